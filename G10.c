@@ -471,12 +471,14 @@ int g_init ( GXInstance_t **pp_instance, const char *path )
                 extern void init_texture    ( void );
                 extern void init_input      ( void );
                 extern void init_part       ( void );
+                extern void init_asset      ( void );
                 extern void init_material   ( void );
                 extern void init_scheduler  ( void );
                 extern void init_scene      ( void );
                 extern void init_collider   ( void );
                 extern void init_physics    ( void );
                 extern void init_ai         ( void );
+                extern void init_prefab     ( void );
 
                 // Set the loading thread limit
                 if ( p_loading_thread_count )
@@ -492,6 +494,9 @@ int g_init ( GXInstance_t **pp_instance, const char *path )
                 else
                     p_instance->loading_thread_count = 4;
 
+                // Linear algebra initialization
+                init_linear();
+
                 // Input initialization
                 init_input();
 
@@ -501,6 +506,9 @@ int g_init ( GXInstance_t **pp_instance, const char *path )
                 // Part initialization
                 init_part();
 
+                // Asset pipeline initialization
+                init_asset();
+
                 // Material initialization
                 init_material();
 
@@ -514,10 +522,13 @@ int g_init ( GXInstance_t **pp_instance, const char *path )
                 //init_collider();
 
                 // Physics initialization
-                //init_physics();
+                init_physics();
 
                 // AI initialization
                 init_ai();
+
+                // Prefab initialization
+                init_prefab();
             }
 
             // Data
@@ -538,7 +549,8 @@ int g_init ( GXInstance_t **pp_instance, const char *path )
                 JSONValue_t *p_material_cache_count = 0,
                             *p_part_cache_count     = 0,
                             *p_shader_cache_count   = 0,
-                            *p_ai_cache_count       = 0;
+                            *p_ai_cache_count       = 0,
+                            *p_prefab_cache_count   = 0;
 
                 // Parse the JSON value
                 {
@@ -551,6 +563,7 @@ int g_init ( GXInstance_t **pp_instance, const char *path )
                     p_part_cache_count     = dict_get(p_dict, "part count");
                     p_shader_cache_count   = dict_get(p_dict, "shader count");
                     p_ai_cache_count       = dict_get(p_dict, "ai count");
+                    p_prefab_cache_count   = dict_get(p_dict, "prefab count");
                 }
 
                 // Construct the material cache
@@ -599,6 +612,19 @@ int g_init ( GXInstance_t **pp_instance, const char *path )
                     else
                         goto wrong_ai_cache_count_type;
                 }
+
+                // Construct the prefab cache
+                if ( p_prefab_cache_count )
+                {
+                    // Parse the prefab cache count as an integer
+                    if ( p_prefab_cache_count->type == JSONinteger )
+                        dict_construct(&p_instance->cache.prefabs, p_prefab_cache_count->integer);
+                    // Default
+                    else
+                        goto wrong_prefab_cache_count_type;
+                }
+                else
+                    (void)dict_construct(&p_instance->cache.prefabs, 16);
             }
             // Default
             else
@@ -609,21 +635,26 @@ int g_init ( GXInstance_t **pp_instance, const char *path )
                 (void)dict_construct(&p_instance->cache.parts, 128);
                 (void)dict_construct(&p_instance->cache.shaders, 32);
                 (void)dict_construct(&p_instance->cache.ais, 16);
+                (void)dict_construct(&p_instance->cache.prefabs, 16);
             }
 
-            // Queues
+            // Cache handles
             {
+                if ( create_handle_table(&p_instance->cache.material_handles) == 0 ) goto no_mem;
+                if ( create_handle_table(&p_instance->cache.part_handles)     == 0 ) goto no_mem;
+                if ( create_handle_table(&p_instance->cache.shader_handles)   == 0 ) goto no_mem;
+                if ( create_handle_table(&p_instance->cache.ai_handles)       == 0 ) goto no_mem;
+            }
 
-                // Queue for entities with colliders
-                (void)queue_construct(&p_instance->queues.actor_collision);
-
-                // Queues for entities with rigidbodies
-                (void)queue_construct(&p_instance->queues.actor_force);
-                (void)queue_construct(&p_instance->queues.actor_move);
+            // Loads in flight
+            {
+                (void)dict_construct(&p_instance->cache.loading_parts, 16);
+                (void)dict_construct(&p_instance->cache.loading_shaders, 16);
+                (void)dict_construct(&p_instance->cache.loading_ais, 16);
+            }
 
-                // Queues for entities with AIs
-                (void)queue_construct(&p_instance->queues.ai_preupdate);
-                (void)queue_construct(&p_instance->queues.ai_update);
+            // Queues
+            {
 
                 // Queue for entities to load
                 (void)queue_construct(&p_instance->queues.load_entity);
@@ -977,6 +1008,14 @@ int g_init ( GXInstance_t **pp_instance, const char *path )
                 // Error
                 return 0;
 
+            wrong_prefab_cache_count_type:
+                #ifndef NDEBUG
+                    g_print_error("[G10] Failed to parse \"prefab count\" property of \"cache\" property. Wrong type in call to function \"%s\"\nRefer to gschema: https://schema.g10.app/instance.json \n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
             wrong_loading_thread_count_type:
                 #ifndef NDEBUG
                     g_print_error("[G10] Failed to parse \"loading thread count\" property. Wrong type in call to function \"%s\"\nRefer to gschema: https://schema.g10.app/instance.json \n", __FUNCTION__);
@@ -1151,6 +1190,97 @@ int g_init ( GXInstance_t **pp_instance, const char *path )
     }
 }
 
+int g_init_headless ( GXInstance_t **pp_instance )
+{
+
+    // Argument Check
+    #ifndef NDEBUG
+        if ( pp_instance == (void *) 0 ) goto no_instance;
+    #endif
+
+    // Initialized data
+    GXInstance_t *p_instance = calloc(1, sizeof(GXInstance_t));
+
+    // External functions
+    extern void init_physics ( void );
+
+    // Error check
+    if ( p_instance == (void *) 0 ) goto no_mem;
+
+    // Set the active instance
+    active_instance = p_instance;
+
+    // Log to standard out
+    log_file = stdout;
+
+    // Initialize SDL timers
+    if ( SDL_Init(SDL_INIT_TIMER | SDL_INIT_EVENTS) ) goto failed_to_initialize_sdl2;
+
+    // Get the clock divisor for high precision timing
+    p_instance->time.clock_div = SDL_GetPerformanceFrequency();
+
+    // Linear algebra initialization
+    init_linear();
+
+    // Physics initialization
+    init_physics();
+
+    // This prevents divide by zero errors when the game loop starts
+    p_instance->time.delta_time = 0.001f;
+
+    // The instance is running
+    p_instance->running = true;
+
+    // Return a pointer to the caller
+    *pp_instance = p_instance;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_instance:
+                #ifndef NDEBUG
+                    g_print_error("[G10] Null pointer provided for parameter \"pp_instance\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // SDL errors
+        {
+            failed_to_initialize_sdl2:
+                #ifndef NDEBUG
+                    g_print_error("[SDL2] Failed to initialize SDL in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Clear the active instance
+                active_instance = (void *) 0;
+
+                // Free the instance
+                free(p_instance);
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    g_print_error("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
 int setup_debug_messenger ( VkDebugUtilsMessengerCreateInfoEXT **debug_messenger_create_info )
 {
 
@@ -4122,14 +4252,9 @@ int copy_state ( GXInstance_t *p_instance )
     #endif
 
     // Initialized data
-    size_t actor_count           = 0,
-           ai_count              = 0,
-           draw_count            = 0,
-           draw_queue_type_count = 0;
-
-    GXEntity_t **actors = 0,
-               **ais    = 0,
-               **draw   = 0;
+    GXComponentStorage_t  *p_storage   = p_instance->context.scene->components;
+    GXEntity_t           **actors      = 0;
+    size_t                 actor_count = 0;
 
     // Lock the mutexes
 
@@ -4142,117 +4267,102 @@ int copy_state ( GXInstance_t *p_instance )
     SDL_LockMutex(p_instance->mutexes.ai_preupdate);
     SDL_LockMutex(p_instance->mutexes.ai_update);
 
-    // Get a list of actors, ais, and draw items
+    // Update the work lists with the entities that were added, removed, or changed components since last frame
+    if ( p_storage )
     {
+        (void) apply_component_changes(p_storage);
 
-        // Get the quantity of dict entries
-        actor_count = dict_keys(p_instance->context.scene->actors, 0);
-        ai_count    = dict_keys(p_instance->context.scene->ais, 0);
-        draw_count  = dict_keys(p_instance->context.scene->entities, 0);
-
-        // Allocate memory for lists
-        actors = calloc(actor_count+1, sizeof(void *));
-        ais    = calloc(ai_count+1, sizeof(void *));
-        draw   = calloc(draw_count+1, sizeof(void *));
-
-        // Get the contents of the dict
-        dict_values(p_instance->context.scene->actors, (void **)actors);
-        dict_values(p_instance->context.scene->ais, (void **)ais);
-        dict_values(p_instance->context.scene->entities, (void **)draw);
+        actors      = p_storage->work_lists[WORK_LIST_ACTORS].entities;
+        actor_count = p_storage->work_lists[WORK_LIST_ACTORS].count;
     }
 
-    // Empty the queues
+    // Start a new pass over each work list
     {
 
         // Physics
-        while ( queue_empty(p_instance->queues.actor_move) == false )
-            queue_dequeue(p_instance->queues.actor_move, 0);
-
-        while ( queue_empty(p_instance->queues.actor_force) == false)
-            queue_dequeue(p_instance->queues.actor_force, 0);
-
-        while ( queue_empty(p_instance->queues.actor_collision) == false)
-            queue_dequeue(p_instance->queues.actor_collision, 0);
+        p_instance->cursors.actor_move      = 0;
+        p_instance->cursors.actor_force     = 0;
+        p_instance->cursors.actor_collision = 0;
 
         // AI
-        while ( queue_empty(p_instance->queues.ai_preupdate) == false ) { queue_dequeue(p_instance->queues.ai_preupdate, 0); };
-
-        while ( queue_empty(p_instance->queues.ai_update)    == false ) { queue_dequeue(p_instance->queues.ai_update   , 0); };
-
-        // Draw
-
-        // Iterate over each render pass
-        /*
-        for (size_t i = 0; i < p_instance->context.renderer->render_pass_count; i++)
-        {
-
-            // Initialized data
-            GXRenderPass_t *p_render_pass = p_instance->context.renderer->render_passes_data[i];
-
-            // Iterate over each draw item
-            for (size_t j = 0; j < draw_count; j++)
-            {
-
-                // Initialized data
-                queue *p_queue = dict_get(p_render_pass->draw_queue_types, draw[i]->shader_name);
-
-                // Dequeue each element
-                while( queue_empty(p_queue) == false ) { (void) queue_dequeue(p_queue, 0); }; 
-            }
-        }
-        */
+        p_instance->cursors.ai_preupdate    = 0;
+        p_instance->cursors.ai_update       = 0;
     }
 
-    // Populate the new queues
+    // Prepare this frame's queries
     {
 
-        // Physics
-        for (size_t i = 0; i < actor_count; i++)
-        {
-            queue_enqueue(p_instance->queues.actor_move, actors[i]);
-            queue_enqueue(p_instance->queues.actor_force, actors[i]);
-            queue_enqueue(p_instance->queues.actor_collision, actors[i]);
-        }
+        // Recompute the world matrix of everything that moved last frame
+        if ( p_instance->context.scene->transforms )
+            (void) update_transforms(p_instance->context.scene->transforms);
 
-        // AI
-        for (size_t i = 0; i < ai_count; i++)
+        // Find colliding pairs for the narrowphase
+        detect_broadphase(p_instance, actors, actor_count);
+
+        // Compile the scene's bounding volume hierarchy for this frame's queries
+        if ( p_instance->context.scene->bvh )
         {
-            queue_enqueue(p_instance->queues.ai_preupdate, ais[i]);
-            queue_enqueue(p_instance->queues.ai_update, ais[i]);
+
+            // Allocate the compiled tree
+            if ( p_instance->context.scene->qbvh == (void *) 0 )
+                (void) create_qbvh(&p_instance->context.scene->qbvh);
+
+            // Refit or rebuild
+            if ( p_instance->context.scene->qbvh )
+                (void) update_qbvh(p_instance->context.scene->qbvh, p_instance->context.scene->bvh);
         }
 
-        // Draw
-        
-        // Iterate over each render pass
-        /*
-        for (size_t i = 0; i < p_instance->context.renderer->render_pass_count; i++)
+        // Queue each entity the active camera sees for drawing, in the draw queue of its shader
+        if ( p_instance->context.scene->qbvh && p_instance->context.scene->active_camera && p_instance->context.renderer )
         {
 
             // Initialized data
-            GXRenderPass_t *p_render_pass = p_instance->context.renderer->render_passes_data[i];
+            GXRenderer_t     *p_renderer    = p_instance->context.renderer;
+            GXScratchMark_t   mark          = scratch_mark();
+            vec4              planes[6]     = { 0 };
+            GXEntity_t      **visible       = 0;
+            size_t            visible_count = 0;
+
+            // Count the visible entities
+            if ( frustum_planes_from_camera(p_instance->context.scene->active_camera, planes) )
+                visible_count = qbvh_frustum(p_instance->context.scene->qbvh, planes, 0, 0);
+
+            // Find the visible entities
+            if ( visible_count )
+                visible = scratch_alloc(visible_count * sizeof(GXEntity_t *));
+
+            if ( visible )
+                (void) qbvh_frustum(p_instance->context.scene->qbvh, planes, visible, visible_count);
+            else
+                visible_count = 0;
 
-            // Iterate over each draw item
-            for (size_t j = 0; j < draw_count; j++)
+            // Iterate over each visible entity
+            for (size_t i = 0; i < visible_count; i++)
             {
 
                 // Initialized data
-                queue *p_queue = dict_get(p_render_pass->draw_queue_types, draw[j]->shader_name);
+                GXEntity_t *p_entity = visible[i];
 
-                // Is the item going to be drawn this renderpass?
-                if ( p_queue )
+                // Nothing to draw
+                if ( p_entity == (void *) 0 || p_entity->shader_name == (void *) 0 ) continue;
 
-                    // Add the draw item to the draw queue
-                    queue_enqueue(p_queue, draw[j]);
+                // Queue the entity in each render pass that uses its shader
+                for (size_t j = 0; j < p_renderer->render_pass_count; j++)
+                {
+
+                    // Initialized data
+                    queue *p_draw_queue = dict_get(p_renderer->render_passes_data[j]->draw_queue_types, p_entity->shader_name);
+
+                    if ( p_draw_queue )
+                        queue_enqueue(p_draw_queue, p_entity);
+                }
             }
+
+            // Clean the scope
+            scratch_rewind(mark);
         }
-        */
     }
 
-    // Clean the scope
-    free(actors);
-    free(ais);
-    free(draw);
-
     // Unlock the mutexes
 
     // Physics
@@ -4361,6 +4471,10 @@ int g_cache_material ( GXInstance_t *p_instance, GXMaterial_t *material )
     // Add the material to the instance's cache
     dict_add(p_instance->cache.materials, material->name, material);
 
+    // Give the material a handle
+    if ( material->handle == HANDLE_INVALID )
+        material->handle = acquire_handle(p_instance->cache.material_handles, material);
+
     // Increment the users counter
     material->users++;
 
@@ -4404,6 +4518,10 @@ int g_cache_part ( GXInstance_t *p_instance, GXPart_t *p_part )
     // Add the part to the dictionary
     dict_add(p_instance->cache.parts, p_part->name, p_part);
 
+    // Give the part a handle
+    if ( p_part->handle == HANDLE_INVALID )
+        p_part->handle = acquire_handle(p_instance->cache.part_handles, p_part);
+
     // Increment the user count
     p_part->users++;
 
@@ -4447,6 +4565,10 @@ int g_cache_shader ( GXInstance_t *p_instance, GXShader_t *p_shader )
     // Add the shader to the cache
     dict_add(p_instance->cache.shaders, p_shader->name, p_shader);
 
+    // Give the shader a handle
+    if ( p_shader->handle == HANDLE_INVALID )
+        p_shader->handle = acquire_handle(p_instance->cache.shader_handles, p_shader);
+
     // Increment the shader users
     p_shader->users++;
 
@@ -4489,6 +4611,10 @@ int g_cache_ai ( GXInstance_t *p_instance, GXAI_t *p_ai )
 
     dict_add(p_instance->cache.ais, p_ai->name, p_ai);
 
+    // Give the ai a handle
+    if ( p_ai->handle == HANDLE_INVALID )
+        p_ai->handle = acquire_handle(p_instance->cache.ai_handles, p_ai);
+
     // Success
     return 1;
 
@@ -4516,6 +4642,44 @@ int g_cache_ai ( GXInstance_t *p_instance, GXAI_t *p_ai )
     }
 }
 
+int g_cache_prefab ( GXInstance_t *p_instance, GXPrefab_t *p_prefab )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( p_instance == (void *) 0 ) goto no_instance;
+        if ( p_prefab   == (void *) 0 ) goto no_prefab;
+    #endif
+
+    dict_add(p_instance->cache.prefabs, p_prefab->name, p_prefab);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_instance:
+                #ifndef NDEBUG
+                    printf("[G10] Null pointer provided for parameter \"p_instance\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_prefab:
+                #ifndef NDEBUG
+                    printf("[G10] Null pointer provided for parameter \"p_prefab\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
 void g_user_exit ( callback_parameter_t input, GXInstance_t* p_instance )
 {
 
@@ -4588,8 +4752,14 @@ GXMaterial_t *g_find_material ( GXInstance_t *p_instance, char *name )
         if ( name       == (void *) 0 ) goto no_name;
     #endif
 
+    // Initialized data
+    GXMaterial_t *p_material = (GXMaterial_t *) dict_get(p_instance->cache.materials, (char *)name);
+
+    // Count the lookup
+    G10_STAT_ADD(( p_material ) ? stat_material_cache_hits : stat_material_cache_misses, 1);
+
     // Success
-    return (GXMaterial_t *) dict_get(p_instance->cache.materials, (char *)name);
+    return p_material;
 
     // Error handling
     {
@@ -4625,8 +4795,14 @@ GXPart_t *g_find_part ( GXInstance_t *p_instance, char *name )
         if ( name       == (void *) 0 ) goto no_name;
     #endif
 
+    // Initialized data
+    GXPart_t *p_part = (GXPart_t *) dict_get(p_instance->cache.parts, (char *)name);
+
+    // Count the lookup
+    G10_STAT_ADD(( p_part ) ? stat_part_cache_hits : stat_part_cache_misses, 1);
+
     // Success
-    return (GXPart_t *) dict_get(p_instance->cache.parts, (char *)name);
+    return p_part;
 
     // Error handling
     {
@@ -4662,8 +4838,14 @@ GXShader_t *g_find_shader ( GXInstance_t *p_instance, char *name )
         if ( name       == (void *) 0 ) goto no_name;
     #endif
 
+    // Initialized data
+    GXShader_t *p_shader = (GXShader_t *) dict_get(p_instance->cache.shaders, (char *)name);
+
+    // Count the lookup
+    G10_STAT_ADD(( p_shader ) ? stat_shader_cache_hits : stat_shader_cache_misses, 1);
+
     // Success
-    return (GXShader_t *) dict_get(p_instance->cache.shaders, (char *)name);
+    return p_shader;
 
     // Error handling
     {
@@ -4699,8 +4881,14 @@ GXAI_t *g_find_ai ( GXInstance_t *p_instance, char *name )
         if ( name       == (void *) 0 ) goto no_name;
     #endif
 
+    // Initialized data
+    GXAI_t *p_ai = (GXAI_t *) dict_get(p_instance->cache.ais, (char *)name);
+
+    // Count the lookup
+    G10_STAT_ADD(( p_ai ) ? stat_ai_cache_hits : stat_ai_cache_misses, 1);
+
     // Success
-    return (GXAI_t *) dict_get(p_instance->cache.ais, (char *)name);
+    return p_ai;
 
     // Error handling
     {
@@ -4727,90 +4915,694 @@ GXAI_t *g_find_ai ( GXInstance_t *p_instance, char *name )
     }
 }
 
-int g_exit ( GXInstance_t **pp_instance )
+GXPrefab_t *g_find_prefab ( GXInstance_t *p_instance, char *name )
 {
 
     // Argument check
     #ifndef NDEBUG
-        if ( pp_instance == (void *) 0 ) goto no_instance;
+        if ( p_instance == (void *) 0 ) goto no_instance;
+        if ( name       == (void *) 0 ) goto no_name;
     #endif
 
-    // Initialized data
-    GXInstance_t *p_instance = *pp_instance;
+    // Success
+    return (GXPrefab_t *) dict_get(p_instance->cache.prefabs, (char *)name);
 
-    // No more instance for caller
-    *pp_instance = 0;
+    // Error handling
+    {
 
-    // Error check
-    if ( p_instance == (void *) 0 ) goto pointer_to_null_pointer;
+        // Argument errors
+        {
+            no_instance:
+                #ifndef NDEBUG
+                    printf("[G10] Null pointer provided for parameter \"p_instance\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
 
-    // Flip the running flag
-    p_instance->running = false;
+                // Error
+                return 0;
 
-    // Wait for the GPU to finish whatever its doing
-    vkDeviceWaitIdle(p_instance->vulkan.device);
+            no_name:
+                #ifndef NDEBUG
+                    printf("[G10] Null pointer provided for parameter \"name\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
 
-    // Cleanup the instance
-    {
+                // Error
+                return 0;
+        }
 
-        // Free the instance name
-        free(p_instance->name);
+    }
+}
 
-        // TODO: Fix
-        //dict_free_clear(p_instance->data.scenes, &destroy_scene);
+// A name being loaded into a cache. Threads that ask for the same name wait on it
+struct cache_load_s
+{
+    char      *name;
+    SDL_cond  *settled;
+    bool       done;
+    size_t     waiters;
+};
 
-        // Cleanup the context
-        {
+static void destroy_cache_load ( struct cache_load_s *p_load )
+{
 
-            // Clear the active schedule...
-            p_instance->context.schedule = 0;
+    SDL_DestroyCond(p_load->settled);
 
-            // ... the active scene ...
-            p_instance->context.scene = 0;
+    free(p_load->name);
+    free(p_load);
+}
 
-            // ... any loading scene ...
-            p_instance->context.loading_scene = 0;
+// Wait out another thread loading a name, or claim the load. Called with the mutex of the cache held
+static bool claim_cache_load ( dict *p_loading, char *name, SDL_mutex *p_mutex )
+{
 
-            // ... and the active renderer ...
-            if ( p_instance->context.renderer )
-                if ( destroy_renderer(&p_instance->context.renderer) == 0 ) goto failed_to_destroy_renderer;
+    // Initialized data
+    struct cache_load_s *p_load   = dict_get(p_loading, name);
+    size_t               name_len = strlen(name);
 
-            // ... and the user code callback
-            p_instance->context.user_code_callback = 0;
-        }
+    // Another thread is loading the object. Wait for it, and look again
+    if ( p_load )
+    {
+        p_load->waiters++;
 
-        // Cleanup the data
-        {
+        while ( p_load->done == false )
+            SDL_CondWait(p_load->settled, p_mutex);
 
-            // TODO: Cleanup the scenes...
-            //dict_free_clear(p_instance->data.scenes, destroy_scene);
+        // The last waiter frees the load
+        if ( --p_load->waiters == 0 )
+            destroy_cache_load(p_load);
 
-            // TODO: ... and the schedules
-            //dict_free_clear(p_instance->data.schedules, destroy_schedule);
-        }
+        return false;
+    }
 
-        // Clean up the cache
-        {
+    // Claim the load
+    p_load = calloc(1, sizeof(struct cache_load_s));
 
-            // Initialized data
-            size_t     len      = dict_values(p_instance->cache.parts,  0);
-            GXPart_t **pp_parts = calloc(len, sizeof(GXPart_t *));
+    // Error checking
+    if ( p_load == (void *) 0 ) goto no_mem;
 
-            // Error check
-            if ( pp_parts == (void *) 0 ) goto no_mem;
+    p_load->name    = calloc(name_len + 1, sizeof(char)),
+    p_load->settled = SDL_CreateCond();
 
-            // Get the contents of the part cache
-            dict_values(p_instance->cache.parts, pp_parts);
+    // Error checking
+    if ( p_load->name    == (void *) 0 ) goto no_mem;
+    if ( p_load->settled == (void *) 0 ) goto failed_to_create_cond;
 
-            // Iterate over each part
-            for (size_t i = 0; i < len; i++)
-            {
+    // Copy the name
+    strncpy(p_load->name, name, name_len);
 
-                // Initialized data
-                GXPart_t *i_part = pp_parts[i];
+    // Other threads asking for the name wait from here
+    dict_add(p_loading, p_load->name, p_load);
 
-                // Pop the part
-                dict_pop(p_instance->cache.parts, i_part->name, 0);
+    // Success
+    return true;
+
+    // Error handling
+    {
+
+        // SDL errors
+        {
+            failed_to_create_cond:
+                #ifndef NDEBUG
+                    g_print_error("[SDL2] Failed to create a condition variable in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                free(p_load->name);
+                free(p_load);
+
+                // Load without a placeholder
+                return true;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    g_print_error("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Destroy the condition variable, if it was made before the name failed
+                if ( p_load && p_load->settled )
+                    SDL_DestroyCond(p_load->settled);
+
+                free(p_load);
+
+                // Load without a placeholder. Another thread may load the same object
+                return true;
+        }
+    }
+}
+
+// Wake the threads waiting for a name. Called with the mutex of the cache held
+static void settle_cache_load ( dict *p_loading, char *name )
+{
+
+    // Initialized data
+    struct cache_load_s *p_load = dict_get(p_loading, name);
+
+    // The load was never claimed
+    if ( p_load == (void *) 0 ) return;
+
+    dict_pop(p_loading, name, 0);
+
+    p_load->done = true;
+
+    SDL_CondBroadcast(p_load->settled);
+
+    // Nobody is waiting
+    if ( p_load->waiters == 0 )
+        destroy_cache_load(p_load);
+}
+
+GXPart_t *g_claim_part ( GXInstance_t *p_instance, char *name )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( p_instance == (void *) 0 ) goto no_instance;
+        if ( name       == (void *) 0 ) goto no_name;
+    #endif
+
+    // Initialized data
+    GXPart_t *p_part = 0;
+
+    // Lock the part cache mutex
+    SDL_LockMutex(p_instance->mutexes.part_cache);
+
+    // Search the cache. Wait out another thread loading the part, or claim the load
+    while ( ( p_part = g_find_part(p_instance, name) ) == 0 )
+        if ( claim_cache_load(p_instance->cache.loading_parts, name, p_instance->mutexes.part_cache) ) break;
+
+    // The caller is a user of the cached part
+    if ( p_part )
+        p_part->users++;
+
+    // Unlock the part cache mutex
+    SDL_UnlockMutex(p_instance->mutexes.part_cache);
+
+    // Success
+    return p_part;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_instance:
+                #ifndef NDEBUG
+                    printf("[G10] Null pointer provided for parameter \"p_instance\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_name:
+                #ifndef NDEBUG
+                    printf("[G10] Null pointer provided for parameter \"name\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+    }
+}
+
+int g_settle_part ( GXInstance_t *p_instance, char *name, GXPart_t *p_part )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( p_instance == (void *) 0 ) goto no_instance;
+        if ( name       == (void *) 0 ) goto no_name;
+    #endif
+
+    // Lock the part cache mutex
+    SDL_LockMutex(p_instance->mutexes.part_cache);
+
+    // Cache the part, unless it failed to load
+    if ( p_part )
+        g_cache_part(p_instance, p_part);
+
+    // Wake the threads waiting for it
+    settle_cache_load(p_instance->cache.loading_parts, name);
+
+    // Unlock the part cache mutex
+    SDL_UnlockMutex(p_instance->mutexes.part_cache);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_instance:
+                #ifndef NDEBUG
+                    printf("[G10] Null pointer provided for parameter \"p_instance\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_name:
+                #ifndef NDEBUG
+                    printf("[G10] Null pointer provided for parameter \"name\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+    }
+}
+
+GXShader_t *g_claim_shader ( GXInstance_t *p_instance, char *name )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( p_instance == (void *) 0 ) goto no_instance;
+        if ( name       == (void *) 0 ) goto no_name;
+    #endif
+
+    // Initialized data
+    GXShader_t *p_shader = 0;
+
+    // Lock the shader cache mutex
+    SDL_LockMutex(p_instance->mutexes.shader_cache);
+
+    // Search the cache. Wait out another thread loading the shader, or claim the load
+    while ( ( p_shader = g_find_shader(p_instance, name) ) == 0 )
+        if ( claim_cache_load(p_instance->cache.loading_shaders, name, p_instance->mutexes.shader_cache) ) break;
+
+    // The caller is a user of the cached shader
+    if ( p_shader )
+        p_shader->users++;
+
+    // Unlock the shader cache mutex
+    SDL_UnlockMutex(p_instance->mutexes.shader_cache);
+
+    // Success
+    return p_shader;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_instance:
+                #ifndef NDEBUG
+                    printf("[G10] Null pointer provided for parameter \"p_instance\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_name:
+                #ifndef NDEBUG
+                    printf("[G10] Null pointer provided for parameter \"name\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+    }
+}
+
+int g_settle_shader ( GXInstance_t *p_instance, char *name, GXShader_t *p_shader )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( p_instance == (void *) 0 ) goto no_instance;
+        if ( name       == (void *) 0 ) goto no_name;
+    #endif
+
+    // Lock the shader cache mutex
+    SDL_LockMutex(p_instance->mutexes.shader_cache);
+
+    // Cache the shader, unless it failed to load
+    if ( p_shader )
+        g_cache_shader(p_instance, p_shader);
+
+    // Wake the threads waiting for it
+    settle_cache_load(p_instance->cache.loading_shaders, name);
+
+    // Unlock the shader cache mutex
+    SDL_UnlockMutex(p_instance->mutexes.shader_cache);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_instance:
+                #ifndef NDEBUG
+                    printf("[G10] Null pointer provided for parameter \"p_instance\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_name:
+                #ifndef NDEBUG
+                    printf("[G10] Null pointer provided for parameter \"name\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+    }
+}
+
+GXAI_t *g_claim_ai ( GXInstance_t *p_instance, char *name )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( p_instance == (void *) 0 ) goto no_instance;
+        if ( name       == (void *) 0 ) goto no_name;
+    #endif
+
+    // Initialized data
+    GXAI_t *p_ai = 0;
+
+    // Lock the AI cache mutex
+    SDL_LockMutex(p_instance->mutexes.ai_cache);
+
+    // Search the cache. Wait out another thread loading the AI, or claim the load
+    while ( ( p_ai = g_find_ai(p_instance, name) ) == 0 )
+        if ( claim_cache_load(p_instance->cache.loading_ais, name, p_instance->mutexes.ai_cache) ) break;
+
+    // Unlock the AI cache mutex
+    SDL_UnlockMutex(p_instance->mutexes.ai_cache);
+
+    // Success
+    return p_ai;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_instance:
+                #ifndef NDEBUG
+                    printf("[G10] Null pointer provided for parameter \"p_instance\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_name:
+                #ifndef NDEBUG
+                    printf("[G10] Null pointer provided for parameter \"name\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+    }
+}
+
+int g_settle_ai ( GXInstance_t *p_instance, char *name, GXAI_t *p_ai )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( p_instance == (void *) 0 ) goto no_instance;
+        if ( name       == (void *) 0 ) goto no_name;
+    #endif
+
+    // Lock the AI cache mutex
+    SDL_LockMutex(p_instance->mutexes.ai_cache);
+
+    // Cache the AI, unless it failed to load
+    if ( p_ai )
+        g_cache_ai(p_instance, p_ai);
+
+    // Wake the threads waiting for it
+    settle_cache_load(p_instance->cache.loading_ais, name);
+
+    // Unlock the AI cache mutex
+    SDL_UnlockMutex(p_instance->mutexes.ai_cache);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_instance:
+                #ifndef NDEBUG
+                    printf("[G10] Null pointer provided for parameter \"p_instance\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_name:
+                #ifndef NDEBUG
+                    printf("[G10] Null pointer provided for parameter \"name\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+    }
+}
+
+GXMaterial_t *g_get_material ( GXInstance_t *p_instance, handle_t handle )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( p_instance == (void *) 0 ) goto no_instance;
+    #endif
+
+    // Success OR null pointer if the handle is stale
+    return (GXMaterial_t *) resolve_handle(p_instance->cache.material_handles, handle);
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_instance:
+                #ifndef NDEBUG
+                    printf("[G10] Null pointer provided for parameter \"p_instance\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+    }
+}
+
+GXPart_t *g_get_part ( GXInstance_t *p_instance, handle_t handle )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( p_instance == (void *) 0 ) goto no_instance;
+    #endif
+
+    // Success OR null pointer if the handle is stale
+    return (GXPart_t *) resolve_handle(p_instance->cache.part_handles, handle);
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_instance:
+                #ifndef NDEBUG
+                    printf("[G10] Null pointer provided for parameter \"p_instance\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+    }
+}
+
+GXShader_t *g_get_shader ( GXInstance_t *p_instance, handle_t handle )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( p_instance == (void *) 0 ) goto no_instance;
+    #endif
+
+    // Success OR null pointer if the handle is stale
+    return (GXShader_t *) resolve_handle(p_instance->cache.shader_handles, handle);
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_instance:
+                #ifndef NDEBUG
+                    printf("[G10] Null pointer provided for parameter \"p_instance\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+    }
+}
+
+GXAI_t *g_get_ai ( GXInstance_t *p_instance, handle_t handle )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( p_instance == (void *) 0 ) goto no_instance;
+    #endif
+
+    // Success OR null pointer if the handle is stale
+    return (GXAI_t *) resolve_handle(p_instance->cache.ai_handles, handle);
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_instance:
+                #ifndef NDEBUG
+                    printf("[G10] Null pointer provided for parameter \"p_instance\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+    }
+}
+
+int g_exit ( GXInstance_t **pp_instance )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( pp_instance == (void *) 0 ) goto no_instance;
+    #endif
+
+    // Initialized data
+    GXInstance_t *p_instance = *pp_instance;
+
+    // No more instance for caller
+    *pp_instance = 0;
+
+    // Error check
+    if ( p_instance == (void *) 0 ) goto pointer_to_null_pointer;
+
+    // Flip the running flag
+    p_instance->running = false;
+
+    // Stop loading assets
+    (void) stop_assets();
+
+    // Wait for the GPU to finish whatever its doing
+    vkDeviceWaitIdle(p_instance->vulkan.device);
+
+    // Cleanup the instance
+    {
+
+        // Free the instance name
+        free(p_instance->name);
+
+        // TODO: Fix
+        //dict_free_clear(p_instance->data.scenes, &destroy_scene);
+
+        // Cleanup the context
+        {
+
+            // Clear the active schedule...
+            p_instance->context.schedule = 0;
+
+            // ... the active scene ...
+            p_instance->context.scene = 0;
+
+            // ... any loading scene ...
+            p_instance->context.loading_scene = 0;
+
+            // ... and the active renderer ...
+            if ( p_instance->context.renderer )
+                if ( destroy_renderer(&p_instance->context.renderer) == 0 ) goto failed_to_destroy_renderer;
+
+            // ... and the user code callback
+            p_instance->context.user_code_callback = 0;
+        }
+
+        // Cleanup the data
+        {
+
+            // TODO: Cleanup the scenes...
+            //dict_free_clear(p_instance->data.scenes, destroy_scene);
+
+            // TODO: ... and the schedules
+            //dict_free_clear(p_instance->data.schedules, destroy_schedule);
+        }
+
+        // Clean up the prefab cache. Templates borrow from the other caches, so they go first
+        {
+
+            // Initialized data
+            size_t       len        = dict_values(p_instance->cache.prefabs, 0);
+            GXPrefab_t **pp_prefabs = calloc(len + 1, sizeof(GXPrefab_t *));
+
+            // Error check
+            if ( pp_prefabs == (void *) 0 ) goto no_mem;
+
+            // Get the contents of the prefab cache
+            dict_values(p_instance->cache.prefabs, (void **)pp_prefabs);
+
+            // Destroy each prefab
+            for (size_t i = 0; i < len; i++)
+                destroy_prefab(&pp_prefabs[i]);
+
+            // Destroy the prefab cache
+            dict_destroy(&p_instance->cache.prefabs);
+
+            // Clean the scope
+            free(pp_prefabs);
+        }
+
+        // Clean up the cache
+        {
+
+            // Initialized data
+            size_t     len      = dict_values(p_instance->cache.parts,  0);
+            GXPart_t **pp_parts = calloc(len, sizeof(GXPart_t *));
+
+            // Error check
+            if ( pp_parts == (void *) 0 ) goto no_mem;
+
+            // Get the contents of the part cache
+            dict_values(p_instance->cache.parts, pp_parts);
+
+            // Iterate over each part
+            for (size_t i = 0; i < len; i++)
+            {
+
+                // Initialized data
+                GXPart_t *i_part = pp_parts[i];
+
+                // Pop the part
+                dict_pop(p_instance->cache.parts, i_part->name, 0);
 
                 // Destroy the part
                 destroy_part(&i_part);
@@ -4820,6 +5612,30 @@ int g_exit ( GXInstance_t **pp_instance )
             dict_destroy(&p_instance->cache.parts);
         }
 
+        // Clean up the cache handles
+        {
+            (void) destroy_handle_table(&p_instance->cache.material_handles);
+            (void) destroy_handle_table(&p_instance->cache.part_handles);
+            (void) destroy_handle_table(&p_instance->cache.shader_handles);
+            (void) destroy_handle_table(&p_instance->cache.ai_handles);
+        }
+
+        // Clean up the loads in flight. Every load has settled by now
+        {
+            dict_destroy(&p_instance->cache.loading_parts);
+            dict_destroy(&p_instance->cache.loading_shaders);
+            dict_destroy(&p_instance->cache.loading_ais);
+        }
+
+        // Clean up interned strings
+        (void) clear_interned_strings();
+
+        // Free every pool
+        (void) clear_pools();
+
+        // Free the main thread's scratch memory
+        (void) scratch_release();
+
         // Cleanup mutexes
         {
 
@@ -4840,6 +5656,9 @@ int g_exit ( GXInstance_t **pp_instance )
             if ( p_instance->mutexes.material_cache )
                 SDL_DestroyMutex(p_instance->mutexes.material_cache);
 
+            if ( p_instance->mutexes.prefab_cache )
+                SDL_DestroyMutex(p_instance->mutexes.prefab_cache);
+
             // ... and the physics mutexes...
             if ( p_instance->mutexes.move_object )
                 SDL_DestroyMutex(p_instance->mutexes.move_object);
@@ -4859,6 +5678,7 @@ int g_exit ( GXInstance_t **pp_instance )
             p_instance->mutexes.part_cache        = 0,
             p_instance->mutexes.ai_cache          = 0,
             p_instance->mutexes.material_cache    = 0,
+            p_instance->mutexes.prefab_cache      = 0,
             p_instance->mutexes.move_object       = 0,
             p_instance->mutexes.update_force      = 0,
             p_instance->mutexes.resolve_collision = 0,
@@ -4875,20 +5695,6 @@ int g_exit ( GXInstance_t **pp_instance )
             // Destroy the light probe loading queue
             if ( p_instance->queues.load_light_probe )
                 queue_destroy(&p_instance->queues.load_light_probe);
-
-            // Destroy the physics queues
-            if ( p_instance->queues.actor_move )
-                queue_destroy(&p_instance->queues.actor_move);
-            if ( p_instance->queues.actor_collision )
-                queue_destroy(&p_instance->queues.actor_collision);
-            if ( p_instance->queues.actor_force )
-                queue_destroy(&p_instance->queues.actor_force);
-
-            // Destroy the AI queues
-            if ( p_instance->queues.ai_preupdate )
-                queue_destroy(&p_instance->queues.ai_preupdate);
-            if ( p_instance->queues.ai_update )
-                queue_destroy(&p_instance->queues.ai_update);
         }
 
         // Cleanup input
@@ -4934,6 +5740,11 @@ int g_exit ( GXInstance_t **pp_instance )
     // Free the instance data
     free(p_instance);
 
+    // Report memory that was never freed
+    #ifdef BUILD_G10_WITH_ALLOC_TRACKING
+        (void) alloc_leaks();
+    #endif
+
     // Log
     g_print_log("[G10] Exit successful\n");
 
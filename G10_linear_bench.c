@@ -0,0 +1,1286 @@
+/** !
+ * @file G10 linear algebra benchmark
+ *
+ * Times the vector, matrix, and quaternion kernels of GXLinear and
+ * GXQuaternion on each supported backend, in by value, pointer, and batch
+ * forms. Kernels without a backend of their own are timed too, as a
+ * baseline. Measures the error of each kernel against a double precision
+ * reference, and reports ns/op, GFLOP/s, and ULP error as JSON.
+ *
+ * @author Jacob C Smith
+*/
+
+// Standard library
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+
+// G10
+#include <G10/G10.h>
+#include <G10/GXLinear.h>
+#include <G10/GXQuaternion.h>
+
+// Defaults
+#define BENCH_COUNT      65536
+#define BENCH_ITERATIONS 16
+#define BENCH_SLERP_T    0.3f
+
+// Error of a kernel, in units in the last place
+struct bench_error_s
+{
+    double max,
+           sum;
+    size_t count;
+};
+typedef struct bench_error_s bench_error_t;
+
+// A kernel under test
+struct bench_kernel_s
+{
+    const char *name;
+
+    // Nominal floating point operations per element. Square roots, divisions, and transcendentals count as one
+    double      flops;
+
+    // Run the kernel over count elements
+    void      (*run)   ( size_t count );
+
+    // Compare the output of the last run to the reference
+    void      (*error) ( size_t count, bench_error_t *p_error );
+};
+typedef struct bench_kernel_s bench_kernel_t;
+
+//////////////////////////
+// Forward declarations //
+//////////////////////////
+
+// Inputs
+int  allocate_inputs ( size_t count );
+void free_inputs     ( void );
+
+// Utility functions
+float  random_float   ( float min, float max );
+void   measure        ( bench_error_t *p_error, const float *r, const double *ref, size_t n );
+bool   inverse_mat4_d ( double *r, const double *m );
+void   multiply_quaternion_d ( double *r, const double *a, const double *b );
+int    run_backend    ( linear_backend_t backend, size_t count, size_t iterations, FILE *p_f, bool last );
+
+// Inputs and outputs
+mat4       *in_m, *in_n, *in_model, *out_m;
+vec4       *in_v, *out_v;
+vec3       *in_v3, *out_v3, *in_location, *in_scale, *in_euler;
+vec2       *in_v2, *out_v2;
+mat2       *in_m2, *in_n2, *out_m2;
+float      *out_f;
+quaternion *in_q0, *in_q1, *out_q;
+float      *soa;
+vec4_soa    in_v_soa, out_v_soa;
+vec3_soa    in_location_soa, in_scale_soa;
+quaternion_soa in_q0_soa, in_q1_soa, out_q_soa;
+
+//////////////////////
+// By value kernels //
+//////////////////////
+
+void run_normalize ( size_t count )
+{
+    for (size_t i = 0; i < count; i++)
+        out_v3[i] = normalize(in_v3[i]);
+}
+
+void run_mul_mat4_vec4 ( size_t count )
+{
+    for (size_t i = 0; i < count; i++)
+        out_v[i] = mul_mat4_vec4(in_m[i], in_v[i]);
+}
+
+void run_mul_mat4_mat4 ( size_t count )
+{
+    for (size_t i = 0; i < count; i++)
+        out_m[i] = mul_mat4_mat4(in_m[i], in_n[i]);
+}
+
+void run_inverse_mat4 ( size_t count )
+{
+    for (size_t i = 0; i < count; i++)
+        out_m[i] = inverse_mat4(in_n[i]);
+}
+
+void run_affine_inverse_mat4 ( size_t count )
+{
+    for (size_t i = 0; i < count; i++)
+        out_m[i] = affine_inverse_mat4(in_model[i]);
+}
+
+void run_multiply_quaternion_quaternion ( size_t count )
+{
+    for (size_t i = 0; i < count; i++)
+        out_q[i] = multiply_quaternion_quaternion(in_q0[i], in_q1[i]);
+}
+
+void run_q_slerp ( size_t count )
+{
+    for (size_t i = 0; i < count; i++)
+        out_q[i] = q_slerp(in_q0[i], in_q1[i], BENCH_SLERP_T);
+}
+
+void run_add_vec3 ( size_t count )
+{
+    for (size_t i = 0; i < count; i++)
+        add_vec3(&out_v3[i], in_v3[i], in_location[i]);
+}
+
+void run_sub_vec3 ( size_t count )
+{
+    for (size_t i = 0; i < count; i++)
+        sub_vec3(&out_v3[i], in_v3[i], in_location[i]);
+}
+
+void run_dot_product_vec3 ( size_t count )
+{
+    for (size_t i = 0; i < count; i++)
+        out_f[i] = dot_product_vec3(in_v3[i], in_location[i]);
+}
+
+void run_cross_product_vec3 ( size_t count )
+{
+    for (size_t i = 0; i < count; i++)
+        out_v3[i] = cross_product_vec3(in_v3[i], in_location[i]);
+}
+
+void run_length ( size_t count )
+{
+    for (size_t i = 0; i < count; i++)
+        out_f[i] = length(in_v3[i]);
+}
+
+void run_mul_mat2_vec2 ( size_t count )
+{
+    for (size_t i = 0; i < count; i++)
+        out_v2[i] = mul_mat2_vec2(in_m2[i], in_v2[i]);
+}
+
+void run_mul_mat2_mat2 ( size_t count )
+{
+    for (size_t i = 0; i < count; i++)
+        out_m2[i] = mul_mat2_mat2(in_m2[i], in_n2[i]);
+}
+
+void run_rcp_mat2 ( size_t count )
+{
+    for (size_t i = 0; i < count; i++)
+        out_m2[i] = rcp_mat2(in_m2[i]);
+}
+
+void run_rcp_mat4 ( size_t count )
+{
+    for (size_t i = 0; i < count; i++)
+        out_m[i] = rcp_mat4(in_m[i]);
+}
+
+void run_rotation_mat4_from_quaternion ( size_t count )
+{
+    for (size_t i = 0; i < count; i++)
+        out_m[i] = rotation_mat4_from_quaternion(in_q0[i]);
+}
+
+void run_rotate_vec3_by_quaternion ( size_t count )
+{
+    for (size_t i = 0; i < count; i++)
+        rotate_vec3_by_quaternion(&out_v3[i], in_v3[i], in_q0[i]);
+}
+
+void run_quaternion_from_euler_angle ( size_t count )
+{
+    for (size_t i = 0; i < count; i++)
+        out_q[i] = quaternion_from_euler_angle(in_euler[i]);
+}
+
+/////////////////////
+// Pointer kernels //
+/////////////////////
+
+void run_normalize_p ( size_t count )
+{
+    for (size_t i = 0; i < count; i++)
+        normalize_p(&out_v3[i], &in_v3[i]);
+}
+
+void run_mul_mat4_vec4_p ( size_t count )
+{
+    for (size_t i = 0; i < count; i++)
+        mul_mat4_vec4_p(&out_v[i], &in_m[i], &in_v[i]);
+}
+
+void run_mul_mat4_mat4_p ( size_t count )
+{
+    for (size_t i = 0; i < count; i++)
+        mul_mat4_mat4_p(&out_m[i], &in_m[i], &in_n[i]);
+}
+
+void run_inverse_mat4_p ( size_t count )
+{
+    for (size_t i = 0; i < count; i++)
+        (void) inverse_mat4_p(&out_m[i], &in_n[i]);
+}
+
+void run_affine_inverse_mat4_p ( size_t count )
+{
+    for (size_t i = 0; i < count; i++)
+        affine_inverse_mat4_p(&out_m[i], &in_model[i]);
+}
+
+void run_multiply_quaternion_quaternion_p ( size_t count )
+{
+    for (size_t i = 0; i < count; i++)
+        multiply_quaternion_quaternion_p(&out_q[i], &in_q0[i], &in_q1[i]);
+}
+
+///////////////////
+// Batch kernels //
+///////////////////
+
+void run_mul_mat4_vec4_batch ( size_t count )
+{
+    mul_mat4_vec4_batch(out_v, in_m, in_v, count);
+}
+
+void run_mul_mat4_vec4_batch_soa ( size_t count )
+{
+    mul_mat4_vec4_batch_soa(out_v_soa, in_m, in_v_soa, count);
+}
+
+void run_mul_mat4_mat4_batch ( size_t count )
+{
+    mul_mat4_mat4_batch(out_m, in_m, in_n, count);
+}
+
+void run_inverse_mat4_batch ( size_t count )
+{
+    inverse_mat4_batch(out_m, in_n, count);
+}
+
+void run_affine_inverse_mat4_batch ( size_t count )
+{
+    affine_inverse_mat4_batch(out_m, in_model, count);
+}
+
+void run_normal_mat4_batch ( size_t count )
+{
+    normal_mat4_batch(out_m, in_model, count);
+}
+
+void run_normalize_quaternion_batch ( size_t count )
+{
+    normalize_quaternion_batch(out_q, in_q0, count);
+}
+
+void run_normalize_quaternion_batch_soa ( size_t count )
+{
+    normalize_quaternion_batch_soa(out_q_soa, in_q0_soa, count);
+}
+
+void run_model_mat4_from_trs_batch ( size_t count )
+{
+    model_mat4_from_trs_batch(out_m, in_location, in_q0, in_scale, count);
+}
+
+void run_model_mat4_from_trs_batch_soa ( size_t count )
+{
+    model_mat4_from_trs_batch_soa(out_m, in_location_soa, in_q0_soa, in_scale_soa, count);
+}
+
+void run_q_slerp_batch ( size_t count )
+{
+    q_slerp_batch(out_q, in_q0, in_q1, BENCH_SLERP_T, count);
+}
+
+void run_q_slerp_batch_soa ( size_t count )
+{
+    q_slerp_batch_soa(out_q_soa, in_q0_soa, in_q1_soa, BENCH_SLERP_T, count);
+}
+
+////////////////
+// References //
+////////////////
+
+void error_normalize ( size_t count, bench_error_t *p_error )
+{
+    for (size_t i = 0; i < count; i++)
+    {
+
+        // Initialized data
+        const float *v   = &in_v3[i].x;
+        double       l   = sqrt((double) v[0] * v[0] + (double) v[1] * v[1] + (double) v[2] * v[2] + (double) v[3] * v[3]),
+                     ref[4];
+
+        for (size_t j = 0; j < 4; j++)
+            ref[j] = v[j] / l;
+
+        measure(p_error, &out_v3[i].x, ref, 4);
+    }
+}
+
+void error_mul_mat4_vec4 ( size_t count, bench_error_t *p_error )
+{
+    for (size_t i = 0; i < count; i++)
+    {
+
+        // Initialized data
+        const float *m = &in_m[i].a,
+                    *v = &in_v[i].x;
+        double       ref[4];
+
+        for (size_t r = 0; r < 4; r++)
+            ref[r] = (double) m[r * 4] * v[0] + (double) m[r * 4 + 1] * v[1] + (double) m[r * 4 + 2] * v[2] + (double) m[r * 4 + 3] * v[3];
+
+        measure(p_error, &out_v[i].x, ref, 4);
+    }
+}
+
+// The batch forms apply one matrix to every vector
+void error_mul_mat4_vec4_batch ( size_t count, bench_error_t *p_error )
+{
+    for (size_t i = 0; i < count; i++)
+    {
+
+        // Initialized data
+        const float *m = &in_m[0].a,
+                    *v = &in_v[i].x;
+        double       ref[4];
+
+        for (size_t r = 0; r < 4; r++)
+            ref[r] = (double) m[r * 4] * v[0] + (double) m[r * 4 + 1] * v[1] + (double) m[r * 4 + 2] * v[2] + (double) m[r * 4 + 3] * v[3];
+
+        measure(p_error, &out_v[i].x, ref, 4);
+    }
+}
+
+void error_mul_mat4_vec4_batch_soa ( size_t count, bench_error_t *p_error )
+{
+    for (size_t i = 0; i < count; i++)
+    {
+
+        // Initialized data
+        const float *m      = &in_m[0].a;
+        float        v[4]   = { in_v_soa.x[i], in_v_soa.y[i], in_v_soa.z[i], in_v_soa.w[i] },
+                     out[4] = { out_v_soa.x[i], out_v_soa.y[i], out_v_soa.z[i], out_v_soa.w[i] };
+        double       ref[4];
+
+        for (size_t r = 0; r < 4; r++)
+            ref[r] = (double) m[r * 4] * v[0] + (double) m[r * 4 + 1] * v[1] + (double) m[r * 4 + 2] * v[2] + (double) m[r * 4 + 3] * v[3];
+
+        measure(p_error, out, ref, 4);
+    }
+}
+
+void error_mul_mat4_mat4 ( size_t count, bench_error_t *p_error )
+{
+    for (size_t i = 0; i < count; i++)
+    {
+
+        // Initialized data
+        const float *m = &in_m[i].a,
+                    *n = &in_n[i].a;
+        double       ref[16];
+
+        for (size_t r = 0; r < 4; r++)
+            for (size_t c = 0; c < 4; c++)
+                ref[r * 4 + c] = (double) m[r * 4] * n[c] + (double) m[r * 4 + 1] * n[4 + c] + (double) m[r * 4 + 2] * n[8 + c] + (double) m[r * 4 + 3] * n[12 + c];
+
+        // Measure each row on its own scale
+        for (size_t r = 0; r < 4; r++)
+            measure(p_error, &out_m[i].a + r * 4, ref + r * 4, 4);
+    }
+}
+
+// Shared by the general and affine inverses
+void error_inverse_of ( const mat4 *p_in, size_t count, bench_error_t *p_error )
+{
+    for (size_t i = 0; i < count; i++)
+    {
+
+        // Initialized data
+        double m[16], ref[16];
+
+        for (size_t j = 0; j < 16; j++)
+            m[j] = (&p_in[i].a)[j];
+
+        // Skip singular inputs
+        if ( inverse_mat4_d(ref, m) == false ) continue;
+
+        for (size_t r = 0; r < 4; r++)
+            measure(p_error, &out_m[i].a + r * 4, ref + r * 4, 4);
+    }
+}
+
+void error_inverse_mat4 ( size_t count, bench_error_t *p_error )
+{
+    error_inverse_of(in_n, count, p_error);
+}
+
+void error_affine_inverse_mat4 ( size_t count, bench_error_t *p_error )
+{
+    error_inverse_of(in_model, count, p_error);
+}
+
+void error_normal_mat4 ( size_t count, bench_error_t *p_error )
+{
+    for (size_t i = 0; i < count; i++)
+    {
+
+        // Initialized data
+        double m[16], inv[16], ref[16] = { 0 };
+
+        for (size_t j = 0; j < 16; j++)
+            m[j] = (&in_model[i].a)[j];
+
+        if ( inverse_mat4_d(inv, m) == false ) continue;
+
+        // Transpose the upper 3x3, and drop the translation
+        for (size_t r = 0; r < 3; r++)
+            for (size_t c = 0; c < 3; c++)
+                ref[r * 4 + c] = inv[c * 4 + r];
+
+        ref[15] = 1.0;
+
+        for (size_t r = 0; r < 4; r++)
+            measure(p_error, &out_m[i].a + r * 4, ref + r * 4, 4);
+    }
+}
+
+void error_multiply_quaternion_quaternion ( size_t count, bench_error_t *p_error )
+{
+    for (size_t i = 0; i < count; i++)
+    {
+
+        // Initialized data
+        double a[4] = { in_q0[i].u, in_q0[i].i, in_q0[i].j, in_q0[i].k },
+               b[4] = { in_q1[i].u, in_q1[i].i, in_q1[i].j, in_q1[i].k },
+               ref[4] =
+               {
+                   a[0] * b[0] - a[1] * b[1] - a[2] * b[2] - a[3] * b[3],
+                   a[0] * b[1] + a[1] * b[0] + a[2] * b[3] - a[3] * b[2],
+                   a[0] * b[2] + a[2] * b[0] + a[3] * b[1] - a[1] * b[3],
+                   a[0] * b[3] + a[3] * b[0] + a[1] * b[2] - a[2] * b[1]
+               };
+        float  out[4] = { out_q[i].u, out_q[i].i, out_q[i].j, out_q[i].k };
+
+        measure(p_error, out, ref, 4);
+    }
+}
+
+// Shared by the AoS and SoA normalizes
+void error_normalize_quaternion_of ( size_t count, bench_error_t *p_error, bool soa_layout )
+{
+    for (size_t i = 0; i < count; i++)
+    {
+
+        // Initialized data
+        double q[4] = { in_q0[i].u, in_q0[i].i, in_q0[i].j, in_q0[i].k },
+               l    = sqrt(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]),
+               ref[4];
+        float  out[4];
+
+        for (size_t j = 0; j < 4; j++)
+            ref[j] = q[j] / l;
+
+        if ( soa_layout )
+            out[0] = out_q_soa.u[i], out[1] = out_q_soa.i[i], out[2] = out_q_soa.j[i], out[3] = out_q_soa.k[i];
+        else
+            out[0] = out_q[i].u, out[1] = out_q[i].i, out[2] = out_q[i].j, out[3] = out_q[i].k;
+
+        measure(p_error, out, ref, 4);
+    }
+}
+
+void error_normalize_quaternion ( size_t count, bench_error_t *p_error )
+{
+    error_normalize_quaternion_of(count, p_error, false);
+}
+
+void error_normalize_quaternion_soa ( size_t count, bench_error_t *p_error )
+{
+    error_normalize_quaternion_of(count, p_error, true);
+}
+
+void error_model_mat4_from_trs ( size_t count, bench_error_t *p_error )
+{
+    for (size_t i = 0; i < count; i++)
+    {
+
+        // Initialized data
+        double u  = in_q0[i].u, x = in_q0[i].i, y = in_q0[i].j, z = in_q0[i].k,
+               sx = in_scale[i].x, sy = in_scale[i].y, sz = in_scale[i].z,
+               ref[16] =
+               {
+                   (u * u + x * x - y * y - z * z) * sx, (2 * x * y + 2 * z * u) * sx        , (2 * x * z - 2 * y * u) * sx        , 0,
+                   (2 * x * y - 2 * z * u) * sy        , (u * u - x * x + y * y - z * z) * sy, (2 * y * z + 2 * x * u) * sy        , 0,
+                   (2 * x * z + 2 * y * u) * sz        , (2 * y * z - 2 * x * u) * sz        , (u * u - x * x - y * y + z * z) * sz, 0,
+                   in_location[i].x                    , in_location[i].y                    , in_location[i].z                    , 1
+               };
+
+        for (size_t r = 0; r < 4; r++)
+            measure(p_error, &out_m[i].a + r * 4, ref + r * 4, 4);
+    }
+}
+
+// Shared by the AoS and SoA slerps. Follows q_slerp, including its edge cases
+void error_q_slerp_of ( size_t count, bench_error_t *p_error, bool soa_layout )
+{
+    for (size_t i = 0; i < count; i++)
+    {
+
+        // Initialized data
+        double a[4] = { in_q0[i].u, in_q0[i].i, in_q0[i].j, in_q0[i].k },
+               b[4] = { in_q1[i].u, in_q1[i].i, in_q1[i].j, in_q1[i].k },
+               c    = a[0] * b[0] + a[1] * b[1] + a[2] * b[2] + a[3] * b[3],
+               s    = sqrt(1.0 - c * c),
+               h    = acos(c),
+               t    = BENCH_SLERP_T,
+               ra   = ( s < 0.001 ) ? 0.5 : sin((1.0 - t) * h) / s,
+               rb   = ( s < 0.001 ) ? 0.5 : sin(t * h) / s,
+               ref[4];
+        float  out[4];
+
+        // The branches of q_slerp are decided in single precision, so skip inputs near them
+        if ( fabs(c) >= 0.999 ) continue;
+
+        for (size_t j = 0; j < 4; j++)
+            ref[j] = a[j] * ra + b[j] * rb;
+
+        if ( soa_layout )
+            out[0] = out_q_soa.u[i], out[1] = out_q_soa.i[i], out[2] = out_q_soa.j[i], out[3] = out_q_soa.k[i];
+        else
+            out[0] = out_q[i].u, out[1] = out_q[i].i, out[2] = out_q[i].j, out[3] = out_q[i].k;
+
+        measure(p_error, out, ref, 4);
+    }
+}
+
+void error_q_slerp ( size_t count, bench_error_t *p_error )
+{
+    error_q_slerp_of(count, p_error, false);
+}
+
+void error_q_slerp_soa ( size_t count, bench_error_t *p_error )
+{
+    error_q_slerp_of(count, p_error, true);
+}
+
+void error_add_vec3 ( size_t count, bench_error_t *p_error )
+{
+    for (size_t i = 0; i < count; i++)
+    {
+
+        // Initialized data
+        double ref[3] =
+        {
+            (double) in_v3[i].x + in_location[i].x,
+            (double) in_v3[i].y + in_location[i].y,
+            (double) in_v3[i].z + in_location[i].z
+        };
+
+        measure(p_error, &out_v3[i].x, ref, 3);
+    }
+}
+
+void error_sub_vec3 ( size_t count, bench_error_t *p_error )
+{
+    for (size_t i = 0; i < count; i++)
+    {
+
+        // Initialized data
+        double ref[3] =
+        {
+            (double) in_v3[i].x - in_location[i].x,
+            (double) in_v3[i].y - in_location[i].y,
+            (double) in_v3[i].z - in_location[i].z
+        };
+
+        measure(p_error, &out_v3[i].x, ref, 3);
+    }
+}
+
+void error_dot_product_vec3 ( size_t count, bench_error_t *p_error )
+{
+    for (size_t i = 0; i < count; i++)
+    {
+
+        // Initialized data
+        double ref = (double) in_v3[i].x * in_location[i].x + (double) in_v3[i].y * in_location[i].y + (double) in_v3[i].z * in_location[i].z;
+
+        measure(p_error, &out_f[i], &ref, 1);
+    }
+}
+
+void error_cross_product_vec3 ( size_t count, bench_error_t *p_error )
+{
+    for (size_t i = 0; i < count; i++)
+    {
+
+        // Initialized data
+        double a[3]   = { in_v3[i].x, in_v3[i].y, in_v3[i].z },
+               b[3]   = { in_location[i].x, in_location[i].y, in_location[i].z },
+               ref[3] =
+               {
+                   a[1] * b[2] - a[2] * b[1],
+                   a[2] * b[0] - a[0] * b[2],
+                   a[0] * b[1] - a[1] * b[0]
+               };
+
+        measure(p_error, &out_v3[i].x, ref, 3);
+    }
+}
+
+void error_length ( size_t count, bench_error_t *p_error )
+{
+    for (size_t i = 0; i < count; i++)
+    {
+
+        // Initialized data
+        double ref = sqrt((double) in_v3[i].x * in_v3[i].x + (double) in_v3[i].y * in_v3[i].y + (double) in_v3[i].z * in_v3[i].z);
+
+        measure(p_error, &out_f[i], &ref, 1);
+    }
+}
+
+void error_mul_mat2_vec2 ( size_t count, bench_error_t *p_error )
+{
+    for (size_t i = 0; i < count; i++)
+    {
+
+        // Initialized data
+        const mat2 *m      = &in_m2[i];
+        const vec2 *v      = &in_v2[i];
+        double      ref[2] =
+        {
+            (double) m->a * v->x + (double) m->b * v->y,
+            (double) m->c * v->x + (double) m->d * v->y
+        };
+
+        measure(p_error, &out_v2[i].x, ref, 2);
+    }
+}
+
+void error_mul_mat2_mat2 ( size_t count, bench_error_t *p_error )
+{
+    for (size_t i = 0; i < count; i++)
+    {
+
+        // Initialized data
+        const mat2 *m      = &in_m2[i],
+                   *n      = &in_n2[i];
+        double      ref[4] =
+        {
+            (double) m->a * n->a + (double) m->b * n->c, (double) m->a * n->b + (double) m->b * n->d,
+            (double) m->c * n->a + (double) m->d * n->c, (double) m->c * n->b + (double) m->d * n->d
+        };
+
+        // Measure each row on its own scale
+        for (size_t r = 0; r < 2; r++)
+            measure(p_error, &out_m2[i].a + r * 2, ref + r * 2, 2);
+    }
+}
+
+// rcp_mat2 and rcp_mat4 transpose
+void error_rcp_mat2 ( size_t count, bench_error_t *p_error )
+{
+    for (size_t i = 0; i < count; i++)
+    {
+
+        // Initialized data
+        double ref[4] = { in_m2[i].a, in_m2[i].c, in_m2[i].b, in_m2[i].d };
+
+        measure(p_error, &out_m2[i].a, ref, 4);
+    }
+}
+
+void error_rcp_mat4 ( size_t count, bench_error_t *p_error )
+{
+    for (size_t i = 0; i < count; i++)
+    {
+
+        // Initialized data
+        const float *m = &in_m[i].a;
+        double       ref[16];
+
+        for (size_t r = 0; r < 4; r++)
+            for (size_t c = 0; c < 4; c++)
+                ref[r * 4 + c] = m[c * 4 + r];
+
+        for (size_t r = 0; r < 4; r++)
+            measure(p_error, &out_m[i].a + r * 4, ref + r * 4, 4);
+    }
+}
+
+void error_rotation_mat4_from_quaternion ( size_t count, bench_error_t *p_error )
+{
+    for (size_t i = 0; i < count; i++)
+    {
+
+        // Initialized data
+        double u = in_q0[i].u, x = in_q0[i].i, y = in_q0[i].j, z = in_q0[i].k,
+               ref[16] =
+               {
+                   u * u + x * x - y * y - z * z, 2 * x * y + 2 * z * u        , 2 * x * z - 2 * y * u        , 0,
+                   2 * x * y - 2 * z * u        , u * u - x * x + y * y - z * z, 2 * y * z + 2 * x * u        , 0,
+                   2 * x * z + 2 * y * u        , 2 * y * z - 2 * x * u        , u * u - x * x - y * y + z * z, 0,
+                   0                            , 0                            , 0                            , 1
+               };
+
+        for (size_t r = 0; r < 4; r++)
+            measure(p_error, &out_m[i].a + r * 4, ref + r * 4, 4);
+    }
+}
+
+// rotate_vec3_by_quaternion returns the direction of the rotated vector
+void error_rotate_vec3_by_quaternion ( size_t count, bench_error_t *p_error )
+{
+    for (size_t i = 0; i < count; i++)
+    {
+
+        // Initialized data
+        double q[4]         = { in_q0[i].u, in_q0[i].i, in_q0[i].j, in_q0[i].k },
+               conjugate[4] = { q[0], -q[1], -q[2], -q[3] },
+               p[4]         = { 0, in_v3[i].x, in_v3[i].y, in_v3[i].z },
+               qp[4], ref[4], l;
+
+        multiply_quaternion_d(qp, q, p);
+        multiply_quaternion_d(ref, qp, conjugate);
+
+        l = sqrt(ref[1] * ref[1] + ref[2] * ref[2] + ref[3] * ref[3]);
+
+        // Skip vectors too short to have a direction
+        if ( l < 1e-3 ) continue;
+
+        for (size_t j = 1; j < 4; j++)
+            ref[j] /= l;
+
+        measure(p_error, &out_v3[i].x, ref + 1, 3);
+    }
+}
+
+void error_quaternion_from_euler_angle ( size_t count, bench_error_t *p_error )
+{
+    for (size_t i = 0; i < count; i++)
+    {
+
+        // Initialized data
+        double h      = acos(-1.0) / 360.0,
+               sx     = sin(in_euler[i].x * h), cx = cos(in_euler[i].x * h),
+               sy     = sin(in_euler[i].y * h), cy = cos(in_euler[i].y * h),
+               sz     = sin(in_euler[i].z * h), cz = cos(in_euler[i].z * h),
+               ref[4] =
+               {
+                   cz * cx * cy + sz * sx * sy,
+                   sz * cx * cy - cz * sx * sy,
+                   cz * sx * cy + sz * cx * sy,
+                   cz * cx * sy - sz * sx * cy
+               };
+        float  out[4] = { out_q[i].u, out_q[i].i, out_q[i].j, out_q[i].k };
+
+        measure(p_error, out, ref, 4);
+    }
+}
+
+// Kernel table
+bench_kernel_t kernels[] =
+{
+
+    // By value
+    { "normalize"                          , 12 , run_normalize                       , error_normalize                      },
+    { "mul_mat4_vec4"                      , 28 , run_mul_mat4_vec4                   , error_mul_mat4_vec4                  },
+    { "mul_mat4_mat4"                      , 112, run_mul_mat4_mat4                   , error_mul_mat4_mat4                  },
+    { "inverse_mat4"                       , 140, run_inverse_mat4                    , error_inverse_mat4                   },
+    { "affine_inverse_mat4"                , 45 , run_affine_inverse_mat4             , error_affine_inverse_mat4            },
+    { "multiply_quaternion_quaternion"     , 28 , run_multiply_quaternion_quaternion  , error_multiply_quaternion_quaternion },
+    { "q_slerp"                            , 30 , run_q_slerp                         , error_q_slerp                        },
+    { "add_vec3"                           , 3  , run_add_vec3                        , error_add_vec3                       },
+    { "sub_vec3"                           , 3  , run_sub_vec3                        , error_sub_vec3                       },
+    { "dot_product_vec3"                   , 5  , run_dot_product_vec3                , error_dot_product_vec3               },
+    { "cross_product_vec3"                 , 9  , run_cross_product_vec3              , error_cross_product_vec3             },
+    { "length"                             , 6  , run_length                          , error_length                         },
+    { "mul_mat2_vec2"                      , 6  , run_mul_mat2_vec2                   , error_mul_mat2_vec2                  },
+    { "mul_mat2_mat2"                      , 12 , run_mul_mat2_mat2                   , error_mul_mat2_mat2                  },
+    { "rcp_mat2"                           , 0  , run_rcp_mat2                        , error_rcp_mat2                       },
+    { "rcp_mat4"                           , 0  , run_rcp_mat4                        , error_rcp_mat4                       },
+    { "rotation_mat4_from_quaternion"      , 38 , run_rotation_mat4_from_quaternion   , error_rotation_mat4_from_quaternion  },
+    { "rotate_vec3_by_quaternion"          , 65 , run_rotate_vec3_by_quaternion       , error_rotate_vec3_by_quaternion      },
+    { "quaternion_from_euler_angle"        , 38 , run_quaternion_from_euler_angle     , error_quaternion_from_euler_angle    },
+
+    // Pointer
+    { "normalize_p"                        , 12 , run_normalize_p                     , error_normalize                      },
+    { "mul_mat4_vec4_p"                    , 28 , run_mul_mat4_vec4_p                 , error_mul_mat4_vec4                  },
+    { "mul_mat4_mat4_p"                    , 112, run_mul_mat4_mat4_p                 , error_mul_mat4_mat4                  },
+    { "inverse_mat4_p"                     , 140, run_inverse_mat4_p                  , error_inverse_mat4                   },
+    { "affine_inverse_mat4_p"              , 45 , run_affine_inverse_mat4_p           , error_affine_inverse_mat4            },
+    { "multiply_quaternion_quaternion_p"   , 28 , run_multiply_quaternion_quaternion_p, error_multiply_quaternion_quaternion },
+
+    // Batch
+    { "mul_mat4_vec4_batch"                , 28 , run_mul_mat4_vec4_batch             , error_mul_mat4_vec4_batch            },
+    { "mul_mat4_vec4_batch_soa"            , 28 , run_mul_mat4_vec4_batch_soa         , error_mul_mat4_vec4_batch_soa        },
+    { "mul_mat4_mat4_batch"                , 112, run_mul_mat4_mat4_batch             , error_mul_mat4_mat4                  },
+    { "inverse_mat4_batch"                 , 140, run_inverse_mat4_batch              , error_inverse_mat4                   },
+    { "affine_inverse_mat4_batch"          , 45 , run_affine_inverse_mat4_batch       , error_affine_inverse_mat4            },
+    { "normal_mat4_batch"                  , 27 , run_normal_mat4_batch               , error_normal_mat4                    },
+    { "normalize_quaternion_batch"         , 12 , run_normalize_quaternion_batch      , error_normalize_quaternion           },
+    { "normalize_quaternion_batch_soa"     , 12 , run_normalize_quaternion_batch_soa  , error_normalize_quaternion_soa       },
+    { "model_mat4_from_trs_batch"          , 40 , run_model_mat4_from_trs_batch       , error_model_mat4_from_trs            },
+    { "model_mat4_from_trs_batch_soa"      , 40 , run_model_mat4_from_trs_batch_soa   , error_model_mat4_from_trs            },
+    { "q_slerp_batch"                      , 30 , run_q_slerp_batch                   , error_q_slerp                        },
+    { "q_slerp_batch_soa"                  , 30 , run_q_slerp_batch_soa               , error_q_slerp_soa                    }
+};
+
+#define KERNEL_COUNT ( sizeof(kernels) / sizeof(*kernels) )
+
+// Backend table
+const char *backend_names[] =
+{
+    [linear_backend_scalar] = "scalar",
+    [linear_backend_sse41]  = "sse4.1",
+    [linear_backend_avx2]   = "avx2",
+    [linear_backend_neon]   = "neon"
+};
+
+#define BACKEND_COUNT ( sizeof(backend_names) / sizeof(*backend_names) )
+
+// Entry point
+int main ( int argc, const char *argv[] )
+{
+
+    // Initialized data
+    GXInstance_t     *p_instance   = 0;
+    FILE             *p_f          = stdout;
+    const char       *backend_name = 0,
+                     *output_path  = 0;
+    size_t            count        = BENCH_COUNT,
+                      iterations   = BENCH_ITERATIONS,
+                      run_count    = 0,
+                      runs_done    = 0;
+    bool              run[BACKEND_COUNT] = { 0 };
+    linear_backend_t  best         = linear_backend_scalar;
+
+    // Parse command line arguments
+    for ( int i = 1; i < argc; i++ )
+    {
+
+        // Number of elements per kernel
+        if ( strcmp("-count", argv[i]) == 0 && i + 1 < argc )
+            count = (size_t) strtoull(argv[++i], 0, 10);
+
+        // Number of timed runs per kernel
+        else if ( strcmp("-iterations", argv[i]) == 0 && i + 1 < argc )
+            iterations = (size_t) strtoull(argv[++i], 0, 10);
+
+        // Run a single backend
+        else if ( strcmp("-backend", argv[i]) == 0 && i + 1 < argc )
+            backend_name = argv[++i];
+
+        // Write the report to a file
+        else if ( strcmp("-o", argv[i]) == 0 && i + 1 < argc )
+            output_path = argv[++i];
+
+        // Usage
+        else
+        {
+            printf("Usage: %s [-count N] [-iterations N] [-backend scalar|sse4.1|avx2|neon] [-o report.json]\n", argv[0]);
+
+            // Error
+            return EXIT_FAILURE;
+        }
+    }
+
+    // Create a headless instance. This picks the best backend for this machine
+    if ( g_init_headless(&p_instance) == 0 )
+    {
+
+        // Write an error message
+        (void) g_print_error("[G10] Failed to initialize G10 in call to function \"%s\"\n", __FUNCTION__);
+
+        // Error
+        return EXIT_FAILURE;
+    }
+
+    // At least one element and one run
+    if ( count      == 0 ) count      = 1;
+    if ( iterations == 0 ) iterations = 1;
+
+    // Every machine runs scalar, and AVX2 machines also run SSE4.1
+    best                         = get_linear_backend();
+    run[linear_backend_scalar]   = true;
+    run[best]                    = true;
+    run[linear_backend_sse41]   |= ( best == linear_backend_avx2 );
+
+    // Keep only the backend that was asked for
+    for (size_t i = 0; i < BACKEND_COUNT; i++)
+    {
+        if ( backend_name && strcmp(backend_name, backend_names[i]) ) run[i] = false;
+
+        run_count += run[i];
+    }
+
+    // Unknown or unsupported backend
+    if ( run_count == 0 )
+    {
+        (void) g_print_error("[G10] Backend \"%s\" is unknown or unsupported in call to function \"%s\"\n", backend_name, __FUNCTION__);
+
+        // Error
+        return EXIT_FAILURE;
+    }
+
+    // Make the inputs
+    if ( allocate_inputs(count) == 0 )
+    {
+        (void) g_print_error("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+
+        // Error
+        return EXIT_FAILURE;
+    }
+
+    // Open the output
+    if ( output_path )
+    {
+        p_f = fopen(output_path, "w");
+
+        // Error check
+        if ( p_f == (void *) 0 )
+        {
+            (void) g_print_error("[G10] Failed to open \"%s\" in call to function \"%s\"\n", output_path, __FUNCTION__);
+
+            // Error
+            return EXIT_FAILURE;
+        }
+    }
+
+    // Report header
+    fprintf(p_f, "{\n");
+    fprintf(p_f, "    \"count\" : %zu,\n", count);
+    fprintf(p_f, "    \"iterations\" : %zu,\n", iterations);
+    fprintf(p_f, "    \"backends\" : [\n");
+
+    // Run each backend
+    for (size_t i = 0; i < BACKEND_COUNT; i++)
+        if ( run[i] )
+            (void) run_backend((linear_backend_t) i, count, iterations, p_f, ++runs_done == run_count);
+
+    // Report footer
+    fprintf(p_f, "    ]\n");
+    fprintf(p_f, "}\n");
+
+    // Restore the best backend
+    (void) set_linear_backend(best);
+
+    // Free the inputs
+    free_inputs();
+
+    // Close the output
+    if ( p_f != stdout )
+        fclose(p_f);
+
+    // Success
+    return EXIT_SUCCESS;
+}
+
+int run_backend ( linear_backend_t backend, size_t count, size_t iterations, FILE *p_f, bool last )
+{
+
+    // Initialized data
+    double frequency = (double) SDL_GetPerformanceFrequency();
+
+    // Switch backends
+    if ( set_linear_backend(backend) == 0 ) return 0;
+
+    fprintf(p_f, "        {\n");
+    fprintf(p_f, "            \"name\" : \"%s\",\n", backend_names[backend]);
+    fprintf(p_f, "            \"kernels\" : [\n");
+
+    // Time each kernel
+    for (size_t k = 0; k < KERNEL_COUNT; k++)
+    {
+
+        // Initialized data
+        double        best  = DBL_MAX;
+        bench_error_t error = { 0 };
+
+        // Warm the caches, then keep the fastest run
+        kernels[k].run(count);
+
+        for (size_t i = 0; i < iterations; i++)
+        {
+
+            // Initialized data
+            u64 t0 = SDL_GetPerformanceCounter(),
+                t1 = 0;
+
+            kernels[k].run(count);
+
+            t1 = SDL_GetPerformanceCounter();
+
+            if ( (double) (t1 - t0) / frequency < best )
+                best = (double) (t1 - t0) / frequency;
+        }
+
+        // Compare the last run to the reference
+        kernels[k].error(count, &error);
+
+        fprintf(p_f, "                {\n");
+        fprintf(p_f, "                    \"name\" : \"%s\",\n", kernels[k].name);
+        fprintf(p_f, "                    \"ns per op\" : %f,\n", best * 1e9 / (double) count);
+        fprintf(p_f, "                    \"gflops\" : %f,\n", ( best > 0 ) ? kernels[k].flops * (double) count / best * 1e-9 : 0.0);
+        fprintf(p_f, "                    \"max ulp\" : %f,\n", error.max);
+        fprintf(p_f, "                    \"mean ulp\" : %f\n", ( error.count ) ? error.sum / (double) error.count : 0.0);
+        fprintf(p_f, "                }%s\n", ( k + 1 < KERNEL_COUNT ) ? "," : "");
+    }
+
+    fprintf(p_f, "            ]\n");
+    fprintf(p_f, "        }%s\n", ( last ) ? "" : ",");
+
+    // Success
+    return 1;
+}
+
+float random_float ( float min, float max )
+{
+    return min + ( max - min ) * ( (float) rand() / (float) RAND_MAX );
+}
+
+void measure ( bench_error_t *p_error, const float *r, const double *ref, size_t n )
+{
+
+    // Initialized data
+    double scale = 0,
+           ulp   = 0;
+
+    // Errors are in units in the last place of the largest component, so cancellation in small components doesn't inflate them
+    for (size_t i = 0; i < n; i++)
+        scale = fmax(scale, fabs(ref[i]));
+
+    ulp = ( scale > 0 ) ? ldexp(1.0, ilogb(scale) - ( FLT_MANT_DIG - 1 )) : FLT_MIN;
+
+    for (size_t i = 0; i < n; i++)
+    {
+
+        // Initialized data
+        double e = fabs((double) r[i] - ref[i]) / ulp;
+
+        // NaN is the worst error
+        if ( isnan(e) ) e = INFINITY;
+
+        p_error->max    = fmax(p_error->max, e);
+        p_error->sum   += e;
+        p_error->count += 1;
+    }
+}
+
+bool inverse_mat4_d ( double *r, const double *m )
+{
+
+    // Initialized data
+    double a[4][8];
+
+    // Gauss Jordan elimination with partial pivoting on [ m | I ]
+    for (size_t i = 0; i < 4; i++)
+        for (size_t j = 0; j < 4; j++)
+            a[i][j] = m[i * 4 + j], a[i][j + 4] = ( i == j );
+
+    for (size_t c = 0; c < 4; c++)
+    {
+
+        // Initialized data
+        size_t p = c;
+
+        for (size_t i = c + 1; i < 4; i++)
+            if ( fabs(a[i][c]) > fabs(a[p][c]) ) p = i;
+
+        // Singular
+        if ( a[p][c] == 0.0 ) return false;
+
+        for (size_t j = 0; j < 8; j++)
+        {
+            double t = a[c][j];
+            a[c][j]  = a[p][j];
+            a[p][j]  = t;
+        }
+
+        // Scale the pivot row
+        {
+            double d = a[c][c];
+
+            for (size_t j = 0; j < 8; j++)
+                a[c][j] /= d;
+        }
+
+        // Eliminate the column from the other rows
+
+        for (size_t i = 0; i < 4; i++)
+        {
+            double f = a[i][c];
+
+            if ( i == c ) continue;
+
+            for (size_t j = 0; j < 8; j++)
+                a[i][j] -= f * a[c][j];
+        }
+    }
+
+    for (size_t i = 0; i < 4; i++)
+        for (size_t j = 0; j < 4; j++)
+            r[i * 4 + j] = a[i][j + 4];
+
+    // Success
+    return true;
+}
+
+void multiply_quaternion_d ( double *r, const double *a, const double *b )
+{
+
+    // Same convention as multiply_quaternion_quaternion
+    r[0] = a[0] * b[0] - a[1] * b[1] - a[2] * b[2] - a[3] * b[3],
+    r[1] = a[0] * b[1] + a[1] * b[0] + a[2] * b[3] - a[3] * b[2],
+    r[2] = a[0] * b[2] + a[2] * b[0] + a[3] * b[1] - a[1] * b[3],
+    r[3] = a[0] * b[3] + a[3] * b[0] + a[1] * b[2] - a[2] * b[1];
+}
+
+int allocate_inputs ( size_t count )
+{
+
+    // Initialized data
+    size_t n = count;
+
+    // Arrays of structures
+    in_m        = G10_REALLOC(0, n * sizeof(mat4));
+    in_n        = G10_REALLOC(0, n * sizeof(mat4));
+    in_model    = G10_REALLOC(0, n * sizeof(mat4));
+    out_m       = G10_REALLOC(0, n * sizeof(mat4));
+    in_v        = G10_REALLOC(0, n * sizeof(vec4));
+    out_v       = G10_REALLOC(0, n * sizeof(vec4));
+    in_v3       = G10_REALLOC(0, n * sizeof(vec3));
+    out_v3      = G10_REALLOC(0, n * sizeof(vec3));
+    in_location = G10_REALLOC(0, n * sizeof(vec3));
+    in_scale    = G10_REALLOC(0, n * sizeof(vec3));
+    in_q0       = G10_REALLOC(0, n * sizeof(quaternion));
+    in_q1       = G10_REALLOC(0, n * sizeof(quaternion));
+    out_q       = G10_REALLOC(0, n * sizeof(quaternion));
+    in_euler    = G10_REALLOC(0, n * sizeof(vec3));
+    in_v2       = G10_REALLOC(0, n * sizeof(vec2));
+    out_v2      = G10_REALLOC(0, n * sizeof(vec2));
+    in_m2       = G10_REALLOC(0, n * sizeof(mat2));
+    in_n2       = G10_REALLOC(0, n * sizeof(mat2));
+    out_m2      = G10_REALLOC(0, n * sizeof(mat2));
+    out_f       = G10_REALLOC(0, n * sizeof(float));
+
+    // Structures of arrays. 26 arrays of count floats
+    soa         = G10_REALLOC(0, 26 * n * sizeof(float));
+
+    // Error check
+    if ( !( in_m && in_n && in_model && out_m && in_v && out_v && in_v3 && out_v3 && in_location && in_scale && in_q0 && in_q1 && out_q && soa ) ) return 0;
+    if ( !( in_euler && in_v2 && out_v2 && in_m2 && in_n2 && out_m2 && out_f ) ) return 0;
+
+    in_v_soa        = (vec4_soa)       { soa +  0 * n, soa +  1 * n, soa +  2 * n, soa +  3 * n };
+    out_v_soa       = (vec4_soa)       { soa +  4 * n, soa +  5 * n, soa +  6 * n, soa +  7 * n };
+    in_q0_soa       = (quaternion_soa) { soa +  8 * n, soa +  9 * n, soa + 10 * n, soa + 11 * n };
+    in_q1_soa       = (quaternion_soa) { soa + 12 * n, soa + 13 * n, soa + 14 * n, soa + 15 * n };
+    out_q_soa       = (quaternion_soa) { soa + 16 * n, soa + 17 * n, soa + 18 * n, soa + 19 * n };
+    in_location_soa = (vec3_soa)       { soa + 20 * n, soa + 21 * n, soa + 22 * n, 0 };
+    in_scale_soa    = (vec3_soa)       { soa + 23 * n, soa + 24 * n, soa + 25 * n, 0 };
+
+    // Same inputs on every run
+    srand(1);
+
+    for (size_t i = 0; i < n; i++)
+    {
+
+        // Initialized data
+        quaternion q[2] = { 0 };
+
+        // Random matrices and vectors
+        for (size_t j = 0; j < 16; j++)
+        {
+            (&in_m[i].a)[j] = random_float(-1.f, 1.f);
+
+            // Diagonally dominant, so the general inverse is well conditioned
+            (&in_n[i].a)[j] = random_float(-1.f, 1.f) + ( ( j % 5 == 0 ) ? 4.f : 0.f );
+        }
+
+        in_v[i]  = (vec4) { random_float(-1.f, 1.f), random_float(-1.f, 1.f), random_float(-1.f, 1.f), random_float(-1.f, 1.f) };
+        in_v3[i] = (vec3) { random_float(-1.f, 1.f), random_float(-1.f, 1.f), random_float(-1.f, 1.f), 0.f };
+        in_v2[i] = (vec2) { random_float(-1.f, 1.f), random_float(-1.f, 1.f) };
+        in_m2[i] = (mat2) { random_float(-1.f, 1.f), random_float(-1.f, 1.f), random_float(-1.f, 1.f), random_float(-1.f, 1.f) };
+        in_n2[i] = (mat2) { random_float(-1.f, 1.f), random_float(-1.f, 1.f), random_float(-1.f, 1.f), random_float(-1.f, 1.f) };
+
+        // Random angles, in degrees
+        in_euler[i] = (vec3) { random_float(-180.f, 180.f), random_float(-180.f, 180.f), random_float(-180.f, 180.f), 0.f };
+
+        // Random unit quaternions
+        for (size_t j = 0; j < 2; j++)
+        {
+
+            // Initialized data
+            float l = 0.f;
+
+            do
+            {
+                q[j] = (quaternion) { random_float(-1.f, 1.f), random_float(-1.f, 1.f), random_float(-1.f, 1.f), random_float(-1.f, 1.f) };
+                l    = sqrtf(q[j].u * q[j].u + q[j].i * q[j].i + q[j].j * q[j].j + q[j].k * q[j].k);
+            } while ( l < 0.1f );
+
+            q[j] = (quaternion) { q[j].u / l, q[j].i / l, q[j].j / l, q[j].k / l };
+        }
+
+        in_q0[i] = q[0];
+        in_q1[i] = q[1];
+
+        // Random model matrices
+        in_location[i] = (vec3) { random_float(-10.f, 10.f), random_float(-10.f, 10.f), random_float(-10.f, 10.f), 0.f };
+        in_scale[i]    = (vec3) { random_float(0.5f, 2.f), random_float(0.5f, 2.f), random_float(0.5f, 2.f), 0.f };
+
+        // Copy to the structures of arrays
+        in_v_soa.x[i] = in_v[i].x, in_v_soa.y[i] = in_v[i].y, in_v_soa.z[i] = in_v[i].z, in_v_soa.w[i] = in_v[i].w;
+        in_q0_soa.u[i] = q[0].u, in_q0_soa.i[i] = q[0].i, in_q0_soa.j[i] = q[0].j, in_q0_soa.k[i] = q[0].k;
+        in_q1_soa.u[i] = q[1].u, in_q1_soa.i[i] = q[1].i, in_q1_soa.j[i] = q[1].j, in_q1_soa.k[i] = q[1].k;
+        in_location_soa.x[i] = in_location[i].x, in_location_soa.y[i] = in_location[i].y, in_location_soa.z[i] = in_location[i].z;
+        in_scale_soa.x[i]    = in_scale[i].x   , in_scale_soa.y[i]    = in_scale[i].y   , in_scale_soa.z[i]    = in_scale[i].z;
+    }
+
+    // Build the model matrices with the scalar backend
+    {
+
+        // Initialized data
+        linear_backend_t backend = get_linear_backend();
+
+        (void) set_linear_backend(linear_backend_scalar);
+        model_mat4_from_trs_batch(in_model, in_location, in_q0, in_scale, n);
+        (void) set_linear_backend(backend);
+    }
+
+    // Success
+    return 1;
+}
+
+void free_inputs ( void )
+{
+    free(in_m);
+    free(in_n);
+    free(in_model);
+    free(out_m);
+    free(in_v);
+    free(out_v);
+    free(in_v3);
+    free(out_v3);
+    free(in_location);
+    free(in_scale);
+    free(in_q0);
+    free(in_q1);
+    free(out_q);
+    free(in_euler);
+    free(in_v2);
+    free(out_v2);
+    free(in_m2);
+    free(in_n2);
+    free(out_m2);
+    free(out_f);
+    free(soa);
+}
@@ -0,0 +1,232 @@
+/** !
+ * @file G10 mesh optimizer
+ *
+ * Reads a PLY file, welds its vertices, simplifies it into levels of detail,
+ * orders its triangles for the vertex cache and for overdraw, orders its
+ * vertices for fetch, splits it into meshlets, and writes a G10 mesh file.
+ * Reports the vertex cache before and after, each level of detail, and the
+ * meshlets, as JSON.
+ *
+ * @author Jacob C Smith
+*/
+
+// Standard library
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// G10
+#include <G10/G10.h>
+#include <G10/GXMesh.h>
+
+// Defaults
+#define MESHOPT_THRESHOLD  1.05f
+#define MESHOPT_LOD_ERRORS "0.005,0.02,0.08"
+
+// Vertex cache statistics of a mesh
+struct meshopt_stats_s
+{
+    size_t vertices,
+           triangles;
+    float  acmr,
+           atvr;
+};
+typedef struct meshopt_stats_s meshopt_stats_t;
+
+//////////////////////////
+// Forward declarations //
+//////////////////////////
+
+// Utility functions
+int measure_mesh ( GXMesh_t *p_mesh, size_t cache_size, meshopt_stats_t *p_stats );
+int print_stats  ( FILE *p_f, const char *name, meshopt_stats_t *p_stats, bool last );
+
+// Entry point
+int main ( int argc, const char *argv[] )
+{
+
+    // Initialized data
+    GXMesh_t        *p_mesh      = 0;
+    FILE            *p_f         = stdout;
+    const char      *input_path  = 0,
+                    *mesh_path   = 0,
+                    *output_path = 0,
+                    *lod_errors  = MESHOPT_LOD_ERRORS;
+    char            *next        = 0;
+    size_t           cache_size  = MESH_CACHE_SIZE;
+    float            threshold   = MESHOPT_THRESHOLD;
+    meshopt_stats_t  before      = { 0 },
+                     after       = { 0 };
+
+    // Parse command line arguments
+    for ( int i = 1; i < argc; i++ )
+    {
+
+        // Size of the simulated vertex cache
+        if ( strcmp("-cache", argv[i]) == 0 && i + 1 < argc )
+            cache_size = (size_t) strtoull(argv[++i], 0, 10);
+
+        // How much worse the vertex cache may get to reduce overdraw
+        else if ( strcmp("-threshold", argv[i]) == 0 && i + 1 < argc )
+            threshold = strtof(argv[++i], 0);
+
+        // The error of each level of detail, as fractions of the radius of the mesh
+        else if ( strcmp("-lod-error", argv[i]) == 0 && i + 1 < argc )
+            lod_errors = argv[++i];
+
+        // Write the report to a file
+        else if ( strcmp("-o", argv[i]) == 0 && i + 1 < argc )
+            output_path = argv[++i];
+
+        // The PLY file, then the mesh file
+        else if ( input_path == 0 && argv[i][0] != '-' )
+            input_path = argv[i];
+
+        else if ( mesh_path == 0 && argv[i][0] != '-' )
+            mesh_path = argv[i];
+
+        // Usage
+        else
+            goto usage;
+    }
+
+    // Error check
+    if ( input_path == 0 || mesh_path == 0 || cache_size == 0 ) goto usage;
+
+    // Load the mesh
+    if ( load_mesh_as_ply(&p_mesh, input_path) == 0 )
+    {
+        (void) g_print_error("[G10] Failed to load \"%s\" in call to function \"%s\"\n", input_path, __FUNCTION__);
+
+        // Error
+        return EXIT_FAILURE;
+    }
+
+    (void) measure_mesh(p_mesh, cache_size, &before);
+
+    // Weld the mesh
+    if ( weld_mesh(p_mesh) == 0 ) goto failed_to_optimize_mesh;
+
+    // Simplify each level of detail from the one before it
+    for ( const char *p = lod_errors; *p && p_mesh->lod_count < MESH_MAX_LODS; p = next )
+    {
+
+        // Initialized data
+        float target_error = strtof(p, &next);
+
+        // Error check
+        if ( next == p ) goto usage;
+
+        if ( simplify_mesh(p_mesh, target_error, 0) == 0 ) goto failed_to_optimize_mesh;
+
+        // Skip the comma
+        if ( *next == ',' ) next++;
+    }
+
+    // Optimize every level of detail
+    if ( optimize_mesh_vertex_cache(p_mesh, cache_size)        == 0 ) goto failed_to_optimize_mesh;
+    if ( optimize_mesh_overdraw(p_mesh, cache_size, threshold) == 0 ) goto failed_to_optimize_mesh;
+    if ( optimize_mesh_vertex_fetch(p_mesh)                    == 0 ) goto failed_to_optimize_mesh;
+
+    // Split the first level of detail into meshlets
+    if ( build_mesh_meshlets(p_mesh, MESHLET_MAX_VERTICES, MESHLET_MAX_TRIANGLES) == 0 ) goto failed_to_optimize_mesh;
+
+    (void) measure_mesh(p_mesh, cache_size, &after);
+
+    // Write the mesh
+    if ( save_mesh(p_mesh, mesh_path) == 0 )
+    {
+        (void) g_print_error("[G10] Failed to write \"%s\" in call to function \"%s\"\n", mesh_path, __FUNCTION__);
+
+        // Error
+        return EXIT_FAILURE;
+    }
+
+    // Open the output
+    if ( output_path )
+    {
+        p_f = fopen(output_path, "w");
+
+        // Error check
+        if ( p_f == (void *) 0 )
+        {
+            (void) g_print_error("[G10] Failed to open \"%s\" in call to function \"%s\"\n", output_path, __FUNCTION__);
+
+            // Error
+            return EXIT_FAILURE;
+        }
+    }
+
+    // Report
+    fprintf(p_f, "{\n");
+    fprintf(p_f, "    \"input\" : \"%s\",\n", input_path);
+    fprintf(p_f, "    \"output\" : \"%s\",\n", mesh_path);
+    fprintf(p_f, "    \"cache size\" : %zu,\n", cache_size);
+    fprintf(p_f, "    \"threshold\" : %f,\n", threshold);
+    fprintf(p_f, "    \"index size\" : %d,\n", ( p_mesh->vertex_count < 65536 ) ? 2 : 4);
+    (void) print_stats(p_f, "before", &before, false);
+    (void) print_stats(p_f, "after", &after, false);
+    fprintf(p_f, "    \"lods\" : [\n");
+
+    for (size_t i = 0; i < p_mesh->lod_count; i++)
+        fprintf(p_f, "        { \"triangles\" : %u, \"error\" : %f }%s\n", p_mesh->lods[i].index_count / 3, p_mesh->lods[i].error, ( i + 1 < p_mesh->lod_count ) ? "," : "");
+
+    fprintf(p_f, "    ],\n");
+    fprintf(p_f, "    \"meshlets\" : %zu,\n", p_mesh->meshlet_count);
+    fprintf(p_f, "    \"meshlet vertices\" : %zu\n", p_mesh->meshlet_vertex_count);
+    fprintf(p_f, "}\n");
+
+    // Close the output
+    if ( p_f != stdout )
+        fclose(p_f);
+
+    // Clean up
+    (void) destroy_mesh(&p_mesh);
+
+    // Success
+    return EXIT_SUCCESS;
+
+    // Usage
+    usage:
+        printf("Usage: %s input.ply output.g10mesh [-cache N] [-threshold F] [-lod-error F,F,...] [-o report.json]\n", argv[0]);
+
+        // Clean up
+        (void) destroy_mesh(&p_mesh);
+
+        // Error
+        return EXIT_FAILURE;
+
+    // Error handling
+    failed_to_optimize_mesh:
+        (void) g_print_error("[G10] Failed to optimize \"%s\" in call to function \"%s\"\n", input_path, __FUNCTION__);
+
+        // Clean up
+        (void) destroy_mesh(&p_mesh);
+
+        // Error
+        return EXIT_FAILURE;
+}
+
+int measure_mesh ( GXMesh_t *p_mesh, size_t cache_size, meshopt_stats_t *p_stats )
+{
+
+    // Count vertices, and the triangles of the first level of detail
+    p_stats->vertices  = p_mesh->vertex_count,
+    p_stats->triangles = p_mesh->lods[0].index_count / 3;
+
+    // Simulate the vertex cache
+    return analyze_mesh_vertex_cache(p_mesh, cache_size, &p_stats->acmr, &p_stats->atvr);
+}
+
+int print_stats ( FILE *p_f, const char *name, meshopt_stats_t *p_stats, bool last )
+{
+    fprintf(p_f, "    \"%s\" : {\n", name);
+    fprintf(p_f, "        \"vertices\" : %zu,\n", p_stats->vertices);
+    fprintf(p_f, "        \"triangles\" : %zu,\n", p_stats->triangles);
+    fprintf(p_f, "        \"acmr\" : %f,\n", p_stats->acmr);
+    fprintf(p_f, "        \"atvr\" : %f\n", p_stats->atvr);
+    fprintf(p_f, "    }%s\n", ( last ) ? "" : ",");
+
+    // Success
+    return 1;
+}
@@ -0,0 +1,602 @@
+/** !
+ * @file G10 physics benchmark
+ *
+ * Steps canonical physics scenes without a window or GPU, and reports
+ * steps per second, per phase timings, and peak memory as JSON.
+ *
+ * @author Jacob C Smith
+*/
+
+// Standard library
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Peak memory
+#ifdef _WIN32
+    #include <windows.h>
+    #include <psapi.h>
+#else
+    #include <sys/resource.h>
+#endif
+
+// G10
+#include <G10/G10.h>
+#include <G10/GXEntity.h>
+#include <G10/GXTransform.h>
+#include <G10/GXCollider.h>
+#include <G10/GXRigidbody.h>
+#include <G10/GXPhysics.h>
+
+// Defaults
+#define BENCH_FRAMES      600
+#define BENCH_DELTA_TIME  ( 1.f / 60.f )
+#define BENCH_GRAVITY     -9.81f
+#define BENCH_MAX_THREADS NARROWPHASE_MAX_THREADS
+
+// Phases
+enum bench_phase_e
+{
+    phase_broadphase  = 0,
+    phase_narrowphase = 1,
+    phase_solve       = 2,
+    phase_integrate   = 3,
+    phase_count       = 4
+};
+
+// A scene under test
+struct bench_scene_s
+{
+    const char  *name;
+    GXEntity_t **entities;
+    size_t       entity_count,
+                 entity_max;
+};
+typedef struct bench_scene_s bench_scene_t;
+
+// Narrowphase worker
+struct bench_worker_s
+{
+    SDL_Thread *thread;
+    SDL_sem    *go,
+               *done;
+    bool        running;
+};
+typedef struct bench_worker_s bench_worker_t;
+
+//////////////////////////
+// Forward declarations //
+//////////////////////////
+
+// Scenes
+int build_box_stack        ( bench_scene_t *p_scene );
+int build_sphere_pile      ( bench_scene_t *p_scene );
+int build_ragdoll_crowd    ( bench_scene_t *p_scene );
+int build_projectile_field ( bench_scene_t *p_scene );
+
+// Utility functions
+int    add_body             ( bench_scene_t *p_scene, vec3 location, vec3 scale, collider_type_t type, float mass, vec3 velocity );
+int    destroy_scene_bodies ( bench_scene_t *p_scene );
+int    run_scene            ( GXInstance_t *p_instance, bench_scene_t *p_scene, size_t frames, bench_worker_t *p_workers, size_t worker_count, FILE *p_f, bool last );
+int    narrowphase_work     ( void *vp_worker );
+size_t peak_memory          ( void );
+
+// Scene table
+const char *scene_names[] =
+{
+    "box stack",
+    "sphere pile",
+    "ragdoll crowd",
+    "projectile field"
+};
+
+int (*scene_builders[])( bench_scene_t *p_scene ) =
+{
+    &build_box_stack,
+    &build_sphere_pile,
+    &build_ragdoll_crowd,
+    &build_projectile_field
+};
+
+const char *phase_names[phase_count] =
+{
+    "broadphase",
+    "narrowphase",
+    "solve",
+    "integrate"
+};
+
+#define SCENE_COUNT ( sizeof(scene_names) / sizeof(*scene_names) )
+
+// Entry point
+int main ( int argc, const char *argv[] )
+{
+
+    // Initialized data
+    GXInstance_t   *p_instance   = 0;
+    FILE           *p_f          = stdout;
+    const char     *scene_name   = 0,
+                   *output_path  = 0;
+    size_t          frames       = BENCH_FRAMES,
+                    thread_count = 0,
+                    run_count    = 0,
+                    runs_done    = 0;
+    bench_worker_t  workers[BENCH_MAX_THREADS] = { 0 };
+
+    // Parse command line arguments
+    for ( int i = 1; i < argc; i++ )
+    {
+
+        // Number of frames to step
+        if ( strcmp("-frames", argv[i]) == 0 && i + 1 < argc )
+            frames = (size_t) strtoull(argv[++i], 0, 10);
+
+        // Number of narrowphase threads
+        else if ( strcmp("-threads", argv[i]) == 0 && i + 1 < argc )
+            thread_count = (size_t) strtoull(argv[++i], 0, 10);
+
+        // Run a single scene
+        else if ( strcmp("-scene", argv[i]) == 0 && i + 1 < argc )
+            scene_name = argv[++i];
+
+        // Write the report to a file
+        else if ( strcmp("-o", argv[i]) == 0 && i + 1 < argc )
+            output_path = argv[++i];
+
+        // Usage
+        else
+        {
+            printf("Usage: %s [-frames N] [-threads N] [-scene \"name\"] [-o report.json]\n", argv[0]);
+
+            // Error
+            return EXIT_FAILURE;
+        }
+    }
+
+    // Create a headless instance
+    if ( g_init_headless(&p_instance) == 0 )
+    {
+
+        // Write an error message
+        (void) g_print_error("[G10] Failed to initialize G10 in call to function \"%s\"\n", __FUNCTION__);
+
+        // Error
+        return EXIT_FAILURE;
+    }
+
+    // Fixed time step
+    p_instance->time.delta_time = BENCH_DELTA_TIME;
+
+    // Default to one narrowphase thread per core
+    if ( thread_count == 0 )
+        thread_count = (size_t) SDL_GetCPUCount();
+
+    if ( thread_count > BENCH_MAX_THREADS )
+        thread_count = BENCH_MAX_THREADS;
+
+    if ( thread_count == 0 )
+        thread_count = 1;
+
+    // Start the narrowphase workers. The main thread is the last worker
+    for (size_t i = 0; i < thread_count - 1; i++)
+    {
+        workers[i].go      = SDL_CreateSemaphore(0);
+        workers[i].done    = SDL_CreateSemaphore(0);
+        workers[i].running = true;
+        workers[i].thread  = SDL_CreateThread(narrowphase_work, "Narrowphase", &workers[i]);
+    }
+
+    // Open the output
+    if ( output_path )
+    {
+        p_f = fopen(output_path, "w");
+
+        // Error check
+        if ( p_f == (void *) 0 )
+        {
+            (void) g_print_error("[G10] Failed to open \"%s\" in call to function \"%s\"\n", output_path, __FUNCTION__);
+
+            // Error
+            return EXIT_FAILURE;
+        }
+    }
+
+    // Count the scenes to run
+    for (size_t i = 0; i < SCENE_COUNT; i++)
+        run_count += ( scene_name == 0 || strcmp(scene_name, scene_names[i]) == 0 );
+
+    // Unknown scene
+    if ( run_count == 0 )
+    {
+        (void) g_print_error("[G10] Unknown scene \"%s\" in call to function \"%s\"\n", scene_name, __FUNCTION__);
+
+        // Error
+        return EXIT_FAILURE;
+    }
+
+    // Report header
+    fprintf(p_f, "{\n");
+    fprintf(p_f, "    \"frames\" : %zu,\n", frames);
+    fprintf(p_f, "    \"threads\" : %zu,\n", thread_count);
+    fprintf(p_f, "    \"delta time\" : %f,\n", BENCH_DELTA_TIME);
+    fprintf(p_f, "    \"scenes\" : [\n");
+
+    // Run each scene
+    for (size_t i = 0; i < SCENE_COUNT; i++)
+    {
+
+        // Initialized data
+        bench_scene_t scene = { .name = scene_names[i] };
+
+        // Skip scenes that weren't asked for
+        if ( scene_name && strcmp(scene_name, scene_names[i]) ) continue;
+
+        // Build the scene
+        if ( scene_builders[i](&scene) == 0 )
+        {
+            (void) g_print_error("[G10] Failed to build scene \"%s\" in call to function \"%s\"\n", scene.name, __FUNCTION__);
+
+            // Error
+            return EXIT_FAILURE;
+        }
+
+        // Step the scene
+        (void) run_scene(p_instance, &scene, frames, workers, thread_count - 1, p_f, ++runs_done == run_count);
+
+        // Destroy the scene
+        (void) destroy_scene_bodies(&scene);
+    }
+
+    // Report footer
+    fprintf(p_f, "    ],\n");
+    fprintf(p_f, "    \"peak memory\" : %zu\n", peak_memory());
+    fprintf(p_f, "}\n");
+
+    // Stop the narrowphase workers
+    for (size_t i = 0; i < thread_count - 1; i++)
+    {
+        workers[i].running = false;
+        SDL_SemPost(workers[i].go);
+        SDL_WaitThread(workers[i].thread, 0);
+        SDL_DestroySemaphore(workers[i].go);
+        SDL_DestroySemaphore(workers[i].done);
+    }
+
+    // Close the output
+    if ( p_f != stdout )
+        fclose(p_f);
+
+    // Success
+    return EXIT_SUCCESS;
+}
+
+int narrowphase_work ( void *vp_worker )
+{
+
+    // Initialized data
+    bench_worker_t *p_worker = vp_worker;
+
+    // Run until told otherwise
+    for (;;)
+    {
+
+        // Wait for a frame
+        SDL_SemWait(p_worker->go);
+
+        // Done
+        if ( p_worker->running == false ) break;
+
+        // Claim chunks until there are none left
+        (void) detect_collisions(g_get_active_instance());
+
+        // Tell the main thread
+        SDL_SemPost(p_worker->done);
+    }
+
+    // Success
+    return 1;
+}
+
+int run_scene ( GXInstance_t *p_instance, bench_scene_t *p_scene, size_t frames, bench_worker_t *p_workers, size_t worker_count, FILE *p_f, bool last )
+{
+
+    // Initialized data
+    double clock_div               = (double) p_instance->time.clock_div,
+           phase_time[phase_count] = { 0 },
+           total_time              = 0;
+    size_t manifold_count          = 0;
+
+    // Step the scene
+    for (size_t f = 0; f < frames; f++)
+    {
+
+        // Initialized data
+        u64 t[phase_count + 1] = { 0 };
+
+        // Broadphase
+        t[0] = SDL_GetPerformanceCounter();
+        (void) detect_broadphase(p_instance, p_scene->entities, p_scene->entity_count);
+
+        // Narrowphase
+        t[1] = SDL_GetPerformanceCounter();
+
+        for (size_t i = 0; i < worker_count; i++)
+            SDL_SemPost(p_workers[i].go);
+
+        (void) detect_collisions(p_instance);
+
+        for (size_t i = 0; i < worker_count; i++)
+            SDL_SemWait(p_workers[i].done);
+
+        // Solve
+        t[2] = SDL_GetPerformanceCounter();
+        (void) solve_collisions(p_instance);
+
+        // Integrate
+        t[3] = SDL_GetPerformanceCounter();
+
+        for (size_t i = 0; i < p_scene->entity_count; i++)
+        {
+
+            // Initialized data
+            GXEntity_t    *p_entity    = p_scene->entities[i];
+            GXRigidbody_t *p_rigidbody = p_entity->rigidbody;
+
+            // Skip static bodies
+            if ( p_rigidbody->mass == 0.f ) continue;
+
+            // Apply gravity
+            p_rigidbody->forces[0] = (vec3) { 0.f, 0.f, BENCH_GRAVITY * p_rigidbody->mass, 0.f };
+
+            (void) move_entity(p_entity);
+        }
+
+        t[4] = SDL_GetPerformanceCounter();
+
+        // Accumulate
+        for (size_t i = 0; i < phase_count; i++)
+            phase_time[i] += (double) ( t[i + 1] - t[i] ) / clock_div;
+
+        total_time     += (double) ( t[4] - t[0] ) / clock_div;
+        manifold_count += get_narrowphase_manifolds(0);
+
+        // Tick
+        p_instance->time.ticks++;
+    }
+
+    // Write the report
+    fprintf(p_f, "        {\n");
+    fprintf(p_f, "            \"name\" : \"%s\",\n", p_scene->name);
+    fprintf(p_f, "            \"entities\" : %zu,\n", p_scene->entity_count);
+    fprintf(p_f, "            \"steps per second\" : %f,\n", ( total_time > 0 ) ? (double) frames / total_time : 0.0);
+    fprintf(p_f, "            \"manifolds per step\" : %f,\n", ( frames ) ? (double) manifold_count / (double) frames : 0.0);
+    fprintf(p_f, "            \"phases\" : {\n");
+
+    for (size_t i = 0; i < phase_count; i++)
+        fprintf(p_f, "                \"%s\" : %f%s\n", phase_names[i], ( frames ) ? phase_time[i] * 1000.0 / (double) frames : 0.0, ( i + 1 < phase_count ) ? "," : "");
+
+    fprintf(p_f, "            }\n");
+    fprintf(p_f, "        }%s\n", ( last ) ? "" : ",");
+
+    // Success
+    return 1;
+}
+
+int add_body ( bench_scene_t *p_scene, vec3 location, vec3 scale, collider_type_t type, float mass, vec3 velocity )
+{
+
+    // Initialized data
+    GXEntity_t *p_entity = 0;
+
+    // Grow the entity list
+    if ( p_scene->entity_count == p_scene->entity_max )
+    {
+
+        // Initialized data
+        size_t       new_max      = ( p_scene->entity_max ) ? p_scene->entity_max * 2 : 256;
+        GXEntity_t **new_entities = realloc(p_scene->entities, new_max * sizeof(GXEntity_t *));
+
+        // Error check
+        if ( new_entities == (void *) 0 ) return 0;
+
+        p_scene->entities   = new_entities,
+        p_scene->entity_max = new_max;
+    }
+
+    // Allocate the entity and its components
+    if ( create_entity(&p_entity)                                                                 == 0 ) return 0;
+    if ( construct_transform(&p_entity->transform, location, (quaternion) { 1.f, 0.f, 0.f, 0.f }, scale) == 0 ) return 0;
+    if ( create_collider(&p_entity->collider)                                                     == 0 ) return 0;
+    if ( create_rigidbody(&p_entity->rigidbody)                                                   == 0 ) return 0;
+
+    // A unit cube, scaled by the transform
+    p_entity->collider->type           = type;
+    p_entity->collider->model_matrix   = &p_entity->transform->model_matrix;
+    p_entity->collider->aabb.aabb_min  = (vec3) { -1.f, -1.f, -1.f, 0.f };
+    p_entity->collider->aabb.aabb_max  = (vec3) {  1.f,  1.f,  1.f, 0.f };
+
+    // Rigidbody
+    p_entity->rigidbody->mass          = mass;
+    p_entity->rigidbody->active        = ( mass > 0.f );
+    p_entity->rigidbody->velocity      = velocity;
+    p_entity->rigidbody->forces        = calloc(1, sizeof(vec3));
+    p_entity->rigidbody->force_count   = 1;
+
+    // Error check
+    if ( p_entity->rigidbody->forces == (void *) 0 ) return 0;
+
+    // Add the entity to the scene
+    p_scene->entities[p_scene->entity_count++] = p_entity;
+
+    // Success
+    return 1;
+}
+
+int destroy_scene_bodies ( bench_scene_t *p_scene )
+{
+
+    // Iterate over each entity
+    for (size_t i = 0; i < p_scene->entity_count; i++)
+    {
+
+        // Initialized data
+        GXEntity_t *p_entity = p_scene->entities[i];
+
+        // Destroy the entity. Rigidbodies and colliders go back to their pools
+        (void) destroy_entity(&p_entity);
+    }
+
+    // Free the entity list
+    free(p_scene->entities);
+
+    *p_scene = (bench_scene_t) { 0 };
+
+    // Success
+    return 1;
+}
+
+size_t peak_memory ( void )
+{
+
+    #ifdef _WIN32
+
+        // Initialized data
+        PROCESS_MEMORY_COUNTERS counters = { 0 };
+
+        // Get the peak working set
+        if ( GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)) == 0 ) return 0;
+
+        // Success
+        return (size_t) counters.PeakWorkingSetSize;
+    #else
+
+        // Initialized data
+        struct rusage usage = { 0 };
+
+        // Get the peak resident set
+        if ( getrusage(RUSAGE_SELF, &usage) ) return 0;
+
+        // Success
+        #ifdef __APPLE__
+            return (size_t) usage.ru_maxrss;
+        #else
+            return (size_t) usage.ru_maxrss * 1024;
+        #endif
+    #endif
+}
+
+// Ground plane shared by the scenes
+static int add_ground ( bench_scene_t *p_scene, float half_extent )
+{
+
+    // Success
+    return add_body(p_scene, (vec3) { 0.f, 0.f, -1.f, 0.f }, (vec3) { half_extent, half_extent, 1.f, 0.f }, collider_box, 0.f, (vec3) { 0 });
+}
+
+int build_box_stack ( bench_scene_t *p_scene )
+{
+
+    // Ground
+    if ( add_ground(p_scene, 64.f) == 0 ) return 0;
+
+    // 16 towers of 16 unit boxes
+    for (size_t x = 0; x < 4; x++)
+        for (size_t y = 0; y < 4; y++)
+            for (size_t z = 0; z < 16; z++)
+                if ( add_body(p_scene, (vec3) { x * 4.f, y * 4.f, 0.5f + z * 1.01f, 0.f }, (vec3) { 0.5f, 0.5f, 0.5f, 0.f }, collider_box, 1.f, (vec3) { 0 }) == 0 ) return 0;
+
+    // Success
+    return 1;
+}
+
+int build_sphere_pile ( bench_scene_t *p_scene )
+{
+
+    // Ground
+    if ( add_ground(p_scene, 64.f) == 0 ) return 0;
+
+    // 10,000 spheres
+    for (size_t z = 0; z < 16; z++)
+        for (size_t y = 0; y < 25; y++)
+            for (size_t x = 0; x < 25; x++)
+                if ( add_body(p_scene, (vec3) { x * 1.05f - 12.6f + ( z & 1 ) * 0.5f, y * 1.05f - 12.6f, 0.5f + z * 1.05f, 0.f }, (vec3) { 0.5f, 0.5f, 0.5f, 0.f }, collider_sphere, 1.f, (vec3) { 0 }) == 0 ) return 0;
+
+    // Success
+    return 1;
+}
+
+int build_ragdoll_crowd ( bench_scene_t *p_scene )
+{
+
+    // Initialized data
+    const struct { vec3 location, scale; float mass; } parts[] =
+    {
+        { {  0.00f, 0.f, 1.30f }, { 0.20f, 0.12f, 0.30f }, 30.f }, // Torso
+        { {  0.00f, 0.f, 1.75f }, { 0.12f, 0.12f, 0.12f },  5.f }, // Head
+        { { -0.32f, 0.f, 1.45f }, { 0.12f, 0.06f, 0.06f },  2.f }, // Upper arms
+        { {  0.32f, 0.f, 1.45f }, { 0.12f, 0.06f, 0.06f },  2.f },
+        { { -0.56f, 0.f, 1.45f }, { 0.12f, 0.05f, 0.05f },  1.f }, // Forearms
+        { {  0.56f, 0.f, 1.45f }, { 0.12f, 0.05f, 0.05f },  1.f },
+        { { -0.10f, 0.f, 0.78f }, { 0.07f, 0.07f, 0.22f },  7.f }, // Thighs
+        { {  0.10f, 0.f, 0.78f }, { 0.07f, 0.07f, 0.22f },  7.f },
+        { { -0.10f, 0.f, 0.28f }, { 0.06f, 0.06f, 0.24f },  4.f }, // Shins
+        { {  0.10f, 0.f, 0.28f }, { 0.06f, 0.06f, 0.24f },  4.f },
+        { {  0.00f, 0.f, 0.98f }, { 0.18f, 0.10f, 0.06f },  8.f }, // Pelvis
+    };
+
+    // Ground
+    if ( add_ground(p_scene, 64.f) == 0 ) return 0;
+
+    // 256 ragdolls. There is no joint solver yet, so each part is a free body
+    for (size_t x = 0; x < 16; x++)
+        for (size_t y = 0; y < 16; y++)
+            for (size_t i = 0; i < sizeof(parts) / sizeof(*parts); i++)
+            {
+
+                // Initialized data
+                vec3 location =
+                {
+                    parts[i].location.x + x * 1.5f - 12.f,
+                    parts[i].location.y + y * 1.5f - 12.f,
+                    parts[i].location.z + 0.05f,
+                    0.f
+                };
+
+                if ( add_body(p_scene, location, parts[i].scale, collider_box, parts[i].mass, (vec3) { 0 }) == 0 ) return 0;
+            }
+
+    // Success
+    return 1;
+}
+
+int build_projectile_field ( bench_scene_t *p_scene )
+{
+
+    // Initialized data
+    u32 seed = 0x6a09e667;
+
+    // Ground
+    if ( add_ground(p_scene, 128.f) == 0 ) return 0;
+
+    // 256 static targets
+    for (size_t x = 0; x < 16; x++)
+        for (size_t y = 0; y < 16; y++)
+            if ( add_body(p_scene, (vec3) { x * 8.f - 60.f, y * 8.f - 60.f, 2.f, 0.f }, (vec3) { 1.f, 1.f, 2.f, 0.f }, collider_box, 0.f, (vec3) { 0 }) == 0 ) return 0;
+
+    // 4096 fast projectiles, with deterministic directions
+    for (size_t i = 0; i < 4096; i++)
+    {
+
+        // Initialized data
+        float r[3];
+
+        for (size_t j = 0; j < 3; j++)
+            seed = seed * 1664525u + 1013904223u,
+            r[j] = (float) ( seed >> 8 ) / (float) ( 1u << 24 ) * 2.f - 1.f;
+
+        if ( add_body(p_scene, (vec3) { r[0] * 100.f, r[1] * 100.f, 4.f + ( r[2] + 1.f ) * 8.f, 0.f }, (vec3) { 0.05f, 0.05f, 0.05f, 0.f }, collider_sphere, 0.01f, (vec3) { r[1] * 200.f, -r[0] * 200.f, 0.f, 0.f }) == 0 ) return 0;
+    }
+
+    // Success
+    return 1;
+}
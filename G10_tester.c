@@ -63,6 +63,10 @@ size_t   load_file    ( const char   *path    , void        *buffer, bool binary
 
 void test_ai ( char *name );
 void test_linear ( char *name );
+void test_transform ( char *name );
+void test_handle ( char *name );
+void test_pool ( char *name );
+void test_snapshot ( char *name );
 
 // AI
 bool test_allocate_ai       ( GXAI_t **pp_ai, result_t expected );
@@ -89,6 +93,7 @@ bool test_mul_mat2_mat2           ( mat2 m, mat2 n, mat2 expected );
 bool test_mul_mat4_mat4           ( mat4 m, mat4 n, mat4 expected );
 bool test_rcp_mat2                ( mat2 m, mat2 expected );
 bool test_rcp_mat4                ( mat4 m, mat4 expected );
+bool test_inverse_mat4            ( mat4 m, mat4 expected );
 bool test_identity_mat2           ( mat2 expected );
 bool test_identity_mat4           ( mat4 expected );
 bool test_translation_mat4              ( vec3 location, mat4 expected );
@@ -96,6 +101,32 @@ bool test_scale_mat4              ( vec3 scale, mat4 expected );
 bool test_rotation_mat4_from_vec3 ( vec3 rotation, mat4 expected );
 bool test_model_mat4_from_vec3    ( vec3 location, vec3 rotation, vec3 scale, mat4 expected );
 
+// Transform
+bool transform_order_valid          ( GXTransformHierarchy_t *p_hierarchy );
+bool test_transform_world_matrix    ( vec3 parent_location, vec3 child_location, vec3 expected );
+bool test_transform_reparent        ( void );
+bool test_transform_remove_parent   ( void );
+bool test_transform_remove_subtree  ( void );
+
+// Handle
+bool test_handle_resolve         ( void );
+bool test_handle_stale           ( void );
+bool test_handle_reuse           ( void );
+bool test_handle_release_stale   ( void );
+
+// Pool
+bool test_pool_alloc             ( size_t object_size, size_t slab_objects, size_t count );
+bool test_pool_reuse             ( void );
+bool test_pool_no_growth         ( size_t count );
+bool test_pool_release           ( void );
+
+// Snapshot
+bool snapshot_fixture            ( GXScene_t *p_scene, GXEntity_t **pp_entities, size_t count );
+void snapshot_teardown           ( GXScene_t *p_scene, GXEntity_t **pp_entities, size_t count );
+bool test_snapshot_restore       ( size_t count );
+bool test_snapshot_delta         ( size_t count );
+bool test_snapshot_corrupt       ( void );
+
 GXInstance_t *p_instance = 0;
 
 // Entry point
@@ -121,6 +152,15 @@ int run_tests ( void )
     // Test the FSA
     test_ai("ai");
 
+    // Test generational handles
+    test_handle("handle");
+
+    // Test the object pool
+    test_pool("pool");
+
+    // Test snapshots and deltas
+    test_snapshot("snapshot");
+
     // Test audio
     //test_audio("audio");
 
@@ -185,7 +225,7 @@ int run_tests ( void )
     //test_texture("texture");
 
     // Test the transform
-    //test_transform("transform");
+    test_transform("transform");
 
     // Test the user code task
     //test_user_code("user code");
@@ -283,6 +323,7 @@ void test_linear ( char *name )
     print_test(name, "IDENTITY_MAT4()                 -> <<1,0,0,0>, <0,1,0,0>, <0,1,0,0>, <0,0,0,1>>", test_identity_mat4 ( (mat4) {.a = 1.f, .b = 0.f, .c = 0.f, .d = 0.f, .e = 0.f, .f = 1.f, .g = 0.f, .h = 0.f, .i = 0.f, .j = 0.f, .k = 1.f, .l = 0.f, .m = 0.f, .n = 0.f, .o = 0.f, .p = 1.f} ));
     print_test(name, "TRANSLATION_MAT4(<2, 7, 2>)     -> <<1,0,0,0>, <0,1,0,0>, <0,1,0,0>, <2,7,2,1>>", test_translation_mat4 ( (vec3) {.x = 2.f, .y = 7.f, .z = 2.f}, (mat4) {.a = 1.f, .b = 0.f, .c = 0.f, .d = 0.f, .e = 0.f, .f = 1.f, .g = 0.f, .h = 0.f, .i = 0.f, .j = 0.f, .k = 1.f, .l = 0.f, .m = 2.f, .n = 7.f, .o = 2.f, .p = 1.f} ));
     print_test(name, "SCALE_MAT(<3, 4, 5>)            -> <<3,0,0,0>, <0,4,0,0>, <0,0,5,0>, <0,0,0,0>>", test_scale_mat4 ( (vec3) {.x = 3.f, .y = 4.f, .z = 5.f}, (mat4) {.a = 3.f, .b = 0.f, .c = 0.f, .d = 0.f, .e = 0.f, .f = 4.f, .g = 0.f, .h = 0.f, .i = 0.f, .j = 0.f, .k = 5.f, .l = 0.f, .m = 0.f, .n = 0.f, .o = 0.f, .p = 1.f} ));
+    print_test(name, "INVERSE_MAT4(<<2,0,0,0>, <0,4,0,0>, <0,0,8,0>, <2,4,8,1>>) -> <<0.5,0,0,0>, <0,0.25,0,0>, <0,0,0.125,0>, <-1,-1,-1,1>>", test_inverse_mat4 ( (mat4) {.a = 2.f, .b = 0.f, .c = 0.f, .d = 0.f, .e = 0.f, .f = 4.f, .g = 0.f, .h = 0.f, .i = 0.f, .j = 0.f, .k = 8.f, .l = 0.f, .m = 2.f, .n = 4.f, .o = 8.f, .p = 1.f}, (mat4) {.a = 0.5f, .b = 0.f, .c = 0.f, .d = 0.f, .e = 0.f, .f = 0.25f, .g = 0.f, .h = 0.f, .i = 0.f, .j = 0.f, .k = 0.125f, .l = 0.f, .m = -1.f, .n = -1.f, .o = -1.f, .p = 1.f} ));
 
     // TODO:
     // test_mul_mat4_vec4           ( mat4 m, vec4 v, vec4 expected );
@@ -298,6 +339,77 @@ void test_linear ( char *name )
     return;
 }
 
+void test_handle ( char *name )
+{
+
+    // Output
+    printf("Scenario: %s\n", name);
+
+    print_test(name, "acquire, then resolve                  -> the object"                 , test_handle_resolve());
+    print_test(name, "release, then resolve                  -> null"                       , test_handle_stale());
+    print_test(name, "release, then acquire                  -> same slot, new generation"  , test_handle_reuse());
+    print_test(name, "release a stale handle                 -> error"                      , test_handle_release_stale());
+
+    print_final_summary();
+
+    // Success
+    return;
+}
+
+void test_pool ( char *name )
+{
+
+    // Output
+    printf("Scenario: %s\n", name);
+
+    print_test(name, "alloc 17 objects of 40 bytes, 8 a slab -> aligned, distinct, 3 slabs" , test_pool_alloc(40, 8, 17));
+    print_test(name, "alloc 1 object of 1 byte, 1 a slab     -> aligned, distinct, 1 slab"  , test_pool_alloc(1, 1, 1));
+    print_test(name, "free, then alloc                       -> the same object, zeroed"    , test_pool_reuse());
+    print_test(name, "free 100, then alloc 100               -> no new slabs"               , test_pool_no_growth(100));
+    print_test(name, "release, then calloc without an arena  -> the same object, zeroed"    , test_pool_release());
+
+    print_final_summary();
+
+    // Success
+    return;
+}
+
+void test_snapshot ( char *name )
+{
+
+    // Output
+    printf("Scenario: %s\n", name);
+
+    print_test(name, "take 1, move, restore                  -> the state that was taken"   , test_snapshot_restore(1));
+    print_test(name, "take 64, move, restore                 -> the state that was taken"   , test_snapshot_restore(64));
+    print_test(name, "delta of 1, then apply to the base     -> the same bytes"             , test_snapshot_delta(1));
+    print_test(name, "delta of 64, then apply to the base    -> the same bytes"             , test_snapshot_delta(64));
+    print_test(name, "restore a corrupt snapshot             -> error, and no change"       , test_snapshot_corrupt());
+
+    print_final_summary();
+
+    // Success
+    return;
+}
+
+void test_transform ( char *name )
+{
+
+    // Output
+    printf("Scenario: %s\n", name);
+
+    print_test(name, "parent <1, 2, 3>, child <1, 0, 0>      -> world <2, 2, 3>"            , test_transform_world_matrix((vec3){ .x = 1.f, .y = 2.f, .z = 3.f }, (vec3){ .x = 1.f, .y = 0.f, .z = 0.f }, (vec3){ .x = 2.f, .y = 2.f, .z = 3.f }));
+    print_test(name, "parent <0, 0, 0>, child <4, 5, 6>      -> world <4, 5, 6>"            , test_transform_world_matrix((vec3){ .x = 0.f, .y = 0.f, .z = 0.f }, (vec3){ .x = 4.f, .y = 5.f, .z = 6.f }, (vec3){ .x = 4.f, .y = 5.f, .z = 6.f }));
+    print_test(name, "reparent under a later root            -> depth first order"          , test_transform_reparent());
+    print_test(name, "remove a parent                        -> children become roots"      , test_transform_remove_parent());
+    print_test(name, "remove a subtree                       -> the rest is unchanged"      , test_transform_remove_subtree());
+
+    print_final_summary();
+
+    // Success
+    return;
+}
+
 /*
 void test_audio ( char *name )
 {
@@ -374,10 +486,6 @@ void test_shader ( char *name )
 void test_texture ( char *name )
 {
 
-}
-void test_transform ( char *name )
-{
-
 }
 void test_user_code ( char *name )
 {
@@ -573,6 +681,29 @@ bool test_rcp_mat4 ( mat4 m, mat4 expected )
 
     return false;
 }
+bool test_inverse_mat4 ( mat4 m, mat4 expected )
+{
+    // Initialized data
+    mat4 result = inverse_mat4(m);
+
+    // Return
+    return ( (result.a == expected.a) &&
+             (result.b == expected.b) &&
+             (result.c == expected.c) &&
+             (result.d == expected.d) &&
+             (result.e == expected.e) &&
+             (result.f == expected.f) &&
+             (result.g == expected.g) &&
+             (result.h == expected.h) &&
+             (result.i == expected.i) &&
+             (result.j == expected.j) &&
+             (result.k == expected.k) &&
+             (result.l == expected.l) &&
+             (result.m == expected.m) &&
+             (result.n == expected.n) &&
+             (result.o == expected.o) &&
+             (result.p == expected.p) );
+}
 bool test_identity_mat2 ( mat2 expected )
 {
     // Initialized data
@@ -664,6 +795,564 @@ bool test_model_mat4_from_vec3 ( vec3 location, vec3 rotation, vec3 scale, mat4
     return false;
 }
 
+bool test_handle_resolve ( void )
+{
+
+    // Initialized data
+    GXHandleTable_t *p_table  = 0;
+    int              object   = 0;
+    handle_t         handle   = HANDLE_INVALID;
+    bool             result   = false;
+
+    if ( create_handle_table(&p_table) == 0 ) return false;
+
+    handle = acquire_handle(p_table, &object);
+
+    result = ( handle != HANDLE_INVALID ) &&
+             ( resolve_handle(p_table, handle) == &object ) &&
+             ( resolve_handle(p_table, HANDLE_INVALID) == 0 );
+
+    destroy_handle_table(&p_table);
+
+    // Return
+    return result;
+}
+bool test_handle_stale ( void )
+{
+
+    // Initialized data
+    GXHandleTable_t *p_table  = 0;
+    int              object   = 0;
+    handle_t         handle   = HANDLE_INVALID;
+    bool             result   = false;
+
+    if ( create_handle_table(&p_table) == 0 ) return false;
+
+    handle = acquire_handle(p_table, &object);
+
+    result = ( release_handle(p_table, handle) == 1 ) &&
+             ( resolve_handle(p_table, handle) == 0 );
+
+    destroy_handle_table(&p_table);
+
+    // Return
+    return result;
+}
+bool test_handle_reuse ( void )
+{
+
+    // Initialized data
+    GXHandleTable_t *p_table  = 0;
+    int              a        = 0,
+                     b        = 0;
+    handle_t         stale    = HANDLE_INVALID,
+                     fresh    = HANDLE_INVALID;
+    bool             result   = false;
+
+    if ( create_handle_table(&p_table) == 0 ) return false;
+
+    stale = acquire_handle(p_table, &a);
+
+    release_handle(p_table, stale);
+
+    fresh = acquire_handle(p_table, &b);
+
+    // The slot is reused, and the stale copy does not see the new object
+    result = ( HANDLE_INDEX(fresh) == HANDLE_INDEX(stale) ) &&
+             ( HANDLE_GENERATION(fresh) != HANDLE_GENERATION(stale) ) &&
+             ( resolve_handle(p_table, fresh) == &b ) &&
+             ( resolve_handle(p_table, stale) == 0 );
+
+    destroy_handle_table(&p_table);
+
+    // Return
+    return result;
+}
+bool test_handle_release_stale ( void )
+{
+
+    // Initialized data
+    GXHandleTable_t *p_table  = 0;
+    int              a        = 0,
+                     b        = 0;
+    handle_t         stale    = HANDLE_INVALID,
+                     fresh    = HANDLE_INVALID;
+    bool             result   = false;
+
+    if ( create_handle_table(&p_table) == 0 ) return false;
+
+    stale = acquire_handle(p_table, &a);
+
+    release_handle(p_table, stale);
+
+    fresh = acquire_handle(p_table, &b);
+
+    // Releasing the stale copy again must not release the new object
+    result = ( release_handle(p_table, stale) == 0 ) &&
+             ( resolve_handle(p_table, fresh) == &b );
+
+    destroy_handle_table(&p_table);
+
+    // Return
+    return result;
+}
+
+bool test_pool_alloc ( size_t object_size, size_t slab_objects, size_t count )
+{
+
+    // Initialized data
+    GXPool_t  *p_pool  = 0;
+    void     **objects = calloc(count, sizeof(void *));
+    bool       result  = ( objects != 0 );
+
+    if ( result == false || create_pool(&p_pool, object_size, slab_objects) == 0 ) { free(objects); return false; }
+
+    for (size_t i = 0; i < count && result; i++)
+    {
+        objects[i] = pool_alloc(p_pool);
+
+        // Aligned
+        result = objects[i] && ( (uintptr_t) objects[i] % POOL_OBJECT_ALIGNMENT ) == 0;
+
+        // Distinct
+        for (size_t j = 0; j < i && result; j++)
+            result = ( objects[i] != objects[j] );
+    }
+
+    // Slabs are only added when the pool runs out
+    result = result && ( p_pool->slab_count == ( count + slab_objects - 1 ) / slab_objects );
+
+    destroy_pool(&p_pool);
+    free(objects);
+
+    // Return
+    return result;
+}
+bool test_pool_reuse ( void )
+{
+
+    // Initialized data
+    GXPool_t *p_pool = 0;
+    u8       *p      = 0,
+             *q      = 0;
+    bool      result = true;
+
+    if ( create_pool(&p_pool, 64, 0) == 0 ) return false;
+
+    p = pool_alloc(p_pool);
+
+    memset(p, 0xff, 64);
+
+    pool_free(p_pool, p);
+
+    q = pool_alloc(p_pool);
+
+    result = ( p == q );
+
+    // Zeroed
+    for (size_t i = 0; i < 64 && result; i++)
+        result = ( q[i] == 0 );
+
+    destroy_pool(&p_pool);
+
+    // Return
+    return result;
+}
+bool test_pool_no_growth ( size_t count )
+{
+
+    // Initialized data
+    GXPool_t  *p_pool       = 0;
+    void     **objects      = calloc(count, sizeof(void *));
+    size_t     object_count = 0;
+    bool       result       = ( objects != 0 );
+
+    if ( result == false || create_pool(&p_pool, 32, 16) == 0 ) { free(objects); return false; }
+
+    for (size_t i = 0; i < count; i++)
+        objects[i] = pool_alloc(p_pool);
+
+    object_count = p_pool->object_count;
+
+    for (size_t i = 0; i < count; i++)
+        pool_free(p_pool, objects[i]);
+
+    for (size_t i = 0; i < count; i++)
+        objects[i] = pool_alloc(p_pool);
+
+    result = ( p_pool->object_count == object_count );
+
+    destroy_pool(&p_pool);
+    free(objects);
+
+    // Return
+    return result;
+}
+bool test_pool_release ( void )
+{
+
+    // Initialized data
+    GXPool_t  *p_pool  = 0;
+    GXArena_t *p_arena = set_thread_arena(0);
+    u8        *p       = 0,
+              *q       = 0;
+    bool       result  = false;
+
+    p = pool_calloc(&p_pool, 48);
+
+    if ( p == 0 ) { set_thread_arena(p_arena); return false; }
+
+    memset(p, 0xff, 48);
+
+    pool_release(&p_pool, p);
+
+    q = pool_calloc(&p_pool, 48);
+
+    result = ( p == q );
+
+    // Zeroed
+    for (size_t i = 0; i < 48 && result; i++)
+        result = ( q[i] == 0 );
+
+    pool_release(&p_pool, q);
+
+    // Rebind the arena
+    set_thread_arena(p_arena);
+
+    // Return
+    return result;
+}
+
+bool snapshot_fixture ( GXScene_t *p_scene, GXEntity_t **pp_entities, size_t count )
+{
+
+    // Only the component storage of the scene is used
+    *p_scene = (GXScene_t) { .name = "snapshot" };
+
+    if ( create_component_storage(&p_scene->components) == 0 ) return false;
+
+    // Entities with a transform at <i, 2i, 3i>
+    for (size_t i = 0; i < count; i++)
+    {
+
+        // Initialized data
+        vec3 location = { .x = (float) i, .y = (float) ( 2 * i ), .z = (float) ( 3 * i ) },
+             scale    = { .x = 1.f, .y = 1.f, .z = 1.f };
+
+        if ( create_entity(&pp_entities[i]) == 0 ) return false;
+        if ( construct_transform(&pp_entities[i]->transform, location, identity_quaternion(), scale) == 0 ) return false;
+        if ( add_entity_components(p_scene->components, pp_entities[i]) == 0 ) return false;
+    }
+
+    // Success
+    return true;
+}
+void snapshot_teardown ( GXScene_t *p_scene, GXEntity_t **pp_entities, size_t count )
+{
+
+    // Destroy each entity
+    for (size_t i = 0; i < count; i++)
+        if ( pp_entities[i] )
+            destroy_entity(&pp_entities[i]);
+
+    destroy_component_storage(&p_scene->components);
+}
+bool test_snapshot_restore ( size_t count )
+{
+
+    // Initialized data
+    GXScene_t      scene       = { 0 };
+    GXEntity_t   **entities    = calloc(count, sizeof(GXEntity_t *));
+    GXSnapshot_t  *p_snapshot  = 0;
+    bool           result      = ( entities != 0 );
+
+    if ( result ) result = snapshot_fixture(&scene, entities, count) && create_snapshot(&p_snapshot);
+
+    if ( result ) result = take_snapshot(p_snapshot, &scene);
+
+    // Move every entity
+    for (size_t i = 0; i < count && result; i++)
+        entities[i]->transform->location.x += 100.f;
+
+    if ( result ) result = restore_snapshot(p_snapshot, &scene);
+
+    for (size_t i = 0; i < count && result; i++)
+        result = ( entities[i]->transform->location.x == (float) i ) &&
+                 ( entities[i]->transform->location.y == (float) ( 2 * i ) ) &&
+                 ( entities[i]->transform->location.z == (float) ( 3 * i ) );
+
+    destroy_snapshot(&p_snapshot);
+
+    if ( entities ) snapshot_teardown(&scene, entities, count);
+
+    free(entities);
+
+    // Return
+    return result;
+}
+bool test_snapshot_delta ( size_t count )
+{
+
+    // Initialized data
+    GXScene_t      scene       = { 0 };
+    GXEntity_t   **entities    = calloc(count, sizeof(GXEntity_t *));
+    GXSnapshot_t  *p_base      = 0,
+                  *p_snapshot  = 0,
+                  *p_delta     = 0,
+                  *p_decoded   = 0;
+    bool           result      = ( entities != 0 );
+
+    if ( result ) result = snapshot_fixture(&scene, entities, count);
+
+    if ( result ) result = create_snapshot(&p_base) && create_snapshot(&p_snapshot) && create_snapshot(&p_delta) && create_snapshot(&p_decoded);
+
+    if ( result ) result = take_snapshot(p_base, &scene);
+
+    // Move every other entity
+    for (size_t i = 0; i < count && result; i += 2)
+        entities[i]->transform->location.y -= 1.f;
+
+    if ( result ) result = take_snapshot(p_snapshot, &scene);
+
+    // Encode, then decode
+    if ( result ) result = encode_snapshot_delta(p_delta, p_base, p_snapshot);
+    if ( result ) result = apply_snapshot_delta(p_decoded, p_base, p_delta);
+
+    result = result &&
+             ( p_decoded->size == p_snapshot->size ) &&
+             ( memcmp(p_decoded->data, p_snapshot->data, p_snapshot->size) == 0 );
+
+    destroy_snapshot(&p_decoded);
+    destroy_snapshot(&p_delta);
+    destroy_snapshot(&p_snapshot);
+    destroy_snapshot(&p_base);
+
+    if ( entities ) snapshot_teardown(&scene, entities, count);
+
+    free(entities);
+
+    // Return
+    return result;
+}
+bool test_snapshot_corrupt ( void )
+{
+
+    // Initialized data
+    GXScene_t      scene       = { 0 };
+    GXEntity_t    *entities[4] = { 0 };
+    GXSnapshot_t  *p_snapshot  = 0;
+    u32            transforms  = 0;
+    bool           result      = snapshot_fixture(&scene, entities, 4) && create_snapshot(&p_snapshot);
+
+    if ( result ) result = take_snapshot(p_snapshot, &scene);
+
+    for (size_t i = 0; i < 4 && result; i++)
+        entities[i]->transform->location.x = -1.f;
+
+    // Claim one transform less than the masks hold. The count is the fourth field of the header
+    if ( result )
+    {
+        memcpy(&transforms, p_snapshot->data + 3 * sizeof(u32), sizeof(u32));
+
+        transforms--;
+
+        memcpy(p_snapshot->data + 3 * sizeof(u32), &transforms, sizeof(u32));
+    }
+
+    // The snapshot is rejected before any entity is written
+    if ( result ) result = ( restore_snapshot(p_snapshot, &scene) == 0 );
+
+    for (size_t i = 0; i < 4 && result; i++)
+        result = ( entities[i]->transform->location.x == -1.f );
+
+    destroy_snapshot(&p_snapshot);
+    snapshot_teardown(&scene, entities, 4);
+
+    // Return
+    return result;
+}
+
+bool transform_order_valid ( GXTransformHierarchy_t *p_hierarchy )
+{
+
+    // Check each transform
+    for (size_t i = 0; i < p_hierarchy->transform_count; i++)
+    {
+
+        // Initialized data
+        GXTransform_t *p_transform = p_hierarchy->transforms[i];
+        GXTransform_t *p_parent    = p_transform->parent;
+
+        // The index is the place in the list
+        if ( p_transform->index != i ) return false;
+
+        // The subtree fits in the list
+        if ( p_transform->subtree_size == 0 || i + p_transform->subtree_size > p_hierarchy->transform_count ) return false;
+
+        // Parents precede their children, and the parent's subtree holds the child's subtree
+        if ( p_parent && ( p_parent->index >= i || i + p_transform->subtree_size > p_parent->index + p_parent->subtree_size ) ) return false;
+    }
+
+    // Success
+    return true;
+}
+bool test_transform_world_matrix ( vec3 parent_location, vec3 child_location, vec3 expected )
+{
+
+    // Initialized data
+    GXTransformHierarchy_t *p_hierarchy = 0;
+    GXTransform_t          *p_parent    = 0,
+                           *p_child     = 0;
+    vec3                    scale       = { .x = 1.f, .y = 1.f, .z = 1.f };
+    bool                    result      = false;
+
+    if ( create_transform_hierarchy(&p_hierarchy) == 0 ) return false;
+
+    construct_transform(&p_parent, parent_location, identity_quaternion(), scale);
+    construct_transform(&p_child , child_location , identity_quaternion(), scale);
+
+    // Add the parent, then the child
+    add_transform(p_hierarchy, p_parent);
+    add_transform(p_hierarchy, p_child);
+    set_transform_parent(p_child, p_parent);
+    update_transforms(p_hierarchy);
+
+    result = ( p_child->model_matrix.m == expected.x ) &&
+             ( p_child->model_matrix.n == expected.y ) &&
+             ( p_child->model_matrix.o == expected.z ) &&
+             transform_order_valid(p_hierarchy);
+
+    destroy_transform(&p_child);
+    destroy_transform(&p_parent);
+    destroy_transform_hierarchy(&p_hierarchy);
+
+    // Return
+    return result;
+}
+bool test_transform_reparent ( void )
+{
+
+    // Initialized data
+    GXTransformHierarchy_t *p_hierarchy = 0;
+    GXTransform_t          *p_a         = 0,
+                           *p_b         = 0,
+                           *p_c         = 0;
+    vec3                    scale       = { .x = 1.f, .y = 1.f, .z = 1.f };
+    bool                    result      = false;
+
+    if ( create_transform_hierarchy(&p_hierarchy) == 0 ) return false;
+
+    construct_transform(&p_a, (vec3){ .x = 1.f, .y = 0.f, .z = 0.f }, identity_quaternion(), scale);
+    construct_transform(&p_b, (vec3){ .x = 0.f, .y = 1.f, .z = 0.f }, identity_quaternion(), scale);
+    construct_transform(&p_c, (vec3){ .x = 0.f, .y = 0.f, .z = 1.f }, identity_quaternion(), scale);
+
+    add_transform(p_hierarchy, p_a);
+    add_transform(p_hierarchy, p_b);
+    add_transform(p_hierarchy, p_c);
+    update_transforms(p_hierarchy);
+
+    // c -> a -> b, where c was added last
+    set_transform_parent(p_a, p_c);
+    set_transform_parent(p_b, p_a);
+    update_transforms(p_hierarchy);
+
+    result = transform_order_valid(p_hierarchy) &&
+             ( p_c->index == 0 && p_a->index == 1 && p_b->index == 2 ) &&
+             ( p_c->subtree_size == 3 && p_a->subtree_size == 2 && p_b->subtree_size == 1 ) &&
+             ( p_b->model_matrix.m == 1.f && p_b->model_matrix.n == 1.f && p_b->model_matrix.o == 1.f );
+
+    destroy_transform(&p_b);
+    destroy_transform(&p_a);
+    destroy_transform(&p_c);
+    destroy_transform_hierarchy(&p_hierarchy);
+
+    // Return
+    return result;
+}
+bool test_transform_remove_parent ( void )
+{
+
+    // Initialized data
+    GXTransformHierarchy_t *p_hierarchy = 0;
+    GXTransform_t          *p_parent    = 0,
+                           *p_child     = 0;
+    vec3                    scale       = { .x = 1.f, .y = 1.f, .z = 1.f };
+    bool                    result      = false;
+
+    if ( create_transform_hierarchy(&p_hierarchy) == 0 ) return false;
+
+    construct_transform(&p_parent, (vec3){ .x = 1.f, .y = 2.f, .z = 3.f }, identity_quaternion(), scale);
+    construct_transform(&p_child , (vec3){ .x = 1.f, .y = 0.f, .z = 0.f }, identity_quaternion(), scale);
+
+    add_transform(p_hierarchy, p_parent);
+    add_transform(p_hierarchy, p_child);
+    set_transform_parent(p_child, p_parent);
+    update_transforms(p_hierarchy);
+
+    // The child is left in world space at its local location
+    remove_transform(p_parent);
+    update_transforms(p_hierarchy);
+
+    result = transform_order_valid(p_hierarchy) &&
+             ( p_hierarchy->transform_count == 1 ) &&
+             ( p_child->parent == 0 && p_parent->p_hierarchy == 0 ) &&
+             ( p_child->model_matrix.m == 1.f && p_child->model_matrix.n == 0.f && p_child->model_matrix.o == 0.f );
+
+    destroy_transform(&p_child);
+    destroy_transform(&p_parent);
+    destroy_transform_hierarchy(&p_hierarchy);
+
+    // Return
+    return result;
+}
+bool test_transform_remove_subtree ( void )
+{
+
+    // Initialized data
+    GXTransformHierarchy_t *p_hierarchy = 0;
+    GXTransform_t          *p_root      = 0,
+                           *p_a         = 0,
+                           *p_b         = 0,
+                           *p_other     = 0;
+    vec3                    scale       = { .x = 1.f, .y = 1.f, .z = 1.f };
+    bool                    result      = false;
+
+    if ( create_transform_hierarchy(&p_hierarchy) == 0 ) return false;
+
+    construct_transform(&p_root , (vec3){ .x = 0.f, .y = 0.f, .z = 1.f }, identity_quaternion(), scale);
+    construct_transform(&p_a    , (vec3){ .x = 1.f, .y = 0.f, .z = 0.f }, identity_quaternion(), scale);
+    construct_transform(&p_b    , (vec3){ .x = 0.f, .y = 1.f, .z = 0.f }, identity_quaternion(), scale);
+    construct_transform(&p_other, (vec3){ .x = 2.f, .y = 2.f, .z = 2.f }, identity_quaternion(), scale);
+
+    // root -> a -> b, and another root
+    add_transform(p_hierarchy, p_root);
+    add_transform(p_hierarchy, p_a);
+    add_transform(p_hierarchy, p_b);
+    add_transform(p_hierarchy, p_other);
+    set_transform_parent(p_a, p_root);
+    set_transform_parent(p_b, p_a);
+    update_transforms(p_hierarchy);
+
+    // Remove the subtree of a, leaves first
+    remove_transform(p_b);
+    remove_transform(p_a);
+    update_transforms(p_hierarchy);
+
+    result = transform_order_valid(p_hierarchy) &&
+             ( p_hierarchy->transform_count == 2 ) &&
+             ( p_root->subtree_size == 1 ) &&
+             ( p_root->model_matrix.o == 1.f && p_other->model_matrix.m == 2.f );
+
+    destroy_transform(&p_b);
+    destroy_transform(&p_a);
+    destroy_transform(&p_other);
+    destroy_transform(&p_root);
+    destroy_transform_hierarchy(&p_hierarchy);
+
+    // Return
+    return result;
+}
+
 int print_test ( const char *scenario_name, const char *test_name, bool passed )
 {
 
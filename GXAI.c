@@ -15,6 +15,48 @@ void init_ai ( void )
     return;
 }
 
+// Give a copied AI a states dictionary of its own. The state names are still borrowed
+static int unshare_ai_states ( GXAI_t *p_ai )
+{
+
+    // Initialized data
+    size_t   state_count = dict_keys(p_ai->states, 0);
+    char   **state_names = calloc(state_count + 1, sizeof(char *));
+    dict    *p_states    = 0;
+
+    // Error check
+    if ( state_names == (void *) 0 ) return 0;
+
+    // Construct a dictionary for the states
+    if ( dict_construct(&p_states, state_count + 1) == 0 ) goto failed;
+
+    // Get the name of each state
+    dict_keys(p_ai->states, state_names);
+
+    // Copy each state
+    for (size_t i = 0; i < state_count; i++)
+        dict_add(p_states, state_names[i], dict_get(p_ai->states, state_names[i]));
+
+    // Stop sharing
+    p_ai->states        = p_states;
+    p_ai->shared_states = false;
+
+    // Clean the scope
+    free(state_names);
+
+    // Success
+    return 1;
+
+    // Error handling
+    failed:
+
+        // Clean the scope
+        free(state_names);
+
+        // Error
+        return 0;
+}
+
 int create_ai ( GXAI_t **pp_ai )
 {
     
@@ -29,6 +71,9 @@ int create_ai ( GXAI_t **pp_ai )
     // Error check
     if ( p_ai == (void *) 0 ) goto no_mem;
 
+    // Count the AI
+    G10_STAT_ADD(stat_ais, 1);
+
     // Write the return value
     *pp_ai = p_ai;
 
@@ -269,11 +314,8 @@ int load_ai_as_json_value ( GXAI_t **pp_ai, JSONValue_t *p_value )
         GXAI_t* p_ai = 0;
         GXAI_t* p_cache_ai = 0;
 
-        // Lock the AI cache mutex
-        SDL_LockMutex(p_instance->mutexes.ai_cache);
-
-        // Search the cache for the AI
-        p_cache_ai = g_find_ai(p_instance, p_name->string);
+        // Search the cache for the AI, or claim the load. Other AIs load while this one does
+        p_cache_ai = g_claim_ai(p_instance, p_name->string);
 
         // If the AI is in the cache ...
         if ( p_cache_ai )
@@ -368,11 +410,8 @@ int load_ai_as_json_value ( GXAI_t **pp_ai, JSONValue_t *p_value )
         else
             goto wrong_states_type;
 
-        // Cache the AI
-        g_cache_ai(p_instance, p_ai);
-
-        // Unlock the AI caching mutex
-        SDL_UnlockMutex(p_instance->mutexes.ai_cache);
+        // Cache the AI, and wake the threads waiting for it
+        g_settle_ai(p_instance, p_name->string, p_ai);
 
         // Set the initial state
         set_initial_state:
@@ -432,6 +471,9 @@ int load_ai_as_json_value ( GXAI_t **pp_ai, JSONValue_t *p_value )
                     g_print_error("[G10] [AI] Property \"states\" must be of type [ array ] in call to function \"%s\"\nRefer to gschema: https://schema.g10.app/ai.json \n", __FUNCTION__);
                 #endif
 
+                // Wake the threads waiting for the AI
+                g_settle_ai(p_instance, p_name->string, 0);
+
                 // Error
                 return 0;
 
@@ -440,6 +482,9 @@ int load_ai_as_json_value ( GXAI_t **pp_ai, JSONValue_t *p_value )
                     g_print_error("[G10] [AI] \"name\" property's length must be less than 256 in call to function \"%s\"\nRefer to gschema: https://schema.g10.app/ai.json \n", __FUNCTION__);
                 #endif
 
+                // Wake the threads waiting for the AI
+                g_settle_ai(p_instance, p_name->string, 0);
+
                 // Error
                 return 0;
 
@@ -452,6 +497,9 @@ int load_ai_as_json_value ( GXAI_t **pp_ai, JSONValue_t *p_value )
                     g_print_error("[G10] [AI] Failed to allocate AI in call to function \"%s\"\n", __FUNCTION__);
                 #endif
 
+                // Wake the threads waiting for the AI
+                g_settle_ai(p_instance, p_name->string, 0);
+
                 // Error
                 return 0;
         }
@@ -483,6 +531,9 @@ int load_ai_as_json_value ( GXAI_t **pp_ai, JSONValue_t *p_value )
                     g_print_error("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
                 #endif
 
+                // Wake the threads waiting for the AI
+                g_settle_ai(p_instance, p_name->string, 0);
+
                 // Error
                 return 0;
         }
@@ -499,6 +550,10 @@ int add_ai_state_callback ( GXAI_t *p_ai , char *state_name, int (*function_poin
         if ( function_pointer == (void *) 0 ) goto no_function_pointer;
     #endif
 
+    // Copy shared states before writing to them
+    if ( p_ai->shared_states )
+        if ( unshare_ai_states(p_ai) == 0 ) goto no_mem;
+
     // Update the state callback
     dict_add(p_ai->states, state_name, function_pointer);
 
@@ -534,6 +589,17 @@ int add_ai_state_callback ( GXAI_t *p_ai , char *state_name, int (*function_poin
                 // Error
                 return 0;
         }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    g_print_error("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
     }
 }
 
@@ -633,22 +699,15 @@ int pre_update_ai ( GXInstance_t *p_instance )
     // Get an entity with an AI
     {
 
+        // No entities
+        if ( p_instance->context.scene == (void *) 0 || p_instance->context.scene->components == (void *) 0 )
+            return 1;
+
         // Lock the mutex
         SDL_LockMutex(p_instance->mutexes.ai_preupdate);
 
-        // Are there any AIs left to preupdate?
-        if ( queue_empty(p_instance->queues.ai_preupdate) )
-        {
-
-            // If not, unlock and return
-            SDL_UnlockMutex(p_instance->mutexes.ai_preupdate);
-
-            // Success
-            return 1;
-        }
-
-        // Get a pointer to an entity
-        queue_dequeue(p_instance->queues.ai_preupdate, (void **)&p_entity);
+        // Get a pointer to the next entity, or null if there are no AIs left to preupdate
+        p_entity = next_work_item(&p_instance->context.scene->components->work_lists[WORK_LIST_AIS], &p_instance->cursors.ai_preupdate);
 
         // Unlock the mutex
         SDL_UnlockMutex(p_instance->mutexes.ai_preupdate);
@@ -695,11 +754,17 @@ int copy_ai ( GXAI_t **pp_ai, GXAI_t *p_ai )
     // Return the copy to the caller
     *dest_ai = (GXAI_t)
     {
-        .name = p_ai->name,
-        .states = p_ai->states,
-        .pre_ai = p_ai->pre_ai
+        .name          = p_ai->name,
+        .current_state = p_ai->current_state,
+        .states        = p_ai->states,
+        .pre_ai        = p_ai->pre_ai,
+        .source        = p_ai,
+        .shared_states = true
     };
 
+    // Write the return
+    *pp_ai = dest_ai;
+
     // Success
     return 1;
 
@@ -747,8 +812,9 @@ int ai_info ( GXAI_t *p_ai )
     #endif
 
     // Initialized data
-    size_t   state_count = dict_keys(p_ai->states, 0);
-    char   **state_names = calloc(state_count, sizeof (char *));
+    GXScratchMark_t   scratch     = scratch_mark();
+    size_t            state_count = dict_keys(p_ai->states, 0);
+    char            **state_names = scratch_calloc(state_count, sizeof (char *));
 
     // Formatting
     g_print_log(" - AI info - \n");
@@ -778,7 +844,7 @@ int ai_info ( GXAI_t *p_ai )
     putchar('\n');
 
     // Free the list of state names
-    free(state_names);
+    scratch_rewind(scratch);
 
     // Success
     return 1;
@@ -813,19 +879,15 @@ int update_ai ( GXInstance_t *p_instance )
     // Get an ai entity
     {
 
+        // No entities
+        if ( p_instance->context.scene == (void *) 0 || p_instance->context.scene->components == (void *) 0 )
+            return 1;
+
         // Lock the mutex
         SDL_LockMutex(p_instance->mutexes.ai_update);
 
-        // Is there anything left to move?
-        if (queue_empty(p_instance->queues.ai_update))
-        {
-
-            // If not, unlock and return
-            SDL_UnlockMutex(p_instance->mutexes.ai_update);
-            return 1;
-        }
-
-        queue_dequeue(p_instance->queues.ai_update, (void **)(&entity));
+        // Get the next entity, or null if there is nothing left to update
+        entity = next_work_item(&p_instance->context.scene->components->work_lists[WORK_LIST_AIS], &p_instance->cursors.ai_update);
 
         SDL_UnlockMutex(p_instance->mutexes.ai_update);
     }
@@ -871,9 +933,28 @@ int destroy_ai ( GXAI_t **pp_ai )
     if ( p_ai == 0 )
         return 1;
 
+    G10_STAT_ADD(stat_ais, -1);
+
     p_ai->current_state = 0;
     p_ai->pre_ai = 0;
 
+    // Stale every handle to the AI
+    if ( p_ai->handle )
+        (void) release_handle(g_get_active_instance()->cache.ai_handles, p_ai->handle);
+
+    // A copy only owns its states, and only once it has stopped sharing them
+    if ( p_ai->source )
+    {
+        if ( p_ai->shared_states == false )
+            dict_destroy(&p_ai->states);
+
+        // Free the AI
+        free(p_ai);
+
+        // Success
+        return 1;
+    }
+
     // Free the AI name
     if ( p_ai->name )
         free(p_ai->name);
@@ -0,0 +1,552 @@
+#include <G10/GXAlloc.h>
+
+// Written in front of each tracked allocation. 16 bytes, so allocations keep malloc's alignment
+struct alloc_header_s
+{
+    u64 size;
+    u32 site;
+    u16 tag;
+    u16 magic;
+};
+
+// Headers of live allocations hold this. Freeing clears it, which catches double frees
+#define ALLOC_MAGIC 0xA110
+
+// Counters of one thread. Only the owning thread writes them, unless there are more than ALLOC_THREAD_MAX threads
+struct alloc_thread_s
+{
+    i64 allocs[alloc_tag_count],
+        frees[alloc_tag_count],
+        bytes_allocated[alloc_tag_count],
+        bytes_freed[alloc_tag_count];
+
+    // Keep each thread's counters on their own cache lines
+    u8  _pad[64 - ( 4 * alloc_tag_count * sizeof(i64) ) % 64];
+};
+
+// A call site. Claimed by writing its key, and never released
+struct alloc_site_s
+{
+    u64          key;
+    const char  *file;
+    int          line;
+    alloc_tag_t  tag;
+    i64          total_count,
+                 total_bytes,
+                 live_count,
+                 live_bytes;
+};
+
+// Counters of each thread, and the number of threads that have claimed counters
+static struct alloc_thread_s  threads[ALLOC_THREAD_MAX] = { 0 };
+static i64                    thread_count              = 0;
+static G10_THREAD_LOCAL struct alloc_thread_s *p_thread = 0;
+
+// Call sites. The last site counts every site that didn't fit
+static struct alloc_site_s sites[ALLOC_SITE_MAX + 1] = { 0 };
+
+// Totals at the end of the last frame, the last frame's allocations, and the peaks. The last entry is every subsystem
+static i64 frame_start_count[alloc_tag_count + 1] = { 0 },
+           frame_start_bytes[alloc_tag_count + 1] = { 0 },
+           frame_count[alloc_tag_count + 1]       = { 0 },
+           frame_bytes[alloc_tag_count + 1]       = { 0 },
+           peak_frame_bytes[alloc_tag_count + 1]  = { 0 },
+           peak_bytes[alloc_tag_count + 1]        = { 0 };
+
+// Name of each subsystem
+static const char *tag_names[alloc_tag_count] = {
+    "core",
+    "scene",
+    "renderer",
+    "physics",
+    "network",
+    "json"
+};
+
+// Get the calling thread's counters
+static struct alloc_thread_s *get_thread ( void )
+{
+
+    // Claim counters on first use
+    if ( p_thread == (void *) 0 )
+    {
+
+        // Initialized data
+        i64 i = G10_ATOMIC_ADD(&thread_count, 1);
+
+        p_thread = &threads[( i < ALLOC_THREAD_MAX ) ? i : ALLOC_THREAD_MAX - 1];
+    }
+
+    // Success
+    return p_thread;
+}
+
+// Find or claim the site of a file and line
+static u32 get_site ( const char *file, int line, alloc_tag_t tag )
+{
+
+    // Initialized data
+    u64 key = ( (u64)(uintptr_t) file * 0x9E3779B97F4A7C15ull ) ^ (u64)(u32) line;
+    u32 i   = 0;
+
+    // Zero marks an empty site
+    if ( key == 0 ) key = 1;
+
+    // Probe for the site
+    for (u32 probe = 0; probe < ALLOC_SITE_MAX; probe++)
+    {
+        i = (u32) ( ( key >> 32 ) + probe ) & ( ALLOC_SITE_MAX - 1 );
+
+        // Found it
+        if ( G10_ATOMIC_LOAD(&sites[i].key) == key ) return i;
+
+        // Claim an empty site
+        if ( G10_ATOMIC_LOAD(&sites[i].key) == 0 && G10_ATOMIC_CAS(&sites[i].key, (u64) 0, key) )
+        {
+            sites[i].file = file;
+            sites[i].line = line;
+            sites[i].tag  = tag;
+
+            return i;
+        }
+
+        // Another thread claimed the site for the same key
+        if ( G10_ATOMIC_LOAD(&sites[i].key) == key ) return i;
+    }
+
+    // Out of sites
+    return ALLOC_SITE_MAX;
+}
+
+// Raise a peak to a value
+static void raise_peak ( i64 *p_peak, i64 value )
+{
+
+    // Initialized data
+    i64 peak = G10_ATOMIC_LOAD(p_peak);
+
+    while ( value > peak )
+    {
+        if ( G10_ATOMIC_CAS(p_peak, peak, value) ) break;
+
+        peak = G10_ATOMIC_LOAD(p_peak);
+    }
+}
+
+// Count an allocation
+static void count_alloc ( struct alloc_header_s *p_header )
+{
+
+    // Initialized data
+    struct alloc_thread_s *p_counters = get_thread();
+    struct alloc_site_s   *p_site     = &sites[p_header->site];
+
+    G10_ATOMIC_ADD(&p_counters->allocs[p_header->tag]         , 1);
+    G10_ATOMIC_ADD(&p_counters->bytes_allocated[p_header->tag], (i64) p_header->size);
+
+    G10_ATOMIC_ADD(&p_site->total_count, 1);
+    G10_ATOMIC_ADD(&p_site->total_bytes, (i64) p_header->size);
+    G10_ATOMIC_ADD(&p_site->live_count , 1);
+    G10_ATOMIC_ADD(&p_site->live_bytes , (i64) p_header->size);
+}
+
+// Count a free
+static void count_free ( struct alloc_header_s *p_header )
+{
+
+    // Initialized data
+    struct alloc_thread_s *p_counters = get_thread();
+    struct alloc_site_s   *p_site     = &sites[p_header->site];
+
+    G10_ATOMIC_ADD(&p_counters->frees[p_header->tag]      , 1);
+    G10_ATOMIC_ADD(&p_counters->bytes_freed[p_header->tag], (i64) p_header->size);
+
+    G10_ATOMIC_ADD(&p_site->live_count, -1);
+    G10_ATOMIC_ADD(&p_site->live_bytes, -(i64) p_header->size);
+}
+
+// Sum the counters of every thread for a subsystem, or every subsystem
+static void sum_threads ( alloc_tag_t tag, i64 *p_count, i64 *p_bytes, i64 *p_live_count, i64 *p_live_bytes )
+{
+
+    // Initialized data
+    i64    count      = 0,
+           bytes      = 0,
+           live_count = 0,
+           live_bytes = 0,
+           used       = G10_ATOMIC_LOAD(&thread_count);
+    size_t first      = ( tag == alloc_tag_count ) ? 0 : tag,
+           last       = ( tag == alloc_tag_count ) ? alloc_tag_count : tag + 1;
+
+    // Only look at claimed counters
+    if ( used > ALLOC_THREAD_MAX ) used = ALLOC_THREAD_MAX;
+
+    for (i64 i = 0; i < used; i++)
+        for (size_t t = first; t < last; t++)
+        {
+
+            // Initialized data
+            i64 allocs          = G10_ATOMIC_LOAD(&threads[i].allocs[t]),
+                bytes_allocated = G10_ATOMIC_LOAD(&threads[i].bytes_allocated[t]);
+
+            count      += allocs;
+            bytes      += bytes_allocated;
+            live_count += allocs - G10_ATOMIC_LOAD(&threads[i].frees[t]);
+            live_bytes += bytes_allocated - G10_ATOMIC_LOAD(&threads[i].bytes_freed[t]);
+        }
+
+    if ( p_count      ) *p_count      = count;
+    if ( p_bytes      ) *p_bytes      = bytes;
+    if ( p_live_count ) *p_live_count = live_count;
+    if ( p_live_bytes ) *p_live_bytes = live_bytes;
+}
+
+// Sort sites by bytes allocated, most first
+static int compare_sites ( const void *a, const void *b )
+{
+
+    // Initialized data
+    size_t i = ((const GXAllocSite_t *) a)->total_bytes,
+           j = ((const GXAllocSite_t *) b)->total_bytes;
+
+    // Success
+    return ( i < j ) - ( i > j );
+}
+
+void *alloc_realloc ( void *p, size_t size, alloc_tag_t tag, const char *file, int line )
+{
+
+    // Initialized data
+    struct alloc_header_s *p_header = ( p ) ? (struct alloc_header_s *) p - 1 : 0;
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( p_header && p_header->magic != ALLOC_MAGIC ) goto not_tracked;
+    #endif
+
+    // Behave like realloc(p, 0)
+    if ( size == 0 )
+    {
+        alloc_free(p);
+
+        return 0;
+    }
+
+    // Overflow
+    if ( size > SIZE_MAX - sizeof(struct alloc_header_s) ) goto no_mem;
+
+    // Count the old allocation as freed, so its call site and size are forgotten
+    if ( p_header ) count_free(p_header);
+
+    // Grow or shrink the allocation
+    {
+
+        // Initialized data
+        struct alloc_header_s *p_new = realloc(p_header, sizeof(struct alloc_header_s) + size);
+
+        // Error check. The old allocation is still live
+        if ( p_new == (void *) 0 )
+        {
+            if ( p_header ) count_alloc(p_header);
+
+            goto no_mem;
+        }
+
+        p_header = p_new;
+    }
+
+    // Write the header
+    p_header->size  = size;
+    p_header->site  = get_site(file, line, tag);
+    p_header->tag   = (u16) ( ( (size_t) tag < alloc_tag_count ) ? tag : alloc_tag_core );
+    p_header->magic = ALLOC_MAGIC;
+
+    count_alloc(p_header);
+
+    // Success
+    return p_header + 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            not_tracked:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Alloc] Parameter \"p\" was not allocated with G10_REALLOC, or was freed, in call to function \"%s\" from %s:%d\n", __FUNCTION__, file, line);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    g_print_error("[Standard Library] Failed to allocate memory in call to function \"%s\" from %s:%d\n", __FUNCTION__, file, line);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+void alloc_end_frame ( void )
+{
+
+    // Measure each subsystem, and every subsystem together
+    for (size_t t = 0; t <= alloc_tag_count; t++)
+    {
+
+        // Initialized data
+        i64 count      = 0,
+            bytes      = 0,
+            live_bytes = 0;
+
+        sum_threads((alloc_tag_t) t, &count, &bytes, 0, &live_bytes);
+
+        frame_count[t]       = count - frame_start_count[t];
+        frame_bytes[t]       = bytes - frame_start_bytes[t];
+        frame_start_count[t] = count;
+        frame_start_bytes[t] = bytes;
+
+        raise_peak(&peak_frame_bytes[t], frame_bytes[t]);
+        raise_peak(&peak_bytes[t], live_bytes);
+    }
+}
+
+int get_alloc_stats ( alloc_tag_t tag, GXAllocStats_t *p_stats )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( (size_t) tag > alloc_tag_count ) goto bad_tag;
+        if ( p_stats      == (void *) 0     ) goto no_stats;
+    #endif
+
+    // Initialized data
+    i64 count      = 0,
+        bytes      = 0,
+        live_count = 0,
+        live_bytes = 0;
+
+    sum_threads(tag, &count, &bytes, &live_count, &live_bytes);
+
+    // Sample the peak
+    raise_peak(&peak_bytes[tag], live_bytes);
+
+    *p_stats = (GXAllocStats_t) {
+        .live_count       = (size_t) live_count,
+        .live_bytes       = (size_t) live_bytes,
+        .peak_bytes       = (size_t) G10_ATOMIC_LOAD(&peak_bytes[tag]),
+        .total_count      = (size_t) count,
+        .total_bytes      = (size_t) bytes,
+        .frame_count      = (size_t) frame_count[tag],
+        .frame_bytes      = (size_t) frame_bytes[tag],
+        .peak_frame_bytes = (size_t) G10_ATOMIC_LOAD(&peak_frame_bytes[tag])
+    };
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            bad_tag:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Alloc] Parameter \"tag\" is out of range in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_stats:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Alloc] Null pointer provided for parameter \"p_stats\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+size_t get_alloc_sites ( GXAllocSite_t *p_sites, size_t max )
+{
+
+    // Initialized data
+    GXAllocSite_t *p_all = calloc(ALLOC_SITE_MAX + 1, sizeof(GXAllocSite_t));
+    size_t         n     = 0;
+
+    // Error check
+    if ( p_sites == (void *) 0 || max == 0 ) goto done;
+    if ( p_all   == (void *) 0             ) goto no_mem;
+
+    // Copy each claimed site
+    for (size_t i = 0; i <= ALLOC_SITE_MAX; i++)
+    {
+
+        // Initialized data
+        struct alloc_site_s *p_site = &sites[i];
+
+        // Skip empty sites, and sites that are still being claimed
+        if ( G10_ATOMIC_LOAD(&p_site->total_count) == 0 ) continue;
+
+        p_all[n++] = (GXAllocSite_t) {
+            .file        = ( i == ALLOC_SITE_MAX ) ? "(other sites)" : p_site->file,
+            .line        = p_site->line,
+            .tag         = p_site->tag,
+            .total_count = (size_t) G10_ATOMIC_LOAD(&p_site->total_count),
+            .total_bytes = (size_t) G10_ATOMIC_LOAD(&p_site->total_bytes),
+            .live_count  = (size_t) G10_ATOMIC_LOAD(&p_site->live_count),
+            .live_bytes  = (size_t) G10_ATOMIC_LOAD(&p_site->live_bytes)
+        };
+
+        if ( p_all[n - 1].file == (void *) 0 ) n--;
+    }
+
+    // Keep the sites that allocated the most
+    qsort(p_all, n, sizeof(GXAllocSite_t), compare_sites);
+
+    if ( n > max ) n = max;
+
+    memcpy(p_sites, p_all, n * sizeof(GXAllocSite_t));
+
+    done:
+
+    // Clean the scope
+    free(p_all);
+
+    // Success
+    return n;
+
+    // Error handling
+    {
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    g_print_error("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+const char *get_alloc_tag_name ( alloc_tag_t tag )
+{
+
+    // Out of range
+    if ( (size_t) tag >= alloc_tag_count ) return 0;
+
+    // Success
+    return tag_names[tag];
+}
+
+int alloc_info ( void )
+{
+
+    // Initialized data
+    GXAllocSite_t sites_out[16] = { 0 };
+    size_t        site_count    = get_alloc_sites(sites_out, sizeof(sites_out) / sizeof(*sites_out));
+
+    // Formatting
+    g_print_log("\n - Allocations -\n");
+    g_print_log("%-10s : %12s %12s %12s %12s %12s\n", "subsystem", "live", "live bytes", "peak bytes", "frame allocs", "frame bytes");
+
+    // Print each subsystem, then every subsystem together
+    for (size_t t = 0; t <= alloc_tag_count; t++)
+    {
+
+        // Initialized data
+        GXAllocStats_t stats = { 0 };
+
+        (void) get_alloc_stats((alloc_tag_t) t, &stats);
+
+        g_print_log("%-10s : %12zu %12zu %12zu %12zu %12zu\n", ( t == alloc_tag_count ) ? "total" : tag_names[t], stats.live_count, stats.live_bytes, stats.peak_bytes, stats.frame_count, stats.frame_bytes);
+    }
+
+    // Print the call sites that allocated the most bytes
+    g_print_log("top call sites :\n");
+
+    for (size_t i = 0; i < site_count; i++)
+        g_print_log("    %s:%d (%s) : %zu bytes in %zu allocations, %zu bytes live\n", sites_out[i].file, sites_out[i].line, tag_names[sites_out[i].tag], sites_out[i].total_bytes, sites_out[i].total_count, sites_out[i].live_bytes);
+
+    // Formatting
+    g_print_log("\n");
+
+    // Success
+    return 1;
+}
+
+size_t alloc_leaks ( void )
+{
+
+    // Initialized data
+    size_t leaks = 0;
+
+    // Print each site with live allocations
+    for (size_t i = 0; i <= ALLOC_SITE_MAX; i++)
+    {
+
+        // Initialized data
+        struct alloc_site_s *p_site     = &sites[i];
+        i64                  live_count = G10_ATOMIC_LOAD(&p_site->live_count);
+
+        if ( live_count <= 0 ) continue;
+
+        g_print_warning("[G10] [Alloc] %lld allocations ( %lld bytes ) from %s:%d were never freed\n", live_count, G10_ATOMIC_LOAD(&p_site->live_bytes), ( i == ALLOC_SITE_MAX ) ? "(other sites)" : p_site->file, p_site->line);
+
+        leaks += (size_t) live_count;
+    }
+
+    // Success
+    return leaks;
+}
+
+void alloc_free ( void *p )
+{
+
+    // Initialized data
+    struct alloc_header_s *p_header = ( p ) ? (struct alloc_header_s *) p - 1 : 0;
+
+    // Free a null pointer
+    if ( p_header == (void *) 0 ) return;
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( p_header->magic != ALLOC_MAGIC ) goto not_tracked;
+    #endif
+
+    count_free(p_header);
+
+    // Catch the next free of the same pointer
+    p_header->magic = 0;
+
+    free(p_header);
+
+    // Success
+    return;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            not_tracked:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Alloc] Parameter \"p\" was not allocated with G10_REALLOC, or was already freed, in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return;
+        }
+    }
+}
@@ -0,0 +1,733 @@
+// Allocations made here are counted against the scene
+#define G10_ALLOC_TAG alloc_tag_scene
+
+#include <G10/GXArchetype.h>
+
+// G10
+#include <G10/GXEntity.h>
+
+// Write an entity's components to a row of a chunk
+static void write_chunk_row ( GXArchetypeChunk_t *p_chunk, size_t row, GXEntity_t *p_entity )
+{
+    p_chunk->entities[row]    = p_entity;
+    p_chunk->transforms[row]  = p_entity->transform;
+    p_chunk->rigidbodies[row] = p_entity->rigidbody;
+    p_chunk->colliders[row]   = p_entity->collider;
+    p_chunk->ais[row]         = p_entity->ai;
+
+    p_entity->chunk     = p_chunk;
+    p_entity->chunk_row = row;
+}
+
+// Append an entity to the last chunk of an archetype
+static int append_archetype_row ( GXArchetype_t *p_archetype, GXEntity_t *p_entity )
+{
+
+    // Initialized data
+    GXArchetypeChunk_t *p_chunk = ( p_archetype->chunk_count ) ? p_archetype->chunks[p_archetype->chunk_count - 1] : 0;
+
+    // The last chunk is full
+    if ( p_chunk == (void *) 0 || p_chunk->count == ARCHETYPE_CHUNK_CAPACITY )
+    {
+
+        // Grow the chunk list
+        if ( p_archetype->chunk_count == p_archetype->chunk_max )
+        {
+
+            // Initialized data
+            size_t               new_max    = ( p_archetype->chunk_max ) ? p_archetype->chunk_max * 2 : 4;
+            GXArchetypeChunk_t **new_chunks = G10_REALLOC(p_archetype->chunks, new_max * sizeof(GXArchetypeChunk_t *));
+
+            // Error check
+            if ( new_chunks == (void *) 0 ) return 0;
+
+            p_archetype->chunks    = new_chunks;
+            p_archetype->chunk_max = new_max;
+        }
+
+        // Allocate a chunk
+        p_chunk = calloc(1, sizeof(GXArchetypeChunk_t));
+
+        // Error check
+        if ( p_chunk == (void *) 0 ) return 0;
+
+        p_chunk->archetype = p_archetype;
+
+        p_archetype->chunks[p_archetype->chunk_count++] = p_chunk;
+    }
+
+    // Write the row
+    write_chunk_row(p_chunk, p_chunk->count++, p_entity);
+
+    p_archetype->entity_count++;
+
+    // Success
+    return 1;
+}
+
+// Remove an entity from its chunk, and fill the hole with the last entity of the archetype
+static void remove_archetype_row ( GXEntity_t *p_entity )
+{
+
+    // Initialized data
+    GXArchetypeChunk_t *p_chunk     = p_entity->chunk;
+    GXArchetype_t      *p_archetype = p_chunk->archetype;
+    GXArchetypeChunk_t *p_last      = p_archetype->chunks[p_archetype->chunk_count - 1];
+    size_t              row         = p_entity->chunk_row,
+                        last_row    = p_last->count - 1;
+
+    // Move the last entity into the hole
+    if ( p_chunk != p_last || row != last_row )
+    {
+        p_chunk->entities[row]    = p_last->entities[last_row];
+        p_chunk->transforms[row]  = p_last->transforms[last_row];
+        p_chunk->rigidbodies[row] = p_last->rigidbodies[last_row];
+        p_chunk->colliders[row]   = p_last->colliders[last_row];
+        p_chunk->ais[row]         = p_last->ais[last_row];
+
+        p_chunk->entities[row]->chunk     = p_chunk;
+        p_chunk->entities[row]->chunk_row = row;
+    }
+
+    p_last->count--;
+    p_archetype->entity_count--;
+    p_archetype->storage->entity_count--;
+
+    // Free the last chunk once it is empty
+    if ( p_last->count == 0 )
+    {
+        free(p_last);
+        p_archetype->chunk_count--;
+    }
+
+    p_entity->chunk     = 0;
+    p_entity->chunk_row = 0;
+}
+
+// Make room for one more entry in the change log
+static int reserve_component_change ( GXComponentStorage_t *p_storage )
+{
+
+    // Grow the change log
+    if ( p_storage->change_count == p_storage->change_max )
+    {
+
+        // Initialized data
+        size_t    new_max     = ( p_storage->change_max ) ? p_storage->change_max * 2 : 64;
+        handle_t *new_changes = G10_REALLOC(p_storage->changes, new_max * sizeof(handle_t));
+
+        // Error check
+        if ( new_changes == (void *) 0 ) return 0;
+
+        p_storage->changes    = new_changes;
+        p_storage->change_max = new_max;
+    }
+
+    // Success
+    return 1;
+}
+
+// Add an entity to, or remove it from, each work list, so the work lists match a set of components
+static int list_entity ( GXComponentStorage_t *p_storage, GXEntity_t *p_entity, u32 components )
+{
+
+    // Iterate over each work list
+    for (size_t i = 0; i < WORK_LIST_COUNT; i++)
+    {
+
+        // Initialized data
+        GXWorkList_t *p_work_list = &p_storage->work_lists[i];
+        bool          listed      = p_entity->work_lists & ( 1u << i ),
+                      matches     = ( components & p_work_list->components ) == p_work_list->components;
+
+        // Join the work list
+        if ( matches && !listed )
+        {
+
+            // Grow the work list
+            if ( p_work_list->count == p_work_list->max )
+            {
+
+                // Initialized data
+                size_t       new_max      = ( p_work_list->max ) ? p_work_list->max * 2 : 64;
+                GXEntity_t **new_entities = G10_REALLOC(p_work_list->entities, new_max * sizeof(GXEntity_t *));
+
+                // Error check
+                if ( new_entities == (void *) 0 ) return 0;
+
+                p_work_list->entities = new_entities;
+                p_work_list->max      = new_max;
+            }
+
+            p_entity->work_list_rows[i]                 = p_work_list->count;
+            p_work_list->entities[p_work_list->count++] = p_entity;
+            p_entity->work_lists                       |= 1u << i;
+        }
+
+        // Leave the work list. The last entity of the list takes its place
+        else if ( listed && !matches )
+        {
+
+            // Initialized data
+            size_t      row    = p_entity->work_list_rows[i];
+            GXEntity_t *p_last = p_work_list->entities[--p_work_list->count];
+
+            p_work_list->entities[row]  = p_last;
+            p_last->work_list_rows[i]   = row;
+            p_entity->work_list_rows[i] = 0;
+            p_entity->work_lists       &= ~( 1u << i );
+        }
+    }
+
+    // Success
+    return 1;
+}
+
+// Get the archetype of a set of components, allocating it on first use
+static GXArchetype_t *find_archetype ( GXComponentStorage_t *p_storage, u32 components )
+{
+
+    // Initialized data
+    GXArchetype_t *p_archetype = p_storage->archetypes[components];
+
+    // Allocate the archetype
+    if ( p_archetype == (void *) 0 )
+    {
+        p_archetype = calloc(1, sizeof(GXArchetype_t));
+
+        // Error check
+        if ( p_archetype == (void *) 0 ) return 0;
+
+        p_archetype->storage              = p_storage;
+        p_archetype->components           = components;
+        p_storage->archetypes[components] = p_archetype;
+    }
+
+    return p_archetype;
+}
+
+int create_component_storage ( GXComponentStorage_t **pp_storage )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( pp_storage == (void *) 0 ) goto no_storage;
+    #endif
+
+    // Initialized data
+    GXComponentStorage_t *p_storage = calloc(1, sizeof(GXComponentStorage_t));
+
+    // Memory check
+    if ( p_storage == (void *) 0 ) goto no_mem;
+
+    // Allocate the handle table
+    if ( create_handle_table(&p_storage->handles) == 0 )
+    {
+        free(p_storage);
+
+        goto no_mem;
+    }
+
+    // Set up the work lists
+    p_storage->work_lists[WORK_LIST_ACTORS].components = COMPONENT_RIGIDBODY;
+    p_storage->work_lists[WORK_LIST_AIS].components    = COMPONENT_AI;
+
+    // Return the allocated memory
+    *pp_storage = p_storage;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_storage:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Archetype] Null pointer provided for parameter \"pp_storage\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    g_print_error("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int add_entity_components ( GXComponentStorage_t *p_storage, GXEntity_t *p_entity )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( p_storage       == (void *) 0 ) goto no_storage;
+        if ( p_entity        == (void *) 0 ) goto no_entity;
+        if ( p_entity->chunk != (void *) 0 ) goto already_stored;
+    #endif
+
+    // Initialized data
+    GXArchetype_t *p_archetype = find_archetype(p_storage, entity_components(p_entity));
+
+    // Error check
+    if ( p_archetype == (void *) 0 ) goto no_mem;
+
+    // Make room in the change log
+    if ( reserve_component_change(p_storage) == 0 ) goto no_mem;
+
+    // Give the entity a handle
+    p_entity->handle = acquire_handle(p_storage->handles, p_entity);
+
+    // Error check
+    if ( p_entity->handle == HANDLE_INVALID ) goto no_mem;
+
+    // Add the entity
+    if ( append_archetype_row(p_archetype, p_entity) == 0 )
+    {
+        (void) release_handle(p_storage->handles, p_entity->handle);
+
+        p_entity->handle = HANDLE_INVALID;
+
+        goto no_mem;
+    }
+
+    p_storage->entity_count++;
+
+    // Join the work lists on the next update
+    p_storage->changes[p_storage->change_count++] = p_entity->handle;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_storage:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Archetype] Null pointer provided for parameter \"p_storage\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_entity:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Archetype] Null pointer provided for parameter \"p_entity\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            already_stored:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Archetype] Entity \"%s\" is already stored in call to function \"%s\"\n", p_entity->name, __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    g_print_error("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int update_entity_components ( GXEntity_t *p_entity )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( p_entity        == (void *) 0 ) goto no_entity;
+        if ( p_entity->chunk == (void *) 0 ) goto not_stored;
+    #endif
+
+    // Initialized data
+    GXArchetypeChunk_t   *p_chunk   = p_entity->chunk;
+    GXComponentStorage_t *p_storage = p_chunk->archetype->storage;
+
+    // Same components. Refresh the row in place
+    if ( entity_components(p_entity) == p_chunk->archetype->components )
+    {
+        write_chunk_row(p_chunk, p_entity->chunk_row, p_entity);
+
+        // Success
+        return 1;
+    }
+
+    // Move the entity to its new archetype. The entity keeps its handle
+    {
+
+        // Initialized data
+        GXArchetype_t *p_archetype = find_archetype(p_storage, entity_components(p_entity));
+
+        // Error check
+        if ( p_archetype                          == (void *) 0 ) goto failed_to_move;
+        if ( reserve_component_change(p_storage) == 0          ) goto failed_to_move;
+
+        remove_archetype_row(p_entity);
+
+        if ( append_archetype_row(p_archetype, p_entity) == 0 )
+        {
+
+            // The entity is no longer stored. Leave the work lists, so nothing reads its missing chunk
+            (void) list_entity(p_storage, p_entity, 0);
+
+            (void) release_handle(p_storage->handles, p_entity->handle);
+
+            p_entity->handle = HANDLE_INVALID;
+
+            goto failed_to_move;
+        }
+
+        p_storage->entity_count++;
+
+        // Update the work lists on the next update
+        p_storage->changes[p_storage->change_count++] = p_entity->handle;
+    }
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_entity:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Archetype] Null pointer provided for parameter \"p_entity\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            not_stored:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Archetype] Entity \"%s\" is not stored in call to function \"%s\"\n", p_entity->name, __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // G10 errors
+        {
+            failed_to_move:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Archetype] Failed to move entity \"%s\" to a new archetype in call to function \"%s\"\n", p_entity->name, __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int remove_entity_components ( GXEntity_t *p_entity )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( p_entity        == (void *) 0 ) goto no_entity;
+        if ( p_entity->chunk == (void *) 0 ) goto not_stored;
+    #endif
+
+    // Initialized data
+    GXComponentStorage_t *p_storage = p_entity->chunk->archetype->storage;
+
+    // Leave the work lists now. They must never hold an entity that is about to be freed
+    (void) list_entity(p_storage, p_entity, 0);
+
+    // Release the handle. The entity's entries in the change log go stale
+    (void) release_handle(p_storage->handles, p_entity->handle);
+
+    p_entity->handle = HANDLE_INVALID;
+
+    // Remove the row
+    remove_archetype_row(p_entity);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_entity:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Archetype] Null pointer provided for parameter \"p_entity\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            not_stored:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Archetype] Entity \"%s\" is not stored in call to function \"%s\"\n", p_entity->name, __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int apply_component_changes ( GXComponentStorage_t *p_storage )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( p_storage == (void *) 0 ) goto no_storage;
+    #endif
+
+    // Iterate over each change
+    for (size_t i = 0; i < p_storage->change_count; i++)
+    {
+
+        // Initialized data
+        GXEntity_t *p_entity = resolve_handle(p_storage->handles, p_storage->changes[i]);
+
+        // The entity was removed after it changed
+        if ( p_entity == (void *) 0 ) continue;
+
+        // Move the entity between work lists
+        if ( list_entity(p_storage, p_entity, p_entity->chunk->archetype->components) == 0 )
+        {
+
+            // Keep the changes that were not applied, and try them again next time
+            memmove(p_storage->changes, &p_storage->changes[i], ( p_storage->change_count - i ) * sizeof(handle_t));
+
+            p_storage->change_count -= i;
+
+            goto no_mem;
+        }
+    }
+
+    // Clear the change log
+    p_storage->change_count = 0;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_storage:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Archetype] Null pointer provided for parameter \"p_storage\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    g_print_error("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+GXEntity_t *next_work_item ( GXWorkList_t *p_work_list, size_t *p_cursor )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( p_work_list == (void *) 0 ) goto no_work_list;
+        if ( p_cursor    == (void *) 0 ) goto no_cursor;
+    #endif
+
+    // End of the list
+    if ( *p_cursor >= p_work_list->count ) return 0;
+
+    // Success
+    return p_work_list->entities[(*p_cursor)++];
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_work_list:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Archetype] Null pointer provided for parameter \"p_work_list\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_cursor:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Archetype] Null pointer provided for parameter \"p_cursor\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+u32 entity_components ( GXEntity_t *p_entity )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( p_entity == (void *) 0 ) goto no_entity;
+    #endif
+
+    // Success
+    return ( ( p_entity->transform ) ? COMPONENT_TRANSFORM : 0 ) |
+           ( ( p_entity->rigidbody ) ? COMPONENT_RIGIDBODY : 0 ) |
+           ( ( p_entity->collider  ) ? COMPONENT_COLLIDER  : 0 ) |
+           ( ( p_entity->ai        ) ? COMPONENT_AI        : 0 );
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_entity:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Archetype] Null pointer provided for parameter \"p_entity\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+GXEntity_t *resolve_entity ( GXComponentStorage_t *p_storage, handle_t handle )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( p_storage == (void *) 0 ) goto no_storage;
+    #endif
+
+    // Success OR null pointer if the handle is stale
+    return (GXEntity_t *) resolve_handle(p_storage->handles, handle);
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_storage:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Archetype] Null pointer provided for parameter \"p_storage\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int destroy_component_storage ( GXComponentStorage_t **pp_storage )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( pp_storage == (void *) 0 ) goto no_storage;
+    #endif
+
+    // Initialized data
+    GXComponentStorage_t *p_storage = *pp_storage;
+
+    // No more pointer for caller
+    *pp_storage = 0;
+
+    // Nothing to free
+    if ( p_storage == (void *) 0 ) return 1;
+
+    // Free each archetype
+    for (size_t i = 0; i < ARCHETYPE_COUNT; i++)
+    {
+
+        // Initialized data
+        GXArchetype_t *p_archetype = p_storage->archetypes[i];
+
+        if ( p_archetype == (void *) 0 ) continue;
+
+        // Free each chunk
+        for (size_t j = 0; j < p_archetype->chunk_count; j++)
+        {
+
+            // Initialized data
+            GXArchetypeChunk_t *p_chunk = p_archetype->chunks[j];
+
+            // Detach the entities
+            for (size_t k = 0; k < p_chunk->count; k++)
+            {
+                p_chunk->entities[k]->chunk      = 0;
+                p_chunk->entities[k]->chunk_row  = 0;
+                p_chunk->entities[k]->handle     = HANDLE_INVALID;
+                p_chunk->entities[k]->work_lists = 0;
+            }
+
+            free(p_chunk);
+        }
+
+        G10_FREE(p_archetype->chunks);
+        free(p_archetype);
+    }
+
+    // Free the work lists and the change log
+    for (size_t i = 0; i < WORK_LIST_COUNT; i++)
+        G10_FREE(p_storage->work_lists[i].entities);
+
+    G10_FREE(p_storage->changes);
+
+    // Free the handle table
+    (void) destroy_handle_table(&p_storage->handles);
+
+    // Free the storage
+    free(p_storage);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_storage:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Archetype] Null pointer provided for parameter \"pp_storage\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
@@ -0,0 +1,468 @@
+#include <G10/GXArena.h>
+
+// Platform dependent aligned allocation
+#ifdef _WIN32
+    #include <malloc.h>
+#endif
+
+// Blocks each thread carves from, one per arena, most recent first
+#define ARENA_THREAD_BLOCKS 4
+
+// Windows in each leaf of the window map
+#define ARENA_MAP_LEAF_SHIFT 16
+#define ARENA_MAP_LEAF_SIZE  ( (size_t) 1 << ARENA_MAP_LEAF_SHIFT )
+
+// Leaves of the window map. Covers 48 bit addresses
+#define ARENA_MAP_LEAVES     ( (size_t) 1 << 16 )
+
+// Every live arena
+static struct
+{
+    u64           next_id;
+
+    // One flag for each window that an arena block covers. Leaves are allocated
+    // the first time a block lands in them, and never freed
+    u8           *windows[ARENA_MAP_LEAVES];
+
+    // Guards the ids, and writing the window map
+    SDL_SpinLock  lock;
+} arenas = { 0 };
+
+// Allocate memory that starts on a window
+static void *alloc_window_aligned ( size_t size )
+{
+
+    #ifdef _WIN32
+
+        // Allocate on a window
+        return _aligned_malloc(size, ARENA_WINDOW_SIZE);
+    #else
+
+        // Initialized data
+        void *p = 0;
+
+        // Allocate on a window
+        if ( posix_memalign(&p, ARENA_WINDOW_SIZE, size) ) return 0;
+
+        // Success
+        return p;
+    #endif
+}
+
+// Free memory from alloc_window_aligned
+static void free_window_aligned ( void *p )
+{
+
+    #ifdef _WIN32
+        _aligned_free(p);
+    #else
+        free(p);
+    #endif
+}
+
+// Flag, or clear, each window a block covers
+static int map_block_windows ( GXArenaBlock_t *p_block, u8 owned )
+{
+
+    // Initialized data
+    uintptr_t first = (uintptr_t) p_block >> ARENA_WINDOW_SHIFT,
+              last  = ( (uintptr_t) p_block->data + p_block->size - 1 ) >> ARENA_WINDOW_SHIFT;
+    int       ret   = 1;
+
+    SDL_AtomicLock(&arenas.lock);
+
+    for (uintptr_t w = first; w <= last; w++)
+    {
+
+        // Initialized data
+        size_t  leaf   = (size_t) ( w >> ARENA_MAP_LEAF_SHIFT );
+        u8     *p_leaf = 0;
+
+        // Out of range of the map
+        if ( leaf >= ARENA_MAP_LEAVES ) { ret = 0; break; }
+
+        p_leaf = arenas.windows[leaf];
+
+        // Allocate the leaf
+        if ( p_leaf == (void *) 0 )
+        {
+
+            // Nothing to clear
+            if ( owned == 0 ) continue;
+
+            p_leaf = calloc(ARENA_MAP_LEAF_SIZE, sizeof(u8));
+
+            // Error check
+            if ( p_leaf == (void *) 0 ) { ret = 0; break; }
+
+            // Readers look leaves up without the lock
+            SDL_AtomicSetPtr((void **)&arenas.windows[leaf], p_leaf);
+        }
+
+        p_leaf[w & ( ARENA_MAP_LEAF_SIZE - 1 )] = owned;
+    }
+
+    SDL_AtomicUnlock(&arenas.lock);
+
+    return ret;
+}
+
+// The arena bound to this thread, and the blocks this thread carves from
+static G10_THREAD_LOCAL GXArena_t *thread_arena = 0;
+static G10_THREAD_LOCAL struct
+{
+    u64             arena_id;
+    GXArenaBlock_t *block;
+} thread_blocks[ARENA_THREAD_BLOCKS] = { 0 };
+
+int create_arena ( GXArena_t **pp_arena, size_t block_size )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( pp_arena == (void *) 0 ) goto no_arena;
+    #endif
+
+    // Initialized data
+    GXArena_t *p_arena = calloc(1, sizeof(GXArena_t));
+
+    // Memory check
+    if ( p_arena == (void *) 0 ) goto no_mem;
+
+    // Round the block size up to the alignment
+    block_size = ( block_size ) ? block_size : ARENA_BLOCK_SIZE;
+
+    p_arena->block_size = ( block_size + ARENA_ALIGNMENT - 1 ) & ~(size_t)( ARENA_ALIGNMENT - 1 );
+
+    // Give the arena an id
+    SDL_AtomicLock(&arenas.lock);
+
+    p_arena->id = ++arenas.next_id;
+
+    SDL_AtomicUnlock(&arenas.lock);
+
+    // Return the allocated memory
+    *pp_arena = p_arena;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_arena:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Arena] Null pointer provided for parameter \"pp_arena\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    g_print_error("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+void *arena_alloc ( GXArena_t *p_arena, size_t size )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( p_arena == (void *) 0 ) goto no_arena;
+    #endif
+
+    // Initialized data
+    GXArenaBlock_t *p_block = 0;
+    void           *p       = 0;
+
+    // Round the size up to the alignment
+    size = ( size + ARENA_ALIGNMENT - 1 ) & ~(size_t)( ARENA_ALIGNMENT - 1 );
+
+    // Fast path. Carve from this thread's block, without a lock
+    for (size_t i = 0; i < ARENA_THREAD_BLOCKS; i++)
+    {
+
+        // Not this arena's block
+        if ( thread_blocks[i].arena_id != p_arena->id ) continue;
+
+        p_block = thread_blocks[i].block;
+
+        // Carve
+        if ( p_block->size - p_block->used >= size )
+        {
+            p = &p_block->data[p_block->used];
+
+            p_block->used += size;
+
+            // Success
+            return p;
+        }
+
+        break;
+    }
+
+    // Slow path. Allocate a block. Blocks are zeroed, and never reused, so allocations are zeroed too
+    {
+
+        // Initialized data
+        size_t  header     = offsetof(GXArenaBlock_t, data),
+                block_size = ( size + header > p_arena->block_size ) ? size + header : p_arena->block_size;
+
+        // Cover whole windows
+        block_size = ( block_size + ARENA_WINDOW_SIZE - 1 ) & ~( ARENA_WINDOW_SIZE - 1 );
+
+        // Start on a window
+        p_block = alloc_window_aligned(block_size);
+
+        // Error check
+        if ( p_block == (void *) 0 ) goto no_mem;
+
+        // Zero the block
+        memset(p_block, 0, block_size);
+
+        p_block->size = block_size - header;
+        p_block->used = size;
+
+        // Record the windows of the block
+        if ( map_block_windows(p_block, 1) == 0 )
+        {
+            map_block_windows(p_block, 0);
+
+            free_window_aligned(p_block);
+
+            goto no_mem;
+        }
+
+        G10_STAT_ADD(stat_arena_bytes, (i64) p_block->size);
+
+        p = p_block->data;
+
+        // Add the block to the arena
+        SDL_AtomicLock(&p_arena->lock);
+
+        p_block->next   = p_arena->blocks;
+        p_arena->blocks = p_block;
+        p_arena->block_count++;
+
+        SDL_AtomicUnlock(&p_arena->lock);
+    }
+
+    // Carve from the new block from now on, unless the allocation used all of it
+    if ( p_block->used < p_block->size )
+    {
+
+        // Initialized data
+        size_t slot = ARENA_THREAD_BLOCKS - 1;
+
+        // Replace this arena's old block, or else the least recent block
+        for (size_t i = 0; i < ARENA_THREAD_BLOCKS; i++)
+            if ( thread_blocks[i].arena_id == p_arena->id ) { slot = i; break; }
+
+        // Move the block to the front
+        memmove(&thread_blocks[1], &thread_blocks[0], slot * sizeof(thread_blocks[0]));
+
+        thread_blocks[0].arena_id = p_arena->id;
+        thread_blocks[0].block    = p_block;
+    }
+
+    // Success
+    return p;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_arena:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Arena] Null pointer provided for parameter \"p_arena\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    g_print_error("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+GXArena_t *set_thread_arena ( GXArena_t *p_arena )
+{
+
+    // Initialized data
+    GXArena_t *p_previous = thread_arena;
+
+    // Bind the arena
+    thread_arena = p_arena;
+
+    // Success
+    return p_previous;
+}
+
+void *arena_calloc ( size_t count, size_t size )
+{
+
+    // Allocate from the heap
+    if ( thread_arena == (void *) 0 )
+        return calloc(count, size);
+
+    // Overflow
+    if ( size && count > SIZE_MAX / size )
+        return 0;
+
+    // Allocate from the thread's arena
+    return arena_alloc(thread_arena, count * size);
+}
+
+void arena_free ( void *p )
+{
+
+    // Nothing to free
+    if ( p == (void *) 0 ) return;
+
+    // Memory from the heap
+    if ( arena_owned(p) == false )
+        free(p);
+}
+
+GXArena_t *get_thread_arena ( void )
+{
+
+    // Success
+    return thread_arena;
+}
+
+bool arena_owns ( GXArena_t *p_arena, void *p )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( p_arena == (void *) 0 ) goto no_arena;
+    #endif
+
+    // Initialized data
+    bool owned = false;
+
+    SDL_AtomicLock(&p_arena->lock);
+
+    // Search each block
+    for (GXArenaBlock_t *i = p_arena->blocks; i && owned == false; i = i->next)
+        owned = (u8 *) p >= i->data && (u8 *) p < i->data + i->size;
+
+    SDL_AtomicUnlock(&p_arena->lock);
+
+    // Success
+    return owned;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_arena:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Arena] Null pointer provided for parameter \"p_arena\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return false;
+        }
+    }
+}
+
+bool arena_owned ( void *p )
+{
+
+    // Initialized data
+    uintptr_t  w      = (uintptr_t) p >> ARENA_WINDOW_SHIFT;
+    size_t     leaf   = (size_t) ( w >> ARENA_MAP_LEAF_SHIFT );
+    u8        *p_leaf = 0;
+
+    // Out of range of the map, so no block covers it
+    if ( leaf >= ARENA_MAP_LEAVES ) return false;
+
+    p_leaf = SDL_AtomicGetPtr((void **)&arenas.windows[leaf]);
+
+    // Success
+    return p_leaf && p_leaf[w & ( ARENA_MAP_LEAF_SIZE - 1 )];
+}
+
+int destroy_arena ( GXArena_t **pp_arena )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( pp_arena == (void *) 0 ) goto no_arena;
+    #endif
+
+    // Initialized data
+    GXArena_t *p_arena = *pp_arena;
+
+    // No more pointer for caller
+    *pp_arena = 0;
+
+    // Nothing to free
+    if ( p_arena == (void *) 0 ) return 1;
+
+    // Unbind the arena from this thread
+    if ( thread_arena == p_arena )
+        thread_arena = 0;
+
+    // Free each block
+    while ( p_arena->blocks )
+    {
+
+        // Initialized data
+        GXArenaBlock_t *p_block = p_arena->blocks;
+
+        p_arena->blocks = p_block->next;
+
+        G10_STAT_ADD(stat_arena_bytes, -(i64) p_block->size);
+
+        // Forget the windows of the block
+        map_block_windows(p_block, 0);
+
+        free_window_aligned(p_block);
+    }
+
+    // Free the arena
+    free(p_arena);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_arena:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Arena] Null pointer provided for parameter \"pp_arena\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
@@ -0,0 +1,933 @@
+#include <G10/GXAsset.h>
+#include <G10/GXPLY.h>
+
+// The stages, in order
+#define ASSET_STAGE_READ   0
+#define ASSET_STAGE_DECODE 1
+#define ASSET_STAGE_UPLOAD 2
+#define ASSET_STAGE_COUNT  3
+
+// The first word of every SPIR-V module
+#define SPIRV_MAGIC 0x07230203
+
+// A request waiting for a stage. An asset waits again when its priority is raised, and the entry it leaves behind is skipped
+struct asset_entry_s
+{
+    GXAsset_t *p_asset;
+    i32        priority;
+    u64        sequence;
+};
+
+// A stage, and the requests waiting for it. The entries are a heap, highest priority first
+struct asset_stage_s
+{
+    const char           *name;
+    struct asset_entry_s *entries;
+    size_t                count,
+                          max,
+                          thread_count;
+    SDL_cond             *ready;
+    double                busy;
+};
+
+// What each stage does to a type of asset, what to free once the asset is finished, and how to destroy results no callback took
+struct asset_loader_s
+{
+    int  (*pfn_stages[ASSET_STAGE_COUNT])(GXAsset_t *p_asset);
+    void (*pfn_clean)(GXAsset_t *p_asset);
+    void (*pfn_destroy)(GXAsset_t *p_asset);
+};
+
+// Forward declarations
+static int  read_ply_asset             ( GXAsset_t *p_asset );
+static int  decode_ply_asset           ( GXAsset_t *p_asset );
+static int  upload_ply_asset           ( GXAsset_t *p_asset );
+static int  upload_quantized_ply_asset ( GXAsset_t *p_asset );
+static void clean_ply_asset            ( GXAsset_t *p_asset );
+static void destroy_ply_asset          ( GXAsset_t *p_asset );
+static int  read_file_asset            ( GXAsset_t *p_asset );
+static int  decode_spirv_asset         ( GXAsset_t *p_asset );
+static int  upload_spirv_asset         ( GXAsset_t *p_asset );
+static void clean_file_asset           ( GXAsset_t *p_asset );
+static void destroy_spirv_asset        ( GXAsset_t *p_asset );
+
+// Loader of each type of asset
+static const struct asset_loader_s loaders[asset_type_count] = {
+    [asset_type_part]           = { { read_ply_asset , decode_ply_asset  , upload_ply_asset           }, clean_ply_asset  , destroy_ply_asset   },
+    [asset_type_shader_module]  = { { read_file_asset, decode_spirv_asset, upload_spirv_asset         }, clean_file_asset , destroy_spirv_asset },
+    [asset_type_quantized_part] = { { read_ply_asset , decode_ply_asset  , upload_quantized_ply_asset }, clean_ply_asset  , destroy_ply_asset   }
+};
+
+// Guards every request, and every stage
+static SDL_mutex            *lock                       = 0;
+static SDL_cond             *finished                   = 0;
+static struct asset_stage_s  stages[ASSET_STAGE_COUNT]  = { { .name = "read" }, { .name = "decode" }, { .name = "upload" } };
+
+// Requests of each type, by path
+static dict                 *requests[asset_type_count] = { 0 };
+
+// Threads of every stage
+static SDL_Thread          **threads                    = 0;
+static size_t                thread_count               = 0;
+
+// Requests that have not settled, and the order of the last request
+static size_t                in_flight                  = 0;
+static u64                   sequence                   = 0;
+static bool                  running                    = false;
+
+static double now ( void )
+{
+    return (double) SDL_GetPerformanceCounter() / (double) SDL_GetPerformanceFrequency();
+}
+
+static bool entry_before ( struct asset_entry_s *a, struct asset_entry_s *b )
+{
+    return a->priority > b->priority || ( a->priority == b->priority && a->sequence < b->sequence );
+}
+
+// Queue an asset for a stage. Called with the lock held
+static int push_asset ( size_t stage, GXAsset_t *p_asset )
+{
+
+    // Initialized data
+    struct asset_stage_s *p_stage = &stages[stage];
+    size_t                i       = p_stage->count;
+
+    // Grow the heap
+    if ( p_stage->count == p_stage->max )
+    {
+
+        // Initialized data
+        size_t                max       = ( p_stage->max ) ? p_stage->max * 2 : 64;
+        struct asset_entry_s *p_entries = G10_REALLOC(p_stage->entries, max * sizeof(struct asset_entry_s));
+
+        // Error checking
+        if ( p_entries == (void *) 0 ) return 0;
+
+        p_stage->entries = p_entries,
+        p_stage->max     = max;
+    }
+
+    p_stage->entries[i] = (struct asset_entry_s) { .p_asset = p_asset, .priority = p_asset->priority, .sequence = p_asset->sequence };
+    p_stage->count++;
+
+    // Sift up
+    while ( i && entry_before(&p_stage->entries[i], &p_stage->entries[( i - 1 ) / 2]) )
+    {
+
+        // Initialized data
+        struct asset_entry_s t = p_stage->entries[i];
+
+        p_stage->entries[i]             = p_stage->entries[( i - 1 ) / 2],
+        p_stage->entries[( i - 1 ) / 2] = t;
+
+        i = ( i - 1 ) / 2;
+    }
+
+    // The entry holds the asset
+    p_asset->references++;
+
+    // Wake a thread of the stage
+    SDL_CondSignal(p_stage->ready);
+
+    // Success
+    return 1;
+}
+
+// Take the first asset waiting for a stage. The caller gets the reference of the entry. Called with the lock held
+static GXAsset_t *pop_asset ( size_t stage )
+{
+
+    // Initialized data
+    struct asset_stage_s *p_stage = &stages[stage];
+    GXAsset_t            *p_asset = p_stage->entries[0].p_asset;
+    size_t                i       = 0;
+
+    p_stage->entries[0] = p_stage->entries[--p_stage->count];
+
+    // Sift down
+    for (;;)
+    {
+
+        // Initialized data
+        size_t l     = i * 2 + 1,
+               r     = l + 1,
+               first = i;
+
+        if ( l < p_stage->count && entry_before(&p_stage->entries[l], &p_stage->entries[first]) ) first = l;
+        if ( r < p_stage->count && entry_before(&p_stage->entries[r], &p_stage->entries[first]) ) first = r;
+
+        if ( first == i ) break;
+
+        {
+
+            // Initialized data
+            struct asset_entry_s t = p_stage->entries[i];
+
+            p_stage->entries[i]     = p_stage->entries[first],
+            p_stage->entries[first] = t;
+        }
+
+        i = first;
+    }
+
+    return p_asset;
+}
+
+// Drop a reference. The last reference forgets the request, and destroys what no callback took. Called with the lock held
+static void unref_asset ( GXAsset_t *p_asset )
+{
+
+    if ( --p_asset->references ) return;
+
+    // A failed request may have been replaced by a retry
+    if ( dict_get(requests[p_asset->type], p_asset->path) == p_asset )
+        dict_pop(requests[p_asset->type], p_asset->path, 0);
+
+    loaders[p_asset->type].pfn_destroy(p_asset);
+
+    G10_FREE(p_asset->callbacks);
+    free(p_asset->path);
+    free(p_asset);
+}
+
+// Finish an asset, and run its callbacks. Called with the lock held
+static void finish_asset ( GXAsset_t *p_asset, bool loaded )
+{
+
+    // From here, new requests for the asset run their callbacks themselves
+    p_asset->state = ( loaded ) ? asset_state_done : asset_state_failed;
+
+    for (size_t i = 0; i < p_asset->callback_count; i++)
+        p_asset->callbacks[i].pfn_callback(p_asset, p_asset->callbacks[i].p_user);
+
+    G10_FREE(p_asset->callbacks);
+
+    p_asset->callbacks      = 0,
+    p_asset->callback_count = 0,
+    p_asset->callback_max   = 0;
+
+    p_asset->settled = true;
+    in_flight--;
+
+    SDL_CondBroadcast(finished);
+}
+
+static int asset_work ( void *vp_stage )
+{
+
+    // Initialized data
+    size_t stage = (size_t) vp_stage;
+
+    SDL_LockMutex(lock);
+
+    while ( running )
+    {
+
+        // Initialized data
+        GXAsset_t *p_asset = 0;
+        int        result  = 0;
+        double     start   = 0;
+
+        // Sleep until there is work
+        if ( stages[stage].count == 0 )
+        {
+            SDL_CondWait(stages[stage].ready, lock);
+
+            continue;
+        }
+
+        p_asset = pop_asset(stage);
+
+        // The asset was queued again with a higher priority, and has already passed this stage
+        if ( p_asset->state != (asset_state_t)( stage * 2 ) )
+        {
+            unref_asset(p_asset);
+
+            continue;
+        }
+
+        // Claim the asset
+        p_asset->state++;
+
+        SDL_UnlockMutex(lock);
+
+        // Run the stage
+        start  = now();
+        result = loaders[p_asset->type].pfn_stages[stage](p_asset);
+
+        // Record the time spent
+        {
+
+            // Initialized data
+            double elapsed = now() - start;
+
+            if      ( stage == ASSET_STAGE_READ )   p_asset->read_time   = elapsed;
+            else if ( stage == ASSET_STAGE_DECODE ) p_asset->decode_time = elapsed;
+            else                                    p_asset->upload_time = elapsed;
+
+            // Free what the stages left behind
+            if ( result == 0 || stage == ASSET_STAGE_UPLOAD )
+                loaders[p_asset->type].pfn_clean(p_asset);
+
+            SDL_LockMutex(lock);
+
+            stages[stage].busy += elapsed;
+        }
+
+        // Hand the asset to the next stage
+        if ( result && stage < ASSET_STAGE_UPLOAD )
+        {
+            p_asset->state++;
+
+            if ( push_asset(stage + 1, p_asset) == 0 )
+            {
+                SDL_UnlockMutex(lock);
+                loaders[p_asset->type].pfn_clean(p_asset);
+                SDL_LockMutex(lock);
+
+                finish_asset(p_asset, false);
+            }
+        }
+
+        // Or finish it
+        else
+            finish_asset(p_asset, result);
+
+        // Drop the reference of the entry
+        unref_asset(p_asset);
+    }
+
+    SDL_UnlockMutex(lock);
+
+    // Success
+    return 0;
+}
+
+void init_asset ( void )
+{
+
+    // Initialized data
+    GXInstance_t *p_instance = g_get_active_instance();
+
+    // Create the lock, and the condition variables
+    lock     = SDL_CreateMutex();
+    finished = SDL_CreateCond();
+
+    for (size_t i = 0; i < ASSET_STAGE_COUNT; i++)
+        stages[i].ready = SDL_CreateCond();
+
+    // Construct a dictionary of requests for each type
+    for (size_t i = 0; i < asset_type_count; i++)
+        dict_construct(&requests[i], 64);
+
+    // A few threads read, the loading threads decode, and one thread uploads
+    stages[ASSET_STAGE_READ].thread_count   = ASSET_IO_THREADS;
+    stages[ASSET_STAGE_DECODE].thread_count = ( p_instance->loading_thread_count ) ? p_instance->loading_thread_count : 1;
+    stages[ASSET_STAGE_UPLOAD].thread_count = 1;
+
+    threads = calloc(ASSET_IO_THREADS + stages[ASSET_STAGE_DECODE].thread_count + 1, sizeof(SDL_Thread *));
+
+    // Error checking
+    if ( threads == (void *) 0 ) goto no_mem;
+
+    running = true;
+
+    // Spawn the threads of each stage
+    for (size_t i = 0; i < ASSET_STAGE_COUNT; i++)
+        for (size_t j = 0; j < stages[i].thread_count; j++)
+            threads[thread_count++] = SDL_CreateThread(asset_work, stages[i].name, (void *) i);
+
+    return;
+
+    // Error handling
+    {
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    g_print_error("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return;
+        }
+    }
+}
+
+int request_asset ( GXAsset_t **pp_asset, asset_type_t type, const char *path, i32 priority, void (*pfn_callback)(GXAsset_t *p_asset, void *p_user), void *p_user )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( pp_asset == (void *) 0 )     goto no_asset;
+        if ( type     >= asset_type_count ) goto bad_type;
+        if ( path     == (void *) 0 )     goto no_path;
+    #endif
+
+    // Initialized data
+    GXAsset_t *p_asset = 0;
+
+    SDL_LockMutex(lock);
+
+    // Error checking
+    if ( running == false ) goto not_running;
+
+    // Look for the same file
+    p_asset = dict_get(requests[type], (char *) path);
+
+    // Retry assets that failed
+    if ( p_asset && p_asset->state == asset_state_failed )
+    {
+        dict_pop(requests[type], (char *) path, 0);
+
+        p_asset = 0;
+    }
+
+    // The file is already requested
+    if ( p_asset )
+    {
+        p_asset->references++;
+
+        // Raise the priority. The asset waits again in the queue of its stage, and the old entry is skipped
+        if ( priority > p_asset->priority )
+        {
+            p_asset->priority = priority;
+
+            if ( p_asset->state < asset_state_done && p_asset->state % 2 == 0 )
+                (void) push_asset(p_asset->state / 2, p_asset);
+        }
+    }
+
+    // Make a new request
+    else
+    {
+
+        // Initialized data
+        size_t path_len = strlen(path);
+
+        p_asset = calloc(1, sizeof(GXAsset_t));
+
+        // Error checking
+        if ( p_asset == (void *) 0 ) goto no_mem;
+
+        p_asset->path = calloc(path_len + 1, sizeof(char));
+
+        // Error checking
+        if ( p_asset->path == (void *) 0 ) goto no_mem;
+
+        // Copy the path
+        strncpy(p_asset->path, path, path_len);
+
+        p_asset->type       = type,
+        p_asset->state      = asset_state_read,
+        p_asset->priority   = priority,
+        p_asset->sequence   = sequence++,
+        p_asset->references = 1;
+
+        // Queue the asset for the first stage
+        if ( push_asset(ASSET_STAGE_READ, p_asset) == 0 ) goto no_mem;
+
+        dict_add(requests[type], p_asset->path, p_asset);
+
+        in_flight++;
+    }
+
+    // Add the callback
+    if ( pfn_callback )
+    {
+
+        // The asset is already finished. Call back now
+        if ( p_asset->state >= asset_state_done )
+            pfn_callback(p_asset, p_user);
+
+        // Call back when the asset is finished
+        else
+        {
+
+            // Grow the callbacks
+            if ( p_asset->callback_count == p_asset->callback_max )
+            {
+
+                // Initialized data
+                size_t                   max       = ( p_asset->callback_max ) ? p_asset->callback_max * 2 : 4;
+                struct asset_callback_s *callbacks = G10_REALLOC(p_asset->callbacks, max * sizeof(struct asset_callback_s));
+
+                // Error checking
+                if ( callbacks == (void *) 0 ) goto no_mem_for_callback;
+
+                p_asset->callbacks    = callbacks,
+                p_asset->callback_max = max;
+            }
+
+            p_asset->callbacks[p_asset->callback_count].pfn_callback = pfn_callback,
+            p_asset->callbacks[p_asset->callback_count].p_user       = p_user;
+            p_asset->callback_count++;
+        }
+    }
+
+    SDL_UnlockMutex(lock);
+
+    // Return a pointer to the caller
+    *pp_asset = p_asset;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_asset:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Asset] Null pointer provided for parameter \"pp_asset\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            bad_type:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Asset] Parameter \"type\" is out of range in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_path:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Asset] Null pointer provided for parameter \"path\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // G10 errors
+        {
+            not_running:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Asset] The asset pipeline is not running in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                SDL_UnlockMutex(lock);
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    g_print_error("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Free the request
+                if ( p_asset )
+                    free(p_asset->path);
+
+                free(p_asset);
+
+                SDL_UnlockMutex(lock);
+
+                // Error
+                return 0;
+
+            no_mem_for_callback:
+                #ifndef NDEBUG
+                    g_print_error("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Drop the reference of this request
+                unref_asset(p_asset);
+
+                SDL_UnlockMutex(lock);
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int wait_asset ( GXAsset_t *p_asset )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( p_asset == (void *) 0 ) goto no_asset;
+    #endif
+
+    // Initialized data
+    int loaded = 0;
+
+    SDL_LockMutex(lock);
+
+    // Wait for the callbacks, too
+    while ( p_asset->settled == false )
+        SDL_CondWait(finished, lock);
+
+    loaded = ( p_asset->state == asset_state_done );
+
+    SDL_UnlockMutex(lock);
+
+    return loaded;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_asset:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Asset] Null pointer provided for parameter \"p_asset\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int wait_assets ( void )
+{
+
+    SDL_LockMutex(lock);
+
+    while ( in_flight )
+        SDL_CondWait(finished, lock);
+
+    SDL_UnlockMutex(lock);
+
+    // Success
+    return 1;
+}
+
+asset_state_t get_asset_state ( GXAsset_t *p_asset )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( p_asset == (void *) 0 ) goto no_asset;
+    #endif
+
+    // Initialized data
+    asset_state_t state = asset_state_read;
+
+    SDL_LockMutex(lock);
+
+    state = p_asset->state;
+
+    SDL_UnlockMutex(lock);
+
+    return state;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_asset:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Asset] Null pointer provided for parameter \"p_asset\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return asset_state_failed;
+        }
+    }
+}
+
+int asset_info ( void )
+{
+
+    SDL_LockMutex(lock);
+
+    // Formatting
+    g_print_log(" - Assets - \n");
+
+    // Print the requests that have not settled
+    g_print_log("in flight : %zu\n", in_flight);
+
+    // Print each stage
+    for (size_t i = 0; i < ASSET_STAGE_COUNT; i++)
+        g_print_log("%-9s : %zu waiting, %zu threads, %.3f s busy\n", stages[i].name, stages[i].count, stages[i].thread_count, stages[i].busy);
+
+    SDL_UnlockMutex(lock);
+
+    putchar('\n');
+
+    // Success
+    return 1;
+}
+
+int release_asset ( GXAsset_t **pp_asset )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( pp_asset == (void *) 0 ) goto no_asset;
+    #endif
+
+    // Initialized data
+    GXAsset_t *p_asset = *pp_asset;
+
+    // No more pointer for caller
+    *pp_asset = 0;
+
+    // Error checking
+    if ( p_asset == (void *) 0 ) goto pointer_to_null_pointer;
+
+    SDL_LockMutex(lock);
+
+    unref_asset(p_asset);
+
+    SDL_UnlockMutex(lock);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_asset:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Asset] Null pointer provided for parameter \"pp_asset\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            pointer_to_null_pointer:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Asset] Parameter \"pp_asset\" points to null pointer in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int stop_assets ( void )
+{
+
+    SDL_LockMutex(lock);
+
+    // Stop the threads after their current stage
+    running = false;
+
+    for (size_t i = 0; i < ASSET_STAGE_COUNT; i++)
+        SDL_CondBroadcast(stages[i].ready);
+
+    SDL_UnlockMutex(lock);
+
+    // Wait for each thread to stop
+    for (size_t i = 0; i < thread_count; i++)
+        SDL_WaitThread(threads[i], 0);
+
+    free(threads);
+
+    threads      = 0,
+    thread_count = 0;
+
+    SDL_LockMutex(lock);
+
+    // Fail whatever is still waiting
+    for (size_t i = 0; i < ASSET_STAGE_COUNT; i++)
+    {
+        while ( stages[i].count )
+        {
+
+            // Initialized data
+            GXAsset_t *p_asset = pop_asset(i);
+
+            if ( p_asset->state == (asset_state_t)( i * 2 ) )
+            {
+                SDL_UnlockMutex(lock);
+                loaders[p_asset->type].pfn_clean(p_asset);
+                SDL_LockMutex(lock);
+
+                finish_asset(p_asset, false);
+            }
+
+            unref_asset(p_asset);
+        }
+
+        G10_FREE(stages[i].entries);
+
+        stages[i].entries = 0,
+        stages[i].max     = 0;
+    }
+
+    SDL_UnlockMutex(lock);
+
+    // Success
+    return 1;
+}
+
+// Parts. The file is mapped and faulted in by the read stage, converted by the decode stage, and copied into buffers by the upload stage
+static int read_ply_asset ( GXAsset_t *p_asset )
+{
+
+    // Initialized data
+    GXPLY_t     *p_ply = 0;
+    volatile u8  touch = 0;
+
+    if ( map_ply(&p_ply, p_asset->path) == 0 ) return 0;
+
+    // Fault each page in, so the decode stage doesn't wait on the disk
+    for (size_t i = 0; i < p_ply->file_size; i += 4096)
+        touch ^= p_ply->file[i];
+
+    (void) touch;
+
+    p_asset->p_decoded = p_ply;
+
+    // Success
+    return 1;
+}
+
+static int decode_ply_asset ( GXAsset_t *p_asset )
+{
+
+    // Initialized data
+    size_t stride = 0,
+           count  = 0;
+
+    // Convert, and triangulate. The upload stage gets the same results back
+    return get_ply_vertices(p_asset->p_decoded, &stride, &count) && get_ply_indices(p_asset->p_decoded, &count);
+}
+
+static int upload_ply_asset ( GXAsset_t *p_asset )
+{
+
+    // Initialized data
+    GXPart_t part = { 0 };
+
+    if ( upload_ply(&part, p_asset->p_decoded) == 0 ) return 0;
+
+    p_asset->part.vertex_buffer         = part.vertex_buffer,
+    p_asset->part.element_buffer        = part.element_buffer,
+    p_asset->part.vertex_buffer_memory  = part.vertex_buffer_memory,
+    p_asset->part.element_buffer_memory = part.element_buffer_memory,
+    p_asset->part.vertex_count          = part.vertex_count,
+    p_asset->part.index_count           = part.index_count;
+
+    // Success
+    return 1;
+}
+
+static int upload_quantized_ply_asset ( GXAsset_t *p_asset )
+{
+
+    // Initialized data
+    GXPart_t part = { 0 };
+
+    if ( upload_ply_quantized(&part, p_asset->p_decoded) == 0 ) return 0;
+
+    p_asset->part.vertex_buffer         = part.vertex_buffer,
+    p_asset->part.element_buffer        = part.element_buffer,
+    p_asset->part.vertex_buffer_memory  = part.vertex_buffer_memory,
+    p_asset->part.element_buffer_memory = part.element_buffer_memory,
+    p_asset->part.vertex_count          = part.vertex_count,
+    p_asset->part.index_count           = part.index_count,
+    p_asset->part.vertex_groups         = part.vertex_groups,
+    p_asset->part.dequantize            = part.dequantize;
+
+    // Success
+    return 1;
+}
+
+static void clean_ply_asset ( GXAsset_t *p_asset )
+{
+    if ( p_asset->p_decoded )
+        unmap_ply((GXPLY_t **) &p_asset->p_decoded);
+}
+
+static void destroy_ply_asset ( GXAsset_t *p_asset )
+{
+
+    // Initialized data
+    GXInstance_t *p_instance = g_get_active_instance();
+
+    // Taken by a callback
+    if ( p_asset->part.vertex_buffer == 0 && p_asset->part.element_buffer == 0 ) return;
+
+    // Free the vertex buffer
+    vkDestroyBuffer(p_instance->vulkan.device, p_asset->part.vertex_buffer, 0);
+    vkFreeMemory(p_instance->vulkan.device, p_asset->part.vertex_buffer_memory, 0);
+
+    // Free the index buffer
+    vkDestroyBuffer(p_instance->vulkan.device, p_asset->part.element_buffer, 0);
+    vkFreeMemory(p_instance->vulkan.device, p_asset->part.element_buffer_memory, 0);
+}
+
+// Shader modules are read whole
+static int read_file_asset ( GXAsset_t *p_asset )
+{
+
+    // Initialized data
+    FILE *f    = fopen(p_asset->path, "rb");
+    long  size = 0;
+
+    if ( f == (void *) 0 ) return 0;
+
+    // Find the size of the file
+    fseek(f, 0, SEEK_END);
+    size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+
+    if ( size > 0 )
+        p_asset->data = G10_REALLOC(p_asset->data, (size_t) size + 1);
+
+    // Read the file
+    if ( p_asset->data )
+        p_asset->size = fread(p_asset->data, 1, (size_t) size, f);
+
+    fclose(f);
+
+    // Success
+    return p_asset->size == (size_t) size && size > 0;
+}
+
+static void clean_file_asset ( GXAsset_t *p_asset )
+{
+    G10_FREE(p_asset->data);
+
+    p_asset->data = 0,
+    p_asset->size = 0;
+}
+
+// Shader modules. Checked to be SPIR-V, then handed to the driver
+static int decode_spirv_asset ( GXAsset_t *p_asset )
+{
+
+    // Initialized data
+    u32 magic = 0;
+
+    if ( p_asset->size < sizeof(u32) || p_asset->size % sizeof(u32) ) return 0;
+
+    memcpy(&magic, p_asset->data, sizeof(u32));
+
+    return magic == SPIRV_MAGIC;
+}
+
+static int upload_spirv_asset ( GXAsset_t *p_asset )
+{
+    return create_shader_module((char *) p_asset->data, p_asset->size, &p_asset->shader_module);
+}
+
+static void destroy_spirv_asset ( GXAsset_t *p_asset )
+{
+
+    // Initialized data
+    GXInstance_t *p_instance = g_get_active_instance();
+
+    if ( p_asset->shader_module )
+        vkDestroyShaderModule(p_instance->vulkan.device, p_asset->shader_module, 0);
+}
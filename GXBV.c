@@ -1,5 +1,8 @@
 ﻿#include <G10/GXBV.h>
 
+// Bounding volumes are rebuilt as entities move
+static GXPool_t *bv_pool = 0;
+
 int create_bv ( GXBV_t **pp_bv )
 {
 
@@ -9,7 +12,7 @@ int create_bv ( GXBV_t **pp_bv )
     #endif
 
     // Initialized data
-    GXBV_t *p_bv = calloc(1, sizeof(GXBV_t));
+    GXBV_t *p_bv = G10_POOL_ALLOC(&bv_pool, sizeof(GXBV_t));
 
     // Check if the memory was allocated
     if ( p_bv == (void *) 0 ) goto no_mem;
@@ -195,6 +198,7 @@ int construct_bvh_from_scene ( GXBV_t **pp_bv, GXScene_t *scene )
     GXBV_t     **bounding_volumes  = 0; // List of qualifying entities
 
     // Initialized data
+    GXScratchMark_t scratch            = scratch_mark();
     size_t       actors_in_scene       = dict_values(scene->actors, 0), // How many entities are in the scene?
                  actors_with_colliders = 0,
                  i                     = 0,                           // Iterators      ...
@@ -206,8 +210,8 @@ int construct_bvh_from_scene ( GXBV_t **pp_bv, GXScene_t *scene )
     if ( actors_in_scene == 0 ) goto no_actors;
 
     // Allocate a double pointer list
-    actor_list       = calloc(actors_in_scene, sizeof(void*));
-    bounding_volumes = calloc(actors_in_scene, sizeof(void*));
+    actor_list       = scratch_calloc(actors_in_scene, sizeof(void*));
+    bounding_volumes = scratch_calloc(actors_in_scene, sizeof(void*));
     dict_values(scene->actors, (void **)actor_list);
 
     // Error check
@@ -281,7 +285,9 @@ int construct_bvh_from_scene ( GXBV_t **pp_bv, GXScene_t *scene )
 
     ret = (bounding_volumes) ? *bounding_volumes : 0;
 
-    //free(BVList);
+    // Free the lists
+    scratch_rewind(scratch);
+
     *pp_bv = ret;
 
     // Success
@@ -300,6 +306,9 @@ int construct_bvh_from_scene ( GXBV_t **pp_bv, GXScene_t *scene )
                     g_print_error("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
                 #endif
 
+                // Free the lists
+                scratch_rewind(scratch);
+
                 // Error
                 return 0;
         }
@@ -890,12 +899,15 @@ int destroy_bv ( GXBV_t **pp_bv )
     // No more pointer for caller
     *pp_bv = 0;
 
+    // Nothing to free
+    if ( p_bv == (void *) 0 ) return 1;
+
     // Recursively destroy left and right
     destroy_bv(&p_bv->left);
     destroy_bv(&p_bv->right);
 
     // Free the bounding volume
-    free(p_bv);
+    G10_POOL_FREE(&bv_pool, p_bv);
 
     // Success
     return 1;
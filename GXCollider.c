@@ -2,6 +2,9 @@
 
 #define COLLIDER_TYPE_COUNT 8
 
+// Colliders made outside of a scene arena
+static GXPool_t *collider_pool = 0;
+
 char* collider_type_names[COLLIDER_TYPE_COUNT] = {
     "invalid",
     "quad",
@@ -42,10 +45,13 @@ int create_collider ( GXCollider_t **pp_collider )
     #endif
 
     // Initialized data
-    GXCollider_t * p_collider = calloc(1, sizeof(GXCollider_t));
+    GXCollider_t * p_collider = pool_calloc(&collider_pool, sizeof(GXCollider_t));
 
     // Error check
-    if ( pp_collider == (void *) 0 ) goto no_mem;
+    if ( p_collider == (void *) 0 ) goto no_mem;
+
+    // Count the collider
+    G10_STAT_ADD(stat_colliders, 1);
 
     // Write the return value
     *pp_collider = p_collider;
@@ -196,3 +202,62 @@ int load_collider_as_json_text ( GXCollider_t **collider, char *text )
 //    return 1;
 //}
 //
+
+int destroy_collider ( GXCollider_t **pp_collider )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( pp_collider == (void *) 0 ) goto no_collider;
+    #endif
+
+    // Initialized data
+    GXCollider_t *p_collider = *pp_collider;
+
+    // No more pointer for caller
+    *pp_collider = 0;
+
+    // Nothing to free
+    if ( p_collider == (void *) 0 ) return 1;
+
+    // Destroy the collisions
+    if ( p_collider->collisions )
+        dict_destroy(&p_collider->collisions);
+
+    // Free the convex hull and the callbacks, unless they are borrowed
+    if ( p_collider->source == (void *) 0 )
+    {
+        free(p_collider->convex_hull.convex_hull);
+
+        free(p_collider->aabb.aabb_start_callbacks);
+        free(p_collider->aabb.aabb_callbacks);
+        free(p_collider->aabb.aabb_end_callbacks);
+
+        free(p_collider->obb.obb_start_callbacks);
+        free(p_collider->obb.obb_callbacks);
+        free(p_collider->obb.obb_end_callbacks);
+    }
+
+    // Free the collider
+    pool_release(&collider_pool, p_collider);
+
+    G10_STAT_ADD(stat_colliders, -1);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_collider:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Collider] Null pointer provided for parameter \"pp_collider\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
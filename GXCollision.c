@@ -1,5 +1,8 @@
 #include <G10/GXCollision.h>
 
+// Collision events come and go every frame
+static GXPool_t *collision_pool = 0;
+
 int create_collision ( GXCollision_t **pp_collision )
 {
 
@@ -9,10 +12,10 @@ int create_collision ( GXCollision_t **pp_collision )
     #endif
 
     // Initialized data
-    GXCollision_t *p_collision = calloc(1, sizeof(GXCollision_t));
+    GXCollision_t *p_collision = G10_POOL_ALLOC(&collision_pool, sizeof(GXCollision_t));
 
     // Error check
-    if ( pp_collision == (void *) 0 ) goto no_mem;
+    if ( p_collision == (void *) 0 ) goto no_mem;
 
     // Write the return value
     *pp_collision = p_collision;
@@ -124,3 +127,884 @@ int construct_collision_from_entities ( GXCollision_t **pp_collision, GXEntity_t
         }
     }
 }
+
+// Oriented box in world space, derived from a collider and a model matrix
+struct obb_s
+{
+    vec3  center,
+          axes[3];
+    float extents[3];
+};
+
+static void obb_from_entity ( GXEntity_t *p_entity, struct obb_s *p_obb )
+{
+
+    // Initialized data
+    GXCollider_t *p_collider = p_entity->collider;
+    mat4          m          = p_entity->transform->model_matrix;
+    vec3          rows[3]    =
+    {
+        { m.a, m.b, m.c, 0.f },
+        { m.e, m.f, m.g, 0.f },
+        { m.i, m.j, m.k, 0.f }
+    };
+    vec3          c          =
+    {
+        .x = ( p_collider->aabb.aabb_max.x + p_collider->aabb.aabb_min.x ) * 0.5f,
+        .y = ( p_collider->aabb.aabb_max.y + p_collider->aabb.aabb_min.y ) * 0.5f,
+        .z = ( p_collider->aabb.aabb_max.z + p_collider->aabb.aabb_min.z ) * 0.5f
+    };
+    float         h[3]       =
+    {
+        ( p_collider->aabb.aabb_max.x - p_collider->aabb.aabb_min.x ) * 0.5f,
+        ( p_collider->aabb.aabb_max.y - p_collider->aabb.aabb_min.y ) * 0.5f,
+        ( p_collider->aabb.aabb_max.z - p_collider->aabb.aabb_min.z ) * 0.5f
+    };
+
+    // The model matrix uses row vectors, so the local center is x * row 0 + y * row 1 + z * row 2 + translation
+    p_obb->center = (vec3)
+    {
+        .x = c.x * m.a + c.y * m.e + c.z * m.i + m.m,
+        .y = c.x * m.b + c.y * m.f + c.z * m.j + m.n,
+        .z = c.x * m.c + c.y * m.g + c.z * m.k + m.o
+    };
+
+    // Split each row into a unit axis and a scaled extent
+    for (size_t i = 0; i < 3; i++)
+    {
+
+        // Initialized data
+        float l = length(rows[i]);
+
+        p_obb->axes[i]    = ( l > 0.f ) ? mul_vec3_f(rows[i], 1.f / l) : (vec3) { 0.f, 0.f, 0.f, 0.f };
+        p_obb->extents[i] = h[i] * l;
+    }
+
+    // Done
+    return;
+}
+
+static void sphere_from_entity ( GXEntity_t *p_entity, vec3 *p_center, float *p_radius )
+{
+
+    // Initialized data
+    GXCollider_t *p_collider = p_entity->collider;
+    mat4          m          = p_entity->transform->model_matrix;
+    vec3          min        = p_collider->aabb.aabb_min,
+                  max        = p_collider->aabb.aabb_max;
+    float         r          = p_collider->sphere.radius,
+                  s          = fmaxf(length((vec3) { m.a, m.b, m.c, 0.f }), fmaxf(length((vec3) { m.e, m.f, m.g, 0.f }), length((vec3) { m.i, m.j, m.k, 0.f })));
+
+    // Without a radius, use the largest sphere that fits inside the box
+    if ( r <= 0.f )
+        r = fminf(max.x - min.x, fminf(max.y - min.y, max.z - min.z)) * 0.5f;
+
+    // The center of the box, in world space
+    *p_center = (vec3)
+    {
+        .x = ( max.x + min.x ) * 0.5f * m.a + ( max.y + min.y ) * 0.5f * m.e + ( max.z + min.z ) * 0.5f * m.i + m.m,
+        .y = ( max.x + min.x ) * 0.5f * m.b + ( max.y + min.y ) * 0.5f * m.f + ( max.z + min.z ) * 0.5f * m.j + m.n,
+        .z = ( max.x + min.x ) * 0.5f * m.c + ( max.y + min.y ) * 0.5f * m.g + ( max.z + min.z ) * 0.5f * m.k + m.o
+    };
+
+    // Scale the radius by the largest axis, so the sphere encloses the scaled one
+    *p_radius = r * s;
+
+    // Done
+    return;
+}
+
+static void aabb_from_entity ( GXEntity_t *p_entity, vec3 *p_min, vec3 *p_max )
+{
+
+    // Use the bounding volume, if the collider has one
+    if ( p_entity->collider->bv )
+    {
+        *p_min = p_entity->collider->bv->minimum,
+        *p_max = p_entity->collider->bv->maximum;
+
+        return;
+    }
+
+    // Initialized data
+    struct obb_s obb = { 0 };
+    float        r[3];
+
+    // Compute the world space box
+    obb_from_entity(p_entity, &obb);
+
+    // Compute the axis aligned radius of the oriented box
+    for (size_t i = 0; i < 3; i++)
+        r[i] = fabsf((&obb.axes[0].x)[i]) * obb.extents[0] +
+               fabsf((&obb.axes[1].x)[i]) * obb.extents[1] +
+               fabsf((&obb.axes[2].x)[i]) * obb.extents[2];
+
+    *p_min = (vec3) { obb.center.x - r[0], obb.center.y - r[1], obb.center.z - r[2], 0.f };
+    *p_max = (vec3) { obb.center.x + r[0], obb.center.y + r[1], obb.center.z + r[2], 0.f };
+
+    // Done
+    return;
+}
+
+bool collide_aabb ( GXEntity_t *p_a, GXEntity_t *p_b, GXManifold_t *p_manifold )
+{
+
+    // Initialized data
+    vec3  a_min, a_max,
+          b_min, b_max;
+    float best   = FLT_MAX;
+    int   axis   = 0;
+    float sign   = 1.f;
+
+    // Get the world space boxes
+    aabb_from_entity(p_a, &a_min, &a_max);
+    aabb_from_entity(p_b, &b_min, &b_max);
+
+    // Find the axis of least penetration
+    for (int i = 0; i < 3; i++)
+    {
+
+        // Initialized data
+        float a_lo = (&a_min.x)[i], a_hi = (&a_max.x)[i],
+              b_lo = (&b_min.x)[i], b_hi = (&b_max.x)[i],
+              o    = fminf(a_hi, b_hi) - fmaxf(a_lo, b_lo);
+
+        // Separated on this axis
+        if ( o < 0.f ) return false;
+
+        if ( o < best )
+            best = o,
+            axis = i,
+            sign = ( ( a_lo + a_hi ) < ( b_lo + b_hi ) ) ? 1.f : -1.f;
+    }
+
+    // Write the manifold
+    if ( p_manifold )
+    {
+        *p_manifold = (GXManifold_t)
+        {
+            .a      = p_a,
+            .b      = p_b,
+            .normal = { 0.f, 0.f, 0.f, 0.f },
+            .depth  = best
+        };
+
+        (&p_manifold->normal.x)[axis] = sign;
+    }
+
+    // Colliding
+    return true;
+}
+
+bool collide_sphere ( GXEntity_t *p_a, GXEntity_t *p_b, GXManifold_t *p_manifold )
+{
+
+    // Initialized data
+    vec3  a   = { 0 },
+          b   = { 0 },
+          d   = { 0 };
+    float r_a = 0.f,
+          r_b = 0.f,
+          r   = 0.f,
+          l   = 0.f;
+
+    // Get the world space spheres
+    sphere_from_entity(p_a, &a, &r_a);
+    sphere_from_entity(p_b, &b, &r_b);
+
+    r = r_a + r_b;
+
+    sub_vec3(&d, b, a);
+
+    l = dot_product_vec3(d, d);
+
+    // Separated
+    if ( l > r * r ) return false;
+
+    // Write the manifold
+    if ( p_manifold )
+    {
+        l = sqrtf(l);
+
+        *p_manifold = (GXManifold_t)
+        {
+            .a      = p_a,
+            .b      = p_b,
+            .normal = ( l > FLT_EPSILON ) ? mul_vec3_f(d, 1.f / l) : (vec3) { 0.f, 0.f, 1.f, 0.f },
+            .depth  = r - l
+        };
+    }
+
+    // Colliding
+    return true;
+}
+
+bool collide_obb ( GXEntity_t *p_a, GXEntity_t *p_b, GXManifold_t *p_manifold )
+{
+
+    // Initialized data
+    struct obb_s a      = { 0 },
+                 b      = { 0 };
+    vec3         t      = { 0 },
+                 axes[15],
+                 best_axis = { 0.f, 0.f, 1.f, 0.f };
+    float        best   = FLT_MAX;
+    size_t       axis_count = 6;
+
+    // Get the world space boxes
+    obb_from_entity(p_a, &a);
+    obb_from_entity(p_b, &b);
+
+    sub_vec3(&t, b.center, a.center);
+
+    // Face normals of each box
+    for (size_t i = 0; i < 3; i++)
+        axes[i]     = a.axes[i],
+        axes[i + 3] = b.axes[i];
+
+    // Edge / edge cross products. Parallel edges produce a degenerate axis, which is skipped
+    for (size_t i = 0; i < 3; i++)
+        for (size_t j = 0; j < 3; j++)
+        {
+
+            // Initialized data
+            vec3  c = cross_product_vec3(a.axes[i], b.axes[j]);
+            float l = length(c);
+
+            if ( l > 1e-5f )
+                axes[axis_count++] = mul_vec3_f(c, 1.f / l);
+        }
+
+    // Project both boxes onto each axis
+    for (size_t i = 0; i < axis_count; i++)
+    {
+
+        // Initialized data
+        vec3  l  = axes[i];
+        float ra = a.extents[0] * fabsf(dot_product_vec3(a.axes[0], l)) +
+                   a.extents[1] * fabsf(dot_product_vec3(a.axes[1], l)) +
+                   a.extents[2] * fabsf(dot_product_vec3(a.axes[2], l)),
+              rb = b.extents[0] * fabsf(dot_product_vec3(b.axes[0], l)) +
+                   b.extents[1] * fabsf(dot_product_vec3(b.axes[1], l)) +
+                   b.extents[2] * fabsf(dot_product_vec3(b.axes[2], l)),
+              d  = dot_product_vec3(t, l),
+              o  = ra + rb - fabsf(d);
+
+        // Found a separating axis
+        if ( o < 0.f ) return false;
+
+        // Track the axis of least penetration, pointing from a to b
+        if ( o < best )
+            best      = o,
+            best_axis = ( d < 0.f ) ? mul_vec3_f(l, -1.f) : l;
+    }
+
+    // Write the manifold
+    if ( p_manifold )
+        *p_manifold = (GXManifold_t)
+        {
+            .a      = p_a,
+            .b      = p_b,
+            .normal = best_axis,
+            .depth  = best
+        };
+
+    // Colliding
+    return true;
+}
+
+// Furthest point of an entity's hull along a world space direction
+static vec3 convex_hull_support ( GXEntity_t *p_entity, vec3 d )
+{
+
+    // Initialized data
+    GXCollider_t *p_collider = p_entity->collider;
+    mat4          m          = p_entity->transform->model_matrix;
+    vec3          best_point = { 0 },
+                  p          = { 0 };
+    float         best       = -FLT_MAX;
+
+    // Move the direction into the collider's space, instead of moving every point into world space
+    vec3          dl         =
+    {
+        .x = m.a * d.x + m.b * d.y + m.c * d.z,
+        .y = m.e * d.x + m.f * d.y + m.g * d.z,
+        .z = m.i * d.x + m.j * d.y + m.k * d.z
+    };
+
+    // Search the convex hull
+    if ( p_collider->convex_hull.convex_hull_count )
+    {
+        for (size_t i = 0; i < p_collider->convex_hull.convex_hull_count; i++)
+        {
+
+            // Initialized data
+            vec3  v  = p_collider->convex_hull.convex_hull[i];
+            float pd = v.x * dl.x + v.y * dl.y + v.z * dl.z;
+
+            if ( pd > best )
+                best       = pd,
+                best_point = v;
+        }
+    }
+
+    // Default to the collider's box
+    else
+    {
+        best_point.x = ( dl.x >= 0.f ) ? p_collider->aabb.aabb_max.x : p_collider->aabb.aabb_min.x,
+        best_point.y = ( dl.y >= 0.f ) ? p_collider->aabb.aabb_max.y : p_collider->aabb.aabb_min.y,
+        best_point.z = ( dl.z >= 0.f ) ? p_collider->aabb.aabb_max.z : p_collider->aabb.aabb_min.z;
+    }
+
+    // Move the point into world space
+    p = (vec3)
+    {
+        .x = best_point.x * m.a + best_point.y * m.e + best_point.z * m.i + m.m,
+        .y = best_point.x * m.b + best_point.y * m.f + best_point.z * m.j + m.n,
+        .z = best_point.x * m.c + best_point.y * m.g + best_point.z * m.k + m.o
+    };
+
+    // Success
+    return p;
+}
+
+// Support point of the minkowski difference a - b
+static vec3 minkowski_support ( GXEntity_t *p_a, GXEntity_t *p_b, vec3 d )
+{
+
+    // Initialized data
+    vec3 r = { 0 };
+
+    sub_vec3(&r, convex_hull_support(p_a, d), convex_hull_support(p_b, mul_vec3_f(d, -1.f)));
+
+    // Success
+    return r;
+}
+
+// Reduce the simplex to the feature closest to the origin, and compute the next search direction
+static bool gjk_do_simplex ( vec3 *simplex, size_t *p_count, vec3 *p_d )
+{
+
+    // Initialized data
+    vec3 a  = simplex[*p_count - 1],
+         ao = mul_vec3_f(a, -1.f);
+
+    // Line
+    if ( *p_count == 2 )
+    {
+
+        // Initialized data
+        vec3 b  = simplex[0],
+             ab = { 0 };
+
+        sub_vec3(&ab, b, a);
+
+        if ( dot_product_vec3(ab, ao) > 0.f )
+            *p_d = cross_product_vec3(cross_product_vec3(ab, ao), ab);
+        else
+            simplex[0] = a,
+            *p_count   = 1,
+            *p_d       = ao;
+
+        return false;
+    }
+
+    // Triangle
+    if ( *p_count == 3 )
+    {
+
+        // Initialized data
+        vec3 b   = simplex[1],
+             c   = simplex[0],
+             ab  = { 0 },
+             ac  = { 0 },
+             abc = { 0 };
+
+        sub_vec3(&ab, b, a);
+        sub_vec3(&ac, c, a);
+        abc = cross_product_vec3(ab, ac);
+
+        // Outside edge ac
+        if ( dot_product_vec3(cross_product_vec3(abc, ac), ao) > 0.f )
+        {
+            if ( dot_product_vec3(ac, ao) > 0.f )
+                simplex[0] = c,
+                simplex[1] = a,
+                *p_count   = 2,
+                *p_d       = cross_product_vec3(cross_product_vec3(ac, ao), ac);
+            else
+                simplex[0] = b,
+                simplex[1] = a,
+                *p_count   = 2,
+                *p_d       = cross_product_vec3(cross_product_vec3(ab, ao), ab);
+
+            return false;
+        }
+
+        // Outside edge ab
+        if ( dot_product_vec3(cross_product_vec3(ab, abc), ao) > 0.f )
+        {
+            simplex[0] = b,
+            simplex[1] = a,
+            *p_count   = 2,
+            *p_d       = cross_product_vec3(cross_product_vec3(ab, ao), ab);
+
+            return false;
+        }
+
+        // Above or below the triangle
+        if ( dot_product_vec3(abc, ao) > 0.f )
+            *p_d = abc;
+        else
+            simplex[0] = b,
+            simplex[1] = c,
+            *p_d       = mul_vec3_f(abc, -1.f);
+
+        return false;
+    }
+
+    // Tetrahedron
+    {
+
+        // Initialized data
+        vec3 b   = simplex[2],
+             c   = simplex[1],
+             d   = simplex[0],
+             ab  = { 0 },
+             ac  = { 0 },
+             ad  = { 0 },
+             abc = { 0 },
+             acd = { 0 },
+             adb = { 0 };
+
+        sub_vec3(&ab, b, a);
+        sub_vec3(&ac, c, a);
+        sub_vec3(&ad, d, a);
+
+        abc = cross_product_vec3(ab, ac);
+        acd = cross_product_vec3(ac, ad);
+        adb = cross_product_vec3(ad, ab);
+
+        // Recurse into the face the origin is in front of
+        if ( dot_product_vec3(abc, ao) > 0.f )
+        {
+            simplex[0] = c, simplex[1] = b, simplex[2] = a, *p_count = 3;
+
+            return gjk_do_simplex(simplex, p_count, p_d);
+        }
+
+        if ( dot_product_vec3(acd, ao) > 0.f )
+        {
+            simplex[0] = d, simplex[1] = c, simplex[2] = a, *p_count = 3;
+
+            return gjk_do_simplex(simplex, p_count, p_d);
+        }
+
+        if ( dot_product_vec3(adb, ao) > 0.f )
+        {
+            simplex[0] = b, simplex[1] = d, simplex[2] = a, *p_count = 3;
+
+            return gjk_do_simplex(simplex, p_count, p_d);
+        }
+
+        // The origin is enclosed
+        return true;
+    }
+}
+
+// A face of the expanding polytope. The normal points out of the polytope
+struct epa_face_s
+{
+    size_t v[3];
+    vec3   normal;
+    float  distance;
+};
+
+// Make a face of the expanding polytope, wound away from a point inside it
+static bool epa_make_face ( vec3 *vertices, vec3 inside, size_t a, size_t b, size_t c, struct epa_face_s *p_face )
+{
+
+    // Initialized data
+    vec3  ab     = { 0 },
+          ac     = { 0 },
+          ai     = { 0 },
+          n      = { 0 };
+    float length = 0.f;
+
+    sub_vec3(&ab, vertices[b], vertices[a]);
+    sub_vec3(&ac, vertices[c], vertices[a]);
+    sub_vec3(&ai, inside, vertices[a]);
+
+    n      = cross_product_vec3(ab, ac);
+    length = sqrtf(dot_product_vec3(n, n));
+
+    // The face is degenerate
+    if ( length < 1e-12f ) return false;
+
+    n = mul_vec3_f(n, 1.f / length);
+
+    // Turn the face away from the inside of the polytope
+    if ( dot_product_vec3(n, ai) > 0.f )
+    {
+        size_t t = b;
+
+        b = c,
+        c = t,
+        n = mul_vec3_f(n, -1.f);
+    }
+
+    *p_face = (struct epa_face_s)
+    {
+        .v        = { a, b, c },
+        .normal   = n,
+        .distance = dot_product_vec3(n, vertices[a])
+    };
+
+    // Success
+    return true;
+}
+
+// The face of the expanding polytope closest to the origin
+static size_t epa_closest_face ( struct epa_face_s *faces, size_t face_count )
+{
+
+    // Initialized data
+    size_t closest = 0;
+
+    for (size_t i = 1; i < face_count; i++)
+        if ( faces[i].distance < faces[closest].distance )
+            closest = i;
+
+    // Success
+    return closest;
+}
+
+// Expand the tetrahedron GJK ended with until its closest face is on the minkowski difference
+static bool epa ( GXEntity_t *p_a, GXEntity_t *p_b, vec3 *simplex, vec3 *p_normal, float *p_depth )
+{
+
+    // Initialized data
+    vec3               vertices[EPA_MAX_VERTICES]  = { 0 },
+                       inside                      = { 0 };
+    struct epa_face_s  faces[EPA_MAX_FACES]        = { 0 };
+    size_t             edges[EPA_MAX_FACES * 3][2] = { 0 },
+                       vertex_count                = 4,
+                       face_count                  = 0,
+                       closest                     = 0;
+    const size_t       tetrahedron[4][3]           = { { 0, 1, 2 }, { 0, 2, 3 }, { 0, 3, 1 }, { 1, 3, 2 } };
+
+    // The center of the tetrahedron is inside every polytope expanded from it
+    for (size_t i = 0; i < 4; i++)
+        vertices[i] = simplex[i],
+        add_vec3(&inside, inside, mul_vec3_f(simplex[i], 0.25f));
+
+    // Make the faces of the tetrahedron
+    for (size_t i = 0; i < 4; i++)
+        if ( epa_make_face(vertices, inside, tetrahedron[i][0], tetrahedron[i][1], tetrahedron[i][2], &faces[face_count++]) == false )
+            return false;
+
+    // Expand the polytope
+    for (size_t i = 0; i < EPA_MAX_ITERATIONS && vertex_count < EPA_MAX_VERTICES; i++)
+    {
+
+        // Initialized data
+        vec3   p          = { 0 },
+               n          = { 0 };
+        size_t edge_count = 0;
+
+        closest = epa_closest_face(faces, face_count);
+        n       = faces[closest].normal;
+        p       = minkowski_support(p_a, p_b, n);
+
+        // The closest face is on the minkowski difference
+        if ( dot_product_vec3(p, n) - faces[closest].distance < EPA_TOLERANCE ) break;
+
+        vertices[vertex_count] = p;
+
+        // Remove every face the new point can see, and keep the edges that border the hole
+        for (size_t j = 0; j < face_count; )
+        {
+
+            // Initialized data
+            vec3 to_p = { 0 };
+
+            sub_vec3(&to_p, p, vertices[faces[j].v[0]]);
+
+            // The face can't see the new point
+            if ( dot_product_vec3(faces[j].normal, to_p) <= 0.f )
+            {
+                j++;
+
+                continue;
+            }
+
+            // Add each edge of the face, unless its neighbour already added it
+            for (size_t e = 0; e < 3; e++)
+            {
+
+                // Initialized data
+                size_t from   = faces[j].v[e],
+                       to     = faces[j].v[( e + 1 ) % 3],
+                       shared = edge_count;
+
+                for (size_t k = 0; k < edge_count; k++)
+                    if ( edges[k][0] == to && edges[k][1] == from )
+                        shared = k;
+
+                // The edge is inside the hole
+                if ( shared < edge_count )
+                {
+                    edges[shared][0] = edges[edge_count - 1][0],
+                    edges[shared][1] = edges[edge_count - 1][1],
+                    edge_count--;
+                }
+
+                // The edge borders the hole
+                else if ( edge_count < EPA_MAX_FACES * 3 )
+                    edges[edge_count][0] = from,
+                    edges[edge_count][1] = to,
+                    edge_count++;
+            }
+
+            // Remove the face
+            faces[j] = faces[--face_count];
+        }
+
+        // Close the hole with faces to the new point
+        for (size_t e = 0; e < edge_count && face_count < EPA_MAX_FACES; e++)
+            if ( epa_make_face(vertices, inside, edges[e][0], edges[e][1], vertex_count, &faces[face_count]) )
+                face_count++;
+
+        vertex_count++;
+
+        // Error check
+        if ( face_count == 0 ) return false;
+    }
+
+    // Use the closest face
+    closest = epa_closest_face(faces, face_count);
+
+    *p_normal = faces[closest].normal,
+    *p_depth  = fmaxf(faces[closest].distance, 0.f);
+
+    // Success
+    return true;
+}
+
+bool collide_convex_hull ( GXEntity_t *p_a, GXEntity_t *p_b, GXManifold_t *p_manifold )
+{
+
+    // Initialized data
+    vec3   simplex[4] = { 0 },
+           d          = { 1.f, 0.f, 0.f, 0.f },
+           normal     = { 0 };
+    size_t count      = 1;
+    float  depth      = 0.f;
+    bool   enclosed   = false;
+
+    // Start with the support along an arbitrary direction
+    simplex[0] = minkowski_support(p_a, p_b, d);
+    d          = mul_vec3_f(simplex[0], -1.f);
+
+    // GJK converges in a handful of iterations for well formed hulls
+    for (size_t i = 0; i < GJK_MAX_ITERATIONS; i++)
+    {
+
+        // Initialized data
+        vec3 a = { 0 };
+
+        // The origin is on the simplex, so the hulls touch without overlapping
+        if ( dot_product_vec3(d, d) < 1e-12f ) return false;
+
+        a = minkowski_support(p_a, p_b, d);
+
+        // The new point didn't pass the origin, so the hulls are separated
+        if ( dot_product_vec3(a, d) < 0.f ) return false;
+
+        simplex[count++] = a;
+
+        if ( gjk_do_simplex(simplex, &count, &d) )
+        {
+            enclosed = true;
+
+            break;
+        }
+    }
+
+    // GJK didn't converge. Treat the hulls as separated
+    if ( enclosed == false ) return false;
+
+    // Find the contact normal and depth
+    if ( epa(p_a, p_b, simplex, &normal, &depth) == false )
+    {
+
+        // Initialized data
+        mat4  ma     = p_a->transform->model_matrix,
+              mb     = p_b->transform->model_matrix;
+        vec3  ab     = { mb.m - ma.m, mb.n - ma.n, mb.o - ma.o, 0.f };
+        float length = sqrtf(dot_product_vec3(ab, ab));
+
+        // The tetrahedron is flat, so the hulls barely overlap. Push them apart along their centers
+        normal = ( length > 0.f ) ? mul_vec3_f(ab, 1.f / length) : (vec3) { 0.f, 0.f, 1.f, 0.f },
+        depth  = 0.f;
+    }
+
+    // Write the manifold
+    if ( p_manifold )
+        *p_manifold = (GXManifold_t) { .a = p_a, .b = p_b, .normal = normal, .depth = depth };
+
+    // Colliding
+    return true;
+}
+
+bool test_aabb ( GXCollision_t *p_collision )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( p_collision == (void *) 0 ) goto no_collision;
+    #endif
+
+    // Initialized data
+    GXManifold_t manifold = { 0 };
+
+    // Test the bounding boxes
+    p_collision->aabb_colliding = collide_aabb(p_collision->a, p_collision->b, &manifold);
+
+    // Update the collision
+    if ( p_collision->aabb_colliding )
+        p_collision->a_collision_normal = manifold.normal,
+        p_collision->b_collision_normal = mul_vec3_f(manifold.normal, -1.f),
+        p_collision->depth              = manifold.depth;
+
+    // Success
+    return p_collision->aabb_colliding;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_collision:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Collision] Null pointer provided for parameter \"p_collision\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return false;
+        }
+    }
+}
+
+bool test_obb ( GXCollision_t *p_collision )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( p_collision == (void *) 0 ) goto no_collision;
+    #endif
+
+    // Initialized data
+    GXManifold_t manifold  = { 0 };
+    bool         colliding = collide_obb(p_collision->a, p_collision->b, &manifold);
+
+    // Update the collision
+    if ( colliding )
+        p_collision->a_collision_normal = manifold.normal,
+        p_collision->b_collision_normal = mul_vec3_f(manifold.normal, -1.f),
+        p_collision->depth              = manifold.depth;
+
+    // Success
+    return colliding;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_collision:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Collision] Null pointer provided for parameter \"p_collision\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return false;
+        }
+    }
+}
+
+bool test_convex_hull ( GXCollision_t *p_collision )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( p_collision == (void *) 0 ) goto no_collision;
+    #endif
+
+    // Initialized data
+    GXManifold_t manifold = { 0 };
+
+    // Test the convex hulls
+    p_collision->convex_hull_colliding = collide_convex_hull(p_collision->a, p_collision->b, &manifold);
+
+    // Update the collision
+    if ( p_collision->convex_hull_colliding )
+        p_collision->a_collision_normal = manifold.normal,
+        p_collision->b_collision_normal = mul_vec3_f(manifold.normal, -1.f),
+        p_collision->depth              = manifold.depth;
+
+    // Success
+    return p_collision->convex_hull_colliding;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_collision:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Collision] Null pointer provided for parameter \"p_collision\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return false;
+        }
+    }
+}
+
+int destroy_collision ( GXCollision_t **pp_collision )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( pp_collision == (void *) 0 ) goto no_collision;
+    #endif
+
+    // Initialized data
+    GXCollision_t *p_collision = *pp_collision;
+
+    // No more pointer for caller
+    *pp_collision = 0;
+
+    // Free the collision
+    if ( p_collision )
+        G10_POOL_FREE(&collision_pool, p_collision);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_collision:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Collision] Null pointer provided for parameter \"pp_collision\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
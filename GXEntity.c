@@ -1,4 +1,7 @@
-﻿#include <G10/GXEntity.h>
+﻿// Allocations made here are counted against the scene
+#define G10_ALLOC_TAG alloc_tag_scene
+
+#include <G10/GXEntity.h>
 
 vec3 calculate_force_gravitational(GXEntity_t* entity);
 vec3 calculate_force_applied(GXEntity_t* entity);
@@ -7,6 +10,9 @@ vec3 calculate_force_friction(GXEntity_t* entity);
 vec3 calculate_force_tension(GXEntity_t* entity);
 vec3 calculate_force_spring(GXEntity_t* entity);
 
+// Entities made outside of a scene arena
+static GXPool_t *entity_pool = 0;
+
 int create_entity ( GXEntity_t **pp_entity )
 {
 
@@ -16,11 +22,14 @@ int create_entity ( GXEntity_t **pp_entity )
     #endif
 
     // Initialized data
-    GXEntity_t *p_entity = calloc(1,sizeof(GXEntity_t));
+    GXEntity_t *p_entity = pool_calloc(&entity_pool, sizeof(GXEntity_t));
 
     // Error check
     if ( p_entity == (void *) 0 ) goto no_mem;
 
+    // Count the entity
+    G10_STAT_ADD(stat_entities, 1);
+
     // Return a pointer to the caller
     *pp_entity = p_entity;
 
@@ -65,11 +74,14 @@ int load_entity ( GXEntity_t** pp_entity, char* path )
 
     // Initialized data
     size_t  len  = g_load_file(path, 0, true);
-    char   *text = calloc(len+1, sizeof(char));
+    char   *text = G10_TAGGED_REALLOC(0, len + 1, alloc_tag_json);
 
     // Error check
     if ( text == (void *) 0 ) goto no_mem;
 
+    // Terminate the text
+    text[len] = '\0';
+
     // Load the entity file
     if ( g_load_file(path, text, true) == 0 ) goto failed_to_load_entity;
 
@@ -77,7 +89,7 @@ int load_entity ( GXEntity_t** pp_entity, char* path )
     if ( load_entity_as_json_text(pp_entity, text) == 0 ) goto failed_to_load_entity_as_json;
 
     // Clean up the scope
-    free(text);
+    G10_FREE(text);
 
     // Success
     return 1;
@@ -223,7 +235,8 @@ int load_entity_as_json_value ( GXEntity_t **pp_entity, JSONValue_t *p_value )
                 *p_transform_value   = 0,
                 *p_rigidbody_value   = 0,
                 *p_collider_value    = 0,
-                *p_ai_value          = 0;
+                *p_ai_value          = 0,
+                *p_prefab_value      = 0;
 
     // Parse the JSON value
     if ( p_value->type == JSONobject )
@@ -243,6 +256,7 @@ int load_entity_as_json_value ( GXEntity_t **pp_entity, JSONValue_t *p_value )
         p_rigidbody_value   = dict_get(p_dict, "rigidbody");
         p_collider_value    = dict_get(p_dict, "collider");
         p_ai_value          = dict_get(p_dict, "ai");
+        p_prefab_value      = dict_get(p_dict, "prefab");
 
         // Error check
         if ( ! (
@@ -255,6 +269,64 @@ int load_entity_as_json_value ( GXEntity_t **pp_entity, JSONValue_t *p_value )
     else
         goto wrong_value_type;
 
+    // Stamp the entity out of a prefab
+    if ( p_prefab_value )
+    {
+
+        // Initialized data
+        GXInstance_t *p_instance = g_get_active_instance();
+        GXPrefab_t   *p_prefab   = 0;
+
+        // Error check
+        if ( p_prefab_value->type != JSONstring ) goto wrong_prefab_type;
+        if ( p_name_value->type   != JSONstring ) goto wrong_name_type;
+
+        // Lock the prefab cache mutex
+        SDL_LockMutex(p_instance->mutexes.prefab_cache);
+
+        // Search the cache for the prefab
+        p_prefab = g_find_prefab(p_instance, p_prefab_value->string);
+
+        // If the prefab is not in the cache, load it from a file, and cache it
+        if ( p_prefab == (void *) 0 )
+        {
+            if ( load_prefab(&p_prefab, p_prefab_value->string) == 0 )
+            {
+
+                // Unlock the prefab cache mutex
+                SDL_UnlockMutex(p_instance->mutexes.prefab_cache);
+
+                goto failed_to_load_prefab;
+            }
+
+            g_cache_prefab(p_instance, p_prefab);
+        }
+
+        // Unlock the prefab cache mutex
+        SDL_UnlockMutex(p_instance->mutexes.prefab_cache);
+
+        // Stamp the entity
+        if ( instance_prefab(&p_entity, p_prefab, p_name_value->string) == 0 ) goto failed_to_instance_prefab;
+
+        // Override the template's transform
+        if ( p_transform_value )
+        {
+            (void) destroy_transform(&p_entity->transform);
+
+            if ( load_transform_as_json_value(&p_entity->transform, p_transform_value) == 0 )
+                goto failed_to_load_transform_as_json_value;
+
+            if ( p_entity->collider )
+                p_entity->collider->model_matrix = &p_entity->transform->model_matrix;
+        }
+
+        // Return a pointer to the caller
+        *pp_entity = p_entity;
+
+        // Success
+        return 1;
+    }
+
     // Construct the entity
     {
 
@@ -269,7 +341,7 @@ int load_entity_as_json_value ( GXEntity_t **pp_entity, JSONValue_t *p_value )
             size_t name_len = strlen(p_name_value->string);
 
             // Allocate memory for the name
-            p_entity->name  = calloc(name_len + 1, sizeof(char));
+            p_entity->name  = arena_calloc(name_len + 1, sizeof(char));
 
             // Error check
             if ( p_entity->name == (void *) 0 ) goto no_mem;
@@ -349,7 +421,7 @@ int load_entity_as_json_value ( GXEntity_t **pp_entity, JSONValue_t *p_value )
                 size_t len = strlen(p_shader_name_value->string);
 
                 // Allocate memory for the shader
-                p_entity->shader_name = calloc(len+1, sizeof(char));
+                p_entity->shader_name = arena_calloc(len+1, sizeof(char));
 
                 // Error check
                 if ( p_entity->shader_name == (void *) 0 ) goto no_mem;
@@ -427,6 +499,22 @@ int load_entity_as_json_value ( GXEntity_t **pp_entity, JSONValue_t *p_value )
                 // Error
                 return 0;
 
+            failed_to_load_prefab:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Entity] Failed to load prefab \"%s\" in call to function \"%s\"\n", p_prefab_value->string, __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            failed_to_instance_prefab:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Entity] Failed to stamp entity out of prefab \"%s\" in call to function \"%s\"\n", p_prefab_value->string, __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
             failed_to_load_part:
                 #ifndef NDEBUG
                     g_print_error("[G10] [Entity] Failed to load part in call to function \"%s\"\n", __FUNCTION__);
@@ -455,6 +543,14 @@ int load_entity_as_json_value ( GXEntity_t **pp_entity, JSONValue_t *p_value )
                 // Error
                 return 0;
 
+            wrong_prefab_type:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Entity] Property \"prefab\" must be of type [ string ] in call to function \"%s\"\nRefer to gschema: https://schema.g10.app/entity.json \n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
             wrong_parts_type:
                 #ifndef NDEBUG
                     g_print_error("[G10] [Entity] Property \"parts\" must be of type [ array ] in call to function \"%s\"\nRefer to gschema: https://schema.g10.app/entity.json \n", __FUNCTION__);
@@ -618,8 +714,8 @@ int draw_entity (
     GXTransform_t  *p_transform    = p_entity->transform;
     size_t          part_count     = dict_values(p_entity->parts, 0),
                     material_count = dict_values(p_entity->materials, 0);
-    GXPart_t      **pp_part        = G10_REALLOC(0, part_count     * sizeof(GXPart_t *));
-    GXMaterial_t  **pp_material    = G10_REALLOC(0, material_count * sizeof(GXPart_t *));
+    GXPart_t      **pp_part        = G10_TAGGED_REALLOC(0, part_count     * sizeof(GXPart_t *), alloc_tag_renderer);
+    GXMaterial_t  **pp_material    = G10_TAGGED_REALLOC(0, material_count * sizeof(GXPart_t *), alloc_tag_renderer);
 
     // TODO: Bind the part
     // TODO: Bind the transform
@@ -627,6 +723,10 @@ int draw_entity (
     // TODO: Draw the entity
     //
 
+    // Clean the scope
+    G10_FREE(pp_part);
+    G10_FREE(pp_material);
+
     // Success
     return 1;
 
@@ -691,10 +791,7 @@ int get_model_matrix ( void* ret )
 
     // Initialized data
     GXInstance_t *p_instance        = g_get_active_instance();
-    mat4          model_matrix    = { 0 };
-
-    // Compute a transform model matrix from the active entity
-    transform_model_matrix(p_instance->context.scene->active_entity->transform, &model_matrix);
+    mat4          model_matrix    = p_instance->context.scene->active_entity->transform->model_matrix;
 
     // Write the camera position to the return
     *(mat4 *)ret = model_matrix;
@@ -717,6 +814,50 @@ int get_model_matrix ( void* ret )
     }
 }
 
+int get_dequantized_model_matrix ( void *ret )
+{
+
+    // Argument errors
+    #ifndef NDEBUG
+        if ( ret == (void *) 0 ) goto no_return;
+    #endif
+
+    // Initialized data
+    GXInstance_t *p_instance   = g_get_active_instance();
+    GXPart_t     *p_part       = p_instance->context.scene->active_part;
+    mat4          model_matrix = p_instance->context.scene->active_entity->transform->model_matrix;
+
+    // Scale and move the positions into the box of the part, then into the world
+    if ( p_part && p_part->vertex_groups )
+        model_matrix = mul_mat4_mat4((mat4)
+        {
+            .a = p_part->dequantize.w, .b = 0.f, .c = 0.f, .d = 0.f,
+            .e = 0.f, .f = p_part->dequantize.w, .g = 0.f, .h = 0.f,
+            .i = 0.f, .j = 0.f, .k = p_part->dequantize.w, .l = 0.f,
+            .m = p_part->dequantize.x, .n = p_part->dequantize.y, .o = p_part->dequantize.z, .p = 1.f
+        }, model_matrix);
+
+    // Write the model matrix to the return
+    *(mat4 *)ret = model_matrix;
+
+    return sizeof(mat4);
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_return:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Entity] Null pointer provided for parameter \"ret\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
 vec3 calculate_force_gravitational ( GXEntity_t *p_entity )
 {
 
@@ -934,6 +1075,9 @@ int load_entity_from_queue ( void *vp_instance )
     GXEntity_t   *p_entity   = 0;
     GXScene_t    *p_scene    = p_instance->context.loading_scene;
 
+    // Entities loaded by this thread belong to the loading scene
+    (void) set_thread_arena(p_scene->arena);
+
     // TODO: Fix
     while ( queue_empty(p_instance->queues.load_entity) == false )
     {
@@ -948,6 +1092,9 @@ int load_entity_from_queue ( void *vp_instance )
             // Unlock the mutex
             SDL_UnlockMutex(p_instance->mutexes.load_entity);
 
+            // Unbind the arena
+            (void) set_thread_arena(0);
+
             // Success
             return 0;
         }
@@ -966,6 +1113,9 @@ int load_entity_from_queue ( void *vp_instance )
         append_entity(p_scene, p_entity);
     }
 
+    // Unbind the arena
+    (void) set_thread_arena(0);
+
     // Success
     return 1;
 
@@ -975,6 +1125,8 @@ int load_entity_from_queue ( void *vp_instance )
         // G10 errors
         {
             failed_to_load_entity_as_json:
+                (void) set_thread_arena(0);
+
                 #ifndef NDEBUG
                     g_print_error("[G10] [Scene] Failed to load entity in call to function \"%s\"\n", __FUNCTION__);
                 #endif
@@ -1078,23 +1230,32 @@ int destroy_entity ( GXEntity_t **pp_entity )
     // No more pointer for caller
     *pp_entity = (void *) 0;
 
+    // Leave the scene's component storage
+    if ( p_entity->chunk )
+        remove_entity_components(p_entity);
+
     // Free the name
-    free(p_entity->name);
+    arena_free(p_entity->name);
 
     if ( p_entity->shader_name )
-        ;//
+        arena_free(p_entity->shader_name);
 
     if ( p_entity->transform )
         destroy_transform(&p_entity->transform);
 
     if ( p_entity->rigidbody )
-        ;//destroy_rigidbody(p_entity->rigidbody);
+        destroy_rigidbody(&p_entity->rigidbody);
+
+    if ( p_entity->collider )
+        destroy_collider(&p_entity->collider);
 
     if ( p_entity->ai )
         destroy_ai(&p_entity->ai);
 
     // Free the entity
-    free(p_entity);
+    pool_release(&entity_pool, p_entity);
+
+    G10_STAT_ADD(stat_entities, -1);
 
     // Success
     return 1;
@@ -1162,8 +1323,8 @@ int move_entity ( GXEntity_t *p_entity )
 
     }
 
-    // Update the model matrix
-    transform_model_matrix(transform, &transform->model_matrix);
+    // Update the model matrix on the next transform hierarchy update
+    dirty_transform(transform);
     //resize_bv(p_entity->collider->bv);
 
     return 1;
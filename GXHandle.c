@@ -0,0 +1,487 @@
+#include <G10/GXHandle.h>
+
+// The string intern table. Open addressing, with linear probing
+static struct
+{
+    char         **strings;
+    u32           *hashes;
+    size_t         count,
+                   max;
+    SDL_SpinLock   lock;
+} interned = { 0 };
+
+// FNV-1a
+static u32 hash_string ( const char *string )
+{
+
+    // Initialized data
+    u32 h = 2166136261u;
+
+    for (const u8 *c = (const u8 *) string; *c; c++)
+        h = ( h ^ *c ) * 16777619u;
+
+    return h;
+}
+
+// Double the size of the string intern table. Call with the lock held
+static int grow_interned_strings ( void )
+{
+
+    // Initialized data
+    size_t   new_max     = ( interned.max ) ? interned.max * 2 : 256;
+    char   **new_strings = calloc(new_max, sizeof(char *));
+    u32     *new_hashes  = calloc(new_max, sizeof(u32));
+
+    // Error check
+    if ( new_strings == (void *) 0 || new_hashes == (void *) 0 )
+    {
+        free(new_strings);
+        free(new_hashes);
+
+        return 0;
+    }
+
+    // Reinsert each string
+    for (size_t i = 0; i < interned.max; i++)
+    {
+
+        // Initialized data
+        size_t j = interned.hashes[i] & ( new_max - 1 );
+
+        if ( interned.strings[i] == (void *) 0 ) continue;
+
+        while ( new_strings[j] )
+            j = ( j + 1 ) & ( new_max - 1 );
+
+        new_strings[j] = interned.strings[i];
+        new_hashes[j]  = interned.hashes[i];
+    }
+
+    free(interned.strings);
+    free(interned.hashes);
+
+    interned.strings = new_strings;
+    interned.hashes  = new_hashes;
+    interned.max     = new_max;
+
+    // Success
+    return 1;
+}
+
+int create_handle_table ( GXHandleTable_t **pp_handle_table )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( pp_handle_table == (void *) 0 ) goto no_handle_table;
+    #endif
+
+    // Initialized data
+    GXHandleTable_t *p_handle_table = calloc(1, sizeof(GXHandleTable_t));
+
+    // Memory check
+    if ( p_handle_table == (void *) 0 ) goto no_mem;
+
+    // Return the allocated memory
+    *pp_handle_table = p_handle_table;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_handle_table:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Handle] Null pointer provided for parameter \"pp_handle_table\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    g_print_error("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+handle_t acquire_handle ( GXHandleTable_t *p_handle_table, void *p_object )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( p_handle_table == (void *) 0 ) goto no_handle_table;
+        if ( p_object       == (void *) 0 ) goto no_object;
+    #endif
+
+    // Initialized data
+    u32      index  = 0;
+    handle_t handle = HANDLE_INVALID;
+
+    SDL_AtomicLock(&p_handle_table->lock);
+
+    // Reuse a released slot
+    if ( p_handle_table->free_count )
+        index = p_handle_table->free_slots[--p_handle_table->free_count];
+
+    // Append a slot
+    else
+    {
+
+        // Out of slots
+        if ( p_handle_table->count == HANDLE_INDEX_MAX ) goto out_of_handles;
+
+        // Grow the slots
+        if ( p_handle_table->count == p_handle_table->max )
+        {
+
+            // Initialized data
+            size_t   new_max         = ( p_handle_table->max ) ? p_handle_table->max * 2 : 64;
+            void   **new_objects     = G10_REALLOC(p_handle_table->objects    , new_max * sizeof(void *));
+            u16     *new_generations = ( new_objects ) ? G10_REALLOC(p_handle_table->generations, new_max * sizeof(u16)) : 0;
+            u32     *new_free_slots  = ( new_generations ) ? G10_REALLOC(p_handle_table->free_slots, new_max * sizeof(u32)) : 0;
+
+            // Keep whatever grew, so the table stays consistent on error
+            if ( new_objects     ) p_handle_table->objects     = new_objects;
+            if ( new_generations ) p_handle_table->generations = new_generations;
+            if ( new_free_slots  ) p_handle_table->free_slots  = new_free_slots;
+
+            // Error check
+            if ( new_free_slots == (void *) 0 ) goto no_mem;
+
+            p_handle_table->max = new_max;
+        }
+
+        index = (u32) p_handle_table->count++;
+
+        p_handle_table->generations[index] = 1;
+    }
+
+    p_handle_table->objects[index] = p_object;
+    p_handle_table->handle_count++;
+
+    handle = ( (handle_t) p_handle_table->generations[index] << HANDLE_INDEX_BITS ) | index;
+
+    SDL_AtomicUnlock(&p_handle_table->lock);
+
+    // Success
+    return handle;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_handle_table:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Handle] Null pointer provided for parameter \"p_handle_table\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return HANDLE_INVALID;
+
+            no_object:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Handle] Null pointer provided for parameter \"p_object\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return HANDLE_INVALID;
+        }
+
+        // G10 errors
+        {
+            out_of_handles:
+                SDL_AtomicUnlock(&p_handle_table->lock);
+
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Handle] Handle table is full in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return HANDLE_INVALID;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                SDL_AtomicUnlock(&p_handle_table->lock);
+
+                #ifndef NDEBUG
+                    g_print_error("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return HANDLE_INVALID;
+        }
+    }
+}
+
+int release_handle ( GXHandleTable_t *p_handle_table, handle_t handle )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( p_handle_table == (void *) 0 ) goto no_handle_table;
+    #endif
+
+    // Initialized data
+    u32 index      = HANDLE_INDEX(handle),
+        generation = HANDLE_GENERATION(handle);
+
+    SDL_AtomicLock(&p_handle_table->lock);
+
+    // Stale or invalid
+    if ( index >= p_handle_table->count || p_handle_table->generations[index] != generation ) goto stale_handle;
+
+    // Bump the generation. Skip 0, so no handle is HANDLE_INVALID
+    p_handle_table->generations[index] = (u16) ( ( generation + 1 ) & ( HANDLE_GENERATION_MAX - 1 ) );
+
+    if ( p_handle_table->generations[index] == 0 )
+        p_handle_table->generations[index] = 1;
+
+    p_handle_table->objects[index]                           = 0;
+    p_handle_table->free_slots[p_handle_table->free_count++] = index;
+    p_handle_table->handle_count--;
+
+    SDL_AtomicUnlock(&p_handle_table->lock);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_handle_table:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Handle] Null pointer provided for parameter \"p_handle_table\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // G10 errors
+        {
+            stale_handle:
+                SDL_AtomicUnlock(&p_handle_table->lock);
+
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Handle] Stale handle 0x%08x in call to function \"%s\"\n", handle, __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+void *resolve_handle ( GXHandleTable_t *p_handle_table, handle_t handle )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( p_handle_table == (void *) 0 ) goto no_handle_table;
+    #endif
+
+    // Initialized data
+    u32   index    = HANDLE_INDEX(handle);
+    void *p_object = 0;
+
+    SDL_AtomicLock(&p_handle_table->lock);
+
+    // The generation only matches while the handle is live
+    if ( index < p_handle_table->count && p_handle_table->generations[index] == HANDLE_GENERATION(handle) )
+        p_object = p_handle_table->objects[index];
+
+    SDL_AtomicUnlock(&p_handle_table->lock);
+
+    // Success
+    return p_object;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_handle_table:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Handle] Null pointer provided for parameter \"p_handle_table\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int destroy_handle_table ( GXHandleTable_t **pp_handle_table )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( pp_handle_table == (void *) 0 ) goto no_handle_table;
+    #endif
+
+    // Initialized data
+    GXHandleTable_t *p_handle_table = *pp_handle_table;
+
+    // No more pointer for caller
+    *pp_handle_table = 0;
+
+    // Nothing to free
+    if ( p_handle_table == (void *) 0 ) return 1;
+
+    // Free the slots
+    G10_FREE(p_handle_table->objects);
+    G10_FREE(p_handle_table->generations);
+    G10_FREE(p_handle_table->free_slots);
+
+    // Free the handle table
+    free(p_handle_table);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_handle_table:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Handle] Null pointer provided for parameter \"pp_handle_table\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+const char *intern_string ( const char *string )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( string == (void *) 0 ) goto no_string;
+    #endif
+
+    // Initialized data
+    u32         h        = hash_string(string);
+    const char *p_result = 0;
+
+    SDL_AtomicLock(&interned.lock);
+
+    // Keep the table at most half full
+    if ( ( interned.count + 1 ) * 2 > interned.max )
+        if ( grow_interned_strings() == 0 ) goto no_mem;
+
+    // Probe for the string, or for the slot it belongs in
+    for (size_t i = h & ( interned.max - 1 );; i = ( i + 1 ) & ( interned.max - 1 ))
+    {
+
+        // Already interned
+        if ( interned.strings[i] )
+        {
+            if ( interned.hashes[i] == h && strcmp(interned.strings[i], string) == 0 )
+            {
+                p_result = interned.strings[i];
+
+                break;
+            }
+
+            continue;
+        }
+
+        // Intern a copy
+        {
+
+            // Initialized data
+            size_t  len  = strlen(string);
+            char   *copy = calloc(len + 1, sizeof(char));
+
+            // Error check
+            if ( copy == (void *) 0 ) goto no_mem;
+
+            memcpy(copy, string, len);
+
+            interned.strings[i] = copy;
+            interned.hashes[i]  = h;
+            interned.count++;
+
+            p_result = copy;
+        }
+
+        break;
+    }
+
+    SDL_AtomicUnlock(&interned.lock);
+
+    // Success
+    return p_result;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_string:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Handle] Null pointer provided for parameter \"string\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                SDL_AtomicUnlock(&interned.lock);
+
+                #ifndef NDEBUG
+                    g_print_error("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int clear_interned_strings ( void )
+{
+
+    SDL_AtomicLock(&interned.lock);
+
+    // Free each string
+    for (size_t i = 0; i < interned.max; i++)
+        free(interned.strings[i]);
+
+    // Free the table
+    free(interned.strings);
+    free(interned.hashes);
+
+    interned.strings = 0;
+    interned.hashes  = 0;
+    interned.count   = 0;
+    interned.max     = 0;
+
+    SDL_AtomicUnlock(&interned.lock);
+
+    // Success
+    return 1;
+}
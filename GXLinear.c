@@ -1,5 +1,855 @@
 ﻿#include <G10/GXLinear.h>
 
+#if defined(_MSC_VER) && defined(G10_LINEAR_X86)
+    #include <intrin.h>
+#endif
+
+// Scalar kernels
+static void normalize_scalar ( vec3 *r, const vec3 *v )
+{
+
+    // Initialized data
+    float vl = sqrtf((v->x * v->x) + (v->y * v->y) + (v->z * v->z) + (v->w * v->w));
+
+    // Return the normalized vector
+    *r = (vec3)
+    {
+        .x = v->x / vl,
+        .y = v->y / vl,
+        .z = v->z / vl,
+        .w = v->w / vl
+    };
+}
+
+static void mul_mat4_vec4_scalar ( vec4 *r, const mat4 *m, const vec4 *v )
+{
+    *r = (vec4)
+    {
+        .x = m->a * v->x + m->b * v->y + m->c * v->z + m->d * v->w,
+        .y = m->e * v->x + m->f * v->y + m->g * v->z + m->h * v->w,
+        .z = m->i * v->x + m->j * v->y + m->k * v->z + m->l * v->w,
+        .w = m->m * v->x + m->n * v->y + m->o * v->z + m->p * v->w
+    };
+}
+
+static void mul_mat4_mat4_scalar ( mat4 *r, const mat4 *m, const mat4 *n )
+{
+    *r = (mat4)
+    {
+        .a = (m->a * n->a + m->b * n->e + m->c * n->i + m->d * n->m), .b = (m->a * n->b + m->b * n->f + m->c * n->j + m->d * n->n), .c = (m->a * n->c + m->b * n->g + m->c * n->k + m->d * n->o), .d = (m->a * n->d + m->b * n->h + m->c * n->l + m->d * n->p),
+        .e = (m->e * n->a + m->f * n->e + m->g * n->i + m->h * n->m), .f = (m->e * n->b + m->f * n->f + m->g * n->j + m->h * n->n), .g = (m->e * n->c + m->f * n->g + m->g * n->k + m->h * n->o), .h = (m->e * n->d + m->f * n->h + m->g * n->l + m->h * n->p),
+        .i = (m->i * n->a + m->j * n->e + m->k * n->i + m->l * n->m), .j = (m->i * n->b + m->j * n->f + m->k * n->j + m->l * n->n), .k = (m->i * n->c + m->j * n->g + m->k * n->k + m->l * n->o), .l = (m->i * n->d + m->j * n->h + m->k * n->l + m->l * n->p),
+        .m = (m->m * n->a + m->n * n->e + m->o * n->i + m->p * n->m), .n = (m->m * n->b + m->n * n->f + m->o * n->j + m->p * n->n), .o = (m->m * n->c + m->n * n->g + m->o * n->k + m->p * n->o), .p = (m->m * n->d + m->n * n->h + m->o * n->l + m->p * n->p)
+    };
+}
+
+#ifdef G10_LINEAR_X86
+
+// SSE4.1 kernels
+G10_TARGET("sse4.1")
+static void normalize_sse41 ( vec3 *r, const vec3 *v )
+{
+
+    // Initialized data
+    __m128 x = _mm_load_ps(&v->x);
+
+    // Divide each component by the length
+    _mm_store_ps(&r->x, _mm_div_ps(x, _mm_sqrt_ps(_mm_dp_ps(x, x, 0xFF))));
+}
+
+G10_TARGET("sse4.1")
+static void mul_mat4_vec4_sse41 ( vec4 *r, const mat4 *m, const vec4 *v )
+{
+
+    // Initialized data
+    __m128 x = _mm_load_ps(&v->x);
+
+    // Each dot product writes one lane and zeros the others
+    __m128 rx = _mm_dp_ps(_mm_load_ps(&m->a), x, 0xF1),
+           ry = _mm_dp_ps(_mm_load_ps(&m->e), x, 0xF2),
+           rz = _mm_dp_ps(_mm_load_ps(&m->i), x, 0xF4),
+           rw = _mm_dp_ps(_mm_load_ps(&m->m), x, 0xF8);
+
+    // Merge the lanes
+    _mm_store_ps(&r->x, _mm_or_ps(_mm_or_ps(rx, ry), _mm_or_ps(rz, rw)));
+}
+
+G10_TARGET("sse4.1")
+static void mul_mat4_mat4_sse41 ( mat4 *r, const mat4 *m, const mat4 *n )
+{
+
+    // Initialized data
+    const float *p_m = &m->a;
+    float       *p_r = &r->a;
+    __m128       n0  = _mm_load_ps(&n->a),
+                 n1  = _mm_load_ps(&n->e),
+                 n2  = _mm_load_ps(&n->i),
+                 n3  = _mm_load_ps(&n->m);
+
+    // Each row of r is a linear combination of the rows of n
+    for (size_t i = 0; i < 16; i += 4)
+    {
+        __m128 row = _mm_load_ps(&p_m[i]),
+               acc = _mm_mul_ps(_mm_shuffle_ps(row, row, 0x00), n0);
+
+        acc = _mm_add_ps(acc, _mm_mul_ps(_mm_shuffle_ps(row, row, 0x55), n1));
+        acc = _mm_add_ps(acc, _mm_mul_ps(_mm_shuffle_ps(row, row, 0xAA), n2));
+        acc = _mm_add_ps(acc, _mm_mul_ps(_mm_shuffle_ps(row, row, 0xFF), n3));
+
+        _mm_store_ps(&p_r[i], acc);
+    }
+}
+
+// AVX2 and FMA kernels
+G10_TARGET("avx2,fma")
+static void mul_mat4_vec4_avx2 ( vec4 *r, const mat4 *m, const vec4 *v )
+{
+
+    // Initialized data
+    __m256 x   = _mm256_broadcast_ps((const __m128 *)&v->x),
+           p01 = _mm256_mul_ps(_mm256_loadu_ps(&m->a), x),
+           p23 = _mm256_mul_ps(_mm256_loadu_ps(&m->i), x),
+           h   = _mm256_hadd_ps(p01, p23);
+
+    // [ 0, 2, 1, 3 ] -> [ 0, 1, 2, 3 ]
+    __m128 s = _mm_hadd_ps(_mm256_castps256_ps128(h), _mm256_extractf128_ps(h, 1));
+
+    _mm_store_ps(&r->x, _mm_shuffle_ps(s, s, _MM_SHUFFLE(3, 1, 2, 0)));
+}
+
+G10_TARGET("avx2,fma")
+static void mul_mat4_mat4_avx2 ( mat4 *r, const mat4 *m, const mat4 *n )
+{
+
+    // Initialized data
+    __m256 m01 = _mm256_loadu_ps(&m->a),
+           m23 = _mm256_loadu_ps(&m->i),
+           n0  = _mm256_broadcast_ps((const __m128 *)&n->a),
+           n1  = _mm256_broadcast_ps((const __m128 *)&n->e),
+           n2  = _mm256_broadcast_ps((const __m128 *)&n->i),
+           n3  = _mm256_broadcast_ps((const __m128 *)&n->m),
+           r01 = _mm256_mul_ps(_mm256_permute_ps(m01, 0x00), n0),
+           r23 = _mm256_mul_ps(_mm256_permute_ps(m23, 0x00), n0);
+
+    // Two rows of r at a time
+    r01 = _mm256_fmadd_ps(_mm256_permute_ps(m01, 0x55), n1, r01);
+    r23 = _mm256_fmadd_ps(_mm256_permute_ps(m23, 0x55), n1, r23);
+    r01 = _mm256_fmadd_ps(_mm256_permute_ps(m01, 0xAA), n2, r01);
+    r23 = _mm256_fmadd_ps(_mm256_permute_ps(m23, 0xAA), n2, r23);
+    r01 = _mm256_fmadd_ps(_mm256_permute_ps(m01, 0xFF), n3, r01);
+    r23 = _mm256_fmadd_ps(_mm256_permute_ps(m23, 0xFF), n3, r23);
+
+    _mm256_storeu_ps(&r->a, r01);
+    _mm256_storeu_ps(&r->i, r23);
+}
+
+static bool cpu_has_fma ( void )
+{
+    #if defined(_MSC_VER)
+        int registers[4];
+
+        __cpuid(registers, 1);
+
+        return ( registers[2] & ( 1 << 12 ) ) != 0;
+    #else
+        return __builtin_cpu_supports("fma");
+    #endif
+}
+#endif
+
+#ifdef G10_LINEAR_NEON
+
+// NEON kernels
+static void normalize_neon ( vec3 *r, const vec3 *v )
+{
+
+    // Initialized data
+    float32x4_t x = vld1q_f32(&v->x);
+
+    // Divide each component by the length
+    vst1q_f32(&r->x, vdivq_f32(x, vdupq_n_f32(sqrtf(vaddvq_f32(vmulq_f32(x, x))))));
+}
+
+static void mul_mat4_vec4_neon ( vec4 *r, const mat4 *m, const vec4 *v )
+{
+
+    // Initialized data
+    float32x4_t x  = vld1q_f32(&v->x),
+                p0 = vmulq_f32(vld1q_f32(&m->a), x),
+                p1 = vmulq_f32(vld1q_f32(&m->e), x),
+                p2 = vmulq_f32(vld1q_f32(&m->i), x),
+                p3 = vmulq_f32(vld1q_f32(&m->m), x);
+
+    // Two rounds of pairwise adds sum each row into its own lane
+    vst1q_f32(&r->x, vpaddq_f32(vpaddq_f32(p0, p1), vpaddq_f32(p2, p3)));
+}
+
+static void mul_mat4_mat4_neon ( mat4 *r, const mat4 *m, const mat4 *n )
+{
+
+    // Initialized data
+    const float *p_m = &m->a;
+    float       *p_r = &r->a;
+    float32x4_t  n0  = vld1q_f32(&n->a),
+                 n1  = vld1q_f32(&n->e),
+                 n2  = vld1q_f32(&n->i),
+                 n3  = vld1q_f32(&n->m);
+
+    // Each row of r is a linear combination of the rows of n
+    for (size_t i = 0; i < 16; i += 4)
+    {
+        float32x4_t row = vld1q_f32(&p_m[i]),
+                    acc = vmulq_laneq_f32(n0, row, 0);
+
+        acc = vfmaq_laneq_f32(acc, n1, row, 1);
+        acc = vfmaq_laneq_f32(acc, n2, row, 2);
+        acc = vfmaq_laneq_f32(acc, n3, row, 3);
+
+        vst1q_f32(&p_r[i], acc);
+    }
+}
+#endif
+
+// Scalar batch kernels
+static void mul_mat4_vec4_batch_scalar ( vec4 *r, const mat4 *m, const vec4 *v, size_t count )
+{
+
+    // Initialized data
+    mat4 M = *m;
+
+    // Transform each vector
+    for (size_t i = 0; i < count; i++)
+    {
+        vec4 x = v[i];
+
+        r[i] = (vec4)
+        {
+            .x = M.a * x.x + M.b * x.y + M.c * x.z + M.d * x.w,
+            .y = M.e * x.x + M.f * x.y + M.g * x.z + M.h * x.w,
+            .z = M.i * x.x + M.j * x.y + M.k * x.z + M.l * x.w,
+            .w = M.m * x.x + M.n * x.y + M.o * x.z + M.p * x.w
+        };
+    }
+}
+
+static void mul_mat4_vec4_batch_soa_scalar ( vec4_soa r, const mat4 *m, vec4_soa v, size_t count )
+{
+
+    // Initialized data
+    mat4 M = *m;
+
+    // Transform each vector
+    for (size_t i = 0; i < count; i++)
+    {
+        float x = v.x[i],
+              y = v.y[i],
+              z = v.z[i],
+              w = ( v.w ) ? v.w[i] : 1.f;
+
+        r.x[i] = M.a * x + M.b * y + M.c * z + M.d * w,
+        r.y[i] = M.e * x + M.f * y + M.g * z + M.h * w,
+        r.z[i] = M.i * x + M.j * y + M.k * z + M.l * w;
+
+        if ( r.w ) r.w[i] = M.m * x + M.n * y + M.o * z + M.p * w;
+    }
+}
+
+static void mul_mat4_mat4_batch_scalar ( mat4 *r, const mat4 *m, const mat4 *n, size_t count )
+{
+    for (size_t i = 0; i < count; i++)
+        mul_mat4_mat4_scalar(&r[i], &m[i], &n[i]);
+}
+
+// Advance each array of a structure of arrays
+static vec4_soa vec4_soa_offset ( vec4_soa v, size_t i )
+{
+    return (vec4_soa)
+    {
+        .x = v.x + i,
+        .y = v.y + i,
+        .z = v.z + i,
+        .w = ( v.w ) ? v.w + i : (void *) 0
+    };
+}
+
+#ifdef G10_LINEAR_X86
+
+// SSE4.1 batch kernels
+G10_TARGET("sse4.1")
+static void mul_mat4_vec4_batch_sse41 ( vec4 *r, const mat4 *m, const vec4 *v, size_t count )
+{
+
+    // Initialized data
+    __m128 c0 = _mm_load_ps(&m->a),
+           c1 = _mm_load_ps(&m->e),
+           c2 = _mm_load_ps(&m->i),
+           c3 = _mm_load_ps(&m->m);
+
+    // Rows to columns
+    _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+
+    // Each vector is a linear combination of the columns
+    for (size_t i = 0; i < count; i++)
+    {
+        __m128 x   = _mm_load_ps(&v[i].x),
+               acc = _mm_mul_ps(c0, _mm_shuffle_ps(x, x, 0x00));
+
+        acc = _mm_add_ps(acc, _mm_mul_ps(c1, _mm_shuffle_ps(x, x, 0x55)));
+        acc = _mm_add_ps(acc, _mm_mul_ps(c2, _mm_shuffle_ps(x, x, 0xAA)));
+        acc = _mm_add_ps(acc, _mm_mul_ps(c3, _mm_shuffle_ps(x, x, 0xFF)));
+
+        _mm_store_ps(&r[i].x, acc);
+    }
+}
+
+G10_TARGET("sse4.1")
+static void mul_mat4_vec4_batch_soa_sse41 ( vec4_soa r, const mat4 *m, vec4_soa v, size_t count )
+{
+
+    // Initialized data
+    size_t i   = 0;
+    __m128 one = _mm_set1_ps(1.f),
+           a   = _mm_set1_ps(m->a), b = _mm_set1_ps(m->b), c = _mm_set1_ps(m->c), d = _mm_set1_ps(m->d),
+           e   = _mm_set1_ps(m->e), f = _mm_set1_ps(m->f), g = _mm_set1_ps(m->g), h = _mm_set1_ps(m->h),
+           j   = _mm_set1_ps(m->i), k = _mm_set1_ps(m->j), l = _mm_set1_ps(m->k), o = _mm_set1_ps(m->l),
+           p   = _mm_set1_ps(m->m), q = _mm_set1_ps(m->n), s = _mm_set1_ps(m->o), t = _mm_set1_ps(m->p);
+
+    // Four vectors at a time
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128 x = _mm_loadu_ps(&v.x[i]),
+               y = _mm_loadu_ps(&v.y[i]),
+               z = _mm_loadu_ps(&v.z[i]),
+               w = ( v.w ) ? _mm_loadu_ps(&v.w[i]) : one;
+
+        _mm_storeu_ps(&r.x[i], _mm_add_ps(_mm_add_ps(_mm_mul_ps(a, x), _mm_mul_ps(b, y)), _mm_add_ps(_mm_mul_ps(c, z), _mm_mul_ps(d, w))));
+        _mm_storeu_ps(&r.y[i], _mm_add_ps(_mm_add_ps(_mm_mul_ps(e, x), _mm_mul_ps(f, y)), _mm_add_ps(_mm_mul_ps(g, z), _mm_mul_ps(h, w))));
+        _mm_storeu_ps(&r.z[i], _mm_add_ps(_mm_add_ps(_mm_mul_ps(j, x), _mm_mul_ps(k, y)), _mm_add_ps(_mm_mul_ps(l, z), _mm_mul_ps(o, w))));
+
+        if ( r.w ) _mm_storeu_ps(&r.w[i], _mm_add_ps(_mm_add_ps(_mm_mul_ps(p, x), _mm_mul_ps(q, y)), _mm_add_ps(_mm_mul_ps(s, z), _mm_mul_ps(t, w))));
+    }
+
+    // The rest
+    mul_mat4_vec4_batch_soa_scalar(vec4_soa_offset(r, i), m, vec4_soa_offset(v, i), count - i);
+}
+
+G10_TARGET("sse4.1")
+static void mul_mat4_mat4_batch_sse41 ( mat4 *r, const mat4 *m, const mat4 *n, size_t count )
+{
+    for (size_t i = 0; i < count; i++)
+        mul_mat4_mat4_sse41(&r[i], &m[i], &n[i]);
+}
+
+// AVX2 and FMA batch kernels
+G10_TARGET("avx2,fma")
+static void mul_mat4_vec4_batch_avx2 ( vec4 *r, const mat4 *m, const vec4 *v, size_t count )
+{
+
+    // Initialized data
+    size_t i  = 0;
+    __m128 c0 = _mm_load_ps(&m->a),
+           c1 = _mm_load_ps(&m->e),
+           c2 = _mm_load_ps(&m->i),
+           c3 = _mm_load_ps(&m->m);
+
+    // Rows to columns
+    _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+
+    // Two vectors at a time
+    {
+
+        // Initialized data
+        __m256 w0 = _mm256_set_m128(c0, c0),
+               w1 = _mm256_set_m128(c1, c1),
+               w2 = _mm256_set_m128(c2, c2),
+               w3 = _mm256_set_m128(c3, c3);
+
+        for (; i + 2 <= count; i += 2)
+        {
+            __m256 x   = _mm256_loadu_ps(&v[i].x),
+                   acc = _mm256_mul_ps(w0, _mm256_permute_ps(x, 0x00));
+
+            acc = _mm256_fmadd_ps(w1, _mm256_permute_ps(x, 0x55), acc);
+            acc = _mm256_fmadd_ps(w2, _mm256_permute_ps(x, 0xAA), acc);
+            acc = _mm256_fmadd_ps(w3, _mm256_permute_ps(x, 0xFF), acc);
+
+            _mm256_storeu_ps(&r[i].x, acc);
+        }
+    }
+
+    // The last odd vector
+    if ( i < count )
+    {
+        __m128 x   = _mm_load_ps(&v[i].x),
+               acc = _mm_mul_ps(c0, _mm_permute_ps(x, 0x00));
+
+        acc = _mm_fmadd_ps(c1, _mm_permute_ps(x, 0x55), acc);
+        acc = _mm_fmadd_ps(c2, _mm_permute_ps(x, 0xAA), acc);
+        acc = _mm_fmadd_ps(c3, _mm_permute_ps(x, 0xFF), acc);
+
+        _mm_store_ps(&r[i].x, acc);
+    }
+}
+
+G10_TARGET("avx2,fma")
+static void mul_mat4_vec4_batch_soa_avx2 ( vec4_soa r, const mat4 *m, vec4_soa v, size_t count )
+{
+
+    // Initialized data
+    size_t i   = 0;
+    __m256 one = _mm256_set1_ps(1.f),
+           a   = _mm256_set1_ps(m->a), b = _mm256_set1_ps(m->b), c = _mm256_set1_ps(m->c), d = _mm256_set1_ps(m->d),
+           e   = _mm256_set1_ps(m->e), f = _mm256_set1_ps(m->f), g = _mm256_set1_ps(m->g), h = _mm256_set1_ps(m->h),
+           j   = _mm256_set1_ps(m->i), k = _mm256_set1_ps(m->j), l = _mm256_set1_ps(m->k), o = _mm256_set1_ps(m->l),
+           p   = _mm256_set1_ps(m->m), q = _mm256_set1_ps(m->n), s = _mm256_set1_ps(m->o), t = _mm256_set1_ps(m->p);
+
+    // Eight vectors at a time
+    for (; i + 8 <= count; i += 8)
+    {
+        __m256 x = _mm256_loadu_ps(&v.x[i]),
+               y = _mm256_loadu_ps(&v.y[i]),
+               z = _mm256_loadu_ps(&v.z[i]),
+               w = ( v.w ) ? _mm256_loadu_ps(&v.w[i]) : one;
+
+        _mm256_storeu_ps(&r.x[i], _mm256_fmadd_ps(d, w, _mm256_fmadd_ps(c, z, _mm256_fmadd_ps(b, y, _mm256_mul_ps(a, x)))));
+        _mm256_storeu_ps(&r.y[i], _mm256_fmadd_ps(h, w, _mm256_fmadd_ps(g, z, _mm256_fmadd_ps(f, y, _mm256_mul_ps(e, x)))));
+        _mm256_storeu_ps(&r.z[i], _mm256_fmadd_ps(o, w, _mm256_fmadd_ps(l, z, _mm256_fmadd_ps(k, y, _mm256_mul_ps(j, x)))));
+
+        if ( r.w ) _mm256_storeu_ps(&r.w[i], _mm256_fmadd_ps(t, w, _mm256_fmadd_ps(s, z, _mm256_fmadd_ps(q, y, _mm256_mul_ps(p, x)))));
+    }
+
+    // The rest
+    mul_mat4_vec4_batch_soa_scalar(vec4_soa_offset(r, i), m, vec4_soa_offset(v, i), count - i);
+}
+
+G10_TARGET("avx2,fma")
+static void mul_mat4_mat4_batch_avx2 ( mat4 *r, const mat4 *m, const mat4 *n, size_t count )
+{
+    for (size_t i = 0; i < count; i++)
+        mul_mat4_mat4_avx2(&r[i], &m[i], &n[i]);
+}
+#endif
+
+#ifdef G10_LINEAR_NEON
+
+// NEON batch kernels
+static void mul_mat4_vec4_batch_neon ( vec4 *r, const mat4 *m, const vec4 *v, size_t count )
+{
+
+    // Initialized data
+    float32x4x4_t c = vld4q_f32(&m->a);
+
+    // Each vector is a linear combination of the columns
+    for (size_t i = 0; i < count; i++)
+    {
+        float32x4_t x   = vld1q_f32(&v[i].x),
+                    acc = vmulq_laneq_f32(c.val[0], x, 0);
+
+        acc = vfmaq_laneq_f32(acc, c.val[1], x, 1);
+        acc = vfmaq_laneq_f32(acc, c.val[2], x, 2);
+        acc = vfmaq_laneq_f32(acc, c.val[3], x, 3);
+
+        vst1q_f32(&r[i].x, acc);
+    }
+}
+
+static void mul_mat4_vec4_batch_soa_neon ( vec4_soa r, const mat4 *m, vec4_soa v, size_t count )
+{
+
+    // Initialized data
+    size_t      i   = 0;
+    float32x4_t one = vdupq_n_f32(1.f);
+
+    // Four vectors at a time
+    for (; i + 4 <= count; i += 4)
+    {
+        float32x4_t x = vld1q_f32(&v.x[i]),
+                    y = vld1q_f32(&v.y[i]),
+                    z = vld1q_f32(&v.z[i]),
+                    w = ( v.w ) ? vld1q_f32(&v.w[i]) : one;
+
+        vst1q_f32(&r.x[i], vfmaq_n_f32(vfmaq_n_f32(vfmaq_n_f32(vmulq_n_f32(x, m->a), y, m->b), z, m->c), w, m->d));
+        vst1q_f32(&r.y[i], vfmaq_n_f32(vfmaq_n_f32(vfmaq_n_f32(vmulq_n_f32(x, m->e), y, m->f), z, m->g), w, m->h));
+        vst1q_f32(&r.z[i], vfmaq_n_f32(vfmaq_n_f32(vfmaq_n_f32(vmulq_n_f32(x, m->i), y, m->j), z, m->k), w, m->l));
+
+        if ( r.w ) vst1q_f32(&r.w[i], vfmaq_n_f32(vfmaq_n_f32(vfmaq_n_f32(vmulq_n_f32(x, m->m), y, m->n), z, m->o), w, m->p));
+    }
+
+    // The rest
+    mul_mat4_vec4_batch_soa_scalar(vec4_soa_offset(r, i), m, vec4_soa_offset(v, i), count - i);
+}
+
+static void mul_mat4_mat4_batch_neon ( mat4 *r, const mat4 *m, const mat4 *n, size_t count )
+{
+    for (size_t i = 0; i < count; i++)
+        mul_mat4_mat4_neon(&r[i], &m[i], &n[i]);
+}
+#endif
+
+// Scalar inverse kernels
+static bool inverse_mat4_scalar ( mat4 *r, const mat4 *m )
+{
+
+    // Initialized data
+    const float *p = &m->a;
+    float        c[16],
+                 det,
+                 rcp;
+
+    // Cofactors
+    c[0]  =  p[5] * p[10] * p[15] - p[5] * p[11] * p[14] - p[9] * p[6] * p[15] + p[9] * p[7] * p[14] + p[13] * p[6] * p[11] - p[13] * p[7] * p[10];
+    c[4]  = -p[4] * p[10] * p[15] + p[4] * p[11] * p[14] + p[8] * p[6] * p[15] - p[8] * p[7] * p[14] - p[12] * p[6] * p[11] + p[12] * p[7] * p[10];
+    c[8]  =  p[4] * p[9]  * p[15] - p[4] * p[11] * p[13] - p[8] * p[5] * p[15] + p[8] * p[7] * p[13] + p[12] * p[5] * p[11] - p[12] * p[7] * p[9];
+    c[12] = -p[4] * p[9]  * p[14] + p[4] * p[10] * p[13] + p[8] * p[5] * p[14] - p[8] * p[6] * p[13] - p[12] * p[5] * p[10] + p[12] * p[6] * p[9];
+    c[1]  = -p[1] * p[10] * p[15] + p[1] * p[11] * p[14] + p[9] * p[2] * p[15] - p[9] * p[3] * p[14] - p[13] * p[2] * p[11] + p[13] * p[3] * p[10];
+    c[5]  =  p[0] * p[10] * p[15] - p[0] * p[11] * p[14] - p[8] * p[2] * p[15] + p[8] * p[3] * p[14] + p[12] * p[2] * p[11] - p[12] * p[3] * p[10];
+    c[9]  = -p[0] * p[9]  * p[15] + p[0] * p[11] * p[13] + p[8] * p[1] * p[15] - p[8] * p[3] * p[13] - p[12] * p[1] * p[11] + p[12] * p[3] * p[9];
+    c[13] =  p[0] * p[9]  * p[14] - p[0] * p[10] * p[13] - p[8] * p[1] * p[14] + p[8] * p[2] * p[13] + p[12] * p[1] * p[10] - p[12] * p[2] * p[9];
+    c[2]  =  p[1] * p[6]  * p[15] - p[1] * p[7]  * p[14] - p[5] * p[2] * p[15] + p[5] * p[3] * p[14] + p[13] * p[2] * p[7]  - p[13] * p[3] * p[6];
+    c[6]  = -p[0] * p[6]  * p[15] + p[0] * p[7]  * p[14] + p[4] * p[2] * p[15] - p[4] * p[3] * p[14] - p[12] * p[2] * p[7]  + p[12] * p[3] * p[6];
+    c[10] =  p[0] * p[5]  * p[15] - p[0] * p[7]  * p[13] - p[4] * p[1] * p[15] + p[4] * p[3] * p[13] + p[12] * p[1] * p[7]  - p[12] * p[3] * p[5];
+    c[14] = -p[0] * p[5]  * p[14] + p[0] * p[6]  * p[13] + p[4] * p[1] * p[14] - p[4] * p[2] * p[13] - p[12] * p[1] * p[6]  + p[12] * p[2] * p[5];
+    c[3]  = -p[1] * p[6]  * p[11] + p[1] * p[7]  * p[10] + p[5] * p[2] * p[11] - p[5] * p[3] * p[10] - p[9]  * p[2] * p[7]  + p[9]  * p[3] * p[6];
+    c[7]  =  p[0] * p[6]  * p[11] - p[0] * p[7]  * p[10] - p[4] * p[2] * p[11] + p[4] * p[3] * p[10] + p[8]  * p[2] * p[7]  - p[8]  * p[3] * p[6];
+    c[11] = -p[0] * p[5]  * p[11] + p[0] * p[7]  * p[9]  + p[4] * p[1] * p[11] - p[4] * p[3] * p[9]  - p[8]  * p[1] * p[7]  + p[8]  * p[3] * p[5];
+    c[15] =  p[0] * p[5]  * p[10] - p[0] * p[6]  * p[9]  - p[4] * p[1] * p[10] + p[4] * p[2] * p[9]  + p[8]  * p[1] * p[6]  - p[8]  * p[2] * p[5];
+
+    // Expand along the first row
+    det = p[0] * c[0] + p[1] * c[4] + p[2] * c[8] + p[3] * c[12];
+
+    // Singular matrices have no inverse
+    if ( det == 0.f ) return false;
+
+    // One reciprocal
+    rcp = 1.f / det;
+
+    for (size_t i = 0; i < 16; i++)
+        (&r->a)[i] = c[i] * rcp;
+
+    // Success
+    return true;
+}
+
+static void affine_inverse_mat4_scalar ( mat4 *r, const mat4 *m )
+{
+
+    // Initialized data
+    float sx = 1.f / (m->a * m->a + m->b * m->b + m->c * m->c),
+          sy = 1.f / (m->e * m->e + m->f * m->f + m->g * m->g),
+          sz = 1.f / (m->i * m->i + m->j * m->j + m->k * m->k),
+          a  = m->a * sx, b = m->e * sy, c = m->i * sz,
+          e  = m->b * sx, f = m->f * sy, g = m->j * sz,
+          i  = m->c * sx, j = m->g * sy, k = m->k * sz,
+          x  = m->m,
+          y  = m->n,
+          z  = m->o;
+
+    // Transpose the rotation, divide out the scale, and undo the translation
+    *r = (mat4)
+    {
+        .a = a                          , .b = b                          , .c = c                          , .d = 0.f,
+        .e = e                          , .f = f                          , .g = g                          , .h = 0.f,
+        .i = i                          , .j = j                          , .k = k                          , .l = 0.f,
+        .m = -(x * a + y * e + z * i)   , .n = -(x * b + y * f + z * j)   , .o = -(x * c + y * g + z * k)   , .p = 1.f
+    };
+}
+
+static void normal_mat4_scalar ( mat4 *r, const mat4 *m )
+{
+
+    // Initialized data
+    float sx = 1.f / (m->a * m->a + m->b * m->b + m->c * m->c),
+          sy = 1.f / (m->e * m->e + m->f * m->f + m->g * m->g),
+          sz = 1.f / (m->i * m->i + m->j * m->j + m->k * m->k);
+
+    // The transposed inverse of scale * rotation is rotation / scale
+    *r = (mat4)
+    {
+        .a = m->a * sx, .b = m->b * sx, .c = m->c * sx, .d = 0.f,
+        .e = m->e * sy, .f = m->f * sy, .g = m->g * sy, .h = 0.f,
+        .i = m->i * sz, .j = m->j * sz, .k = m->k * sz, .l = 0.f,
+        .m = 0.f      , .n = 0.f      , .o = 0.f      , .p = 1.f
+    };
+}
+
+static void inverse_mat4_batch_scalar ( mat4 *r, const mat4 *m, size_t count )
+{
+    for (size_t i = 0; i < count; i++)
+        if ( inverse_mat4_scalar(&r[i], &m[i]) == false )
+            r[i] = (mat4) { NAN, NAN, NAN, NAN, NAN, NAN, NAN, NAN, NAN, NAN, NAN, NAN, NAN, NAN, NAN, NAN };
+}
+
+static void affine_inverse_mat4_batch_scalar ( mat4 *r, const mat4 *m, size_t count )
+{
+    for (size_t i = 0; i < count; i++)
+        affine_inverse_mat4_scalar(&r[i], &m[i]);
+}
+
+static void normal_mat4_batch_scalar ( mat4 *r, const mat4 *m, size_t count )
+{
+    for (size_t i = 0; i < count; i++)
+        normal_mat4_scalar(&r[i], &m[i]);
+}
+
+#ifdef G10_LINEAR_X86
+
+// SSE4.1 inverse kernels. The general inverse splits the matrix into 2x2
+// blocks, each held in one register as < a, b, c, d >
+
+// A * B
+G10_TARGET("sse4.1")
+static __m128 mul_mat2_sse41 ( __m128 a, __m128 b )
+{
+    return _mm_add_ps(
+        _mm_mul_ps(a, _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 3, 0))),
+        _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 2, 1, 2)))
+    );
+}
+
+// adjugate(A) * B
+G10_TARGET("sse4.1")
+static __m128 adj_mul_mat2_sse41 ( __m128 a, __m128 b )
+{
+    return _mm_sub_ps(
+        _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(0, 0, 3, 3)), b),
+        _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 2, 1, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 0, 3, 2)))
+    );
+}
+
+// A * adjugate(B)
+G10_TARGET("sse4.1")
+static __m128 mul_adj_mat2_sse41 ( __m128 a, __m128 b )
+{
+    return _mm_sub_ps(
+        _mm_mul_ps(a, _mm_shuffle_ps(b, b, _MM_SHUFFLE(0, 3, 0, 3))),
+        _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 2, 1, 2)))
+    );
+}
+
+G10_TARGET("sse4.1")
+static bool inverse_mat4_sse41 ( mat4 *r, const mat4 *m )
+{
+
+    // Initialized data
+    __m128 r0 = _mm_load_ps(&m->a),
+           r1 = _mm_load_ps(&m->e),
+           r2 = _mm_load_ps(&m->i),
+           r3 = _mm_load_ps(&m->m),
+
+           // | A B |
+           // | C D |
+           a  = _mm_movelh_ps(r0, r1),
+           b  = _mm_movehl_ps(r1, r0),
+           c  = _mm_movelh_ps(r2, r3),
+           d  = _mm_movehl_ps(r3, r2),
+
+           // < |A|, |B|, |C|, |D| >
+           det_sub = _mm_sub_ps(
+               _mm_mul_ps(_mm_shuffle_ps(r0, r2, _MM_SHUFFLE(2, 0, 2, 0)), _mm_shuffle_ps(r1, r3, _MM_SHUFFLE(3, 1, 3, 1))),
+               _mm_mul_ps(_mm_shuffle_ps(r0, r2, _MM_SHUFFLE(3, 1, 3, 1)), _mm_shuffle_ps(r1, r3, _MM_SHUFFLE(2, 0, 2, 0)))
+           ),
+           det_a = _mm_shuffle_ps(det_sub, det_sub, 0x00),
+           det_b = _mm_shuffle_ps(det_sub, det_sub, 0x55),
+           det_c = _mm_shuffle_ps(det_sub, det_sub, 0xAA),
+           det_d = _mm_shuffle_ps(det_sub, det_sub, 0xFF),
+
+           // adjugate(D) * C and adjugate(A) * B
+           d_c = adj_mul_mat2_sse41(d, c),
+           a_b = adj_mul_mat2_sse41(a, b),
+
+           // The adjugate of each block of the inverse
+           x = _mm_sub_ps(_mm_mul_ps(det_d, a), mul_mat2_sse41(b, d_c)),
+           w = _mm_sub_ps(_mm_mul_ps(det_a, d), mul_mat2_sse41(c, a_b)),
+           y = _mm_sub_ps(_mm_mul_ps(det_b, c), mul_adj_mat2_sse41(d, a_b)),
+           z = _mm_sub_ps(_mm_mul_ps(det_c, b), mul_adj_mat2_sse41(a, d_c)),
+
+           // |M| = |A| |D| + |B| |C| - tr( adjugate(A) * B * adjugate(D) * C )
+           tr  = _mm_mul_ps(a_b, _mm_shuffle_ps(d_c, d_c, _MM_SHUFFLE(3, 1, 2, 0))),
+           det;
+
+    tr  = _mm_hadd_ps(tr, tr);
+    tr  = _mm_hadd_ps(tr, tr);
+    det = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(det_a, det_d), _mm_mul_ps(det_b, det_c)), tr);
+
+    // Singular matrices have no inverse
+    if ( _mm_cvtss_f32(det) == 0.f ) return false;
+
+    // One reciprocal, with the signs of the adjugate
+    det = _mm_div_ps(_mm_setr_ps(1.f, -1.f, -1.f, 1.f), det);
+
+    x = _mm_mul_ps(x, det);
+    y = _mm_mul_ps(y, det);
+    z = _mm_mul_ps(z, det);
+    w = _mm_mul_ps(w, det);
+
+    // Blocks to rows
+    _mm_store_ps(&r->a, _mm_shuffle_ps(x, y, _MM_SHUFFLE(1, 3, 1, 3)));
+    _mm_store_ps(&r->e, _mm_shuffle_ps(x, y, _MM_SHUFFLE(0, 2, 0, 2)));
+    _mm_store_ps(&r->i, _mm_shuffle_ps(z, w, _MM_SHUFFLE(1, 3, 1, 3)));
+    _mm_store_ps(&r->m, _mm_shuffle_ps(z, w, _MM_SHUFFLE(0, 2, 0, 2)));
+
+    // Success
+    return true;
+}
+
+G10_TARGET("sse4.1")
+static void affine_inverse_mat4_sse41 ( mat4 *r, const mat4 *m )
+{
+
+    // Initialized data
+    __m128 c0 = _mm_load_ps(&m->a),
+           c1 = _mm_load_ps(&m->e),
+           c2 = _mm_load_ps(&m->i),
+           c3 = _mm_load_ps(&m->m),
+           t  = c3,
+           s;
+
+    // Rows to columns
+    _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+
+    // < 1 / |row 0|^2, 1 / |row 1|^2, 1 / |row 2|^2, 0 >
+    s = _mm_add_ps(_mm_add_ps(_mm_mul_ps(c0, c0), _mm_mul_ps(c1, c1)), _mm_mul_ps(c2, c2));
+    s = _mm_div_ps(_mm_set1_ps(1.f), _mm_blend_ps(s, _mm_set1_ps(1.f), 0x8));
+    s = _mm_blend_ps(s, _mm_setzero_ps(), 0x8);
+
+    // Transpose the rotation and divide out the scale
+    c0 = _mm_mul_ps(c0, s);
+    c1 = _mm_mul_ps(c1, s);
+    c2 = _mm_mul_ps(c2, s);
+
+    // Undo the translation
+    c3 = _mm_mul_ps(_mm_shuffle_ps(t, t, 0x00), c0);
+    c3 = _mm_add_ps(c3, _mm_mul_ps(_mm_shuffle_ps(t, t, 0x55), c1));
+    c3 = _mm_add_ps(c3, _mm_mul_ps(_mm_shuffle_ps(t, t, 0xAA), c2));
+    c3 = _mm_sub_ps(_mm_setr_ps(0.f, 0.f, 0.f, 1.f), c3);
+
+    _mm_store_ps(&r->a, c0);
+    _mm_store_ps(&r->e, c1);
+    _mm_store_ps(&r->i, c2);
+    _mm_store_ps(&r->m, c3);
+}
+
+G10_TARGET("sse4.1")
+static void normal_mat4_sse41 ( mat4 *r, const mat4 *m )
+{
+
+    // Initialized data
+    __m128 mask = _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0)),
+           r0   = _mm_and_ps(_mm_load_ps(&m->a), mask),
+           r1   = _mm_and_ps(_mm_load_ps(&m->e), mask),
+           r2   = _mm_and_ps(_mm_load_ps(&m->i), mask),
+
+           // < |row 0|^2, |row 1|^2, |row 2|^2, 1 >
+           s    = _mm_or_ps(
+                      _mm_or_ps(_mm_dp_ps(r0, r0, 0x71), _mm_dp_ps(r1, r1, 0x72)),
+                      _mm_or_ps(_mm_dp_ps(r2, r2, 0x74), _mm_setr_ps(0.f, 0.f, 0.f, 1.f))
+                  );
+
+    // One division for all three rows
+    s = _mm_div_ps(_mm_set1_ps(1.f), s);
+
+    _mm_store_ps(&r->a, _mm_mul_ps(r0, _mm_shuffle_ps(s, s, 0x00)));
+    _mm_store_ps(&r->e, _mm_mul_ps(r1, _mm_shuffle_ps(s, s, 0x55)));
+    _mm_store_ps(&r->i, _mm_mul_ps(r2, _mm_shuffle_ps(s, s, 0xAA)));
+    _mm_store_ps(&r->m, _mm_setr_ps(0.f, 0.f, 0.f, 1.f));
+}
+
+G10_TARGET("sse4.1")
+static void inverse_mat4_batch_sse41 ( mat4 *r, const mat4 *m, size_t count )
+{
+    for (size_t i = 0; i < count; i++)
+        if ( inverse_mat4_sse41(&r[i], &m[i]) == false )
+            r[i] = (mat4) { NAN, NAN, NAN, NAN, NAN, NAN, NAN, NAN, NAN, NAN, NAN, NAN, NAN, NAN, NAN, NAN };
+}
+
+G10_TARGET("sse4.1")
+static void affine_inverse_mat4_batch_sse41 ( mat4 *r, const mat4 *m, size_t count )
+{
+    for (size_t i = 0; i < count; i++)
+        affine_inverse_mat4_sse41(&r[i], &m[i]);
+}
+
+G10_TARGET("sse4.1")
+static void normal_mat4_batch_sse41 ( mat4 *r, const mat4 *m, size_t count )
+{
+    for (size_t i = 0; i < count; i++)
+        normal_mat4_sse41(&r[i], &m[i]);
+}
+#endif
+
+#ifdef G10_LINEAR_NEON
+
+// NEON inverse kernels. The general inverse uses the scalar kernel
+static void affine_inverse_mat4_neon ( mat4 *r, const mat4 *m )
+{
+
+    // Initialized data
+    float32x4x4_t c = vld4q_f32(&m->a);
+    float32x4_t   s = vfmaq_f32(vfmaq_f32(vmulq_f32(c.val[0], c.val[0]), c.val[1], c.val[1]), c.val[2], c.val[2]),
+                  t;
+
+    // < 1 / |row 0|^2, 1 / |row 1|^2, 1 / |row 2|^2, 0 >
+    s = vdivq_f32(vdupq_n_f32(1.f), vsetq_lane_f32(1.f, s, 3));
+    s = vsetq_lane_f32(0.f, s, 3);
+
+    // Transpose the rotation and divide out the scale
+    c.val[0] = vmulq_f32(c.val[0], s);
+    c.val[1] = vmulq_f32(c.val[1], s);
+    c.val[2] = vmulq_f32(c.val[2], s);
+
+    // Undo the translation
+    t = vmulq_n_f32(c.val[0], m->m);
+    t = vfmaq_n_f32(t, c.val[1], m->n);
+    t = vfmaq_n_f32(t, c.val[2], m->o);
+    t = vsetq_lane_f32(1.f, vnegq_f32(t), 3);
+
+    vst1q_f32(&r->a, c.val[0]);
+    vst1q_f32(&r->e, c.val[1]);
+    vst1q_f32(&r->i, c.val[2]);
+    vst1q_f32(&r->m, t);
+}
+
+static void normal_mat4_neon ( mat4 *r, const mat4 *m )
+{
+
+    // Initialized data
+    float32x4_t r0 = vsetq_lane_f32(0.f, vld1q_f32(&m->a), 3),
+                r1 = vsetq_lane_f32(0.f, vld1q_f32(&m->e), 3),
+                r2 = vsetq_lane_f32(0.f, vld1q_f32(&m->i), 3);
+
+    vst1q_f32(&r->a, vmulq_n_f32(r0, 1.f / vaddvq_f32(vmulq_f32(r0, r0))));
+    vst1q_f32(&r->e, vmulq_n_f32(r1, 1.f / vaddvq_f32(vmulq_f32(r1, r1))));
+    vst1q_f32(&r->i, vmulq_n_f32(r2, 1.f / vaddvq_f32(vmulq_f32(r2, r2))));
+    vst1q_f32(&r->m, vsetq_lane_f32(1.f, vdupq_n_f32(0.f), 3));
+}
+
+static void affine_inverse_mat4_batch_neon ( mat4 *r, const mat4 *m, size_t count )
+{
+    for (size_t i = 0; i < count; i++)
+        affine_inverse_mat4_neon(&r[i], &m[i]);
+}
+
+static void normal_mat4_batch_neon ( mat4 *r, const mat4 *m, size_t count )
+{
+    for (size_t i = 0; i < count; i++)
+        normal_mat4_neon(&r[i], &m[i]);
+}
+#endif
+
+// Selected kernels. Scalar until g_init picks a backend
+static linear_backend_t linear_backend = linear_backend_scalar;
+static void (*normalize_kernel)                 ( vec3 *r, const vec3 *v )                              = normalize_scalar;
+static void (*mul_mat4_vec4_kernel)             ( vec4 *r, const mat4 *m, const vec4 *v )               = mul_mat4_vec4_scalar;
+static void (*mul_mat4_mat4_kernel)             ( mat4 *r, const mat4 *m, const mat4 *n )               = mul_mat4_mat4_scalar;
+static void (*mul_mat4_vec4_batch_kernel)       ( vec4 *r, const mat4 *m, const vec4 *v, size_t count ) = mul_mat4_vec4_batch_scalar;
+static void (*mul_mat4_vec4_batch_soa_kernel)   ( vec4_soa r, const mat4 *m, vec4_soa v, size_t count ) = mul_mat4_vec4_batch_soa_scalar;
+static void (*mul_mat4_mat4_batch_kernel)       ( mat4 *r, const mat4 *m, const mat4 *n, size_t count ) = mul_mat4_mat4_batch_scalar;
+static bool (*inverse_mat4_kernel)              ( mat4 *r, const mat4 *m )                              = inverse_mat4_scalar;
+static void (*affine_inverse_mat4_kernel)       ( mat4 *r, const mat4 *m )                              = affine_inverse_mat4_scalar;
+static void (*inverse_mat4_batch_kernel)        ( mat4 *r, const mat4 *m, size_t count )                = inverse_mat4_batch_scalar;
+static void (*affine_inverse_mat4_batch_kernel) ( mat4 *r, const mat4 *m, size_t count )                = affine_inverse_mat4_batch_scalar;
+static void (*normal_mat4_batch_kernel)         ( mat4 *r, const mat4 *m, size_t count )                = normal_mat4_batch_scalar;
+
 void add_vec3 ( vec3 *r, vec3 a, vec3 b )
 {
     r->x = a.x + b.x,
@@ -62,14 +912,20 @@ vec3 mul_vec3_f ( vec3 v, float s )
 
 vec3 normalize ( vec3 v )
 {
-    float vl = sqrtf((v.x * v.x) + (v.y * v.y) + (v.z * v.z) + (v.w * v.w));
-    return (vec3)
-    {
-        .x = v.x / vl,
-        .y = v.y / vl,
-        .z = v.z / vl,
-        .w = v.w / vl
-    };
+
+    // Initialized data
+    vec3 ret;
+
+    // Normalize
+    normalize_kernel(&ret, &v);
+
+    // Success
+    return ret;
+}
+
+void normalize_p ( vec3 *r, const vec3 *v )
+{
+    normalize_kernel(r, v);
 }
 
 vec2 mul_mat2_vec2 ( mat2 m, vec2 v)
@@ -83,13 +939,20 @@ vec2 mul_mat2_vec2 ( mat2 m, vec2 v)
 
 vec4 mul_mat4_vec4 ( mat4 m, vec4 v )
 {
-    return (vec4)
-    {
-        .x = m.a* v.x + m.b * v.y + m.c * v.z + m.d * v.w,
-        .y = m.e* v.x + m.f * v.y + m.g * v.z + m.h * v.w,
-        .z = m.i* v.x + m.j * v.y + m.k * v.z + m.l * v.w,
-        .w = m.m* v.x + m.n * v.y + m.o * v.z + m.p * v.w
-    };
+
+    // Initialized data
+    vec4 ret;
+
+    // Multiply
+    mul_mat4_vec4_kernel(&ret, &m, &v);
+
+    // Success
+    return ret;
+}
+
+void mul_mat4_vec4_p ( vec4 *r, const mat4 *m, const vec4 *v )
+{
+    mul_mat4_vec4_kernel(r, m, v);
 }
 
 mat2 mul_mat2_mat2 ( mat2 m, mat2 n )
@@ -103,13 +966,35 @@ mat2 mul_mat2_mat2 ( mat2 m, mat2 n )
 
 mat4 mul_mat4_mat4 ( mat4 m, mat4 n )
 {
-    return (mat4)
-    {
-        .a = (m.a * n.a + m.b * n.e + m.c * n.i + m.d * n.m), .b = (m.a * n.b + m.b * n.f + m.c * n.j + m.d * n.n), .c = (m.a * n.c + m.b * n.g + m.c * n.k + m.d * n.o), .d = (m.a * n.d + m.b * n.h + m.c * n.l + m.d * n.p),
-        .e = (m.e * n.a + m.f * n.e + m.g * n.i + m.h * n.m), .f = (m.e * n.b + m.f * n.f + m.g * n.j + m.h * n.n), .g = (m.e * n.c + m.f * n.g + m.g * n.k + m.h * n.o), .h = (m.e * n.d + m.f * n.h + m.g * n.l + m.h * n.p),
-        .i = (m.i * n.a + m.j * n.e + m.k * n.i + m.l * n.m), .j = (m.i * n.b + m.j * n.f + m.k * n.j + m.l * n.n), .k = (m.i * n.c + m.j * n.g + m.k * n.k + m.l * n.o), .l = (m.i * n.d + m.j * n.h + m.k * n.l + m.l * n.p),
-        .m = (m.m * n.a + m.n * n.e + m.o * n.i + m.p * n.m), .n = (m.m * n.b + m.n * n.f + m.o * n.j + m.p * n.n), .o = (m.m * n.c + m.n * n.g + m.o * n.k + m.p * n.o), .p = (m.m * n.d + m.n * n.h + m.o * n.l + m.p * n.p)
-    };
+
+    // Initialized data
+    mat4 ret;
+
+    // Multiply
+    mul_mat4_mat4_kernel(&ret, &m, &n);
+
+    // Success
+    return ret;
+}
+
+void mul_mat4_mat4_p ( mat4 *r, const mat4 *m, const mat4 *n )
+{
+    mul_mat4_mat4_kernel(r, m, n);
+}
+
+void mul_mat4_vec4_batch ( vec4 *r, const mat4 *m, const vec4 *v, size_t count )
+{
+    mul_mat4_vec4_batch_kernel(r, m, v, count);
+}
+
+void mul_mat4_vec4_batch_soa ( vec4_soa r, const mat4 *m, vec4_soa v, size_t count )
+{
+    mul_mat4_vec4_batch_soa_kernel(r, m, v, count);
+}
+
+void mul_mat4_mat4_batch ( mat4 *r, const mat4 *m, const mat4 *n, size_t count )
+{
+    mul_mat4_mat4_batch_kernel(r, m, n, count);
 }
 
 mat2 rcp_mat2( mat2 m )
@@ -132,6 +1017,58 @@ mat4 rcp_mat4( mat4 m )
     };
 }
 
+mat4 inverse_mat4 ( mat4 m )
+{
+
+    // Initialized data
+    mat4 ret;
+
+    // Invert
+    if ( inverse_mat4_kernel(&ret, &m) == false )
+        ret = (mat4) { NAN, NAN, NAN, NAN, NAN, NAN, NAN, NAN, NAN, NAN, NAN, NAN, NAN, NAN, NAN, NAN };
+
+    // Success
+    return ret;
+}
+
+bool inverse_mat4_p ( mat4 *r, const mat4 *m )
+{
+    return inverse_mat4_kernel(r, m);
+}
+
+mat4 affine_inverse_mat4 ( mat4 m )
+{
+
+    // Initialized data
+    mat4 ret;
+
+    // Invert
+    affine_inverse_mat4_kernel(&ret, &m);
+
+    // Success
+    return ret;
+}
+
+void affine_inverse_mat4_p ( mat4 *r, const mat4 *m )
+{
+    affine_inverse_mat4_kernel(r, m);
+}
+
+void inverse_mat4_batch ( mat4 *r, const mat4 *m, size_t count )
+{
+    inverse_mat4_batch_kernel(r, m, count);
+}
+
+void affine_inverse_mat4_batch ( mat4 *r, const mat4 *m, size_t count )
+{
+    affine_inverse_mat4_batch_kernel(r, m, count);
+}
+
+void normal_mat4_batch ( mat4 *r, const mat4 *m, size_t count )
+{
+    normal_mat4_batch_kernel(r, m, count);
+}
+
 mat2 identity_mat2()
 {
     return (mat2)
@@ -188,4 +1125,138 @@ mat4 rotation_mat4_from_vec3 ( vec3 rotation )
 mat4 model_mat4_from_vec3 ( vec3 location, vec3 rotation, vec3 scale )
 {
     return mul_mat4_mat4(mul_mat4_mat4(scale_mat4(scale), translation_mat4(location)), rotation_mat4_from_vec3(rotation));
-}
\ No newline at end of file
+}
+
+static bool linear_backend_supported ( linear_backend_t backend )
+{
+    switch ( backend )
+    {
+        case linear_backend_scalar:
+            return true;
+
+        #ifdef G10_LINEAR_X86
+            case linear_backend_sse41:
+                return SDL_HasSSE41();
+
+            case linear_backend_avx2:
+                return SDL_HasAVX2() && cpu_has_fma();
+        #endif
+
+        #ifdef G10_LINEAR_NEON
+            case linear_backend_neon:
+                return SDL_HasNEON();
+        #endif
+
+        default:
+            return false;
+    }
+}
+
+int set_linear_backend ( linear_backend_t backend )
+{
+
+    // External functions
+    extern void set_quaternion_backend ( linear_backend_t backend );
+
+    // Check for support
+    if ( linear_backend_supported(backend) == false ) goto unsupported_backend;
+
+    // Default to scalar kernels
+    normalize_kernel                 = normalize_scalar;
+    mul_mat4_vec4_kernel             = mul_mat4_vec4_scalar;
+    mul_mat4_mat4_kernel             = mul_mat4_mat4_scalar;
+    mul_mat4_vec4_batch_kernel       = mul_mat4_vec4_batch_scalar;
+    mul_mat4_vec4_batch_soa_kernel   = mul_mat4_vec4_batch_soa_scalar;
+    mul_mat4_mat4_batch_kernel       = mul_mat4_mat4_batch_scalar;
+    inverse_mat4_kernel              = inverse_mat4_scalar;
+    affine_inverse_mat4_kernel       = affine_inverse_mat4_scalar;
+    inverse_mat4_batch_kernel        = inverse_mat4_batch_scalar;
+    affine_inverse_mat4_batch_kernel = affine_inverse_mat4_batch_scalar;
+    normal_mat4_batch_kernel         = normal_mat4_batch_scalar;
+
+    #ifdef G10_LINEAR_X86
+
+        // SSE4.1
+        if ( backend == linear_backend_sse41 || backend == linear_backend_avx2 )
+        {
+            normalize_kernel                 = normalize_sse41;
+            mul_mat4_vec4_kernel             = mul_mat4_vec4_sse41;
+            mul_mat4_mat4_kernel             = mul_mat4_mat4_sse41;
+            mul_mat4_vec4_batch_kernel       = mul_mat4_vec4_batch_sse41;
+            mul_mat4_vec4_batch_soa_kernel   = mul_mat4_vec4_batch_soa_sse41;
+            mul_mat4_mat4_batch_kernel       = mul_mat4_mat4_batch_sse41;
+            inverse_mat4_kernel              = inverse_mat4_sse41;
+            affine_inverse_mat4_kernel       = affine_inverse_mat4_sse41;
+            inverse_mat4_batch_kernel        = inverse_mat4_batch_sse41;
+            affine_inverse_mat4_batch_kernel = affine_inverse_mat4_batch_sse41;
+            normal_mat4_batch_kernel         = normal_mat4_batch_sse41;
+        }
+
+        // AVX2 and FMA
+        if ( backend == linear_backend_avx2 )
+        {
+            mul_mat4_vec4_kernel           = mul_mat4_vec4_avx2;
+            mul_mat4_mat4_kernel           = mul_mat4_mat4_avx2;
+            mul_mat4_vec4_batch_kernel     = mul_mat4_vec4_batch_avx2;
+            mul_mat4_vec4_batch_soa_kernel = mul_mat4_vec4_batch_soa_avx2;
+            mul_mat4_mat4_batch_kernel     = mul_mat4_mat4_batch_avx2;
+        }
+    #endif
+
+    #ifdef G10_LINEAR_NEON
+
+        // NEON
+        if ( backend == linear_backend_neon )
+        {
+            normalize_kernel                 = normalize_neon;
+            mul_mat4_vec4_kernel             = mul_mat4_vec4_neon;
+            mul_mat4_mat4_kernel             = mul_mat4_mat4_neon;
+            mul_mat4_vec4_batch_kernel       = mul_mat4_vec4_batch_neon;
+            mul_mat4_vec4_batch_soa_kernel   = mul_mat4_vec4_batch_soa_neon;
+            mul_mat4_mat4_batch_kernel       = mul_mat4_mat4_batch_neon;
+            affine_inverse_mat4_kernel       = affine_inverse_mat4_neon;
+            affine_inverse_mat4_batch_kernel = affine_inverse_mat4_batch_neon;
+            normal_mat4_batch_kernel         = normal_mat4_batch_neon;
+        }
+    #endif
+
+    // Quaternions use the same instruction set
+    set_quaternion_backend(backend);
+
+    linear_backend = backend;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // G10 errors
+        {
+            unsupported_backend:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Linear] Backend %d is not supported by this CPU in call to function \"%s\"\n", (int)backend, __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+linear_backend_t get_linear_backend ( void )
+{
+    return linear_backend;
+}
+
+void init_linear ( void )
+{
+
+    // Use the widest instruction set the CPU has
+    if      ( linear_backend_supported(linear_backend_neon) )  set_linear_backend(linear_backend_neon);
+    else if ( linear_backend_supported(linear_backend_avx2) )  set_linear_backend(linear_backend_avx2);
+    else if ( linear_backend_supported(linear_backend_sse41) ) set_linear_backend(linear_backend_sse41);
+    else                                                       set_linear_backend(linear_backend_scalar);
+
+    return;
+}
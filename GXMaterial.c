@@ -24,6 +24,9 @@ int create_material ( GXMaterial_t **pp_material )
     // Error check
     if ( p_material == (void *) 0 ) goto no_mem;
 
+    // Count the material
+    G10_STAT_ADD(stat_materials, 1);
+
     *pp_material = p_material;
 
     // Success
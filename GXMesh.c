@@ -0,0 +1,2395 @@
+// Allocations made here are counted against the renderer
+#define G10_ALLOC_TAG alloc_tag_renderer
+
+#include <G10/GXMesh.h>
+#include <G10/GXPLY.h>
+#include <G10/GXQBVH.h>
+
+#include <stdbool.h>
+#include <math.h>
+
+// Marks an empty slot, or a vertex that has not been seen
+#define MESH_NONE 0xFFFFFFFF
+
+// Borders weigh more than faces, so the outline of an open mesh holds its shape
+#define MESH_BORDER_WEIGHT 10.0
+
+// What a vertex may collapse onto
+#define MESH_VERTEX_FREE   0
+#define MESH_VERTEX_BORDER 1
+#define MESH_VERTEX_LOCKED 2
+
+// A cluster of triangles, and how much it faces out of the mesh
+struct mesh_cluster_s
+{
+    float  facing;
+    u32    index;
+};
+
+// The sum of the squared distances to a set of planes, weighted by area
+struct mesh_quadric_s
+{
+    double a00, a11, a22,
+           a10, a20, a21,
+           b0, b1, b2,
+           c,
+           w;
+};
+
+// Moving one vertex onto another
+struct mesh_collapse_s
+{
+    double cost;
+    u32    from,
+           to;
+};
+
+// FNV-1a over the bytes of a vertex
+static u32 hash_vertex ( const u8 *p_vertex, size_t size )
+{
+
+    // Initialized data
+    u32 h = 2166136261u;
+
+    for (size_t i = 0; i < size; i++)
+        h = ( h ^ p_vertex[i] ) * 16777619u;
+
+    return h;
+}
+
+// Transform a vertex, unless the FIFO cache still holds it. Returns 1 on a miss
+static u32 touch_vertex ( u32 *timestamps, u32 *p_time, u32 v, size_t cache_size )
+{
+
+    // Hit
+    if ( *p_time - timestamps[v] <= cache_size ) return 0;
+
+    // Miss
+    timestamps[v] = (*p_time)++;
+
+    return 1;
+}
+
+// The position of a vertex
+static const float *mesh_position ( GXMesh_t *p_mesh, u32 v )
+{
+    return (const float *) ( (const u8 *) p_mesh->vertices + v * p_mesh->vertex_stride + p_mesh->position_offset );
+}
+
+// The center of the box around the vertices, and the distance to the farthest vertex
+static float bound_mesh ( GXMesh_t *p_mesh, float *center )
+{
+
+    // Initialized data
+    float lo[3] = {  INFINITY,  INFINITY,  INFINITY },
+          hi[3] = { -INFINITY, -INFINITY, -INFINITY },
+          r2    = 0;
+
+    center[0] = center[1] = center[2] = 0;
+
+    // No vertices
+    if ( p_mesh->vertex_count == 0 ) return 0;
+
+    for (size_t v = 0; v < p_mesh->vertex_count; v++)
+    {
+
+        // Initialized data
+        const float *p = mesh_position(p_mesh, (u32) v);
+
+        for (size_t j = 0; j < 3; j++)
+            lo[j] = ( p[j] < lo[j] ) ? p[j] : lo[j],
+            hi[j] = ( p[j] > hi[j] ) ? p[j] : hi[j];
+    }
+
+    for (size_t j = 0; j < 3; j++)
+        center[j] = ( lo[j] + hi[j] ) / 2.f;
+
+    for (size_t v = 0; v < p_mesh->vertex_count; v++)
+    {
+
+        // Initialized data
+        const float *p = mesh_position(p_mesh, (u32) v);
+        float        d = ( p[0] - center[0] ) * ( p[0] - center[0] ) +
+                         ( p[1] - center[1] ) * ( p[1] - center[1] ) +
+                         ( p[2] - center[2] ) * ( p[2] - center[2] );
+
+        if ( d > r2 ) r2 = d;
+    }
+
+    return sqrtf(r2);
+}
+
+// Clusters that face out of the mesh first, and ties in the order they were made
+static int compare_clusters ( const void *a, const void *b )
+{
+
+    // Initialized data
+    const struct mesh_cluster_s *p_a = a,
+                                *p_b = b;
+
+    if ( p_a->facing > p_b->facing ) return -1;
+    if ( p_a->facing < p_b->facing ) return  1;
+
+    return ( p_a->index > p_b->index ) - ( p_a->index < p_b->index );
+}
+
+// Add a plane, n . p + d = 0, to a quadric
+static void add_plane_quadric ( struct mesh_quadric_s *p_q, const double *n, double d, double w )
+{
+    p_q->a00 += w * n[0] * n[0], p_q->a11 += w * n[1] * n[1], p_q->a22 += w * n[2] * n[2],
+    p_q->a10 += w * n[1] * n[0], p_q->a20 += w * n[2] * n[0], p_q->a21 += w * n[2] * n[1],
+    p_q->b0  += w * n[0] * d,    p_q->b1  += w * n[1] * d,    p_q->b2  += w * n[2] * d,
+    p_q->c   += w * d * d,
+    p_q->w   += w;
+}
+
+// Add one quadric to another
+static void add_quadric ( struct mesh_quadric_s *p_q, const struct mesh_quadric_s *p_r )
+{
+    p_q->a00 += p_r->a00, p_q->a11 += p_r->a11, p_q->a22 += p_r->a22,
+    p_q->a10 += p_r->a10, p_q->a20 += p_r->a20, p_q->a21 += p_r->a21,
+    p_q->b0  += p_r->b0,  p_q->b1  += p_r->b1,  p_q->b2  += p_r->b2,
+    p_q->c   += p_r->c,
+    p_q->w   += p_r->w;
+}
+
+// The mean squared distance from a point to the planes of a quadric
+static double quadric_error ( const struct mesh_quadric_s *p_q, const float *p )
+{
+
+    // Initialized data
+    double x  = p[0],
+           y  = p[1],
+           z  = p[2],
+           rx = p_q->a00 * x + p_q->a10 * y + p_q->a20 * z + p_q->b0,
+           ry = p_q->a10 * x + p_q->a11 * y + p_q->a21 * z + p_q->b1,
+           rz = p_q->a20 * x + p_q->a21 * y + p_q->a22 * z + p_q->b2,
+           e  = rx * x + ry * y + rz * z + p_q->b0 * x + p_q->b1 * y + p_q->b2 * z + p_q->c;
+
+    return fabs(e) / ( ( p_q->w > 0 ) ? p_q->w : 1 );
+}
+
+// The normal of a triangle, scaled by twice its area
+static void triangle_normal ( const float *a, const float *b, const float *c, double *n )
+{
+
+    // Initialized data
+    double e0[3] = { b[0] - a[0], b[1] - a[1], b[2] - a[2] },
+           e1[3] = { c[0] - a[0], c[1] - a[1], c[2] - a[2] };
+
+    n[0] = e0[1] * e1[2] - e0[2] * e1[1],
+    n[1] = e0[2] * e1[0] - e0[0] * e1[2],
+    n[2] = e0[0] * e1[1] - e0[1] * e1[0];
+}
+
+// The unit normal of a meshlet triangle. Returns false if the triangle has no area
+static bool meshlet_triangle_normal ( GXMesh_t *p_mesh, const u32 *vertices, const u8 *triangle, double *n )
+{
+
+    // Initialized data
+    double length = 0;
+
+    triangle_normal(mesh_position(p_mesh, vertices[triangle[0]]), mesh_position(p_mesh, vertices[triangle[1]]), mesh_position(p_mesh, vertices[triangle[2]]), n);
+
+    length = sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+
+    // Error check
+    if ( length == 0 ) return false;
+
+    n[0] /= length,
+    n[1] /= length,
+    n[2] /= length;
+
+    // Success
+    return true;
+}
+
+// Bound the triangles of a meshlet with a sphere, and a cone that holds their normals
+static void bound_meshlet ( GXMesh_t *p_mesh, GXMeshlet_t *p_meshlet )
+{
+
+    // Initialized data
+    const u32 *vertices  = p_mesh->meshlet_vertices  + p_meshlet->vertex_offset;
+    const u8  *triangles = p_mesh->meshlet_triangles + p_meshlet->triangle_offset * 3;
+    float      lo[3]     = {  INFINITY,  INFINITY,  INFINITY },
+               hi[3]     = { -INFINITY, -INFINITY, -INFINITY },
+               axis[3]   = { 0 },
+               r2        = 0,
+               min_dot   = 1,
+               max_t     = 0,
+               length    = 0;
+    size_t     normals   = 0;
+
+    // Bounding sphere, around the center of the box
+    for (u32 i = 0; i < p_meshlet->vertex_count; i++)
+    {
+
+        // Initialized data
+        const float *p = mesh_position(p_mesh, vertices[i]);
+
+        for (size_t j = 0; j < 3; j++)
+            lo[j] = ( p[j] < lo[j] ) ? p[j] : lo[j],
+            hi[j] = ( p[j] > hi[j] ) ? p[j] : hi[j];
+    }
+
+    for (size_t j = 0; j < 3; j++)
+        p_meshlet->center[j] = ( lo[j] + hi[j] ) / 2.f;
+
+    for (u32 i = 0; i < p_meshlet->vertex_count; i++)
+    {
+
+        // Initialized data
+        const float *p = mesh_position(p_mesh, vertices[i]);
+        float        d = ( p[0] - p_meshlet->center[0] ) * ( p[0] - p_meshlet->center[0] ) +
+                         ( p[1] - p_meshlet->center[1] ) * ( p[1] - p_meshlet->center[1] ) +
+                         ( p[2] - p_meshlet->center[2] ) * ( p[2] - p_meshlet->center[2] );
+
+        if ( d > r2 ) r2 = d;
+    }
+
+    p_meshlet->radius = sqrtf(r2);
+
+    // A cone that is never culled
+    p_meshlet->cone_axis[0] = p_meshlet->cone_axis[1] = p_meshlet->cone_axis[2] = 0,
+    p_meshlet->cone_apex[0] = p_meshlet->center[0],
+    p_meshlet->cone_apex[1] = p_meshlet->center[1],
+    p_meshlet->cone_apex[2] = p_meshlet->center[2],
+    p_meshlet->cone_cutoff  = 1,
+    p_meshlet->padding      = 0;
+
+    // Average the normals of the triangles
+    for (u32 t = 0; t < p_meshlet->triangle_count; t++)
+    {
+
+        // Initialized data
+        double n[3] = { 0 };
+
+        // Skip triangles with no area
+        if ( meshlet_triangle_normal(p_mesh, vertices, triangles + t * 3, n) == false ) continue;
+
+        for (size_t j = 0; j < 3; j++)
+            axis[j] += (float) n[j];
+
+        normals++;
+    }
+
+    length = sqrtf(axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2]);
+
+    // Error check
+    if ( normals == 0 || length == 0 ) return;
+
+    for (size_t j = 0; j < 3; j++)
+        axis[j] /= length;
+
+    // Find the widest normal, and how far back the apex must sit to see every triangle edge on
+    for (u32 t = 0; t < p_meshlet->triangle_count; t++)
+    {
+
+        // Initialized data
+        const float *p0  = mesh_position(p_mesh, vertices[triangles[t * 3 + 0]]);
+        double       n[3] = { 0 };
+        float        dp   = 0,
+                     t_n  = 0;
+
+        // Skip triangles with no area
+        if ( meshlet_triangle_normal(p_mesh, vertices, triangles + t * 3, n) == false ) continue;
+
+        dp = (float) ( n[0] * axis[0] + n[1] * axis[1] + n[2] * axis[2] );
+
+        if ( dp < min_dot ) min_dot = dp;
+
+        // Error check
+        if ( dp <= 0 ) continue;
+
+        t_n = (float) ( ( p_meshlet->center[0] - p0[0] ) * n[0] + ( p_meshlet->center[1] - p0[1] ) * n[1] + ( p_meshlet->center[2] - p0[2] ) * n[2] ) / dp;
+
+        if ( t_n > max_t ) max_t = t_n;
+    }
+
+    // The normals spread too far to ever face away together
+    if ( min_dot <= 0.1f ) return;
+
+    // Success
+    for (size_t j = 0; j < 3; j++)
+        p_meshlet->cone_axis[j] = axis[j],
+        p_meshlet->cone_apex[j] = p_meshlet->center[j] - axis[j] * max_t;
+
+    p_meshlet->cone_cutoff = sqrtf(1.f - min_dot * min_dot);
+}
+
+// List the triangles around each vertex
+static void build_adjacency ( const u32 *indices, size_t index_count, size_t vertex_count, u32 *offsets, u32 *adjacency, u32 *counts )
+{
+    memset(counts, 0, vertex_count * sizeof(u32));
+
+    for (size_t i = 0; i < index_count; i++)
+        counts[indices[i]]++;
+
+    offsets[0] = 0;
+
+    for (size_t v = 0; v < vertex_count; v++)
+        offsets[v + 1] = offsets[v] + counts[v],
+        counts[v]      = 0;
+
+    for (size_t i = 0; i < index_count; i++)
+        adjacency[offsets[indices[i]] + counts[indices[i]]++] = (u32) ( i / 3 );
+}
+
+// Is there a triangle with the edge from a to b
+static bool has_edge ( const u32 *indices, const u32 *offsets, const u32 *adjacency, u32 a, u32 b )
+{
+    for (u32 i = offsets[a]; i < offsets[a + 1]; i++)
+        for (size_t k = 0; k < 3; k++)
+            if ( indices[adjacency[i] * 3 + k] == a && indices[adjacency[i] * 3 + ( k + 1 ) % 3] == b )
+                return true;
+
+    return false;
+}
+
+// Cheapest collapses first, and ties in the order of the vertices
+static int compare_collapses ( const void *a, const void *b )
+{
+
+    // Initialized data
+    const struct mesh_collapse_s *p_a = a,
+                                 *p_b = b;
+
+    if ( p_a->cost < p_b->cost ) return -1;
+    if ( p_a->cost > p_b->cost ) return  1;
+    if ( p_a->from != p_b->from ) return ( p_a->from < p_b->from ) ? -1 : 1;
+
+    return ( p_a->to > p_b->to ) - ( p_a->to < p_b->to );
+}
+
+// The next fanning vertex of Tipsify. The candidate that stays in the cache after its fan is drawn, or the one longest in it
+static u32 next_fanning_vertex ( u32 *live, u32 *cache_time, u32 time, size_t cache_size, u32 *candidates, size_t candidate_count, u32 *dead_ends, size_t *p_dead_end_count, u32 *p_cursor, size_t vertex_count )
+{
+
+    // Initialized data
+    u32  best     = MESH_NONE;
+    long priority = -1;
+
+    for (size_t i = 0; i < candidate_count; i++)
+    {
+
+        // Initialized data
+        u32  v = candidates[i];
+        long p = 0;
+
+        if ( live[v] == 0 ) continue;
+
+        if ( time - cache_time[v] + 2 * live[v] <= cache_size )
+            p = (long) ( time - cache_time[v] );
+
+        if ( p > priority )
+            priority = p,
+            best     = v;
+    }
+
+    if ( best != MESH_NONE ) return best;
+
+    // Back up to a vertex that was used recently
+    while ( *p_dead_end_count )
+    {
+
+        // Initialized data
+        u32 v = dead_ends[--(*p_dead_end_count)];
+
+        if ( live[v] ) return v;
+    }
+
+    // Or take the next vertex in order
+    while ( *p_cursor < vertex_count )
+    {
+        if ( live[*p_cursor] ) return *p_cursor;
+
+        (*p_cursor)++;
+    }
+
+    // Every triangle is drawn
+    return MESH_NONE;
+}
+
+int create_mesh ( GXMesh_t **pp_mesh )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( pp_mesh == (void *) 0 ) goto no_mesh;
+    #endif
+
+    // Initialized data
+    GXMesh_t *p_mesh = calloc(1, sizeof(GXMesh_t));
+
+    // Error check
+    if ( p_mesh == (void *) 0 ) goto no_mem;
+
+    // Return
+    *pp_mesh = p_mesh;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_mesh:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Mesh] Null pointer provided for parameter \"pp_mesh\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    g_print_error("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int load_mesh_as_ply ( GXMesh_t **pp_mesh, const char *path )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( pp_mesh == (void *) 0 ) goto no_mesh;
+        if ( path    == (void *) 0 ) goto no_path;
+    #endif
+
+    // Initialized data
+    GXPLY_t        *p_ply         = 0;
+    GXPLYElement_t *p_element     = 0;
+    GXMesh_t       *p_mesh        = 0;
+    const void     *vertices      = 0;
+    const u32      *indices       = 0;
+    size_t          vertex_stride = 0,
+                    vertex_count  = 0,
+                    index_count   = 0,
+                    x             = 0;
+
+    // Map the file
+    if ( map_ply(&p_ply, path) == 0 ) goto failed_to_map_ply;
+
+    p_element = get_ply_element(p_ply, "vertex");
+
+    // Error check
+    if ( p_element == (void *) 0 ) goto no_positions;
+
+    // Find x, y, and z
+    while ( x < p_element->property_count && strcmp(p_element->properties[x].name, "x") )
+        x++;
+
+    // Error check
+    if ( x + 2 >= p_element->property_count )               goto no_positions;
+    if ( strcmp(p_element->properties[x + 1].name, "y") )  goto no_positions;
+    if ( strcmp(p_element->properties[x + 2].name, "z") )  goto no_positions;
+
+    // Read the vertices and the faces
+    vertices = get_ply_vertices(p_ply, &vertex_stride, &vertex_count);
+    indices  = get_ply_indices(p_ply, &index_count);
+
+    // Error check
+    if ( vertices == (void *) 0 ) goto failed_to_read_ply;
+    if ( indices  == (void *) 0 ) goto failed_to_read_ply;
+    if ( index_count == 0 )       goto no_triangles;
+
+    // Allocate a mesh
+    if ( create_mesh(&p_mesh) == 0 ) goto failed_to_allocate_mesh;
+
+    p_mesh->vertices = G10_REALLOC(0, vertex_count * vertex_stride),
+    p_mesh->indices  = G10_REALLOC(0, index_count * sizeof(u32));
+
+    // Error check
+    if ( p_mesh->vertices == (void *) 0 ) goto no_mem;
+    if ( p_mesh->indices  == (void *) 0 ) goto no_mem;
+
+    // Copy the vertices out of the mapping. They may not be aligned there
+    memcpy(p_mesh->vertices, vertices, vertex_count * vertex_stride);
+    memcpy(p_mesh->indices, indices, index_count * sizeof(u32));
+
+    p_mesh->vertex_count    = vertex_count,
+    p_mesh->vertex_stride   = vertex_stride,
+    p_mesh->position_offset = x * sizeof(float),
+    p_mesh->index_count     = index_count;
+
+    // The whole mesh is the first level of detail
+    p_mesh->lods[0]   = (GXMeshLOD_t) { .first_index = 0, .index_count = (u32) index_count, .error = 0 },
+    p_mesh->lod_count = 1;
+
+    // Clean up
+    (void) unmap_ply(&p_ply);
+
+    // Return
+    *pp_mesh = p_mesh;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_mesh:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Mesh] Null pointer provided for parameter \"pp_mesh\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_path:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Mesh] Null pointer provided for parameter \"path\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // G10 errors
+        {
+            failed_to_map_ply:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Mesh] Failed to map PLY file \"%s\" in call to function \"%s\"\n", path, __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_positions:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Mesh] The vertices of \"%s\" have no x, y, and z properties in call to function \"%s\"\n", path, __FUNCTION__);
+                #endif
+
+                // Clean up
+                (void) unmap_ply(&p_ply);
+
+                // Error
+                return 0;
+
+            failed_to_read_ply:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Mesh] Failed to read the vertices and faces of \"%s\" in call to function \"%s\"\n", path, __FUNCTION__);
+                #endif
+
+                // Clean up
+                (void) unmap_ply(&p_ply);
+
+                // Error
+                return 0;
+
+            no_triangles:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Mesh] \"%s\" has no faces in call to function \"%s\"\n", path, __FUNCTION__);
+                #endif
+
+                // Clean up
+                (void) unmap_ply(&p_ply);
+
+                // Error
+                return 0;
+
+            failed_to_allocate_mesh:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Mesh] Failed to allocate mesh in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Clean up
+                (void) unmap_ply(&p_ply);
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    g_print_error("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Clean up
+                (void) destroy_mesh(&p_mesh);
+                (void) unmap_ply(&p_ply);
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int load_mesh_part ( GXPart_t *p_part, const char *path )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( p_part == (void *) 0 ) goto no_part;
+        if ( path   == (void *) 0 ) goto no_path;
+    #endif
+
+    // Initialized data
+    GXMeshHeader_t  header     = { 0 };
+    GXMeshLOD_t     lod        = { 0 };
+    GXMeshlet_t     meshlet    = { 0 };
+    size_t          len        = g_load_file(path, 0, true),
+                    lods       = 0,
+                    vertices   = 0,
+                    indices    = 0,
+                    meshlets   = 0;
+    u8             *data       = 0,
+                   *p_meshlets = 0;
+
+    // Error check
+    if ( len < sizeof(GXMeshHeader_t) ) goto failed_to_load_file;
+
+    data = G10_REALLOC(0, len);
+
+    // Error check
+    if ( data == (void *) 0 ) goto no_mem;
+
+    // Load the file
+    if ( g_load_file(path, data, true) == 0 ) goto failed_to_load_file;
+
+    memcpy(&header, data, sizeof(GXMeshHeader_t));
+
+    // Check the header
+    if ( header.magic   != MESH_MAGIC )                        goto not_a_mesh;
+    if ( header.version != MESH_VERSION )                      goto wrong_version;
+    if ( header.index_size != 2 && header.index_size != 4 )    goto not_a_mesh;
+    if ( header.vertex_stride % sizeof(float) )                goto not_a_mesh;
+    if ( header.index_count % 3 )                              goto not_a_mesh;
+    if ( header.lod_count == 0 )                               goto not_a_mesh;
+    if ( header.lod_count > PART_MAX_LODS )                    goto not_a_mesh;
+
+    lods       = (size_t) header.lod_count    * sizeof(GXMeshLOD_t),
+    vertices   = (size_t) header.vertex_count * header.vertex_stride,
+    indices    = (size_t) header.index_count  * header.index_size,
+    meshlets   = ( header.meshlet_count ) ? (size_t) header.meshlet_count * sizeof(GXMeshlet_t) + (size_t) header.meshlet_vertex_count * sizeof(u32) + ( (size_t) header.meshlet_triangle_count * 3 + 3 ) / 4 * 4 : 0,
+    p_meshlets = data + sizeof(GXMeshHeader_t) + lods + vertices + indices;
+
+    // Error check
+    if ( len != sizeof(GXMeshHeader_t) + lods + vertices + indices + meshlets ) goto not_a_mesh;
+
+    // Check each level of detail
+    for (size_t i = 0; i < header.lod_count; i++)
+    {
+        memcpy(&lod, data + sizeof(GXMeshHeader_t) + i * sizeof(GXMeshLOD_t), sizeof(GXMeshLOD_t));
+
+        if ( lod.index_count % 3 )                                           goto not_a_mesh;
+        if ( (size_t) lod.first_index + lod.index_count > header.index_count ) goto not_a_mesh;
+    }
+
+    // Check each meshlet
+    for (size_t i = 0; i < header.meshlet_count; i++)
+    {
+        memcpy(&meshlet, p_meshlets + i * sizeof(GXMeshlet_t), sizeof(GXMeshlet_t));
+
+        if ( meshlet.vertex_count > 256 )                                                               goto not_a_mesh;
+        if ( (size_t) meshlet.vertex_offset   + meshlet.vertex_count   > header.meshlet_vertex_count )   goto not_a_mesh;
+        if ( (size_t) meshlet.triangle_offset + meshlet.triangle_count > header.meshlet_triangle_count ) goto not_a_mesh;
+    }
+
+    // Check each meshlet vertex
+    for (size_t i = 0; i < header.meshlet_vertex_count; i++)
+    {
+
+        // Initialized data
+        u32 v = 0;
+
+        memcpy(&v, p_meshlets + header.meshlet_count * sizeof(GXMeshlet_t) + i * sizeof(u32), sizeof(u32));
+
+        if ( v >= header.vertex_count ) goto not_a_mesh;
+    }
+
+    // Upload the vertices and the indices as they are in the file
+    if ( upload_part(p_part, data + sizeof(GXMeshHeader_t) + lods, header.vertex_stride, header.vertex_count, data + sizeof(GXMeshHeader_t) + lods + vertices, header.index_size, header.index_count) == 0 ) goto failed_to_upload_part;
+
+    // Levels of detail
+    for (size_t i = 0; i < header.lod_count; i++)
+    {
+        memcpy(&lod, data + sizeof(GXMeshHeader_t) + i * sizeof(GXMeshLOD_t), sizeof(GXMeshLOD_t));
+
+        p_part->lods[i].first_index = lod.first_index,
+        p_part->lods[i].index_count = lod.index_count,
+        p_part->lods[i].error       = lod.error;
+    }
+
+    p_part->lod_count = header.lod_count;
+
+    // Meshlets
+    if ( header.meshlet_count )
+        if ( upload_part_meshlets(p_part,
+            (const GXMeshlet_t *) p_meshlets, header.meshlet_count,
+            (const u32 *) ( p_meshlets + header.meshlet_count * sizeof(GXMeshlet_t) ), header.meshlet_vertex_count,
+            p_meshlets + header.meshlet_count * sizeof(GXMeshlet_t) + header.meshlet_vertex_count * sizeof(u32), header.meshlet_triangle_count
+        ) == 0 ) goto failed_to_upload_part;
+
+    // Bounding sphere
+    p_part->center = (vec3) { .x = header.center[0], .y = header.center[1], .z = header.center[2], .w = 0 },
+    p_part->radius = header.radius;
+
+    // Clean up
+    G10_FREE(data);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_part:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Mesh] Null pointer provided for parameter \"p_part\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_path:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Mesh] Null pointer provided for parameter \"path\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // G10 errors
+        {
+            failed_to_load_file:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Mesh] Failed to load file \"%s\" in call to function \"%s\"\n", path, __FUNCTION__);
+                #endif
+
+                // Clean up
+                G10_FREE(data);
+
+                // Error
+                return 0;
+
+            not_a_mesh:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Mesh] \"%s\" is not a G10 mesh file in call to function \"%s\"\n", path, __FUNCTION__);
+                #endif
+
+                // Clean up
+                G10_FREE(data);
+
+                // Error
+                return 0;
+
+            wrong_version:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Mesh] \"%s\" is version %u, expected version %u in call to function \"%s\"\n", path, header.version, MESH_VERSION, __FUNCTION__);
+                #endif
+
+                // Clean up
+                G10_FREE(data);
+
+                // Error
+                return 0;
+
+            failed_to_upload_part:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Mesh] Failed to upload \"%s\" in call to function \"%s\"\n", path, __FUNCTION__);
+                #endif
+
+                // Clean up
+                G10_FREE(data);
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    g_print_error("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int weld_mesh ( GXMesh_t *p_mesh )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( p_mesh == (void *) 0 ) goto no_mesh;
+    #endif
+
+    // Initialized data
+    u8     *vertices     = (u8 *) p_mesh->vertices;
+    size_t  stride       = p_mesh->vertex_stride,
+            table_size   = 1,
+            unique_count = 0,
+            index_count  = 0;
+    u32    *table        = 0,
+           *remap        = 0;
+
+    // Open addressing, at most half full
+    while ( table_size < p_mesh->vertex_count * 2 )
+        table_size <<= 1;
+
+    table = G10_REALLOC(0, table_size * sizeof(u32)),
+    remap = G10_REALLOC(0, ( p_mesh->vertex_count + 1 ) * sizeof(u32));
+
+    // Error check
+    if ( table == (void *) 0 ) goto no_mem;
+    if ( remap == (void *) 0 ) goto no_mem;
+
+    memset(table, 0xFF, table_size * sizeof(u32));
+
+    // Move each vertex that hasn't been seen down to the next free slot. Vertices below the slot are never written again
+    for (size_t i = 0; i < p_mesh->vertex_count; i++)
+    {
+
+        // Initialized data
+        const u8 *p_vertex = vertices + i * stride;
+        size_t    slot     = hash_vertex(p_vertex, stride) & ( table_size - 1 );
+
+        // Find the vertex, or an empty slot
+        while ( table[slot] != MESH_NONE && memcmp(vertices + table[slot] * stride, p_vertex, stride) )
+            slot = ( slot + 1 ) & ( table_size - 1 );
+
+        // A new vertex
+        if ( table[slot] == MESH_NONE )
+        {
+            if ( unique_count != i )
+                memcpy(vertices + unique_count * stride, p_vertex, stride);
+
+            table[slot] = (u32) unique_count++;
+        }
+
+        remap[i] = table[slot];
+    }
+
+    // Rewrite the triangles of each level, and drop the ones that welded into lines or points
+    for (size_t l = 0; l < p_mesh->lod_count; l++)
+    {
+
+        // Initialized data
+        size_t first = p_mesh->lods[l].first_index,
+               end   = first + p_mesh->lods[l].index_count;
+
+        p_mesh->lods[l].first_index = (u32) index_count;
+
+        for (size_t i = first; i + 2 < end; i += 3)
+        {
+
+            // Initialized data
+            u32 a = remap[p_mesh->indices[i]],
+                b = remap[p_mesh->indices[i + 1]],
+                c = remap[p_mesh->indices[i + 2]];
+
+            if ( a == b || b == c || a == c ) continue;
+
+            p_mesh->indices[index_count++] = a,
+            p_mesh->indices[index_count++] = b,
+            p_mesh->indices[index_count++] = c;
+        }
+
+        p_mesh->lods[l].index_count = (u32) ( index_count - p_mesh->lods[l].first_index );
+    }
+
+    p_mesh->vertex_count = unique_count,
+    p_mesh->index_count  = index_count;
+
+    // Clean up
+    G10_FREE(table);
+    G10_FREE(remap);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_mesh:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Mesh] Null pointer provided for parameter \"p_mesh\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    g_print_error("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Clean up
+                G10_FREE(table);
+                G10_FREE(remap);
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int simplify_mesh ( GXMesh_t *p_mesh, float target_error, size_t target_index_count )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( p_mesh            == (void *) 0 )    goto no_mesh;
+        if ( p_mesh->lod_count == 0 )             goto no_levels;
+        if ( p_mesh->lod_count >= MESH_MAX_LODS ) goto too_many_levels;
+    #endif
+
+    // Initialized data
+    GXMeshLOD_t            *p_last         = &p_mesh->lods[p_mesh->lod_count - 1];
+    size_t                  vertex_count   = p_mesh->vertex_count,
+                            index_count    = p_last->index_count,
+                            table_size     = 1;
+    float                   center[3]      = { 0 },
+                            budget         = target_error * bound_mesh(p_mesh, center) - p_last->error;
+    double                  limit          = ( budget > 0 ) ? (double) budget * budget : 0,
+                            error          = 0;
+    u32                    *indices        = G10_REALLOC(0, ( index_count + 1 ) * sizeof(u32)),
+                           *offsets        = G10_REALLOC(0, ( vertex_count + 1 ) * sizeof(u32)),
+                           *adjacency      = G10_REALLOC(0, ( index_count + 1 ) * sizeof(u32)),
+                           *counts         = G10_REALLOC(0, ( vertex_count + 1 ) * sizeof(u32)),
+                           *border_next    = G10_REALLOC(0, ( vertex_count + 1 ) * sizeof(u32)),
+                           *border_prev    = G10_REALLOC(0, ( vertex_count + 1 ) * sizeof(u32)),
+                           *table          = 0,
+                           *grown          = 0;
+    u8                     *kinds          = G10_REALLOC(0, vertex_count + 1),
+                           *touched        = G10_REALLOC(0, vertex_count + 1);
+    struct mesh_quadric_s  *quadrics       = G10_REALLOC(0, ( vertex_count + 1 ) * sizeof(struct mesh_quadric_s));
+    struct mesh_collapse_s *collapses      = G10_REALLOC(0, ( index_count * 2 + 1 ) * sizeof(struct mesh_collapse_s));
+
+    // Open addressing, at most half full
+    while ( table_size < vertex_count * 2 )
+        table_size <<= 1;
+
+    table = G10_REALLOC(0, table_size * sizeof(u32));
+
+    // Error check
+    if ( ! ( indices && offsets && adjacency && counts && border_next && border_prev && table && kinds && touched && quadrics && collapses ) ) goto no_mem;
+
+    // Simplify a copy of the last level
+    memcpy(indices, p_mesh->indices + p_last->first_index, index_count * sizeof(u32));
+    memset(kinds, MESH_VERTEX_FREE, vertex_count);
+    memset(quadrics, 0, vertex_count * sizeof(struct mesh_quadric_s));
+    memset(border_next, 0xFF, vertex_count * sizeof(u32));
+    memset(border_prev, 0xFF, vertex_count * sizeof(u32));
+    memset(table, 0xFF, table_size * sizeof(u32));
+
+    // Lock vertices that share a position with another vertex. Moving one would tear the seam open
+    for (size_t v = 0; v < vertex_count; v++)
+    {
+
+        // Initialized data
+        const float *p    = mesh_position(p_mesh, (u32) v);
+        size_t       slot = hash_vertex((const u8 *) p, 3 * sizeof(float)) & ( table_size - 1 );
+
+        while ( table[slot] != MESH_NONE && memcmp(mesh_position(p_mesh, table[slot]), p, 3 * sizeof(float)) )
+            slot = ( slot + 1 ) & ( table_size - 1 );
+
+        if ( table[slot] == MESH_NONE )
+            table[slot] = (u32) v;
+        else
+            kinds[v]           = MESH_VERTEX_LOCKED,
+            kinds[table[slot]] = MESH_VERTEX_LOCKED;
+    }
+
+    build_adjacency(indices, index_count, vertex_count, offsets, adjacency, counts);
+
+    // Add the plane of each triangle to its vertices, and find the borders
+    for (size_t t = 0; t < index_count / 3; t++)
+    {
+
+        // Initialized data
+        double n[3]   = { 0 },
+               length = 0;
+
+        triangle_normal(mesh_position(p_mesh, indices[t * 3]), mesh_position(p_mesh, indices[t * 3 + 1]), mesh_position(p_mesh, indices[t * 3 + 2]), n);
+
+        length = sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+
+        if ( length > 0 )
+        {
+
+            // Initialized data
+            const float *p0 = mesh_position(p_mesh, indices[t * 3]);
+            double       d  = 0;
+
+            n[0] /= length, n[1] /= length, n[2] /= length;
+
+            d = -( n[0] * p0[0] + n[1] * p0[1] + n[2] * p0[2] );
+
+            for (size_t k = 0; k < 3; k++)
+                add_plane_quadric(&quadrics[indices[t * 3 + k]], n, d, length / 2);
+        }
+
+        // An edge no other triangle walks back along is on a border
+        for (size_t k = 0; k < 3; k++)
+        {
+
+            // Initialized data
+            u32          a  = indices[t * 3 + k],
+                         b  = indices[t * 3 + ( k + 1 ) % 3];
+            const float *pa = mesh_position(p_mesh, a),
+                        *pb = mesh_position(p_mesh, b);
+            double       e[3] = { pb[0] - pa[0], pb[1] - pa[1], pb[2] - pa[2] },
+                         m[3] = { e[1] * n[2] - e[2] * n[1], e[2] * n[0] - e[0] * n[2], e[0] * n[1] - e[1] * n[0] },
+                         s    = sqrt(m[0] * m[0] + m[1] * m[1] + m[2] * m[2]);
+
+            if ( has_edge(indices, offsets, adjacency, b, a) ) continue;
+
+            // A vertex on more than one border can't move along either
+            if ( border_next[a] != MESH_NONE && border_next[a] != b ) kinds[a] = MESH_VERTEX_LOCKED;
+            if ( border_prev[b] != MESH_NONE && border_prev[b] != a ) kinds[b] = MESH_VERTEX_LOCKED;
+
+            border_next[a] = b,
+            border_prev[b] = a;
+
+            if ( kinds[a] == MESH_VERTEX_FREE ) kinds[a] = MESH_VERTEX_BORDER;
+            if ( kinds[b] == MESH_VERTEX_FREE ) kinds[b] = MESH_VERTEX_BORDER;
+
+            // Hold the border in place with a plane through it, at a right angle to the triangle
+            if ( s > 0 )
+            {
+                m[0] /= s, m[1] /= s, m[2] /= s;
+
+                add_plane_quadric(&quadrics[a], m, -( m[0] * pa[0] + m[1] * pa[1] + m[2] * pa[2] ), ( e[0] * e[0] + e[1] * e[1] + e[2] * e[2] ) * MESH_BORDER_WEIGHT);
+                add_plane_quadric(&quadrics[b], m, -( m[0] * pa[0] + m[1] * pa[1] + m[2] * pa[2] ), ( e[0] * e[0] + e[1] * e[1] + e[2] * e[2] ) * MESH_BORDER_WEIGHT);
+            }
+        }
+    }
+
+    // Collapse edges in passes, until the error or the size is reached
+    while ( index_count > target_index_count && limit > 0 )
+    {
+
+        // Initialized data
+        size_t collapse_count = 0,
+               take           = 0,
+               applied        = 0,
+               live           = index_count,
+               kept           = 0;
+        bool   done           = false;
+
+        build_adjacency(indices, index_count, vertex_count, offsets, adjacency, counts);
+
+        // Price every collapse along an edge, in both directions
+        for (size_t i = 0; i < index_count; i++)
+        {
+
+            // Initialized data
+            u32 ends[2] = { indices[i], indices[i - i % 3 + ( i + 1 ) % 3] };
+
+            for (size_t j = 0; j < 2; j++)
+            {
+
+                // Initialized data
+                u32                   u = ends[j],
+                                      v = ends[1 - j];
+                struct mesh_quadric_s q = quadrics[u];
+
+                // Locked vertices stay, and border vertices only slide along their border
+                if ( kinds[u] == MESH_VERTEX_LOCKED ) continue;
+                if ( kinds[u] == MESH_VERTEX_BORDER && border_next[u] != v && border_prev[u] != v ) continue;
+
+                add_quadric(&q, &quadrics[v]);
+
+                collapses[collapse_count++] = (struct mesh_collapse_s) { .cost = quadric_error(&q, mesh_position(p_mesh, v)), .from = u, .to = v };
+            }
+        }
+
+        // Nothing can move
+        if ( collapse_count == 0 ) break;
+
+        qsort(collapses, collapse_count, sizeof(struct mesh_collapse_s), compare_collapses);
+
+        // Take the cheapest quarter, so collapses made cheap by this pass are priced before the dear ones
+        take = ( collapse_count + 3 ) / 4;
+
+        memset(touched, 0, vertex_count);
+
+        for (size_t i = 0; i < take && !done; i++)
+        {
+
+            // Initialized data
+            u32  u  = collapses[i].from,
+                 v  = collapses[i].to;
+            bool ok = true;
+
+            // Every collapse left costs more than the budget
+            if ( collapses[i].cost > limit )                          { done = true; break; }
+            if ( target_index_count && live <= target_index_count )   { done = true; break; }
+
+            // Each vertex moves, or is moved onto, once a pass
+            if ( touched[u] || touched[v] ) continue;
+
+            // Don't fold a triangle over
+            for (u32 a = offsets[u]; a < offsets[u + 1] && ok; a++)
+            {
+
+                // Initialized data
+                u32   *t = &indices[adjacency[a] * 3];
+                double before[3] = { 0 },
+                       after[3]  = { 0 };
+
+                // Triangles on the edge are removed
+                if ( t[0] == v || t[1] == v || t[2] == v ) continue;
+
+                triangle_normal(mesh_position(p_mesh, t[0]), mesh_position(p_mesh, t[1]), mesh_position(p_mesh, t[2]), before);
+                triangle_normal(mesh_position(p_mesh, ( t[0] == u ) ? v : t[0]), mesh_position(p_mesh, ( t[1] == u ) ? v : t[1]), mesh_position(p_mesh, ( t[2] == u ) ? v : t[2]), after);
+
+                ok = ( before[0] * after[0] + before[1] * after[1] + before[2] * after[2] ) > 0;
+            }
+
+            if ( !ok ) continue;
+
+            // Move the vertex
+            for (u32 a = offsets[u]; a < offsets[u + 1]; a++)
+            {
+
+                // Initialized data
+                u32 *t = &indices[adjacency[a] * 3];
+
+                if ( t[0] == v || t[1] == v || t[2] == v )
+                    live -= 3;
+
+                for (size_t k = 0; k < 3; k++)
+                {
+                    if ( t[k] == u ) t[k] = v;
+
+                    touched[t[k]] = 1;
+                }
+            }
+
+            touched[u] = 1;
+
+            add_quadric(&quadrics[v], &quadrics[u]);
+
+            // Keep the border whole
+            if ( kinds[u] == MESH_VERTEX_BORDER )
+            {
+                if ( border_next[u] == v )
+                {
+                    border_prev[v] = border_prev[u];
+
+                    if ( border_prev[u] != MESH_NONE ) border_next[border_prev[u]] = v;
+                }
+                else
+                {
+                    border_next[v] = border_next[u];
+
+                    if ( border_next[u] != MESH_NONE ) border_prev[border_next[u]] = v;
+                }
+            }
+
+            if ( collapses[i].cost > error ) error = collapses[i].cost;
+
+            applied++;
+        }
+
+        // Drop the triangles that collapsed
+        for (size_t t = 0; t < index_count / 3; t++)
+        {
+
+            // Initialized data
+            u32 a = indices[t * 3],
+                b = indices[t * 3 + 1],
+                c = indices[t * 3 + 2];
+
+            if ( a == b || b == c || a == c ) continue;
+
+            indices[kept++] = a,
+            indices[kept++] = b,
+            indices[kept++] = c;
+        }
+
+        index_count = kept;
+
+        if ( applied == 0 || done ) break;
+    }
+
+    // Add the level, unless nothing was removed
+    if ( index_count < p_last->index_count )
+    {
+        grown = G10_REALLOC(p_mesh->indices, ( p_mesh->index_count + index_count ) * sizeof(u32));
+
+        // Error check
+        if ( grown == (void *) 0 ) goto no_mem;
+
+        memcpy(grown + p_mesh->index_count, indices, index_count * sizeof(u32));
+
+        p_mesh->indices                 = grown,
+        p_mesh->lods[p_mesh->lod_count] = (GXMeshLOD_t)
+        {
+            .first_index = (u32) p_mesh->index_count,
+            .index_count = (u32) index_count,
+            .error       = p_last->error + (float) sqrt(error)
+        };
+
+        p_mesh->lod_count++,
+        p_mesh->index_count += index_count;
+    }
+
+    // Clean up
+    G10_FREE(indices);
+    G10_FREE(offsets);
+    G10_FREE(adjacency);
+    G10_FREE(counts);
+    G10_FREE(border_next);
+    G10_FREE(border_prev);
+    G10_FREE(table);
+    G10_FREE(kinds);
+    G10_FREE(touched);
+    G10_FREE(quadrics);
+    G10_FREE(collapses);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_mesh:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Mesh] Null pointer provided for parameter \"p_mesh\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_levels:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Mesh] Mesh has no triangles to simplify in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            too_many_levels:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Mesh] Mesh already has %d levels of detail in call to function \"%s\"\n", MESH_MAX_LODS, __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    g_print_error("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Clean up
+                G10_FREE(indices);
+                G10_FREE(offsets);
+                G10_FREE(adjacency);
+                G10_FREE(counts);
+                G10_FREE(border_next);
+                G10_FREE(border_prev);
+                G10_FREE(table);
+                G10_FREE(kinds);
+                G10_FREE(touched);
+                G10_FREE(quadrics);
+                G10_FREE(collapses);
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int optimize_mesh_vertex_cache ( GXMesh_t *p_mesh, size_t cache_size )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( p_mesh     == (void *) 0 ) goto no_mesh;
+        if ( cache_size == 0 )          goto no_cache;
+    #endif
+
+    // Initialized data
+    size_t  vertex_count    = p_mesh->vertex_count,
+            index_count     = p_mesh->index_count,
+            dead_end_count  = 0,
+            output_count    = 0;
+    u32    *live            = G10_REALLOC(0, ( vertex_count + 1 ) * sizeof(u32)),
+           *offsets         = G10_REALLOC(0, ( vertex_count + 1 ) * sizeof(u32)),
+           *cache_time      = G10_REALLOC(0, ( vertex_count + 1 ) * sizeof(u32)),
+           *adjacency       = G10_REALLOC(0, ( index_count + 1 ) * sizeof(u32)),
+           *dead_ends       = G10_REALLOC(0, ( index_count + 1 ) * sizeof(u32)),
+           *candidates      = G10_REALLOC(0, ( index_count + 1 ) * sizeof(u32)),
+           *output          = G10_REALLOC(0, ( index_count + 1 ) * sizeof(u32)),
+            time            = (u32) cache_size + 1,
+            cursor          = 1,
+            fanning         = 0;
+    u8     *drawn           = G10_REALLOC(0, index_count / 3 + 1);
+
+    // Error check
+    if ( ! ( live && offsets && cache_time && adjacency && dead_ends && candidates && output && drawn ) ) goto no_mem;
+
+    // Order each level of detail on its own
+    for (size_t l = 0; l < p_mesh->lod_count; l++)
+    {
+
+        // Initialized data
+        u32    *indices     = p_mesh->indices + p_mesh->lods[l].first_index;
+        size_t  level_count = p_mesh->lods[l].index_count;
+
+        memset(live, 0, vertex_count * sizeof(u32));
+        memset(cache_time, 0, vertex_count * sizeof(u32));
+        memset(drawn, 0, level_count / 3);
+
+        dead_end_count = 0,
+        output_count   = 0,
+        time           = (u32) cache_size + 1,
+        cursor         = 1,
+        fanning        = 0;
+
+        // Count the triangles of each vertex
+        for (size_t i = 0; i < level_count; i++)
+            live[indices[i]]++;
+
+        // Find where the triangles of each vertex start
+        offsets[0] = 0;
+
+        for (size_t i = 0; i < vertex_count; i++)
+            offsets[i + 1] = offsets[i] + live[i];
+
+        // List the triangles of each vertex, using the cache times as cursors
+        for (size_t i = 0; i < level_count; i++)
+        {
+
+            // Initialized data
+            u32 v = indices[i];
+
+            adjacency[offsets[v] + cache_time[v]++] = (u32) ( i / 3 );
+        }
+
+        memset(cache_time, 0, vertex_count * sizeof(u32));
+
+        // Nothing to draw
+        if ( vertex_count == 0 ) fanning = MESH_NONE;
+
+        // Draw the fan around each vertex
+        while ( fanning != MESH_NONE )
+        {
+
+            // Initialized data
+            size_t candidate_count = 0;
+
+            for (u32 i = offsets[fanning]; i < offsets[fanning + 1]; i++)
+            {
+
+                // Initialized data
+                u32 t = adjacency[i];
+
+                if ( drawn[t] ) continue;
+
+                // Draw the triangle
+                for (size_t j = 0; j < 3; j++)
+                {
+
+                    // Initialized data
+                    u32 v = indices[t * 3 + j];
+
+                    output[output_count++]         = v,
+                    dead_ends[dead_end_count++]    = v,
+                    candidates[candidate_count++]  = v;
+
+                    live[v]--;
+
+                    // Transformed again
+                    if ( time - cache_time[v] > cache_size )
+                        cache_time[v] = time++;
+                }
+
+                drawn[t] = 1;
+            }
+
+            fanning = next_fanning_vertex(live, cache_time, time, cache_size, candidates, candidate_count, dead_ends, &dead_end_count, &cursor, vertex_count);
+        }
+
+        memcpy(indices, output, output_count * sizeof(u32));
+    }
+
+    // Clean up
+    G10_FREE(live);
+    G10_FREE(offsets);
+    G10_FREE(cache_time);
+    G10_FREE(adjacency);
+    G10_FREE(dead_ends);
+    G10_FREE(candidates);
+    G10_FREE(output);
+    G10_FREE(drawn);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_mesh:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Mesh] Null pointer provided for parameter \"p_mesh\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_cache:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Mesh] Parameter \"cache_size\" must be greater than zero in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    g_print_error("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Clean up
+                G10_FREE(live);
+                G10_FREE(offsets);
+                G10_FREE(cache_time);
+                G10_FREE(adjacency);
+                G10_FREE(dead_ends);
+                G10_FREE(candidates);
+                G10_FREE(output);
+                G10_FREE(drawn);
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int optimize_mesh_overdraw ( GXMesh_t *p_mesh, size_t cache_size, float threshold )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( p_mesh     == (void *) 0 ) goto no_mesh;
+        if ( cache_size == 0 )          goto no_cache;
+    #endif
+
+    // Initialized data
+    size_t                 triangle_count = p_mesh->index_count / 3,
+                           hard_count     = 0,
+                           cluster_count  = 0,
+                           output_count   = 0;
+    u32                   *timestamps     = G10_REALLOC(0, ( p_mesh->vertex_count + 1 ) * sizeof(u32)),
+                          *hard           = G10_REALLOC(0, ( triangle_count + 1 ) * sizeof(u32)),
+                          *soft           = G10_REALLOC(0, ( triangle_count + 1 ) * sizeof(u32)),
+                          *output         = G10_REALLOC(0, ( p_mesh->index_count + 1 ) * sizeof(u32)),
+                           time           = (u32) cache_size + 1;
+    struct mesh_cluster_s *clusters       = G10_REALLOC(0, ( triangle_count + 1 ) * sizeof(struct mesh_cluster_s));
+    float                  centroid[3]    = { 0 };
+
+    // Error check
+    if ( ! ( timestamps && hard && soft && output && clusters ) ) goto no_mem;
+
+    // Find the center of the mesh
+    for (size_t v = 0; v < p_mesh->vertex_count; v++)
+    {
+
+        // Initialized data
+        const float *p = mesh_position(p_mesh, (u32) v);
+
+        centroid[0] += p[0],
+        centroid[1] += p[1],
+        centroid[2] += p[2];
+    }
+
+    if ( p_mesh->vertex_count )
+        centroid[0] /= (float) p_mesh->vertex_count,
+        centroid[1] /= (float) p_mesh->vertex_count,
+        centroid[2] /= (float) p_mesh->vertex_count;
+
+    // Order each level of detail on its own
+    for (size_t l = 0; l < p_mesh->lod_count; l++)
+    {
+
+        // Initialized data
+        u32    *indices         = p_mesh->indices + p_mesh->lods[l].first_index;
+        size_t  level_triangles = p_mesh->lods[l].index_count / 3;
+
+        hard_count    = 0,
+        cluster_count = 0,
+        output_count  = 0;
+
+        memset(timestamps, 0, p_mesh->vertex_count * sizeof(u32));
+
+        // Split where the cache is cold. A triangle that misses all three vertices starts a new patch of the mesh
+        for (size_t t = 0; t < level_triangles; t++)
+        {
+
+            // Initialized data
+            u32 misses = touch_vertex(timestamps, &time, indices[t * 3],     cache_size) +
+                         touch_vertex(timestamps, &time, indices[t * 3 + 1], cache_size) +
+                         touch_vertex(timestamps, &time, indices[t * 3 + 2], cache_size);
+
+            if ( t == 0 || misses == 3 )
+                hard[hard_count++] = (u32) t;
+        }
+
+        hard[hard_count] = (u32) level_triangles;
+
+        // Split each patch further, wherever the cache has done as well as it does over the whole patch
+        for (size_t i = 0; i < hard_count; i++)
+        {
+
+            // Initialized data
+            u32    start       = hard[i],
+                   end         = hard[i + 1],
+                   misses      = 0,
+                   first       = (u32) cluster_count;
+            float  patch_acmr  = 0;
+
+            // Measure the patch from a cold cache
+            time += (u32) cache_size + 1;
+
+            for (u32 t = start; t < end; t++)
+                for (size_t j = 0; j < 3; j++)
+                    misses += touch_vertex(timestamps, &time, indices[t * 3 + j], cache_size);
+
+            patch_acmr = threshold * (float) misses / (float) ( end - start );
+
+            soft[cluster_count++] = start;
+
+            // Cut a cluster each time the running cost falls to the cost of the patch
+            {
+
+                // Initialized data
+                u32 running_misses    = 0,
+                    running_triangles = 0;
+
+                time += (u32) cache_size + 1;
+
+                for (u32 t = start; t < end; t++)
+                {
+                    for (size_t j = 0; j < 3; j++)
+                        running_misses += touch_vertex(timestamps, &time, indices[t * 3 + j], cache_size);
+
+                    running_triangles++;
+
+                    if ( t + 1 < end && (float) running_misses / (float) running_triangles <= patch_acmr )
+                    {
+                        soft[cluster_count++] = t + 1;
+
+                        running_misses    = 0,
+                        running_triangles = 0;
+
+                        time += (u32) cache_size + 1;
+                    }
+                }
+
+                // The last cluster rarely reaches the cost of the patch. Merge it into the one before
+                if ( cluster_count - first > 1 && running_triangles )
+                    cluster_count--;
+            }
+        }
+
+        soft[cluster_count] = (u32) level_triangles;
+
+        // Measure how much each cluster faces away from the center
+        for (size_t i = 0; i < cluster_count; i++)
+        {
+
+            // Initialized data
+            float area       = 0,
+                  center[3]  = { 0 },
+                  normal[3]  = { 0 },
+                  length     = 0;
+
+            for (u32 t = soft[i]; t < soft[i + 1]; t++)
+            {
+
+                // Initialized data
+                const float *a  = mesh_position(p_mesh, indices[t * 3]),
+                            *b  = mesh_position(p_mesh, indices[t * 3 + 1]),
+                            *c  = mesh_position(p_mesh, indices[t * 3 + 2]);
+                float        e0[3] = { b[0] - a[0], b[1] - a[1], b[2] - a[2] },
+                             e1[3] = { c[0] - a[0], c[1] - a[1], c[2] - a[2] },
+                             n[3]  = { e0[1] * e1[2] - e0[2] * e1[1], e0[2] * e1[0] - e0[0] * e1[2], e0[0] * e1[1] - e0[1] * e1[0] },
+                             s     = sqrtf(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+
+                // Weigh the center of each triangle by its area
+                for (size_t j = 0; j < 3; j++)
+                    center[j] += ( a[j] + b[j] + c[j] ) / 3.f * s,
+                    normal[j] += n[j];
+
+                area += s;
+            }
+
+            length = sqrtf(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+
+            clusters[i].index  = (u32) i,
+            clusters[i].facing = 0;
+
+            // Degenerate clusters face nowhere
+            if ( area > 0 && length > 0 )
+                clusters[i].facing = ( ( center[0] / area - centroid[0] ) * normal[0] +
+                                       ( center[1] / area - centroid[1] ) * normal[1] +
+                                       ( center[2] / area - centroid[2] ) * normal[2] ) / length;
+        }
+
+        // Draw the clusters that face out first, so they hide the ones behind them
+        qsort(clusters, cluster_count, sizeof(struct mesh_cluster_s), compare_clusters);
+
+        for (size_t i = 0; i < cluster_count; i++)
+        {
+
+            // Initialized data
+            u32 start = soft[clusters[i].index],
+                end   = soft[clusters[i].index + 1];
+
+            memcpy(&output[output_count], &indices[start * 3], ( end - start ) * 3 * sizeof(u32));
+
+            output_count += ( end - start ) * 3;
+        }
+
+        memcpy(indices, output, output_count * sizeof(u32));
+    }
+
+    // Clean up
+    G10_FREE(timestamps);
+    G10_FREE(hard);
+    G10_FREE(soft);
+    G10_FREE(output);
+    G10_FREE(clusters);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_mesh:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Mesh] Null pointer provided for parameter \"p_mesh\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_cache:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Mesh] Parameter \"cache_size\" must be greater than zero in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    g_print_error("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Clean up
+                G10_FREE(timestamps);
+                G10_FREE(hard);
+                G10_FREE(soft);
+                G10_FREE(output);
+                G10_FREE(clusters);
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int optimize_mesh_vertex_fetch ( GXMesh_t *p_mesh )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( p_mesh == (void *) 0 ) goto no_mesh;
+    #endif
+
+    // Initialized data
+    size_t  stride       = p_mesh->vertex_stride,
+            vertex_count = 0;
+    u32    *remap        = G10_REALLOC(0, ( p_mesh->vertex_count + 1 ) * sizeof(u32));
+    u8     *vertices     = G10_REALLOC(0, ( p_mesh->vertex_count + 1 ) * stride);
+
+    // Error check
+    if ( remap    == (void *) 0 ) goto no_mem;
+    if ( vertices == (void *) 0 ) goto no_mem;
+
+    memset(remap, 0xFF, p_mesh->vertex_count * sizeof(u32));
+
+    // Number the vertices in the order the triangles use them
+    for (size_t i = 0; i < p_mesh->index_count; i++)
+    {
+
+        // Initialized data
+        u32 v = p_mesh->indices[i];
+
+        if ( remap[v] == MESH_NONE )
+        {
+            memcpy(vertices + vertex_count * stride, (u8 *) p_mesh->vertices + v * stride, stride);
+
+            remap[v] = (u32) vertex_count++;
+        }
+
+        p_mesh->indices[i] = remap[v];
+    }
+
+    // Swap the vertices
+    G10_FREE(p_mesh->vertices);
+
+    p_mesh->vertices     = (float *) vertices,
+    p_mesh->vertex_count = vertex_count;
+
+    // Clean up
+    G10_FREE(remap);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_mesh:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Mesh] Null pointer provided for parameter \"p_mesh\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    g_print_error("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Clean up
+                G10_FREE(remap);
+                G10_FREE(vertices);
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int build_mesh_meshlets ( GXMesh_t *p_mesh, size_t max_vertices, size_t max_triangles )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( p_mesh        == (void *) 0 ) goto no_mesh;
+        if ( max_vertices  <  3 )          goto bad_max_vertices;
+        if ( max_vertices  >  256 )        goto bad_max_vertices;
+        if ( max_triangles == 0 )          goto bad_max_triangles;
+    #endif
+
+    // Initialized data
+    const u32   *indices        = p_mesh->indices + p_mesh->lods[0].first_index;
+    size_t       triangle_count = ( p_mesh->lod_count ) ? p_mesh->lods[0].index_count / 3 : 0,
+                 meshlet_count  = 0,
+                 vertex_count   = 0;
+    u32         *local          = G10_REALLOC(0, ( p_mesh->vertex_count + 1 ) * sizeof(u32)),
+                *vertices       = G10_REALLOC(0, ( triangle_count * 3 + 1 ) * sizeof(u32));
+    u8          *triangles      = G10_REALLOC(0, triangle_count * 3 + 1);
+    GXMeshlet_t *meshlets       = G10_REALLOC(0, ( triangle_count + 1 ) * sizeof(GXMeshlet_t)),
+                *p_meshlet      = meshlets;
+
+    // Error check
+    if ( local     == (void *) 0 ) goto no_mem;
+    if ( vertices  == (void *) 0 ) goto no_mem;
+    if ( triangles == (void *) 0 ) goto no_mem;
+    if ( meshlets  == (void *) 0 ) goto no_mem;
+
+    memset(local, 0xFF, p_mesh->vertex_count * sizeof(u32));
+    memset(meshlets, 0, sizeof(GXMeshlet_t));
+
+    // Fill each meshlet with triangles in the order they are drawn
+    for (size_t t = 0; t < triangle_count; t++)
+    {
+
+        // Initialized data
+        const u32 *tri   = indices + t * 3;
+        u32        added = ( local[tri[0]] == MESH_NONE ) +
+                           ( local[tri[1]] == MESH_NONE && tri[1] != tri[0] ) +
+                           ( local[tri[2]] == MESH_NONE && tri[2] != tri[0] && tri[2] != tri[1] );
+
+        // Start the next meshlet when this one is full
+        if ( p_meshlet->vertex_count + added > max_vertices || p_meshlet->triangle_count + 1 > max_triangles )
+        {
+
+            // Forget the vertices of the full meshlet
+            for (u32 i = 0; i < p_meshlet->vertex_count; i++)
+                local[vertices[p_meshlet->vertex_offset + i]] = MESH_NONE;
+
+            p_meshlet++,
+            meshlet_count++;
+
+            *p_meshlet = (GXMeshlet_t)
+            {
+                .vertex_offset   = (u32) vertex_count,
+                .triangle_offset = (u32) t
+            };
+        }
+
+        // Add the triangle, and any vertices the meshlet does not have yet
+        for (size_t j = 0; j < 3; j++)
+        {
+            if ( local[tri[j]] == MESH_NONE )
+            {
+                local[tri[j]]            = p_meshlet->vertex_count++,
+                vertices[vertex_count++] = tri[j];
+            }
+
+            triangles[t * 3 + j] = (u8) local[tri[j]];
+        }
+
+        p_meshlet->triangle_count++;
+    }
+
+    // Count the last meshlet
+    if ( triangle_count ) meshlet_count++;
+
+    // Swap the meshlets
+    G10_FREE(p_mesh->meshlets);
+    G10_FREE(p_mesh->meshlet_vertices);
+    G10_FREE(p_mesh->meshlet_triangles);
+
+    p_mesh->meshlets               = meshlets,
+    p_mesh->meshlet_count          = meshlet_count,
+    p_mesh->meshlet_vertices       = vertices,
+    p_mesh->meshlet_vertex_count   = vertex_count,
+    p_mesh->meshlet_triangles      = triangles,
+    p_mesh->meshlet_triangle_count = triangle_count;
+
+    // Bound each meshlet
+    for (size_t i = 0; i < meshlet_count; i++)
+        bound_meshlet(p_mesh, &meshlets[i]);
+
+    // Clean up
+    G10_FREE(local);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_mesh:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Mesh] Null pointer provided for parameter \"p_mesh\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            bad_max_vertices:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Mesh] Parameter \"max_vertices\" must be between 3 and 256 in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            bad_max_triangles:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Mesh] Parameter \"max_triangles\" must be greater than zero in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    g_print_error("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Clean up
+                G10_FREE(local);
+                G10_FREE(vertices);
+                G10_FREE(triangles);
+                G10_FREE(meshlets);
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+size_t cull_part_meshlets ( GXPart_t *p_part, GXTransform_t *p_transform, GXCamera_t *p_camera, u32 *p_visible )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( p_part      == (void *) 0 ) goto no_part;
+        if ( p_transform == (void *) 0 ) goto no_transform;
+        if ( p_camera    == (void *) 0 ) goto no_camera;
+        if ( p_visible   == (void *) 0 ) goto no_visible;
+    #endif
+
+    // Initialized data
+    mat4    inverse     = affine_inverse_mat4(p_transform->model_matrix);
+    vec3    camera      = p_camera->view.location;
+    vec4    planes[6]   = { 0 };
+    float   eye[3]      = { 0 };
+    size_t  group_count = ( p_part->meshlet_count + 3 ) / 4,
+            count       = 0;
+
+    // Nothing to cull
+    if ( p_part->meshlet_bounds == (void *) 0 ) return 0;
+
+    // Bring the planes into model space, and normalize them so spheres can be tested by distance
+    (void) frustum_planes_from_camera(p_camera, planes);
+
+    for (size_t i = 0; i < 6; i++)
+    {
+
+        // Initialized data
+        vec4  plane  = mul_mat4_vec4(p_transform->model_matrix, planes[i]);
+        float length = sqrtf(plane.x * plane.x + plane.y * plane.y + plane.z * plane.z);
+
+        planes[i] = ( length > 0 ) ? (vec4) { plane.x / length, plane.y / length, plane.z / length, plane.w / length } : plane;
+    }
+
+    // Bring the camera into model space
+    eye[0] = camera.x * inverse.a + camera.y * inverse.e + camera.z * inverse.i + inverse.m,
+    eye[1] = camera.x * inverse.b + camera.y * inverse.f + camera.z * inverse.j + inverse.n,
+    eye[2] = camera.x * inverse.c + camera.y * inverse.g + camera.z * inverse.k + inverse.o;
+
+    // Test four meshlets at a time
+    for (size_t g = 0; g < group_count; g++)
+    {
+
+        // Initialized data
+        const GXMeshletBounds_t *p_bounds = &p_part->meshlet_bounds[g];
+        size_t                   lanes    = p_part->meshlet_count - g * 4;
+        int                      mask     = ( lanes >= 4 ) ? 0xF : ( 1 << lanes ) - 1;
+
+        #ifdef G10_MESH_SSE
+        {
+
+            // Initialized data
+            __m128 cx      = _mm_loadu_ps(p_bounds->center_x),
+                   cy      = _mm_loadu_ps(p_bounds->center_y),
+                   cz      = _mm_loadu_ps(p_bounds->center_z),
+                   r       = _mm_loadu_ps(p_bounds->radius),
+                   dx      = _mm_sub_ps(_mm_loadu_ps(p_bounds->apex_x), _mm_set1_ps(eye[0])),
+                   dy      = _mm_sub_ps(_mm_loadu_ps(p_bounds->apex_y), _mm_set1_ps(eye[1])),
+                   dz      = _mm_sub_ps(_mm_loadu_ps(p_bounds->apex_z), _mm_set1_ps(eye[2])),
+                   length  = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz))),
+                   facing  = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, _mm_loadu_ps(p_bounds->axis_x)), _mm_mul_ps(dy, _mm_loadu_ps(p_bounds->axis_y))), _mm_mul_ps(dz, _mm_loadu_ps(p_bounds->axis_z))),
+                   culled  = _mm_cmpgt_ps(facing, _mm_mul_ps(_mm_loadu_ps(p_bounds->cutoff), length));
+
+            // Iterate over each plane
+            for (int i = 0; i < 6; i++)
+            {
+
+                // Initialized data
+                __m128 d = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(planes[i].x), cx), _mm_mul_ps(_mm_set1_ps(planes[i].y), cy)), _mm_add_ps(_mm_mul_ps(_mm_set1_ps(planes[i].z), cz), _mm_set1_ps(planes[i].w)));
+
+                // The sphere is entirely behind the plane
+                culled = _mm_or_ps(culled, _mm_cmplt_ps(_mm_add_ps(d, r), _mm_setzero_ps()));
+            }
+
+            mask &= ~_mm_movemask_ps(culled);
+        }
+        #else
+            for (int i = 0; i < 4; i++)
+            {
+
+                // Initialized data
+                float dx     = p_bounds->apex_x[i] - eye[0],
+                      dy     = p_bounds->apex_y[i] - eye[1],
+                      dz     = p_bounds->apex_z[i] - eye[2],
+                      length = sqrtf(dx * dx + dy * dy + dz * dz);
+                bool  culled = dx * p_bounds->axis_x[i] + dy * p_bounds->axis_y[i] + dz * p_bounds->axis_z[i] > p_bounds->cutoff[i] * length;
+
+                // Iterate over each plane
+                for (int j = 0; j < 6 && culled == false; j++)
+                    culled = planes[j].x * p_bounds->center_x[i] + planes[j].y * p_bounds->center_y[i] + planes[j].z * p_bounds->center_z[i] + planes[j].w + p_bounds->radius[i] < 0;
+
+                if ( culled ) mask &= ~( 1 << i );
+            }
+        #endif
+
+        // Keep the meshlets that may be seen
+        for (int i = 0; i < 4; i++)
+            if ( mask & ( 1 << i ) )
+                p_visible[count++] = (u32) ( g * 4 + i );
+    }
+
+    // Success
+    return count;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_part:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Mesh] Null pointer provided for parameter \"p_part\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_transform:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Mesh] Null pointer provided for parameter \"p_transform\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_camera:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Mesh] Null pointer provided for parameter \"p_camera\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_visible:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Mesh] Null pointer provided for parameter \"p_visible\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int analyze_mesh_vertex_cache ( GXMesh_t *p_mesh, size_t cache_size, float *p_acmr, float *p_atvr )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( p_mesh     == (void *) 0 ) goto no_mesh;
+        if ( cache_size == 0 )          goto no_cache;
+        if ( p_acmr     == (void *) 0 ) goto no_acmr;
+        if ( p_atvr     == (void *) 0 ) goto no_atvr;
+    #endif
+
+    // Initialized data
+    u32    *timestamps  = G10_REALLOC(0, ( p_mesh->vertex_count + 1 ) * sizeof(u32)),
+           *indices     = p_mesh->indices + p_mesh->lods[0].first_index,
+            time        = (u32) cache_size + 1;
+    size_t  index_count = ( p_mesh->lod_count ) ? p_mesh->lods[0].index_count : 0,
+            misses      = 0,
+            used        = 0;
+
+    // Error check
+    if ( timestamps == (void *) 0 ) goto no_mem;
+
+    memset(timestamps, 0, p_mesh->vertex_count * sizeof(u32));
+
+    // Run the triangles through the cache
+    for (size_t i = 0; i < index_count; i++)
+        misses += touch_vertex(timestamps, &time, indices[i], cache_size);
+
+    // Count the vertices that were transformed at least once
+    for (size_t v = 0; v < p_mesh->vertex_count; v++)
+        used += ( timestamps[v] != 0 );
+
+    *p_acmr = ( index_count ) ? (float) misses / (float) ( index_count / 3 ) : 0,
+    *p_atvr = ( used )        ? (float) misses / (float) used                : 0;
+
+    // Clean up
+    G10_FREE(timestamps);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_mesh:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Mesh] Null pointer provided for parameter \"p_mesh\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_cache:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Mesh] Parameter \"cache_size\" must be greater than zero in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_acmr:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Mesh] Null pointer provided for parameter \"p_acmr\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_atvr:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Mesh] Null pointer provided for parameter \"p_atvr\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    g_print_error("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int save_mesh ( GXMesh_t *p_mesh, const char *path )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( p_mesh == (void *) 0 ) goto no_mesh;
+        if ( path   == (void *) 0 ) goto no_path;
+    #endif
+
+    // Initialized data
+    GXMeshHeader_t  header  = {
+        .magic         = MESH_MAGIC,
+        .version       = MESH_VERSION,
+        .vertex_count  = (u32) p_mesh->vertex_count,
+        .vertex_stride = (u32) p_mesh->vertex_stride,
+        .index_count   = (u32) p_mesh->index_count,
+        .index_size    = ( p_mesh->vertex_count < 65536 ) ? sizeof(u16) : sizeof(u32),
+        .lod_count     = (u32) p_mesh->lod_count,
+
+        .meshlet_count          = (u32) p_mesh->meshlet_count,
+        .meshlet_vertex_count   = (u32) p_mesh->meshlet_vertex_count,
+        .meshlet_triangle_count = (u32) p_mesh->meshlet_triangle_count
+    };
+    u16            *narrow  = 0;
+    FILE           *p_f     = 0;
+    size_t          padding = ( 4 - p_mesh->meshlet_triangle_count * 3 % 4 ) % 4;
+    u8              zero[4] = { 0 };
+
+    // Bounding sphere
+    header.radius = bound_mesh(p_mesh, header.center);
+
+    // Narrow the indices
+    if ( header.index_size == sizeof(u16) )
+    {
+        narrow = G10_REALLOC(0, ( p_mesh->index_count + 1 ) * sizeof(u16));
+
+        // Error check
+        if ( narrow == (void *) 0 ) goto no_mem;
+
+        for (size_t i = 0; i < p_mesh->index_count; i++)
+            narrow[i] = (u16) p_mesh->indices[i];
+    }
+
+    p_f = fopen(path, "wb");
+
+    // Error check
+    if ( p_f == (void *) 0 ) goto failed_to_open_file;
+
+    // Write the header, the levels of detail, the vertices, the indices, and the meshlets
+    if ( fwrite(&header, sizeof(GXMeshHeader_t), 1, p_f) != 1 ) goto failed_to_write_file;
+    if ( fwrite(p_mesh->lods, sizeof(GXMeshLOD_t), p_mesh->lod_count, p_f) != p_mesh->lod_count ) goto failed_to_write_file;
+    if ( fwrite(p_mesh->vertices, p_mesh->vertex_stride, p_mesh->vertex_count, p_f) != p_mesh->vertex_count ) goto failed_to_write_file;
+
+    if ( narrow )
+    {
+        if ( fwrite(narrow, sizeof(u16), p_mesh->index_count, p_f) != p_mesh->index_count ) goto failed_to_write_file;
+    }
+    else
+    {
+        if ( fwrite(p_mesh->indices, sizeof(u32), p_mesh->index_count, p_f) != p_mesh->index_count ) goto failed_to_write_file;
+    }
+
+    // Meshlet triangles are padded to 4 bytes, so the file can be uploaded as it is
+    if ( p_mesh->meshlet_count )
+    {
+        if ( fwrite(p_mesh->meshlets, sizeof(GXMeshlet_t), p_mesh->meshlet_count, p_f) != p_mesh->meshlet_count ) goto failed_to_write_file;
+        if ( fwrite(p_mesh->meshlet_vertices, sizeof(u32), p_mesh->meshlet_vertex_count, p_f) != p_mesh->meshlet_vertex_count ) goto failed_to_write_file;
+        if ( fwrite(p_mesh->meshlet_triangles, 3, p_mesh->meshlet_triangle_count, p_f) != p_mesh->meshlet_triangle_count ) goto failed_to_write_file;
+        if ( fwrite(zero, 1, padding, p_f) != padding ) goto failed_to_write_file;
+    }
+
+    // Close the file
+    fclose(p_f);
+
+    // Clean up
+    G10_FREE(narrow);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_mesh:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Mesh] Null pointer provided for parameter \"p_mesh\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_path:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Mesh] Null pointer provided for parameter \"path\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    g_print_error("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            failed_to_open_file:
+                #ifndef NDEBUG
+                    g_print_error("[Standard Library] Failed to open file \"%s\" in call to function \"%s\"\n", path, __FUNCTION__);
+                #endif
+
+                // Clean up
+                G10_FREE(narrow);
+
+                // Error
+                return 0;
+
+            failed_to_write_file:
+                #ifndef NDEBUG
+                    g_print_error("[Standard Library] Failed to write file \"%s\" in call to function \"%s\"\n", path, __FUNCTION__);
+                #endif
+
+                // Clean up
+                fclose(p_f);
+                G10_FREE(narrow);
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int destroy_mesh ( GXMesh_t **pp_mesh )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( pp_mesh == (void *) 0 ) goto no_mesh;
+    #endif
+
+    // Initialized data
+    GXMesh_t *p_mesh = *pp_mesh;
+
+    // No more pointer for caller
+    *pp_mesh = 0;
+
+    // Error check
+    if ( p_mesh == (void *) 0 ) goto pointer_to_null_pointer;
+
+    // Free the vertices, the indices, and the meshlets
+    G10_FREE(p_mesh->vertices);
+    G10_FREE(p_mesh->indices);
+    G10_FREE(p_mesh->meshlets);
+    G10_FREE(p_mesh->meshlet_vertices);
+    G10_FREE(p_mesh->meshlet_triangles);
+
+    // Free the mesh
+    free(p_mesh);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_mesh:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Mesh] Null pointer provided for parameter \"pp_mesh\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            pointer_to_null_pointer:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Mesh] Parameter \"pp_mesh\" points to null pointer in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
@@ -1,47 +1,34 @@
-#include <stdio.h>
-#include <string.h>
-#include <stdlib.h>
+// Allocations made here are counted against the renderer
+#define G10_ALLOC_TAG alloc_tag_renderer
+
+#include <G10/GXPLY.h>
+
 #include <stdbool.h>
 
+// Platform dependent mapping
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
 // Vulkan
 #include <vulkan/vulkan.h>
 
-#include <G10/GXtypedef.h>
-#include <G10/GXPart.h>
-
-// PLY Debugging
-#define GXPLY_CheckTriangulation  false
-
-// PLY header strings
-#define GXPLY_HSignature          0x0A796C70 // "ply\n"
-#define GXPLY_HFormat             0x6D726F66 // "form"
-#define GXPLY_HComment            0x6D6D6F63 // "comm"
-#define GXPLY_HElement            0x6D656C65 // "elem"
-#define GXPLY_HProperty           0x706F7270 // "prop"
-#define GXPLY_HEnd                0x5F646E65 // "end_"
-
-// PLY types
-#define GXPLY_char                0x72616863 // "char"
-#define GXPLY_uchar               0x61686375 // "ucha"
-#define GXPLY_short               0x726F6873 // "shor"
-#define GXPLY_ushort              0x6F687375 // "usho"
-#define GXPLY_int                 0x20746E69 // "int "
-#define GXPLY_uint                0x746E6975 // "uint"
-#define GXPLY_float               0x616F6C66 // "floa"
-#define GXPLY_double              0x62756F64 // "doub"
-#define GXPLY_list                0x7473696C // "list"
-
 // Vertex groups that are likely to be encountered
-#define GXPLY_Geometric           0x00001
-#define GXPLY_Texture             0x00002
-#define GXPLY_Normal              0x00004
-#define GXPLY_Bitangent           0x00008
-#define GXPLY_Tangent             0x00010
-#define GXPLY_Color               0x00020
-#define GXPLY_Bones               0x00040
-#define GXPLY_Weights             0x00080
+#define GXPLY_Geometric           VERTEX_GROUP_GEOMETRIC
+#define GXPLY_Texture             VERTEX_GROUP_TEXTURE
+#define GXPLY_Normal              VERTEX_GROUP_NORMAL
+#define GXPLY_Bitangent           VERTEX_GROUP_BITANGENT
+#define GXPLY_Tangent             VERTEX_GROUP_TANGENT
+#define GXPLY_Color               VERTEX_GROUP_COLOR
+#define GXPLY_Bones               VERTEX_GROUP_BONES
+#define GXPLY_Weights             VERTEX_GROUP_WEIGHTS
 
-#define GXPLY_MAXVERTEXGROUPS     8
+#define GXPLY_MAXVERTEXGROUPS     VERTEX_GROUP_COUNT
 
 // Geometric
 #define GXPLY_X                   0x000001
@@ -86,698 +73,1679 @@
 #define GXPLY_BW2                 0x200000
 #define GXPLY_BW3                 0x400000
 
-enum GXply_fileType_e {
-    none   = 0,
-    ASCII  = 1,
-    little = 2,
-    big    = 3
-};
-typedef enum GXply_fileType_e GXply_fileType_t;
+// The most tokens on one line of the header. "property list uchar int vertex_indices" has five
+#define PLY_MAX_TOKENS            6
+
+// Size of each type in bytes, indexed by ply_type_t
+static const size_t ply_type_sizes[] = { 0, 1, 1, 2, 2, 4, 4, 4, 8 };
 
-struct GXPLYproperty_s
+// The properties of each vertex group, in bit order, under each of their spellings
+static const char *ply_group_properties[GXPLY_MAXVERTEXGROUPS][2][4] =
 {
-    size_t  type_size;
-    char   *name;
+    { { "x"  , "y"    , "z"   , 0       }, { 0 }                  },
+    { { "s"  , "t"    , 0     , 0       }, { "u", "v", 0  , 0   } },
+    { { "nx" , "ny"   , "nz"  , 0       }, { 0 }                  },
+    { { "bx" , "by"   , "bz"  , 0       }, { 0 }                  },
+    { { "tx" , "ty"   , "tz"  , 0       }, { 0 }                  },
+    { { "red", "green", "blue", "alpha" }, { "r", "g", "b", "a" } },
+    { { "b0" , "b1"   , "b2"  , "b3"    }, { 0 }                  },
+    { { "w0" , "w1"   , "w2"  , "w3"    }, { 0 }                  }
 };
-typedef struct GXPLYproperty_s GXPLYproperty_t;
 
-struct GXPLYelement_s
+static inline u16 swap_16 ( u16 v )
 {
-    size_t           n_count;
-    size_t           n_properties;
-    size_t           s_stride;
-    GXPLYproperty_t *properties;
-    char            *name;
-};
-typedef struct GXPLYelement_s GXPLYelement_t;
+    return (u16) ( ( v >> 8 ) | ( v << 8 ) );
+}
 
-struct GXply_file_s {
-    size_t           n_elements,
-                     flags;
-    GXply_fileType_t  format;
-    GXPLYelement_t  *elements;
-};
-typedef struct GXply_file_s GXply_file_t;
-
-#pragma pack (push)
-#pragma pack (1)
-struct GXPLYindex_s {
-    u8  count;
-    u32 a;
-    u32 b;
-    u32 c;
-};
-#pragma pack (pop)
-typedef struct GXPLYindex_s GXPLYindex_t;
+static inline u32 swap_32 ( u32 v )
+{
+    return ( v >> 24 ) | ( ( v >> 8 ) & 0xff00 ) | ( ( v << 8 ) & 0xff0000 ) | ( v << 24 );
+}
 
-GXPart_t *load_ply ( GXPart_t *part, const char *path )
+static inline u64 swap_64 ( u64 v )
 {
+    return ( (u64) swap_32((u32) v) << 32 ) | swap_32((u32) ( v >> 32 ));
+}
 
-    // Commentary
-    {
-        /*
-         * The PLY loaders job is  to turn a PLY file header into a 64 bit metadata value.
-         * the function is written to recognize vertex properties and parse them into common vertex
-         * groups. Each vertex property in a vertex group should appear concurrently. Each
-         * group has an associated byte code. The vertex groups metadata value is used to create a
-         * vertex array object, vertex buffer object, and element buffer object.
-         *
-         * ╭─────────────────────┬──────────────────────────────────────────────────┬──────╮
-         * │ Vertex group name   │ Vertex properties as they appear in the PLY file │ Code │
-         * ├─────────────────────┼──────────────────────────────────────────────────┼──────┤
-         * │ Geometric vertices  │ ( x, y, z )                                      │ 0x01 │
-         * │ Texture coordinates │ ( u, v ) or ( s, t )                             │ 0x02 │
-         * │ Vertex normals      │ ( nx, ny, nz )                                   │ 0x04 │
-         * │ Vertex bitangents   │ ( bx, by, bz )                                   │ 0x08 │
-         * │ Vertex tangents     │ ( tx, ty, tz )                                   │ 0x10 │
-         * │ Vertex colors       │ ( red, green, blue, alpha ) or ( r, g, b, a )    │ 0x20 │
-         * │ Bone groups         │ ( b0, b1, b2, b3 )                               │ 0x40 │
-         * │ Bone weights        │ ( w0, w1, w2, w3 )                               │ 0x80 │
-         * ╰─────────────────────┴──────────────────────────────────────────────────┴──────╯
-         *
-         * NOTE: The function can be modified to read two more vertex groups, supporting a
-         * maximum of 8 vertex groups.
-         *
-         * The parser makes several passes through the header, populating more and more data each
-         * time. Each pass and its purpose is listed below
-         *
-         * Pass 1.
-         *     On pass 1, the function counts all the elements in the header. It will also print
-         *     any comments it n_counters. After this pass, the elements are allocated for
-         *
-         * Pass 2.
-         *     On pass 2, the elements are populated and the properties are counted up and
-         *     allocated for.
-         *
-         * Pass 3.
-         *     On pass 3, the properties are populated and the stride of the element is computed.
-         *     Each property is kept track of using bitflags and a temporary value. The temporary
-         *     value is then tested with various AND masks to deduce what vertex groups are
-         *     present and which are absent.
-         *
-         *     All this work to determine the vertex groups is integrated when the function creates
-         *     the vertexGroups quad word. This 64 bit number is an especially compact way to
-         *     represent both the type and position of each vertex group in the file. Each
-         *     code is packed into the 64 bit number, such that the last vertex group occupies
-         *     the eight least significant bits. For comprehension and completeness, here are a
-         *     few examples and how they should be interpreted.
-         *
-         *        63......................................0
-         *     A. | 00 | 00 | 00 | 00 | 00 | 01 | 04 | 20 |
-         *     B. | 00 | 00 | 00 | 00 | 00 | 04 | 02 | 01 |
-         *     C. | 01 | 02 | 04 | 08 | 10 | 20 | 40 | 80 |
-         *
-         *     A. First is geometric, second is normals, third is colors
-         *     B. First is normals, second is texture coordinates, third is geometric
-         *     C. First is geometric, second is texture coordinates, third is vertex normals, fourth is
-         *        vertex bitangents, fifth is vertex tangents, sixth is vertex bitangents, seventh is
-         *        bone groups,and eighth is bone weights.
-         *
-         * After the third pass, all the metadata to describe the file data has been extracted, and
-         * the function can start making the VAO, and VBO. The last significant byte
-         * of the vertex groups variable is masked off, and switch()ed against the vertex group codes.
-         * Vertex attribute pointers are created for the specific offset and stride of the vertex
-         * group. The first vertex group will be at layout position 0, the second at 1, the third at 2, and soforth.
-         *
-         *
-         */
-    }
+static inline bool host_is_little_endian ( void )
+{
 
-    // Argument check
-    #ifndef NDEBUG
-        if ( part == (void *) 0 ) goto no_part;
-        if ( path == (void *) 0 ) goto no_path;
-    #endif
+    // Initialized data
+    const u16 one = 1;
+
+    return *(const u8 *) &one == 1;
+}
 
-    // Uninitialized data
-    GXInstance_t  *p_instance  = g_get_active_instance();
-    size_t         vertices_in_buffer = 0,
-                   indices_in_buffer = 0;
+static const u8 *map_file ( const char *path, size_t *p_size )
+{
 
-    char          *c_data = 0;
-    float         *vertex_array = 0;
-    GXPLYindex_t  *indices = 0;
-    u32           *corrected_indicies = 0;
+    #ifdef _WIN32
 
-    // Initialized data
-    size_t         i                  = g_load_file(path, 0, true),
-                   j                  = 0,
-                   k                  = 0,
-                   vertex_group_count   = 0,
-                   vertex_attrib_offset = 0,
-                   icount               = 0;
-    char          *data                 = calloc(i, sizeof(u8));
-    GXply_file_t   *ply_file            = calloc(1, sizeof(GXply_file_t));
-
-    // Load the file
-    if ( g_load_file(path, data, true) == 0 ) goto failed_to_load_file;
-
-    // Reset counter
-    i = 0;
-
-    // Populate the PLY file
-    {
+        // Initialized data
+        HANDLE         file    = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, 0, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, 0),
+                       mapping = 0;
+        LARGE_INTEGER  size    = { 0 };
+        const u8      *p       = 0;
 
-        // Make sure the header isn't corrupted
-        if ( *(u32*)data != GXPLY_HSignature ) goto invalidHeader;
+        if ( file == INVALID_HANDLE_VALUE ) return 0;
 
-        // Copy of data pointer
-        c_data = data;
+        // An empty file can't be mapped
+        if ( GetFileSizeEx(file, &size) && size.QuadPart > 0 )
+            mapping = CreateFileMappingA(file, 0, PAGE_READONLY, 0, 0, 0);
 
-        // Pass 1
-        while ( *(u32*)c_data != GXPLY_HEnd )
+        // The view keeps the mapping alive after its handles are closed
+        if ( mapping )
         {
-            // Check the first four bytes of the line
-            if ( *(u32*)c_data == GXPLY_HElement )
-                ply_file->n_elements++;
+            p = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+            CloseHandle(mapping);
+        }
 
-            // Here is as good a place as any to look for comments
-            #ifndef NDEBUG
-                if ( *(u32*)c_data == GXPLY_HComment )
-                {
-                    i = 0;
-                    while ( c_data[++i] != '\n' );
-                }
-            #endif
+        CloseHandle(file);
 
-            // Zero set the index
-            i = 0;
-            while (c_data[++i] != '\n'); // Skip to the end of the line
-            c_data = &c_data[i + 1];      // Set the pointer
-        }
+        *p_size = (size_t) size.QuadPart;
 
-        // Allocate for PLY file elements
-        ply_file->elements = calloc(ply_file->n_elements+1, sizeof(GXPLYelement_t));
+        return p;
+    #else
 
-        // Copy the data pointer again
-        c_data = data;
+        // Initialized data
+        int          fd = open(path, O_RDONLY);
+        struct stat  st = { 0 };
+        void        *p  = MAP_FAILED;
 
-        // Pass 2
-        {
-            while (*(u32*)c_data != GXPLY_HEnd)
-            {
+        if ( fd == -1 ) return 0;
 
-                // Check if iterator is on an element
-                if (*(u32*)c_data == GXPLY_HElement)
-                {
-                    // TODO: Dynamically determine size.
-                    char *l = strchr(c_data+8, ' ');
-                    size_t n_len = l-(c_data+8);
-                    ply_file->elements[j].name = calloc(n_len+1, sizeof(u8));
-                    strncpy(ply_file->elements[j].name, c_data+8, n_len);
+        // An empty file can't be mapped
+        if ( fstat(fd, &st) == 0 && st.st_size > 0 )
+            p = mmap(0, (size_t) st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
 
-                    ply_file->elements[j].n_count = atoi(c_data + 8 + n_len+1);
+        // The mapping keeps the file alive after it is closed
+        close(fd);
 
-                    i = 0;
-                    while (c_data[++i] != '\n'); // Skip to the end of the line
-                    c_data = &c_data[i + 1];      // Set the pointer
+        if ( p == MAP_FAILED ) return 0;
 
-                    // Check if iterator is on a property
-                    while (*(u32*)c_data == GXPLY_HProperty)
-                    {
-                        // Increment properties
-                        ply_file->elements[j].n_properties += 1;
+        // The file is read once, front to back. Start reading ahead now
+        (void) madvise(p, (size_t) st.st_size, MADV_SEQUENTIAL);
+        (void) madvise(p, (size_t) st.st_size, MADV_WILLNEED);
 
-                        // Zero set the index
-                        i = 0;
-                        while (c_data[++i] != '\n'); // Skip to the end of the line
-                        c_data = &c_data[i + 1];      // Set the pointer
-                    }
+        *p_size = (size_t) st.st_size;
 
-                    goto p2propertyExit;
+        return p;
+    #endif
+}
 
-                    // TODO: Copy out the name, count, and veretx count
-                }
+static void unmap_file ( const u8 *p, size_t size )
+{
+    #ifdef _WIN32
+        (void) size;
+        UnmapViewOfFile(p);
+    #else
+        munmap((void *) p, size);
+    #endif
+}
 
-                // Zero set the index
-                i = 0;
-                while (c_data[++i] != '\n'); // Skip to the end of the line
-                c_data = &c_data[i + 1];      // Set the pointer
-                continue;
+static ply_type_t parse_ply_type ( const char *token, size_t len )
+{
 
-                // Allocate space for the properties
-            p2propertyExit:
-                ply_file->elements[j].properties = calloc(ply_file->elements[j].n_properties, sizeof(GXPLYproperty_t));
-                j++;
-            }
-        }
+    // Initialized data
+    static const struct { const char *name; ply_type_t type; } types[] = {
+        { "char"   , ply_type_int8    }, { "int8"   , ply_type_int8    },
+        { "uchar"  , ply_type_uint8   }, { "uint8"  , ply_type_uint8   },
+        { "short"  , ply_type_int16   }, { "int16"  , ply_type_int16   },
+        { "ushort" , ply_type_uint16  }, { "uint16" , ply_type_uint16  },
+        { "int"    , ply_type_int32   }, { "int32"  , ply_type_int32   },
+        { "uint"   , ply_type_uint32  }, { "uint32" , ply_type_uint32  },
+        { "float"  , ply_type_float32 }, { "float32", ply_type_float32 },
+        { "double" , ply_type_float64 }, { "float64", ply_type_float64 }
+    };
+
+    for (size_t i = 0; i < sizeof(types) / sizeof(*types); i++)
+        if ( strlen(types[i].name) == len && memcmp(types[i].name, token, len) == 0 )
+            return types[i].type;
+
+    return ply_type_none;
+}
 
-        // Zero set j
-        j ^= j;
+static size_t split_ply_line ( const char *line, const char *eol, const char **tokens, size_t *lengths )
+{
 
-        // Copy data pointer again
-        c_data = data;
+    // Initialized data
+    size_t count = 0;
 
-        // Pass 3
-        {
-            while (*(u32*)c_data != GXPLY_HEnd)
-            {
+    while ( line < eol && count < PLY_MAX_TOKENS )
+    {
 
-                // Check if iterator is on an element
-                if (*(u32*)c_data == GXPLY_HElement)
-                {
-                    // TODO: Dynamically determine size.
+        // Skip whitespace, and the carriage return of a CRLF header
+        while ( line < eol && ( *line == ' ' || *line == '\t' || *line == '\r' ) ) line++;
 
-                    i = 0;
-                    while (c_data[++i] != '\n'); // Skip to the end of the line
-                    c_data = &c_data[i + 1];      // Set the pointer
+        if ( line == eol ) break;
 
-                    // Check if iterator is on a property
-                    while (*(u32*)c_data == GXPLY_HProperty)
-                    {
-                        // Increment properties
-                        c_data += 9;
-
-                        // Compute stride and type size for each element and property respectively
-                        switch (*(u32*)c_data)
-                        {
-                        case GXPLY_char:
-                        case GXPLY_uchar:
-                            ply_file->elements[j].s_stride                += 1;
-                            ply_file->elements[j].properties[k].type_size =  1;
-                            break;
-                        case GXPLY_short:
-                        case GXPLY_ushort:
-                            ply_file->elements[j].s_stride                += 2;
-                            ply_file->elements[j].properties[k].type_size =  2;
-                            break;
-                        case GXPLY_int:
-                        case GXPLY_uint:
-                        case GXPLY_float:
-                            ply_file->elements[j].s_stride                += 4;
-                            ply_file->elements[j].properties[k].type_size =  4;
-                            break;
-                        case GXPLY_list:
-                            goto p3propertyExit;
-                            break;
-                        case GXPLY_double:
-                            goto noDoubleSupport;
-                            break;
-                        default:
-                            goto unrecognizedPropertyType;
-                            break;
-
-                        }
-
-                        c_data                 = strchr(c_data, ' ') + 1;
-                        size_t propertyLength = strchr(c_data, '\n') - c_data;
-
-                        ply_file->elements[j].properties[k].name = calloc(propertyLength + 1, sizeof(u8));
-                        strncpy(ply_file->elements[j].properties[k].name, c_data, propertyLength);
-
-                        // Zero set the index
-                        i = 0;
-                        while (c_data[++i] != '\n'); // Skip to the end of the line
-                        c_data = &c_data[i + 1];      // Set the pointer
-                        k++;
-                    }
-                    goto p3propertyExit;
+        tokens[count] = line;
 
-                }
+        while ( line < eol && *line != ' ' && *line != '\t' && *line != '\r' ) line++;
 
-                // Zero set the index
-                i = 0;
-                while (c_data[++i] != '\n'); // Skip to the end of the line
-                c_data = &c_data[i + 1];      // Set the pointer
-                continue;
+        lengths[count] = (size_t)(line - tokens[count]);
+        count++;
+    }
 
-                p3propertyExit:j++;
-            }
-        }
+    return count;
+}
 
-        // Pass 4
-        {
-            // Build faces
-            GXPLYindex_t *indices =  (GXPLYindex_t *)(c_data+11+ply_file->elements[0].n_count * ply_file->elements[0].s_stride);
-            corrected_indicies = calloc(12, ply_file->elements[1].n_count);
+static bool token_is ( const char *token, size_t len, const char *text )
+{
+    return strlen(text) == len && memcmp(token, text, len) == 0;
+}
+
+static void copy_ply_name ( char *name, const char *token, size_t len )
+{
+
+    // Long names are truncated
+    if ( len > PLY_MAX_NAME - 1 ) len = PLY_MAX_NAME - 1;
+
+    memcpy(name, token, len);
+    name[len] = '\0';
+}
+
+static size_t read_ply_count ( const u8 *p, ply_type_t type, bool swap )
+{
 
-            for (size_t i = 0; i < ply_file->elements[1].n_count; i++)
-                corrected_indicies[i*3]     = indices[i].a,
-                corrected_indicies[(i*3)+1] = indices[i].b,
-                corrected_indicies[(i*3)+2] = indices[i].c;
+    // Negative counts and indices become huge, and fail the bounds checks of the caller
+    switch ( type )
+    {
+        case ply_type_int8:   return (size_t)(i64)(signed char) *p;
+        case ply_type_uint8:  return (size_t) *p;
+        case ply_type_int16:
+        case ply_type_uint16:
+        {
+            u16 v;
+            memcpy(&v, p, sizeof(v));
+            if ( swap ) v = swap_16(v);
+            return ( type == ply_type_int16 ) ? (size_t)(i64)(i16) v : (size_t) v;
+        }
+        case ply_type_int32:
+        case ply_type_uint32:
+        {
+            u32 v;
+            memcpy(&v, p, sizeof(v));
+            if ( swap ) v = swap_32(v);
+            return ( type == ply_type_int32 ) ? (size_t)(i64)(i32) v : (size_t) v;
         }
+        default: return SIZE_MAX;
     }
+}
+
+static const u8 *parse_ply_header ( GXPLY_t *p_ply )
+{
 
-    // Create flags
+    // Initialized data
+    const char     *p         = (const char *) p_ply->file,
+                   *end       = p + p_ply->file_size;
+    GXPLYElement_t *p_element = 0;
+
+    // Check the signature
+    if ( p_ply->file_size < 4 || memcmp(p, "ply", 3) || ( p[3] != '\n' && p[3] != '\r' ) ) return 0;
+
+    // One pass over the header
+    while ( p < end )
     {
 
         // Initialized data
-        int tflags = 0;
+        const char *eol                     = memchr(p, '\n', (size_t)(end - p)),
+                   *tokens[PLY_MAX_TOKENS]  = { 0 };
+        size_t      lengths[PLY_MAX_TOKENS] = { 0 },
+                    token_count             = 0;
 
-        // Determine what properties are in the file
-        {
-            for (int a = 0; a < 1; a++)
-                for (int b = 0; b < ply_file->elements[a].n_properties; b++)
-                    if (*ply_file->elements[a].properties[b].name == 'x')
-                    {
-                        ply_file->flags <<= 8;
-                        ply_file->flags |= (GXPLY_Geometric);
-                        tflags |= GXPLY_X;
-                        vertex_group_count++;
-                    }
-                    else if (*ply_file->elements[a].properties[b].name == 'y')
-                        tflags |= GXPLY_Y;
-                    else if (*ply_file->elements[a].properties[b].name == 'z')
-                        tflags |= GXPLY_Z;
-                    else if (strncmp(ply_file->elements[a].properties[b].name, "tx", 2) == 0)
-                    {
-                        ply_file->flags <<= 8;
-                        ply_file->flags |= (GXPLY_Tangent);
-                        tflags |= GXPLY_TX;
-                        vertex_group_count++;
-                    }
-                    else if (strncmp(ply_file->elements[a].properties[b].name, "ty", 2) == 0)
-                        tflags |= GXPLY_TY;
-                    else if (strncmp(ply_file->elements[a].properties[b].name, "tz", 2) == 0)
-                        tflags |= GXPLY_TZ;
-                    else if (*ply_file->elements[a].properties[b].name == 's')
-                    {
-                        ply_file->flags <<= 8;
-                        ply_file->flags |= (GXPLY_Texture);
-                        tflags |= GXPLY_S;
-                        vertex_group_count++;
-                    }
-                    else if (*ply_file->elements[a].properties[b].name == 't')
-                        tflags |= GXPLY_T;
-                    else if (strncmp(ply_file->elements[a].properties[b].name, "nx", 2) == 0)
-                    {
-                        ply_file->flags <<= 8;
-                        ply_file->flags |= (GXPLY_Normal);
-                        tflags |= GXPLY_NX;
-                        vertex_group_count++;
-                    }
-                    else if (strncmp(ply_file->elements[a].properties[b].name, "ny", 2) == 0)
-                        tflags |= GXPLY_NY;
-                    else if (strncmp(ply_file->elements[a].properties[b].name, "nz", 2) == 0)
-                        tflags |= GXPLY_NZ;
+        // The header ends in the middle of a line
+        if ( eol == 0 ) return 0;
 
-                    else if (strncmp(ply_file->elements[a].properties[b].name, "bx", 2) == 0)
-                    {
-                        ply_file->flags <<= 8;
-                        ply_file->flags |= (GXPLY_Bitangent);
-                        tflags |= (GXPLY_BX);
-                        vertex_group_count++;
-                    }
-                    else if (strncmp(ply_file->elements[a].properties[b].name, "by", 2) == 0)
-                        tflags |= GXPLY_BY;
-                    else if (strncmp(ply_file->elements[a].properties[b].name, "bz", 2) == 0)
-                        tflags |= GXPLY_BZ;
-                    else if (strncmp(ply_file->elements[a].properties[b].name, "red", 3) == 0)
-                    {
-                        ply_file->flags <<= 8;
-                        ply_file->flags  |= (GXPLY_Color);
-                        tflags          |= GXPLY_R;
-                        vertex_group_count++;
-                    }
-                    else if (strncmp(ply_file->elements[a].properties[b].name, "green", 5) == 0)
-                        tflags |= GXPLY_G;
-                    else if (strncmp(ply_file->elements[a].properties[b].name, "blue", 4) == 0)
-                        tflags |= GXPLY_B;
-                    else if (strncmp(ply_file->elements[a].properties[b].name, "alpha", 5) == 0)
-                        tflags |= GXPLY_A;
-                    else if (strncmp(ply_file->elements[a].properties[b].name, "b0", 2) == 0)
-                    {
-                        if (tflags & GXPLY_B1 || tflags & GXPLY_B2 || tflags & GXPLY_B3)
-                            goto irregularVertices;
-                        ply_file->flags <<= 8;
-                        ply_file->flags  |= (GXPLY_Bones);
-                        tflags          |= GXPLY_B0;
-                        vertex_group_count++;
-                    }
-                    else if (strncmp(ply_file->elements[a].properties[b].name, "b1", 2) == 0)
-                        tflags |= GXPLY_B1;
-                    else if (strncmp(ply_file->elements[a].properties[b].name, "b2", 2) == 0)
-                        tflags |= GXPLY_B2;
-                    else if (strncmp(ply_file->elements[a].properties[b].name, "b3", 2) == 0)
-                        tflags |= GXPLY_B3;
-                    else if (strncmp(ply_file->elements[a].properties[b].name, "w0", 2) == 0)
-                    {
-                        ply_file->flags <<= 8;
-                        ply_file->flags  |= (GXPLY_Weights);
-                        tflags          |= GXPLY_BW1;
-                        vertex_group_count++;
-                    }
-                    else if (strncmp(ply_file->elements[a].properties[b].name, "w1", 2) == 0)
-                        tflags |= GXPLY_BW1;
-                    else if (strncmp(ply_file->elements[a].properties[b].name, "w2", 2) == 0)
-                        tflags |= GXPLY_BW2;
-                    else if (strncmp(ply_file->elements[a].properties[b].name, "w3", 2) == 0)
-                        tflags |= GXPLY_BW3;
-        }
-
-        // Check the integrity of the mesh
-        #ifndef NDEBUG
-        {
-            if (ply_file->flags & GXPLY_Geometric &&
-                !( tflags & GXPLY_X &&
-                   tflags & GXPLY_Y &&
-                   tflags & GXPLY_Z ))
-                goto missingVerts;
-
-            if (ply_file->flags & GXPLY_Texture &&
-                !( tflags & GXPLY_S &&
-                   tflags & GXPLY_T ))
-                goto missingVerts;
-
-            if (ply_file->flags & GXPLY_Normal &&
-                !( tflags & GXPLY_NX &&
-                   tflags & GXPLY_NY &&
-                   tflags & GXPLY_NZ ))
-                goto missingVerts;
-
-            if (ply_file->flags & GXPLY_Tangent &&
-                !(tflags & GXPLY_TX &&
-                  tflags & GXPLY_TY &&
-                  tflags & GXPLY_TZ))
-                goto missingVerts;
-
-            if (ply_file->flags & GXPLY_Bitangent &&
-                  !(tflags & GXPLY_BX &&
-                    tflags & GXPLY_BY &&
-                    tflags & GXPLY_BZ))
-                goto missingVerts;
-
-            if (ply_file->flags & GXPLY_Color &&
-                !( tflags & GXPLY_R &&
-                   tflags & GXPLY_G &&
-                   tflags & GXPLY_B ))
-                goto missingVerts;
-
-            if (ply_file->flags & GXPLY_Bones &&
-                !( tflags & GXPLY_B0 &&
-                   tflags & GXPLY_B1 &&
-                   tflags & GXPLY_B2 &&
-                   tflags & GXPLY_B3 ))
-                goto missingVerts;
-
-            if (ply_file->flags & GXPLY_Weights &&
-                !( tflags & GXPLY_BW0 &&
-                   tflags & GXPLY_BW1 &&
-                   tflags & GXPLY_BW2 &&
-                   tflags & GXPLY_BW3 ))
-                goto missingVerts;
-        }
-        #endif
-        goto processVAO;
-        missingVerts:
-            g_print_log("[G10] [PLY] Missing vertex attributes detected in \"%s\"\n",path);
-            goto processVAO;
-        irregularVertices:
-            g_print_log("[G10] [PLY] Detected irregular vertex attribute grouping in \"%s\"\n", path);
-            goto processVAO;
-    }
-    processVAO:
-    c_data = c_data+11;
+        token_count = split_ply_line(p, eol, tokens, lengths);
+        p           = eol + 1;
 
-    vertex_array = (float*)c_data;
-    vertices_in_buffer = ply_file->elements[0].n_count;
-    indices = (GXPLYindex_t *)corrected_indicies;
-    indices_in_buffer = ply_file->elements[1].n_count;
-    part->index_count = indices_in_buffer;
+        // Blank line
+        if ( token_count == 0 ) continue;
 
-    // Populate the part
-    {
+        // Signature
+        else if ( token_is(tokens[0], lengths[0], "ply") ) continue;
+
+        // Comments
+        else if ( token_is(tokens[0], lengths[0], "comment") || token_is(tokens[0], lengths[0], "obj_info") ) continue;
 
-        part->vertex_count = vertices_in_buffer;
-        extern u32 find_memory_type(u32 type_filter, VkMemoryPropertyFlags properties);
+        // Format
+        else if ( token_is(tokens[0], lengths[0], "format") )
+        {
+            if ( token_count < 2 ) return 0;
+
+            if      ( token_is(tokens[1], lengths[1], "binary_little_endian") ) p_ply->format = ply_format_little_endian;
+            else if ( token_is(tokens[1], lengths[1], "binary_big_endian") )    p_ply->format = ply_format_big_endian;
+            else if ( token_is(tokens[1], lengths[1], "ascii") )                p_ply->format = ply_format_ascii;
+            else return 0;
+        }
 
+        // Element
+        else if ( token_is(tokens[0], lengths[0], "element") )
+        {
+            if ( token_count < 3 || p_ply->element_count == PLY_MAX_ELEMENTS ) return 0;
 
-        VkMemoryRequirements memory_requirements = { 0 };
-        VkBufferCreateInfo   buffer_create_info  = {
-            .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
-            .size = ply_file->elements[0].s_stride * vertices_in_buffer,
-            .usage = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
-            .sharingMode = VK_SHARING_MODE_EXCLUSIVE
-        };
-        VkMemoryAllocateInfo allocate_info       = { 0 };
-        void *data = vertex_array;
+            p_element = &p_ply->elements[p_ply->element_count++];
 
-        if ( vkCreateBuffer(p_instance->vulkan.device, &buffer_create_info, 0, &part->vertex_buffer) != VK_SUCCESS )
-            g_print_error("[G10] [PLY] Failed to create vertex buffer");
+            copy_ply_name(p_element->name, tokens[1], lengths[1]);
 
-        vkGetBufferMemoryRequirements(p_instance->vulkan.device, part->vertex_buffer, &memory_requirements);
+            // The count is followed by whitespace, so it is terminated inside the mapping
+            p_element->count = (size_t) strtoull(tokens[2], 0, 10);
+        }
 
-        allocate_info = (VkMemoryAllocateInfo)
+        // Property
+        else if ( token_is(tokens[0], lengths[0], "property") )
         {
-            .sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
-            .allocationSize = memory_requirements.size,
-            .memoryTypeIndex = find_memory_type(memory_requirements.memoryTypeBits, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT)
-        };
 
-        if (vkAllocateMemory(p_instance->vulkan.device, &allocate_info, 0, &part->vertex_buffer_memory))
-            g_print_error("[G10] [PLY] Failed to allocate vertex buffer memory");
+            // Initialized data
+            GXPLYProperty_t *p_property = 0;
+
+            if ( p_element == 0 || p_element->property_count == PLY_MAX_PROPERTIES ) return 0;
+
+            p_property = &p_element->properties[p_element->property_count++];
+
+            // List
+            if ( token_count >= 5 && token_is(tokens[1], lengths[1], "list") )
+            {
+                p_property->count_type = parse_ply_type(tokens[2], lengths[2]);
+                p_property->type       = parse_ply_type(tokens[3], lengths[3]);
+
+                copy_ply_name(p_property->name, tokens[4], lengths[4]);
+
+                // Lists are counted by integers
+                if ( p_property->count_type == ply_type_none || p_property->count_type >= ply_type_float32 ) return 0;
+            }
 
-        vkBindBufferMemory(p_instance->vulkan.device, part->vertex_buffer, part->vertex_buffer_memory, 0);
+            // Scalar
+            else if ( token_count >= 3 )
+            {
+                p_property->type = parse_ply_type(tokens[1], lengths[1]);
+
+                copy_ply_name(p_property->name, tokens[2], lengths[2]);
+            }
+            else return 0;
 
-        vkMapMemory(p_instance->vulkan.device, part->vertex_buffer_memory, 0, buffer_create_info.size, 0, &data);
+            if ( p_property->type == ply_type_none ) return 0;
+        }
 
-        // TODO: Replace w staging
-        memcpy(data, vertex_array, buffer_create_info.size);
+        // End of the header
+        else if ( token_is(tokens[0], lengths[0], "end_header") ) goto done;
 
-        vkUnmapMemory(p_instance->vulkan.device, part->vertex_buffer_memory);
+        // Unknown keyword
+        else return 0;
     }
 
-    {
+    // The file has no end_header
+    return 0;
 
-        part->vertex_count = vertices_in_buffer;
-        extern u32 find_memory_type(u32 type_filter, VkMemoryPropertyFlags properties);
+    done:
 
+    // Compute offsets and strides
+    for (size_t i = 0; i < p_ply->element_count; i++)
+    {
 
-        VkMemoryRequirements* memory_requirements = calloc(1, sizeof(VkMemoryRequirements));
-        VkBufferCreateInfo* buffer_create_info = calloc(1, sizeof(VkBufferCreateInfo));
-        VkMemoryAllocateInfo* allocate_info = calloc(1, sizeof(VkMemoryAllocateInfo));
-        void* data = corrected_indicies;
+        // Initialized data
+        GXPLYElement_t *p_e    = &p_ply->elements[i];
+        size_t          offset = 0;
+        bool            list   = false;
 
+        for (size_t j = 0; j < p_e->property_count; j++)
         {
-            buffer_create_info->sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-            buffer_create_info->size = 12 * indices_in_buffer;
-            buffer_create_info->usage = VK_BUFFER_USAGE_INDEX_BUFFER_BIT;
-            buffer_create_info->sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+            p_e->properties[j].offset = offset;
+
+            if ( p_e->properties[j].count_type != ply_type_none ) list = true;
+
+            if ( list == false ) offset += ply_type_sizes[p_e->properties[j].type];
         }
 
-        if (vkCreateBuffer(p_instance->vulkan.device, buffer_create_info, 0, &part->element_buffer) != VK_SUCCESS)
-            g_print_error("[G10] [PLY] Failed to create element buffer");
+        p_e->stride = ( list ) ? 0 : offset;
+    }
+
+    // Success
+    return (const u8 *) p;
+}
+
+static size_t measure_ply_element ( GXPLYElement_t *p_element, const u8 *p, const u8 *end, bool swap )
+{
+
+    // Initialized data
+    const u8 *start = p;
+
+    // Walk each row
+    for (size_t i = 0; i < p_element->count; i++)
+        for (size_t j = 0; j < p_element->property_count; j++)
+        {
 
-        vkGetBufferMemoryRequirements(p_instance->vulkan.device, part->element_buffer, memory_requirements);
+            // Initialized data
+            GXPLYProperty_t *p_property = &p_element->properties[j];
+            size_t           item_size  = ply_type_sizes[p_property->type],
+                             count      = 1;
 
-        allocate_info->sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-        allocate_info->allocationSize = memory_requirements->size;
-        allocate_info->memoryTypeIndex = find_memory_type(memory_requirements->memoryTypeBits, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+            if ( p_property->count_type != ply_type_none )
+            {
 
+                // Initialized data
+                size_t count_size = ply_type_sizes[p_property->count_type];
 
-        if (vkAllocateMemory(p_instance->vulkan.device, allocate_info, 0, &part->element_buffer_memory))
-            g_print_error("[G10] [PLY] Failed to allocate element buffer memory");
+                if ( (size_t)(end - p) < count_size ) return SIZE_MAX;
 
-        vkBindBufferMemory(p_instance->vulkan.device, part->element_buffer, part->element_buffer_memory, 0);
+                count  = read_ply_count(p, p_property->count_type, swap);
+                p     += count_size;
+            }
 
-        vkMapMemory(p_instance->vulkan.device, part->element_buffer_memory, 0, buffer_create_info->size, 0, &data);
+            if ( count > (size_t)(end - p) / item_size ) return SIZE_MAX;
 
-        // TODO: Replace w staging
-        memcpy(data, corrected_indicies, buffer_create_info->size);
+            p += count * item_size;
+        }
 
-        vkUnmapMemory(p_instance->vulkan.device, part->element_buffer_memory);
+    // Success
+    return (size_t)(p - start);
+}
 
-        free(memory_requirements);
-        free(buffer_create_info);
-        free(allocate_info);
+#ifndef NDEBUG
+static int ply_vertex_groups ( GXPLYElement_t *p_vertex, const char *path )
+{
 
+    // Commentary
+    {
+        /*
+         * Vertex properties are recognized by name, and sorted into common vertex groups.
+         * Each vertex property in a vertex group should appear concurrently. Each group
+         * has an associated byte code.
+         *
+         * ╭─────────────────────┬──────────────────────────────────────────────────┬──────╮
+         * │ Vertex group name   │ Vertex properties as they appear in the PLY file │ Code │
+         * ├─────────────────────┼──────────────────────────────────────────────────┼──────┤
+         * │ Geometric vertices  │ ( x, y, z )                                      │ 0x01 │
+         * │ Texture coordinates │ ( u, v ) or ( s, t )                             │ 0x02 │
+         * │ Vertex normals      │ ( nx, ny, nz )                                   │ 0x04 │
+         * │ Vertex bitangents   │ ( bx, by, bz )                                   │ 0x08 │
+         * │ Vertex tangents     │ ( tx, ty, tz )                                   │ 0x10 │
+         * │ Vertex colors       │ ( red, green, blue, alpha ) or ( r, g, b, a )    │ 0x20 │
+         * │ Bone groups         │ ( b0, b1, b2, b3 )                               │ 0x40 │
+         * │ Bone weights        │ ( w0, w1, w2, w3 )                               │ 0x80 │
+         * ╰─────────────────────┴──────────────────────────────────────────────────┴──────╯
+         *
+         * The codes are packed into a 64 bit number, such that the last vertex group
+         * occupies the eight least significant bits. For example
+         *
+         *        63......................................0
+         *     A. | 00 | 00 | 00 | 00 | 00 | 01 | 04 | 20 |
+         *     B. | 00 | 00 | 00 | 00 | 00 | 04 | 02 | 01 |
+         *
+         *     A. First is geometric, second is normals, third is colors
+         *     B. First is normals, second is texture coordinates, third is geometric
+         */
     }
 
+    // Initialized data
+    u64 flags  = 0;
+    int tflags = 0;
 
-    // Destroy the PLY File
-    //{
-    //    // Depopulate all elements
-    //    for (i = 0; i < ply_file->n_elements; i++)
-    //    {
-    //        // Depopulate all properties of an element
-    //        for (j = 0; j < ply_file->elements[i].n_properties; j++)
-    //        {
-    //           // Free the name of the property
-    //           free(ply_file->elements[i].properties[j].name);
-    //           // Zero set the type_size
-    //           ply_file->elements[i].properties[j].type_size = 0;
-    //        }
-    //        // Free the properties
-    //        free(ply_file->elements[i].properties);
-    //
-    //        // Free the name of the element
-    //        //free(ply_file->elements[i].name);
-    //        // Zero set all the primatives
-    //        ply_file->elements[i].n_count = 0;
-    //        ply_file->elements[i].n_properties = 0;
-    //        ply_file->elements[i].s_stride = 0;
-    //    }
-    //    // Free the elements
-    //    free(ply_file->elements);
-    //    // Zero set all the primatives
-    //    ply_file->flags = 0;
-    //    ply_file->format = 0;
-    //    ply_file->n_elements = 0;
-    //    // Free the ply_file
-    //    free(ply_file);
-    //}
-
-    //free(corrected_indicies);
-    //free(data);
+    // Determine what properties are in the file
+    for (size_t b = 0; b < p_vertex->property_count; b++)
+    {
 
-    return part;
+        // Initialized data
+        const char *name = p_vertex->properties[b].name;
+
+        if (*name == 'x')
+        {
+            flags <<= 8;
+            flags |= (GXPLY_Geometric);
+            tflags |= GXPLY_X;
+        }
+        else if (*name == 'y')
+            tflags |= GXPLY_Y;
+        else if (*name == 'z')
+            tflags |= GXPLY_Z;
+        else if (strncmp(name, "tx", 2) == 0)
+        {
+            flags <<= 8;
+            flags |= (GXPLY_Tangent);
+            tflags |= GXPLY_TX;
+        }
+        else if (strncmp(name, "ty", 2) == 0)
+            tflags |= GXPLY_TY;
+        else if (strncmp(name, "tz", 2) == 0)
+            tflags |= GXPLY_TZ;
+        else if (*name == 's')
+        {
+            flags <<= 8;
+            flags |= (GXPLY_Texture);
+            tflags |= GXPLY_S;
+        }
+        else if (*name == 't')
+            tflags |= GXPLY_T;
+        else if (strncmp(name, "nx", 2) == 0)
+        {
+            flags <<= 8;
+            flags |= (GXPLY_Normal);
+            tflags |= GXPLY_NX;
+        }
+        else if (strncmp(name, "ny", 2) == 0)
+            tflags |= GXPLY_NY;
+        else if (strncmp(name, "nz", 2) == 0)
+            tflags |= GXPLY_NZ;
+        else if (strncmp(name, "bx", 2) == 0)
+        {
+            flags <<= 8;
+            flags |= (GXPLY_Bitangent);
+            tflags |= (GXPLY_BX);
+        }
+        else if (strncmp(name, "by", 2) == 0)
+            tflags |= GXPLY_BY;
+        else if (strncmp(name, "bz", 2) == 0)
+            tflags |= GXPLY_BZ;
+        else if (strncmp(name, "red", 3) == 0)
+        {
+            flags <<= 8;
+            flags  |= (GXPLY_Color);
+            tflags |= GXPLY_R;
+        }
+        else if (strncmp(name, "green", 5) == 0)
+            tflags |= GXPLY_G;
+        else if (strncmp(name, "blue", 4) == 0)
+            tflags |= GXPLY_B;
+        else if (strncmp(name, "alpha", 5) == 0)
+            tflags |= GXPLY_A;
+        else if (strncmp(name, "b0", 2) == 0)
+        {
+            if (tflags & GXPLY_B1 || tflags & GXPLY_B2 || tflags & GXPLY_B3)
+                goto irregular_vertices;
+            flags <<= 8;
+            flags  |= (GXPLY_Bones);
+            tflags |= GXPLY_B0;
+        }
+        else if (strncmp(name, "b1", 2) == 0)
+            tflags |= GXPLY_B1;
+        else if (strncmp(name, "b2", 2) == 0)
+            tflags |= GXPLY_B2;
+        else if (strncmp(name, "b3", 2) == 0)
+            tflags |= GXPLY_B3;
+        else if (strncmp(name, "w0", 2) == 0)
+        {
+            flags <<= 8;
+            flags  |= (GXPLY_Weights);
+            tflags |= GXPLY_BW0;
+        }
+        else if (strncmp(name, "w1", 2) == 0)
+            tflags |= GXPLY_BW1;
+        else if (strncmp(name, "w2", 2) == 0)
+            tflags |= GXPLY_BW2;
+        else if (strncmp(name, "w3", 2) == 0)
+            tflags |= GXPLY_BW3;
+    }
+
+    // Check the integrity of the mesh
+    if ( ( flags & GXPLY_Geometric && !( tflags & GXPLY_X  && tflags & GXPLY_Y  && tflags & GXPLY_Z ) )                       ||
+         ( flags & GXPLY_Texture   && !( tflags & GXPLY_S  && tflags & GXPLY_T ) )                                           ||
+         ( flags & GXPLY_Normal    && !( tflags & GXPLY_NX && tflags & GXPLY_NY && tflags & GXPLY_NZ ) )                     ||
+         ( flags & GXPLY_Tangent   && !( tflags & GXPLY_TX && tflags & GXPLY_TY && tflags & GXPLY_TZ ) )                     ||
+         ( flags & GXPLY_Bitangent && !( tflags & GXPLY_BX && tflags & GXPLY_BY && tflags & GXPLY_BZ ) )                     ||
+         ( flags & GXPLY_Color     && !( tflags & GXPLY_R  && tflags & GXPLY_G  && tflags & GXPLY_B ) )                      ||
+         ( flags & GXPLY_Bones     && !( tflags & GXPLY_B0 && tflags & GXPLY_B1 && tflags & GXPLY_B2 && tflags & GXPLY_B3 ) ) ||
+         ( flags & GXPLY_Weights   && !( tflags & GXPLY_BW0 && tflags & GXPLY_BW1 && tflags & GXPLY_BW2 && tflags & GXPLY_BW3 ) ) )
+        goto missing_vertices;
+
+    // Success
+    return 1;
 
     // Error handling
     {
-        failed_to_load_file:
-            #ifndef NDEBUG
-                g_print_error("[G10] [PLY] Failed to load file %s\n", path);
-            #endif
+        missing_vertices:
+            g_print_log("[G10] [PLY] Missing vertex attributes detected in \"%s\"\n", path);
 
             // Error
             return 0;
 
-        no_part:
-            #ifndef NDEBUG
-                g_print_error("[G10] [PLY] Null pointer provided for parameter \"part\" in call to %s\n", __FUNCTION__);
-            #endif
+        irregular_vertices:
+            g_print_log("[G10] [PLY] Detected irregular vertex attribute grouping in \"%s\"\n", path);
 
             // Error
             return 0;
+    }
+}
+#endif
+
+int map_ply ( GXPLY_t **pp_ply, const char *path )
+{
 
-        no_path:
-            #ifndef NDEBUG
-                g_print_error("[G10] [PLY] Null pointer provided for parameter \"path\" in call to %s\n", __FUNCTION__);
-            #endif
+    // Argument check
+    #ifndef NDEBUG
+        if ( pp_ply == (void *) 0 ) goto no_ply;
+        if ( path   == (void *) 0 ) goto no_path;
+    #endif
 
-            // Error
-            return 0;
+    // Initialized data
+    GXPLY_t  *p_ply  = calloc(1, sizeof(GXPLY_t));
+    const u8 *cursor = 0,
+             *end    = 0;
+    bool      swap   = false;
 
-        invalidHeader:
-            #ifndef NDEBUG
-                g_print_error("[G10] [PLY] Invalid header detected in file \"%s\"\n",path);
-            #endif
+    // Error checking
+    if ( p_ply == (void *) 0 ) goto no_mem;
 
-            // Error
-            return 0;
+    // Map the file
+    p_ply->file = map_file(path, &p_ply->file_size);
 
-        noDoubleSupport:
-            #ifndef NDEBUG
-                g_print_error("[G10] [PLY] Double detected in element \"%s\" in file \"%s\"\n", ply_file->elements[j].name, path);
-            #endif
+    // Error checking
+    if ( p_ply->file == (void *) 0 ) goto failed_to_map_file;
 
-            // Error
-            return 0;
+    // Parse the header
+    cursor = parse_ply_header(p_ply);
 
-        unrecognizedPropertyType:
-            #ifndef NDEBUG
-                g_print_error("[G10] [PLY] Unrecognized property type detected in file \"%s\"\n", path);
-            #endif
+    // Error checking
+    if ( cursor == (void *) 0 ) goto invalid_header;
+    if ( p_ply->format == ply_format_ascii ) goto ascii_format;
 
-            // Error
-            return 0;
+    end  = p_ply->file + p_ply->file_size;
+    swap = ( p_ply->format == ply_format_big_endian ) == host_is_little_endian();
 
-        //nonTriangulated:
-            #ifndef NDEBUG
-                g_print_error("[G10] [PLY] Detected non triangulated faces in file \"%s\"\n", path);
-            #endif
+    // Find the rows of each element
+    for (size_t i = 0; i < p_ply->element_count; i++)
+    {
 
-            // Error
-            return 0;
+        // Initialized data
+        GXPLYElement_t *p_element = &p_ply->elements[i];
+
+        p_element->data = cursor;
+
+        // Fixed rows
+        if ( p_element->stride )
+        {
+            if ( p_element->count > (size_t)(end - cursor) / p_element->stride ) goto truncated_file;
+
+            p_element->size = p_element->count * p_element->stride;
+        }
+
+        // The last element runs to the end of the file. Its lists are checked as they are read
+        else if ( i == p_ply->element_count - 1 )
+            p_element->size = (size_t)(end - cursor);
+
+        // Rows with lists have to be walked to find the next element
+        else
+        {
+            p_element->size = measure_ply_element(p_element, cursor, end, swap);
+
+            if ( p_element->size == SIZE_MAX ) goto truncated_file;
+        }
+
+        cursor += p_element->size;
+    }
+
+    // Check the integrity of the mesh
+    #ifndef NDEBUG
+        if ( get_ply_element(p_ply, "vertex") )
+            (void) ply_vertex_groups(get_ply_element(p_ply, "vertex"), path);
+    #endif
+
+    // Return a pointer to the caller
+    *pp_ply = p_ply;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_ply:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [PLY] Null pointer provided for parameter \"pp_ply\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_path:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [PLY] Null pointer provided for parameter \"path\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // G10 errors
+        {
+            failed_to_map_file:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [PLY] Failed to map file \"%s\" in call to function \"%s\"\n", path, __FUNCTION__);
+                #endif
+
+                // Free the PLY file
+                free(p_ply);
+
+                // Error
+                return 0;
+
+            invalid_header:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [PLY] Invalid header detected in file \"%s\"\n", path);
+                #endif
+
+                // Unmap the PLY file
+                unmap_ply(&p_ply);
+
+                // Error
+                return 0;
+
+            ascii_format:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [PLY] ASCII PLY file \"%s\" is not supported\n", path);
+                #endif
+
+                // Unmap the PLY file
+                unmap_ply(&p_ply);
+
+                // Error
+                return 0;
+
+            truncated_file:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [PLY] File \"%s\" is shorter than its header describes\n", path);
+                #endif
+
+                // Unmap the PLY file
+                unmap_ply(&p_ply);
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    g_print_error("[Standard library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+GXPart_t *load_ply ( GXPart_t *part, const char *path )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( part == (void *) 0 ) goto no_part;
+        if ( path == (void *) 0 ) goto no_path;
+    #endif
+
+    // Initialized data
+    GXPLY_t *p_ply = 0;
+
+    // Map the file
+    if ( map_ply(&p_ply, path) == 0 ) goto failed_to_load_file;
+
+    // Upload the vertices and the faces
+    if ( upload_ply(part, p_ply) == 0 ) goto failed_to_upload;
+
+    // Unmap the file
+    unmap_ply(&p_ply);
+
+    return part;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_part:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [PLY] Null pointer provided for parameter \"part\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_path:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [PLY] Null pointer provided for parameter \"path\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // G10 errors
+        {
+            failed_to_load_file:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [PLY] Failed to load file %s\n", path);
+                #endif
+
+                // Error
+                return 0;
+
+            failed_to_upload:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [PLY] Failed to upload file \"%s\" in call to function \"%s\"\n", path, __FUNCTION__);
+                #endif
+
+                // Unmap the file
+                unmap_ply(&p_ply);
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int upload_ply ( GXPart_t *part, GXPLY_t *p_ply )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( part  == (void *) 0 ) goto no_part;
+        if ( p_ply == (void *) 0 ) goto no_ply;
+    #endif
+
+    // Initialized data
+    const void   *vertices      = 0;
+    const u32    *indices       = 0;
+    size_t        vertex_stride = 0,
+                  vertex_count  = 0,
+                  index_count   = 0;
+
+    // Read the vertices and the faces. Little endian floats are not copied
+    vertices = get_ply_vertices(p_ply, &vertex_stride, &vertex_count);
+    indices  = get_ply_indices(p_ply, &index_count);
+
+    // Error checking
+    if ( vertices == (void *) 0 ) goto no_vertices;
+    if ( indices  == (void *) 0 ) goto no_indices;
+
+    // Copy the vertices and the faces into the buffers of the part
+    if ( upload_part(part, vertices, vertex_stride, vertex_count, indices, sizeof(u32), index_count) == 0 ) goto failed_to_upload_part;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_part:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [PLY] Null pointer provided for parameter \"part\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_ply:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [PLY] Null pointer provided for parameter \"p_ply\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // G10 errors
+        {
+            no_vertices:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [PLY] Failed to read vertices in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_indices:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [PLY] Failed to read faces in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            failed_to_upload_part:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [PLY] Failed to upload part in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+GXPart_t *load_ply_quantized ( GXPart_t *part, const char *path )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( part == (void *) 0 ) goto no_part;
+        if ( path == (void *) 0 ) goto no_path;
+    #endif
+
+    // Initialized data
+    GXPLY_t *p_ply = 0;
+
+    // Map the file
+    if ( map_ply(&p_ply, path) == 0 ) goto failed_to_load_file;
+
+    // Quantize and upload the vertices, and upload the faces
+    if ( upload_ply_quantized(part, p_ply) == 0 ) goto failed_to_upload;
+
+    // Unmap the file
+    unmap_ply(&p_ply);
+
+    return part;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_part:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [PLY] Null pointer provided for parameter \"part\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_path:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [PLY] Null pointer provided for parameter \"path\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // G10 errors
+        {
+            failed_to_load_file:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [PLY] Failed to load file %s\n", path);
+                #endif
+
+                // Error
+                return 0;
+
+            failed_to_upload:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [PLY] Failed to upload file \"%s\" in call to function \"%s\"\n", path, __FUNCTION__);
+                #endif
+
+                // Unmap the file
+                unmap_ply(&p_ply);
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int upload_ply_quantized ( GXPart_t *part, GXPLY_t *p_ply )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( part  == (void *) 0 ) goto no_part;
+        if ( p_ply == (void *) 0 ) goto no_ply;
+    #endif
+
+    // Initialized data
+    GXVertexSource_t  source        = { 0 };
+    vec4              dequantize    = { 0 };
+    const void       *vertices      = 0;
+    const u32        *indices       = 0;
+    u8               *quantized     = 0;
+    u32               groups        = 0;
+    size_t            vertex_stride = 0,
+                      vertex_count  = 0,
+                      index_count   = 0,
+                      stride        = 0;
+
+    // Read the vertices and the faces
+    vertices = get_ply_vertices(p_ply, &vertex_stride, &vertex_count);
+    indices  = get_ply_indices(p_ply, &index_count);
+
+    // Error checking
+    if ( vertices == (void *) 0 ) goto no_vertices;
+    if ( indices  == (void *) 0 ) goto no_indices;
+
+    // Choose the encodings from the vertex groups of the file
+    groups = get_ply_vertex_groups(p_ply, &source),
+    stride = quantized_vertex_stride(groups);
+
+    // Error checking
+    if ( ( groups & VERTEX_GROUP_GEOMETRIC ) == 0 ) goto no_positions;
+
+    quantized = G10_REALLOC(0, vertex_count * stride + 1);
+
+    // Error checking
+    if ( quantized == (void *) 0 ) goto no_mem;
+
+    if ( quantize_vertices(groups, &source, vertices, vertex_stride, vertex_count, quantized, &dequantize) == 0 ) goto failed_to_quantize_vertices;
+
+    // Copy the vertices and the faces into the buffers of the part
+    if ( upload_part(part, quantized, stride, vertex_count, indices, sizeof(u32), index_count) == 0 ) goto failed_to_upload_part;
+
+    part->vertex_groups = groups,
+    part->dequantize    = dequantize;
+
+    // Clean up
+    G10_FREE(quantized);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_part:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [PLY] Null pointer provided for parameter \"part\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_ply:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [PLY] Null pointer provided for parameter \"p_ply\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // G10 errors
+        {
+            no_vertices:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [PLY] Failed to read vertices in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_indices:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [PLY] Failed to read faces in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_positions:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [PLY] Vertices have no x, y, and z in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            failed_to_quantize_vertices:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [PLY] Failed to quantize vertices in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Clean up
+                G10_FREE(quantized);
+
+                // Error
+                return 0;
+
+            failed_to_upload_part:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [PLY] Failed to upload part in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Clean up
+                G10_FREE(quantized);
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    g_print_error("[Standard library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+GXPLYElement_t *get_ply_element ( GXPLY_t *p_ply, const char *name )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( p_ply == (void *) 0 ) goto no_ply;
+        if ( name  == (void *) 0 ) goto no_name;
+    #endif
+
+    for (size_t i = 0; i < p_ply->element_count; i++)
+        if ( strcmp(p_ply->elements[i].name, name) == 0 )
+            return &p_ply->elements[i];
+
+    // Not found
+    return 0;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_ply:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [PLY] Null pointer provided for parameter \"p_ply\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_name:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [PLY] Null pointer provided for parameter \"name\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+// Convert one property of every row to floats. The byte order is fixed for the
+// whole loop, so the branch on swap is hoisted out of it, and the loop vectorizes
+#define PLY_CONVERT(T, U, SWAP)                                     \
+    for (size_t i = 0; i < count; i++)                              \
+    {                                                               \
+        U u;                                                        \
+        T v;                                                        \
+        memcpy(&u, p_in + i * stride, sizeof(U));                   \
+        if ( swap ) u = SWAP(u);                                    \
+        memcpy(&v, &u, sizeof(T));                                  \
+        p_out[i * out_stride] = (float) v;                          \
+    }
+
+#define PLY_NO_SWAP(u) (u)
+
+static void convert_ply_property ( float *p_out, size_t out_stride, const u8 *p_in, size_t stride, size_t count, ply_type_t type, bool swap )
+{
+    switch ( type )
+    {
+        case ply_type_int8:    PLY_CONVERT(signed char, u8 , PLY_NO_SWAP); break;
+        case ply_type_uint8:   PLY_CONVERT(u8 , u8 , PLY_NO_SWAP); break;
+        case ply_type_int16:   PLY_CONVERT(i16, u16, swap_16);     break;
+        case ply_type_uint16:  PLY_CONVERT(u16, u16, swap_16);     break;
+        case ply_type_int32:   PLY_CONVERT(i32, u32, swap_32);     break;
+        case ply_type_uint32:  PLY_CONVERT(u32, u32, swap_32);     break;
+        case ply_type_float32: PLY_CONVERT(f32, u32, swap_32);     break;
+        case ply_type_float64: PLY_CONVERT(f64, u64, swap_64);     break;
+        default: break;
+    }
+}
+
+#undef PLY_NO_SWAP
+#undef PLY_CONVERT
+
+const void *get_ply_vertices ( GXPLY_t *p_ply, size_t *p_stride, size_t *p_count )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( p_ply    == (void *) 0 ) goto no_ply;
+        if ( p_stride == (void *) 0 ) goto no_stride;
+        if ( p_count  == (void *) 0 ) goto no_count;
+    #endif
+
+    // Initialized data
+    GXPLYElement_t *p_vertex   = get_ply_element(p_ply, "vertex");
+    bool            swap       = false,
+                    all_floats = true;
+    size_t          n          = 0;
+    float          *p_out      = 0;
+
+    // Error checking
+    if ( p_vertex == (void *) 0 ) goto no_vertex_element;
+    if ( p_vertex->stride == 0 ) goto vertex_list;
+
+    n    = p_vertex->property_count;
+    swap = ( p_ply->format == ply_format_big_endian ) == host_is_little_endian();
+
+    for (size_t i = 0; i < n; i++)
+        if ( p_vertex->properties[i].type != ply_type_float32 ) all_floats = false;
+
+    *p_count = p_vertex->count;
+
+    // The file already holds what the GPU reads. Use it in place
+    if ( all_floats && swap == false )
+    {
+        *p_stride = p_vertex->stride;
+
+        // Success
+        return p_vertex->data;
+    }
+
+    *p_stride = n * sizeof(float);
+
+    // Already converted
+    if ( p_ply->vertices ) return p_ply->vertices;
+
+    // Allocate for the converted vertices
+    p_out = G10_REALLOC(p_ply->vertices, p_vertex->count * n * sizeof(float) + 1);
+
+    // Error checking
+    if ( p_out == (void *) 0 ) goto no_mem;
+
+    p_ply->vertices = p_out;
+
+    // Floats of the other byte order. Every word is swapped, so the rows don't matter
+    if ( all_floats )
+    {
+
+        // Initialized data
+        const u8 *p_in  = p_vertex->data;
+        size_t    words = p_vertex->count * n;
+
+        for (size_t i = 0; i < words; i++)
+        {
+            u32 u;
+            memcpy(&u, p_in + i * sizeof(u32), sizeof(u32));
+            u = swap_32(u);
+            memcpy(&p_out[i], &u, sizeof(u32));
+        }
+    }
+
+    // Mixed types. One loop per property
+    else
+        for (size_t i = 0; i < n; i++)
+            convert_ply_property(p_out + i, n, p_vertex->data + p_vertex->properties[i].offset, p_vertex->stride, p_vertex->count, p_vertex->properties[i].type, swap);
+
+    // Success
+    return p_out;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_ply:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [PLY] Null pointer provided for parameter \"p_ply\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_stride:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [PLY] Null pointer provided for parameter \"p_stride\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_count:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [PLY] Null pointer provided for parameter \"p_count\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // G10 errors
+        {
+            no_vertex_element:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [PLY] PLY file has no vertex element in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            vertex_list:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [PLY] List properties of vertices are not supported in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    g_print_error("[Standard library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+static size_t walk_ply_faces ( GXPLYElement_t *p_face, size_t list, bool swap, u32 *p_out )
+{
+
+    // Initialized data
+    const u8 *p     = p_face->data,
+             *end   = p_face->data + p_face->size;
+    size_t    total = 0;
+
+    // Walk each row. The first pass counts, the second writes
+    for (size_t i = 0; i < p_face->count; i++)
+        for (size_t j = 0; j < p_face->property_count; j++)
+        {
+
+            // Initialized data
+            GXPLYProperty_t *p_property = &p_face->properties[j];
+            size_t           item_size  = ply_type_sizes[p_property->type],
+                             count      = 1;
+
+            if ( p_property->count_type != ply_type_none )
+            {
+
+                // Initialized data
+                size_t count_size = ply_type_sizes[p_property->count_type];
+
+                if ( (size_t)(end - p) < count_size ) return SIZE_MAX;
+
+                count  = read_ply_count(p, p_property->count_type, swap);
+                p     += count_size;
+            }
+
+            if ( count > (size_t)(end - p) / item_size ) return SIZE_MAX;
+
+            // Split the polygon into a fan
+            if ( j == list && count >= 3 )
+            {
+                if ( p_out )
+                {
+
+                    // Initialized data
+                    u32 first = (u32) read_ply_count(p, p_property->type, swap),
+                        prev  = (u32) read_ply_count(p + item_size, p_property->type, swap);
+
+                    for (size_t k = 2; k < count; k++)
+                    {
+
+                        // Initialized data
+                        u32 next = (u32) read_ply_count(p + k * item_size, p_property->type, swap);
+
+                        p_out[total + 0] = first,
+                        p_out[total + 1] = prev,
+                        p_out[total + 2] = next;
+
+                        prev = next;
+                        total += 3;
+                    }
+                }
+                else
+                    total += ( count - 2 ) * 3;
+            }
+
+            p += count * item_size;
+        }
+
+    // Success
+    return total;
+}
+
+const u32 *get_ply_indices ( GXPLY_t *p_ply, size_t *p_count )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( p_ply   == (void *) 0 ) goto no_ply;
+        if ( p_count == (void *) 0 ) goto no_count;
+    #endif
+
+    // Initialized data
+    GXPLYElement_t *p_face = get_ply_element(p_ply, "face");
+    size_t          list   = SIZE_MAX,
+                    total  = 0;
+    bool            swap   = false;
+    u32            *p_out  = 0;
+
+    // Error checking
+    if ( p_face == (void *) 0 ) goto no_face_element;
+
+    // Already triangulated
+    if ( p_ply->indices )
+    {
+        *p_count = p_ply->index_count;
+
+        return p_ply->indices;
+    }
+
+    swap = ( p_ply->format == ply_format_big_endian ) == host_is_little_endian();
+
+    // Find the list of vertices. Fall back to the first list
+    for (size_t i = 0; i < p_face->property_count; i++)
+    {
+        if ( p_face->properties[i].count_type == ply_type_none ) continue;
+
+        if ( strcmp(p_face->properties[i].name, "vertex_indices") == 0 || strcmp(p_face->properties[i].name, "vertex_index") == 0 )
+        {
+            list = i;
+            break;
+        }
+
+        if ( list == SIZE_MAX ) list = i;
+    }
+
+    // Error checking
+    if ( list == SIZE_MAX ) goto no_face_list;
+    if ( p_face->properties[list].type >= ply_type_float32 ) goto no_face_list;
+
+    // Triangles of 32 bit indices, and nothing else. Copy each row without walking it
+    if ( p_face->property_count                 == 1              &&
+         p_face->properties[0].count_type       <= ply_type_uint8 &&
+         ply_type_sizes[p_face->properties[0].type] == sizeof(u32)   &&
+         p_face->count <= p_face->size / 13 )
+    {
+
+        // Initialized data
+        const u8 *p_in = p_face->data;
+        size_t    i    = 0;
+
+        p_out = G10_REALLOC(p_ply->indices, p_face->count * 3 * sizeof(u32) + 1);
+
+        // Error checking
+        if ( p_out == (void *) 0 ) goto no_mem;
+
+        p_ply->indices = p_out;
+
+        for (; i < p_face->count; i++, p_in += 13)
+        {
+
+            // A polygon. Triangulate everything from the start
+            if ( p_in[0] != 3 ) break;
+
+            memcpy(&p_out[i * 3], p_in + 1, 3 * sizeof(u32));
+        }
+
+        if ( i == p_face->count )
+        {
+            total = p_face->count * 3;
+
+            if ( swap )
+                for (size_t j = 0; j < total; j++)
+                    p_out[j] = swap_32(p_out[j]);
+
+            goto done;
+        }
+    }
+
+    // Count the triangles
+    total = walk_ply_faces(p_face, list, swap, 0);
+
+    // Error checking
+    if ( total == SIZE_MAX ) goto truncated_faces;
+
+    // Allocate for the indices
+    p_out = G10_REALLOC(p_ply->indices, total * sizeof(u32) + 1);
+
+    // Error checking
+    if ( p_out == (void *) 0 ) goto no_mem;
+
+    p_ply->indices = p_out;
+
+    // Write the triangles
+    walk_ply_faces(p_face, list, swap, p_out);
+
+    done:
+
+    // Check each index against the vertices
+    {
+
+        // Initialized data
+        GXPLYElement_t *p_vertex     = get_ply_element(p_ply, "vertex");
+        size_t          vertex_count = ( p_vertex ) ? p_vertex->count : 0;
+
+        for (size_t i = 0; i < total; i++)
+            if ( p_out[i] >= vertex_count ) goto index_out_of_range;
+    }
+
+    p_ply->index_count = total;
+    *p_count           = total;
+
+    // Success
+    return p_out;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_ply:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [PLY] Null pointer provided for parameter \"p_ply\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_count:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [PLY] Null pointer provided for parameter \"p_count\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // G10 errors
+        {
+            no_face_element:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [PLY] PLY file has no face element in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_face_list:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [PLY] Faces have no list of integer vertex indices in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            truncated_faces:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [PLY] Faces run past the end of the file in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Don't leave rows of the fast path behind for the next call
+                G10_FREE(p_ply->indices);
+                p_ply->indices = 0;
+
+                // Error
+                return 0;
+
+            index_out_of_range:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [PLY] Face refers to a vertex that does not exist in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Don't return the indices from the next call
+                G10_FREE(p_ply->indices);
+                p_ply->indices = 0;
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    g_print_error("[Standard library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+u32 get_ply_vertex_groups ( GXPLY_t *p_ply, GXVertexSource_t *p_source )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( p_ply    == (void *) 0 ) goto no_ply;
+        if ( p_source == (void *) 0 ) goto no_source;
+    #endif
+
+    // Initialized data
+    GXPLYElement_t *p_vertex = get_ply_element(p_ply, "vertex");
+    u32             groups   = 0;
+
+    memset(p_source, 0, sizeof(GXVertexSource_t));
+
+    // No vertices
+    if ( p_vertex == (void *) 0 ) return 0;
+
+    // Find each group under either of its spellings
+    for (size_t g = 0; g < VERTEX_GROUP_COUNT; g++)
+    {
+        for (size_t s = 0; s < 2 && p_source->counts[g] == 0; s++)
+        {
+
+            // Initialized data
+            size_t count = 0;
+
+            // Find each property of the group, in order
+            for (; count < 4 && ply_group_properties[g][s][count]; count++)
+            {
+
+                // Initialized data
+                size_t i = 0;
+
+                while ( i < p_vertex->property_count && strcmp(p_vertex->properties[i].name, ply_group_properties[g][s][count]) ) i++;
+
+                // Missing property
+                if ( i == p_vertex->property_count ) break;
+
+                p_source->properties[g][count] = i;
+            }
+
+            // Every property, or every color but alpha
+            if ( ply_group_properties[g][s][0] && ( count == 4 || ply_group_properties[g][s][count] == 0 || ( g == 5 && count == 3 ) ) )
+                p_source->counts[g] = count;
+        }
+
+        // Error check
+        if ( p_source->counts[g] == 0 ) continue;
+
+        groups |= 1u << g;
+
+        // Colors and weights stored as integers are brought into [0, 1]
+        p_source->scales[g] = 1;
+
+        if ( g == 5 || g == 7 )
+            switch ( p_vertex->properties[p_source->properties[g][0]].type )
+            {
+                case ply_type_uint8:  p_source->scales[g] = 1.f / 255.f;   break;
+                case ply_type_uint16: p_source->scales[g] = 1.f / 65535.f; break;
+                default: break;
+            }
+    }
+
+    // Success
+    return groups;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_ply:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [PLY] Null pointer provided for parameter \"p_ply\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_source:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [PLY] Null pointer provided for parameter \"p_source\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int unmap_ply ( GXPLY_t **pp_ply )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( pp_ply == (void *) 0 ) goto no_ply;
+    #endif
+
+    // Initialized data
+    GXPLY_t *p_ply = *pp_ply;
+
+    // No more pointer for caller
+    *pp_ply = 0;
+
+    // Error checking
+    if ( p_ply == (void *) 0 ) goto pointer_to_null_pointer;
+
+    // Free converted data
+    G10_FREE(p_ply->vertices);
+    G10_FREE(p_ply->indices);
+
+    // Unmap the file
+    if ( p_ply->file ) unmap_file(p_ply->file, p_ply->file_size);
+
+    // Free the PLY file
+    free(p_ply);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_ply:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [PLY] Null pointer provided for parameter \"pp_ply\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            pointer_to_null_pointer:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [PLY] Parameter \"pp_ply\" points to null pointer in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
     }
 }
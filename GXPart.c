@@ -1,4 +1,10 @@
+// Allocations made here are counted against the renderer
+#define G10_ALLOC_TAG alloc_tag_renderer
+
 #include <G10/GXPart.h>
+#include <G10/GXPLY.h>
+#include <G10/GXMesh.h>
+#include <G10/GXCamera.h>
 
 void init_part ( void )
 {
@@ -9,6 +15,48 @@ void init_part ( void )
     p_instance->mutexes.part_cache = SDL_CreateMutex();
 }
 
+// Move the buffers of a loaded PLY file into the part that asked for it
+static void adopt_part_asset ( GXAsset_t *p_asset, void *vp_part )
+{
+
+    // Initialized data
+    GXPart_t *p_part = vp_part;
+
+    // The file failed to load
+    if ( p_asset->state != asset_state_done ) return;
+
+    // Another part of the same file took the buffers. Load buffers of its own
+    if ( p_asset->part.vertex_buffer == 0 )
+    {
+        if ( p_asset->type == asset_type_quantized_part )
+            (void) load_ply_quantized(p_part, p_asset->path);
+        else
+            (void) load_ply(p_part, p_asset->path);
+
+        return;
+    }
+
+    p_part->vertex_buffer         = p_asset->part.vertex_buffer,
+    p_part->element_buffer        = p_asset->part.element_buffer,
+    p_part->vertex_buffer_memory  = p_asset->part.vertex_buffer_memory,
+    p_part->element_buffer_memory = p_asset->part.element_buffer_memory,
+    p_part->vertex_count          = p_asset->part.vertex_count,
+    p_part->index_count           = p_asset->part.index_count,
+    p_part->index_size            = sizeof(u32),
+    p_part->vertex_groups         = p_asset->part.vertex_groups,
+    p_part->dequantize            = p_asset->part.dequantize,
+    p_part->lod_count             = 1,
+    p_part->lods[0].first_index   = 0,
+    p_part->lods[0].index_count   = (u32) ( p_asset->part.index_count * 3 ),
+    p_part->lods[0].error         = 0;
+
+    // The part owns the buffers now
+    p_asset->part.vertex_buffer         = 0,
+    p_asset->part.element_buffer        = 0,
+    p_asset->part.vertex_buffer_memory  = 0,
+    p_asset->part.element_buffer_memory = 0;
+}
+
 int create_part ( GXPart_t **pp_part )
 {
 
@@ -23,6 +71,9 @@ int create_part ( GXPart_t **pp_part )
     // Error check
     if ( p_part == (void *) 0 ) goto no_mem;
 
+    // Count the part
+    G10_STAT_ADD(stat_parts, 1);
+
     // Return a pointer to the caller
     *pp_part = p_part;
 
@@ -221,7 +272,9 @@ int load_part_as_json_value ( GXPart_t **pp_part, JSONValue_t *p_value )
     GXInstance_t *p_instance = g_get_active_instance();
     GXPart_t     *p_part     = 0;
     JSONValue_t  *p_name     = 0,
-                 *p_path     = 0;
+                 *p_path     = 0,
+                 *p_quantize = 0;
+    bool          quantize   = false;
 
     // Parse the JSON as an object
     if ( p_value->type == JSONobject )
@@ -234,12 +287,27 @@ int load_part_as_json_value ( GXPart_t **pp_part, JSONValue_t *p_value )
         p_name = dict_get(part_json, "name");
         p_path = dict_get(part_json, "path");
 
+        // Optional properties
+        p_quantize = dict_get(part_json, "quantize");
+
         // Check for required data
         if ( ! (
             p_name &&
             p_path
         ) )
             goto missing_properties;
+
+        // Upload quantized vertices
+        if ( p_quantize )
+        {
+
+            // Check for the right type
+            if ( p_quantize->type == JSONboolean )
+                quantize = p_quantize->boolean;
+            // Default
+            else
+                goto wrong_quantize_type;
+        }
     }
     // Parse the JSON as a path
     else if ( p_value->type == JSONstring )
@@ -262,11 +330,8 @@ int load_part_as_json_value ( GXPart_t **pp_part, JSONValue_t *p_value )
         // Initialized data
         GXPart_t* p_cache_part = 0;
 
-        // Lock the part cache mutex
-        SDL_LockMutex(p_instance->mutexes.part_cache);
-
-        // Search the cache for the part
-        p_cache_part = g_find_part(p_instance, p_name->string);
+        // Search the cache for the part, or claim the load. Other parts load while this one does
+        p_cache_part = g_claim_part(p_instance, p_name->string);
 
         // If the part is in the cache ...
         if ( p_cache_part )
@@ -277,9 +342,8 @@ int load_part_as_json_value ( GXPart_t **pp_part, JSONValue_t *p_value )
 
             // Write the return
             *pp_part = p_cache_part;
-            p_cache_part->users++;
 
-            // TODO: Fix
+            // Success
             return 1;
         }
     }
@@ -314,16 +378,43 @@ int load_part_as_json_value ( GXPart_t **pp_part, JSONValue_t *p_value )
         // Get a pointer to the PLY loader
         extern GXPart_t* load_ply(GXPart_t * part, const char* path);
 
-        // Load the part as a PLY file
+        // Load the part from a file
         if ( p_path->type == JSONstring )
-            load_ply(p_part, p_path->string);
+        {
+
+            // Initialized data
+            size_t path_len = strlen(p_path->string);
+
+            // Optimized meshes are uploaded as they are in the file
+            if ( path_len > 8 && strcmp(&p_path->string[path_len - 8], ".g10mesh") == 0 )
+            {
+                if ( load_mesh_part(p_part, p_path->string) == 0 ) goto failed_to_load_mesh;
+            }
+
+            // While a scene loads, the asset pipeline reads, decodes, and uploads PLY files. The scene waits for it before it is used
+            else if ( p_instance->context.loading_scene )
+            {
+
+                // Initialized data
+                GXAsset_t *p_asset = 0;
+
+                if ( request_asset(&p_asset, ( quantize ) ? asset_type_quantized_part : asset_type_part, p_path->string, 0, adopt_part_asset, p_part) == 0 ) goto failed_to_request_asset;
+
+                // The callback still runs
+                (void) release_asset(&p_asset);
+            }
+            else if ( quantize )
+                load_ply_quantized(p_part, p_path->string);
+            else
+                load_ply(p_part, p_path->string);
+        }
         //  Default
         else
             goto wrong_path_type;
     }
 
-    // Cache the part
-    g_cache_part(p_instance, p_part);
+    // Cache the part, and wake the threads waiting for it
+    g_settle_part(p_instance, p_name->string, p_part);
 
     // Success
     return 1;
@@ -358,6 +449,9 @@ int load_part_as_json_value ( GXPart_t **pp_part, JSONValue_t *p_value )
                     g_print_error("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
                 #endif
 
+                // Wake the threads waiting for the part
+                g_settle_part(p_instance, p_name->string, 0);
+
                 // Error
                 return 0;
         }
@@ -394,6 +488,17 @@ int load_part_as_json_value ( GXPart_t **pp_part, JSONValue_t *p_value )
                     g_print_error("[G10] [Part] Property \"path\" must be of type [ string ] in call to function \"%s\"\nRefer to gschema: https://schema.g10.app/part.json \n", __FUNCTION__);
                 #endif
 
+                // Wake the threads waiting for the part
+                g_settle_part(p_instance, p_name->string, 0);
+
+                // Error
+                return 0;
+
+            wrong_quantize_type:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Part] Property \"quantize\" must be of type [ boolean ] in call to function \"%s\"\nRefer to gschema: https://schema.g10.app/part.json \n", __FUNCTION__);
+                #endif
+
                 // Error
                 return 0;
         }
@@ -408,11 +513,495 @@ int load_part_as_json_value ( GXPart_t **pp_part, JSONValue_t *p_value )
                 // Error
                 return 0;
 
+            failed_to_load_mesh:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Part] Failed to load mesh \"%s\" in call to function \"%s\"\n", p_path->string, __FUNCTION__);
+                #endif
+
+                // Wake the threads waiting for the part
+                g_settle_part(p_instance, p_name->string, 0);
+
+                // Error
+                return 0;
+
+            failed_to_request_asset:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Part] Failed to request part \"%s\" from the asset pipeline in call to function \"%s\"\n", p_path->string, __FUNCTION__);
+                #endif
+
+                // Wake the threads waiting for the part
+                g_settle_part(p_instance, p_name->string, 0);
+
+                // Error
+                return 0;
+
             failed_to_create_part:
                 #ifndef NDEBUG
                     g_print_error("[G10] [Part] Failed to allocate part  in call to function \"%s\"\n", __FUNCTION__);
                 #endif
 
+                // Wake the threads waiting for the part
+                g_settle_part(p_instance, p_name->string, 0);
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int upload_part ( GXPart_t *p_part, const void *p_vertices, size_t vertex_size, size_t vertex_count, const void *p_indices, size_t index_size, size_t index_count )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( p_part     == (void *) 0 )              goto no_part;
+        if ( p_vertices == (void *) 0 )              goto no_vertices;
+        if ( p_indices  == (void *) 0 )              goto no_indices;
+        if ( index_size != 2 && index_size != 4 )    goto bad_index_size;
+    #endif
+
+    // Initialized data
+    GXInstance_t *p_instance = g_get_active_instance();
+
+    // Get a pointer to the memory type finder
+    extern u32 find_memory_type(u32 type_filter, VkMemoryPropertyFlags properties);
+
+    p_part->vertex_count = vertex_count,
+    p_part->index_count  = index_count / 3,
+    p_part->index_size   = index_size;
+
+    // One level of detail, the whole part
+    p_part->lod_count           = 1,
+    p_part->lods[0].first_index = 0,
+    p_part->lods[0].index_count = (u32) index_count,
+    p_part->lods[0].error       = 0;
+
+    // Populate the vertex buffer
+    {
+
+        // Initialized data
+        VkMemoryRequirements memory_requirements = { 0 };
+        VkBufferCreateInfo   buffer_create_info  = {
+            .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+            .size = vertex_size * vertex_count,
+            .usage = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+            .sharingMode = VK_SHARING_MODE_EXCLUSIVE
+        };
+        VkMemoryAllocateInfo allocate_info       = { 0 };
+        void *data = 0;
+
+        if ( vkCreateBuffer(p_instance->vulkan.device, &buffer_create_info, 0, &p_part->vertex_buffer) != VK_SUCCESS ) goto failed_to_create_vertex_buffer;
+
+        vkGetBufferMemoryRequirements(p_instance->vulkan.device, p_part->vertex_buffer, &memory_requirements);
+
+        allocate_info = (VkMemoryAllocateInfo)
+        {
+            .sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
+            .allocationSize = memory_requirements.size,
+            .memoryTypeIndex = find_memory_type(memory_requirements.memoryTypeBits, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT)
+        };
+
+        if ( vkAllocateMemory(p_instance->vulkan.device, &allocate_info, 0, &p_part->vertex_buffer_memory) != VK_SUCCESS ) goto failed_to_allocate_vertex_buffer_memory;
+
+        G10_STAT_ADD(stat_vertex_buffer_bytes, (i64) memory_requirements.size);
+
+        vkBindBufferMemory(p_instance->vulkan.device, p_part->vertex_buffer, p_part->vertex_buffer_memory, 0);
+
+        vkMapMemory(p_instance->vulkan.device, p_part->vertex_buffer_memory, 0, buffer_create_info.size, 0, &data);
+
+        // TODO: Replace w staging
+        memcpy(data, p_vertices, buffer_create_info.size);
+
+        vkUnmapMemory(p_instance->vulkan.device, p_part->vertex_buffer_memory);
+    }
+
+    // Populate the index buffer
+    {
+
+        // Initialized data
+        VkMemoryRequirements memory_requirements = { 0 };
+        VkBufferCreateInfo   buffer_create_info  = {
+            .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+            .size = index_size * index_count,
+            .usage = VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
+            .sharingMode = VK_SHARING_MODE_EXCLUSIVE
+        };
+        VkMemoryAllocateInfo allocate_info       = { 0 };
+        void* data = 0;
+
+        if ( vkCreateBuffer(p_instance->vulkan.device, &buffer_create_info, 0, &p_part->element_buffer) != VK_SUCCESS ) goto failed_to_create_element_buffer;
+
+        vkGetBufferMemoryRequirements(p_instance->vulkan.device, p_part->element_buffer, &memory_requirements);
+
+        allocate_info = (VkMemoryAllocateInfo)
+        {
+            .sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
+            .allocationSize = memory_requirements.size,
+            .memoryTypeIndex = find_memory_type(memory_requirements.memoryTypeBits, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT)
+        };
+
+        if ( vkAllocateMemory(p_instance->vulkan.device, &allocate_info, 0, &p_part->element_buffer_memory) != VK_SUCCESS ) goto failed_to_allocate_element_buffer_memory;
+
+        G10_STAT_ADD(stat_index_buffer_bytes, (i64) memory_requirements.size);
+
+        vkBindBufferMemory(p_instance->vulkan.device, p_part->element_buffer, p_part->element_buffer_memory, 0);
+
+        vkMapMemory(p_instance->vulkan.device, p_part->element_buffer_memory, 0, buffer_create_info.size, 0, &data);
+
+        // TODO: Replace w staging
+        memcpy(data, p_indices, buffer_create_info.size);
+
+        vkUnmapMemory(p_instance->vulkan.device, p_part->element_buffer_memory);
+    }
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_part:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Part] Null pointer provided for parameter \"p_part\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_vertices:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Part] Null pointer provided for parameter \"p_vertices\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_indices:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Part] Null pointer provided for parameter \"p_indices\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            bad_index_size:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Part] Parameter \"index_size\" must be 2 or 4 in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Vulkan errors
+        {
+            failed_to_create_vertex_buffer:
+                #ifndef NDEBUG
+                    g_print_error("[Vulkan] Failed to create vertex buffer in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            failed_to_allocate_vertex_buffer_memory:
+                #ifndef NDEBUG
+                    g_print_error("[Vulkan] Failed to allocate vertex buffer memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            failed_to_create_element_buffer:
+                #ifndef NDEBUG
+                    g_print_error("[Vulkan] Failed to create element buffer in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            failed_to_allocate_element_buffer_memory:
+                #ifndef NDEBUG
+                    g_print_error("[Vulkan] Failed to allocate element buffer memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int upload_part_meshlets ( GXPart_t *p_part, const GXMeshlet_t *p_meshlets, size_t meshlet_count, const u32 *p_vertices, size_t vertex_count, const u8 *p_triangles, size_t triangle_count )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( p_part      == (void *) 0 ) goto no_part;
+        if ( p_meshlets  == (void *) 0 ) goto no_meshlets;
+        if ( p_vertices  == (void *) 0 ) goto no_vertices;
+        if ( p_triangles == (void *) 0 ) goto no_triangles;
+        if ( meshlet_count == 0 )        goto no_meshlets;
+    #endif
+
+    // Initialized data
+    GXInstance_t *p_instance     = g_get_active_instance();
+    size_t        group_count    = ( meshlet_count + 3 ) / 4,
+                  vertices_size  = vertex_count * sizeof(u32),
+                  triangles_size = ( triangle_count * 3 + 3 ) / 4 * 4;
+
+    // Get a pointer to the memory type finder
+    extern u32 find_memory_type(u32 type_filter, VkMemoryPropertyFlags properties);
+
+    // Each section starts where a storage buffer descriptor may be bound on any device
+    p_part->meshlet_count            = meshlet_count,
+    p_part->meshlet_vertices_offset  = ( meshlet_count * sizeof(GXMeshlet_t) + 255 ) / 256 * 256,
+    p_part->meshlet_triangles_offset = ( p_part->meshlet_vertices_offset + vertices_size + 255 ) / 256 * 256;
+
+    // Bounds of the meshlets, four to a group. Unused lanes are zero
+    p_part->meshlet_bounds = G10_REALLOC(0, group_count * sizeof(GXMeshletBounds_t));
+
+    // Error check
+    if ( p_part->meshlet_bounds == (void *) 0 ) goto no_mem;
+
+    memset(p_part->meshlet_bounds, 0, group_count * sizeof(GXMeshletBounds_t));
+
+    for (size_t i = 0; i < meshlet_count; i++)
+    {
+
+        // Initialized data
+        GXMeshletBounds_t *p_bounds = &p_part->meshlet_bounds[i / 4];
+        GXMeshlet_t        meshlet  = { 0 };
+        size_t             lane     = i % 4;
+
+        // The meshlets may not be aligned, when they are read straight from a file
+        memcpy(&meshlet, (const u8 *) p_meshlets + i * sizeof(GXMeshlet_t), sizeof(GXMeshlet_t));
+
+        p_bounds->center_x[lane] = meshlet.center[0],
+        p_bounds->center_y[lane] = meshlet.center[1],
+        p_bounds->center_z[lane] = meshlet.center[2],
+        p_bounds->radius[lane]   = meshlet.radius,
+        p_bounds->apex_x[lane]   = meshlet.cone_apex[0],
+        p_bounds->apex_y[lane]   = meshlet.cone_apex[1],
+        p_bounds->apex_z[lane]   = meshlet.cone_apex[2],
+        p_bounds->axis_x[lane]   = meshlet.cone_axis[0],
+        p_bounds->axis_y[lane]   = meshlet.cone_axis[1],
+        p_bounds->axis_z[lane]   = meshlet.cone_axis[2],
+        p_bounds->cutoff[lane]   = meshlet.cone_cutoff;
+    }
+
+    // Populate the meshlet buffer
+    {
+
+        // Initialized data
+        VkMemoryRequirements memory_requirements = { 0 };
+        VkBufferCreateInfo   buffer_create_info  = {
+            .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+            .size = p_part->meshlet_triangles_offset + triangles_size,
+            .usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+            .sharingMode = VK_SHARING_MODE_EXCLUSIVE
+        };
+        VkMemoryAllocateInfo allocate_info       = { 0 };
+        u8 *data = 0;
+
+        if ( vkCreateBuffer(p_instance->vulkan.device, &buffer_create_info, 0, &p_part->meshlet_buffer) != VK_SUCCESS ) goto failed_to_create_meshlet_buffer;
+
+        vkGetBufferMemoryRequirements(p_instance->vulkan.device, p_part->meshlet_buffer, &memory_requirements);
+
+        allocate_info = (VkMemoryAllocateInfo)
+        {
+            .sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
+            .allocationSize = memory_requirements.size,
+            .memoryTypeIndex = find_memory_type(memory_requirements.memoryTypeBits, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT)
+        };
+
+        if ( vkAllocateMemory(p_instance->vulkan.device, &allocate_info, 0, &p_part->meshlet_buffer_memory) != VK_SUCCESS ) goto failed_to_allocate_meshlet_buffer_memory;
+
+        G10_STAT_ADD(stat_vertex_buffer_bytes, (i64) memory_requirements.size);
+
+        vkBindBufferMemory(p_instance->vulkan.device, p_part->meshlet_buffer, p_part->meshlet_buffer_memory, 0);
+
+        vkMapMemory(p_instance->vulkan.device, p_part->meshlet_buffer_memory, 0, buffer_create_info.size, 0, (void **) &data);
+
+        // TODO: Replace w staging
+        memset(data, 0, buffer_create_info.size);
+        memcpy(data, p_meshlets, meshlet_count * sizeof(GXMeshlet_t));
+        memcpy(data + p_part->meshlet_vertices_offset, p_vertices, vertices_size);
+        memcpy(data + p_part->meshlet_triangles_offset, p_triangles, triangle_count * 3);
+
+        vkUnmapMemory(p_instance->vulkan.device, p_part->meshlet_buffer_memory);
+    }
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_part:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Part] Null pointer provided for parameter \"p_part\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_meshlets:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Part] Null pointer provided for parameter \"p_meshlets\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_vertices:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Part] Null pointer provided for parameter \"p_vertices\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_triangles:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Part] Null pointer provided for parameter \"p_triangles\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Vulkan errors
+        {
+            failed_to_create_meshlet_buffer:
+                #ifndef NDEBUG
+                    g_print_error("[Vulkan] Failed to create meshlet buffer in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Clean up
+                G10_FREE(p_part->meshlet_bounds);
+                p_part->meshlet_bounds = 0,
+                p_part->meshlet_count  = 0;
+
+                // Error
+                return 0;
+
+            failed_to_allocate_meshlet_buffer_memory:
+                #ifndef NDEBUG
+                    g_print_error("[Vulkan] Failed to allocate meshlet buffer memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Clean up
+                vkDestroyBuffer(p_instance->vulkan.device, p_part->meshlet_buffer, 0);
+                G10_FREE(p_part->meshlet_bounds);
+                p_part->meshlet_buffer = 0,
+                p_part->meshlet_bounds = 0,
+                p_part->meshlet_count  = 0;
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    g_print_error("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Clean up
+                p_part->meshlet_count = 0;
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+size_t select_part_lod ( GXPart_t *p_part, GXTransform_t *p_transform, GXCamera_t *p_camera, float pixel_error )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( p_part      == (void *) 0 ) goto no_part;
+        if ( p_transform == (void *) 0 ) goto no_transform;
+        if ( p_camera    == (void *) 0 ) goto no_camera;
+    #endif
+
+    // Initialized data
+    GXInstance_t *p_instance = g_get_active_instance();
+    mat4          m          = p_transform->model_matrix;
+    float         scale      = 0,
+                  distance   = 0,
+                  focal      = 0;
+    vec3          center     = { 0 };
+    size_t        lod        = 0;
+
+    // Nothing to choose from
+    if ( p_part->lod_count < 2 ) return 0;
+
+    // The longest axis of the world matrix bounds the error in every direction. This includes the scale of every parent
+    scale = sqrtf(fmaxf(fmaxf(
+        m.a * m.a + m.b * m.b + m.c * m.c,
+        m.e * m.e + m.f * m.f + m.g * m.g),
+        m.i * m.i + m.j * m.j + m.k * m.k
+    ));
+
+    // Find the distance from the camera to the nearest point of the bounding sphere. The center is rotated, scaled, and moved into world space
+    center = (vec3)
+    {
+        .x = p_part->center.x * m.a + p_part->center.y * m.e + p_part->center.z * m.i + m.m,
+        .y = p_part->center.x * m.b + p_part->center.y * m.f + p_part->center.z * m.j + m.n,
+        .z = p_part->center.x * m.c + p_part->center.y * m.g + p_part->center.z * m.k + m.o
+    };
+
+    distance = sqrtf(
+        ( center.x - p_camera->view.location.x ) * ( center.x - p_camera->view.location.x ) +
+        ( center.y - p_camera->view.location.y ) * ( center.y - p_camera->view.location.y ) +
+        ( center.z - p_camera->view.location.z ) * ( center.z - p_camera->view.location.z )
+    ) - p_part->radius * scale;
+
+    // The camera is inside the part
+    if ( distance <= p_camera->projection.near_clip ) return 0;
+
+    // Pixels per unit, one unit in front of the camera
+    focal = (float) p_instance->window.height / ( 2.f * tanf(p_camera->projection.fov / 2.f) );
+
+    // Take the coarsest level whose error covers too few pixels to see
+    while ( lod + 1 < p_part->lod_count && p_part->lods[lod + 1].error * scale * focal / distance <= pixel_error )
+        lod++;
+
+    // Success
+    return lod;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_part:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Part] Null pointer provided for parameter \"p_part\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_transform:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Part] Null pointer provided for parameter \"p_transform\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_camera:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Part] Null pointer provided for parameter \"p_camera\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
                 // Error
                 return 0;
         }
@@ -449,6 +1038,14 @@ int part_info ( GXPart_t *p_part )
     if (p_part->vertex_count)
         g_print_log("faces           : %lld\n", p_part->index_count);
 
+    // Print the levels of detail
+    if (p_part->lod_count > 1)
+        g_print_log("levels of detail: %lld\n", p_part->lod_count);
+
+    // Print the vertex groups of quantized vertices
+    if (p_part->vertex_groups)
+        g_print_log("vertex groups   : 0x%02x\n", p_part->vertex_groups);
+
     // Print the user count
     if (p_part->users)
         g_print_log("users           : %lld\n", p_part->users);
@@ -499,12 +1096,34 @@ int destroy_part ( GXPart_t **pp_part )
         // Success
         return 1;
 
+    // Stale every handle to the part
+    if ( p_part->handle )
+        (void) release_handle(p_instance->cache.part_handles, p_part->handle);
+
     // Free the name
     free(p_part->name);
 
     // Free vulkan resources
     {
 
+        // Initialized data
+        VkMemoryRequirements vertex_requirements  = { 0 },
+                             element_requirements = { 0 },
+                             meshlet_requirements = { 0 };
+
+        // Measure the buffers before they are destroyed
+        if ( p_part->vertex_buffer )
+            vkGetBufferMemoryRequirements(p_instance->vulkan.device, p_part->vertex_buffer, &vertex_requirements);
+
+        if ( p_part->element_buffer )
+            vkGetBufferMemoryRequirements(p_instance->vulkan.device, p_part->element_buffer, &element_requirements);
+
+        if ( p_part->meshlet_buffer )
+            vkGetBufferMemoryRequirements(p_instance->vulkan.device, p_part->meshlet_buffer, &meshlet_requirements);
+
+        G10_STAT_ADD(stat_vertex_buffer_bytes, -(i64) ( vertex_requirements.size + meshlet_requirements.size ));
+        G10_STAT_ADD(stat_index_buffer_bytes , -(i64) element_requirements.size);
+
         // Free the vertex buffer
         vkDestroyBuffer(p_instance->vulkan.device, p_part->vertex_buffer, 0);
         vkFreeMemory(p_instance->vulkan.device, p_part->vertex_buffer_memory, 0);
@@ -512,11 +1131,20 @@ int destroy_part ( GXPart_t **pp_part )
         // Free the index buffer
         vkDestroyBuffer(p_instance->vulkan.device, p_part->element_buffer, 0);
         vkFreeMemory(p_instance->vulkan.device, p_part->element_buffer_memory, 0);
+
+        // Free the meshlet buffer
+        vkDestroyBuffer(p_instance->vulkan.device, p_part->meshlet_buffer, 0);
+        vkFreeMemory(p_instance->vulkan.device, p_part->meshlet_buffer_memory, 0);
     }
 
+    // Free the meshlet bounds
+    G10_FREE(p_part->meshlet_bounds);
+
     // Free the part itself
     free(p_part);
 
+    G10_STAT_ADD(stat_parts, -1);
+
     // Success
     return 1;
 
@@ -1,5 +1,46 @@
+// Allocations made here are counted against physics
+#define G10_ALLOC_TAG alloc_tag_physics
+
 #include <G10/GXPhysics.h>
 
+// A run of pairs that share a shape pair
+struct narrowphase_chunk_s
+{
+    size_t begin,
+           end;
+    u32    shape_pair;
+};
+
+// Manifolds written by one thread. Padded, so that two threads never write to the same cache line
+struct narrowphase_thread_s
+{
+    GXManifold_t *manifolds;
+    size_t        manifold_count,
+                  manifold_max;
+    u8            padding[64 - sizeof(void *) - 2 * sizeof(size_t)];
+};
+
+// Narrowphase routines, indexed by shape pair
+static bool (*narrowphase_routines[64])( GXEntity_t *p_a, GXEntity_t *p_b, GXManifold_t *p_manifold ) = { 0 };
+
+// Narrowphase state
+static GXCollisionPair_t          *narrowphase_pairs         = 0,
+                                  *broadphase_pairs          = 0;
+static size_t                      narrowphase_pair_max      = 0,
+                                   broadphase_pair_max       = 0,
+                                   narrowphase_chunk_count   = 0,
+                                   narrowphase_chunk_max     = 0;
+static struct narrowphase_chunk_s *narrowphase_chunks        = 0;
+static struct narrowphase_thread_s narrowphase_threads[NARROWPHASE_MAX_THREADS] = { 0 };
+static SDL_atomic_t                narrowphase_next_chunk    = { 0 },
+                                   narrowphase_thread_count  = { 0 },
+                                   narrowphase_workers       = { 0 };
+static SDL_TLSID                   narrowphase_thread_slot   = 0;
+
+// The last worker to leave the narrowphase wakes the threads waiting on it
+static SDL_mutex                  *narrowphase_idle_lock     = 0;
+static SDL_cond                   *narrowphase_idle          = 0;
+
 void init_physics ( void )
 {
 
@@ -11,9 +52,415 @@ void init_physics ( void )
     p_instance->mutexes.resolve_collision = SDL_CreateMutex();
     // TODO: Add rig mutex
 
+    // Each narrowphase thread gets its own manifold buffer
+    narrowphase_thread_slot = SDL_TLSCreate();
+
+    // Create the lock, and the condition variable, that the narrowphase is waited on with
+    narrowphase_idle_lock = SDL_CreateMutex();
+    narrowphase_idle      = SDL_CreateCond();
+
+    // Default to bounding boxes
+    for (size_t i = 0; i < 64; i++)
+        narrowphase_routines[i] = collide_aabb;
+
+    // Use the most specific test for each shape pair
+    for (size_t i = 0; i < 8; i++)
+        narrowphase_routines[i * 8 + collider_convexhull] = collide_convex_hull;
+
+    narrowphase_routines[collider_box    * 8 + collider_box]    = collide_obb;
+    narrowphase_routines[collider_sphere * 8 + collider_sphere] = collide_sphere;
+
     return;
 }
 
+// Sleep until no worker is testing pairs
+static void wait_for_narrowphase_workers ( void )
+{
+    SDL_LockMutex(narrowphase_idle_lock);
+
+    while ( SDL_AtomicGet(&narrowphase_workers) )
+        SDL_CondWait(narrowphase_idle, narrowphase_idle_lock);
+
+    SDL_UnlockMutex(narrowphase_idle_lock);
+}
+
+// Stop counting the calling thread as a worker, and wake the waiting threads if it was the last
+static void leave_narrowphase ( void )
+{
+
+    // Other workers are still testing pairs
+    if ( SDL_AtomicDecRef(&narrowphase_workers) == SDL_FALSE ) return;
+
+    // Take the lock, so a thread between checking the count and sleeping doesn't miss the wake
+    SDL_LockMutex(narrowphase_idle_lock);
+    SDL_CondBroadcast(narrowphase_idle);
+    SDL_UnlockMutex(narrowphase_idle_lock);
+}
+
+static int compare_broadphase_bounds ( const void *p_a, const void *p_b )
+{
+
+    // Initialized data
+    float a = ((const float *)p_a)[0],
+          b = ((const float *)p_b)[0];
+
+    // Sort by the minimum on the sweep axis
+    return ( a > b ) - ( a < b );
+}
+
+int detect_broadphase ( GXInstance_t *p_instance, GXEntity_t **pp_actors, size_t actor_count )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( p_instance == (void *) 0 ) goto no_instance;
+        if ( pp_actors  == (void *) 0 ) goto no_actors;
+    #endif
+
+    // Bounds of each entity. The sort key comes first
+    struct { float key, min[3], max[3]; GXEntity_t *p_entity; } *bounds = 0;
+
+    // Initialized data
+    GXScratchMark_t scratch     = scratch_mark();
+    size_t          bound_count = 0,
+                    pair_count  = 0,
+                    axis        = 0;
+    double          sum[3]      = { 0 },
+                    sum_sq[3]   = { 0 },
+                    variance    = -1.0;
+
+    // Allocate memory for bounds
+    bounds = scratch_alloc(( actor_count + 1 ) * sizeof(*bounds));
+
+    // Error check
+    if ( bounds == (void *) 0 ) goto no_mem;
+
+    // Compute the world space box of each entity with a collider
+    for (size_t i = 0; i < actor_count; i++)
+    {
+
+        // Initialized data
+        GXEntity_t   *p_entity   = pp_actors[i];
+        GXCollider_t *p_collider = 0;
+
+        // Skip entities that can't collide
+        if ( p_entity == 0 || p_entity->collider == 0 || p_entity->transform == 0 ) continue;
+
+        p_collider = p_entity->collider;
+
+        // Use the bounding volume
+        if ( p_collider->bv )
+        {
+            bounds[bound_count].min[0] = p_collider->bv->minimum.x,
+            bounds[bound_count].min[1] = p_collider->bv->minimum.y,
+            bounds[bound_count].min[2] = p_collider->bv->minimum.z,
+            bounds[bound_count].max[0] = p_collider->bv->maximum.x,
+            bounds[bound_count].max[1] = p_collider->bv->maximum.y,
+            bounds[bound_count].max[2] = p_collider->bv->maximum.z;
+        }
+
+        // Transform the collider's box
+        else
+        {
+
+            // Initialized data
+            mat4  m    = p_entity->transform->model_matrix;
+            vec3  mn   = p_collider->aabb.aabb_min,
+                  mx   = p_collider->aabb.aabb_max;
+            float c[3] = { ( mn.x + mx.x ) * 0.5f, ( mn.y + mx.y ) * 0.5f, ( mn.z + mx.z ) * 0.5f },
+                  h[3] = { ( mx.x - mn.x ) * 0.5f, ( mx.y - mn.y ) * 0.5f, ( mx.z - mn.z ) * 0.5f },
+                  w[3] =
+                  {
+                      c[0] * m.a + c[1] * m.e + c[2] * m.i + m.m,
+                      c[0] * m.b + c[1] * m.f + c[2] * m.j + m.n,
+                      c[0] * m.c + c[1] * m.g + c[2] * m.k + m.o
+                  },
+                  r[3] =
+                  {
+                      h[0] * fabsf(m.a) + h[1] * fabsf(m.e) + h[2] * fabsf(m.i),
+                      h[0] * fabsf(m.b) + h[1] * fabsf(m.f) + h[2] * fabsf(m.j),
+                      h[0] * fabsf(m.c) + h[1] * fabsf(m.g) + h[2] * fabsf(m.k)
+                  };
+
+            for (size_t j = 0; j < 3; j++)
+                bounds[bound_count].min[j] = w[j] - r[j],
+                bounds[bound_count].max[j] = w[j] + r[j];
+        }
+
+        // Accumulate the spread of the centers
+        for (size_t j = 0; j < 3; j++)
+        {
+
+            // Initialized data
+            double c = 0.5 * ( bounds[bound_count].min[j] + bounds[bound_count].max[j] );
+
+            sum[j]    += c,
+            sum_sq[j] += c * c;
+        }
+
+        bounds[bound_count].p_entity = p_entity;
+        bound_count++;
+    }
+
+    // Sweep along the axis with the most spread, so the fewest boxes overlap on it
+    for (size_t j = 0; j < 3; j++)
+    {
+
+        // Initialized data
+        double v = sum_sq[j] - sum[j] * sum[j] / (double) ( bound_count ? bound_count : 1 );
+
+        if ( v > variance )
+            variance = v,
+            axis     = j;
+    }
+
+    for (size_t i = 0; i < bound_count; i++)
+        bounds[i].key = bounds[i].min[axis];
+
+    // Sort along the sweep axis
+    qsort(bounds, bound_count, sizeof(*bounds), compare_broadphase_bounds);
+
+    // Sweep
+    for (size_t i = 0; i < bound_count; i++)
+    {
+        for (size_t j = i + 1; j < bound_count && bounds[j].min[axis] <= bounds[i].max[axis]; j++)
+        {
+
+            // Initialized data
+            u32 a_type = bounds[i].p_entity->collider->type & 7,
+                b_type = bounds[j].p_entity->collider->type & 7;
+
+            // Prune on the other axes
+            if ( bounds[j].min[0] > bounds[i].max[0] || bounds[i].min[0] > bounds[j].max[0] ) continue;
+            if ( bounds[j].min[1] > bounds[i].max[1] || bounds[i].min[1] > bounds[j].max[1] ) continue;
+            if ( bounds[j].min[2] > bounds[i].max[2] || bounds[i].min[2] > bounds[j].max[2] ) continue;
+
+            // Grow the pair list
+            if ( pair_count == broadphase_pair_max )
+            {
+
+                // Initialized data
+                size_t             new_max   = ( broadphase_pair_max ) ? broadphase_pair_max * 2 : 256;
+                GXCollisionPair_t *new_pairs = G10_REALLOC(broadphase_pairs, new_max * sizeof(GXCollisionPair_t));
+
+                // Error check
+                if ( new_pairs == (void *) 0 ) goto no_mem;
+
+                broadphase_pairs    = new_pairs,
+                broadphase_pair_max = new_max;
+            }
+
+            // Add the pair
+            broadphase_pairs[pair_count++] = (GXCollisionPair_t)
+            {
+                .a          = bounds[i].p_entity,
+                .b          = bounds[j].p_entity,
+                .shape_pair = ( a_type < b_type ) ? a_type * 8 + b_type : b_type * 8 + a_type
+            };
+        }
+    }
+
+    // Clean the scope
+    scratch_rewind(scratch);
+
+    // Hand the pairs to the narrowphase
+    if ( begin_narrowphase(p_instance, broadphase_pairs, pair_count) == 0 ) goto failed_to_begin_narrowphase;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_instance:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Physics] Null pointer provided for parameter \"p_instance\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_actors:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Physics] Null pointer provided for parameter \"pp_actors\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    g_print_error("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Clean the scope
+                scratch_rewind(scratch);
+
+                // Error
+                return 0;
+        }
+
+        // G10 errors
+        {
+            failed_to_begin_narrowphase:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Physics] Failed to begin narrowphase in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int begin_narrowphase ( GXInstance_t *p_instance, GXCollisionPair_t *p_pairs, size_t pair_count )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( p_instance == (void *) 0 ) goto no_instance;
+        if ( p_pairs    == (void *) 0 && pair_count ) goto no_pairs;
+    #endif
+
+    // Initialized data
+    size_t offsets[65]   = { 0 },
+           cursor[64]    = { 0 },
+           chunk_count   = 0;
+
+    // Stop the workers from claiming chunks of the last narrowphase
+    SDL_AtomicSet(&narrowphase_next_chunk, NARROWPHASE_CLOSED);
+
+    // Wait for the workers still testing pairs of the last narrowphase
+    wait_for_narrowphase_workers();
+
+    // Grow the pair list
+    if ( pair_count > narrowphase_pair_max )
+    {
+
+        // Initialized data
+        GXCollisionPair_t *new_pairs = G10_REALLOC(narrowphase_pairs, pair_count * sizeof(GXCollisionPair_t));
+
+        // Error check
+        if ( new_pairs == (void *) 0 ) goto no_mem;
+
+        narrowphase_pairs    = new_pairs,
+        narrowphase_pair_max = pair_count;
+    }
+
+    // Count the pairs of each shape pair
+    for (size_t i = 0; i < pair_count; i++)
+        offsets[( p_pairs[i].shape_pair & 63 ) + 1]++;
+
+    // Compute the first pair of each shape pair, and count the chunks
+    for (size_t i = 0; i < 64; i++)
+    {
+        chunk_count    += ( offsets[i + 1] + NARROWPHASE_CHUNK_PAIRS - 1 ) / NARROWPHASE_CHUNK_PAIRS;
+        offsets[i + 1] += offsets[i];
+        cursor[i]       = offsets[i];
+    }
+
+    // Sort the pairs by shape pair, so every chunk calls one routine
+    for (size_t i = 0; i < pair_count; i++)
+        narrowphase_pairs[cursor[p_pairs[i].shape_pair & 63]++] = p_pairs[i];
+
+    // Grow the chunk list
+    if ( chunk_count > narrowphase_chunk_max )
+    {
+
+        // Initialized data
+        struct narrowphase_chunk_s *new_chunks = G10_REALLOC(narrowphase_chunks, chunk_count * sizeof(struct narrowphase_chunk_s));
+
+        // Error check
+        if ( new_chunks == (void *) 0 ) goto no_mem;
+
+        narrowphase_chunks    = new_chunks,
+        narrowphase_chunk_max = chunk_count;
+    }
+
+    // Split each shape pair into chunks
+    narrowphase_chunk_count = 0;
+
+    for (u32 i = 0; i < 64; i++)
+        for (size_t j = offsets[i]; j < offsets[i + 1]; j += NARROWPHASE_CHUNK_PAIRS)
+            narrowphase_chunks[narrowphase_chunk_count++] = (struct narrowphase_chunk_s)
+            {
+                .begin      = j,
+                .end        = ( j + NARROWPHASE_CHUNK_PAIRS < offsets[i + 1] ) ? j + NARROWPHASE_CHUNK_PAIRS : offsets[i + 1],
+                .shape_pair = i
+            };
+
+    // Clear the manifolds from the last narrowphase
+    for (size_t i = 0; i < NARROWPHASE_MAX_THREADS; i++)
+        narrowphase_threads[i].manifold_count = 0;
+
+    // Release the chunks to the workers
+    SDL_AtomicSet(&narrowphase_next_chunk, 0);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_instance:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Physics] Null pointer provided for parameter \"p_instance\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_pairs:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Physics] Null pointer provided for parameter \"p_pairs\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    g_print_error("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+size_t get_narrowphase_manifolds ( GXManifold_t *p_manifolds )
+{
+
+    // Initialized data
+    size_t count        = 0,
+           thread_count = (size_t) SDL_AtomicGet(&narrowphase_thread_count);
+
+    // Gather the manifolds from each thread
+    for (size_t i = 0; i < thread_count && i < NARROWPHASE_MAX_THREADS; i++)
+    {
+
+        // Copy the manifolds
+        if ( p_manifolds )
+            memcpy(&p_manifolds[count], narrowphase_threads[i].manifolds, narrowphase_threads[i].manifold_count * sizeof(GXManifold_t));
+
+        count += narrowphase_threads[i].manifold_count;
+    }
+
+    // Success
+    return count;
+}
+
 int detect_collisions ( GXInstance_t *p_instance )
 {
 
@@ -23,28 +470,67 @@ int detect_collisions ( GXInstance_t *p_instance )
     #endif
 
     // Initialized data
-    GXEntity_t *entity = 0;
+    size_t                       slot     = (size_t) SDL_TLSGet(narrowphase_thread_slot);
+    struct narrowphase_thread_s *p_thread = 0;
 
-    /*
-    // Get an entity to test collisions
+    // Claim a manifold buffer the first time this thread runs the narrowphase
+    if ( slot == 0 )
     {
+        slot = (size_t) SDL_AtomicAdd(&narrowphase_thread_count, 1) + 1;
 
-        // Lock the mutex
-        SDL_LockMutex(p_instance->mutexes.resolve_collision);
+        // Error check
+        if ( slot > NARROWPHASE_MAX_THREADS ) goto too_many_threads;
+
+        SDL_TLSSet(narrowphase_thread_slot, (void *) slot, 0);
+    }
+
+    p_thread = &narrowphase_threads[slot - 1];
+
+    // Count this thread as a worker, so begin_narrowphase waits for it
+    SDL_AtomicIncRef(&narrowphase_workers);
+
+    // Claim chunks until there are none left
+    for (;;)
+    {
+
+        // Initialized data
+        size_t                      c       = (size_t) SDL_AtomicAdd(&narrowphase_next_chunk, 1);
+        struct narrowphase_chunk_s  chunk   = { 0 };
+        bool                      (*routine)( GXEntity_t *, GXEntity_t *, GXManifold_t * ) = 0;
+
+        // Done
+        if ( c >= narrowphase_chunk_count ) break;
+
+        chunk   = narrowphase_chunks[c];
+        routine = narrowphase_routines[chunk.shape_pair];
 
-        // Is there anything left to move?
-        if (queue_empty(p_instance->queues.actor_collision))
+        // Make room for every pair in the chunk
+        if ( p_thread->manifold_count + ( chunk.end - chunk.begin ) > p_thread->manifold_max )
         {
 
-            // If not, unlock and return
-            SDL_UnlockMutex(p_instance->mutexes.resolve_collision);
-            return 1;
+            // Initialized data
+            size_t        new_max       = p_thread->manifold_count + NARROWPHASE_CHUNK_PAIRS * 2;
+            GXManifold_t *new_manifolds = G10_REALLOC(p_thread->manifolds, new_max * sizeof(GXManifold_t));
+
+            // Error check
+            if ( new_manifolds == (void *) 0 )
+            {
+                leave_narrowphase();
+
+                goto no_mem;
+            }
+
+            p_thread->manifolds    = new_manifolds,
+            p_thread->manifold_max = new_max;
         }
 
-        queue_dequeue(p_instance->queues.actor_collision, &entity);
+        // Test each pair
+        for (size_t i = chunk.begin; i < chunk.end; i++)
+            p_thread->manifold_count += routine(narrowphase_pairs[i].a, narrowphase_pairs[i].b, &p_thread->manifolds[p_thread->manifold_count]);
+    }
 
-        SDL_UnlockMutex(p_instance->mutexes.resolve_collision);
-    }*/
+    // This thread is done with the narrowphase
+    leave_narrowphase();
 
     // Successs
     return 1;
@@ -62,6 +548,163 @@ int detect_collisions ( GXInstance_t *p_instance )
                 // Error
                 return 0;
         }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    g_print_error("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // G10 errors
+        {
+            too_many_threads:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Physics] More than %d threads called function \"%s\"\n", NARROWPHASE_MAX_THREADS, __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int solve_collisions ( GXInstance_t *p_instance )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( p_instance == (void *) 0 ) goto no_instance;
+    #endif
+
+    // Initialized data
+    static GXManifold_t *manifolds     = 0;
+    static size_t        manifold_max  = 0;
+    size_t               manifold_count = 0;
+
+    // Test the pairs no worker has claimed yet
+    if ( detect_collisions(p_instance) == 0 ) goto failed_to_detect_collisions;
+
+    // Wait for the workers still testing pairs
+    wait_for_narrowphase_workers();
+
+    // Count the manifolds
+    manifold_count = get_narrowphase_manifolds(0);
+
+    // Grow the manifold list
+    if ( manifold_count > manifold_max )
+    {
+
+        // Initialized data
+        GXManifold_t *new_manifolds = G10_REALLOC(manifolds, manifold_count * sizeof(GXManifold_t));
+
+        // Error check
+        if ( new_manifolds == (void *) 0 ) goto no_mem;
+
+        manifolds    = new_manifolds,
+        manifold_max = manifold_count;
+    }
+
+    // Gather the manifolds
+    (void) get_narrowphase_manifolds(manifolds);
+
+    // Resolve each contact
+    for (size_t i = 0; i < manifold_count; i++)
+    {
+
+        // Initialized data
+        GXManifold_t   m           = manifolds[i];
+        GXRigidbody_t *a           = m.a->rigidbody,
+                      *b           = m.b->rigidbody;
+        float          a_inv_mass  = ( a && a->mass > 0.f ) ? 1.f / a->mass : 0.f,
+                       b_inv_mass  = ( b && b->mass > 0.f ) ? 1.f / b->mass : 0.f,
+                       inv_mass    = a_inv_mass + b_inv_mass,
+                       correction  = 0.f,
+                       vn          = 0.f;
+        vec3           relative    = { 0 };
+
+        // Both entities are static
+        if ( inv_mass == 0.f ) continue;
+
+        // Move the entities out of each other. Leave a little overlap, so resting contacts stay in contact
+        correction = fmaxf(m.depth - 0.001f, 0.f) * 0.8f / inv_mass;
+
+        if ( a_inv_mass > 0.f )
+        {
+            sub_vec3(&m.a->transform->location, m.a->transform->location, mul_vec3_f(m.normal, correction * a_inv_mass));
+            dirty_transform(m.a->transform);
+        }
+
+        if ( b_inv_mass > 0.f )
+        {
+            add_vec3(&m.b->transform->location, m.b->transform->location, mul_vec3_f(m.normal, correction * b_inv_mass));
+            dirty_transform(m.b->transform);
+        }
+
+        // Relative velocity along the normal
+        sub_vec3(&relative, ( b ) ? b->velocity : (vec3) { 0 }, ( a ) ? a->velocity : (vec3) { 0 });
+
+        vn = dot_product_vec3(relative, m.normal);
+
+        // The entities are already separating
+        if ( vn >= 0.f ) continue;
+
+        // Apply an impulse with a fixed restitution of 0.2
+        {
+
+            // Initialized data
+            float j = -1.2f * vn / inv_mass;
+
+            if ( a_inv_mass > 0.f )
+                sub_vec3(&a->velocity, a->velocity, mul_vec3_f(m.normal, j * a_inv_mass));
+
+            if ( b_inv_mass > 0.f )
+                add_vec3(&b->velocity, b->velocity, mul_vec3_f(m.normal, j * b_inv_mass));
+        }
+    }
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_instance:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Physics] Null pointer provided for parameter \"p_instance\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    g_print_error("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // G10 errors
+        {
+            failed_to_detect_collisions:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Physics] Failed to detect collisions in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
     }
 }
 
@@ -82,16 +725,8 @@ int move_objects ( GXInstance_t* p_instance )
         // Lock the mutex
         SDL_LockMutex(p_instance->mutexes.move_object);
 
-        // Is there anything left to move?
-        if (queue_empty(p_instance->queues.actor_move))
-        {
-
-            // If not, unlock and return
-            SDL_UnlockMutex(p_instance->mutexes.move_object);
-            return 1;
-        }
-
-        entity = queue_dequeue(p_instance->queues.actor_move);
+        // Get the next entity, or null if there is nothing left to move
+        entity = next_work_item(&p_instance->context.scene->components->work_lists[WORK_LIST_ACTORS], &p_instance->cursors.actor_move);
 
         SDL_UnlockMutex(p_instance->mutexes.move_object);
     }
@@ -137,16 +772,8 @@ int update_forces ( GXInstance_t *p_instance )
         // Lock the mutex
         SDL_LockMutex(p_instance->mutexes.update_force);
 
-        // Is there anything left to move?
-        if (queue_empty(p_instance->queues.actor_force))
-        {
-
-            // If not, unlock and return
-            SDL_UnlockMutex(p_instance->mutexes.update_force);
-            return 1;
-        }
-
-        queue_dequeue(p_instance->queues.actor_force, &entity);
+        // Get the next entity, or null if there is nothing left to move
+        entity = next_work_item(&p_instance->context.scene->components->work_lists[WORK_LIST_ACTORS], &p_instance->cursors.actor_force);
 
         SDL_UnlockMutex(p_instance->mutexes.update_force);
     }
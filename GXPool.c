@@ -0,0 +1,546 @@
+#include <G10/GXPool.h>
+
+// Pools each thread caches objects for
+#define POOL_THREAD_CACHES 8
+
+// Free objects are linked through their first word
+#define NEXT_FREE(p) ( *(void **) (p) )
+
+// Every live pool
+static struct
+{
+    GXPool_t     *head;
+    u64           next_id;
+    SDL_SpinLock  lock,
+                  init_lock;
+} pools = { 0 };
+
+// The free objects this thread caches, one list per pool, most recent first
+static G10_THREAD_LOCAL struct
+{
+    u64       pool_id;
+    GXPool_t *pool;
+    void     *head;
+    size_t    count;
+} thread_caches[POOL_THREAD_CACHES] = { 0 };
+
+// Add a slab to a pool, and put its objects on the free list. Call with the lock held
+static int grow_pool ( GXPool_t *p_pool )
+{
+
+    // Initialized data
+    u8 *p_raw  = 0,
+       *p_slab = 0;
+
+    // Grow the list of slabs
+    if ( p_pool->slab_count == p_pool->slab_max )
+    {
+
+        // Initialized data
+        size_t   new_max   = ( p_pool->slab_max ) ? p_pool->slab_max * 2 : 4;
+        void   **new_slabs = G10_REALLOC(p_pool->slabs, new_max * sizeof(void *));
+
+        // Error check
+        if ( new_slabs == (void *) 0 ) return 0;
+
+        p_pool->slabs    = new_slabs;
+        p_pool->slab_max = new_max;
+    }
+
+    // Allocate the slab, with room to move it onto a cache line
+    p_raw = calloc(1, p_pool->slab_objects * p_pool->object_size + POOL_SLAB_ALIGNMENT - 1);
+
+    // Error check
+    if ( p_raw == (void *) 0 ) return 0;
+
+    p_slab = (u8 *) ( ( (uintptr_t) p_raw + POOL_SLAB_ALIGNMENT - 1 ) & ~(uintptr_t) ( POOL_SLAB_ALIGNMENT - 1 ) );
+
+    p_pool->slabs[p_pool->slab_count++] = p_raw;
+
+    G10_STAT_ADD(stat_pool_bytes, (i64) ( p_pool->slab_objects * p_pool->object_size ));
+
+    // Push each object, last first, so the free list walks the slab in order
+    for (size_t i = p_pool->slab_objects; i-- > 0;)
+    {
+
+        // Initialized data
+        void *p = p_slab + i * p_pool->object_size;
+
+        NEXT_FREE(p)      = p_pool->free_list;
+        p_pool->free_list = p;
+    }
+
+    p_pool->free_count   += p_pool->slab_objects;
+    p_pool->object_count += p_pool->slab_objects;
+
+    // Success
+    return 1;
+}
+
+// Give a list of free objects back to a pool
+static void return_objects ( GXPool_t *p_pool, void *p_head, size_t count )
+{
+
+    // Initialized data
+    void *p_tail = p_head;
+
+    // Nothing to return
+    if ( count == 0 ) return;
+
+    // Find the end of the list
+    for (size_t i = 1; i < count; i++)
+        p_tail = NEXT_FREE(p_tail);
+
+    // Splice the list onto the pool's free list
+    SDL_AtomicLock(&p_pool->lock);
+
+    NEXT_FREE(p_tail)   = p_pool->free_list;
+    p_pool->free_list   = p_head;
+    p_pool->free_count += count;
+
+    SDL_AtomicUnlock(&p_pool->lock);
+}
+
+// Move this thread's cache for a pool to the front of the thread's caches
+static void front_thread_cache ( GXPool_t *p_pool )
+{
+
+    // Initialized data
+    size_t slot = POOL_THREAD_CACHES - 1;
+
+    // Fast path. The most recent pool
+    if ( thread_caches[0].pool_id == p_pool->id ) return;
+
+    // Find this pool's cache. Unused caches can sit between live caches, so
+    // every cache is checked before an unused cache is taken
+    for (size_t i = 1; i < POOL_THREAD_CACHES; i++)
+    {
+
+        // This pool's cache
+        if ( thread_caches[i].pool_id == p_pool->id ) { slot = i; break; }
+
+        // The first unused cache
+        if ( thread_caches[i].pool_id == 0 && thread_caches[slot].pool_id != 0 ) slot = i;
+    }
+
+    // Evict the least recent cache
+    if ( thread_caches[slot].pool_id != p_pool->id && thread_caches[slot].pool_id )
+    {
+
+        // Give the objects back, unless the pool was destroyed
+        SDL_AtomicLock(&pools.lock);
+
+        for (GXPool_t *i = pools.head; i; i = i->next)
+            if ( i == thread_caches[slot].pool && i->id == thread_caches[slot].pool_id )
+            {
+                return_objects(i, thread_caches[slot].head, thread_caches[slot].count);
+
+                break;
+            }
+
+        SDL_AtomicUnlock(&pools.lock);
+
+        thread_caches[slot].pool_id = 0;
+    }
+
+    // Move the cache to the front
+    {
+
+        // Initialized data
+        u64    pool_id = thread_caches[slot].pool_id;
+        void  *p_head  = thread_caches[slot].head;
+        size_t count   = thread_caches[slot].count;
+
+        memmove(&thread_caches[1], &thread_caches[0], slot * sizeof(thread_caches[0]));
+
+        thread_caches[0].pool_id = p_pool->id;
+        thread_caches[0].pool    = p_pool;
+        thread_caches[0].head    = ( pool_id ) ? p_head : 0;
+        thread_caches[0].count   = ( pool_id ) ? count  : 0;
+    }
+}
+
+int create_pool ( GXPool_t **pp_pool, size_t object_size, size_t slab_objects )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( pp_pool     == (void *) 0 ) goto no_pool;
+        if ( object_size == 0          ) goto no_object_size;
+    #endif
+
+    // Initialized data
+    GXPool_t *p_pool = calloc(1, sizeof(GXPool_t));
+
+    // Memory check
+    if ( p_pool == (void *) 0 ) goto no_mem;
+
+    // Round the object size up to the alignment. Free objects hold a pointer
+    p_pool->object_size  = ( object_size + POOL_OBJECT_ALIGNMENT - 1 ) & ~(size_t)( POOL_OBJECT_ALIGNMENT - 1 );
+    p_pool->slab_objects = ( slab_objects ) ? slab_objects : POOL_SLAB_SIZE / p_pool->object_size;
+
+    if ( p_pool->slab_objects == 0 )
+        p_pool->slab_objects = 1;
+
+    // Add the pool to the list of live pools
+    SDL_AtomicLock(&pools.lock);
+
+    p_pool->id   = ++pools.next_id;
+    p_pool->next = pools.head;
+    pools.head   = p_pool;
+
+    SDL_AtomicUnlock(&pools.lock);
+
+    // Return the allocated memory
+    *pp_pool = p_pool;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_pool:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Pool] Null pointer provided for parameter \"pp_pool\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_object_size:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Pool] Parameter \"object_size\" must be greater than 0 in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    g_print_error("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+void *pool_alloc ( GXPool_t *p_pool )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( p_pool == (void *) 0 ) goto no_pool;
+    #endif
+
+    // Initialized data
+    void *p = 0;
+
+    front_thread_cache(p_pool);
+
+    // Slow path. Take a batch of objects from the pool
+    if ( thread_caches[0].count == 0 )
+    {
+
+        // Initialized data
+        void   *p_tail = 0;
+        size_t  count  = 0;
+
+        SDL_AtomicLock(&p_pool->lock);
+
+        // Out of free objects
+        if ( p_pool->free_count == 0 )
+            if ( grow_pool(p_pool) == 0 ) goto no_mem;
+
+        count  = ( p_pool->free_count < POOL_BATCH ) ? p_pool->free_count : POOL_BATCH;
+        p_tail = p_pool->free_list;
+
+        for (size_t j = 1; j < count; j++)
+            p_tail = NEXT_FREE(p_tail);
+
+        thread_caches[0].head  = p_pool->free_list;
+        thread_caches[0].count = count;
+
+        p_pool->free_list   = NEXT_FREE(p_tail);
+        p_pool->free_count -= count;
+
+        NEXT_FREE(p_tail) = 0;
+
+        SDL_AtomicUnlock(&p_pool->lock);
+    }
+
+    // Fast path. Pop an object from this thread's cache, without a lock
+    p = thread_caches[0].head;
+
+    thread_caches[0].head = NEXT_FREE(p);
+    thread_caches[0].count--;
+
+    memset(p, 0, p_pool->object_size);
+
+    // Success
+    return p;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_pool:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Pool] Null pointer provided for parameter \"p_pool\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                SDL_AtomicUnlock(&p_pool->lock);
+
+                #ifndef NDEBUG
+                    g_print_error("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+void pool_free ( GXPool_t *p_pool, void *p )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( p_pool == (void *) 0 ) goto no_pool;
+    #endif
+
+    // Nothing to free
+    if ( p == (void *) 0 ) return;
+
+    front_thread_cache(p_pool);
+
+    // Push the object onto this thread's cache
+    NEXT_FREE(p)          = thread_caches[0].head;
+    thread_caches[0].head = p;
+    thread_caches[0].count++;
+
+    // Keep the most recent batch, and give the rest back to the pool
+    if ( thread_caches[0].count >= 2 * POOL_BATCH )
+    {
+
+        // Initialized data
+        void *p_last = thread_caches[0].head;
+
+        for (size_t j = 1; j < POOL_BATCH; j++)
+            p_last = NEXT_FREE(p_last);
+
+        return_objects(p_pool, NEXT_FREE(p_last), thread_caches[0].count - POOL_BATCH);
+
+        NEXT_FREE(p_last)      = 0;
+        thread_caches[0].count = POOL_BATCH;
+    }
+
+    // Done
+    return;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_pool:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Pool] Null pointer provided for parameter \"p_pool\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return;
+        }
+    }
+}
+
+void *pool_calloc ( GXPool_t **pp_pool, size_t size )
+{
+
+    // Initialized data
+    GXArena_t *p_arena = get_thread_arena();
+
+    // Allocate from the thread's arena
+    if ( p_arena )
+        return arena_alloc(p_arena, size);
+
+    // Allocate from the pool
+    return G10_POOL_ALLOC(pp_pool, size);
+}
+
+void pool_release ( GXPool_t **pp_pool, void *p )
+{
+
+    // Nothing to free
+    if ( p == (void *) 0 ) return;
+
+    // Memory from an arena
+    if ( arena_owned(p) ) return;
+
+    // Memory from the pool
+    G10_POOL_FREE(pp_pool, p);
+}
+
+GXPool_t *get_pool ( GXPool_t **pp_pool, size_t object_size )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( pp_pool == (void *) 0 ) goto no_pool;
+    #endif
+
+    // Initialized data
+    GXPool_t *p_pool = SDL_AtomicGetPtr((void **) pp_pool);
+
+    // Fast path. The pool exists
+    if ( p_pool ) return p_pool;
+
+    // Slow path. Make the pool, unless another thread got here first
+    SDL_AtomicLock(&pools.init_lock);
+
+    p_pool = *pp_pool;
+
+    if ( p_pool == (void *) 0 && create_pool(&p_pool, object_size, 0) )
+    {
+
+        // Remember the variable, for clear_pools
+        SDL_AtomicLock(&pools.lock);
+
+        p_pool->slot = pp_pool;
+
+        SDL_AtomicUnlock(&pools.lock);
+
+        SDL_AtomicSetPtr((void **) pp_pool, p_pool);
+    }
+
+    SDL_AtomicUnlock(&pools.init_lock);
+
+    // Success
+    return p_pool;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_pool:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Pool] Null pointer provided for parameter \"pp_pool\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int destroy_pool ( GXPool_t **pp_pool )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( pp_pool == (void *) 0 ) goto no_pool;
+    #endif
+
+    // Initialized data
+    GXPool_t *p_pool = *pp_pool;
+
+    // No more pointer for caller
+    *pp_pool = 0;
+
+    // Nothing to free
+    if ( p_pool == (void *) 0 ) return 1;
+
+    // Remove the pool from the list of live pools
+    SDL_AtomicLock(&pools.lock);
+
+    for (GXPool_t **i = &pools.head; *i; i = &(*i)->next)
+        if ( *i == p_pool )
+        {
+            *i = p_pool->next;
+
+            break;
+        }
+
+    SDL_AtomicUnlock(&pools.lock);
+
+    // The next get_pool makes a new pool
+    if ( p_pool->slot )
+        SDL_AtomicSetPtr((void **) p_pool->slot, 0);
+
+    // Drop this thread's cache for the pool
+    for (size_t i = 0; i < POOL_THREAD_CACHES; i++)
+        if ( thread_caches[i].pool_id == p_pool->id )
+            thread_caches[i].pool_id = 0;
+
+    // Free each slab
+    for (size_t i = 0; i < p_pool->slab_count; i++)
+        free(p_pool->slabs[i]);
+
+    G10_STAT_ADD(stat_pool_bytes, -(i64) ( p_pool->slab_count * p_pool->slab_objects * p_pool->object_size ));
+
+    G10_FREE(p_pool->slabs);
+
+    // Free the pool
+    free(p_pool);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_pool:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Pool] Null pointer provided for parameter \"pp_pool\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int clear_pools ( void )
+{
+
+    // Destroy each pool made by get_pool
+    while ( true )
+    {
+
+        // Initialized data
+        GXPool_t *p_pool = 0;
+
+        SDL_AtomicLock(&pools.lock);
+
+        for (GXPool_t *i = pools.head; i; i = i->next)
+            if ( i->slot ) { p_pool = i; break; }
+
+        SDL_AtomicUnlock(&pools.lock);
+
+        // Done
+        if ( p_pool == (void *) 0 ) break;
+
+        destroy_pool(&p_pool);
+    }
+
+    // Success
+    return 1;
+}
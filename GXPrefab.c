@@ -0,0 +1,606 @@
+#include <G10/GXPrefab.h>
+
+// Rigidbodies are loaded with room for this many forces and torques
+#define PREFAB_FORCE_MAX 16
+
+// Copy a string into the arena bound to the calling thread
+static char *copy_string ( const char *string )
+{
+
+    // Initialized data
+    size_t  len  = strlen(string);
+    char   *copy = arena_calloc(len + 1, sizeof(char));
+
+    // Copy the string
+    if ( copy )
+        memcpy(copy, string, len);
+
+    // Success
+    return copy;
+}
+
+void init_prefab ( void )
+{
+
+    // Initialized data
+    GXInstance_t *p_instance = g_get_active_instance();
+
+    // Create a prefab cache mutex
+    p_instance->mutexes.prefab_cache = SDL_CreateMutex();
+
+    // Exit
+    return;
+}
+
+int create_prefab ( GXPrefab_t **pp_prefab )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( pp_prefab == (void *) 0 ) goto no_prefab;
+    #endif
+
+    // Initialized data
+    GXPrefab_t *p_prefab = calloc(1, sizeof(GXPrefab_t));
+
+    // Error check
+    if ( p_prefab == (void *) 0 ) goto no_mem;
+
+    // Count the prefab
+    G10_STAT_ADD(stat_prefabs, 1);
+
+    // Return a pointer to the caller
+    *pp_prefab = p_prefab;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_prefab:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Prefab] Null pointer provided for parameter \"pp_prefab\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    g_print_error("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int load_prefab ( GXPrefab_t **pp_prefab, const char *path )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( pp_prefab == (void *) 0 ) goto no_prefab;
+        if ( path      == (void *) 0 ) goto no_path;
+    #endif
+
+    // Initialized data
+    GXPrefab_t *p_prefab         = 0;
+    GXArena_t  *p_previous_arena = 0;
+
+    // Allocate a prefab
+    if ( create_prefab(&p_prefab) == 0 ) goto failed_to_allocate_prefab;
+
+    // The template outlives the scene that asked for it, so keep it out of the scene's arena
+    p_previous_arena = set_thread_arena(0);
+
+    // Name the prefab after the path
+    p_prefab->name = copy_string(path);
+
+    // Error check
+    if ( p_prefab->name == (void *) 0 ) goto no_mem;
+
+    // Load the template
+    if ( load_entity(&p_prefab->entity, (char *) path) == 0 ) goto failed_to_load_entity;
+
+    // Rebind the scene's arena
+    (void) set_thread_arena(p_previous_arena);
+
+    // Return a pointer to the caller
+    *pp_prefab = p_prefab;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_prefab:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Prefab] Null pointer provided for parameter \"pp_prefab\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_path:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Prefab] Null pointer provided for parameter \"path\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // G10 errors
+        {
+            failed_to_allocate_prefab:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Prefab] Failed to allocate prefab in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            failed_to_load_entity:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Prefab] Failed to load prefab from \"%s\" in call to function \"%s\"\n", path, __FUNCTION__);
+                #endif
+
+                // Clean up
+                (void) set_thread_arena(p_previous_arena);
+                (void) destroy_prefab(&p_prefab);
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    g_print_error("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Clean up
+                (void) set_thread_arena(p_previous_arena);
+                (void) destroy_prefab(&p_prefab);
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int load_prefab_as_json_value ( GXPrefab_t **pp_prefab, JSONValue_t *p_value )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( pp_prefab == (void *) 0 ) goto no_prefab;
+        if ( p_value   == (void *) 0 ) goto no_value;
+    #endif
+
+    // Initialized data
+    GXPrefab_t *p_prefab         = 0;
+    GXArena_t  *p_previous_arena = 0;
+
+    // Load the prefab as a path
+    if ( p_value->type == JSONstring )
+        return load_prefab(pp_prefab, p_value->string);
+
+    // Allocate a prefab
+    if ( create_prefab(&p_prefab) == 0 ) goto failed_to_allocate_prefab;
+
+    // The template outlives the scene that asked for it, so keep it out of the scene's arena
+    p_previous_arena = set_thread_arena(0);
+
+    // Load the template
+    if ( load_entity_as_json_value(&p_prefab->entity, p_value) == 0 ) goto failed_to_load_entity;
+
+    // Name the prefab after the template
+    p_prefab->name = copy_string(p_prefab->entity->name);
+
+    // Error check
+    if ( p_prefab->name == (void *) 0 ) goto no_mem;
+
+    // Rebind the scene's arena
+    (void) set_thread_arena(p_previous_arena);
+
+    // Return a pointer to the caller
+    *pp_prefab = p_prefab;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_prefab:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Prefab] Null pointer provided for parameter \"pp_prefab\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_value:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Prefab] Null pointer provided for parameter \"p_value\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // G10 errors
+        {
+            failed_to_allocate_prefab:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Prefab] Failed to allocate prefab in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            failed_to_load_entity:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Prefab] Failed to load entity in call to function \"%s\"\nRefer to gschema: https://schema.g10.app/entity.json \n", __FUNCTION__);
+                #endif
+
+                // Clean up
+                (void) set_thread_arena(p_previous_arena);
+                (void) destroy_prefab(&p_prefab);
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    g_print_error("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Clean up
+                (void) set_thread_arena(p_previous_arena);
+                (void) destroy_prefab(&p_prefab);
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int instance_prefab ( GXEntity_t **pp_entity, GXPrefab_t *p_prefab, const char *name )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( pp_entity == (void *) 0 ) goto no_entity;
+        if ( p_prefab  == (void *) 0 ) goto no_prefab;
+        if ( name      == (void *) 0 ) goto no_name;
+    #endif
+
+    // Initialized data
+    GXEntity_t *p_template = p_prefab->entity,
+               *p_entity   = 0;
+
+    // Allocate the entity
+    if ( create_entity(&p_entity) == 0 ) goto failed_to_allocate_entity;
+
+    // Stamp the template. Parts and materials are borrowed
+    memcpy(p_entity, p_template, sizeof(GXEntity_t));
+
+    // The instance owns none of the template's names or components until it
+    // copies them, since destroy_entity frees them if a later step fails
+    p_entity->name        = 0;
+    p_entity->shader_name = 0;
+    p_entity->transform   = 0;
+    p_entity->rigidbody   = 0;
+    p_entity->collider    = 0;
+    p_entity->ai          = 0;
+
+    // The instance is in no component storage, and no work list
+    p_entity->chunk      = 0;
+    p_entity->chunk_row  = 0;
+    p_entity->handle     = HANDLE_INVALID;
+    p_entity->work_lists = 0;
+
+    // Name the instance
+    p_entity->name = copy_string(name);
+
+    // Error check
+    if ( p_entity->name == (void *) 0 ) goto no_mem;
+
+    // Copy the shader name. Entities free their own
+    if ( p_template->shader_name )
+    {
+        p_entity->shader_name = copy_string(p_template->shader_name);
+
+        // Error check
+        if ( p_entity->shader_name == (void *) 0 ) goto no_mem;
+    }
+
+    // Transform
+    if ( p_template->transform )
+    {
+
+        // Allocate a transform
+        if ( create_transform(&p_entity->transform) == 0 ) goto failed_to_allocate_transform;
+
+        // Stamp the template's transform
+        memcpy(p_entity->transform, p_template->transform, sizeof(GXTransform_t));
+
+        // The instance is in no hierarchy
+        p_entity->transform->parent       = 0;
+        p_entity->transform->p_hierarchy  = 0;
+        p_entity->transform->index        = 0;
+        p_entity->transform->subtree_size = 1;
+    }
+
+    // Rigidbody
+    if ( p_template->rigidbody )
+    {
+
+        // Initialized data
+        GXRigidbody_t *p_rigidbody = 0;
+
+        // Allocate a rigidbody
+        if ( create_rigidbody(&p_entity->rigidbody) == 0 ) goto failed_to_allocate_rigidbody;
+
+        p_rigidbody = p_entity->rigidbody;
+
+        // Stamp the template's rigidbody. Mass, radius, and flags are copied by value
+        memcpy(p_rigidbody, p_template->rigidbody, sizeof(GXRigidbody_t));
+
+        p_rigidbody->forces  = 0;
+        p_rigidbody->torques = 0;
+
+        // Leave room for the template's forces and torques
+        size_t force_max  = ( p_rigidbody->force_count  > PREFAB_FORCE_MAX ) ? p_rigidbody->force_count  : PREFAB_FORCE_MAX,
+               torque_max = ( p_rigidbody->torque_count > PREFAB_FORCE_MAX ) ? p_rigidbody->torque_count : PREFAB_FORCE_MAX;
+
+        // Forces and torques are written every frame, so the instance gets its own
+        if ( p_template->rigidbody->forces )
+        {
+            p_rigidbody->forces = arena_calloc(force_max, sizeof(vec3));
+
+            // Error check
+            if ( p_rigidbody->forces == (void *) 0 ) goto no_mem;
+
+            memcpy(p_rigidbody->forces, p_template->rigidbody->forces, p_rigidbody->force_count * sizeof(vec3));
+        }
+
+        if ( p_template->rigidbody->torques )
+        {
+            p_rigidbody->torques = arena_calloc(torque_max, sizeof(quaternion));
+
+            // Error check
+            if ( p_rigidbody->torques == (void *) 0 ) goto no_mem;
+
+            memcpy(p_rigidbody->torques, p_template->rigidbody->torques, p_rigidbody->torque_count * sizeof(quaternion));
+        }
+    }
+
+    // Collider
+    if ( p_template->collider )
+    {
+
+        // Initialized data
+        GXCollider_t *p_collider = 0;
+
+        // Allocate a collider
+        if ( create_collider(&p_entity->collider) == 0 ) goto failed_to_allocate_collider;
+
+        p_collider = p_entity->collider;
+
+        // Stamp the template's collider. The convex hull and the callbacks are borrowed
+        memcpy(p_collider, p_template->collider, sizeof(GXCollider_t));
+
+        p_collider->source       = ( p_template->collider->source ) ? p_template->collider->source : p_template->collider;
+        p_collider->model_matrix = ( p_entity->transform ) ? &p_entity->transform->model_matrix : 0;
+        p_collider->bv           = 0;
+        p_collider->collisions   = 0;
+
+        // The instance has a bounding volume of its own
+        if ( p_template->collider->bv )
+        {
+            if ( construct_bv(&p_collider->bv, p_template->collider->bv->minimum, p_template->collider->bv->maximum) == 0 ) goto failed_to_construct_bv;
+
+            p_collider->bv->entity = p_entity;
+        }
+
+        // The instance collides on its own
+        if ( p_template->collider->collisions )
+            dict_construct(&p_collider->collisions, 16);
+    }
+
+    // AI. The copy shares the template's states
+    if ( p_template->ai )
+        if ( copy_ai(&p_entity->ai, p_template->ai) == 0 ) goto failed_to_copy_ai;
+
+    // Return a pointer to the caller
+    *pp_entity = p_entity;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_entity:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Prefab] Null pointer provided for parameter \"pp_entity\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_prefab:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Prefab] Null pointer provided for parameter \"p_prefab\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_name:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Prefab] Null pointer provided for parameter \"name\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // G10 errors
+        {
+            failed_to_allocate_entity:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Prefab] Failed to allocate entity in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            failed_to_allocate_transform:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Prefab] Failed to allocate transform in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Clean up
+                (void) destroy_entity(&p_entity);
+
+                // Error
+                return 0;
+
+            failed_to_allocate_rigidbody:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Prefab] Failed to allocate rigidbody in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Clean up
+                (void) destroy_entity(&p_entity);
+
+                // Error
+                return 0;
+
+            failed_to_allocate_collider:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Prefab] Failed to allocate collider in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Clean up
+                (void) destroy_entity(&p_entity);
+
+                // Error
+                return 0;
+
+            failed_to_construct_bv:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Prefab] Failed to construct bounding volume in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Clean up
+                (void) destroy_entity(&p_entity);
+
+                // Error
+                return 0;
+
+            failed_to_copy_ai:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Prefab] Failed to copy AI in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Clean up
+                (void) destroy_entity(&p_entity);
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    g_print_error("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Clean up
+                (void) destroy_entity(&p_entity);
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int destroy_prefab ( GXPrefab_t **pp_prefab )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( pp_prefab == (void *) 0 ) goto no_prefab;
+    #endif
+
+    // Initialized data
+    GXPrefab_t *p_prefab = *pp_prefab;
+
+    // No more pointer for caller
+    *pp_prefab = 0;
+
+    // Nothing to free
+    if ( p_prefab == (void *) 0 ) return 1;
+
+    G10_STAT_ADD(stat_prefabs, -1);
+
+    // Destroy the template
+    if ( p_prefab->entity )
+    {
+
+        // An AI that is not a copy belongs to the AI cache
+        if ( p_prefab->entity->ai && p_prefab->entity->ai->source == (void *) 0 )
+            p_prefab->entity->ai = 0;
+
+        (void) destroy_entity(&p_prefab->entity);
+    }
+
+    // Free the name
+    arena_free(p_prefab->name);
+
+    // Free the prefab
+    free(p_prefab);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_prefab:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Prefab] Null pointer provided for parameter \"pp_prefab\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
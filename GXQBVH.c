@@ -0,0 +1,985 @@
+// Allocations made here are counted against physics
+#define G10_ALLOC_TAG alloc_tag_physics
+
+#include <G10/GXQBVH.h>
+
+// Ray constants shared by every node test
+struct qbvh_ray_s
+{
+    float origin[3],
+          inverse_direction[3];
+};
+
+// Bit i is set when child i is used
+static int qbvh_valid_mask ( const GXQBVHNode_t *p_node )
+{
+
+    // Success
+    return ( p_node->children[0] != QBVH_EMPTY ) << 0 |
+           ( p_node->children[1] != QBVH_EMPTY ) << 1 |
+           ( p_node->children[2] != QBVH_EMPTY ) << 2 |
+           ( p_node->children[3] != QBVH_EMPTY ) << 3;
+}
+
+// Slab test a ray against all four children. Writes the entry distance of each child, and returns a mask of hits
+static int qbvh_ray_node ( const GXQBVHNode_t *p_node, const struct qbvh_ray_s *p_ray, float max_t, float *p_t )
+{
+
+    #ifdef G10_QBVH_SSE
+
+        // Initialized data
+        __m128 ox   = _mm_set1_ps(p_ray->origin[0]),
+               oy   = _mm_set1_ps(p_ray->origin[1]),
+               oz   = _mm_set1_ps(p_ray->origin[2]),
+               ix   = _mm_set1_ps(p_ray->inverse_direction[0]),
+               iy   = _mm_set1_ps(p_ray->inverse_direction[1]),
+               iz   = _mm_set1_ps(p_ray->inverse_direction[2]),
+               t1x  = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(p_node->min_x), ox), ix),
+               t2x  = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(p_node->max_x), ox), ix),
+               t1y  = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(p_node->min_y), oy), iy),
+               t2y  = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(p_node->max_y), oy), iy),
+               t1z  = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(p_node->min_z), oz), iz),
+               t2z  = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(p_node->max_z), oz), iz),
+               tmin = _mm_max_ps(_mm_max_ps(_mm_min_ps(t1x, t2x), _mm_min_ps(t1y, t2y)), _mm_max_ps(_mm_min_ps(t1z, t2z), _mm_setzero_ps())),
+               tmax = _mm_min_ps(_mm_min_ps(_mm_max_ps(t1x, t2x), _mm_max_ps(t1y, t2y)), _mm_min_ps(_mm_max_ps(t1z, t2z), _mm_set1_ps(max_t)));
+
+        _mm_storeu_ps(p_t, tmin);
+
+        // Success
+        return _mm_movemask_ps(_mm_cmple_ps(tmin, tmax)) & qbvh_valid_mask(p_node);
+    #else
+
+        // Initialized data
+        int mask = 0;
+
+        for (int i = 0; i < 4; i++)
+        {
+
+            // Initialized data
+            float t1x  = ( p_node->min_x[i] - p_ray->origin[0] ) * p_ray->inverse_direction[0],
+                  t2x  = ( p_node->max_x[i] - p_ray->origin[0] ) * p_ray->inverse_direction[0],
+                  t1y  = ( p_node->min_y[i] - p_ray->origin[1] ) * p_ray->inverse_direction[1],
+                  t2y  = ( p_node->max_y[i] - p_ray->origin[1] ) * p_ray->inverse_direction[1],
+                  t1z  = ( p_node->min_z[i] - p_ray->origin[2] ) * p_ray->inverse_direction[2],
+                  t2z  = ( p_node->max_z[i] - p_ray->origin[2] ) * p_ray->inverse_direction[2],
+                  tmin = fmaxf(fmaxf(fminf(t1x, t2x), fminf(t1y, t2y)), fmaxf(fminf(t1z, t2z), 0.f)),
+                  tmax = fminf(fminf(fmaxf(t1x, t2x), fmaxf(t1y, t2y)), fminf(fmaxf(t1z, t2z), max_t));
+
+            p_t[i] = tmin;
+            mask  |= ( tmin <= tmax ) << i;
+        }
+
+        // Success
+        return mask & qbvh_valid_mask(p_node);
+    #endif
+}
+
+// Test an axis aligned box against all four children, and return a mask of overlaps
+static int qbvh_box_node ( const GXQBVHNode_t *p_node, const float *p_min, const float *p_max )
+{
+
+    #ifdef G10_QBVH_SSE
+
+        // Initialized data
+        __m128 x = _mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(p_node->min_x), _mm_set1_ps(p_max[0])), _mm_cmpge_ps(_mm_loadu_ps(p_node->max_x), _mm_set1_ps(p_min[0]))),
+               y = _mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(p_node->min_y), _mm_set1_ps(p_max[1])), _mm_cmpge_ps(_mm_loadu_ps(p_node->max_y), _mm_set1_ps(p_min[1]))),
+               z = _mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(p_node->min_z), _mm_set1_ps(p_max[2])), _mm_cmpge_ps(_mm_loadu_ps(p_node->max_z), _mm_set1_ps(p_min[2])));
+
+        // Success
+        return _mm_movemask_ps(_mm_and_ps(_mm_and_ps(x, y), z)) & qbvh_valid_mask(p_node);
+    #else
+
+        // Initialized data
+        int mask = 0;
+
+        for (int i = 0; i < 4; i++)
+            mask |= ( p_node->min_x[i] <= p_max[0] && p_node->max_x[i] >= p_min[0] &&
+                      p_node->min_y[i] <= p_max[1] && p_node->max_y[i] >= p_min[1] &&
+                      p_node->min_z[i] <= p_max[2] && p_node->max_z[i] >= p_min[2] ) << i;
+
+        // Success
+        return mask & qbvh_valid_mask(p_node);
+    #endif
+}
+
+// Test six planes against all four children, and return a mask of children that aren't fully outside any plane
+static int qbvh_frustum_node ( const GXQBVHNode_t *p_node, const vec4 *p_planes )
+{
+
+    #ifdef G10_QBVH_SSE
+
+        // Initialized data
+        __m128 half    = _mm_set1_ps(0.5f),
+               sign    = _mm_set1_ps(-0.f),
+               min_x   = _mm_loadu_ps(p_node->min_x),
+               min_y   = _mm_loadu_ps(p_node->min_y),
+               min_z   = _mm_loadu_ps(p_node->min_z),
+               max_x   = _mm_loadu_ps(p_node->max_x),
+               max_y   = _mm_loadu_ps(p_node->max_y),
+               max_z   = _mm_loadu_ps(p_node->max_z),
+               cx      = _mm_mul_ps(_mm_add_ps(min_x, max_x), half),
+               cy      = _mm_mul_ps(_mm_add_ps(min_y, max_y), half),
+               cz      = _mm_mul_ps(_mm_add_ps(min_z, max_z), half),
+               ex      = _mm_mul_ps(_mm_sub_ps(max_x, min_x), half),
+               ey      = _mm_mul_ps(_mm_sub_ps(max_y, min_y), half),
+               ez      = _mm_mul_ps(_mm_sub_ps(max_z, min_z), half),
+               outside = _mm_setzero_ps();
+
+        // Iterate over each plane
+        for (int i = 0; i < 6; i++)
+        {
+
+            // Initialized data
+            __m128 nx = _mm_set1_ps(p_planes[i].x),
+                   ny = _mm_set1_ps(p_planes[i].y),
+                   nz = _mm_set1_ps(p_planes[i].z),
+                   d  = _mm_add_ps(_mm_add_ps(_mm_mul_ps(nx, cx), _mm_mul_ps(ny, cy)), _mm_add_ps(_mm_mul_ps(nz, cz), _mm_set1_ps(p_planes[i].w))),
+                   r  = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_andnot_ps(sign, nx), ex), _mm_mul_ps(_mm_andnot_ps(sign, ny), ey)), _mm_mul_ps(_mm_andnot_ps(sign, nz), ez));
+
+            // The box is entirely behind the plane
+            outside = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(d, r), _mm_setzero_ps()));
+        }
+
+        // Success
+        return ~_mm_movemask_ps(outside) & qbvh_valid_mask(p_node);
+    #else
+
+        // Initialized data
+        int mask = 0;
+
+        for (int i = 0; i < 4; i++)
+        {
+
+            // Initialized data
+            float cx      = ( p_node->min_x[i] + p_node->max_x[i] ) * 0.5f,
+                  cy      = ( p_node->min_y[i] + p_node->max_y[i] ) * 0.5f,
+                  cz      = ( p_node->min_z[i] + p_node->max_z[i] ) * 0.5f,
+                  ex      = ( p_node->max_x[i] - p_node->min_x[i] ) * 0.5f,
+                  ey      = ( p_node->max_y[i] - p_node->min_y[i] ) * 0.5f,
+                  ez      = ( p_node->max_z[i] - p_node->min_z[i] ) * 0.5f;
+            bool  outside = false;
+
+            for (int j = 0; j < 6 && outside == false; j++)
+                outside = ( p_planes[j].x * cx + p_planes[j].y * cy + p_planes[j].z * cz + p_planes[j].w ) +
+                          ( fabsf(p_planes[j].x) * ex + fabsf(p_planes[j].y) * ey + fabsf(p_planes[j].z) * ez ) < 0.f;
+
+            mask |= ( outside == false ) << i;
+        }
+
+        // Success
+        return mask & qbvh_valid_mask(p_node);
+    #endif
+}
+
+// Surface area heuristic for choosing which binary node to open
+static float qbvh_bv_area ( GXBV_t *p_bv )
+{
+
+    // Initialized data
+    float dx = p_bv->maximum.x - p_bv->minimum.x,
+          dy = p_bv->maximum.y - p_bv->minimum.y,
+          dz = p_bv->maximum.z - p_bv->minimum.z;
+
+    // Success
+    return dx * dy + dy * dz + dz * dx;
+}
+
+// A binary node worth keeping
+static bool qbvh_bv_used ( GXBV_t *p_bv )
+{
+
+    // Success
+    return p_bv && ( p_bv->entity || p_bv->left || p_bv->right );
+}
+
+// Walk the dynamic tree, counting and hashing its leaves
+static void qbvh_bv_signature ( GXBV_t *p_bv, size_t *p_count, size_t *p_hash )
+{
+
+    // Base case
+    if ( p_bv == (void *) 0 ) return;
+
+    // Leaf
+    if ( p_bv->entity )
+    {
+        *p_count += 1,
+        *p_hash  ^= (size_t) p_bv * (size_t) 0x9E3779B97F4A7C15ull;
+
+        return;
+    }
+
+    qbvh_bv_signature(p_bv->left, p_count, p_hash);
+    qbvh_bv_signature(p_bv->right, p_count, p_hash);
+}
+
+// Compile one 4-wide node from a binary node. Returns the index of the node, or -1 on error
+static i32 qbvh_compile_node ( GXQBVH_t *p_qbvh, GXBV_t *p_bv, i32 parent, u32 parent_slot )
+{
+
+    // Initialized data
+    GXBV_t *children[4] = { 0 };
+    size_t  child_count = 0;
+    i32     index       = 0;
+
+    // A lone leaf
+    if ( p_bv->entity )
+        children[child_count++] = p_bv;
+
+    // The children of the binary node
+    else
+    {
+        if ( qbvh_bv_used(p_bv->left)  ) children[child_count++] = p_bv->left;
+        if ( qbvh_bv_used(p_bv->right) ) children[child_count++] = p_bv->right;
+    }
+
+    // Open the largest interior child until there are four
+    while ( child_count < 4 )
+    {
+
+        // Initialized data
+        GXBV_t *p_open    = 0;
+        size_t  best      = 0;
+        float   best_area = -1.f;
+
+        // Find the largest interior child
+        for (size_t i = 0; i < child_count; i++)
+        {
+
+            // Initialized data
+            float area = 0.f;
+
+            // Leaves can't be opened
+            if ( children[i]->entity ) continue;
+
+            area = qbvh_bv_area(children[i]);
+
+            if ( area > best_area )
+                best_area = area,
+                best      = i;
+        }
+
+        // Nothing left to open
+        if ( best_area < 0.f ) break;
+
+        // Replace the child with its children
+        p_open          = children[best];
+        child_count    -= 1;
+        children[best]  = children[child_count];
+
+        if ( qbvh_bv_used(p_open->left)  ) children[child_count++] = p_open->left;
+        if ( qbvh_bv_used(p_open->right) ) children[child_count++] = p_open->right;
+    }
+
+    // Grow the node list
+    if ( p_qbvh->node_count == p_qbvh->node_max )
+    {
+
+        // Initialized data
+        size_t        new_max   = ( p_qbvh->node_max ) ? p_qbvh->node_max * 2 : 64;
+        GXQBVHNode_t *new_nodes = G10_REALLOC(p_qbvh->nodes, new_max * sizeof(GXQBVHNode_t));
+
+        // Error check
+        if ( new_nodes == (void *) 0 ) return -1;
+
+        p_qbvh->nodes    = new_nodes,
+        p_qbvh->node_max = new_max;
+    }
+
+    // Add the node
+    index = (i32) p_qbvh->node_count++;
+
+    p_qbvh->nodes[index] = (GXQBVHNode_t)
+    {
+        .min_x       = {  FLT_MAX,  FLT_MAX,  FLT_MAX,  FLT_MAX },
+        .min_y       = {  FLT_MAX,  FLT_MAX,  FLT_MAX,  FLT_MAX },
+        .min_z       = {  FLT_MAX,  FLT_MAX,  FLT_MAX,  FLT_MAX },
+        .max_x       = { -FLT_MAX, -FLT_MAX, -FLT_MAX, -FLT_MAX },
+        .max_y       = { -FLT_MAX, -FLT_MAX, -FLT_MAX, -FLT_MAX },
+        .max_z       = { -FLT_MAX, -FLT_MAX, -FLT_MAX, -FLT_MAX },
+        .children    = { QBVH_EMPTY, QBVH_EMPTY, QBVH_EMPTY, QBVH_EMPTY },
+        .parent      = parent,
+        .parent_slot = parent_slot
+    };
+
+    // Compile each child
+    for (size_t i = 0; i < child_count; i++)
+    {
+
+        // Initialized data
+        GXBV_t *p_child = children[i];
+        i32     c       = 0;
+
+        // Leaf
+        if ( p_child->entity )
+        {
+
+            // Grow the leaf list
+            if ( p_qbvh->leaf_count == p_qbvh->leaf_max )
+            {
+
+                // Initialized data
+                size_t   new_max    = ( p_qbvh->leaf_max ) ? p_qbvh->leaf_max * 2 : 64;
+                GXBV_t **new_leaves = G10_REALLOC(p_qbvh->leaves, new_max * sizeof(GXBV_t *));
+
+                // Error check
+                if ( new_leaves == (void *) 0 ) return -1;
+
+                p_qbvh->leaves   = new_leaves,
+                p_qbvh->leaf_max = new_max;
+            }
+
+            p_qbvh->leaves[p_qbvh->leaf_count] = p_child;
+            c = ~(i32) p_qbvh->leaf_count++;
+        }
+
+        // Interior node
+        else
+        {
+            c = qbvh_compile_node(p_qbvh, p_child, index, (u32) i);
+
+            // Error check
+            if ( c < 0 ) return -1;
+        }
+
+        // The node list may have moved, so index it again
+        p_qbvh->nodes[index].children[i] = c;
+        p_qbvh->nodes[index].min_x[i]    = p_child->minimum.x,
+        p_qbvh->nodes[index].min_y[i]    = p_child->minimum.y,
+        p_qbvh->nodes[index].min_z[i]    = p_child->minimum.z,
+        p_qbvh->nodes[index].max_x[i]    = p_child->maximum.x,
+        p_qbvh->nodes[index].max_y[i]    = p_child->maximum.y,
+        p_qbvh->nodes[index].max_z[i]    = p_child->maximum.z;
+    }
+
+    // Success
+    return index;
+}
+
+int create_qbvh ( GXQBVH_t **pp_qbvh )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( pp_qbvh == (void *) 0 ) goto no_qbvh;
+    #endif
+
+    // Initialized data
+    GXQBVH_t *p_qbvh = calloc(1, sizeof(GXQBVH_t));
+
+    // Error check
+    if ( p_qbvh == (void *) 0 ) goto no_mem;
+
+    // Return a pointer to the caller
+    *pp_qbvh = p_qbvh;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_qbvh:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [QBVH] Null pointer provided for parameter \"pp_qbvh\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    g_print_error("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int build_qbvh ( GXQBVH_t *p_qbvh, GXBV_t *p_bvh )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( p_qbvh == (void *) 0 ) goto no_qbvh;
+    #endif
+
+    // Reuse the memory of the last build
+    p_qbvh->node_count = 0,
+    p_qbvh->leaf_count = 0,
+    p_qbvh->source     = p_bvh;
+
+    // An empty tree
+    if ( qbvh_bv_used(p_bvh) == false ) return 1;
+
+    // Compile the tree, starting at the root
+    if ( qbvh_compile_node(p_qbvh, p_bvh, -1, 0) < 0 ) goto no_mem;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_qbvh:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [QBVH] Null pointer provided for parameter \"p_qbvh\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    g_print_error("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Leave an empty tree, instead of a partial one
+                p_qbvh->node_count = 0,
+                p_qbvh->leaf_count = 0;
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int refit_qbvh ( GXQBVH_t *p_qbvh )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( p_qbvh == (void *) 0 ) goto no_qbvh;
+    #endif
+
+    // Children always come after their parents, so walk backwards
+    for (size_t i = p_qbvh->node_count; i-- > 0;)
+    {
+
+        // Initialized data
+        GXQBVHNode_t *p_node = &p_qbvh->nodes[i];
+
+        // Iterate over each child
+        for (int j = 0; j < 4; j++)
+        {
+
+            // Initialized data
+            i32 c = p_node->children[j];
+
+            // Unused
+            if ( c == QBVH_EMPTY ) continue;
+
+            // Copy the bounds of the leaf
+            if ( QBVH_IS_LEAF(c) )
+            {
+
+                // Initialized data
+                GXBV_t *p_leaf = p_qbvh->leaves[QBVH_LEAF_INDEX(c)];
+
+                p_node->min_x[j] = p_leaf->minimum.x,
+                p_node->min_y[j] = p_leaf->minimum.y,
+                p_node->min_z[j] = p_leaf->minimum.z,
+                p_node->max_x[j] = p_leaf->maximum.x,
+                p_node->max_y[j] = p_leaf->maximum.y,
+                p_node->max_z[j] = p_leaf->maximum.z;
+            }
+
+            // Merge the bounds of the child node
+            else
+            {
+
+                // Initialized data
+                GXQBVHNode_t *p_child = &p_qbvh->nodes[c];
+
+                p_node->min_x[j] = fminf(fminf(p_child->min_x[0], p_child->min_x[1]), fminf(p_child->min_x[2], p_child->min_x[3])),
+                p_node->min_y[j] = fminf(fminf(p_child->min_y[0], p_child->min_y[1]), fminf(p_child->min_y[2], p_child->min_y[3])),
+                p_node->min_z[j] = fminf(fminf(p_child->min_z[0], p_child->min_z[1]), fminf(p_child->min_z[2], p_child->min_z[3])),
+                p_node->max_x[j] = fmaxf(fmaxf(p_child->max_x[0], p_child->max_x[1]), fmaxf(p_child->max_x[2], p_child->max_x[3])),
+                p_node->max_y[j] = fmaxf(fmaxf(p_child->max_y[0], p_child->max_y[1]), fmaxf(p_child->max_y[2], p_child->max_y[3])),
+                p_node->max_z[j] = fmaxf(fmaxf(p_child->max_z[0], p_child->max_z[1]), fmaxf(p_child->max_z[2], p_child->max_z[3]));
+            }
+        }
+    }
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_qbvh:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [QBVH] Null pointer provided for parameter \"p_qbvh\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int update_qbvh ( GXQBVH_t *p_qbvh, GXBV_t *p_bvh )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( p_qbvh == (void *) 0 ) goto no_qbvh;
+    #endif
+
+    // Initialized data
+    size_t leaf_count = 0,
+           leaf_hash  = 0,
+           last_hash  = 0;
+
+    // Compute the signature of the dynamic tree
+    qbvh_bv_signature(p_bvh, &leaf_count, &leaf_hash);
+
+    // Compute the signature of the last build
+    for (size_t i = 0; i < p_qbvh->leaf_count; i++)
+        last_hash ^= (size_t) p_qbvh->leaves[i] * (size_t) 0x9E3779B97F4A7C15ull;
+
+    // The same leaves are in the tree, so only the bounds changed
+    if ( p_qbvh->source == p_bvh && p_qbvh->leaf_count == leaf_count && last_hash == leaf_hash )
+        return refit_qbvh(p_qbvh);
+
+    // Leaves were added or removed
+    return build_qbvh(p_qbvh, p_bvh);
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_qbvh:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [QBVH] Null pointer provided for parameter \"p_qbvh\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+bool qbvh_raycast ( GXQBVH_t *p_qbvh, vec3 origin, vec3 direction, float max_t, GXEntity_t **pp_entity, float *p_t )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( p_qbvh    == (void *) 0 ) goto no_qbvh;
+        if ( pp_entity == (void *) 0 ) goto no_entity;
+    #endif
+
+    // Initialized data
+    struct qbvh_ray_s ray =
+    {
+        .origin            = { origin.x, origin.y, origin.z },
+        .inverse_direction = { 1.f / direction.x, 1.f / direction.y, 1.f / direction.z }
+    };
+    i32               stack[QBVH_STACK_SIZE];
+    size_t            stack_count = 0;
+    GXEntity_t       *p_hit       = 0;
+    float             best        = max_t;
+
+    // Empty tree
+    if ( p_qbvh->node_count == 0 ) return false;
+
+    // Start at the root
+    stack[stack_count++] = 0;
+
+    while ( stack_count )
+    {
+
+        // Initialized data
+        const GXQBVHNode_t *p_node     = &p_qbvh->nodes[stack[--stack_count]];
+        float               t[4]       = { 0 };
+        int                 mask       = qbvh_ray_node(p_node, &ray, best, t);
+        i32                 near[4]    = { 0 };
+        float               near_t[4]  = { 0 };
+        size_t              near_count = 0;
+
+        // Iterate over each child that was hit
+        for (int i = 0; i < 4; i++)
+        {
+
+            // Initialized data
+            i32 c = p_node->children[i];
+
+            // Missed
+            if ( ( mask & ( 1 << i ) ) == 0 ) continue;
+
+            // Closer leaf
+            if ( QBVH_IS_LEAF(c) )
+            {
+                if ( t[i] <= best )
+                    best  = t[i],
+                    p_hit = p_qbvh->leaves[QBVH_LEAF_INDEX(c)]->entity;
+
+                continue;
+            }
+
+            // Sort interior children, nearest first
+            {
+
+                // Initialized data
+                size_t j = near_count++;
+
+                for (; j > 0 && near_t[j - 1] > t[i]; j--)
+                    near[j]   = near[j - 1],
+                    near_t[j] = near_t[j - 1];
+
+                near[j]   = c,
+                near_t[j] = t[i];
+            }
+        }
+
+        // Push the farthest child first, so the nearest child is visited next
+        for (size_t i = near_count; i-- > 0;)
+        {
+
+            // Error check
+            if ( stack_count == QBVH_STACK_SIZE ) goto stack_overflow;
+
+            stack[stack_count++] = near[i];
+        }
+    }
+
+    // Write the return values
+    *pp_entity = p_hit;
+
+    if ( p_t )
+        *p_t = best;
+
+    // Success
+    return p_hit != 0;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_qbvh:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [QBVH] Null pointer provided for parameter \"p_qbvh\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return false;
+
+            no_entity:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [QBVH] Null pointer provided for parameter \"pp_entity\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return false;
+        }
+
+        // G10 errors
+        {
+            stack_overflow:
+
+                // Reported in every build, since the query would be missing part of the tree
+                g_print_error("[G10] [QBVH] Tree is deeper than %d nodes in call to function \"%s\"\n", QBVH_STACK_SIZE, __FUNCTION__);
+
+                // Error
+                return false;
+        }
+    }
+}
+
+size_t qbvh_overlap ( GXQBVH_t *p_qbvh, vec3 min, vec3 max, GXEntity_t **pp_entities, size_t max_entities )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( p_qbvh == (void *) 0 ) goto no_qbvh;
+    #endif
+
+    // Initialized data
+    float  box_min[3]  = { min.x, min.y, min.z },
+           box_max[3]  = { max.x, max.y, max.z };
+    i32    stack[QBVH_STACK_SIZE];
+    size_t stack_count = 0,
+           count       = 0;
+
+    // Empty tree
+    if ( p_qbvh->node_count == 0 ) return 0;
+
+    // Start at the root
+    stack[stack_count++] = 0;
+
+    while ( stack_count )
+    {
+
+        // Initialized data
+        const GXQBVHNode_t *p_node = &p_qbvh->nodes[stack[--stack_count]];
+        int                 mask   = qbvh_box_node(p_node, box_min, box_max);
+
+        // Iterate over each overlapping child
+        for (int i = 0; i < 4; i++)
+        {
+
+            // Initialized data
+            i32 c = p_node->children[i];
+
+            // No overlap
+            if ( ( mask & ( 1 << i ) ) == 0 ) continue;
+
+            // Leaf
+            if ( QBVH_IS_LEAF(c) )
+            {
+                if ( pp_entities && count < max_entities )
+                    pp_entities[count] = p_qbvh->leaves[QBVH_LEAF_INDEX(c)]->entity;
+
+                count++;
+
+                continue;
+            }
+
+            // Error check
+            if ( stack_count == QBVH_STACK_SIZE ) goto stack_overflow;
+
+            stack[stack_count++] = c;
+        }
+    }
+
+    // Success
+    return count;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_qbvh:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [QBVH] Null pointer provided for parameter \"p_qbvh\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // G10 errors
+        {
+            stack_overflow:
+
+                // Reported in every build, since the result would be missing part of the tree
+                g_print_error("[G10] [QBVH] Tree is deeper than %d nodes in call to function \"%s\"\n", QBVH_STACK_SIZE, __FUNCTION__);
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+size_t qbvh_frustum ( GXQBVH_t *p_qbvh, vec4 *p_planes, GXEntity_t **pp_entities, size_t max_entities )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( p_qbvh   == (void *) 0 ) goto no_qbvh;
+        if ( p_planes == (void *) 0 ) goto no_planes;
+    #endif
+
+    // Initialized data
+    i32    stack[QBVH_STACK_SIZE];
+    size_t stack_count = 0,
+           count       = 0;
+
+    // Empty tree
+    if ( p_qbvh->node_count == 0 ) return 0;
+
+    // Start at the root
+    stack[stack_count++] = 0;
+
+    while ( stack_count )
+    {
+
+        // Initialized data
+        const GXQBVHNode_t *p_node = &p_qbvh->nodes[stack[--stack_count]];
+        int                 mask   = qbvh_frustum_node(p_node, p_planes);
+
+        // Iterate over each visible child
+        for (int i = 0; i < 4; i++)
+        {
+
+            // Initialized data
+            i32 c = p_node->children[i];
+
+            // Culled
+            if ( ( mask & ( 1 << i ) ) == 0 ) continue;
+
+            // Leaf
+            if ( QBVH_IS_LEAF(c) )
+            {
+                if ( pp_entities && count < max_entities )
+                    pp_entities[count] = p_qbvh->leaves[QBVH_LEAF_INDEX(c)]->entity;
+
+                count++;
+
+                continue;
+            }
+
+            // Error check
+            if ( stack_count == QBVH_STACK_SIZE ) goto stack_overflow;
+
+            stack[stack_count++] = c;
+        }
+    }
+
+    // Success
+    return count;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_qbvh:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [QBVH] Null pointer provided for parameter \"p_qbvh\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_planes:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [QBVH] Null pointer provided for parameter \"p_planes\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // G10 errors
+        {
+            stack_overflow:
+
+                // Reported in every build, since the result would be missing part of the tree
+                g_print_error("[G10] [QBVH] Tree is deeper than %d nodes in call to function \"%s\"\n", QBVH_STACK_SIZE, __FUNCTION__);
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int frustum_planes_from_camera ( GXCamera_t *p_camera, vec4 *p_planes )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( p_camera == (void *) 0 ) goto no_camera;
+        if ( p_planes == (void *) 0 ) goto no_planes;
+    #endif
+
+    // Initialized data
+    mat4 m = mul_mat4_mat4(p_camera->view_matrix, p_camera->projection_matrix);
+
+    // Points are row vectors, so clip = p * m, and each plane is a sum of columns
+    vec4 c0 = { m.a, m.e, m.i, m.m },
+         c1 = { m.b, m.f, m.j, m.n },
+         c2 = { m.c, m.g, m.k, m.o },
+         c3 = { m.d, m.h, m.l, m.p };
+
+    // Left, right, bottom, top, near, far
+    p_planes[0] = (vec4) { c3.x + c0.x, c3.y + c0.y, c3.z + c0.z, c3.w + c0.w };
+    p_planes[1] = (vec4) { c3.x - c0.x, c3.y - c0.y, c3.z - c0.z, c3.w - c0.w };
+    p_planes[2] = (vec4) { c3.x + c1.x, c3.y + c1.y, c3.z + c1.z, c3.w + c1.w };
+    p_planes[3] = (vec4) { c3.x - c1.x, c3.y - c1.y, c3.z - c1.z, c3.w - c1.w };
+    p_planes[4] = (vec4) { c3.x + c2.x, c3.y + c2.y, c3.z + c2.z, c3.w + c2.w };
+    p_planes[5] = (vec4) { c3.x - c2.x, c3.y - c2.y, c3.z - c2.z, c3.w - c2.w };
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_camera:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [QBVH] Null pointer provided for parameter \"p_camera\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_planes:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [QBVH] Null pointer provided for parameter \"p_planes\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int destroy_qbvh ( GXQBVH_t **pp_qbvh )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( pp_qbvh == (void *) 0 ) goto no_qbvh;
+    #endif
+
+    // Initialized data
+    GXQBVH_t *p_qbvh = *pp_qbvh;
+
+    // Error check
+    if ( p_qbvh == (void *) 0 ) goto pointer_to_null_pointer;
+
+    // No more pointer for caller
+    *pp_qbvh = 0;
+
+    // Free the nodes and leaves
+    G10_FREE(p_qbvh->nodes);
+    G10_FREE(p_qbvh->leaves);
+
+    // Free the tree
+    free(p_qbvh);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_qbvh:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [QBVH] Null pointer provided for parameter \"pp_qbvh\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            pointer_to_null_pointer:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [QBVH] Parameter \"pp_qbvh\" points to null pointer in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
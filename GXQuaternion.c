@@ -1,5 +1,915 @@
 ﻿#include <G10/GXQuaternion.h>
 
+// Scalar kernels
+static void multiply_quaternion_quaternion_scalar ( quaternion *r, const quaternion *q1, const quaternion *q2 )
+{
+    *r = (quaternion)
+    {
+        .u = (q1->u * q2->u - q1->i * q2->i - q1->j * q2->j - q1->k * q2->k),
+        .i = (q1->u * q2->i + q1->i * q2->u + q1->j * q2->k - q1->k * q2->j),
+        .j = (q1->u * q2->j + q1->j * q2->u + q1->k * q2->i - q1->i * q2->k),
+        .k = (q1->u * q2->k + q1->k * q2->u + q1->i * q2->j - q1->j * q2->i)
+    };
+}
+
+// The product is q1.u * q2 + q1.i * < -i,  u, -k,  j >
+//                          + q1.j * < -j,  k,  u, -i >
+//                          + q1.k * < -k, -j,  i,  u >
+#ifdef G10_LINEAR_X86
+
+// SSE4.1 kernels
+G10_TARGET("sse4.1")
+static void multiply_quaternion_quaternion_sse41 ( quaternion *r, const quaternion *q1, const quaternion *q2 )
+{
+
+    // Initialized data
+    __m128 a  = _mm_load_ps(&q1->u),
+           b  = _mm_load_ps(&q2->u),
+           bi = _mm_xor_ps(_mm_shuffle_ps(b, b, _MM_SHUFFLE(2, 3, 0, 1)), _mm_set_ps( 0.f, -0.f,  0.f, -0.f)),
+           bj = _mm_xor_ps(_mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 0, 3, 2)), _mm_set_ps(-0.f,  0.f,  0.f, -0.f)),
+           bk = _mm_xor_ps(_mm_shuffle_ps(b, b, _MM_SHUFFLE(0, 1, 2, 3)), _mm_set_ps( 0.f,  0.f, -0.f, -0.f)),
+           ret = _mm_mul_ps(_mm_shuffle_ps(a, a, 0x00), b);
+
+    ret = _mm_add_ps(ret, _mm_mul_ps(_mm_shuffle_ps(a, a, 0x55), bi));
+    ret = _mm_add_ps(ret, _mm_mul_ps(_mm_shuffle_ps(a, a, 0xAA), bj));
+    ret = _mm_add_ps(ret, _mm_mul_ps(_mm_shuffle_ps(a, a, 0xFF), bk));
+
+    _mm_store_ps(&r->u, ret);
+}
+
+// AVX2 and FMA kernels
+G10_TARGET("avx2,fma")
+static void multiply_quaternion_quaternion_avx2 ( quaternion *r, const quaternion *q1, const quaternion *q2 )
+{
+
+    // Initialized data
+    __m128 a  = _mm_load_ps(&q1->u),
+           b  = _mm_load_ps(&q2->u),
+           bi = _mm_xor_ps(_mm_permute_ps(b, _MM_SHUFFLE(2, 3, 0, 1)), _mm_set_ps( 0.f, -0.f,  0.f, -0.f)),
+           bj = _mm_xor_ps(_mm_permute_ps(b, _MM_SHUFFLE(1, 0, 3, 2)), _mm_set_ps(-0.f,  0.f,  0.f, -0.f)),
+           bk = _mm_xor_ps(_mm_permute_ps(b, _MM_SHUFFLE(0, 1, 2, 3)), _mm_set_ps( 0.f,  0.f, -0.f, -0.f)),
+           ret = _mm_mul_ps(_mm_permute_ps(a, 0x00), b);
+
+    ret = _mm_fmadd_ps(_mm_permute_ps(a, 0x55), bi, ret);
+    ret = _mm_fmadd_ps(_mm_permute_ps(a, 0xAA), bj, ret);
+    ret = _mm_fmadd_ps(_mm_permute_ps(a, 0xFF), bk, ret);
+
+    _mm_store_ps(&r->u, ret);
+}
+#endif
+
+#ifdef G10_LINEAR_NEON
+
+// NEON kernels
+static void multiply_quaternion_quaternion_neon ( quaternion *r, const quaternion *q1, const quaternion *q2 )
+{
+
+    // Initialized data
+    static const float sign_i[4] = { -1.f,  1.f, -1.f,  1.f },
+                       sign_j[4] = { -1.f,  1.f,  1.f, -1.f },
+                       sign_k[4] = { -1.f, -1.f,  1.f,  1.f };
+    float32x4_t a   = vld1q_f32(&q1->u),
+                b   = vld1q_f32(&q2->u),
+                bj  = vextq_f32(b, b, 2),
+                ret = vmulq_laneq_f32(b, a, 0);
+
+    ret = vfmaq_laneq_f32(ret, vmulq_f32(vrev64q_f32(b) , vld1q_f32(sign_i)), a, 1);
+    ret = vfmaq_laneq_f32(ret, vmulq_f32(bj             , vld1q_f32(sign_j)), a, 2);
+    ret = vfmaq_laneq_f32(ret, vmulq_f32(vrev64q_f32(bj), vld1q_f32(sign_k)), a, 3);
+
+    vst1q_f32(&r->u, ret);
+}
+#endif
+
+// Scalar batch kernels
+static void normalize_quaternion_batch_scalar ( quaternion *r, const quaternion *q, size_t count )
+{
+    for (size_t n = 0; n < count; n++)
+    {
+
+        // Initialized data
+        quaternion x  = q[n];
+        float      vl = sqrtf((x.u * x.u) + (x.i * x.i) + (x.j * x.j) + (x.k * x.k));
+
+        r[n] = (quaternion)
+        {
+            .u = x.u / vl,
+            .i = x.i / vl,
+            .j = x.j / vl,
+            .k = x.k / vl
+        };
+    }
+}
+
+static void normalize_quaternion_batch_soa_scalar ( quaternion_soa r, quaternion_soa q, size_t count )
+{
+    for (size_t n = 0; n < count; n++)
+    {
+
+        // Initialized data
+        float u  = q.u[n],
+              i  = q.i[n],
+              j  = q.j[n],
+              k  = q.k[n],
+              vl = sqrtf((u * u) + (i * i) + (j * j) + (k * k));
+
+        r.u[n] = u / vl,
+        r.i[n] = i / vl,
+        r.j[n] = j / vl,
+        r.k[n] = k / vl;
+    }
+}
+
+// Same as scale_mat4(s) * rotation_mat4_from_quaternion(q) * translation_mat4(l), without the multiplies
+static void model_mat4_from_trs_scalar ( mat4 *r, float lx, float ly, float lz, float u, float i, float j, float k, float sx, float sy, float sz )
+{
+    *r = (mat4)
+    {
+        .a = (u * u + i * i - j * j - k * k) * sx, .b = (2 * i * j + 2 * k * u)         * sx, .c = (2 * i * k - 2 * j * u)         * sx, .d = 0.f,
+        .e = (2 * i * j - 2 * k * u)         * sy, .f = (u * u - i * i + j * j - k * k) * sy, .g = (2 * j * k + 2 * i * u)         * sy, .h = 0.f,
+        .i = (2 * i * k + 2 * j * u)         * sz, .j = (2 * j * k - 2 * i * u)         * sz, .k = (u * u - i * i - j * j + k * k) * sz, .l = 0.f,
+        .m = lx                                  , .n = ly                                  , .o = lz                                  , .p = 1.f
+    };
+}
+
+static void model_mat4_from_trs_batch_scalar ( mat4 *r, const vec3 *location, const quaternion *rotation, const vec3 *scale, size_t count )
+{
+    for (size_t n = 0; n < count; n++)
+        model_mat4_from_trs_scalar(&r[n],
+            location[n].x, location[n].y, location[n].z,
+            rotation[n].u, rotation[n].i, rotation[n].j, rotation[n].k,
+            scale[n].x   , scale[n].y   , scale[n].z
+        );
+}
+
+static void model_mat4_from_trs_batch_soa_scalar ( mat4 *r, vec3_soa location, quaternion_soa rotation, vec3_soa scale, size_t count )
+{
+    for (size_t n = 0; n < count; n++)
+        model_mat4_from_trs_scalar(&r[n],
+            location.x[n], location.y[n], location.z[n],
+            rotation.u[n], rotation.i[n], rotation.j[n], rotation.k[n],
+            scale.x[n]   , scale.y[n]   , scale.z[n]
+        );
+}
+
+static void q_slerp_batch_scalar ( quaternion *r, const quaternion *q0, const quaternion *q1, float t, size_t count )
+{
+    for (size_t n = 0; n < count; n++)
+        r[n] = q_slerp(q0[n], q1[n], t);
+}
+
+static void q_slerp_batch_soa_scalar ( quaternion_soa r, quaternion_soa q0, quaternion_soa q1, float t, size_t count )
+{
+    for (size_t n = 0; n < count; n++)
+    {
+
+        // Initialized data
+        quaternion x = q_slerp(
+            (quaternion) { q0.u[n], q0.i[n], q0.j[n], q0.k[n] },
+            (quaternion) { q1.u[n], q1.i[n], q1.j[n], q1.k[n] },
+            t
+        );
+
+        r.u[n] = x.u,
+        r.i[n] = x.i,
+        r.j[n] = x.j,
+        r.k[n] = x.k;
+    }
+}
+
+// Advance each array of a structure of arrays
+static quaternion_soa quaternion_soa_offset ( quaternion_soa q, size_t n )
+{
+    return (quaternion_soa) { q.u + n, q.i + n, q.j + n, q.k + n };
+}
+
+static vec3_soa vec3_soa_offset ( vec3_soa v, size_t n )
+{
+    return (vec3_soa) { v.x + n, v.y + n, v.z + n, ( v.w ) ? v.w + n : (void *) 0 };
+}
+
+// Coefficients of the vectorized acos and sin. acos(x) = sqrt(1 - x) * P(x) on [0, 1],
+// from Abramowitz and Stegun 4.4.46. sin is a Taylor series on [-pi/2, pi/2]
+#define QUATERNION_ACOS_0  1.5707963050f
+#define QUATERNION_ACOS_1 -0.2145988016f
+#define QUATERNION_ACOS_2  0.0889789874f
+#define QUATERNION_ACOS_3 -0.0501743046f
+#define QUATERNION_ACOS_4  0.0308918810f
+#define QUATERNION_ACOS_5 -0.0170881256f
+#define QUATERNION_ACOS_6  0.0066700901f
+#define QUATERNION_ACOS_7 -0.0012624911f
+#define QUATERNION_SIN_3  -1.6666667163e-1f
+#define QUATERNION_SIN_5   8.3333337680e-3f
+#define QUATERNION_SIN_7  -1.9841270114e-4f
+#define QUATERNION_SIN_9   2.7557314297e-6f
+#define QUATERNION_SIN_11 -2.5052108385e-8f
+#define QUATERNION_PI      3.14159265358979f
+#define QUATERNION_PI_HI   3.140625f
+#define QUATERNION_PI_LO   9.67653589793e-4f
+
+#ifdef G10_LINEAR_X86
+
+// SSE4.1 batch kernels
+G10_TARGET("sse4.1")
+static __m128 acos_sse41 ( __m128 x )
+{
+
+    // Initialized data
+    __m128 ax = _mm_andnot_ps(_mm_set1_ps(-0.f), x),
+           p  = _mm_set1_ps(QUATERNION_ACOS_7);
+
+    // Horner's method
+    p = _mm_add_ps(_mm_mul_ps(p, ax), _mm_set1_ps(QUATERNION_ACOS_6));
+    p = _mm_add_ps(_mm_mul_ps(p, ax), _mm_set1_ps(QUATERNION_ACOS_5));
+    p = _mm_add_ps(_mm_mul_ps(p, ax), _mm_set1_ps(QUATERNION_ACOS_4));
+    p = _mm_add_ps(_mm_mul_ps(p, ax), _mm_set1_ps(QUATERNION_ACOS_3));
+    p = _mm_add_ps(_mm_mul_ps(p, ax), _mm_set1_ps(QUATERNION_ACOS_2));
+    p = _mm_add_ps(_mm_mul_ps(p, ax), _mm_set1_ps(QUATERNION_ACOS_1));
+    p = _mm_add_ps(_mm_mul_ps(p, ax), _mm_set1_ps(QUATERNION_ACOS_0));
+    p = _mm_mul_ps(p, _mm_sqrt_ps(_mm_max_ps(_mm_sub_ps(_mm_set1_ps(1.f), ax), _mm_setzero_ps())));
+
+    // acos(-x) = pi - acos(x)
+    return _mm_blendv_ps(p, _mm_sub_ps(_mm_set1_ps(QUATERNION_PI), p), x);
+}
+
+G10_TARGET("sse4.1")
+static __m128 sin_sse41 ( __m128 x )
+{
+
+    // Initialized data
+    __m128 k  = _mm_round_ps(_mm_mul_ps(x, _mm_set1_ps(1.f / QUATERNION_PI)), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC),
+           y  = _mm_sub_ps(_mm_sub_ps(x, _mm_mul_ps(k, _mm_set1_ps(QUATERNION_PI_HI))), _mm_mul_ps(k, _mm_set1_ps(QUATERNION_PI_LO))),
+           y2 = _mm_mul_ps(y, y),
+           p  = _mm_set1_ps(QUATERNION_SIN_11);
+
+    // sin(y) = y + y^3 * P(y^2)
+    p = _mm_add_ps(_mm_mul_ps(p, y2), _mm_set1_ps(QUATERNION_SIN_9));
+    p = _mm_add_ps(_mm_mul_ps(p, y2), _mm_set1_ps(QUATERNION_SIN_7));
+    p = _mm_add_ps(_mm_mul_ps(p, y2), _mm_set1_ps(QUATERNION_SIN_5));
+    p = _mm_add_ps(_mm_mul_ps(p, y2), _mm_set1_ps(QUATERNION_SIN_3));
+    p = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(p, y2), y), y);
+
+    // sin(y + k * pi) = (-1)^k * sin(y)
+    return _mm_xor_ps(p, _mm_castsi128_ps(_mm_slli_epi32(_mm_cvtps_epi32(k), 31)));
+}
+
+G10_TARGET("sse4.1")
+static void q_slerp_x4_sse41 ( __m128 *q0, __m128 *q1, __m128 t, __m128 *r )
+{
+
+    // Initialized data
+    __m128 one  = _mm_set1_ps(1.f),
+           half = _mm_set1_ps(0.5f),
+           c    = _mm_add_ps(_mm_add_ps(_mm_mul_ps(q0[0], q1[0]), _mm_mul_ps(q0[1], q1[1])), _mm_add_ps(_mm_mul_ps(q0[2], q1[2]), _mm_mul_ps(q0[3], q1[3]))),
+           ht   = acos_sse41(_mm_min_ps(_mm_max_ps(c, _mm_set1_ps(-1.f)), one)),
+           sht  = _mm_sqrt_ps(_mm_max_ps(_mm_sub_ps(one, _mm_mul_ps(c, c)), _mm_setzero_ps())),
+           ra   = _mm_div_ps(sin_sse41(_mm_mul_ps(_mm_sub_ps(one, t), ht)), sht),
+           rb   = _mm_div_ps(sin_sse41(_mm_mul_ps(t, ht)), sht),
+           anti = _mm_cmplt_ps(sht, _mm_set1_ps(0.001f)),
+           same = _mm_cmpge_ps(_mm_andnot_ps(_mm_set1_ps(-0.f), c), one);
+
+    // If theta = 180, average
+    ra = _mm_blendv_ps(ra, half, anti);
+    rb = _mm_blendv_ps(rb, half, anti);
+
+    // If the half angle is zero, return q0
+    ra = _mm_blendv_ps(ra, one, same);
+    rb = _mm_blendv_ps(rb, _mm_setzero_ps(), same);
+
+    for (size_t n = 0; n < 4; n++)
+        r[n] = _mm_add_ps(_mm_mul_ps(q0[n], ra), _mm_mul_ps(q1[n], rb));
+}
+
+G10_TARGET("sse4.1")
+static void model_mat4_from_trs_x4_sse41 ( mat4 *r, __m128 *l, __m128 *q, __m128 *s )
+{
+
+    // Initialized data
+    __m128 two = _mm_set1_ps(2.f),
+           zro = _mm_setzero_ps(),
+           uu  = _mm_mul_ps(q[0], q[0]), ii = _mm_mul_ps(q[1], q[1]),
+           jj  = _mm_mul_ps(q[2], q[2]), kk = _mm_mul_ps(q[3], q[3]),
+           ij  = _mm_mul_ps(two, _mm_mul_ps(q[1], q[2])), ik = _mm_mul_ps(two, _mm_mul_ps(q[1], q[3])),
+           jk  = _mm_mul_ps(two, _mm_mul_ps(q[2], q[3])), ku = _mm_mul_ps(two, _mm_mul_ps(q[3], q[0])),
+           ju  = _mm_mul_ps(two, _mm_mul_ps(q[2], q[0])), iu = _mm_mul_ps(two, _mm_mul_ps(q[1], q[0])),
+           a   = _mm_mul_ps(_mm_sub_ps(_mm_add_ps(uu, ii), _mm_add_ps(jj, kk)), s[0]),
+           b   = _mm_mul_ps(_mm_add_ps(ij, ku), s[0]),
+           c   = _mm_mul_ps(_mm_sub_ps(ik, ju), s[0]),
+           d   = zro,
+           e   = _mm_mul_ps(_mm_sub_ps(ij, ku), s[1]),
+           f   = _mm_mul_ps(_mm_add_ps(_mm_sub_ps(uu, ii), _mm_sub_ps(jj, kk)), s[1]),
+           g   = _mm_mul_ps(_mm_add_ps(jk, iu), s[1]),
+           h   = zro,
+           i   = _mm_mul_ps(_mm_add_ps(ik, ju), s[2]),
+           j   = _mm_mul_ps(_mm_sub_ps(jk, iu), s[2]),
+           k   = _mm_mul_ps(_mm_sub_ps(_mm_sub_ps(uu, ii), _mm_sub_ps(jj, kk)), s[2]),
+           o   = zro,
+           m   = l[0],
+           n   = l[1],
+           p   = l[2],
+           w   = _mm_set1_ps(1.f);
+
+    // Lanes to matrices
+    _MM_TRANSPOSE4_PS(a, b, c, d);
+    _MM_TRANSPOSE4_PS(e, f, g, h);
+    _MM_TRANSPOSE4_PS(i, j, k, o);
+    _MM_TRANSPOSE4_PS(m, n, p, w);
+
+    _mm_store_ps(&r[0].a, a), _mm_store_ps(&r[0].e, e), _mm_store_ps(&r[0].i, i), _mm_store_ps(&r[0].m, m);
+    _mm_store_ps(&r[1].a, b), _mm_store_ps(&r[1].e, f), _mm_store_ps(&r[1].i, j), _mm_store_ps(&r[1].m, n);
+    _mm_store_ps(&r[2].a, c), _mm_store_ps(&r[2].e, g), _mm_store_ps(&r[2].i, k), _mm_store_ps(&r[2].m, p);
+    _mm_store_ps(&r[3].a, d), _mm_store_ps(&r[3].e, h), _mm_store_ps(&r[3].i, o), _mm_store_ps(&r[3].m, w);
+}
+
+// Load four consecutive 4 component values, one component per register
+G10_TARGET("sse4.1")
+static void load_x4_sse41 ( const float *p, __m128 *r )
+{
+    r[0] = _mm_load_ps(&p[0]);
+    r[1] = _mm_load_ps(&p[4]);
+    r[2] = _mm_load_ps(&p[8]);
+    r[3] = _mm_load_ps(&p[12]);
+
+    _MM_TRANSPOSE4_PS(r[0], r[1], r[2], r[3]);
+}
+
+G10_TARGET("sse4.1")
+static void normalize_quaternion_batch_sse41 ( quaternion *r, const quaternion *q, size_t count )
+{
+    for (size_t n = 0; n < count; n++)
+    {
+        __m128 x = _mm_load_ps(&q[n].u);
+
+        _mm_store_ps(&r[n].u, _mm_div_ps(x, _mm_sqrt_ps(_mm_dp_ps(x, x, 0xFF))));
+    }
+}
+
+G10_TARGET("sse4.1")
+static void normalize_quaternion_batch_soa_sse41 ( quaternion_soa r, quaternion_soa q, size_t count )
+{
+
+    // Initialized data
+    size_t n = 0;
+
+    // Four quaternions at a time
+    for (; n + 4 <= count; n += 4)
+    {
+        __m128 u  = _mm_loadu_ps(&q.u[n]),
+               i  = _mm_loadu_ps(&q.i[n]),
+               j  = _mm_loadu_ps(&q.j[n]),
+               k  = _mm_loadu_ps(&q.k[n]),
+               vl = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(u, u), _mm_mul_ps(i, i)), _mm_add_ps(_mm_mul_ps(j, j), _mm_mul_ps(k, k))));
+
+        _mm_storeu_ps(&r.u[n], _mm_div_ps(u, vl));
+        _mm_storeu_ps(&r.i[n], _mm_div_ps(i, vl));
+        _mm_storeu_ps(&r.j[n], _mm_div_ps(j, vl));
+        _mm_storeu_ps(&r.k[n], _mm_div_ps(k, vl));
+    }
+
+    // The rest
+    normalize_quaternion_batch_soa_scalar(quaternion_soa_offset(r, n), quaternion_soa_offset(q, n), count - n);
+}
+
+G10_TARGET("sse4.1")
+static void model_mat4_from_trs_batch_sse41 ( mat4 *r, const vec3 *location, const quaternion *rotation, const vec3 *scale, size_t count )
+{
+
+    // Initialized data
+    size_t n = 0;
+
+    // Four matrices at a time
+    for (; n + 4 <= count; n += 4)
+    {
+        __m128 l[4], q[4], s[4];
+
+        load_x4_sse41(&location[n].x, l);
+        load_x4_sse41(&rotation[n].u, q);
+        load_x4_sse41(&scale[n].x, s);
+
+        model_mat4_from_trs_x4_sse41(&r[n], l, q, s);
+    }
+
+    // The rest
+    model_mat4_from_trs_batch_scalar(&r[n], &location[n], &rotation[n], &scale[n], count - n);
+}
+
+G10_TARGET("sse4.1")
+static void model_mat4_from_trs_batch_soa_sse41 ( mat4 *r, vec3_soa location, quaternion_soa rotation, vec3_soa scale, size_t count )
+{
+
+    // Initialized data
+    size_t n = 0;
+
+    // Four matrices at a time
+    for (; n + 4 <= count; n += 4)
+    {
+        __m128 l[3] = { _mm_loadu_ps(&location.x[n]), _mm_loadu_ps(&location.y[n]), _mm_loadu_ps(&location.z[n]) },
+               q[4] = { _mm_loadu_ps(&rotation.u[n]), _mm_loadu_ps(&rotation.i[n]), _mm_loadu_ps(&rotation.j[n]), _mm_loadu_ps(&rotation.k[n]) },
+               s[3] = { _mm_loadu_ps(&scale.x[n])   , _mm_loadu_ps(&scale.y[n])   , _mm_loadu_ps(&scale.z[n]) };
+
+        model_mat4_from_trs_x4_sse41(&r[n], l, q, s);
+    }
+
+    // The rest
+    model_mat4_from_trs_batch_soa_scalar(&r[n], vec3_soa_offset(location, n), quaternion_soa_offset(rotation, n), vec3_soa_offset(scale, n), count - n);
+}
+
+G10_TARGET("sse4.1")
+static void q_slerp_batch_sse41 ( quaternion *r, const quaternion *q0, const quaternion *q1, float t, size_t count )
+{
+
+    // Initialized data
+    size_t n  = 0;
+    __m128 tt = _mm_set1_ps(t);
+
+    // Four quaternions at a time
+    for (; n + 4 <= count; n += 4)
+    {
+        __m128 a[4], b[4], x[4];
+
+        load_x4_sse41(&q0[n].u, a);
+        load_x4_sse41(&q1[n].u, b);
+
+        q_slerp_x4_sse41(a, b, tt, x);
+
+        // Lanes to quaternions
+        _MM_TRANSPOSE4_PS(x[0], x[1], x[2], x[3]);
+
+        _mm_store_ps(&r[n + 0].u, x[0]);
+        _mm_store_ps(&r[n + 1].u, x[1]);
+        _mm_store_ps(&r[n + 2].u, x[2]);
+        _mm_store_ps(&r[n + 3].u, x[3]);
+    }
+
+    // The rest
+    q_slerp_batch_scalar(&r[n], &q0[n], &q1[n], t, count - n);
+}
+
+G10_TARGET("sse4.1")
+static void q_slerp_batch_soa_sse41 ( quaternion_soa r, quaternion_soa q0, quaternion_soa q1, float t, size_t count )
+{
+
+    // Initialized data
+    size_t n  = 0;
+    __m128 tt = _mm_set1_ps(t);
+
+    // Four quaternions at a time
+    for (; n + 4 <= count; n += 4)
+    {
+        __m128 a[4] = { _mm_loadu_ps(&q0.u[n]), _mm_loadu_ps(&q0.i[n]), _mm_loadu_ps(&q0.j[n]), _mm_loadu_ps(&q0.k[n]) },
+               b[4] = { _mm_loadu_ps(&q1.u[n]), _mm_loadu_ps(&q1.i[n]), _mm_loadu_ps(&q1.j[n]), _mm_loadu_ps(&q1.k[n]) },
+               x[4];
+
+        q_slerp_x4_sse41(a, b, tt, x);
+
+        _mm_storeu_ps(&r.u[n], x[0]);
+        _mm_storeu_ps(&r.i[n], x[1]);
+        _mm_storeu_ps(&r.j[n], x[2]);
+        _mm_storeu_ps(&r.k[n], x[3]);
+    }
+
+    // The rest
+    q_slerp_batch_soa_scalar(quaternion_soa_offset(r, n), quaternion_soa_offset(q0, n), quaternion_soa_offset(q1, n), t, count - n);
+}
+
+// AVX2 and FMA batch kernels. Array of structure layouts use the SSE4.1 kernels
+G10_TARGET("avx2,fma")
+static __m256 acos_avx2 ( __m256 x )
+{
+
+    // Initialized data
+    __m256 ax = _mm256_andnot_ps(_mm256_set1_ps(-0.f), x),
+           p  = _mm256_set1_ps(QUATERNION_ACOS_7);
+
+    // Horner's method
+    p = _mm256_fmadd_ps(p, ax, _mm256_set1_ps(QUATERNION_ACOS_6));
+    p = _mm256_fmadd_ps(p, ax, _mm256_set1_ps(QUATERNION_ACOS_5));
+    p = _mm256_fmadd_ps(p, ax, _mm256_set1_ps(QUATERNION_ACOS_4));
+    p = _mm256_fmadd_ps(p, ax, _mm256_set1_ps(QUATERNION_ACOS_3));
+    p = _mm256_fmadd_ps(p, ax, _mm256_set1_ps(QUATERNION_ACOS_2));
+    p = _mm256_fmadd_ps(p, ax, _mm256_set1_ps(QUATERNION_ACOS_1));
+    p = _mm256_fmadd_ps(p, ax, _mm256_set1_ps(QUATERNION_ACOS_0));
+    p = _mm256_mul_ps(p, _mm256_sqrt_ps(_mm256_max_ps(_mm256_sub_ps(_mm256_set1_ps(1.f), ax), _mm256_setzero_ps())));
+
+    // acos(-x) = pi - acos(x)
+    return _mm256_blendv_ps(p, _mm256_sub_ps(_mm256_set1_ps(QUATERNION_PI), p), x);
+}
+
+G10_TARGET("avx2,fma")
+static __m256 sin_avx2 ( __m256 x )
+{
+
+    // Initialized data
+    __m256 k  = _mm256_round_ps(_mm256_mul_ps(x, _mm256_set1_ps(1.f / QUATERNION_PI)), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC),
+           y  = _mm256_fnmadd_ps(k, _mm256_set1_ps(QUATERNION_PI_LO), _mm256_fnmadd_ps(k, _mm256_set1_ps(QUATERNION_PI_HI), x)),
+           y2 = _mm256_mul_ps(y, y),
+           p  = _mm256_set1_ps(QUATERNION_SIN_11);
+
+    // sin(y) = y + y^3 * P(y^2)
+    p = _mm256_fmadd_ps(p, y2, _mm256_set1_ps(QUATERNION_SIN_9));
+    p = _mm256_fmadd_ps(p, y2, _mm256_set1_ps(QUATERNION_SIN_7));
+    p = _mm256_fmadd_ps(p, y2, _mm256_set1_ps(QUATERNION_SIN_5));
+    p = _mm256_fmadd_ps(p, y2, _mm256_set1_ps(QUATERNION_SIN_3));
+    p = _mm256_fmadd_ps(_mm256_mul_ps(p, y2), y, y);
+
+    // sin(y + k * pi) = (-1)^k * sin(y)
+    return _mm256_xor_ps(p, _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_cvtps_epi32(k), 31)));
+}
+
+G10_TARGET("avx2,fma")
+static void normalize_quaternion_batch_avx2 ( quaternion *r, const quaternion *q, size_t count )
+{
+
+    // Initialized data
+    size_t n = 0;
+
+    // Two quaternions at a time
+    for (; n + 2 <= count; n += 2)
+    {
+        __m256 x = _mm256_loadu_ps(&q[n].u),
+               h = _mm256_mul_ps(x, x);
+
+        // Sum each quaternion into each of its lanes
+        h = _mm256_hadd_ps(h, h);
+        h = _mm256_hadd_ps(h, h);
+
+        _mm256_storeu_ps(&r[n].u, _mm256_div_ps(x, _mm256_sqrt_ps(h)));
+    }
+
+    // The rest
+    normalize_quaternion_batch_sse41(&r[n], &q[n], count - n);
+}
+
+G10_TARGET("avx2,fma")
+static void normalize_quaternion_batch_soa_avx2 ( quaternion_soa r, quaternion_soa q, size_t count )
+{
+
+    // Initialized data
+    size_t n = 0;
+
+    // Eight quaternions at a time
+    for (; n + 8 <= count; n += 8)
+    {
+        __m256 u  = _mm256_loadu_ps(&q.u[n]),
+               i  = _mm256_loadu_ps(&q.i[n]),
+               j  = _mm256_loadu_ps(&q.j[n]),
+               k  = _mm256_loadu_ps(&q.k[n]),
+               vl = _mm256_sqrt_ps(_mm256_fmadd_ps(k, k, _mm256_fmadd_ps(j, j, _mm256_fmadd_ps(i, i, _mm256_mul_ps(u, u)))));
+
+        _mm256_storeu_ps(&r.u[n], _mm256_div_ps(u, vl));
+        _mm256_storeu_ps(&r.i[n], _mm256_div_ps(i, vl));
+        _mm256_storeu_ps(&r.j[n], _mm256_div_ps(j, vl));
+        _mm256_storeu_ps(&r.k[n], _mm256_div_ps(k, vl));
+    }
+
+    // The rest
+    normalize_quaternion_batch_soa_scalar(quaternion_soa_offset(r, n), quaternion_soa_offset(q, n), count - n);
+}
+
+G10_TARGET("avx2,fma")
+static void q_slerp_batch_soa_avx2 ( quaternion_soa r, quaternion_soa q0, quaternion_soa q1, float t, size_t count )
+{
+
+    // Initialized data
+    size_t n    = 0;
+    __m256 tt   = _mm256_set1_ps(t),
+           one  = _mm256_set1_ps(1.f),
+           half = _mm256_set1_ps(0.5f),
+           zro  = _mm256_setzero_ps();
+
+    // Eight quaternions at a time
+    for (; n + 8 <= count; n += 8)
+    {
+        __m256 au   = _mm256_loadu_ps(&q0.u[n]), ai = _mm256_loadu_ps(&q0.i[n]), aj = _mm256_loadu_ps(&q0.j[n]), ak = _mm256_loadu_ps(&q0.k[n]),
+               bu   = _mm256_loadu_ps(&q1.u[n]), bi = _mm256_loadu_ps(&q1.i[n]), bj = _mm256_loadu_ps(&q1.j[n]), bk = _mm256_loadu_ps(&q1.k[n]),
+               c    = _mm256_fmadd_ps(ak, bk, _mm256_fmadd_ps(aj, bj, _mm256_fmadd_ps(ai, bi, _mm256_mul_ps(au, bu)))),
+               ht   = acos_avx2(_mm256_min_ps(_mm256_max_ps(c, _mm256_set1_ps(-1.f)), one)),
+               sht  = _mm256_sqrt_ps(_mm256_max_ps(_mm256_fnmadd_ps(c, c, one), zro)),
+               ra   = _mm256_div_ps(sin_avx2(_mm256_mul_ps(_mm256_sub_ps(one, tt), ht)), sht),
+               rb   = _mm256_div_ps(sin_avx2(_mm256_mul_ps(tt, ht)), sht),
+               anti = _mm256_cmp_ps(sht, _mm256_set1_ps(0.001f), _CMP_LT_OQ),
+               same = _mm256_cmp_ps(_mm256_andnot_ps(_mm256_set1_ps(-0.f), c), one, _CMP_GE_OQ);
+
+        // If theta = 180, average
+        ra = _mm256_blendv_ps(ra, half, anti);
+        rb = _mm256_blendv_ps(rb, half, anti);
+
+        // If the half angle is zero, return q0
+        ra = _mm256_blendv_ps(ra, one, same);
+        rb = _mm256_blendv_ps(rb, zro, same);
+
+        _mm256_storeu_ps(&r.u[n], _mm256_fmadd_ps(bu, rb, _mm256_mul_ps(au, ra)));
+        _mm256_storeu_ps(&r.i[n], _mm256_fmadd_ps(bi, rb, _mm256_mul_ps(ai, ra)));
+        _mm256_storeu_ps(&r.j[n], _mm256_fmadd_ps(bj, rb, _mm256_mul_ps(aj, ra)));
+        _mm256_storeu_ps(&r.k[n], _mm256_fmadd_ps(bk, rb, _mm256_mul_ps(ak, ra)));
+    }
+
+    // The rest
+    q_slerp_batch_soa_sse41(quaternion_soa_offset(r, n), quaternion_soa_offset(q0, n), quaternion_soa_offset(q1, n), t, count - n);
+}
+#endif
+
+#ifdef G10_LINEAR_NEON
+
+// NEON batch kernels
+static float32x4_t acos_neon ( float32x4_t x )
+{
+
+    // Initialized data
+    float32x4_t ax = vabsq_f32(x),
+                p  = vdupq_n_f32(QUATERNION_ACOS_7);
+
+    // Horner's method
+    p = vfmaq_f32(vdupq_n_f32(QUATERNION_ACOS_6), p, ax);
+    p = vfmaq_f32(vdupq_n_f32(QUATERNION_ACOS_5), p, ax);
+    p = vfmaq_f32(vdupq_n_f32(QUATERNION_ACOS_4), p, ax);
+    p = vfmaq_f32(vdupq_n_f32(QUATERNION_ACOS_3), p, ax);
+    p = vfmaq_f32(vdupq_n_f32(QUATERNION_ACOS_2), p, ax);
+    p = vfmaq_f32(vdupq_n_f32(QUATERNION_ACOS_1), p, ax);
+    p = vfmaq_f32(vdupq_n_f32(QUATERNION_ACOS_0), p, ax);
+    p = vmulq_f32(p, vsqrtq_f32(vmaxq_f32(vsubq_f32(vdupq_n_f32(1.f), ax), vdupq_n_f32(0.f))));
+
+    // acos(-x) = pi - acos(x)
+    return vbslq_f32(vcltq_f32(x, vdupq_n_f32(0.f)), vsubq_f32(vdupq_n_f32(QUATERNION_PI), p), p);
+}
+
+static float32x4_t sin_neon ( float32x4_t x )
+{
+
+    // Initialized data
+    float32x4_t k  = vrndnq_f32(vmulq_n_f32(x, 1.f / QUATERNION_PI)),
+                y  = vfmsq_f32(vfmsq_f32(x, k, vdupq_n_f32(QUATERNION_PI_HI)), k, vdupq_n_f32(QUATERNION_PI_LO)),
+                y2 = vmulq_f32(y, y),
+                p  = vdupq_n_f32(QUATERNION_SIN_11);
+
+    // sin(y) = y + y^3 * P(y^2)
+    p = vfmaq_f32(vdupq_n_f32(QUATERNION_SIN_9), p, y2);
+    p = vfmaq_f32(vdupq_n_f32(QUATERNION_SIN_7), p, y2);
+    p = vfmaq_f32(vdupq_n_f32(QUATERNION_SIN_5), p, y2);
+    p = vfmaq_f32(vdupq_n_f32(QUATERNION_SIN_3), p, y2);
+    p = vfmaq_f32(y, vmulq_f32(p, y2), y);
+
+    // sin(y + k * pi) = (-1)^k * sin(y)
+    return vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(p), vshlq_n_u32(vreinterpretq_u32_s32(vcvtq_s32_f32(k)), 31)));
+}
+
+static float32x4x4_t q_slerp_x4_neon ( float32x4x4_t q0, float32x4x4_t q1, float32x4_t t )
+{
+
+    // Initialized data
+    float32x4x4_t r;
+    float32x4_t   one  = vdupq_n_f32(1.f),
+                  c    = vfmaq_f32(vfmaq_f32(vfmaq_f32(vmulq_f32(q0.val[0], q1.val[0]), q0.val[1], q1.val[1]), q0.val[2], q1.val[2]), q0.val[3], q1.val[3]),
+                  ht   = acos_neon(vminq_f32(vmaxq_f32(c, vdupq_n_f32(-1.f)), one)),
+                  sht  = vsqrtq_f32(vmaxq_f32(vfmsq_f32(one, c, c), vdupq_n_f32(0.f))),
+                  ra   = vdivq_f32(sin_neon(vmulq_f32(vsubq_f32(one, t), ht)), sht),
+                  rb   = vdivq_f32(sin_neon(vmulq_f32(t, ht)), sht);
+    uint32x4_t    anti = vcltq_f32(sht, vdupq_n_f32(0.001f)),
+                  same = vcgeq_f32(vabsq_f32(c), one);
+
+    // If theta = 180, average
+    ra = vbslq_f32(anti, vdupq_n_f32(0.5f), ra);
+    rb = vbslq_f32(anti, vdupq_n_f32(0.5f), rb);
+
+    // If the half angle is zero, return q0
+    ra = vbslq_f32(same, one, ra);
+    rb = vbslq_f32(same, vdupq_n_f32(0.f), rb);
+
+    for (size_t n = 0; n < 4; n++)
+        r.val[n] = vfmaq_f32(vmulq_f32(q0.val[n], ra), q1.val[n], rb);
+
+    return r;
+}
+
+// Lanes to matrix rows
+static void transpose_neon ( float32x4_t *a, float32x4_t *b, float32x4_t *c, float32x4_t *d )
+{
+    float32x4x2_t ab = vtrnq_f32(*a, *b),
+                  cd = vtrnq_f32(*c, *d);
+
+    *a = vcombine_f32(vget_low_f32(ab.val[0]) , vget_low_f32(cd.val[0]));
+    *b = vcombine_f32(vget_low_f32(ab.val[1]) , vget_low_f32(cd.val[1]));
+    *c = vcombine_f32(vget_high_f32(ab.val[0]), vget_high_f32(cd.val[0]));
+    *d = vcombine_f32(vget_high_f32(ab.val[1]), vget_high_f32(cd.val[1]));
+}
+
+static void model_mat4_from_trs_x4_neon ( mat4 *r, const float32x4_t *l, const float32x4_t *q, const float32x4_t *s )
+{
+
+    // Initialized data
+    float32x4_t zro = vdupq_n_f32(0.f),
+                uu  = vmulq_f32(q[0], q[0]), ii = vmulq_f32(q[1], q[1]),
+                jj  = vmulq_f32(q[2], q[2]), kk = vmulq_f32(q[3], q[3]),
+                ij  = vmulq_n_f32(vmulq_f32(q[1], q[2]), 2.f), ik = vmulq_n_f32(vmulq_f32(q[1], q[3]), 2.f),
+                jk  = vmulq_n_f32(vmulq_f32(q[2], q[3]), 2.f), ku = vmulq_n_f32(vmulq_f32(q[3], q[0]), 2.f),
+                ju  = vmulq_n_f32(vmulq_f32(q[2], q[0]), 2.f), iu = vmulq_n_f32(vmulq_f32(q[1], q[0]), 2.f),
+                a   = vmulq_f32(vsubq_f32(vaddq_f32(uu, ii), vaddq_f32(jj, kk)), s[0]),
+                b   = vmulq_f32(vaddq_f32(ij, ku), s[0]),
+                c   = vmulq_f32(vsubq_f32(ik, ju), s[0]),
+                d   = zro,
+                e   = vmulq_f32(vsubq_f32(ij, ku), s[1]),
+                f   = vmulq_f32(vaddq_f32(vsubq_f32(uu, ii), vsubq_f32(jj, kk)), s[1]),
+                g   = vmulq_f32(vaddq_f32(jk, iu), s[1]),
+                h   = zro,
+                i   = vmulq_f32(vaddq_f32(ik, ju), s[2]),
+                j   = vmulq_f32(vsubq_f32(jk, iu), s[2]),
+                k   = vmulq_f32(vsubq_f32(vsubq_f32(uu, ii), vsubq_f32(jj, kk)), s[2]),
+                o   = zro,
+                m   = l[0],
+                n   = l[1],
+                p   = l[2],
+                w   = vdupq_n_f32(1.f);
+
+    // Lanes to matrices
+    transpose_neon(&a, &b, &c, &d);
+    transpose_neon(&e, &f, &g, &h);
+    transpose_neon(&i, &j, &k, &o);
+    transpose_neon(&m, &n, &p, &w);
+
+    vst1q_f32(&r[0].a, a), vst1q_f32(&r[0].e, e), vst1q_f32(&r[0].i, i), vst1q_f32(&r[0].m, m);
+    vst1q_f32(&r[1].a, b), vst1q_f32(&r[1].e, f), vst1q_f32(&r[1].i, j), vst1q_f32(&r[1].m, n);
+    vst1q_f32(&r[2].a, c), vst1q_f32(&r[2].e, g), vst1q_f32(&r[2].i, k), vst1q_f32(&r[2].m, p);
+    vst1q_f32(&r[3].a, d), vst1q_f32(&r[3].e, h), vst1q_f32(&r[3].i, o), vst1q_f32(&r[3].m, w);
+}
+
+static void normalize_quaternion_batch_neon ( quaternion *r, const quaternion *q, size_t count )
+{
+    for (size_t n = 0; n < count; n++)
+    {
+        float32x4_t x = vld1q_f32(&q[n].u);
+
+        vst1q_f32(&r[n].u, vdivq_f32(x, vdupq_n_f32(sqrtf(vaddvq_f32(vmulq_f32(x, x))))));
+    }
+}
+
+static void normalize_quaternion_batch_soa_neon ( quaternion_soa r, quaternion_soa q, size_t count )
+{
+
+    // Initialized data
+    size_t n = 0;
+
+    // Four quaternions at a time
+    for (; n + 4 <= count; n += 4)
+    {
+        float32x4_t u  = vld1q_f32(&q.u[n]),
+                    i  = vld1q_f32(&q.i[n]),
+                    j  = vld1q_f32(&q.j[n]),
+                    k  = vld1q_f32(&q.k[n]),
+                    vl = vsqrtq_f32(vfmaq_f32(vfmaq_f32(vfmaq_f32(vmulq_f32(u, u), i, i), j, j), k, k));
+
+        vst1q_f32(&r.u[n], vdivq_f32(u, vl));
+        vst1q_f32(&r.i[n], vdivq_f32(i, vl));
+        vst1q_f32(&r.j[n], vdivq_f32(j, vl));
+        vst1q_f32(&r.k[n], vdivq_f32(k, vl));
+    }
+
+    // The rest
+    normalize_quaternion_batch_soa_scalar(quaternion_soa_offset(r, n), quaternion_soa_offset(q, n), count - n);
+}
+
+static void model_mat4_from_trs_batch_neon ( mat4 *r, const vec3 *location, const quaternion *rotation, const vec3 *scale, size_t count )
+{
+
+    // Initialized data
+    size_t n = 0;
+
+    // Four matrices at a time. vld4q splits components into registers
+    for (; n + 4 <= count; n += 4)
+    {
+        float32x4x4_t l = vld4q_f32(&location[n].x),
+                      q = vld4q_f32(&rotation[n].u),
+                      s = vld4q_f32(&scale[n].x);
+
+        model_mat4_from_trs_x4_neon(&r[n], l.val, q.val, s.val);
+    }
+
+    // The rest
+    model_mat4_from_trs_batch_scalar(&r[n], &location[n], &rotation[n], &scale[n], count - n);
+}
+
+static void model_mat4_from_trs_batch_soa_neon ( mat4 *r, vec3_soa location, quaternion_soa rotation, vec3_soa scale, size_t count )
+{
+
+    // Initialized data
+    size_t n = 0;
+
+    // Four matrices at a time
+    for (; n + 4 <= count; n += 4)
+    {
+        float32x4_t l[3] = { vld1q_f32(&location.x[n]), vld1q_f32(&location.y[n]), vld1q_f32(&location.z[n]) },
+                    q[4] = { vld1q_f32(&rotation.u[n]), vld1q_f32(&rotation.i[n]), vld1q_f32(&rotation.j[n]), vld1q_f32(&rotation.k[n]) },
+                    s[3] = { vld1q_f32(&scale.x[n])   , vld1q_f32(&scale.y[n])   , vld1q_f32(&scale.z[n]) };
+
+        model_mat4_from_trs_x4_neon(&r[n], l, q, s);
+    }
+
+    // The rest
+    model_mat4_from_trs_batch_soa_scalar(&r[n], vec3_soa_offset(location, n), quaternion_soa_offset(rotation, n), vec3_soa_offset(scale, n), count - n);
+}
+
+static void q_slerp_batch_neon ( quaternion *r, const quaternion *q0, const quaternion *q1, float t, size_t count )
+{
+
+    // Initialized data
+    size_t      n  = 0;
+    float32x4_t tt = vdupq_n_f32(t);
+
+    // Four quaternions at a time. vld4q and vst4q convert between layouts
+    for (; n + 4 <= count; n += 4)
+        vst4q_f32(&r[n].u, q_slerp_x4_neon(vld4q_f32(&q0[n].u), vld4q_f32(&q1[n].u), tt));
+
+    // The rest
+    q_slerp_batch_scalar(&r[n], &q0[n], &q1[n], t, count - n);
+}
+
+static void q_slerp_batch_soa_neon ( quaternion_soa r, quaternion_soa q0, quaternion_soa q1, float t, size_t count )
+{
+
+    // Initialized data
+    size_t      n  = 0;
+    float32x4_t tt = vdupq_n_f32(t);
+
+    // Four quaternions at a time
+    for (; n + 4 <= count; n += 4)
+    {
+        float32x4x4_t a = { { vld1q_f32(&q0.u[n]), vld1q_f32(&q0.i[n]), vld1q_f32(&q0.j[n]), vld1q_f32(&q0.k[n]) } },
+                      b = { { vld1q_f32(&q1.u[n]), vld1q_f32(&q1.i[n]), vld1q_f32(&q1.j[n]), vld1q_f32(&q1.k[n]) } },
+                      x = q_slerp_x4_neon(a, b, tt);
+
+        vst1q_f32(&r.u[n], x.val[0]);
+        vst1q_f32(&r.i[n], x.val[1]);
+        vst1q_f32(&r.j[n], x.val[2]);
+        vst1q_f32(&r.k[n], x.val[3]);
+    }
+
+    // The rest
+    q_slerp_batch_soa_scalar(quaternion_soa_offset(r, n), quaternion_soa_offset(q0, n), quaternion_soa_offset(q1, n), t, count - n);
+}
+#endif
+
+// Selected kernels. Scalar until g_init picks a backend
+static void (*multiply_quaternion_quaternion_kernel) ( quaternion *r, const quaternion *q1, const quaternion *q2 )                              = multiply_quaternion_quaternion_scalar;
+static void (*normalize_quaternion_batch_kernel)     ( quaternion *r, const quaternion *q, size_t count )                                      = normalize_quaternion_batch_scalar;
+static void (*normalize_quaternion_batch_soa_kernel) ( quaternion_soa r, quaternion_soa q, size_t count )                                      = normalize_quaternion_batch_soa_scalar;
+static void (*model_mat4_from_trs_batch_kernel)      ( mat4 *r, const vec3 *location, const quaternion *rotation, const vec3 *scale, size_t count ) = model_mat4_from_trs_batch_scalar;
+static void (*model_mat4_from_trs_batch_soa_kernel)  ( mat4 *r, vec3_soa location, quaternion_soa rotation, vec3_soa scale, size_t count )     = model_mat4_from_trs_batch_soa_scalar;
+static void (*q_slerp_batch_kernel)                  ( quaternion *r, const quaternion *q0, const quaternion *q1, float t, size_t count )      = q_slerp_batch_scalar;
+static void (*q_slerp_batch_soa_kernel)              ( quaternion_soa r, quaternion_soa q0, quaternion_soa q1, float t, size_t count )         = q_slerp_batch_soa_scalar;
+
+void set_quaternion_backend ( linear_backend_t backend )
+{
+
+    // Default to scalar kernels
+    multiply_quaternion_quaternion_kernel = multiply_quaternion_quaternion_scalar;
+    normalize_quaternion_batch_kernel     = normalize_quaternion_batch_scalar;
+    normalize_quaternion_batch_soa_kernel = normalize_quaternion_batch_soa_scalar;
+    model_mat4_from_trs_batch_kernel      = model_mat4_from_trs_batch_scalar;
+    model_mat4_from_trs_batch_soa_kernel  = model_mat4_from_trs_batch_soa_scalar;
+    q_slerp_batch_kernel                  = q_slerp_batch_scalar;
+    q_slerp_batch_soa_kernel              = q_slerp_batch_soa_scalar;
+
+    #ifdef G10_LINEAR_X86
+
+        // SSE4.1
+        if ( backend == linear_backend_sse41 || backend == linear_backend_avx2 )
+        {
+            multiply_quaternion_quaternion_kernel = multiply_quaternion_quaternion_sse41;
+            normalize_quaternion_batch_kernel     = normalize_quaternion_batch_sse41;
+            normalize_quaternion_batch_soa_kernel = normalize_quaternion_batch_soa_sse41;
+            model_mat4_from_trs_batch_kernel      = model_mat4_from_trs_batch_sse41;
+            model_mat4_from_trs_batch_soa_kernel  = model_mat4_from_trs_batch_soa_sse41;
+            q_slerp_batch_kernel                  = q_slerp_batch_sse41;
+            q_slerp_batch_soa_kernel              = q_slerp_batch_soa_sse41;
+        }
+
+        // AVX2 and FMA
+        if ( backend == linear_backend_avx2 )
+        {
+            multiply_quaternion_quaternion_kernel = multiply_quaternion_quaternion_avx2;
+            normalize_quaternion_batch_kernel     = normalize_quaternion_batch_avx2;
+            normalize_quaternion_batch_soa_kernel = normalize_quaternion_batch_soa_avx2;
+            q_slerp_batch_soa_kernel              = q_slerp_batch_soa_avx2;
+        }
+    #endif
+
+    #ifdef G10_LINEAR_NEON
+
+        // NEON
+        if ( backend == linear_backend_neon )
+        {
+            multiply_quaternion_quaternion_kernel = multiply_quaternion_quaternion_neon;
+            normalize_quaternion_batch_kernel     = normalize_quaternion_batch_neon;
+            normalize_quaternion_batch_soa_kernel = normalize_quaternion_batch_soa_neon;
+            model_mat4_from_trs_batch_kernel      = model_mat4_from_trs_batch_neon;
+            model_mat4_from_trs_batch_soa_kernel  = model_mat4_from_trs_batch_soa_neon;
+            q_slerp_batch_kernel                  = q_slerp_batch_neon;
+            q_slerp_batch_soa_kernel              = q_slerp_batch_soa_neon;
+        }
+    #endif
+
+    return;
+}
+
 quaternion identity_quaternion ( void )
 {
 
@@ -81,14 +991,19 @@ quaternion multiply_quaternion_quaternion_vec4 ( quaternion q1, quaternion q2 )
 quaternion multiply_quaternion_quaternion ( quaternion q1, quaternion q2 )
 {
 
+    // Initialized data
+    quaternion ret;
+
+    // Multiply
+    multiply_quaternion_quaternion_kernel(&ret, &q1, &q2);
+
     // Success
-    return (quaternion)
-    {
-        .u = (q1.u * q2.u - q1.i * q2.i - q1.j * q2.j - q1.k * q2.k),
-        .i = (q1.u * q2.i + q1.i * q2.u + q1.j * q2.k - q1.k * q2.j),
-        .j = (q1.u * q2.j + q1.j * q2.u + q1.k * q2.i - q1.i * q2.k),
-        .k = (q1.u * q2.k + q1.k * q2.u + q1.i * q2.j - q1.j * q2.i)
-    };
+    return ret;
+}
+
+void multiply_quaternion_quaternion_p ( quaternion *r, const quaternion *q1, const quaternion *q2 )
+{
+    multiply_quaternion_quaternion_kernel(r, q1, q2);
 }
 
 mat4 rotation_mat4_from_quaternion ( quaternion q )
@@ -209,4 +1124,34 @@ quaternion q_slerp ( quaternion q0, quaternion q1, float delta_time )
         .j = (q0.j * rA + q1.j * rB),
         .k = (q0.k * rA + q1.k * rB)
     };
-}
\ No newline at end of file
+}
+
+void normalize_quaternion_batch ( quaternion *r, const quaternion *q, size_t count )
+{
+    normalize_quaternion_batch_kernel(r, q, count);
+}
+
+void normalize_quaternion_batch_soa ( quaternion_soa r, quaternion_soa q, size_t count )
+{
+    normalize_quaternion_batch_soa_kernel(r, q, count);
+}
+
+void model_mat4_from_trs_batch ( mat4 *r, const vec3 *location, const quaternion *rotation, const vec3 *scale, size_t count )
+{
+    model_mat4_from_trs_batch_kernel(r, location, rotation, scale, count);
+}
+
+void model_mat4_from_trs_batch_soa ( mat4 *r, vec3_soa location, quaternion_soa rotation, vec3_soa scale, size_t count )
+{
+    model_mat4_from_trs_batch_soa_kernel(r, location, rotation, scale, count);
+}
+
+void q_slerp_batch ( quaternion *r, const quaternion *q0, const quaternion *q1, float t, size_t count )
+{
+    q_slerp_batch_kernel(r, q0, q1, t, count);
+}
+
+void q_slerp_batch_soa ( quaternion_soa r, quaternion_soa q0, quaternion_soa q1, float t, size_t count )
+{
+    q_slerp_batch_soa_kernel(r, q0, q1, t, count);
+}
@@ -1,4 +1,7 @@
-﻿#include <G10/GXRenderer.h>
+﻿// Allocations made here are counted against the renderer
+#define G10_ALLOC_TAG alloc_tag_renderer
+
+#include <G10/GXRenderer.h>
 
 // Constants
 #define PRESENTATION_MODES_COUNT 4
@@ -1063,7 +1066,10 @@ int create_image ( GXImage_t **pp_image )
     GXImage_t *p_image = calloc(1, sizeof(GXImage_t));
 
     // Error check
-    if ( pp_image == (void *) 0 ) goto no_mem;
+    if ( p_image == (void *) 0 ) goto no_mem;
+
+    // Count the image
+    G10_STAT_ADD(stat_images, 1);
 
     // Return a pointer to the caller
     *pp_image = p_image;
@@ -2921,11 +2927,15 @@ int load_render_pass_as_json_value ( GXRenderPass_t **pp_render_pass, JSONValue_
             // Get the subpass
             p_subpass = dict_get(p_render_pass->subpasses, p_name->string);
 
-            // Allocate memory for an array of shader names
-            p_subpass->shader_names = calloc(shader_count, sizeof(char *));
+            // Allocate memory for an array of shader names, handles, and draw queues
+            p_subpass->shader_names   = calloc(shader_count, sizeof(char *));
+            p_subpass->shader_handles = calloc(shader_count, sizeof(handle_t));
+            p_subpass->draw_queues    = calloc(shader_count, sizeof(queue *));
 
             // Error check
-            if ( p_subpass->shader_names == (void *) 0 ) goto no_mem;
+            if ( p_subpass->shader_names   == (void *) 0 ) goto no_mem;
+            if ( p_subpass->shader_handles == (void *) 0 ) goto no_mem;
+            if ( p_subpass->draw_queues    == (void *) 0 ) goto no_mem;
 
             // Set the shader count
             p_subpass->shader_count = shader_count;
@@ -2946,8 +2956,18 @@ int load_render_pass_as_json_value ( GXRenderPass_t **pp_render_pass, JSONValue_
                 // Add the draw queue to the subpass
                 dict_add(p_instance->context.loading_renderer->current_render_pass->draw_queue_types, p_shader->name, p_draw_queue);
 
-                // Set the subpasses shader
-                p_subpass->shader_names[i] = p_shader->name;
+                // Cache the shader, so it has a handle. Other loaders reach the cache through g_claim_shader
+                SDL_LockMutex(p_instance->mutexes.shader_cache);
+
+                if ( p_shader->handle == HANDLE_INVALID )
+                    g_cache_shader(p_instance, p_shader);
+
+                SDL_UnlockMutex(p_instance->mutexes.shader_cache);
+
+                // Set the subpasses shader. The renderer only uses the handle and queue from here on
+                p_subpass->shader_names[i]   = intern_string(p_shader->name);
+                p_subpass->shader_handles[i] = p_shader->handle;
+                p_subpass->draw_queues[i]    = p_draw_queue;
             }
         }
     }
@@ -4172,6 +4192,9 @@ int construct_image ( GXImage_t *p_image, VkImageCreateFlags flags, VkImageType
     )
         goto failed_to_allocate_image_memory;
 
+    // Count the image memory
+    G10_STAT_ADD(stat_image_bytes, (i64) memory_requirements.size);
+
     // Bind the image to the image memory
     if (
         vkBindImageMemory(
@@ -5157,7 +5180,6 @@ int render_frame ( GXInstance_t *p_instance )
             // Initialized data
             GXRenderPass_t         *p_render_pass          = active_renderer->render_passes_data[i];
             size_t                  subpass_count          = p_render_pass->subpasses_count;
-            dict                   *draw_item_queues       = p_render_pass->draw_queue_types;
             VkRenderPassBeginInfo   render_pass_begin_info =
             {
                 .sType               = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO,
@@ -5196,8 +5218,27 @@ int render_frame ( GXInstance_t *p_instance )
                 {
                     
                     // Initialized data
-                    GXShader_t *p_shader = g_find_shader(p_instance, p_subpass->shader_names[k]);
-                    queue *draw_item_queue = dict_get(draw_item_queues, p_shader->name);
+                    GXShader_t *p_shader = g_get_shader(p_instance, p_subpass->shader_handles[k]);
+                    queue *draw_item_queue = p_subpass->draw_queues[k];
+
+                    // The shader was destroyed after the subpass was loaded
+                    if ( p_shader == (void *) 0 )
+                    {
+
+                        // Drop this frame's draws, so the queue doesn't grow every frame
+                        while ( queue_empty(draw_item_queue) == false )
+                        {
+
+                            // Initialized data
+                            void *p_dropped = 0;
+
+                            // Discard the draw item
+                            queue_dequeue(draw_item_queue, &p_dropped);
+                        }
+
+                        // Skip the shader
+                        continue;
+                    }
                     
                     while( queue_empty(draw_item_queue) == false )
                     {
@@ -5453,18 +5494,27 @@ void draw_part ( void *vp_part )
 
     // Initialized data
     GXInstance_t *p_instance = g_get_active_instance();
+    GXScene_t *p_scene = p_instance->context.scene;
     GXPart_t *p_part = vp_part;
     VkBuffer vertex_buffers[] = { p_part->vertex_buffer };
     VkDeviceSize offsets[] = { 0 };
+    size_t lod = 0;
+
+    // Push constants read the part being drawn
+    if ( p_scene ) p_scene->active_part = p_part;
+
+    // Choose a level of detail for the entity being drawn
+    if ( p_scene && p_scene->active_entity && p_scene->active_entity->transform && p_scene->active_camera )
+        lod = select_part_lod(p_part, p_scene->active_entity->transform, p_scene->active_camera, PART_LOD_PIXEL_ERROR);
 
     // Bind the vertex buffers for the draw call
     vkCmdBindVertexBuffers(p_instance->vulkan.command_buffers[p_instance->vulkan.current_frame], 0, 1, vertex_buffers, offsets);
 
     // Bind the face buffers for the draw call
-    vkCmdBindIndexBuffer(p_instance->vulkan.command_buffers[p_instance->vulkan.current_frame], p_part->element_buffer, 0, VK_INDEX_TYPE_UINT32);
+    vkCmdBindIndexBuffer(p_instance->vulkan.command_buffers[p_instance->vulkan.current_frame], p_part->element_buffer, 0, ( p_part->index_size == sizeof(u16) ) ? VK_INDEX_TYPE_UINT16 : VK_INDEX_TYPE_UINT32);
 
     // Draw the part
-    //vkCmdDrawIndexed(p_instance->vulkan.command_buffers[p_instance->vulkan.current_frame], (u32)p_part->index_count*3, 1, 0, 0, 0);
+    vkCmdDrawIndexed(p_instance->vulkan.command_buffers[p_instance->vulkan.current_frame], p_part->lods[lod].index_count, 1, p_part->lods[lod].first_index, 0, 0);
 
     // Success
     return;
@@ -5762,20 +5812,13 @@ int destroy_subpass ( GXSubpass_t **pp_subpass )
     // Free the subpass name
     free(p_subpass->name);
 
-    // Free the shader names
-    for (size_t i = 0; i > p_subpass->shader_count; i++)
-    {
-
-        // Initialized data
-        char *i_shader_name = p_subpass->shader_names[i];
-
-        // Free the shader name
-        free (i_shader_name);
-    }
-
-    // Free the list of shader names
+    // Free the list of shader names. The names are interned, and are not freed
     free(p_subpass->shader_names);
 
+    // Free the shader handles and draw queue pointers. The draw queues belong to the render pass
+    free(p_subpass->shader_handles);
+    free(p_subpass->draw_queues);
+
 
     // Free the subpass attachment references
     {
@@ -5846,6 +5889,18 @@ int destroy_image ( GXImage_t **pp_image )
     // Free the name
     free(p_image->name);
 
+    // Measure the image memory before the image is destroyed
+    if ( p_image->image_memory )
+    {
+
+        // Initialized data
+        VkMemoryRequirements memory_requirements = { 0 };
+
+        vkGetImageMemoryRequirements(p_instance->vulkan.device, p_image->image, &memory_requirements);
+
+        G10_STAT_ADD(stat_image_bytes, -(i64) memory_requirements.size);
+    }
+
     // Free the VkImage
     vkDestroyImage(p_instance->vulkan.device, p_image->image, 0);
 
@@ -5855,6 +5910,8 @@ int destroy_image ( GXImage_t **pp_image )
     // Free the image
     free(p_image);
 
+    G10_STAT_ADD(stat_images, -1);
+
     // Success
     return 1;
 
@@ -4,6 +4,9 @@
 
 dict *force_calculators = 0;
 
+// Rigidbodies made outside of a scene arena
+static GXPool_t *rigidbody_pool = 0;
+
 
 
 int create_rigidbody ( GXRigidbody_t** pp_rigidbody )
@@ -15,13 +18,16 @@ int create_rigidbody ( GXRigidbody_t** pp_rigidbody )
     #endif
 
     // Initialized data
-    GXRigidbody_t *p_rigidbody = calloc(1, sizeof(GXRigidbody_t));
+    GXRigidbody_t *p_rigidbody = pool_calloc(&rigidbody_pool, sizeof(GXRigidbody_t));
 
     // Error check
     #ifndef NDEBUG
         if ( p_rigidbody == (void *) 0 ) goto no_mem;
     #endif
 
+    // Count the rigidbody
+    G10_STAT_ADD(stat_rigidbodies, 1);
+
     // Write the return value
     *pp_rigidbody = p_rigidbody;
 
@@ -266,13 +272,15 @@ int destroy_rigidbody ( GXRigidbody_t **pp_rigidbody )
     *pp_rigidbody = 0;
 
     // Free the forces
-    free(p_rigidbody->forces);
+    arena_free(p_rigidbody->forces);
 
     // Free the torques
-    free(p_rigidbody->torques);
+    arena_free(p_rigidbody->torques);
 
     // Free the rigidbody
-    free(p_rigidbody);
+    pool_release(&rigidbody_pool, p_rigidbody);
+
+    G10_STAT_ADD(stat_rigidbodies, -1);
 
     // Success
     return 1;
@@ -1,3 +1,6 @@
+// Allocations made here are counted against the scene
+#define G10_ALLOC_TAG alloc_tag_scene
+
 #include <G10/GXScene.h>
 
 void init_scene ( void )
@@ -24,6 +27,26 @@ int create_scene ( GXScene_t **pp_scene )
     // Error check
     if ( p_scene == (void *) 0 ) goto no_mem;
 
+    // Allocate an arena for scene lifetime data
+    if ( create_arena(&p_scene->arena, 0) == 0 )
+    {
+        free(p_scene);
+
+        goto no_mem;
+    }
+
+    // Create a mutex for appending entities
+    p_scene->lock = SDL_CreateMutex();
+
+    // Error check
+    if ( p_scene->lock == (void *) 0 )
+    {
+        destroy_arena(&p_scene->arena);
+        free(p_scene);
+
+        goto no_mem;
+    }
+
     // Return the allocated memory
     *pp_scene = p_scene;
 
@@ -68,11 +91,14 @@ int load_scene ( GXScene_t **pp_scene, const char *path )
 
     // Initialized data
     size_t  len  = g_load_file(path, 0, true);
-    char   *text = calloc(len + 1, sizeof(char));
+    char   *text = G10_TAGGED_REALLOC(0, len + 1, alloc_tag_json);
 
     // Error check
     if ( text == (void *) 0 ) goto no_mem;
 
+    // Terminate the text
+    text[len] = '\0';
+
     // Load the file from the file system
     if ( g_load_file(path, text, true) == 0 ) goto failed_to_load_file;
 
@@ -80,7 +106,7 @@ int load_scene ( GXScene_t **pp_scene, const char *path )
     if ( load_scene_as_json_text(pp_scene, text) == 0 ) goto failed_to_load_scene;
 
     // Clean the scope
-    free(text);
+    G10_FREE(text);
 
     // Success
     return 1;
@@ -221,6 +247,7 @@ int load_scene_as_json_value ( GXScene_t **pp_scene, JSONValue_t *p_value )
     GXScene_t    *p_scene              = 0;
     JSONValue_t  *p_name_value         = 0,
                  *p_entities_value     = 0,
+                 *p_prefabs_value      = 0,
                  *p_cameras_value      = 0,
                  *p_lights_value       = 0,
                  *p_skyboxes_value     = 0,
@@ -238,6 +265,7 @@ int load_scene_as_json_value ( GXScene_t **pp_scene, JSONValue_t *p_value )
 
         // Optional properties
         p_entities_value     = dict_get(p_dict, "entities");
+        p_prefabs_value      = dict_get(p_dict, "prefabs");
         p_cameras_value      = dict_get(p_dict, "cameras");
         p_lights_value       = dict_get(p_dict, "lights");
         p_skyboxes_value     = dict_get(p_dict, "skyboxes");
@@ -277,7 +305,7 @@ int load_scene_as_json_value ( GXScene_t **pp_scene, JSONValue_t *p_value )
             size_t name_len = strlen(p_name_value->string);
 
             // Allocate memory
-            p_scene->name = calloc(name_len + 1, sizeof(char));
+            p_scene->name = arena_alloc(p_scene->arena, name_len + 1);
 
             // Error check
             if ( p_scene->name == (void *) 0 ) goto no_mem;
@@ -289,6 +317,75 @@ int load_scene_as_json_value ( GXScene_t **pp_scene, JSONValue_t *p_value )
         else
             goto name_type_error;
 
+        // Load prefabs before the entities that are stamped out of them
+        if ( p_prefabs_value )
+        {
+
+            // Parse the prefabs as an array
+            if ( p_prefabs_value->type == JSONarray )
+            {
+
+                // Initialized data
+                size_t        len        = 0;
+                JSONValue_t **pp_prefabs = 0;
+
+                // Get the array contents
+                {
+
+                    // Get the array length
+                    array_get(p_prefabs_value->list, 0, &len);
+
+                    // Allocate memory for prefabs
+                    pp_prefabs = calloc(len+1, sizeof(JSONValue_t *));
+
+                    // Error check
+                    if ( pp_prefabs == (void *) 0 ) goto no_mem;
+
+                    // Get list of prefabs
+                    array_get(p_prefabs_value->list, (void **)pp_prefabs, 0);
+                }
+
+                // Lock the prefab cache mutex
+                SDL_LockMutex(p_instance->mutexes.prefab_cache);
+
+                // Iterate over each prefab
+                for (size_t i = 0; i < len; i++)
+                {
+
+                    // Initialized data
+                    GXPrefab_t *p_prefab = 0;
+
+                    // Load the prefab
+                    if ( load_prefab_as_json_value(&p_prefab, pp_prefabs[i]) == 0 )
+                    {
+
+                        // Unlock the prefab cache mutex
+                        SDL_UnlockMutex(p_instance->mutexes.prefab_cache);
+
+                        // Clean the scope
+                        free(pp_prefabs);
+
+                        goto failed_to_load_prefab_as_json_value;
+                    }
+
+                    // Keep the prefab that is already cached
+                    if ( g_find_prefab(p_instance, p_prefab->name) )
+                        destroy_prefab(&p_prefab);
+                    else
+                        g_cache_prefab(p_instance, p_prefab);
+                }
+
+                // Unlock the prefab cache mutex
+                SDL_UnlockMutex(p_instance->mutexes.prefab_cache);
+
+                // Clean the scope
+                free(pp_prefabs);
+            }
+            // Default
+            else
+                goto prefabs_type_error;
+        }
+
         // Load entities
         if ( p_entities_value )
         {
@@ -335,6 +432,14 @@ int load_scene_as_json_value ( GXScene_t **pp_scene, JSONValue_t *p_value )
                 dict_construct(&p_scene->actors, len);
                 dict_construct(&p_scene->ais, len);
 
+                // Allocate the component storage before the loading threads append to it
+                if ( p_scene->components == (void *) 0 )
+                    if ( create_component_storage(&p_scene->components) == 0 ) goto no_mem;
+
+                // Allocate the transform hierarchy before the loading threads add to it
+                if ( p_scene->transforms == (void *) 0 )
+                    if ( create_transform_hierarchy(&p_scene->transforms) == 0 ) goto no_mem;
+
                 // Set the active instance's loading scene
                 p_instance->context.loading_scene = p_scene;
 
@@ -370,6 +475,12 @@ int load_scene_as_json_value ( GXScene_t **pp_scene, JSONValue_t *p_value )
                     // Wait for each thread to stop
                     SDL_WaitThread(entity_loading_threads[i]->thread, &r_stat);
                 }
+
+                // Wait for the parts the entities asked for
+                (void) wait_assets();
+
+                // Parts loaded after this are loaded in place
+                p_instance->context.loading_scene = 0;
             }
             // Default
             else
@@ -536,6 +647,14 @@ int load_scene_as_json_value ( GXScene_t **pp_scene, JSONValue_t *p_value )
                 // Error
                 return 0;
 
+            prefabs_type_error:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Scene] Property \"prefabs\" must be of type [ array ] in call to function \"%s\"\nRefer to gschema: https://schema.g10.app/scene.json \n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
             entities_type_error:
                 #ifndef NDEBUG
                     g_print_error("[G10] [Scene] Property \"entities\" must be of type [ array ] in call to function \"%s\"\nRefer to gschema: https://schema.g10.app/scene.json \n", __FUNCTION__);
@@ -572,6 +691,14 @@ int load_scene_as_json_value ( GXScene_t **pp_scene, JSONValue_t *p_value )
 
         // G10 errors
         {
+            failed_to_load_prefab_as_json_value:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Scene] Failed to load prefab from JSON value in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
             failed_to_load_camera_as_json_value:
                 #ifndef NDEBUG
                     g_print_error("[G10] [Scene] Failed to load camera from JSON value in call to function \"%s\"\n", __FUNCTION__);
@@ -629,7 +756,9 @@ int append_entity ( GXScene_t *p_scene, GXEntity_t *entity )
         if ( entity->name      == (void *) 0 ) goto no_name;
     #endif
 
-        
+    // Lock the scene. Loading threads append at once
+    SDL_LockMutex(p_scene->lock);
+
     // Add the entity to the scene
     (void) dict_add(p_scene->entities, entity->name, entity);
 
@@ -641,6 +770,33 @@ int append_entity ( GXScene_t *p_scene, GXEntity_t *entity )
     if ( entity->ai )
         (void) dict_add(p_scene->ais, entity->name, entity);
 
+    // Store the entity's components with others of its archetype
+    if ( entity->chunk == (void *) 0 )
+    {
+
+        // Allocate the storage
+        if ( p_scene->components == (void *) 0 )
+            (void) create_component_storage(&p_scene->components);
+
+        if ( p_scene->components )
+            (void) add_entity_components(p_scene->components, entity);
+    }
+
+    // If the entity has a transform, add it to the transform hierarchy
+    if ( entity->transform && entity->transform->p_hierarchy == (void *) 0 )
+    {
+
+        // Allocate the hierarchy
+        if ( p_scene->transforms == (void *) 0 )
+            (void) create_transform_hierarchy(&p_scene->transforms);
+
+        if ( p_scene->transforms )
+            (void) add_transform(p_scene->transforms, entity->transform);
+    }
+
+    // Unlock the scene
+    SDL_UnlockMutex(p_scene->lock);
+
     // TODO: Additional state updates
     //
 
@@ -953,6 +1109,32 @@ GXEntity_t *get_entity ( GXScene_t *p_scene, char *name )
     }
 }
 
+GXEntity_t *get_entity_by_handle ( GXScene_t *p_scene, handle_t handle )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( p_scene == (void *) 0 ) goto no_scene;
+    #endif
+
+    // No entities stored yet
+    if ( p_scene->components == (void *) 0 ) return 0;
+
+    // Success OR null pointer if the handle is stale
+    return resolve_entity(p_scene->components, handle);
+
+    // Error handling
+    {
+        no_scene:
+            #ifndef NDEBUG
+                g_print_error("[G10] [Scene] Null pointer provided for parameter \"p_scene\" in call to function \"%s\"\n", __FUNCTION__);
+            #endif
+
+            // Error
+            return 0;
+    }
+}
+
 GXCamera_t *get_camera ( GXScene_t *p_scene, char *name )
 {
 
@@ -1097,15 +1279,28 @@ int destroy_scene ( GXScene_t **pp_scene )
     *pp_scene = 0;
 
     // Free the scene name
-    free(p_scene->name);
+    arena_free(p_scene->name);
 
     // Free the scene entities
     if ( p_scene->entities )
     {
 
-        // TODO: Fix
-        // Free the dictionary and free every value
-        //dict_free_clear(p_scene->entities, destroy_entity);
+        // Initialized data
+        size_t       entity_count = dict_values(p_scene->entities, 0);
+        GXEntity_t **entities     = calloc(entity_count + 1, sizeof(void *));
+
+        // Error checking
+        if ( entities == (void *) 0 ) goto no_mem;
+
+        dict_values(p_scene->entities, (void **)entities);
+
+        // Destroy each entity that was appended after loading. The arena frees the rest
+        for (size_t i = 0; i < entity_count; i++)
+            if ( arena_owned(entities[i]) == false )
+                destroy_entity(&entities[i]);
+
+        // Free the list
+        free(entities);
 
         // Destroy the entity dictionary
         dict_destroy(&p_scene->entities);
@@ -1125,6 +1320,18 @@ int destroy_scene ( GXScene_t **pp_scene )
 
     }
 
+    // Free the compiled bounding volume hierarchy
+    if ( p_scene->qbvh )
+        destroy_qbvh(&p_scene->qbvh);
+
+    // Free the transform hierarchy
+    if ( p_scene->transforms )
+        destroy_transform_hierarchy(&p_scene->transforms);
+
+    // Free the component storage
+    if ( p_scene->components )
+        destroy_component_storage(&p_scene->components);
+
     // TODO: Uncomment
     // Free the lights
     /*
@@ -1153,6 +1360,12 @@ int destroy_scene ( GXScene_t **pp_scene )
     }
     */
 
+    // Free every entity, component, and name loaded with the scene
+    destroy_arena(&p_scene->arena);
+
+    // Free the mutex
+    SDL_DestroyMutex(p_scene->lock);
+
     // Free the scene
     free(p_scene);
 
@@ -1181,5 +1394,16 @@ int destroy_scene ( GXScene_t **pp_scene )
                 return 0;
 
         }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    g_print_error("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
     }
 }
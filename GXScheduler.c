@@ -1,6 +1,6 @@
 #include <G10/GXScheduler.h>
 
-#define TASK_COUNT 23
+#define TASK_COUNT 24
 
 #ifdef BUILD_G10_WITH_DISCORD
 #include <G10/GXDiscordIntegration.h>
@@ -20,6 +20,7 @@ char *task_names[TASK_COUNT] = {
     "Pre AI",
     "User Code",
     "Resolve Collisions",
+    "Solve Collisions",
     "Update Forces",
     "Move Objects",
     "Animation",
@@ -50,6 +51,7 @@ void *task_function_pointers[TASK_COUNT] = {
     &pre_update_ai,
     &user_code,
     &detect_collisions,
+    &solve_collisions,
     &update_forces,
     &move_objects,
     0,//&update_rigs,
@@ -788,8 +790,14 @@ int work ( void *vp_thread )
         // Reset
         for (size_t i = 0; i < p_thread->task_count; i++)
             p_thread->complete_tasks[i] = 0;
+
+        // Free this frame's scratch memory
+        scratch_reset();
     }
 
+    // Free this thread's scratch memory
+    scratch_release();
+
     // Success
     return 1;
 
@@ -867,6 +875,14 @@ int main_work ( GXThread_t *p_thread )
         for (size_t i = 0; i < p_thread->task_count; i++)
             p_thread->complete_tasks[i] = 0;
 
+        // Free this frame's scratch memory
+        scratch_reset();
+
+        // Measure this frame's allocations
+        #ifdef BUILD_G10_WITH_ALLOC_TRACKING
+            alloc_end_frame();
+        #endif
+
     }
 
     // Success
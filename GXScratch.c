@@ -0,0 +1,224 @@
+#include <G10/GXScratch.h>
+
+// The calling thread's scratch memory
+static G10_THREAD_LOCAL struct
+{
+
+    // The buffer, and bytes of it in use
+    u8     *data;
+    size_t  size,
+            used;
+
+    // Allocations that didn't fit in the buffer, and their total size since the last reset
+    void  **spills;
+    size_t  spill_count,
+            spill_max,
+            spill_size;
+} scratch = { 0 };
+
+// Allocate on the heap, and remember the allocation for the next rewind
+static void *spill ( size_t size )
+{
+
+    // Initialized data
+    void *p = 0;
+
+    // Grow the list of spills
+    if ( scratch.spill_count == scratch.spill_max )
+    {
+
+        // Initialized data
+        size_t   new_max    = ( scratch.spill_max ) ? scratch.spill_max * 2 : 4;
+        void   **new_spills = G10_REALLOC(scratch.spills, new_max * sizeof(void *));
+
+        // Error check
+        if ( new_spills == (void *) 0 ) return 0;
+
+        scratch.spills    = new_spills;
+        scratch.spill_max = new_max;
+    }
+
+    p = malloc(size);
+
+    // Error check
+    if ( p == (void *) 0 ) return 0;
+
+    scratch.spills[scratch.spill_count++] = p;
+    scratch.spill_size                   += size;
+
+    // Success
+    return p;
+}
+
+void *scratch_alloc ( size_t size )
+{
+
+    // Initialized data
+    void *p = 0;
+
+    // Round the size up to the alignment
+    size = ( size + SCRATCH_ALIGNMENT - 1 ) & ~(size_t)( SCRATCH_ALIGNMENT - 1 );
+
+    // Allocate the buffer on first use
+    if ( scratch.data == (void *) 0 )
+    {
+        scratch.data = calloc(SCRATCH_SIZE, sizeof(u8));
+
+        // Error check
+        if ( scratch.data == (void *) 0 ) goto no_mem;
+
+        scratch.size = SCRATCH_SIZE;
+
+        G10_STAT_ADD(stat_scratch_bytes, SCRATCH_SIZE);
+    }
+
+    // Slow path. Spill onto the heap
+    if ( scratch.size - scratch.used < size )
+    {
+        p = spill(size);
+
+        // Error check
+        if ( p == (void *) 0 ) goto no_mem;
+
+        // Success
+        return p;
+    }
+
+    // Fast path. Bump
+    p = &scratch.data[scratch.used];
+
+    scratch.used += size;
+
+    // Success
+    return p;
+
+    // Error handling
+    {
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    g_print_error("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+void *scratch_calloc ( size_t count, size_t size )
+{
+
+    // Initialized data
+    void *p = 0;
+
+    // Overflow
+    if ( size && count > SIZE_MAX / size )
+        return 0;
+
+    p = scratch_alloc(count * size);
+
+    // Zero the allocation
+    if ( p )
+        memset(p, 0, count * size);
+
+    // Success
+    return p;
+}
+
+GXScratchMark_t scratch_mark ( void )
+{
+
+    // Success
+    return (GXScratchMark_t) { .used = scratch.used, .spill_count = scratch.spill_count };
+}
+
+void scratch_rewind ( GXScratchMark_t mark )
+{
+
+    // Free each spill since the mark
+    while ( scratch.spill_count > mark.spill_count )
+        free(scratch.spills[--scratch.spill_count]);
+
+    // Rewind the buffer
+    if ( mark.used < scratch.used )
+        scratch.used = mark.used;
+}
+
+int scratch_reset ( void )
+{
+
+    // Initialized data
+    size_t new_size = scratch.size;
+
+    // Free every allocation
+    scratch_rewind((GXScratchMark_t) { 0 });
+
+    // Nothing spilled
+    if ( scratch.spill_size == 0 ) return 1;
+
+    // Grow the buffer to fit the spills
+    while ( new_size < scratch.size + scratch.spill_size )
+        new_size *= 2;
+
+    scratch.spill_size = 0;
+
+    // Replace the buffer. It holds no allocations, so there is nothing to copy
+    {
+
+        // Initialized data
+        u8 *new_data = calloc(new_size, sizeof(u8));
+
+        // Error check. Keep the old buffer
+        if ( new_data == (void *) 0 ) goto no_mem;
+
+        free(scratch.data);
+
+        G10_STAT_ADD(stat_scratch_bytes, (i64) new_size - (i64) scratch.size);
+
+        scratch.data = new_data;
+        scratch.size = new_size;
+    }
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    g_print_error("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int scratch_release ( void )
+{
+
+    // Free every allocation
+    scratch_rewind((GXScratchMark_t) { 0 });
+
+    // Free the buffer and the list of spills
+    free(scratch.data);
+    G10_STAT_ADD(stat_scratch_bytes, -(i64) scratch.size);
+    G10_FREE(scratch.spills);
+
+    scratch.data        = 0;
+    scratch.size        = 0;
+    scratch.used        = 0;
+    scratch.spills      = 0;
+    scratch.spill_max   = 0;
+    scratch.spill_size  = 0;
+
+    // Success
+    return 1;
+}
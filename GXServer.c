@@ -1,5 +1,11 @@
+// Allocations made here are counted against the network
+#define G10_ALLOC_TAG alloc_tag_network
+
 #include <G10/GXServer.h>
 
+// Commands are made and freed every network tick
+static GXPool_t *command_pool = 0;
+
 int create_server ( GXServer_t **pp_server )
 {
 
@@ -321,8 +327,8 @@ int process_command ( GXClient_t *client, GXCommand_t *p_command )
 					#endif
 				}
 
-				// Add the actor to the client actor list
-				client->actors[i] = actor;
+				// Add the actor to the client actor list. Later commands refer to the actor by its index
+				client->actors[i] = actor->handle;
 
 				// Set the actors location, rotation, and scale
 				{
@@ -340,16 +346,11 @@ int process_command ( GXClient_t *client, GXCommand_t *p_command )
 				quaternion  r     = p_command->actor_displace_rotate.quaternion;
 				vec3        v     = p_command->actor_displace_rotate.velocity;
 
-				GXEntity_t *actor = client->actors[i];
-
-				// Error checking
-				{
-					#ifndef NDEBUG
-						if (actor == (void*)0)
-							;// TODO: Error handling
-					#endif
-				}
+				GXEntity_t *actor = get_entity_by_handle(p_instance->context.scene, client->actors[i]);
 
+				// The actor was detached, or destroyed
+				if ( actor == (void *) 0 )
+					break;
 
 				// Set the actors location, rotation, and scale
 				{
@@ -365,7 +366,7 @@ int process_command ( GXClient_t *client, GXCommand_t *p_command )
 			{
 				u16 i = p_command->actor_detach.index;
 
-				client->actors[i] = 0x0;
+				client->actors[i] = HANDLE_INVALID;
 			}
 
 			case chat:
@@ -511,6 +512,9 @@ int server_serialize ( GXClient_t *client )
 		queue_dequeue(client->send_queue, &command);
 		u8* z = client->send_data + i;
 		i += data_from_command(&z, command);
+
+		// Outgoing commands borrow their strings
+		G10_POOL_FREE(&command_pool, command);
 	}
 
 	client->send_len = i;
@@ -538,8 +542,14 @@ int server_process ( GXClient_t *client )
 	if ( p_instance->networking.server )
 		for (size_t i = 0; i < client->actor_count; i++)
 		{
-			GXCommand_t *adr   = calloc(1, sizeof(GXCommand_t));
-			GXEntity_t  *actor = client->actors[i];
+			GXEntity_t  *actor = get_entity_by_handle(p_instance->context.scene, client->actors[i]);
+			GXCommand_t *adr   = 0;
+
+			// The actor was detached, or destroyed
+			if ( actor == (void *) 0 )
+				continue;
+
+			adr = G10_POOL_ALLOC(&command_pool, sizeof(GXCommand_t));
 
 			{
 				adr->type                             = actor_displace_rotate;
@@ -555,7 +565,7 @@ int server_process ( GXClient_t *client )
 
 	if (queue_empty(client->send_queue))
 	{
-		GXCommand_t* adr = calloc(1, sizeof(GXCommand_t));
+		GXCommand_t* adr = G10_POOL_ALLOC(&command_pool, sizeof(GXCommand_t));
 
 		queue_enqueue(p_instance->networking.client->send_queue, adr);
 	}
@@ -649,7 +659,7 @@ int server_wait ( GXInstance_t *p_instance )
 		size_t       active_scene_actors_count = dict_values(p_instance->context.scene->actors, 0);
 		GXEntity_t **actor_list                = calloc(active_scene_actors_count+1, sizeof(void *));
 
-		client->actors = actor_list;
+		client->actors = calloc(active_scene_actors_count+1, sizeof(handle_t));
 
 		// Get a list of actors from the active scene
 		dict_values(p_instance->context.scene->actors, (void **)actor_list);
@@ -662,7 +672,7 @@ int server_wait ( GXInstance_t *p_instance )
 			GXEntity_t *entity = actor_list[i];
 
 			// Allocate a command
-			GXCommand_t *actor_init_command = calloc(1, sizeof(GXCommand_t));
+			GXCommand_t *actor_init_command = G10_POOL_ALLOC(&command_pool, sizeof(GXCommand_t));
 
 			// Construct the actor initialize packets
 			{
@@ -673,7 +683,7 @@ int server_wait ( GXInstance_t *p_instance )
 				actor_init_command->actor_initialize.scale      = entity->transform->scale;
 				actor_init_command->actor_initialize.index      = (u16) i;
 
-				client->actors[i] = entity;
+				client->actors[i] = entity->handle;
 
 				// Increment the actor count
 				client->actor_count++;
@@ -691,6 +701,9 @@ int server_wait ( GXInstance_t *p_instance )
 			queue_enqueue(client->send_queue, actor_init_command);
 		}
 
+		// The client keeps handles, not the actor list
+		free(actor_list);
+
 		// Serialize each command into a data block
 		server_serialize(client);
 
@@ -752,7 +765,7 @@ int connect_client ( char *name)
 	IPaddress     addr                = { 0 };
 	size_t        name_len            = strlen(name),
 		          connect_command_len = 0;
-	GXCommand_t  *connect_command     = calloc(1, sizeof(GXCommand_t));
+	GXCommand_t  *connect_command     = G10_POOL_ALLOC(&command_pool, sizeof(GXCommand_t));
 
 	// Allocate a client
 	create_client(&p_instance->networking.client);
@@ -790,9 +803,7 @@ int connect_client ( char *name)
 		}
 	}
 
-	GXEntity_t** actor_list = calloc(16 + 1, sizeof(void*));
-
-	i_client->actors = actor_list;
+	i_client->actors = calloc(16 + 1, sizeof(handle_t));
 
 	// Create a connection command
 	{
@@ -811,7 +822,7 @@ int connect_client ( char *name)
 	// Send the connect command to the server
 	SDLNet_TCP_Send(i_client->socket, i_client->send_data, (int) connect_command_len);
 
-	free(connect_command);
+	G10_POOL_FREE(&command_pool, connect_command);
 
 	// Set up the networking thread
 	{
@@ -877,7 +888,7 @@ int command_from_data ( GXCommand_t **ret, void *data )
 	// TODO: Argument check
 
 	// Initialized data
-	GXCommand_t  *i_ret        = calloc(1, sizeof(GXCommand_t));
+	GXCommand_t  *i_ret        = G10_POOL_ALLOC(&command_pool, sizeof(GXCommand_t));
 	GXInstance_t *p_instance   = g_get_active_instance();
 
 	u16           command_type = * ( (u16 *) data );
@@ -937,13 +948,13 @@ int command_from_data ( GXCommand_t **ret, void *data )
 				i_ret->actor_initialize.index      = * ( (u16 *) data + 1);
 
 				// Set actor location
-				i_ret->actor_initialize.location   = * ( (vec3 *)       ( (u8 *) data ) + ( 0x4 ) );
+				memcpy(&i_ret->actor_initialize.location, (u8 *) data + ( 0x4 ), sizeof(vec3));
 
 				// Set actor rotation
-				i_ret->actor_initialize.quaternion = * ( (quaternion *) ( (u8 *) data ) + ( 0x4 + sizeof(vec3) ) );
+				memcpy(&i_ret->actor_initialize.quaternion, (u8 *) data + ( 0x4 + sizeof(vec3) ), sizeof(quaternion));
 
 				// Set actor scale
-				i_ret->actor_initialize.scale      = * ( (vec3 *)       ( (u8 *) data ) + ( 0x4 + sizeof(vec3) + sizeof(quaternion) ) );
+				memcpy(&i_ret->actor_initialize.scale, (u8 *) data + ( 0x4 + sizeof(vec3) + sizeof(quaternion) ), sizeof(vec3));
 
 				// Find the entity in the scene
 				actor = get_entity(p_instance->context.scene, i_ret->actor_initialize.name);
@@ -968,13 +979,13 @@ int command_from_data ( GXCommand_t **ret, void *data )
 				i_ret->actor_displace_rotate.index         = * ( (u16 *)        ( (u8 *) data+1 ) );
 
 				// Set actor location
-				i_ret->actor_displace_rotate.location      = * ( (vec3 *)       ( (u8 *) data + ( 0x4 ) ) );
+				memcpy(&i_ret->actor_displace_rotate.location, (u8 *) data + ( 0x4 ), sizeof(vec3));
 
 				// Set actor rotation
-				i_ret->actor_displace_rotate.quaternion    = * ( (quaternion *) ( (u8 *) data + ( 0x4 + sizeof(vec3) ) ) );
+				memcpy(&i_ret->actor_displace_rotate.quaternion, (u8 *) data + ( 0x4 + sizeof(vec3) ), sizeof(quaternion));
 
 				// Set actor scale
-				i_ret->actor_displace_rotate.velocity      = * ( (vec3 *)       ( (u8 *) data + ( 0x4 + sizeof(vec3) + sizeof(quaternion) ) ) );
+				memcpy(&i_ret->actor_displace_rotate.velocity, (u8 *) data + ( 0x4 + sizeof(vec3) + sizeof(quaternion) ), sizeof(vec3));
 
 				// Return the size of the packet in bytes
 				ret_len = ( sizeof(u16) + 2 * sizeof(vec3) + sizeof(quaternion) );
@@ -1035,9 +1046,9 @@ int data_from_command ( void **ret, GXCommand_t *command )
 
 			*(u16*)retn                                                           = actor_initialize;
 			*((u16*)retn+1)                                                       = command->actor_initialize.index;
-			*((vec3*)       ((u8*)retn + 4))                                      = command->actor_initialize.location;
-			*((quaternion*) ((u8*)retn + 4 + sizeof(vec3)                      )) = command->actor_initialize.quaternion;
-			*((vec3*)       ((u8*)retn + 4 + sizeof(vec3) + sizeof(quaternion) )) = command->actor_initialize.scale;
+			memcpy((u8*)retn + 4, &command->actor_initialize.location, sizeof(vec3));
+			memcpy((u8*)retn + 4 + sizeof(vec3), &command->actor_initialize.quaternion, sizeof(quaternion));
+			memcpy((u8*)retn + 4 + sizeof(vec3) + sizeof(quaternion), &command->actor_initialize.scale, sizeof(vec3));
 
 
 			strncpy( (u8*) ((u8*)retn + 4 + ( 2 * sizeof(vec3) ) + sizeof(quaternion) ), command->actor_initialize.name, chat_len);
@@ -1051,9 +1062,9 @@ int data_from_command ( void **ret, GXCommand_t *command )
 
 			*(u16*)retn                                                   = actor_displace_rotate;
 			*((u16*)retn + 1)                                             = command->actor_displace_rotate.index;
-			*((vec3*)((u8*)retn + 4))                                     = command->actor_displace_rotate.location;
-			*((quaternion*)((u8*)retn + 4 + sizeof(vec3)))                = command->actor_displace_rotate.quaternion;
-			*((vec3*)((u8*)retn + 4 + sizeof(vec3) + sizeof(quaternion))) = command->actor_displace_rotate.velocity;
+			memcpy((u8*)retn + 4, &command->actor_displace_rotate.location, sizeof(vec3));
+			memcpy((u8*)retn + 4 + sizeof(vec3), &command->actor_displace_rotate.quaternion, sizeof(quaternion));
+			memcpy((u8*)retn + 4 + sizeof(vec3) + sizeof(quaternion), &command->actor_displace_rotate.velocity, sizeof(vec3));
 
 		}
 		break;
@@ -1099,48 +1110,61 @@ int destroy_client ( GXClient_t **pp_client )
 
 int destroy_command ( GXCommand_t **pp_command )
 {
-	//// Argument check
-	//{
-	//	#ifndef NDEBUG
-	//		if ( pp_command == (void *) 0 )
-	//			goto no_command;
-	//	#endif
-	//}
-	//
-	//// Deallocate command data
-	//switch (command->type)
-	//{
-	//	case no_op:
-	//	case actor_displace_rotate:
-	//	case actor_detach:
-	//	case disconnect:
-	//	break;
-	//
-	//	case connect_CMD:
-	//	{
-	//		free(command->connect.name);
-	//	}
-	//	break;
-	//
-	//	case actor_initialize:
-	//	{
-	//		free(command->actor_initialize.name);
-	//	}
-	//	break;
-	//
-	//	case chat:
-	//	{
-	//		free(command->chat.chat);
-	//	}
-	//	break;
-	//
-	//	default:
-	//	break;
-	//}
-	//
-	//// Deallocate the command
-	//free(command);
-	//
-	//no_command:
-	return 0;
+
+	// Argument check
+	{
+		#ifndef NDEBUG
+			if ( pp_command == (void *) 0 )
+				goto no_command;
+		#endif
+	}
+
+	// Initialized data
+	GXCommand_t *p_command = *pp_command;
+
+	// No more pointer for caller
+	*pp_command = 0;
+
+	// Nothing to free
+	if ( p_command == (void *) 0 )
+		return 1;
+
+	// Deallocate command data. Commands from command_from_data own their strings
+	switch (p_command->type)
+	{
+		case connect_CMD:
+			free(p_command->connect.name);
+			break;
+
+		case actor_initialize:
+			free(p_command->actor_initialize.name);
+			break;
+
+		case chat:
+			free(p_command->chat.chat);
+			break;
+
+		default:
+			break;
+	}
+
+	// Deallocate the command
+	G10_POOL_FREE(&command_pool, p_command);
+
+	return 1;
+
+	// Error handling
+	{
+
+		// Argument errors
+		{
+			no_command:
+				#ifndef NDEBUG
+					g_print_error("[G10] [Server] Null pointer provided for parameter \"pp_command\" in call to function \"%s\"\n", __FUNCTION__);
+				#endif
+
+				// Error
+				return 0;
+		}
+	}
 }
@@ -2,7 +2,7 @@
 
 #define FORMATS_COUNT                 17
 #define DESCRIPTOR_TYPE_COUNT         11
-#define PUSH_CONSTANT_GETTERS_COUNT   2
+#define PUSH_CONSTANT_GETTERS_COUNT   3
 #define RASTERIZER_POLYGON_MODE_COUNT 3
 #define BLEND_OPERATIONS_COUNT        5
 #define BLEND_FACTORS_COUNT           19
@@ -128,12 +128,14 @@ VkDescriptorType  descriptor_type_enums [DESCRIPTOR_TYPE_COUNT] =
 char *push_constant_getter_names [PUSH_CONSTANT_GETTERS_COUNT] =
 {
     "camera position",
-    "model matrix"
+    "model matrix",
+    "dequantized model matrix"
 };
 void *push_constant_getter_functions [PUSH_CONSTANT_GETTERS_COUNT] =
 {
     &get_camera_position,
-    &get_model_matrix
+    &get_model_matrix,
+    &get_dequantized_model_matrix
 };
 
 char *rasterizer_polygon_mode_names [RASTERIZER_POLYGON_MODE_COUNT] =
@@ -549,6 +551,9 @@ int create_shader ( GXShader_t **pp_shader )
     // Check memory
     if ( p_shader == (void *) 0 ) goto no_mem;
 
+    // Count the shader
+    G10_STAT_ADD(stat_shaders, 1);
+
     // Return a pointer to the caller
     *pp_shader = p_shader;
 
@@ -1217,8 +1222,8 @@ int set_shader_camera               ( GXEntity_t   *p_entity )
     mat4 uniform_buffer[4];
 
     {
-        // Update the transform
-        transform_model_matrix(transform, &uniform_buffer[0]);
+        // The world matrix, updated once a frame by the scene's transform hierarchy
+        uniform_buffer[0] = transform->model_matrix;
 
         vec3 a;
         add_vec3(&a, camera->target, camera->location);
@@ -1276,6 +1281,8 @@ int destroy_shader ( GXShader_t **pp_shader )
     // Error check
     if ( p_shader == (void *) 0 ) goto pointer_to_null_pointer;
 
+    G10_STAT_ADD(stat_shaders, -1);
+
     // Destroy the pipeline
     vkDestroyPipeline(p_instance->vulkan.device, p_shader->graphics.pipeline, 0);
 
@@ -1290,6 +1297,10 @@ int destroy_shader ( GXShader_t **pp_shader )
     vkDestroyShaderModule(p_instance->vulkan.device, p_shader->graphics.vertex_shader_module, 0);
     vkDestroyShaderModule(p_instance->vulkan.device, p_shader->graphics.fragment_shader_module, 0);
 
+    // Stale every handle to the shader
+    if ( p_shader->handle )
+        (void) release_handle(p_instance->cache.shader_handles, p_shader->handle);
+
     free(p_shader->name);
     free(p_shader);
 
@@ -1320,6 +1331,25 @@ int destroy_shader ( GXShader_t **pp_shader )
     }
 }
 
+// Move a shader module made by the asset pipeline into the shader that asked for it
+static void adopt_shader_module ( GXAsset_t *p_asset, void *vp_module )
+{
+
+    // Initialized data
+    VkShaderModule *p_module = vp_module;
+
+    // The file failed to load
+    if ( p_asset->state != asset_state_done ) return;
+
+    // Another shader took the module. This one loads a module of its own
+    if ( p_asset->shader_module == 0 ) return;
+
+    *p_module = p_asset->shader_module;
+
+    // The shader owns the module now
+    p_asset->shader_module = 0;
+}
+
 int load_graphics_shader_as_json_value ( GXShader_t **pp_shader, JSONValue_t *p_value )
 {
     // Argument notes
@@ -1412,11 +1442,49 @@ int load_graphics_shader_as_json_value ( GXShader_t **pp_shader, JSONValue_t *p_
             if ( load_layout_as_json_value(&p_shader->layout, p_layout) == 0 ) goto failed_to_load_layout_as_json_value;
         }
 
+        // Read and create every shader module at once on the asset pipeline. Modules it doesn't create are loaded below
+        {
+
+            // Initialized data
+            JSONValue_t    *paths[7]   =
+            {
+                p_vertex_shader_path,
+                p_tessellation_control_shader_path,
+                p_tessellation_evaluation_shader_path,
+                p_geometry_shader_path,
+                p_task_shader_path,
+                p_mesh_shader_path,
+                p_fragment_shader_path
+            };
+            VkShaderModule *modules[7] =
+            {
+                &p_shader->graphics.vertex_shader_module,
+                &p_shader->graphics.tessellation_control_shader_module,
+                &p_shader->graphics.tessellation_evaluation_shader_module,
+                &p_shader->graphics.geometry_shader_module,
+                &p_shader->graphics.task_shader_module,
+                &p_shader->graphics.mesh_shader_module,
+                &p_shader->graphics.fragment_shader_module
+            };
+            GXAsset_t      *assets[7]  = { 0 };
+
+            // Request each module
+            for (size_t i = 0; i < 7; i++)
+                if ( paths[i] && paths[i]->type == JSONstring )
+                    (void) request_asset(&assets[i], asset_type_shader_module, paths[i]->string, 0, adopt_shader_module, modules[i]);
+
+            // Wait for each module
+            for (size_t i = 0; i < 7; i++)
+                if ( assets[i] )
+                    (void) wait_asset(assets[i]),
+                    (void) release_asset(&assets[i]);
+        }
+
         // Load the shader binaries
         {
 
             // Load the vertex shader binary
-            if ( p_vertex_shader_path )
+            if ( p_vertex_shader_path && p_shader->graphics.vertex_shader_module == 0 )
             {
 
                 // Parse the vertex shader path as a string
@@ -1443,7 +1511,7 @@ int load_graphics_shader_as_json_value ( GXShader_t **pp_shader, JSONValue_t *p_
             }
 
             // Load tessellation control shader
-            if ( p_tessellation_control_shader_path )
+            if ( p_tessellation_control_shader_path && p_shader->graphics.tessellation_control_shader_module == 0 )
             {
 
                 // Parse the tessellation control shader path as a string
@@ -1470,7 +1538,7 @@ int load_graphics_shader_as_json_value ( GXShader_t **pp_shader, JSONValue_t *p_
             }
 
             // Load tessellation evaluation shader
-            if ( p_tessellation_evaluation_shader_path )
+            if ( p_tessellation_evaluation_shader_path && p_shader->graphics.tessellation_evaluation_shader_module == 0 )
             {
 
                 // Parse the tessellation evaluation shader path as a string
@@ -1487,7 +1555,7 @@ int load_graphics_shader_as_json_value ( GXShader_t **pp_shader, JSONValue_t *p_
                     if ( g_load_file(p_tessellation_evaluation_shader_path->string, tessellation_evaluation_shader_data, true) == 0 ) goto failed_to_load_tessellation_evaluation_shader_binary;
 
                     // Create a shader module
-                    if ( create_shader_module(tessellation_evaluation_shader_data, tessellation_evaluation_shader_data_len, &p_shader->graphics.tessellation_control_shader_module) == 0 ) goto failed_to_create_tessellation_evaluation_shader_module;
+                    if ( create_shader_module(tessellation_evaluation_shader_data, tessellation_evaluation_shader_data_len, &p_shader->graphics.tessellation_evaluation_shader_module) == 0 ) goto failed_to_create_tessellation_evaluation_shader_module;
 
                     // Clean the scope
                     free(tessellation_evaluation_shader_data);
@@ -1497,7 +1565,7 @@ int load_graphics_shader_as_json_value ( GXShader_t **pp_shader, JSONValue_t *p_
             }
 
             // Load the geometry shader binary
-            if ( p_geometry_shader_path )
+            if ( p_geometry_shader_path && p_shader->graphics.geometry_shader_module == 0 )
             {
 
                 // Parse the geometry shader path as a string
@@ -1524,7 +1592,7 @@ int load_graphics_shader_as_json_value ( GXShader_t **pp_shader, JSONValue_t *p_
             }
 
             // Load the task shader binary
-            if ( p_task_shader_path )
+            if ( p_task_shader_path && p_shader->graphics.task_shader_module == 0 )
             {
 
                 // Parse the task shader path as a string
@@ -1551,7 +1619,7 @@ int load_graphics_shader_as_json_value ( GXShader_t **pp_shader, JSONValue_t *p_
             }
 
             // Load the mesh shader binary
-            if ( p_mesh_shader_path )
+            if ( p_mesh_shader_path && p_shader->graphics.mesh_shader_module == 0 )
             {
 
                 // Parse the mesh shader path as a string
@@ -1578,7 +1646,7 @@ int load_graphics_shader_as_json_value ( GXShader_t **pp_shader, JSONValue_t *p_
             }
 
             // Load the fragment shader binary
-            if ( p_fragment_shader_path )
+            if ( p_fragment_shader_path && p_shader->graphics.fragment_shader_module == 0 )
             {
 
                 // Parse the fragment shader path as a string
@@ -1740,7 +1808,8 @@ int load_graphics_shader_as_json_value ( GXShader_t **pp_shader, JSONValue_t *p_
                 size_t       vertex_group_count        = 0,
                              stride                    = 0,
                              binding_description_count = 0;
-                JSONValue_t *p_vertex_attributes       = 0;
+                JSONValue_t *p_vertex_attributes       = 0,
+                            *p_vertex_groups           = 0;
 
                 // Parse the JSON object
                 {
@@ -1750,18 +1819,74 @@ int load_graphics_shader_as_json_value ( GXShader_t **pp_shader, JSONValue_t *p_
 
                     // Required properties
                     p_vertex_attributes = dict_get(p_dict, "vertex attributes");
+                    p_vertex_groups     = dict_get(p_dict, "vertex groups");
                     p_topology          = dict_get(p_dict, "topology");
 
                     // Error check
                     if ( ! (
-                        p_vertex_attributes &&
+                        ( p_vertex_attributes || p_vertex_groups ) &&
                         p_topology
                     ) )
                         goto missing_properties;
                 }
 
+                // Did the user specify quantized vertex groups?
+                if ( p_vertex_groups )
+                {
+
+                    // Initialized data
+                    JSONValue_t **pp_names   = 0;
+                    size_t        name_count = 0;
+                    u32           groups     = 0;
+
+                    // Check for the right type
+                    if ( p_vertex_groups->type != JSONarray ) goto vertex_group_wrong_type;
+
+                    // Get the array size
+                    array_get(p_vertex_groups->list, 0, &name_count);
+
+                    // Allocate for vertex group JSON values
+                    pp_names = calloc(name_count + 1, sizeof(JSONValue_t *));
+
+                    // Error check
+                    if ( pp_names == (void *) 0 ) goto no_mem;
+
+                    // Get the array contents
+                    array_get(p_vertex_groups->list, (void **)pp_names, 0);
+
+                    // Accumulate the vertex groups
+                    for (size_t i = 0; i < name_count; i++)
+                    {
+
+                        // Initialized data
+                        u32 group = ( pp_names[i]->type == JSONstring ) ? get_vertex_group(pp_names[i]->string) : 0;
+
+                        // Error check
+                        if ( group == 0 )
+                        {
+                            free(pp_names);
+
+                            goto unknown_vertex_group;
+                        }
+
+                        groups |= group;
+                    }
+
+                    // Free the array contents
+                    free(pp_names);
+
+                    // Allocate vertex attributes
+                    vertex_input_attribute_descriptions = calloc(VERTEX_GROUP_COUNT, sizeof(VkVertexInputAttributeDescription));
+
+                    // Error check
+                    if ( vertex_input_attribute_descriptions == (void *) 0 ) goto no_mem;
+
+                    // Describe the quantized vertices with the same groups the part was quantized with
+                    vertex_group_count = quantized_vertex_input(groups, &binding_description, vertex_input_attribute_descriptions);
+                }
+
                 // Did the user specify vertex groups?
-                if ( p_vertex_attributes->type == JSONarray )
+                else if ( p_vertex_attributes->type == JSONarray )
                 {
 
                     // Initialized data
@@ -2669,6 +2794,14 @@ int load_graphics_shader_as_json_value ( GXShader_t **pp_shader, JSONValue_t *p_
                 // Error
                 return 0;
 
+            unknown_vertex_group:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Shader] Unknown vertex group in \"vertex groups\" property in call to function \"%s\"\nRefer to gschema: https://schema.g10.app/shader.json \n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
             wrong_multisampler_type:
                 #ifndef NDEBUG
                     g_print_error("[G10] [Shader] Failed to parse \"multisampler\" property in call to function \"%s\"\nRefer to gschema: https://schema.g10.app/shader.json \n", __FUNCTION__);
@@ -3021,18 +3154,21 @@ int load_compute_shader_as_json_value ( GXShader_t **pp_shader, JSONValue_t *p_v
             goto missing_properties;
     }
 
-    // Lock the shader cache mutex
-    SDL_LockMutex(p_instance->mutexes.shader_cache);
+    // Error check
+    if ( p_name->type != JSONstring ) goto name_wrong_type;
 
-    // Search the cache for the shader
-    p_cache_shader = g_find_shader(p_instance, p_name->string);
+    // Search the cache for the shader, or claim the load. Other shaders load while this one does
+    p_cache_shader = g_claim_shader(p_instance, p_name->string);
 
     // If the shader is in the cache ...
     if ( p_cache_shader )
     {
 
-        // TODO
+        // ... return it to the caller
+        *pp_shader = p_cache_shader;
 
+        // Success
+        return 1;
     }
 
     // ... the shader is not in the cache
@@ -3154,8 +3290,8 @@ int load_compute_shader_as_json_value ( GXShader_t **pp_shader, JSONValue_t *p_v
             ) goto failed_to_create_compute_pipeline;
         }
 
-        // Cache the shader
-        g_cache_shader(p_instance, p_shader);
+        // Cache the shader, and wake the threads waiting for it
+        g_settle_shader(p_instance, p_name->string, p_shader);
 
         // Return the pointer to the caller
         *pp_shader = p_shader;
@@ -3168,6 +3304,10 @@ int load_compute_shader_as_json_value ( GXShader_t **pp_shader, JSONValue_t *p_v
     no_compute_shader_path:
     failed_to_load_layout_as_json_value:
     failed_to_create_descriptor_set_layout:
+
+        // Wake the threads waiting for the shader
+        g_settle_shader(p_instance, p_name->string, 0);
+
         return 0;
 
     // Error handling
@@ -3191,6 +3331,9 @@ int load_compute_shader_as_json_value ( GXShader_t **pp_shader, JSONValue_t *p_v
                     g_print_error("[Vulkan] Failed to create pipeline layout in call to function \"%s\"\n", __FUNCTION__);
                 #endif
 
+                // Wake the threads waiting for the shader
+                g_settle_shader(p_instance, p_name->string, 0);
+
                 // Error
                 return 0;
 
@@ -3199,6 +3342,9 @@ int load_compute_shader_as_json_value ( GXShader_t **pp_shader, JSONValue_t *p_v
                     g_print_error("[Vulkan] Failed to create compute pipeline in call to function \"%s\"\n", __FUNCTION__);
                 #endif
 
+                // Wake the threads waiting for the shader
+                g_settle_shader(p_instance, p_name->string, 0);
+
                 // Error
                 return 0;
         }
@@ -3210,6 +3356,9 @@ int load_compute_shader_as_json_value ( GXShader_t **pp_shader, JSONValue_t *p_v
                     g_print_error("[G10] [Shader] Failed to allocate shader in call to function \"%s\"\n", __FUNCTION__);
                 #endif
 
+                // Wake the threads waiting for the shader
+                g_settle_shader(p_instance, p_name->string, 0);
+
                 // Error
                 return 0;
         }
@@ -3238,6 +3387,9 @@ int load_compute_shader_as_json_value ( GXShader_t **pp_shader, JSONValue_t *p_v
                     g_print_error("[G10] [Shader] Failed to parse \"compute shader path\" property in call to function \"%s\"\nRefer to gschema: https://schema.g10.app/shader.json \n", __FUNCTION__);
                 #endif
 
+                // Wake the threads waiting for the shader
+                g_settle_shader(p_instance, p_name->string, 0);
+
                 // Error
                 return 0;
 
@@ -3246,6 +3398,9 @@ int load_compute_shader_as_json_value ( GXShader_t **pp_shader, JSONValue_t *p_v
                     g_print_error("[G10] [Shader] Failed to load compute shader binary in call to function \"%s\"\nRefer to gschema: https://schema.g10.app/shader.json \n", __FUNCTION__);
                 #endif
 
+                // Wake the threads waiting for the shader
+                g_settle_shader(p_instance, p_name->string, 0);
+
                 // Error
                 return 0;
 
@@ -3254,6 +3409,9 @@ int load_compute_shader_as_json_value ( GXShader_t **pp_shader, JSONValue_t *p_v
                     g_print_error("[G10] [Shader] Failed to create compute shader module in call to function \"%s\"\nRefer to gschema: https://schema.g10.app/shader.json \n", __FUNCTION__);
                 #endif
 
+                // Wake the threads waiting for the shader
+                g_settle_shader(p_instance, p_name->string, 0);
+
                 // Error
                 return 0;
         }
@@ -3265,6 +3423,9 @@ int load_compute_shader_as_json_value ( GXShader_t **pp_shader, JSONValue_t *p_v
                     g_print_error("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
                 #endif
 
+                // Wake the threads waiting for the shader
+                g_settle_shader(p_instance, p_name->string, 0);
+
                 // Error
                 return 0;
         }
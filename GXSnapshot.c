@@ -0,0 +1,1012 @@
+// Allocations made here are counted against the scene
+#define G10_ALLOC_TAG alloc_tag_scene
+
+#include <G10/GXSnapshot.h>
+
+// "G10S" and "G10D"
+#define SNAPSHOT_MAGIC   0x53303147
+#define DELTA_MAGIC      0x44303147
+#define SNAPSHOT_VERSION 1
+
+// Marks an AI without a current state
+#define NO_STATE         0xFFFFFFFF
+
+// Round up to a multiple of 16 bytes
+#define ALIGN_16(x)      ( ( (x) + 15 ) & ~(size_t) 15 )
+
+// Start of a snapshot
+struct snapshot_header_s
+{
+    u32 magic,
+        version,
+        entity_count,
+        transform_count,
+        rigidbody_count,
+        ai_count,
+        string_size,
+        _pad;
+};
+
+// Start of a delta
+struct delta_header_s
+{
+    u32 magic,
+        version;
+    u64 size,
+        base_size;
+};
+
+// State of a transform
+struct snapshot_transform_s
+{
+    vec3       location;
+    quaternion rotation;
+    vec3       scale;
+};
+
+// State of a rigidbody
+struct snapshot_rigidbody_s
+{
+    vec3       acceleration,
+               velocity,
+               momentum;
+    quaternion angular_acceleration,
+               angular_velocity,
+               angular_momentum;
+    u32        active,
+               _pad[3];
+};
+
+// Where each array of a snapshot starts
+struct snapshot_layout_s
+{
+    size_t handles,
+           masks,
+           transforms,
+           rigidbodies,
+           ais,
+           strings,
+           size;
+};
+
+// Place each array of a snapshot
+static struct snapshot_layout_s layout_snapshot ( const struct snapshot_header_s *p_header )
+{
+
+    // Initialized data
+    struct snapshot_layout_s layout = { 0 };
+
+    layout.handles     = sizeof(struct snapshot_header_s);
+    layout.masks       = layout.handles     + p_header->entity_count * sizeof(handle_t);
+    layout.transforms  = ALIGN_16(layout.masks + p_header->entity_count * sizeof(u8));
+    layout.rigidbodies = layout.transforms  + p_header->transform_count * sizeof(struct snapshot_transform_s);
+    layout.ais         = layout.rigidbodies + p_header->rigidbody_count * sizeof(struct snapshot_rigidbody_s);
+    layout.strings     = layout.ais         + p_header->ai_count * sizeof(u32);
+    layout.size        = ALIGN_16(layout.strings + p_header->string_size);
+
+    // Success
+    return layout;
+}
+
+// Grow a snapshot to hold at least size bytes
+static int reserve_snapshot ( GXSnapshot_t *p_snapshot, size_t size )
+{
+
+    // Initialized data
+    size_t  new_max  = ( p_snapshot->max ) ? p_snapshot->max : 4096;
+    u8     *new_data = 0;
+
+    // Already big enough
+    if ( size <= p_snapshot->max ) return 1;
+
+    while ( new_max < size )
+        new_max *= 2;
+
+    new_data = G10_REALLOC(p_snapshot->data, new_max);
+
+    // Error check
+    if ( new_data == (void *) 0 ) return 0;
+
+    p_snapshot->data = new_data;
+    p_snapshot->max  = new_max;
+
+    // Success
+    return 1;
+}
+
+int create_snapshot ( GXSnapshot_t **pp_snapshot )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( pp_snapshot == (void *) 0 ) goto no_snapshot;
+    #endif
+
+    // Initialized data
+    GXSnapshot_t *p_snapshot = calloc(1, sizeof(GXSnapshot_t));
+
+    // Error check
+    if ( p_snapshot == (void *) 0 ) goto no_mem;
+
+    // Return
+    *pp_snapshot = p_snapshot;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_snapshot:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Snapshot] Null pointer provided for parameter \"pp_snapshot\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    g_print_error("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int load_snapshot ( GXSnapshot_t **pp_snapshot, const char *path )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( pp_snapshot == (void *) 0 ) goto no_snapshot;
+        if ( path        == (void *) 0 ) goto no_path;
+    #endif
+
+    // Initialized data
+    GXSnapshot_t *p_snapshot = 0;
+    size_t        len        = g_load_file(path, 0, true);
+
+    // Error check
+    if ( len < sizeof(u32) ) goto failed_to_load_file;
+
+    // Allocate a snapshot
+    if ( create_snapshot(&p_snapshot) == 0 ) goto failed_to_allocate_snapshot;
+
+    if ( reserve_snapshot(p_snapshot, len) == 0 ) goto no_mem;
+
+    // Load the file
+    if ( g_load_file(path, p_snapshot->data, true) == 0 ) goto failed_to_load_file;
+
+    p_snapshot->size = len;
+
+    // Return
+    *pp_snapshot = p_snapshot;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_snapshot:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Snapshot] Null pointer provided for parameter \"pp_snapshot\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_path:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Snapshot] Null pointer provided for parameter \"path\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // G10 errors
+        {
+            failed_to_load_file:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Snapshot] Failed to load file \"%s\" in call to function \"%s\"\n", path, __FUNCTION__);
+                #endif
+
+                // Clean up
+                (void) destroy_snapshot(&p_snapshot);
+
+                // Error
+                return 0;
+
+            failed_to_allocate_snapshot:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Snapshot] Failed to allocate snapshot in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    g_print_error("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Clean up
+                (void) destroy_snapshot(&p_snapshot);
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int take_snapshot ( GXSnapshot_t *p_snapshot, GXScene_t *p_scene )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( p_snapshot          == (void *) 0 ) goto no_snapshot;
+        if ( p_scene             == (void *) 0 ) goto no_scene;
+        if ( p_scene->components == (void *) 0 ) goto no_components;
+    #endif
+
+    // Initialized data
+    GXComponentStorage_t      *p_storage = p_scene->components;
+    struct snapshot_header_s   header    = { .magic = SNAPSHOT_MAGIC, .version = SNAPSHOT_VERSION };
+    struct snapshot_layout_s   layout    = { 0 };
+    GXScratchMark_t            mark      = scratch_mark();
+    const char               **states    = 0;
+    size_t                     e         = 0,
+                               t         = 0,
+                               r         = 0,
+                               a         = 0;
+
+    // Count the records from the size of each archetype
+    for (size_t i = 0; i < ARCHETYPE_COUNT; i++)
+    {
+
+        // Initialized data
+        GXArchetype_t *p_archetype = p_storage->archetypes[i];
+
+        if ( p_archetype == (void *) 0 ) continue;
+
+        header.entity_count += (u32) p_archetype->entity_count;
+
+        if ( p_archetype->components & COMPONENT_TRANSFORM ) header.transform_count += (u32) p_archetype->entity_count;
+        if ( p_archetype->components & COMPONENT_RIGIDBODY ) header.rigidbody_count += (u32) p_archetype->entity_count;
+        if ( p_archetype->components & COMPONENT_AI        ) header.ai_count        += (u32) p_archetype->entity_count;
+    }
+
+    // The current state of each AI, until the string sizes are known
+    states = scratch_alloc(( header.ai_count + 1 ) * sizeof(const char *));
+
+    // Error check
+    if ( states == (void *) 0 ) goto no_mem;
+
+    // Make room for everything but the strings
+    layout = layout_snapshot(&header);
+
+    if ( reserve_snapshot(p_snapshot, layout.size) == 0 ) goto no_mem;
+
+    // Write each chunk of each archetype
+    {
+
+        // Initialized data
+        handle_t                    *p_handles     = (handle_t *) ( p_snapshot->data + layout.handles );
+        u8                          *p_masks       = p_snapshot->data + layout.masks;
+        struct snapshot_transform_s *p_transforms  = (struct snapshot_transform_s *) ( p_snapshot->data + layout.transforms );
+        struct snapshot_rigidbody_s *p_rigidbodies = (struct snapshot_rigidbody_s *) ( p_snapshot->data + layout.rigidbodies );
+
+        for (size_t i = 0; i < ARCHETYPE_COUNT; i++)
+        {
+
+            // Initialized data
+            GXArchetype_t *p_archetype = p_storage->archetypes[i];
+
+            if ( p_archetype == (void *) 0 ) continue;
+
+            for (size_t j = 0; j < p_archetype->chunk_count; j++)
+            {
+
+                // Initialized data
+                GXArchetypeChunk_t *p_chunk = p_archetype->chunks[j];
+
+                // Handles and component masks
+                for (size_t k = 0; k < p_chunk->count; k++)
+                {
+                    p_handles[e + k] = p_chunk->entities[k]->handle;
+                    p_masks[e + k]   = (u8) p_archetype->components;
+                }
+
+                e += p_chunk->count;
+
+                // Transforms
+                if ( p_archetype->components & COMPONENT_TRANSFORM )
+                    for (size_t k = 0; k < p_chunk->count; k++, t++)
+                    {
+
+                        // Initialized data
+                        GXTransform_t *p_transform = p_chunk->transforms[k];
+
+                        p_transforms[t] = (struct snapshot_transform_s) {
+                            .location = p_transform->location,
+                            .rotation = p_transform->rotation,
+                            .scale    = p_transform->scale
+                        };
+                    }
+
+                // Rigidbodies
+                if ( p_archetype->components & COMPONENT_RIGIDBODY )
+                    for (size_t k = 0; k < p_chunk->count; k++, r++)
+                    {
+
+                        // Initialized data
+                        GXRigidbody_t *p_rigidbody = p_chunk->rigidbodies[k];
+
+                        p_rigidbodies[r] = (struct snapshot_rigidbody_s) {
+                            .acceleration         = p_rigidbody->acceleration,
+                            .velocity             = p_rigidbody->velocity,
+                            .momentum             = p_rigidbody->momentum,
+                            .angular_acceleration = p_rigidbody->angular_acceleration,
+                            .angular_velocity     = p_rigidbody->angular_velocity,
+                            .angular_momentum     = p_rigidbody->angular_momentum,
+                            .active               = p_rigidbody->active
+                        };
+                    }
+
+                // AIs
+                if ( p_archetype->components & COMPONENT_AI )
+                    for (size_t k = 0; k < p_chunk->count; k++)
+                        states[a++] = p_chunk->ais[k]->current_state;
+            }
+        }
+    }
+
+    // Write the current state of each AI. Neighbours usually share a state, so only write a state when it changes
+    {
+
+        // Initialized data
+        const char *p_last = 0;
+        u32         last   = NO_STATE;
+
+        for (size_t i = 0; i < a; i++)
+        {
+
+            // Initialized data
+            const char *p_state = states[i];
+            u32        *p_ais   = 0;
+
+            // Write the state
+            if ( p_state && p_state != p_last && ( p_last == (void *) 0 || strcmp(p_state, p_last) ) )
+            {
+
+                // Initialized data
+                size_t len = strlen(p_state) + 1;
+
+                if ( reserve_snapshot(p_snapshot, ALIGN_16(layout.strings + header.string_size + len)) == 0 ) goto no_mem;
+
+                memcpy(p_snapshot->data + layout.strings + header.string_size, p_state, len);
+
+                last                = header.string_size;
+                p_last              = p_state;
+                header.string_size += (u32) len;
+            }
+
+            p_ais    = (u32 *) ( p_snapshot->data + layout.ais );
+            p_ais[i] = ( p_state ) ? last : NO_STATE;
+        }
+    }
+
+    // Write the header, and zero the padding so deltas stay small
+    layout = layout_snapshot(&header);
+
+    memcpy(p_snapshot->data, &header, sizeof(header));
+    memset(p_snapshot->data + layout.masks + header.entity_count, 0, layout.transforms - ( layout.masks + header.entity_count ));
+    memset(p_snapshot->data + layout.strings + header.string_size, 0, layout.size - ( layout.strings + header.string_size ));
+
+    p_snapshot->size = layout.size;
+
+    // Clean the scope
+    scratch_rewind(mark);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_snapshot:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Snapshot] Null pointer provided for parameter \"p_snapshot\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_scene:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Snapshot] Null pointer provided for parameter \"p_scene\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_components:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Snapshot] Scene \"%s\" has no component storage in call to function \"%s\"\n", p_scene->name, __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    g_print_error("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Clean the scope
+                scratch_rewind(mark);
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int restore_snapshot ( GXSnapshot_t *p_snapshot, GXScene_t *p_scene )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( p_snapshot          == (void *) 0 ) goto no_snapshot;
+        if ( p_scene             == (void *) 0 ) goto no_scene;
+        if ( p_scene->components == (void *) 0 ) goto no_components;
+    #endif
+
+    // Initialized data
+    struct snapshot_header_s     header        = { 0 };
+    struct snapshot_layout_s     layout        = { 0 };
+    handle_t                    *p_handles     = 0;
+    u8                          *p_masks       = 0;
+    struct snapshot_transform_s *p_transforms  = 0;
+    struct snapshot_rigidbody_s *p_rigidbodies = 0;
+    u32                         *p_ais         = 0;
+    const char                  *p_strings     = 0;
+    size_t                       t             = 0,
+                                 r             = 0,
+                                 a             = 0;
+
+    // Check the snapshot
+    if ( p_snapshot->size < sizeof(header) ) goto bad_snapshot;
+
+    memcpy(&header, p_snapshot->data, sizeof(header));
+
+    if ( header.magic   != SNAPSHOT_MAGIC   ) goto bad_snapshot;
+    if ( header.version != SNAPSHOT_VERSION ) goto bad_snapshot;
+
+    layout = layout_snapshot(&header);
+
+    if ( layout.size > p_snapshot->size ) goto bad_snapshot;
+
+    p_handles     = (handle_t *) ( p_snapshot->data + layout.handles );
+    p_masks       = p_snapshot->data + layout.masks;
+    p_transforms  = (struct snapshot_transform_s *) ( p_snapshot->data + layout.transforms );
+    p_rigidbodies = (struct snapshot_rigidbody_s *) ( p_snapshot->data + layout.rigidbodies );
+    p_ais         = (u32 *) ( p_snapshot->data + layout.ais );
+    p_strings     = (const char *) ( p_snapshot->data + layout.strings );
+
+    // Check that the masks account for every record, so the record indices stay in bounds
+    for (size_t i = 0; i < header.entity_count; i++)
+    {
+        t += ( p_masks[i] & COMPONENT_TRANSFORM ) != 0;
+        r += ( p_masks[i] & COMPONENT_RIGIDBODY ) != 0;
+        a += ( p_masks[i] & COMPONENT_AI        ) != 0;
+    }
+
+    if ( t != header.transform_count ) goto bad_snapshot;
+    if ( r != header.rigidbody_count ) goto bad_snapshot;
+    if ( a != header.ai_count        ) goto bad_snapshot;
+
+    // Check that each state is a terminated string inside the snapshot
+    if ( header.string_size && p_strings[header.string_size - 1] != '\0' ) goto bad_snapshot;
+
+    for (size_t i = 0; i < header.ai_count; i++)
+        if ( p_ais[i] != NO_STATE && p_ais[i] >= header.string_size ) goto bad_snapshot;
+
+    t = r = a = 0;
+
+    // Restore each entity
+    for (size_t i = 0; i < header.entity_count; i++)
+    {
+
+        // Initialized data
+        u32         mask     = p_masks[i];
+        GXEntity_t *p_entity = resolve_entity(p_scene->components, p_handles[i]);
+
+        // Skip entities that are gone, or that changed shape
+        if ( p_entity == (void *) 0 || entity_components(p_entity) != mask )
+        {
+            t += ( mask & COMPONENT_TRANSFORM ) != 0;
+            r += ( mask & COMPONENT_RIGIDBODY ) != 0;
+            a += ( mask & COMPONENT_AI        ) != 0;
+
+            continue;
+        }
+
+        // Transform
+        if ( mask & COMPONENT_TRANSFORM )
+        {
+
+            // Initialized data
+            GXTransform_t               *p_transform = p_entity->transform;
+            struct snapshot_transform_s *p_record    = &p_transforms[t++];
+
+            p_transform->location = p_record->location;
+            p_transform->rotation = p_record->rotation;
+            p_transform->scale    = p_record->scale;
+
+            // Rebuild the model matrix
+            dirty_transform(p_transform);
+        }
+
+        // Rigidbody
+        if ( mask & COMPONENT_RIGIDBODY )
+        {
+
+            // Initialized data
+            GXRigidbody_t               *p_rigidbody = p_entity->rigidbody;
+            struct snapshot_rigidbody_s *p_record    = &p_rigidbodies[r++];
+
+            p_rigidbody->acceleration         = p_record->acceleration;
+            p_rigidbody->velocity             = p_record->velocity;
+            p_rigidbody->momentum             = p_record->momentum;
+            p_rigidbody->angular_acceleration = p_record->angular_acceleration;
+            p_rigidbody->angular_velocity     = p_record->angular_velocity;
+            p_rigidbody->angular_momentum     = p_record->angular_momentum;
+            p_rigidbody->active               = p_record->active;
+        }
+
+        // AI
+        if ( mask & COMPONENT_AI )
+        {
+
+            // Initialized data
+            GXAI_t *p_ai  = p_entity->ai;
+            u32     state = p_ais[a++];
+
+            // No state
+            if ( state == NO_STATE )
+                p_ai->current_state = 0;
+
+            // Change the state. Interned, since the snapshot may be freed
+            else if ( ( p_ai->current_state == (void *) 0 || strcmp(p_ai->current_state, &p_strings[state]) ) )
+                (void) set_ai_state(p_ai, intern_string(&p_strings[state]));
+        }
+    }
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_snapshot:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Snapshot] Null pointer provided for parameter \"p_snapshot\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_scene:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Snapshot] Null pointer provided for parameter \"p_scene\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_components:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Snapshot] Scene \"%s\" has no component storage in call to function \"%s\"\n", p_scene->name, __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // G10 errors
+        {
+            bad_snapshot:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Snapshot] Parameter \"p_snapshot\" is not a snapshot, is a delta, or is corrupt, in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int encode_snapshot_delta ( GXSnapshot_t *p_delta, GXSnapshot_t *p_base, GXSnapshot_t *p_snapshot )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( p_delta    == (void *) 0 ) goto no_delta;
+        if ( p_base     == (void *) 0 ) goto no_base;
+        if ( p_snapshot == (void *) 0 ) goto no_snapshot;
+        if ( p_delta    == p_base || p_delta == p_snapshot ) goto delta_aliases;
+    #endif
+
+    // Initialized data
+    struct delta_header_s  header = { .magic = DELTA_MAGIC, .version = SNAPSHOT_VERSION, .size = p_snapshot->size, .base_size = p_base->size };
+    const u32             *p_t    = (const u32 *) p_snapshot->data,
+                          *p_b    = (const u32 *) p_base->data;
+    size_t                 n      = p_snapshot->size / sizeof(u32),
+                           bn     = p_base->size / sizeof(u32),
+                           i      = 0;
+    u32                   *p_out  = 0;
+
+    // Worst case is one run for every literal word and zero word pair
+    if ( reserve_snapshot(p_delta, sizeof(header) + p_snapshot->size * 2 + sizeof(u32)) == 0 ) goto no_mem;
+
+    memcpy(p_delta->data, &header, sizeof(header));
+
+    p_out = (u32 *) ( p_delta->data + sizeof(header) );
+
+    // Each run is a count of unchanged words, then a count of changed words, then the changed words xor the base
+    while ( i < n )
+    {
+
+        // Initialized data
+        u32    zeros    = 0,
+               literals = 0;
+        size_t start    = 0;
+
+        // Count unchanged words
+        while ( i < n && zeros < 0xFFFF && p_t[i] == ( ( i < bn ) ? p_b[i] : 0 ) )
+            zeros++, i++;
+
+        // Count changed words. A single unchanged word is cheaper to keep as a literal than to start a run
+        start = i;
+
+        while ( i < n && literals < 0xFFFF )
+        {
+            if ( p_t[i] == ( ( i < bn ) ? p_b[i] : 0 ) && ( i + 1 >= n || p_t[i + 1] == ( ( i + 1 < bn ) ? p_b[i + 1] : 0 ) ) )
+                break;
+
+            literals++, i++;
+        }
+
+        // Write the run
+        *p_out++ = zeros | ( literals << 16 );
+
+        for (size_t j = start; j < start + literals; j++)
+            *p_out++ = p_t[j] ^ ( ( j < bn ) ? p_b[j] : 0 );
+    }
+
+    p_delta->size = (u8 *) p_out - p_delta->data;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_delta:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Snapshot] Null pointer provided for parameter \"p_delta\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_base:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Snapshot] Null pointer provided for parameter \"p_base\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_snapshot:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Snapshot] Null pointer provided for parameter \"p_snapshot\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            delta_aliases:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Snapshot] Parameter \"p_delta\" is the same snapshot as \"p_base\" or \"p_snapshot\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    g_print_error("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int apply_snapshot_delta ( GXSnapshot_t *p_snapshot, GXSnapshot_t *p_base, GXSnapshot_t *p_delta )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( p_snapshot == (void *) 0 ) goto no_snapshot;
+        if ( p_base     == (void *) 0 ) goto no_base;
+        if ( p_delta    == (void *) 0 ) goto no_delta;
+        if ( p_delta    == p_snapshot ) goto delta_aliases;
+    #endif
+
+    // Initialized data
+    struct delta_header_s  header = { 0 };
+    const u32             *p_in   = 0,
+                          *p_end  = 0,
+                          *p_b    = 0;
+    u32                   *p_t    = 0;
+    size_t                 n      = 0,
+                           bn     = 0,
+                           i      = 0;
+
+    // Check the delta
+    if ( p_delta->size < sizeof(header) ) goto bad_delta;
+
+    memcpy(&header, p_delta->data, sizeof(header));
+
+    if ( header.magic     != DELTA_MAGIC      ) goto bad_delta;
+    if ( header.version   != SNAPSHOT_VERSION ) goto bad_delta;
+    if ( header.base_size != p_base->size     ) goto wrong_base;
+
+    // Make room for the snapshot. The base may be the snapshot, so look at it after it moves
+    if ( reserve_snapshot(p_snapshot, header.size) == 0 ) goto no_mem;
+
+    p_in  = (const u32 *) ( p_delta->data + sizeof(header) );
+    p_end = (const u32 *) ( p_delta->data + p_delta->size );
+    p_b   = (const u32 *) p_base->data;
+    p_t   = (u32 *) p_snapshot->data;
+    n     = header.size / sizeof(u32);
+    bn    = p_base->size / sizeof(u32);
+
+    // Decode each run
+    while ( i < n )
+    {
+
+        // Initialized data
+        u32 zeros    = 0,
+            literals = 0;
+
+        if ( p_in >= p_end ) goto bad_delta;
+
+        zeros    = *p_in & 0xFFFF;
+        literals = *p_in++ >> 16;
+
+        if ( i + zeros + literals > n || (size_t) ( p_end - p_in ) < literals ) goto bad_delta;
+
+        // Copy unchanged words from the base
+        for (u32 j = 0; j < zeros; j++, i++)
+            p_t[i] = ( i < bn ) ? p_b[i] : 0;
+
+        // Undo the xor of changed words
+        for (u32 j = 0; j < literals; j++, i++)
+            p_t[i] = *p_in++ ^ ( ( i < bn ) ? p_b[i] : 0 );
+    }
+
+    p_snapshot->size = header.size;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_snapshot:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Snapshot] Null pointer provided for parameter \"p_snapshot\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_base:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Snapshot] Null pointer provided for parameter \"p_base\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_delta:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Snapshot] Null pointer provided for parameter \"p_delta\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            delta_aliases:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Snapshot] Parameter \"p_delta\" is the same snapshot as \"p_snapshot\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // G10 errors
+        {
+            bad_delta:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Snapshot] Parameter \"p_delta\" is not a delta, or is damaged, in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            wrong_base:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Snapshot] Parameter \"p_base\" is not the base of the delta in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    g_print_error("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int save_snapshot ( GXSnapshot_t *p_snapshot, const char *path )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( p_snapshot == (void *) 0 ) goto no_snapshot;
+        if ( path       == (void *) 0 ) goto no_path;
+    #endif
+
+    // Initialized data
+    FILE *p_f = fopen(path, "wb");
+
+    // Error check
+    if ( p_f == (void *) 0 ) goto failed_to_open_file;
+
+    // Write the snapshot
+    if ( fwrite(p_snapshot->data, 1, p_snapshot->size, p_f) != p_snapshot->size ) goto failed_to_write_file;
+
+    // Close the file
+    fclose(p_f);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_snapshot:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Snapshot] Null pointer provided for parameter \"p_snapshot\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_path:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Snapshot] Null pointer provided for parameter \"path\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            failed_to_open_file:
+                #ifndef NDEBUG
+                    g_print_error("[Standard Library] Failed to open file \"%s\" in call to function \"%s\"\n", path, __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            failed_to_write_file:
+                #ifndef NDEBUG
+                    g_print_error("[Standard Library] Failed to write file \"%s\" in call to function \"%s\"\n", path, __FUNCTION__);
+                #endif
+
+                // Close the file
+                fclose(p_f);
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int destroy_snapshot ( GXSnapshot_t **pp_snapshot )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( pp_snapshot == (void *) 0 ) goto no_snapshot;
+    #endif
+
+    // Initialized data
+    GXSnapshot_t *p_snapshot = *pp_snapshot;
+
+    // Nothing to destroy
+    if ( p_snapshot == (void *) 0 ) return 1;
+
+    // No more pointer for caller
+    *pp_snapshot = 0;
+
+    // Free the snapshot
+    G10_FREE(p_snapshot->data);
+    free(p_snapshot);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_snapshot:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Snapshot] Null pointer provided for parameter \"pp_snapshot\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
@@ -0,0 +1,359 @@
+#include <G10/GXStats.h>
+
+// The value of each statistic, and the highest value it has had
+static i64 values[stat_count] = { 0 },
+           peaks[stat_count]  = { 0 };
+
+// Name of each statistic
+static const char *stat_names[stat_count] = {
+    "entities",
+    "transforms",
+    "rigidbodies",
+    "colliders",
+    "ais",
+    "prefabs",
+    "parts",
+    "materials",
+    "shaders",
+    "images",
+    "arena bytes",
+    "pool bytes",
+    "scratch bytes",
+    "vertex buffer bytes",
+    "index buffer bytes",
+    "image bytes",
+    "part cache hits",
+    "part cache misses",
+    "material cache hits",
+    "material cache misses",
+    "shader cache hits",
+    "shader cache misses",
+    "ai cache hits",
+    "ai cache misses"
+};
+
+// The first statistic of each group, and the name of the group
+static const struct { stat_type_t first; const char *name; } stat_groups[] = {
+    { stat_entities           , "objects"   },
+    { stat_arena_bytes        , "cpu bytes" },
+    { stat_vertex_buffer_bytes, "gpu bytes" },
+    { stat_part_cache_hits    , "cache"     },
+    { stat_count              , 0           }
+};
+
+// Write a string as a JSON string
+static void print_json_string ( FILE *p_f, const char *string )
+{
+
+    // Open the string
+    fputc('"', p_f);
+
+    // Escape quotes, backslashes, and control characters
+    for (const char *c = string; *c; c++)
+    {
+        if ( *c == '"' || *c == '\\' )
+            fprintf(p_f, "\\%c", *c);
+        else if ( (unsigned char) *c < 0x20 )
+            fprintf(p_f, "\\u%04x", (unsigned char) *c);
+        else
+            fputc(*c, p_f);
+    }
+
+    // Close the string
+    fputc('"', p_f);
+}
+
+void stats_add ( stat_type_t stat, i64 n )
+{
+
+    // Initialized data
+    i64 value = G10_ATOMIC_ADD(&values[stat], n) + n,
+        peak  = G10_ATOMIC_LOAD(&peaks[stat]);
+
+    // Raise the peak
+    while ( value > peak )
+    {
+        if ( G10_ATOMIC_CAS(&peaks[stat], peak, value) ) break;
+
+        peak = G10_ATOMIC_LOAD(&peaks[stat]);
+    }
+}
+
+i64 get_stat ( stat_type_t stat )
+{
+
+    // Success
+    return G10_ATOMIC_LOAD(&values[stat]);
+}
+
+i64 get_stat_peak ( stat_type_t stat )
+{
+
+    // Success
+    return G10_ATOMIC_LOAD(&peaks[stat]);
+}
+
+const char *get_stat_name ( stat_type_t stat )
+{
+
+    // Out of range
+    if ( (size_t) stat >= stat_count ) return 0;
+
+    // Success
+    return stat_names[stat];
+}
+
+int get_scene_stats ( GXScene_t *p_scene, GXSceneStats_t *p_stats )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( p_scene == (void *) 0 ) goto no_scene;
+        if ( p_stats == (void *) 0 ) goto no_stats;
+    #endif
+
+    // Initialized data
+    size_t       entity_count = ( p_scene->entities ) ? dict_values(p_scene->entities, 0) : 0;
+    GXEntity_t **pp_entities  = calloc(entity_count + 1, sizeof(GXEntity_t *));
+
+    // Error check
+    if ( pp_entities == (void *) 0 ) goto no_mem;
+
+    *p_stats = (GXSceneStats_t) { 0 };
+
+    // Count the components of each entity
+    if ( entity_count )
+    {
+        dict_values(p_scene->entities, (void **)pp_entities);
+
+        for (size_t i = 0; i < entity_count; i++)
+        {
+
+            // Initialized data
+            GXEntity_t *p_entity = pp_entities[i];
+
+            p_stats->transforms  += ( p_entity->transform != 0 );
+            p_stats->rigidbodies += ( p_entity->rigidbody != 0 );
+            p_stats->colliders   += ( p_entity->collider  != 0 );
+            p_stats->ais         += ( p_entity->ai        != 0 );
+        }
+    }
+
+    p_stats->entities = entity_count;
+    p_stats->cameras  = ( p_scene->cameras ) ? dict_values(p_scene->cameras, 0) : 0;
+    p_stats->lights   = ( p_scene->lights  ) ? dict_values(p_scene->lights , 0) : 0;
+
+    // Measure the scene's arena
+    if ( p_scene->arena )
+    {
+        SDL_AtomicLock(&p_scene->arena->lock);
+
+        for (GXArenaBlock_t *p_block = p_scene->arena->blocks; p_block; p_block = p_block->next)
+            p_stats->arena_bytes += p_block->size;
+
+        p_stats->arena_used = p_scene->arena->used;
+
+        SDL_AtomicUnlock(&p_scene->arena->lock);
+    }
+
+    // Clean the scope
+    free(pp_entities);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_scene:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Stats] Null pointer provided for parameter \"p_scene\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_stats:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Stats] Null pointer provided for parameter \"p_stats\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    g_print_error("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int stats_info ( void )
+{
+
+    // Initialized data
+    GXInstance_t  *p_instance  = g_get_active_instance();
+    size_t         scene_count = ( p_instance && p_instance->data.scenes ) ? dict_values(p_instance->data.scenes, 0) : 0;
+    GXScene_t    **pp_scenes   = calloc(scene_count + 1, sizeof(GXScene_t *));
+
+    // Error check
+    if ( pp_scenes == (void *) 0 ) goto no_mem;
+
+    // Formatting
+    g_print_log("\n - Stats -\n");
+
+    // Print each group of statistics
+    for (size_t g = 0; stat_groups[g].name; g++)
+    {
+
+        // Formatting
+        g_print_log("%s :\n", stat_groups[g].name);
+
+        // Print each statistic of the group
+        for (size_t i = stat_groups[g].first; i < stat_groups[g + 1].first; i++)
+            g_print_log("    %-22s : %-12lld peak %lld\n", stat_names[i], get_stat(i), get_stat_peak(i));
+    }
+
+    // Print each scene
+    if ( scene_count )
+        dict_values(p_instance->data.scenes, (void **)pp_scenes);
+
+    for (size_t i = 0; i < scene_count; i++)
+    {
+
+        // Initialized data
+        GXSceneStats_t stats = { 0 };
+
+        if ( get_scene_stats(pp_scenes[i], &stats) == 0 ) continue;
+
+        g_print_log("scene \"%s\" :\n", pp_scenes[i]->name);
+        g_print_log("    entities    : %zu\n", stats.entities);
+        g_print_log("    transforms  : %zu\n", stats.transforms);
+        g_print_log("    rigidbodies : %zu\n", stats.rigidbodies);
+        g_print_log("    colliders   : %zu\n", stats.colliders);
+        g_print_log("    ais         : %zu\n", stats.ais);
+        g_print_log("    cameras     : %zu\n", stats.cameras);
+        g_print_log("    lights      : %zu\n", stats.lights);
+        g_print_log("    arena bytes : %zu ( %zu used )\n", stats.arena_bytes, stats.arena_used);
+    }
+
+    // Formatting
+    g_print_log("\n");
+
+    // Clean the scope
+    free(pp_scenes);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    g_print_error("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int print_stats_as_json ( FILE *p_f )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( p_f == (void *) 0 ) goto no_file;
+    #endif
+
+    // Initialized data
+    GXInstance_t  *p_instance  = g_get_active_instance();
+    size_t         scene_count = ( p_instance && p_instance->data.scenes ) ? dict_values(p_instance->data.scenes, 0) : 0;
+    GXScene_t    **pp_scenes   = calloc(scene_count + 1, sizeof(GXScene_t *));
+
+    // Error check
+    if ( pp_scenes == (void *) 0 ) goto no_mem;
+
+    fprintf(p_f, "{\n");
+
+    // Write each group of statistics
+    for (size_t g = 0; stat_groups[g].name; g++)
+    {
+        fprintf(p_f, "    \"%s\" : {\n", stat_groups[g].name);
+
+        // Write each statistic of the group
+        for (size_t i = stat_groups[g].first; i < stat_groups[g + 1].first; i++)
+            fprintf(p_f, "        \"%s\" : { \"value\" : %lld, \"peak\" : %lld }%s\n", stat_names[i], get_stat(i), get_stat_peak(i), ( i + 1 < stat_groups[g + 1].first ) ? "," : "");
+
+        fprintf(p_f, "    },\n");
+    }
+
+    // Write each scene
+    fprintf(p_f, "    \"scenes\" : [");
+
+    if ( scene_count )
+        dict_values(p_instance->data.scenes, (void **)pp_scenes);
+
+    for (size_t i = 0; i < scene_count; i++)
+    {
+
+        // Initialized data
+        GXSceneStats_t stats = { 0 };
+
+        (void) get_scene_stats(pp_scenes[i], &stats);
+
+        fprintf(p_f, "%s\n        { \"name\" : ", ( i ) ? "," : "");
+        print_json_string(p_f, pp_scenes[i]->name);
+        fprintf(p_f, ", \"entities\" : %zu, \"transforms\" : %zu, \"rigidbodies\" : %zu, \"colliders\" : %zu, \"ais\" : %zu, \"cameras\" : %zu, \"lights\" : %zu, \"arena bytes\" : %zu, \"arena used\" : %zu }",
+            stats.entities, stats.transforms, stats.rigidbodies, stats.colliders, stats.ais, stats.cameras, stats.lights, stats.arena_bytes, stats.arena_used
+        );
+    }
+
+    fprintf(p_f, "%s]\n", ( scene_count ) ? "\n    " : " ");
+    fprintf(p_f, "}\n");
+
+    // Clean the scope
+    free(pp_scenes);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_file:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Stats] Null pointer provided for parameter \"p_f\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    g_print_error("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
@@ -1,5 +1,11 @@
+// Allocations made here are counted against the scene
+#define G10_ALLOC_TAG alloc_tag_scene
+
 #include <G10/GXTransform.h>
 
+// Transforms made outside of a scene arena
+static GXPool_t *transform_pool = 0;
+
 int create_transform ( GXTransform_t **pp_transform )
 {
 
@@ -9,11 +15,14 @@ int create_transform ( GXTransform_t **pp_transform )
     #endif
 
     // Initialized data
-    GXTransform_t *p_transform = calloc(1, sizeof(GXTransform_t));
+    GXTransform_t *p_transform = pool_calloc(&transform_pool, sizeof(GXTransform_t));
 
     // Memory check
     if ( p_transform == (void *) 0 ) goto no_mem;
 
+    // Count the transform
+    G10_STAT_ADD(stat_transforms, 1);
+
     // Return the allocated memory
     *pp_transform = p_transform;
 
@@ -70,7 +79,10 @@ int construct_transform ( GXTransform_t **pp_transform, vec3 location, quaternio
     };
 
     // Compute a model matrix
-    transform_model_matrix(p_transform, &p_transform->model_matrix);
+    transform_model_matrix(p_transform, &p_transform->local_matrix);
+
+    // A transform without a parent is in world space
+    p_transform->model_matrix = p_transform->local_matrix;
 
     // Return the allocated memory
     *pp_transform = p_transform;
@@ -561,16 +573,8 @@ void transform_model_matrix ( GXTransform_t *p_transform, mat4 *r )
         if ( p_transform == (void *) 0 ) goto no_transform;
     #endif
 
-    mat4 sca = scale_mat4(p_transform->scale),
-         rot = rotation_mat4_from_quaternion(p_transform->rotation),
-         tra = translation_mat4(p_transform->location),
-         M   = mul_mat4_mat4(sca, mul_mat4_mat4(rot, tra));
-
-    // Set up the 4x4 matrix
-    r->a = M.a, r->b = M.b, r->c = M.c, r->d = M.d,
-    r->e = M.e, r->f = M.f, r->g = M.g, r->h = M.h,
-    r->i = M.i, r->j = M.j, r->k = M.k, r->l = M.l,
-    r->m = M.m, r->n = M.n, r->o = M.o, r->p = M.p;
+    // Compose scale * ( rotation * translation ) in one step
+    model_mat4_from_trs_batch(r, &p_transform->location, &p_transform->rotation, &p_transform->scale, 1);
 
     // Done
     return;
@@ -595,6 +599,572 @@ void transform_model_matrix ( GXTransform_t *p_transform, mat4 *r )
     }
 }
 
+// Push a transform onto its hierarchy's dirty list
+static int push_dirty_transform ( GXTransformHierarchy_t *p_hierarchy, GXTransform_t *p_transform )
+{
+
+    // Already on the list
+    if ( p_transform->flags & TRANSFORM_WORLD_DIRTY ) return 1;
+
+    // Grow the list
+    if ( p_hierarchy->dirty_count == p_hierarchy->dirty_max )
+    {
+
+        // Initialized data
+        size_t          new_max   = ( p_hierarchy->dirty_max ) ? p_hierarchy->dirty_max * 2 : 64;
+        GXTransform_t **new_dirty = G10_REALLOC(p_hierarchy->dirty, new_max * sizeof(GXTransform_t *));
+
+        // Error check
+        if ( new_dirty == (void *) 0 ) return 0;
+
+        p_hierarchy->dirty     = new_dirty;
+        p_hierarchy->dirty_max = new_max;
+    }
+
+    p_hierarchy->dirty[p_hierarchy->dirty_count++] = p_transform;
+    p_transform->flags |= TRANSFORM_WORLD_DIRTY;
+
+    // Success
+    return 1;
+}
+
+// Order dirty transforms by their place in the hierarchy
+static int compare_transform_index ( const void *a, const void *b )
+{
+
+    // Initialized data
+    size_t i = (*(GXTransform_t **)a)->index,
+           j = (*(GXTransform_t **)b)->index;
+
+    return ( i > j ) - ( i < j );
+}
+
+// Sort the hierarchy in depth first order, and compute the size of each subtree
+static int reorder_transforms ( GXTransformHierarchy_t *p_hierarchy )
+{
+
+    // Initialized data
+    size_t          count      = p_hierarchy->transform_count;
+    size_t         *first      = malloc(3 * count * sizeof(size_t) + 1),
+                   *next       = first + count,
+                   *stack      = next  + count;
+    GXTransform_t **transforms = G10_REALLOC(0, p_hierarchy->transform_max * sizeof(GXTransform_t *) + 1);
+    size_t          top        = 0,
+                    n          = 0;
+
+    // Error check
+    if ( first == (void *) 0 || transforms == (void *) 0 ) goto no_mem;
+
+    // Number each transform by its current place
+    for (size_t i = 0; i < count; i++)
+    {
+        p_hierarchy->transforms[i]->index = i;
+        first[i] = SIZE_MAX;
+        next[i]  = SIZE_MAX;
+    }
+
+    // Link each child to its parent. Walk backwards so siblings keep their order
+    for (size_t i = count; i-- > 0;)
+    {
+
+        // Initialized data
+        GXTransform_t *p_parent = p_hierarchy->transforms[i]->parent;
+
+        if ( p_parent == (void *) 0 ) continue;
+
+        next[i]                = first[p_parent->index];
+        first[p_parent->index] = i;
+    }
+
+    // Visit each root, then its descendants
+    for (size_t i = 0; i < count; i++)
+    {
+
+        // Skip children
+        if ( p_hierarchy->transforms[i]->parent ) continue;
+
+        stack[top++] = i;
+
+        while ( top )
+        {
+
+            // Initialized data
+            size_t         j           = stack[--top];
+            GXTransform_t *p_transform = p_hierarchy->transforms[j];
+
+            transforms[n++] = p_transform;
+
+            for (size_t c = first[j]; c != SIZE_MAX; c = next[c])
+                stack[top++] = c;
+        }
+    }
+
+    // Parents precede their children, so walking backwards sums each subtree
+    for (size_t i = count; i-- > 0;)
+    {
+        transforms[i]->index        = i;
+        transforms[i]->subtree_size = 1;
+    }
+
+    for (size_t i = count; i-- > 0;)
+        if ( transforms[i]->parent )
+            transforms[i]->parent->subtree_size += transforms[i]->subtree_size;
+
+    // Swap in the new order
+    G10_FREE(p_hierarchy->transforms);
+    free(first);
+
+    p_hierarchy->transforms = transforms;
+    p_hierarchy->reorder    = false;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    g_print_error("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Free what was allocated
+                free(first);
+                G10_FREE(transforms);
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int create_transform_hierarchy ( GXTransformHierarchy_t **pp_hierarchy )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( pp_hierarchy == (void *) 0 ) goto no_hierarchy;
+    #endif
+
+    // Initialized data
+    GXTransformHierarchy_t *p_hierarchy = calloc(1, sizeof(GXTransformHierarchy_t));
+
+    // Memory check
+    if ( p_hierarchy == (void *) 0 ) goto no_mem;
+
+    // Return the allocated memory
+    *pp_hierarchy = p_hierarchy;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_hierarchy:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Transform] Null pointer provided for parameter \"pp_hierarchy\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    g_print_error("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int add_transform ( GXTransformHierarchy_t *p_hierarchy, GXTransform_t *p_transform )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( p_hierarchy              == (void *) 0 ) goto no_hierarchy;
+        if ( p_transform              == (void *) 0 ) goto no_transform;
+        if ( p_transform->p_hierarchy != (void *) 0 ) goto already_in_hierarchy;
+    #endif
+
+    // Grow the list
+    if ( p_hierarchy->transform_count == p_hierarchy->transform_max )
+    {
+
+        // Initialized data
+        size_t          new_max        = ( p_hierarchy->transform_max ) ? p_hierarchy->transform_max * 2 : 64;
+        GXTransform_t **new_transforms = G10_REALLOC(p_hierarchy->transforms, new_max * sizeof(GXTransform_t *));
+
+        // Error check
+        if ( new_transforms == (void *) 0 ) goto no_mem;
+
+        p_hierarchy->transforms    = new_transforms;
+        p_hierarchy->transform_max = new_max;
+    }
+
+    // A new root goes at the end, which keeps the order valid
+    p_transform->parent       = 0;
+    p_transform->p_hierarchy  = p_hierarchy;
+    p_transform->index        = p_hierarchy->transform_count;
+    p_transform->subtree_size = 1;
+    p_transform->flags        = TRANSFORM_LOCAL_DIRTY;
+
+    p_hierarchy->transforms[p_hierarchy->transform_count++] = p_transform;
+
+    // Compute the world matrix on the next update
+    if ( push_dirty_transform(p_hierarchy, p_transform) == 0 ) goto no_mem;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_hierarchy:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Transform] Null pointer provided for parameter \"p_hierarchy\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_transform:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Transform] Null pointer provided for parameter \"p_transform\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            already_in_hierarchy:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Transform] Parameter \"p_transform\" is already in a hierarchy in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    g_print_error("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int remove_transform ( GXTransform_t *p_transform )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( p_transform              == (void *) 0 ) goto no_transform;
+        if ( p_transform->p_hierarchy == (void *) 0 ) goto not_in_hierarchy;
+    #endif
+
+    // Initialized data
+    GXTransformHierarchy_t *p_hierarchy = p_transform->p_hierarchy;
+    size_t                  n           = 0;
+
+    // Drop the transform, and promote its children to roots
+    for (size_t i = 0; i < p_hierarchy->transform_count; i++)
+    {
+
+        // Initialized data
+        GXTransform_t *p_other = p_hierarchy->transforms[i];
+
+        if ( p_other == p_transform ) continue;
+
+        if ( p_other->parent == p_transform )
+        {
+            p_other->parent = 0;
+            (void) push_dirty_transform(p_hierarchy, p_other);
+        }
+
+        p_hierarchy->transforms[n++] = p_other;
+    }
+
+    p_hierarchy->transform_count = n;
+    p_hierarchy->reorder         = true;
+
+    // Take the transform off the dirty list
+    if ( p_transform->flags & TRANSFORM_WORLD_DIRTY )
+        for (size_t i = 0; i < p_hierarchy->dirty_count; i++)
+            if ( p_hierarchy->dirty[i] == p_transform )
+            {
+                p_hierarchy->dirty[i] = p_hierarchy->dirty[--p_hierarchy->dirty_count];
+                break;
+            }
+
+    // The transform is a root outside of any hierarchy
+    p_transform->parent       = 0;
+    p_transform->p_hierarchy  = 0;
+    p_transform->index        = 0;
+    p_transform->subtree_size = 1;
+    p_transform->flags        = 0;
+
+    transform_model_matrix(p_transform, &p_transform->local_matrix);
+    p_transform->model_matrix = p_transform->local_matrix;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_transform:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Transform] Null pointer provided for parameter \"p_transform\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            not_in_hierarchy:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Transform] Parameter \"p_transform\" is not in a hierarchy in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int set_transform_parent ( GXTransform_t *p_transform, GXTransform_t *p_parent )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( p_transform              == (void *) 0 ) goto no_transform;
+        if ( p_transform->p_hierarchy == (void *) 0 ) goto not_in_hierarchy;
+    #endif
+
+    // Both transforms must be in the same hierarchy
+    if ( p_parent && p_parent->p_hierarchy != p_transform->p_hierarchy ) goto different_hierarchy;
+
+    // Nothing to do
+    if ( p_transform->parent == p_parent ) return 1;
+
+    // A transform can not be its own ancestor
+    for (GXTransform_t *p_ancestor = p_parent; p_ancestor; p_ancestor = p_ancestor->parent)
+        if ( p_ancestor == p_transform ) goto cycle;
+
+    // Attach the transform
+    p_transform->parent               = p_parent;
+    p_transform->p_hierarchy->reorder = true;
+
+    // Recompute the subtree on the next update
+    if ( push_dirty_transform(p_transform->p_hierarchy, p_transform) == 0 ) goto no_mem;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_transform:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Transform] Null pointer provided for parameter \"p_transform\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            not_in_hierarchy:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Transform] Parameter \"p_transform\" is not in a hierarchy in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            different_hierarchy:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Transform] Parameters \"p_transform\" and \"p_parent\" are in different hierarchies in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            cycle:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Transform] Parameter \"p_parent\" is a descendant of \"p_transform\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    g_print_error("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+void dirty_transform ( GXTransform_t *p_transform )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( p_transform == (void *) 0 ) goto no_transform;
+    #endif
+
+    // Without a hierarchy, the model matrix is updated now
+    if ( p_transform->p_hierarchy == (void *) 0 )
+    {
+        transform_model_matrix(p_transform, &p_transform->local_matrix);
+        p_transform->model_matrix = p_transform->local_matrix;
+
+        // Done
+        return;
+    }
+
+    // Defer the update
+    p_transform->flags |= TRANSFORM_LOCAL_DIRTY;
+
+    (void) push_dirty_transform(p_transform->p_hierarchy, p_transform);
+
+    // Done
+    return;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_transform:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Transform] Null pointer provided for parameter \"p_transform\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return;
+        }
+    }
+}
+
+int update_transforms ( GXTransformHierarchy_t *p_hierarchy )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( p_hierarchy == (void *) 0 ) goto no_hierarchy;
+    #endif
+
+    // Initialized data
+    size_t end = 0;
+
+    // Nothing moved, and nothing was removed or reparented
+    if ( p_hierarchy->dirty_count == 0 && p_hierarchy->reorder == false ) return 1;
+
+    // Restore depth first order after a removal or a reparent
+    if ( p_hierarchy->reorder )
+        if ( reorder_transforms(p_hierarchy) == 0 ) goto failed_to_reorder;
+
+    // Recompute each stale local matrix
+    for (size_t i = 0; i < p_hierarchy->dirty_count; i++)
+    {
+
+        // Initialized data
+        GXTransform_t *p_transform = p_hierarchy->dirty[i];
+
+        if ( p_transform->flags & TRANSFORM_LOCAL_DIRTY )
+            transform_model_matrix(p_transform, &p_transform->local_matrix);
+
+        p_transform->flags = 0;
+    }
+
+    // Ancestors precede their descendants
+    qsort(p_hierarchy->dirty, p_hierarchy->dirty_count, sizeof(GXTransform_t *), compare_transform_index);
+
+    // Recompute each dirty subtree once
+    for (size_t i = 0; i < p_hierarchy->dirty_count; i++)
+    {
+
+        // Initialized data
+        GXTransform_t *p_root = p_hierarchy->dirty[i];
+
+        // This subtree was already updated with an ancestor
+        if ( p_root->index < end ) continue;
+
+        end = p_root->index + p_root->subtree_size;
+
+        // Parents precede their children, so each parent is current before its children are composed
+        for (size_t j = p_root->index; j < end; j++)
+        {
+
+            // Initialized data
+            GXTransform_t *p_transform = p_hierarchy->transforms[j];
+
+            if ( p_transform->parent )
+                mul_mat4_mat4_p(&p_transform->model_matrix, &p_transform->local_matrix, &p_transform->parent->model_matrix);
+            else
+                p_transform->model_matrix = p_transform->local_matrix;
+        }
+    }
+
+    // Clear the dirty list
+    p_hierarchy->dirty_count = 0;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_hierarchy:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Transform] Null pointer provided for parameter \"p_hierarchy\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // G10 errors
+        {
+            failed_to_reorder:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Transform] Failed to sort transform hierarchy in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
 int rotate_about_quaternion ( GXTransform_t *p_transform, quaternion axis, float theta )
 {
 
@@ -657,8 +1227,17 @@ int destroy_transform ( GXTransform_t **pp_transform )
     // No more pointer for caller
     *pp_transform = 0;
 
+    // Leave the hierarchy
+    if ( p_transform && p_transform->p_hierarchy )
+        (void) remove_transform(p_transform);
+
     // Free the transform
-    free(p_transform);
+    if ( p_transform )
+    {
+        pool_release(&transform_pool, p_transform);
+
+        G10_STAT_ADD(stat_transforms, -1);
+    }
 
     // Success
     return 1;
@@ -678,3 +1257,60 @@ int destroy_transform ( GXTransform_t **pp_transform )
         }
     }
 }
+
+int destroy_transform_hierarchy ( GXTransformHierarchy_t **pp_hierarchy )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( pp_hierarchy == (void *) 0 ) goto no_hierarchy;
+    #endif
+
+    // Initialized data
+    GXTransformHierarchy_t *p_hierarchy = *pp_hierarchy;
+
+    // No more pointer for caller
+    *pp_hierarchy = 0;
+
+    // Nothing to free
+    if ( p_hierarchy == (void *) 0 ) return 1;
+
+    // Detach each transform
+    for (size_t i = 0; i < p_hierarchy->transform_count; i++)
+    {
+
+        // Initialized data
+        GXTransform_t *p_transform = p_hierarchy->transforms[i];
+
+        p_transform->parent       = 0;
+        p_transform->p_hierarchy  = 0;
+        p_transform->index        = 0;
+        p_transform->subtree_size = 1;
+        p_transform->flags        = 0;
+    }
+
+    // Free the lists
+    G10_FREE(p_hierarchy->transforms);
+    G10_FREE(p_hierarchy->dirty);
+
+    // Free the hierarchy
+    free(p_hierarchy);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_hierarchy:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Transform] Null pointer provided for parameter \"pp_hierarchy\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
@@ -0,0 +1,441 @@
+#include <G10/GXVertex.h>
+
+#include <stdbool.h>
+#include <math.h>
+
+// The encoding of each vertex group, in bit order
+static const struct { const char *name; VkFormat format; u32 size; size_t min_count; } vertex_encodings[VERTEX_GROUP_COUNT] =
+{
+    { "geometric", VK_FORMAT_R16G16B16A16_UNORM, 8, 3 },
+    { "texture"  , VK_FORMAT_R16G16_SFLOAT     , 4, 2 },
+    { "normal"   , VK_FORMAT_R16G16_SNORM      , 4, 3 },
+    { "bitangent", VK_FORMAT_R16G16_SNORM      , 4, 3 },
+    { "tangent"  , VK_FORMAT_R16G16_SNORM      , 4, 3 },
+    { "color"    , VK_FORMAT_R8G8B8A8_UNORM    , 4, 3 },
+    { "bones"    , VK_FORMAT_R8G8B8A8_UINT     , 4, 4 },
+    { "weights"  , VK_FORMAT_R8G8B8A8_UNORM    , 4, 4 }
+};
+
+// Read a property of a vertex, which may not be aligned
+static float vertex_property ( const u8 *p_vertex, const GXVertexSource_t *p_source, size_t group, size_t i )
+{
+
+    // Initialized data
+    float f = 0;
+
+    memcpy(&f, p_vertex + p_source->properties[group][i] * sizeof(float), sizeof(float));
+
+    return f * p_source->scales[group];
+}
+
+static float clamp_float ( float f, float lo, float hi )
+{
+    return ( f < lo ) ? lo : ( f > hi ) ? hi : f;
+}
+
+// Round to the nearest half float, ties to even
+static u16 float_to_half ( float f )
+{
+
+    // Initialized data
+    u32 x        = 0,
+        sign     = 0,
+        mantissa = 0,
+        h        = 0,
+        rest     = 0;
+    i32 exponent = 0;
+
+    memcpy(&x, &f, sizeof(u32));
+
+    sign     = ( x >> 16 ) & 0x8000,
+    exponent = (i32) ( ( x >> 23 ) & 0xFF ) - 127 + 15,
+    mantissa = x & 0x7FFFFF;
+
+    // Infinity, and NaN
+    if ( ( ( x >> 23 ) & 0xFF ) == 0xFF ) return (u16) ( sign | 0x7C00 | ( ( mantissa ) ? 0x200 : 0 ) );
+
+    // Too large for a half
+    if ( exponent >= 31 ) return (u16) ( sign | 0x7C00 );
+
+    // Subnormal halves
+    if ( exponent <= 0 )
+    {
+
+        // Initialized data
+        u32 shift = (u32) ( 14 - exponent );
+
+        // Too small for a half
+        if ( shift > 24 ) return (u16) sign;
+
+        mantissa |= 0x800000,
+        h         = mantissa >> shift,
+        rest      = mantissa & ( ( 1u << shift ) - 1 );
+
+        if ( rest > ( 1u << ( shift - 1 ) ) || ( rest == ( 1u << ( shift - 1 ) ) && ( h & 1 ) ) ) h++;
+
+        return (u16) ( sign | h );
+    }
+
+    // Normal halves. Rounding may carry into the exponent, which is still right
+    h    = ( (u32) exponent << 10 ) | ( mantissa >> 13 ),
+    rest = mantissa & 0x1FFF;
+
+    if ( rest > 0x1000 || ( rest == 0x1000 && ( h & 1 ) ) ) h++;
+
+    return (u16) ( sign | h );
+}
+
+// Fold a unit vector onto an octahedron, and flatten it into two 16 bit snorms
+static void encode_octahedral ( float x, float y, float z, u8 *p_out )
+{
+
+    // Initialized data
+    float l1   = fabsf(x) + fabsf(y) + fabsf(z),
+          ox   = 0,
+          oy   = 0;
+    s16   e[2] = { 0 };
+
+    // Error check
+    if ( l1 > 0 )
+    {
+        ox = x / l1,
+        oy = y / l1;
+
+        // Fold the lower half over the upper half
+        if ( z < 0 )
+        {
+
+            // Initialized data
+            float fx = ( 1.f - fabsf(oy) ) * ( ( ox >= 0 ) ? 1.f : -1.f ),
+                  fy = ( 1.f - fabsf(ox) ) * ( ( oy >= 0 ) ? 1.f : -1.f );
+
+            ox = fx,
+            oy = fy;
+        }
+    }
+
+    e[0] = (s16) lrintf(clamp_float(ox, -1.f, 1.f) * 32767.f),
+    e[1] = (s16) lrintf(clamp_float(oy, -1.f, 1.f) * 32767.f);
+
+    memcpy(p_out, e, sizeof(e));
+}
+
+int quantize_vertices ( u32 groups, const GXVertexSource_t *p_source, const void *p_vertices, size_t vertex_stride, size_t vertex_count, void *p_quantized, vec4 *p_dequantize )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( groups       == 0 )          goto no_groups;
+        if ( p_source     == (void *) 0 ) goto no_source;
+        if ( p_vertices   == (void *) 0 ) goto no_vertices;
+        if ( p_quantized  == (void *) 0 ) goto no_quantized;
+        if ( p_dequantize == (void *) 0 ) goto no_dequantize;
+    #endif
+
+    // Initialized data
+    const u8 *vertices  = p_vertices;
+    u8       *quantized = p_quantized;
+    size_t    stride    = quantized_vertex_stride(groups);
+    float     lo[3]     = { 0 },
+              scale     = 1;
+
+    // Every group needs its properties
+    for (size_t g = 0; g < VERTEX_GROUP_COUNT; g++)
+        if ( groups & ( 1u << g ) && p_source->counts[g] < vertex_encodings[g].min_count ) goto missing_properties;
+
+    // Find the box around the positions. Every axis is scaled by the longest, so positions dequantize with a uniform scale
+    if ( groups & VERTEX_GROUP_GEOMETRIC && vertex_count )
+    {
+
+        // Initialized data
+        float hi[3] = { -INFINITY, -INFINITY, -INFINITY };
+
+        lo[0] = lo[1] = lo[2] = INFINITY,
+        scale = 0;
+
+        for (size_t v = 0; v < vertex_count; v++)
+            for (size_t j = 0; j < 3; j++)
+            {
+
+                // Initialized data
+                float p = vertex_property(vertices + v * vertex_stride, p_source, 0, j);
+
+                lo[j] = ( p < lo[j] ) ? p : lo[j],
+                hi[j] = ( p > hi[j] ) ? p : hi[j];
+            }
+
+        for (size_t j = 0; j < 3; j++)
+            scale = ( hi[j] - lo[j] > scale ) ? hi[j] - lo[j] : scale;
+
+        // A single point
+        if ( scale == 0 ) scale = 1;
+    }
+
+    *p_dequantize = (vec4) { .x = lo[0], .y = lo[1], .z = lo[2], .w = scale };
+
+    // Encode each vertex
+    for (size_t v = 0; v < vertex_count; v++)
+    {
+
+        // Initialized data
+        const u8 *p_vertex = vertices + v * vertex_stride;
+        u8       *p_out    = quantized + v * stride;
+
+        // Positions
+        if ( groups & VERTEX_GROUP_GEOMETRIC )
+        {
+
+            // Initialized data
+            u16 q[4] = { 0 };
+
+            for (size_t j = 0; j < 3; j++)
+                q[j] = (u16) lrintf(clamp_float(( vertex_property(p_vertex, p_source, 0, j) - lo[j] ) / scale, 0.f, 1.f) * 65535.f);
+
+            memcpy(p_out, q, sizeof(q));
+
+            p_out += sizeof(q);
+        }
+
+        // Texture coordinates
+        if ( groups & VERTEX_GROUP_TEXTURE )
+        {
+
+            // Initialized data
+            u16 h[2] = { float_to_half(vertex_property(p_vertex, p_source, 1, 0)), float_to_half(vertex_property(p_vertex, p_source, 1, 1)) };
+
+            memcpy(p_out, h, sizeof(h));
+
+            p_out += sizeof(h);
+        }
+
+        // Normals, bitangents, and tangents
+        for (size_t g = 2; g < 5; g++)
+        {
+            if ( groups & ( 1u << g ) )
+            {
+                encode_octahedral(vertex_property(p_vertex, p_source, g, 0), vertex_property(p_vertex, p_source, g, 1), vertex_property(p_vertex, p_source, g, 2), p_out);
+
+                p_out += 4;
+            }
+        }
+
+        // Colors. Opaque, when there is no alpha
+        if ( groups & VERTEX_GROUP_COLOR )
+        {
+            for (size_t j = 0; j < 4; j++)
+                p_out[j] = ( j < p_source->counts[5] ) ? (u8) lrintf(clamp_float(vertex_property(p_vertex, p_source, 5, j), 0.f, 1.f) * 255.f) : 255;
+
+            p_out += 4;
+        }
+
+        // Bone groups
+        if ( groups & VERTEX_GROUP_BONES )
+        {
+            for (size_t j = 0; j < 4; j++)
+                p_out[j] = (u8) lrintf(clamp_float(vertex_property(p_vertex, p_source, 6, j), 0.f, 255.f));
+
+            p_out += 4;
+        }
+
+        // Bone weights, rounded so they still sum to one
+        if ( groups & VERTEX_GROUP_WEIGHTS )
+        {
+
+            // Initialized data
+            float  w[4]    = { 0 },
+                   sum     = 0;
+            int    total   = 0;
+            size_t largest = 0;
+
+            for (size_t j = 0; j < 4; j++)
+            {
+                w[j]  = clamp_float(vertex_property(p_vertex, p_source, 7, j), 0.f, 1.f),
+                sum  += w[j];
+
+                if ( w[j] > w[largest] ) largest = j;
+            }
+
+            for (size_t j = 0; j < 4; j++)
+            {
+                p_out[j]  = ( sum > 0 ) ? (u8) lrintf(w[j] / sum * 255.f) : 0,
+                total    += p_out[j];
+            }
+
+            // Give what rounding lost, or took, to the largest weight
+            if ( sum > 0 ) p_out[largest] = (u8) ( p_out[largest] + 255 - total );
+
+            p_out += 4;
+        }
+    }
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_groups:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Vertex] Parameter \"groups\" must have at least one vertex group in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_source:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Vertex] Null pointer provided for parameter \"p_source\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_vertices:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Vertex] Null pointer provided for parameter \"p_vertices\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_quantized:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Vertex] Null pointer provided for parameter \"p_quantized\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_dequantize:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Vertex] Null pointer provided for parameter \"p_dequantize\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // G10 errors
+        {
+            missing_properties:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Vertex] A vertex group is missing properties in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+u32 get_vertex_group ( const char *name )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( name == (void *) 0 ) goto no_name;
+    #endif
+
+    // Find the group by name
+    for (size_t g = 0; g < VERTEX_GROUP_COUNT; g++)
+        if ( strcmp(name, vertex_encodings[g].name) == 0 )
+            return 1u << g;
+
+    // Not a vertex group
+    return 0;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_name:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Vertex] Null pointer provided for parameter \"name\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+size_t quantized_vertex_stride ( u32 groups )
+{
+
+    // Initialized data
+    size_t stride = 0;
+
+    for (size_t g = 0; g < VERTEX_GROUP_COUNT; g++)
+        if ( groups & ( 1u << g ) )
+            stride += vertex_encodings[g].size;
+
+    return stride;
+}
+
+u32 quantized_vertex_input ( u32 groups, VkVertexInputBindingDescription *p_binding, VkVertexInputAttributeDescription *p_attributes )
+{
+
+    // Argument check
+    #ifndef NDEBUG
+        if ( p_binding    == (void *) 0 ) goto no_binding;
+        if ( p_attributes == (void *) 0 ) goto no_attributes;
+    #endif
+
+    // Initialized data
+    u32 count  = 0,
+        offset = 0;
+
+    // One attribute for each group, in bit order
+    for (size_t g = 0; g < VERTEX_GROUP_COUNT; g++)
+    {
+        if ( groups & ( 1u << g ) )
+        {
+            p_attributes[count] = (VkVertexInputAttributeDescription)
+            {
+                .binding  = 0,
+                .location = count,
+                .format   = vertex_encodings[g].format,
+                .offset   = offset
+            };
+
+            offset += vertex_encodings[g].size,
+            count++;
+        }
+    }
+
+    *p_binding = (VkVertexInputBindingDescription)
+    {
+        .binding   = 0,
+        .inputRate = VK_VERTEX_INPUT_RATE_VERTEX,
+        .stride    = offset
+    };
+
+    // Success
+    return count;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_binding:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Vertex] Null pointer provided for parameter \"p_binding\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_attributes:
+                #ifndef NDEBUG
+                    g_print_error("[G10] [Vertex] Null pointer provided for parameter \"p_attributes\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
@@ -19,6 +19,7 @@
 #define BUILD_G10_WITH_SDL_NET
 //#define BUILD_G10_WITH_DISCORD
 //#define BUILD_G10_WITH_FMOD
+//#define BUILD_G10_WITH_ALLOC_TRACKING
 
 // Standard library
 #include <stdio.h>
@@ -57,7 +58,16 @@
 
 // G10
 #include <G10/GXtypedef.h>
+#include <G10/GXHandle.h>
+#include <G10/GXArena.h>
+#include <G10/GXPool.h>
+#include <G10/GXScratch.h>
+#include <G10/GXStats.h>
+#include <G10/GXAlloc.h>
 #include <G10/GXScene.h>
+#include <G10/GXPrefab.h>
+#include <G10/GXSnapshot.h>
+#include <G10/GXAsset.h>
 #include <G10/GXRenderer.h>
 #include <G10/GXInput.h>
 #include <G10/GXScheduler.h>
@@ -113,9 +123,49 @@
     #define JSON_REALLOC(p, sz) realloc(p, sz)
 #endif
 
-// Memory management macro
-#ifndef G10_REALLOC
-#define G10_REALLOC(p, sz) realloc(p,sz)
+// Memory management macros. Define G10_REALLOC, G10_TAGGED_REALLOC, and G10_FREE together
+#ifndef G10_ALLOC_TAG
+#define G10_ALLOC_TAG alloc_tag_core
+#endif
+
+#ifdef BUILD_G10_WITH_ALLOC_TRACKING
+    #ifndef G10_REALLOC
+    #define G10_REALLOC(p, sz) alloc_realloc(p, sz, G10_ALLOC_TAG, __FILE__, __LINE__)
+    #endif
+
+    #ifndef G10_TAGGED_REALLOC
+    #define G10_TAGGED_REALLOC(p, sz, tag) alloc_realloc(p, sz, tag, __FILE__, __LINE__)
+    #endif
+
+    #ifndef G10_FREE
+    #define G10_FREE(p) alloc_free(p)
+    #endif
+#else
+    #ifndef G10_REALLOC
+    #define G10_REALLOC(p, sz) realloc(p,sz)
+    #endif
+
+    #ifndef G10_TAGGED_REALLOC
+    #define G10_TAGGED_REALLOC(p, sz, tag) realloc(p, sz)
+    #endif
+
+    #ifndef G10_FREE
+    #define G10_FREE(p) free(p)
+    #endif
+#endif
+
+// Pool allocation macros. Define both as calloc(1, sz) and free(p) to bypass the pools
+#ifndef G10_POOL_ALLOC
+#define G10_POOL_ALLOC(pp_pool, sz) pool_alloc(get_pool(pp_pool, sz))
+#endif
+
+#ifndef G10_POOL_FREE
+#define G10_POOL_FREE(pp_pool, p) pool_free(*(pp_pool), p)
+#endif
+
+// Statistics macro. Define as nothing to stop counting
+#ifndef G10_STAT_ADD
+#define G10_STAT_ADD(stat, n) stats_add(stat, n)
 #endif
 
 // Structures
@@ -244,21 +294,38 @@ struct GXInstance_s
         dict *parts,
              *materials,
              *shaders,
-             *ais;
+             *ais,
+             *prefabs;
+
+        // A handle for each cached part, material, shader, and ai
+        GXHandleTable_t *part_handles,
+                        *material_handles,
+                        *shader_handles,
+                        *ai_handles;
+
+        // Names being loaded into each cache
+        dict *loading_parts,
+             *loading_shaders,
+             *loading_ais;
     } cache;
 
     // Queues
     struct
     {
         queue *load_entity,
-              *load_light_probe,
-              *actor_move,
-              *actor_collision,
-              *actor_force,
-              *ai_preupdate,
-              *ai_update;
+              *load_light_probe;
     } queues;
 
+    // Cursors into the active scene's work lists. Rewound by copy_state every frame
+    struct
+    {
+        size_t actor_move,
+               actor_collision,
+               actor_force,
+               ai_preupdate,
+               ai_update;
+    } cursors;
+
     // Mutexes
     struct
     {
@@ -267,6 +334,7 @@ struct GXInstance_s
                   *part_cache,
                   *ai_cache,
                   *material_cache,
+                  *prefab_cache,
                   *move_object,
                   *update_force,
                   *resolve_collision,
@@ -337,6 +405,18 @@ struct GXInstance_s
  */
 DLLEXPORT int g_init ( GXInstance_t **pp_instance, const char *path );
 
+/** !
+ *  Construct a G10 instance without a window, renderer, or GPU. Only the
+ *  timer and physics subsystems are initialized. Used by tools and benchmarks.
+ *
+ * @param pp_instance : return
+ *
+ * @sa g_init
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int g_init_headless ( GXInstance_t **pp_instance );
+
 /** !
  * TODO: DOCUMENT
  *  Create a Vulkan buffer
@@ -516,6 +596,18 @@ DLLEXPORT int g_cache_shader ( GXInstance_t *p_instance, GXShader_t *p_shader );
  */
 DLLEXPORT int g_cache_ai ( GXInstance_t *p_instance, GXAI_t *p_ai );
 
+/** !
+ * Cache a prefab. Caching a prefab adds it to the garbage collector.
+ *
+ * @param p_instance : The active instance
+ * @param p_prefab   : A pointer to a prefab
+ *
+ * @sa g_find_prefab
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int g_cache_prefab ( GXInstance_t *p_instance, GXPrefab_t *p_prefab );
+
 /** !
  * Search the cache for a material. Caching a material adds it to the garbage collector.
  *
@@ -572,6 +664,156 @@ DLLEXPORT GXShader_t *g_find_shader ( GXInstance_t *p_instance, char *name );
  */
 DLLEXPORT GXAI_t *g_find_ai ( GXInstance_t *p_instance, char *name );
 
+/** !
+ * Search the cache for a prefab. Prefabs loaded from a file are found by path
+ *
+ * @param p_instance : The active instance
+ * @param name       : The name of the prefab
+ *
+ * @sa g_cache_prefab
+ *
+ * @return the prefab, or 0 if it is not cached
+ */
+DLLEXPORT GXPrefab_t *g_find_prefab ( GXInstance_t *p_instance, char *name );
+
+/** !
+ * Search the cache for a part, or claim the right to load it. While one
+ * thread loads a part, other threads asking for the same name wait for it,
+ * and threads asking for other names are not blocked. A found part counts the
+ * caller as a user
+ *
+ * @param p_instance : The active instance
+ * @param name       : The name of the part
+ *
+ * @sa g_settle_part
+ *
+ * @return the cached part, or 0 if the caller must load it, and call g_settle_part
+ */
+DLLEXPORT GXPart_t *g_claim_part ( GXInstance_t *p_instance, char *name );
+
+/** !
+ * Finish a load claimed with g_claim_part. The part is cached, and the
+ * threads waiting for it are woken. If the load failed, a waiting thread
+ * claims it
+ *
+ * @param p_instance : The active instance
+ * @param name       : The name the load was claimed with
+ * @param p_part     : The loaded part, or 0 if it failed to load
+ *
+ * @sa g_claim_part
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int g_settle_part ( GXInstance_t *p_instance, char *name, GXPart_t *p_part );
+
+/** !
+ * Search the cache for a shader, or claim the right to load it. While one
+ * thread loads a shader, other threads asking for the same name wait for it,
+ * and threads asking for other names are not blocked. A found shader counts the
+ * caller as a user
+ *
+ * @param p_instance : The active instance
+ * @param name       : The name of the shader
+ *
+ * @sa g_settle_shader
+ *
+ * @return the cached shader, or 0 if the caller must load it, and call g_settle_shader
+ */
+DLLEXPORT GXShader_t *g_claim_shader ( GXInstance_t *p_instance, char *name );
+
+/** !
+ * Finish a load claimed with g_claim_shader. The shader is cached, and the
+ * threads waiting for it are woken. If the load failed, a waiting thread
+ * claims it
+ *
+ * @param p_instance : The active instance
+ * @param name       : The name the load was claimed with
+ * @param p_shader   : The loaded shader, or 0 if it failed to load
+ *
+ * @sa g_claim_shader
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int g_settle_shader ( GXInstance_t *p_instance, char *name, GXShader_t *p_shader );
+
+/** !
+ * Search the cache for an AI, or claim the right to load it. While one
+ * thread loads an AI, other threads asking for the same name wait for it,
+ * and threads asking for other names are not blocked
+ *
+ * @param p_instance : The active instance
+ * @param name       : The name of the AI
+ *
+ * @sa g_settle_ai
+ *
+ * @return the cached AI, or 0 if the caller must load it, and call g_settle_ai
+ */
+DLLEXPORT GXAI_t *g_claim_ai ( GXInstance_t *p_instance, char *name );
+
+/** !
+ * Finish a load claimed with g_claim_ai. The AI is cached, and the
+ * threads waiting for it are woken. If the load failed, a waiting thread
+ * claims it
+ *
+ * @param p_instance : The active instance
+ * @param name       : The name the load was claimed with
+ * @param p_ai       : The loaded AI, or 0 if it failed to load
+ *
+ * @sa g_claim_ai
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int g_settle_ai ( GXInstance_t *p_instance, char *name, GXAI_t *p_ai );
+
+/** !
+ * Get a cached material from its handle. Resolve names to handles once, with
+ * g_find_material, and use handles after that
+ *
+ * @param p_instance : The active instance
+ * @param handle     : The handle of the material
+ *
+ * @sa g_find_material
+ *
+ * @return the material, or 0 if the handle is stale
+ */
+DLLEXPORT GXMaterial_t *g_get_material ( GXInstance_t *p_instance, handle_t handle );
+
+/** !
+ * Get a cached part from its handle
+ *
+ * @param p_instance : The active instance
+ * @param handle     : The handle of the part
+ *
+ * @sa g_find_part
+ *
+ * @return the part, or 0 if the handle is stale
+ */
+DLLEXPORT GXPart_t *g_get_part ( GXInstance_t *p_instance, handle_t handle );
+
+/** !
+ * Get a cached shader from its handle
+ *
+ * @param p_instance : The active instance
+ * @param handle     : The handle of the shader
+ *
+ * @sa g_find_shader
+ *
+ * @return the shader, or 0 if the handle is stale
+ */
+DLLEXPORT GXShader_t *g_get_shader ( GXInstance_t *p_instance, handle_t handle );
+
+/** !
+ * Get a cached ai from its handle
+ *
+ * @param p_instance : The active instance
+ * @param handle     : The handle of the ai
+ *
+ * @sa g_find_ai
+ *
+ * @return the ai, or 0 if the handle is stale
+ */
+DLLEXPORT GXAI_t *g_get_ai ( GXInstance_t *p_instance, handle_t handle );
+
 // User operations
 /** !
  * The user calls this function to exit the game
@@ -31,6 +31,12 @@ struct GXAI_s
 	dict    *states;
 	int    (*pre_ai)(GXEntity_t* p_entity);
 	size_t   users;
+	handle_t handle;
+
+	// The AI this AI was copied from, or null. A copy borrows the name of its
+	// source, and shares its states until it adds a state callback
+	GXAI_t  *source;
+	bool     shared_states;
 };
 
 // Allocators
@@ -87,7 +93,8 @@ DLLEXPORT int load_ai_as_json_value ( GXAI_t **pp_ai, JSONValue_t *p_value );
 
 
 /** !
- *  Load an AI from JSON text
+ *  Copy an AI. The copy borrows the name and states of the AI, so the AI must
+ *  outlive the copy
  *
  * @param pp_ai : return
  * @param p_ai  : pointer to ai to copy
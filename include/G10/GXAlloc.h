@@ -0,0 +1,168 @@
+/** !
+ * @file G10/GXAlloc.h
+ * @author Jacob Smith
+ *
+ * Allocation tracking. When G10 is built with BUILD_G10_WITH_ALLOC_TRACKING,
+ * G10_REALLOC and G10_FREE route through alloc_realloc and alloc_free, which
+ * put a small header in front of each allocation. The header remembers the
+ * size, the subsystem, and the call site of the allocation.
+ *
+ * Each thread counts its own allocations and frees in counters that no other
+ * thread writes, so counting takes no lock. Live bytes are the sum of every
+ * thread's counters. The peak is sampled at the end of each frame, and when
+ * the statistics are read.
+ *
+ * A translation unit picks its subsystem by defining G10_ALLOC_TAG before it
+ * includes any G10 header. G10_TAGGED_REALLOC tags a single allocation.
+ *
+ * Memory from G10_REALLOC must be freed with G10_FREE, never with free.
+ */
+
+// Include guard
+#pragma once
+
+// Standard library
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// G10
+#include <G10/GXtypedef.h>
+#include <G10/G10.h>
+
+// The number of threads with counters of their own. Threads past this share the last counters
+#define ALLOC_THREAD_MAX 64
+
+// The number of call sites that are tracked. Sites past this are counted together
+#define ALLOC_SITE_MAX   1024
+
+enum alloc_tag_e
+{
+    alloc_tag_core     = 0,
+    alloc_tag_scene    = 1,
+    alloc_tag_renderer = 2,
+    alloc_tag_physics  = 3,
+    alloc_tag_network  = 4,
+    alloc_tag_json     = 5,
+    alloc_tag_count    = 6
+};
+typedef enum alloc_tag_e alloc_tag_t;
+
+struct GXAllocStats_s
+{
+
+	// Allocations that have not been freed
+	size_t live_count,
+	       live_bytes,
+	       peak_bytes;
+
+	// Allocations since the start of the session
+	size_t total_count,
+	       total_bytes;
+
+	// Allocations during the last frame, and the most bytes allocated in one frame
+	size_t frame_count,
+	       frame_bytes,
+	       peak_frame_bytes;
+};
+
+struct GXAllocSite_s
+{
+
+	// Where the allocation was made
+	const char  *file;
+	int          line;
+	alloc_tag_t  tag;
+
+	// Allocations since the start of the session
+	size_t       total_count,
+	             total_bytes;
+
+	// Allocations that have not been freed
+	size_t       live_count,
+	             live_bytes;
+};
+
+// Allocators
+/** !
+ *  Allocate, grow, or shrink tracked memory. Behaves like realloc
+ *
+ * @param p    : tracked memory, or null pointer to allocate
+ * @param size : the new size in bytes
+ * @param tag  : the subsystem making the allocation
+ * @param file : the file of the call site
+ * @param line : the line of the call site
+ *
+ * @sa alloc_free
+ *
+ * @return pointer to memory on success, 0 on error
+ */
+DLLEXPORT void *alloc_realloc ( void *p, size_t size, alloc_tag_t tag, const char *file, int line );
+
+// Mutators
+/** !
+ *  Mark the end of a frame. Called once a frame by the main thread
+ *
+ * @sa get_alloc_stats
+ */
+DLLEXPORT void alloc_end_frame ( void );
+
+// Getters
+/** !
+ *  Get the allocation statistics of a subsystem
+ *
+ * @param tag     : the subsystem, or alloc_tag_count for every subsystem
+ * @param p_stats : return
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int get_alloc_stats ( alloc_tag_t tag, GXAllocStats_t *p_stats );
+
+/** !
+ *  Get the call sites that allocated the most bytes
+ *
+ * @param p_sites : return
+ * @param max     : the most sites to return
+ *
+ * @return the number of sites written to p_sites
+ */
+DLLEXPORT size_t get_alloc_sites ( GXAllocSite_t *p_sites, size_t max );
+
+/** !
+ *  Get the name of a subsystem
+ *
+ * @param tag : the subsystem
+ *
+ * @return the name, or 0 if tag is out of range
+ */
+DLLEXPORT const char *get_alloc_tag_name ( alloc_tag_t tag );
+
+// Info
+/** !
+ *  Print the statistics of each subsystem, and the call sites that allocated the most bytes
+ *
+ * @sa alloc_leaks
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int alloc_info ( void );
+
+/** !
+ *  Print each call site with allocations that have not been freed
+ *
+ * @sa alloc_info
+ *
+ * @return the number of allocations that have not been freed
+ */
+DLLEXPORT size_t alloc_leaks ( void );
+
+// Destructors
+/** !
+ *  Free tracked memory
+ *
+ * @param p : tracked memory, or null pointer
+ *
+ * @sa alloc_realloc
+ */
+DLLEXPORT void alloc_free ( void *p );
@@ -0,0 +1,221 @@
+/** !
+ * @file G10/GXArchetype.h
+ * @author Jacob Smith
+ *
+ * Archetype component storage. Entities with the same set of components
+ * share an archetype, and each archetype groups its entities into fixed size
+ * chunks. A chunk holds pointers to the components of its entities, not the
+ * components themselves, and is walked by snapshots. Systems that run once
+ * per entity take their entities from persistent work lists, which only
+ * change when a change log is applied.
+ */
+
+// Include guard
+#pragma once
+
+// Standard library
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Components
+#define COMPONENT_TRANSFORM 0x1
+#define COMPONENT_RIGIDBODY 0x2
+#define COMPONENT_COLLIDER  0x4
+#define COMPONENT_AI        0x8
+
+// Number of component types, and of possible archetypes
+#define COMPONENT_COUNT 4
+#define ARCHETYPE_COUNT ( 1 << COMPONENT_COUNT )
+
+// Entities per chunk
+#define ARCHETYPE_CHUNK_CAPACITY 128
+
+// Work lists
+#define WORK_LIST_ACTORS 0 // Entities with rigidbodies
+#define WORK_LIST_AIS    1 // Entities with AIs
+#define WORK_LIST_COUNT  2
+
+// G10
+#include <G10/GXtypedef.h>
+#include <G10/G10.h>
+#include <G10/GXHandle.h>
+
+struct GXArchetypeChunk_s
+{
+
+	// The archetype that owns this chunk
+	GXArchetype_t *archetype;
+
+	// Rows in use. Only the last chunk of an archetype is partly full
+	size_t         count;
+
+	// One column of component pointers per component. Row i of each column belongs to entities[i]
+	GXEntity_t    *entities    [ARCHETYPE_CHUNK_CAPACITY];
+	GXTransform_t *transforms  [ARCHETYPE_CHUNK_CAPACITY];
+	GXRigidbody_t *rigidbodies [ARCHETYPE_CHUNK_CAPACITY];
+	GXCollider_t  *colliders   [ARCHETYPE_CHUNK_CAPACITY];
+	GXAI_t        *ais         [ARCHETYPE_CHUNK_CAPACITY];
+};
+
+struct GXArchetype_s
+{
+
+	// The storage that owns this archetype
+	GXComponentStorage_t  *storage;
+
+	// The components every entity of this archetype has
+	u32                    components;
+
+	// Chunks
+	GXArchetypeChunk_t   **chunks;
+	size_t                 chunk_count,
+	                       chunk_max;
+
+	// Entities in every chunk
+	size_t                 entity_count;
+};
+
+struct GXWorkList_s
+{
+
+	// The components every entity in the list has
+	u32          components;
+
+	// Entities, in no particular order
+	GXEntity_t **entities;
+	size_t       count,
+	             max;
+};
+
+struct GXComponentStorage_s
+{
+
+	// One archetype per set of components, allocated on first use
+	GXArchetype_t   *archetypes[ARCHETYPE_COUNT];
+
+	// Entities in every archetype
+	size_t           entity_count;
+
+	// A handle for each stored entity
+	GXHandleTable_t *handles;
+
+	// Persistent lists of entities for each system
+	GXWorkList_t     work_lists[WORK_LIST_COUNT];
+
+	// Handles of entities added or moved between archetypes since the work lists were last updated
+	handle_t        *changes;
+	size_t           change_count,
+	                 change_max;
+};
+
+// Allocators
+/** !
+ *  Allocate memory for component storage
+ *
+ * @param pp_storage : return
+ *
+ * @sa destroy_component_storage
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int create_component_storage ( GXComponentStorage_t **pp_storage );
+
+// Mutators
+/** !
+ *  Add an entity to the archetype of its components, and give it a handle. The
+ *  entity joins the work lists on the next apply_component_changes
+ *
+ * @param p_storage : the component storage
+ * @param p_entity  : the entity
+ *
+ * @sa update_entity_components
+ * @sa remove_entity_components
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int add_entity_components ( GXComponentStorage_t *p_storage, GXEntity_t *p_entity );
+
+/** !
+ *  Call after adding, removing, or replacing a component of an entity. Moves
+ *  the entity to the archetype of its new components. The work lists catch up
+ *  on the next apply_component_changes
+ *
+ * @param p_entity : the entity
+ *
+ * @sa add_entity_components
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int update_entity_components ( GXEntity_t *p_entity );
+
+/** !
+ *  Remove an entity from its archetype and from every work list, and release
+ *  its handle. The last entity of the archetype takes its place
+ *
+ * @param p_entity : the entity
+ *
+ * @sa add_entity_components
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int remove_entity_components ( GXEntity_t *p_entity );
+
+/** !
+ *  Bring the work lists up to date with every entity added or moved between
+ *  archetypes since the last call. Call once a frame. Costs nothing when no
+ *  entity changed
+ *
+ * @param p_storage : the component storage
+ *
+ * @sa next_work_item
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int apply_component_changes ( GXComponentStorage_t *p_storage );
+
+/** !
+ *  Get the next entity of a pass over a work list
+ *
+ * @param p_work_list : the work list
+ * @param p_cursor    : the position of the pass. Set to 0 to start a new pass
+ *
+ * @sa apply_component_changes
+ *
+ * @return the next entity, or null at the end of the list
+ */
+DLLEXPORT GXEntity_t *next_work_item ( GXWorkList_t *p_work_list, size_t *p_cursor );
+
+// Getters
+/** !
+ *  Get the components of an entity
+ *
+ * @param p_entity : the entity
+ *
+ * @return a mask of COMPONENT_ flags
+ */
+DLLEXPORT u32 entity_components ( GXEntity_t *p_entity );
+
+/** !
+ *  Get a stored entity from its handle
+ *
+ * @param p_storage : the component storage
+ * @param handle    : the handle of the entity
+ *
+ * @sa add_entity_components
+ *
+ * @return the entity, or null if the handle is stale
+ */
+DLLEXPORT GXEntity_t *resolve_entity ( GXComponentStorage_t *p_storage, handle_t handle );
+
+// Destructors
+/** !
+ *  Free component storage. The entities are not freed, and their handles go stale
+ *
+ * @param pp_storage : pointer to component storage
+ *
+ * @sa create_component_storage
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int destroy_component_storage ( GXComponentStorage_t **pp_storage );
@@ -0,0 +1,176 @@
+/** !
+ * @file G10/GXArena.h
+ * @author Jacob Smith
+ *
+ * Block based arena allocator. Allocations are carved out of large blocks, and
+ * are only ever freed all at once, when the arena is destroyed. Each thread
+ * carves from a block of its own, so loading threads allocate without taking
+ * a lock.
+ *
+ * Code that makes objects with the lifetime of a scene allocates them with
+ * arena_calloc, which draws from the arena bound to the calling thread, and
+ * frees them with arena_free, which ignores memory that belongs to an arena.
+ */
+
+// Include guard
+#pragma once
+
+// Standard library
+#include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// G10
+#include <G10/GXtypedef.h>
+#include <G10/G10.h>
+
+// Default size of a block
+#define ARENA_BLOCK_SIZE ( 64 * 1024 )
+
+// Alignment of every allocation
+#define ARENA_ALIGNMENT 16
+
+// Blocks start on, and cover whole, windows of this many address bits. An
+// address belongs to an arena exactly when its window does
+#define ARENA_WINDOW_SHIFT 16
+#define ARENA_WINDOW_SIZE  ( (size_t) 1 << ARENA_WINDOW_SHIFT )
+
+struct GXArenaBlock_s
+{
+
+	// The next block of the arena
+	GXArenaBlock_t *next;
+
+	// Bytes of data, and bytes of data in use
+	size_t          size,
+	                used;
+
+	// Data
+	G10_ALIGN(ARENA_ALIGNMENT) u8 data[];
+};
+
+struct GXArena_s
+{
+
+	// Every block of the arena
+	GXArenaBlock_t *blocks;
+	size_t          block_size,
+	                block_count;
+
+	// Bytes handed out by arena_alloc
+	size_t          used;
+
+	// Distinguishes this arena from an earlier arena at the same address
+	u64             id;
+
+	// Guards the block list
+	SDL_SpinLock    lock;
+};
+
+// Allocators
+/** !
+ *  Allocate memory for an arena
+ *
+ * @param pp_arena   : return
+ * @param block_size : the size of each block in bytes, or 0 for ARENA_BLOCK_SIZE
+ *
+ * @sa destroy_arena
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int create_arena ( GXArena_t **pp_arena, size_t block_size );
+
+// Mutators
+/** !
+ *  Allocate zeroed memory from an arena. Safe to call from many threads at once
+ *
+ * @param p_arena : the arena
+ * @param size    : the size of the allocation in bytes
+ *
+ * @sa arena_calloc
+ *
+ * @return a pointer aligned to ARENA_ALIGNMENT on success, 0 on error
+ */
+DLLEXPORT void *arena_alloc ( GXArena_t *p_arena, size_t size );
+
+/** !
+ *  Bind an arena to the calling thread. arena_calloc draws from the bound arena
+ *
+ * @param p_arena : the arena, or null to allocate from the heap
+ *
+ * @sa get_thread_arena
+ *
+ * @return the arena that was bound before
+ */
+DLLEXPORT GXArena_t *set_thread_arena ( GXArena_t *p_arena );
+
+/** !
+ *  Allocate zeroed memory from the arena bound to the calling thread, or from
+ *  the heap if none is bound. Never realloc the result
+ *
+ * @param count : the number of elements
+ * @param size  : the size of each element in bytes
+ *
+ * @sa arena_free
+ * @sa set_thread_arena
+ *
+ * @return a pointer on success, 0 on error
+ */
+DLLEXPORT void *arena_calloc ( size_t count, size_t size );
+
+/** !
+ *  Free memory from arena_calloc. Memory that belongs to an arena is left for
+ *  destroy_arena
+ *
+ * @param p : the memory, or null
+ *
+ * @sa arena_calloc
+ */
+DLLEXPORT void arena_free ( void *p );
+
+// Getters
+/** !
+ *  Get the arena bound to the calling thread
+ *
+ * @sa set_thread_arena
+ *
+ * @return the arena, or null
+ */
+DLLEXPORT GXArena_t *get_thread_arena ( void );
+
+// Queries
+/** !
+ *  Test if memory belongs to an arena
+ *
+ * @param p_arena : the arena
+ * @param p       : the memory
+ *
+ * @return true if p points into a block of the arena else false
+ */
+DLLEXPORT bool arena_owns ( GXArena_t *p_arena, void *p );
+
+/** !
+ *  Test if memory belongs to any live arena. Looks up the window of the
+ *  address, so it takes constant time, and no lock
+ *
+ * @param p : the memory
+ *
+ * @sa arena_owns
+ *
+ * @return true if p points into a block of a live arena else false
+ */
+DLLEXPORT bool arena_owned ( void *p );
+
+// Destructors
+/** !
+ *  Free an arena, and every allocation made from it
+ *
+ * @param pp_arena : pointer to arena
+ *
+ * @sa create_arena
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int destroy_arena ( GXArena_t **pp_arena );
@@ -0,0 +1,199 @@
+/** !
+ * @file G10/GXAsset.h
+ * @author Jacob Smith
+ *
+ * The asset pipeline. Parts and shader modules are loaded in three stages. A
+ * small pool of IO threads reads files, a pool of decode threads turns them
+ * into what the GPU reads, and a single upload thread creates the Vulkan
+ * objects. Each stage works on the next request while the
+ * following stage works on the last one, so loading many assets takes as long
+ * as the slowest stage, instead of the sum of all three.
+ *
+ * A request returns an asset, which is a future. Requests are taken in order
+ * of priority, then in the order they were made. A request for a file that is
+ * already requested returns the same asset, and raises its priority.
+ *
+ * Callbacks run once the asset is loaded or has failed, on the thread that
+ * finished it. Callbacks run one at a time, with the pipeline locked, so a
+ * callback may request and release assets, but must never wait for one. A
+ * callback takes the result by copying it out of the asset, and zeroing it.
+ * Results that no callback took are destroyed with the asset.
+ */
+
+// Include guard
+#pragma once
+
+// Standard library
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// SDL
+#include <SDL.h>
+
+// Vulkan
+#include <vulkan/vulkan.h>
+
+// G10
+#include <G10/GXtypedef.h>
+#include <G10/G10.h>
+
+// The number of threads that read files
+#define ASSET_IO_THREADS 2
+
+enum asset_type_e
+{
+    asset_type_part           = 0,
+    asset_type_shader_module  = 1,
+    asset_type_quantized_part = 2,
+    asset_type_count          = 3
+};
+typedef enum asset_type_e asset_type_t;
+
+enum asset_state_e
+{
+    asset_state_read      = 0,
+    asset_state_reading   = 1,
+    asset_state_decode    = 2,
+    asset_state_decoding  = 3,
+    asset_state_upload    = 4,
+    asset_state_uploading = 5,
+    asset_state_done      = 6,
+    asset_state_failed    = 7
+};
+typedef enum asset_state_e asset_state_t;
+
+struct GXAsset_s
+{
+
+	// The file, and what is in it
+	char           *path;
+	asset_type_t    type;
+
+	// Where the asset is in the pipeline, and the order it is taken in
+	asset_state_t   state;
+	i32             priority;
+	u64             sequence;
+
+	// Held by each request, and by each queue the asset is waiting in
+	size_t          references;
+
+	// What the stages hand to each other
+	u8             *data;
+	size_t          size;
+	void           *p_decoded;
+
+	// Results
+	union
+	{
+		struct
+		{
+			VkBuffer        vertex_buffer,
+			                element_buffer;
+			VkDeviceMemory  vertex_buffer_memory,
+			                element_buffer_memory;
+			size_t          vertex_count,
+			                index_count;
+			u32             vertex_groups;
+			vec4            dequantize;
+		} part;
+
+		VkShaderModule shader_module;
+	};
+
+	// Seconds spent in each stage
+	double          read_time,
+	                decode_time,
+	                upload_time;
+
+	// Called when the asset is finished
+	struct asset_callback_s
+	{
+		void (*pfn_callback)(GXAsset_t *p_asset, void *p_user);
+		void  *p_user;
+	}              *callbacks;
+	size_t          callback_count,
+	                callback_max;
+
+	// Set after every callback has run
+	bool            settled;
+};
+
+// Constructors
+/** !
+ *  Request an asset. If the file is already requested, the same asset is
+ *  returned, its priority is raised, and the callback is added to it
+ *
+ * @param pp_asset     : return
+ * @param type         : the type of asset in the file
+ * @param path         : the path to the file
+ * @param priority     : higher priorities are loaded first
+ * @param pfn_callback : called when the asset is finished, or null pointer
+ * @param p_user       : passed to the callback
+ *
+ * @sa release_asset
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int request_asset ( GXAsset_t **pp_asset, asset_type_t type, const char *path, i32 priority, void (*pfn_callback)(GXAsset_t *p_asset, void *p_user), void *p_user );
+
+// Mutators
+/** !
+ *  Block until an asset is finished, and its callbacks have run
+ *
+ * @param p_asset : the asset
+ *
+ * @sa wait_assets
+ *
+ * @return 1 if the asset loaded, 0 if it failed
+ */
+DLLEXPORT int wait_asset ( GXAsset_t *p_asset );
+
+/** !
+ *  Block until every requested asset is finished, and its callbacks have run
+ *
+ * @sa wait_asset
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int wait_assets ( void );
+
+// Getters
+/** !
+ *  Get the state of an asset
+ *
+ * @param p_asset : the asset
+ *
+ * @return the state of the asset
+ */
+DLLEXPORT asset_state_t get_asset_state ( GXAsset_t *p_asset );
+
+// Info
+/** !
+ *  Print the number of requests waiting at each stage, and the time each
+ *  stage has spent working
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int asset_info ( void );
+
+// Destructors
+/** !
+ *  Release a request for an asset. An asset that is still loading keeps
+ *  loading, and its callbacks still run
+ *
+ * @param pp_asset : pointer to asset
+ *
+ * @sa request_asset
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int release_asset ( GXAsset_t **pp_asset );
+
+/** !
+ *  Stop the threads of the asset pipeline. Requests that have not started a
+ *  stage are failed
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int stop_assets ( void );
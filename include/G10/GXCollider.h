@@ -75,6 +75,16 @@ struct GXCollider_s
         vec3   *convex_hull;
         size_t  convex_hull_count;
     } convex_hull;
+
+    struct {
+
+        // Radius in model space. 0 fits the sphere inside the bounding box
+        float radius;
+    } sphere;
+
+    // The collider this collider was stamped from, or null. A stamped collider
+    // borrows the convex hull and the callbacks of its source
+    GXCollider_t *source;
 };
 
 // Allocators
@@ -172,11 +182,11 @@ DLLEXPORT int add_aabb_end_collision_callback ( GXCollider_t *collider, void* fu
 
 // Destructors
 /** !
- *  Destroy a collider
+ *  Destroy a collider. The bounding volume is left for the scene's BVH
  *
- * @param p_collider : Pointer to collider pointer
+ * @param pp_collider : Pointer to collider pointer
  *
- * @sa create_ai
+ * @sa create_collider
  *
  * @return 1 on success, 0 on error
  */
@@ -11,10 +11,26 @@
 // Standard library
 #include <stdio.h>
 #include <stdlib.h>
+#include <float.h>
+#include <math.h>
 
 // G10
 #include <G10/GXtypedef.h>
 #include <G10/G10.h>
+#include <G10/GXLinear.h>
+#include <G10/GXEntity.h>
+#include <G10/GXTransform.h>
+#include <G10/GXCollider.h>
+#include <G10/GXBV.h>
+
+// Iterations of the Gilbert Johnson Keerthi algorithm before the hulls are assumed to be separated
+#define GJK_MAX_ITERATIONS 32
+
+// Limits of the expanding polytope algorithm. Each iteration adds one vertex, and at most two faces
+#define EPA_MAX_ITERATIONS 32
+#define EPA_MAX_VERTICES   ( 4 + EPA_MAX_ITERATIONS )
+#define EPA_MAX_FACES      ( 2 * EPA_MAX_VERTICES )
+#define EPA_TOLERANCE      0.0001f
 
 struct GXCollision_s
 {
@@ -31,6 +47,14 @@ struct GXCollision_s
 	float       depth;
 };
 
+struct GXManifold_s
+{
+	GXEntity_t *a,
+	           *b;
+	vec3        normal; // Points from a to b
+	float       depth;
+};
+
 // Allocators
 /** !
  *  Allocate memory for a collision event
@@ -92,6 +116,74 @@ DLLEXPORT bool test_obb ( GXCollision_t *p_collision );
  */
 DLLEXPORT bool test_convex_hull ( GXCollision_t *p_collision );
 
+// Narrowphase primitives
+/** !
+ * Test two entities using their world space axis aligned bounding boxes
+ *
+ * @param p_a        : the first entity
+ * @param p_b        : the second entity
+ * @param p_manifold : return, written only if the entities are colliding. May be null.
+ *
+ * @sa collide_obb
+ * @sa collide_sphere
+ * @sa collide_convex_hull
+ *
+ * @return true if colliding else false
+ */
+DLLEXPORT bool collide_aabb ( GXEntity_t *p_a, GXEntity_t *p_b, GXManifold_t *p_manifold );
+
+/** !
+ * Test two entities using their spheres. The radius of a sphere collider is
+ * its own, or the largest sphere that fits inside its box when it has none,
+ * scaled by the largest axis of the model matrix
+ *
+ * @param p_a        : the first entity
+ * @param p_b        : the second entity
+ * @param p_manifold : return, written only if the entities are colliding. May be null.
+ *
+ * @sa collide_aabb
+ * @sa collide_obb
+ * @sa collide_convex_hull
+ *
+ * @return true if colliding else false
+ */
+DLLEXPORT bool collide_sphere ( GXEntity_t *p_a, GXEntity_t *p_b, GXManifold_t *p_manifold );
+
+/** !
+ * Test two entities using their oriented bounding boxes. Uses the separating axis theorem.
+ *
+ * @param p_a        : the first entity
+ * @param p_b        : the second entity
+ * @param p_manifold : return, written only if the entities are colliding. May be null.
+ *
+ * @sa collide_aabb
+ * @sa collide_sphere
+ * @sa collide_convex_hull
+ *
+ * @return true if colliding else false
+ */
+DLLEXPORT bool collide_obb ( GXEntity_t *p_a, GXEntity_t *p_b, GXManifold_t *p_manifold );
+
+/** !
+ * Test two entities using their convex hulls. Uses the Gilbert Johnson Keerthi algorithm,
+ * and the expanding polytope algorithm for the contact normal and depth. Entities without
+ * a convex hull are treated as their oriented bounding box. Hulls that GJK can not enclose
+ * the origin of in GJK_MAX_ITERATIONS are treated as separated. When the polytope can not
+ * be expanded to EPA_TOLERANCE, the closest face found is used, which is never deeper than
+ * the true contact.
+ *
+ * @param p_a        : the first entity
+ * @param p_b        : the second entity
+ * @param p_manifold : return, written only if the entities are colliding. May be null.
+ *
+ * @sa collide_aabb
+ * @sa collide_sphere
+ * @sa collide_obb
+ *
+ * @return true if colliding else false
+ */
+DLLEXPORT bool collide_convex_hull ( GXEntity_t *p_a, GXEntity_t *p_b, GXManifold_t *p_manifold );
+
 // Collision update
 /** !
  *  Update a collision event
@@ -21,6 +21,7 @@
 #include <G10/GXRigidbody.h>
 #include <G10/GXCollider.h>
 #include <G10/GXAI.h>
+#include <G10/GXArchetype.h>
 
 struct GXEntity_s
 {
@@ -32,6 +33,17 @@ struct GXEntity_s
 	GXRigidbody_t *rigidbody;
 	GXCollider_t  *collider;
 	GXAI_t        *ai;
+
+	// The chunk, and the row of the chunk, that holds this entity's components
+	GXArchetypeChunk_t *chunk;
+	size_t              chunk_row;
+
+	// Handle of this entity in the component storage, while stored
+	handle_t            handle;
+
+	// Bit i is set while this entity is in work list i, at row work_list_rows[i]
+	u32                 work_lists;
+	size_t              work_list_rows[WORK_LIST_COUNT];
 };
 
 // Allocators
@@ -161,6 +173,19 @@ DLLEXPORT int update_entity_ai ( GXEntity_t *p_entity );
 
 DLLEXPORT int get_model_matrix ( void *ret );
 
+/** !
+ * Write the model matrix of the active entity, with the dequantization of the
+ * positions of the active part folded into it. The same as the model matrix
+ * when the vertices of the part are floats
+ *
+ * @param ret : return
+ *
+ * @sa get_model_matrix
+ *
+ * @return the number of bytes written
+ */
+DLLEXPORT int get_dequantized_model_matrix ( void *ret );
+
 // Destructor
 /** !
  * Free an entity, and all its contents
@@ -0,0 +1,139 @@
+/** !
+ * @file G10/GXHandle.h
+ * @author Jacob Smith
+ *
+ * Generational handles, and interned strings. A handle is a 32 bit index into
+ * a handle table, tagged with the generation of its slot. Releasing a handle
+ * bumps the generation of the slot, so stale handles resolve to null instead
+ * of to whatever reuses the slot. Interned strings have exactly one copy, so
+ * they compare by pointer.
+ */
+
+// Include guard
+#pragma once
+
+// Standard library
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// G10
+#include <G10/GXtypedef.h>
+#include <G10/G10.h>
+
+// Handle layout. The low bits index a slot, the high bits are the generation of the slot
+#define HANDLE_INDEX_BITS      20
+#define HANDLE_GENERATION_BITS 12
+#define HANDLE_INDEX_MAX       ( 1u << HANDLE_INDEX_BITS )
+#define HANDLE_GENERATION_MAX  ( 1u << HANDLE_GENERATION_BITS )
+
+#define HANDLE_INDEX(h)      ( (u32) (h) & ( HANDLE_INDEX_MAX - 1 ) )
+#define HANDLE_GENERATION(h) ( (u32) (h) >> HANDLE_INDEX_BITS )
+
+// The null handle. Generations start at 1, so no live handle is 0
+#define HANDLE_INVALID 0
+
+struct GXHandleTable_s
+{
+
+	// One object and one generation per slot
+	void          **objects;
+	u16            *generations;
+	size_t          count,
+	                max;
+
+	// Released slots
+	u32            *free_slots;
+	size_t          free_count;
+
+	// Live handles
+	size_t          handle_count;
+
+	// Guards every field
+	SDL_SpinLock    lock;
+};
+
+// Allocators
+/** !
+ *  Allocate memory for a handle table
+ *
+ * @param pp_handle_table : return
+ *
+ * @sa destroy_handle_table
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int create_handle_table ( GXHandleTable_t **pp_handle_table );
+
+// Mutators
+/** !
+ *  Make a handle for an object
+ *
+ * @param p_handle_table : the handle table
+ * @param p_object       : the object
+ *
+ * @sa resolve_handle
+ * @sa release_handle
+ *
+ * @return a handle on success, HANDLE_INVALID on error
+ */
+DLLEXPORT handle_t acquire_handle ( GXHandleTable_t *p_handle_table, void *p_object );
+
+/** !
+ *  Release a handle. The handle, and every copy of it, goes stale
+ *
+ * @param p_handle_table : the handle table
+ * @param handle         : the handle
+ *
+ * @sa acquire_handle
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int release_handle ( GXHandleTable_t *p_handle_table, handle_t handle );
+
+// Getters
+/** !
+ *  Get the object of a handle
+ *
+ * @param p_handle_table : the handle table
+ * @param handle         : the handle
+ *
+ * @sa acquire_handle
+ *
+ * @return the object, or null if the handle is stale or invalid
+ */
+DLLEXPORT void *resolve_handle ( GXHandleTable_t *p_handle_table, handle_t handle );
+
+// Destructors
+/** !
+ *  Free a handle table. The objects are not freed
+ *
+ * @param pp_handle_table : pointer to handle table
+ *
+ * @sa create_handle_table
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int destroy_handle_table ( GXHandleTable_t **pp_handle_table );
+
+// String interning
+/** !
+ *  Get the interned copy of a string. Equal strings intern to the same pointer,
+ *  which stays valid until clear_interned_strings
+ *
+ * @param string : the string
+ *
+ * @sa clear_interned_strings
+ *
+ * @return the interned string on success, 0 on error
+ */
+DLLEXPORT const char *intern_string ( const char *string );
+
+/** !
+ *  Free every interned string
+ *
+ * @sa intern_string
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int clear_interned_strings ( void );
@@ -11,10 +11,35 @@
 // Standard library
 #include <math.h>
 
+// SIMD
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+    #include <immintrin.h>
+    #define G10_LINEAR_X86
+#elif defined(__aarch64__) || defined(_M_ARM64)
+    #include <arm_neon.h>
+    #define G10_LINEAR_NEON
+#endif
+
+// Compile one function for an instruction set the rest of the file may not use
+#if defined(G10_LINEAR_X86) && ( defined(__GNUC__) || defined(__clang__) )
+    #define G10_TARGET(isa) __attribute__((target(isa)))
+#else
+    #define G10_TARGET(isa)
+#endif
+
 // G10
 #include <G10/GXtypedef.h>
 #include <G10/G10.h>
 
+enum linear_backend_e
+{
+    linear_backend_scalar = 0,
+    linear_backend_sse41  = 1,
+    linear_backend_avx2   = 2,
+    linear_backend_neon   = 3
+};
+typedef enum linear_backend_e linear_backend_t;
+
 /** !
  * Adds vector a to vector b. Returns new vector
  *
@@ -106,6 +131,16 @@ DLLEXPORT vec3 mul_vec3_f ( vec3 v, float s );
  */
 DLLEXPORT vec3 normalize ( vec3 v );
 
+/** !
+ * Normalizes a vector in place, or into another vector
+ *
+ * @param r : return
+ * @param v : vector
+ *
+ * @sa normalize
+ */
+DLLEXPORT void normalize_p ( vec3 *r, const vec3 *v );
+
 /** !
  * Multiplies a 2x2 matrix by a vector
  *
@@ -129,6 +164,17 @@ DLLEXPORT vec2 mul_mat2_vec2 ( mat2 m, vec2 v );
  */
 DLLEXPORT vec4 mul_mat4_vec4 ( mat4 m, vec4 v );
 
+/** !
+ * Multiplies a matrix by a vector. r may alias v
+ *
+ * @param r : return
+ * @param m : 4x4 matrix
+ * @param v : vector
+ *
+ * @sa mul_mat4_vec4
+ */
+DLLEXPORT void mul_mat4_vec4_p ( vec4 *r, const mat4 *m, const vec4 *v );
+
 /** !
  * Multiplies a matrix by a matrix
  *
@@ -149,6 +195,59 @@ DLLEXPORT mat2 mul_mat2_mat2 ( mat2 m, mat2 n );
  */
 DLLEXPORT mat4 mul_mat4_mat4 ( mat4 m, mat4 n );
 
+/** !
+ * Multiplies a matrix by a matrix. r may alias m or n
+ *
+ * @param r : return ( m times n )
+ * @param m : 4x4 matrix
+ * @param n : 4x4 matrix
+ *
+ * @sa mul_mat4_mat4
+ */
+DLLEXPORT void mul_mat4_mat4_p ( mat4 *r, const mat4 *m, const mat4 *n );
+
+// Batches
+/** !
+ * Multiplies one matrix by each vector of an array. r may alias v
+ *
+ * @param r     : return, count vectors
+ * @param m     : 4x4 matrix
+ * @param v     : count vectors
+ * @param count : the number of vectors
+ *
+ * @sa mul_mat4_vec4
+ * @sa mul_mat4_vec4_batch_soa
+ */
+DLLEXPORT void mul_mat4_vec4_batch ( vec4 *r, const mat4 *m, const vec4 *v, size_t count );
+
+/** !
+ * Multiplies one matrix by each vector of a structure of arrays. If v.w is
+ * null, w is taken to be 1, which transforms points. If r.w is null, w is
+ * not written. The arrays need not be aligned. r may alias v
+ *
+ * @param r     : return
+ * @param m     : 4x4 matrix
+ * @param v     : count vectors
+ * @param count : the number of vectors
+ *
+ * @sa mul_mat4_vec4
+ * @sa mul_mat4_vec4_batch
+ */
+DLLEXPORT void mul_mat4_vec4_batch_soa ( vec4_soa r, const mat4 *m, vec4_soa v, size_t count );
+
+/** !
+ * Multiplies each matrix of an array by the matrix at the same index of
+ * another array. r may alias m or n
+ *
+ * @param r     : return, count matrices ( m[i] times n[i] )
+ * @param m     : count matrices
+ * @param n     : count matrices
+ * @param count : the number of matrices
+ *
+ * @sa mul_mat4_mat4
+ */
+DLLEXPORT void mul_mat4_mat4_batch ( mat4 *r, const mat4 *m, const mat4 *n, size_t count );
+
 /** !
  * Computes the inverse of a matrix
  *
@@ -159,14 +258,101 @@ DLLEXPORT mat4 mul_mat4_mat4 ( mat4 m, mat4 n );
 DLLEXPORT mat2 rcp_mat2 ( mat2 m );
 
 /** !
- * Computes the inverse of a matrix
+ * Transposes a matrix. This is only the inverse of a pure rotation
  *
  * @param m : 4x4 matrix
  *
- * @return inverse of m
+ * @sa inverse_mat4
+ * @sa affine_inverse_mat4
+ *
+ * @return transpose of m
  */
 DLLEXPORT mat4 rcp_mat4(mat4 m);
 
+/** !
+ * Computes the inverse of any invertible matrix
+ *
+ * @param m : 4x4 matrix
+ *
+ * @sa inverse_mat4_p
+ * @sa affine_inverse_mat4
+ *
+ * @return inverse of m, or a matrix of NaN if m is singular
+ */
+DLLEXPORT mat4 inverse_mat4 ( mat4 m );
+
+/** !
+ * Computes the inverse of any invertible matrix. r may alias m
+ *
+ * @param r : return, not written if m is singular
+ * @param m : 4x4 matrix
+ *
+ * @sa inverse_mat4
+ *
+ * @return true if m is invertible else false
+ */
+DLLEXPORT bool inverse_mat4_p ( mat4 *r, const mat4 *m );
+
+/** !
+ * Computes the inverse of a scale * rotation * translation matrix, like the
+ * ones from transform_model_matrix, by transposing the rotation and dividing out
+ * the scale. Much cheaper than inverse_mat4, but wrong for shear or projection
+ *
+ * @param m : 4x4 model matrix
+ *
+ * @sa affine_inverse_mat4_p
+ * @sa inverse_mat4
+ *
+ * @return inverse of m
+ */
+DLLEXPORT mat4 affine_inverse_mat4 ( mat4 m );
+
+/** !
+ * Computes the inverse of a scale * rotation * translation matrix. r may alias m
+ *
+ * @param r : return
+ * @param m : 4x4 model matrix
+ *
+ * @sa affine_inverse_mat4
+ */
+DLLEXPORT void affine_inverse_mat4_p ( mat4 *r, const mat4 *m );
+
+/** !
+ * Computes the inverse of each matrix of an array. Singular matrices invert to
+ * matrices of NaN. r may alias m
+ *
+ * @param r     : return, count matrices
+ * @param m     : count matrices
+ * @param count : the number of matrices
+ *
+ * @sa inverse_mat4
+ */
+DLLEXPORT void inverse_mat4_batch ( mat4 *r, const mat4 *m, size_t count );
+
+/** !
+ * Computes the inverse of each scale * rotation * translation matrix of an
+ * array. r may alias m
+ *
+ * @param r     : return, count matrices
+ * @param m     : count model matrices
+ * @param count : the number of matrices
+ *
+ * @sa affine_inverse_mat4
+ */
+DLLEXPORT void affine_inverse_mat4_batch ( mat4 *r, const mat4 *m, size_t count );
+
+/** !
+ * Computes the normal matrix, the transposed inverse without translation, of
+ * each scale * rotation * translation matrix of an array. r may alias m
+ *
+ * @param r     : return, count matrices
+ * @param m     : count model matrices
+ * @param count : the number of matrices
+ *
+ * @sa affine_inverse_mat4_batch
+ */
+DLLEXPORT void normal_mat4_batch ( mat4 *r, const mat4 *m, size_t count );
+
 /**
  * Returns the identity matrix
  *
@@ -227,3 +413,33 @@ DLLEXPORT mat4 rotation_mat4_from_vec3 ( vec3 rotation );
  * @return 4x4 model matrix
  */
 DLLEXPORT mat4 model_mat4_from_vec3 ( vec3 location, vec3 rotation, vec3 scale );
+
+// Initializer
+/** !
+ * Select the fastest backend the CPU has. Called by g_init, and g_init_headless
+ *
+ * @sa set_linear_backend
+ */
+DLLEXPORT void init_linear ( void );
+
+// Backends
+/** !
+ * Select the instruction set used by the pointer variants, and by the by value
+ * functions that forward to them. g_init selects the fastest one the CPU has.
+ *
+ * @param backend : the backend
+ *
+ * @sa get_linear_backend
+ *
+ * @return 1 on success, 0 if the CPU or the build does not support the backend
+ */
+DLLEXPORT int set_linear_backend ( linear_backend_t backend );
+
+/** !
+ * Get the instruction set used by the pointer variants
+ *
+ * @sa set_linear_backend
+ *
+ * @return the backend
+ */
+DLLEXPORT linear_backend_t get_linear_backend ( void );
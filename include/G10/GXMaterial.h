@@ -22,6 +22,7 @@ struct GXMaterial_s {
 	dict   *mutable_ints;
     dict   *mutable_floats;
     size_t  users; 
+    handle_t handle;
 };
 
 // Allocators
@@ -0,0 +1,329 @@
+/** !
+ * @file G10/GXMesh.h
+ * @author Jacob Smith
+ *
+ * Triangle meshes on the CPU, for offline optimization. A mesh is read from a
+ * PLY file, optimized, and saved as a G10 mesh file, which a part loads
+ * without parsing or converting anything.
+ *
+ * The optimizations run in order. Duplicate vertices are welded, triangles
+ * are ordered for the post transform vertex cache with Tipsify, clusters of
+ * triangles are ordered to reduce overdraw, and vertices are ordered by first
+ * use for fetch locality. Each step is deterministic, so the same input always
+ * makes the same file.
+ *
+ * Levels of detail are made by collapsing edges with quadric error metrics.
+ * Each level is simplified from the one before it, and only ever collapses a
+ * vertex onto another, so every level shares the vertices of the first. The
+ * levels are ranges of one index buffer, and each pass above orders each level
+ * on its own.
+ *
+ * The first level of detail is split into meshlets of at most 64 vertices and
+ * 124 triangles, in the order the triangles are drawn. Each meshlet has a
+ * bounding sphere, and a cone that holds the normal of every triangle in it,
+ * so a meshlet can be culled when it is outside the view, or faces away from
+ * the camera. Meshlets are laid out for task and mesh shaders as they are,
+ * and their bounds are kept on the CPU in groups of four, so one SIMD test
+ * culls four meshlets.
+ *
+ * A G10 mesh file is a header, the levels of detail, the vertices, the
+ * indices, and the meshlets, their vertices, and their triangles. Indices are
+ * 16 bits wide when the mesh has fewer than 65536 vertices, and 32 bits wide
+ * otherwise. Files are in the byte order of the machine that wrote them.
+ */
+
+// Include guard
+#pragma once
+
+// Standard library
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// SSE
+#if defined(__SSE__) || defined(_M_X64) || ( defined(_M_IX86_FP) && _M_IX86_FP >= 1 )
+    #include <xmmintrin.h>
+    #define G10_MESH_SSE
+#endif
+
+// G10
+#include <G10/GXtypedef.h>
+#include <G10/G10.h>
+#include <G10/GXPart.h>
+#include <G10/GXCamera.h>
+
+// "G10M"
+#define MESH_MAGIC      0x4D303147
+#define MESH_VERSION    3
+
+// The cache size most GPUs behave like
+#define MESH_CACHE_SIZE 16
+
+// Parts draw every level of detail a mesh has
+#define MESH_MAX_LODS   PART_MAX_LODS
+
+// The most vertices and triangles a mesh shader writes for one meshlet
+#define MESHLET_MAX_VERTICES  64
+#define MESHLET_MAX_TRIANGLES 124
+
+struct GXMeshHeader_s
+{
+	u32   magic,
+	      version,
+	      vertex_count,
+	      vertex_stride,
+	      index_count,
+	      index_size,
+	      lod_count,
+	      meshlet_count,
+	      meshlet_vertex_count,
+	      meshlet_triangle_count;
+
+	// Bounding sphere of the vertices
+	float center[3],
+	      radius;
+};
+
+struct GXMeshLOD_s
+{
+
+	// The range of the indices
+	u32   first_index,
+	      index_count;
+
+	// How far the level strays from the first, in model space
+	float error;
+};
+
+// Laid out in vec4s, so shaders read it with std430
+struct GXMeshlet_s
+{
+
+	// The ranges of the meshlet vertices and the meshlet triangles
+	u32   vertex_offset,
+	      triangle_offset,
+	      vertex_count,
+	      triangle_count;
+
+	// Bounding sphere
+	float center[3],
+	      radius;
+
+	// Every triangle faces away from a camera where dot(normalize(cone_apex - camera), cone_axis) >= cone_cutoff
+	float cone_apex[3],
+	      cone_cutoff;
+	float cone_axis[3],
+	      padding;
+};
+
+// Four meshlets, one lane each
+struct GXMeshletBounds_s
+{
+	float center_x[4], center_y[4], center_z[4], radius[4],
+	      apex_x[4], apex_y[4], apex_z[4],
+	      axis_x[4], axis_y[4], axis_z[4], cutoff[4];
+};
+
+struct GXMesh_s
+{
+
+	// Vertices, one float per vertex property, in the order of the source file
+	float        *vertices;
+	size_t        vertex_count,
+	              vertex_stride;
+
+	// Bytes from the start of a vertex to its x, y, and z
+	size_t        position_offset;
+
+	// Triangles of every level of detail, one level after another
+	u32          *indices;
+	size_t        index_count;
+
+	// Levels of detail
+	GXMeshLOD_t   lods[MESH_MAX_LODS];
+	size_t        lod_count;
+
+	// Meshlets of the first level of detail
+	GXMeshlet_t  *meshlets;
+	size_t        meshlet_count;
+	u32          *meshlet_vertices;
+	size_t        meshlet_vertex_count;
+	u8           *meshlet_triangles;
+	size_t        meshlet_triangle_count;
+};
+
+// Allocators
+/** !
+ *  Allocate memory for a mesh
+ *
+ * @param pp_mesh : return
+ *
+ * @sa destroy_mesh
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int create_mesh ( GXMesh_t **pp_mesh );
+
+// Constructors
+/** !
+ *  Load a mesh from a PLY file. The vertex element must have the float
+ *  properties x, y, and z, one after another
+ *
+ * @param pp_mesh : return
+ * @param path    : the path to the file
+ *
+ * @sa save_mesh
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int load_mesh_as_ply ( GXMesh_t **pp_mesh, const char *path );
+
+/** !
+ *  Load a G10 mesh file into the vertex and index buffers of a part. The
+ *  vertices and indices are uploaded as they are in the file
+ *
+ * @param p_part : the part
+ * @param path   : the path to the file
+ *
+ * @sa save_mesh
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int load_mesh_part ( GXPart_t *p_part, const char *path );
+
+// Mutators
+/** !
+ *  Merge vertices that are equal in every property, and remove the triangles
+ *  that weld into lines or points
+ *
+ * @param p_mesh : the mesh
+ *
+ * @sa optimize_mesh_vertex_cache
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int weld_mesh ( GXMesh_t *p_mesh );
+
+/** !
+ *  Add a level of detail to a mesh, simplified from its last level. Edges are
+ *  collapsed, cheapest first, until the error would pass the target or the
+ *  level is small enough. Vertices on seams are never moved, and vertices on
+ *  borders only move along them
+ *
+ * @param p_mesh             : the mesh, after weld_mesh
+ * @param target_error       : the most error allowed, as a fraction of the radius of the mesh
+ * @param target_index_count : stop at this many indices, or 0 to stop only at the error
+ *
+ * @sa weld_mesh
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int simplify_mesh ( GXMesh_t *p_mesh, float target_error, size_t target_index_count );
+
+/** !
+ *  Order the triangles of a mesh so each vertex is transformed as few times
+ *  as possible, with Tipsify
+ *
+ * @param p_mesh     : the mesh
+ * @param cache_size : the number of vertices in the post transform cache
+ *
+ * @sa optimize_mesh_overdraw
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int optimize_mesh_vertex_cache ( GXMesh_t *p_mesh, size_t cache_size );
+
+/** !
+ *  Split the triangles of a mesh into clusters where the vertex cache is cold,
+ *  and draw the clusters that face out of the mesh first. Clusters are only
+ *  split where the cost to the vertex cache is under a threshold
+ *
+ * @param p_mesh     : the mesh, after optimize_mesh_vertex_cache
+ * @param cache_size : the number of vertices in the post transform cache
+ * @param threshold  : how much worse the vertex cache may get, like 1.05
+ *
+ * @sa optimize_mesh_vertex_cache
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int optimize_mesh_overdraw ( GXMesh_t *p_mesh, size_t cache_size, float threshold );
+
+/** !
+ *  Order the vertices of a mesh by the first triangle that uses them, and
+ *  remove vertices that no triangle uses
+ *
+ * @param p_mesh : the mesh, after its triangles are ordered
+ *
+ * @sa optimize_mesh_overdraw
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int optimize_mesh_vertex_fetch ( GXMesh_t *p_mesh );
+
+/** !
+ *  Split the first level of detail of a mesh into meshlets, in the order its
+ *  triangles are drawn, and bound each one with a sphere and a normal cone
+ *
+ * @param p_mesh        : the mesh, after optimize_mesh_vertex_fetch
+ * @param max_vertices  : the most vertices in a meshlet, up to 256
+ * @param max_triangles : the most triangles in a meshlet
+ *
+ * @sa cull_part_meshlets
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int build_mesh_meshlets ( GXMesh_t *p_mesh, size_t max_vertices, size_t max_triangles );
+
+// Info
+/** !
+ *  Find the meshlets of a part that may be seen by a camera. Meshlets outside
+ *  the view, and meshlets that face away from the camera, are culled four at a
+ *  time. Normal cones assume the transform scales evenly
+ *
+ * @param p_part      : the part
+ * @param p_transform : the transform of the instance being drawn
+ * @param p_camera    : the camera
+ * @param p_visible   : return, the index of each meshlet that may be seen
+ *
+ * @sa build_mesh_meshlets
+ *
+ * @return the number of meshlets that may be seen
+ */
+DLLEXPORT size_t cull_part_meshlets ( GXPart_t *p_part, GXTransform_t *p_transform, GXCamera_t *p_camera, u32 *p_visible );
+
+/** !
+ *  Simulate a FIFO post transform vertex cache over the first level of detail
+ *  of a mesh
+ *
+ * @param p_mesh     : the mesh
+ * @param cache_size : the number of vertices in the cache
+ * @param p_acmr     : return, vertices transformed per triangle
+ * @param p_atvr     : return, vertices transformed per vertex used
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int analyze_mesh_vertex_cache ( GXMesh_t *p_mesh, size_t cache_size, float *p_acmr, float *p_atvr );
+
+/** !
+ *  Write a mesh to a G10 mesh file
+ *
+ * @param p_mesh : the mesh
+ * @param path   : the path to the file
+ *
+ * @sa load_mesh_part
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int save_mesh ( GXMesh_t *p_mesh, const char *path );
+
+// Destructors
+/** !
+ *  Destroy a mesh
+ *
+ * @param pp_mesh : pointer to mesh
+ *
+ * @sa create_mesh
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int destroy_mesh ( GXMesh_t **pp_mesh );
@@ -0,0 +1,249 @@
+/** !
+ * @file G10/GXPLY.h
+ * @author Jacob Smith
+ *
+ * PLY files. A PLY file is mapped into memory, and its header is parsed once
+ * into a table of elements and properties. Every PLY scalar type, and list
+ * properties of any count and item type, are understood.
+ *
+ * Little endian vertices made only of floats are used where they sit in the
+ * mapping, and are never copied before they are uploaded. Anything else is
+ * converted to floats by one tight loop per property. Faces are triangulated
+ * into 32 bit indices.
+ *
+ * Vertex properties are sorted into vertex groups by name. A file may also be
+ * uploaded quantized, where each group it has is encoded compactly, and
+ * interleaved.
+ *
+ * ASCII PLY files are not supported.
+ */
+
+// Include guard
+#pragma once
+
+// Standard library
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// G10
+#include <G10/GXtypedef.h>
+#include <G10/G10.h>
+#include <G10/GXPart.h>
+#include <G10/GXVertex.h>
+
+// Limits of the header
+#define PLY_MAX_ELEMENTS   8
+#define PLY_MAX_PROPERTIES 32
+#define PLY_MAX_NAME       32
+
+enum ply_format_e
+{
+    ply_format_none          = 0,
+    ply_format_ascii         = 1,
+    ply_format_little_endian = 2,
+    ply_format_big_endian    = 3
+};
+typedef enum ply_format_e ply_format_t;
+
+enum ply_type_e
+{
+    ply_type_none    = 0,
+    ply_type_int8    = 1,
+    ply_type_uint8   = 2,
+    ply_type_int16   = 3,
+    ply_type_uint16  = 4,
+    ply_type_int32   = 5,
+    ply_type_uint32  = 6,
+    ply_type_float32 = 7,
+    ply_type_float64 = 8
+};
+typedef enum ply_type_e ply_type_t;
+
+struct GXPLYProperty_s
+{
+
+	// The name of the property
+	char        name[PLY_MAX_NAME];
+
+	// The type of the property, or the type of each item of a list
+	ply_type_t  type;
+
+	// The type of the count of a list, or ply_type_none
+	ply_type_t  count_type;
+
+	// Bytes from the start of the row. Only meaningful for properties before the first list
+	size_t      offset;
+};
+
+struct GXPLYElement_s
+{
+
+	// The name of the element, and the number of rows
+	char             name[PLY_MAX_NAME];
+	size_t           count;
+
+	// Bytes in each row, or 0 if the element has a list property
+	size_t           stride;
+
+	// Properties
+	GXPLYProperty_t  properties[PLY_MAX_PROPERTIES];
+	size_t           property_count;
+
+	// The rows of the element, in the mapping
+	const u8        *data;
+	size_t           size;
+};
+
+struct GXPLY_s
+{
+
+	// The mapped file
+	const u8       *file;
+	size_t          file_size;
+
+	// The format of the data after the header
+	ply_format_t    format;
+
+	// Elements, in the order of the file
+	GXPLYElement_t  elements[PLY_MAX_ELEMENTS];
+	size_t          element_count;
+
+	// Vertices and indices converted from the file. Null when used in place, or not yet read
+	float          *vertices;
+	u32            *indices;
+	size_t          index_count;
+};
+
+// Constructors
+/** !
+ *  Map a PLY file into memory, and parse its header
+ *
+ * @param pp_ply : return
+ * @param path   : the path to the file
+ *
+ * @sa unmap_ply
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int map_ply ( GXPLY_t **pp_ply, const char *path );
+
+/** !
+ *  Load a PLY file into the vertex and index buffers of a part
+ *
+ * @param part : the part
+ * @param path : the path to the file
+ *
+ * @return the part on success, 0 on error
+ */
+DLLEXPORT GXPart_t *load_ply ( GXPart_t *part, const char *path );
+
+/** !
+ *  Upload the vertices and faces of a mapped PLY file into the vertex and
+ *  index buffers of a part
+ *
+ * @param part  : the part
+ * @param p_ply : the PLY file
+ *
+ * @sa load_ply
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int upload_ply ( GXPart_t *part, GXPLY_t *p_ply );
+
+/** !
+ *  Load a PLY file into the vertex and index buffers of a part, with its
+ *  vertices quantized
+ *
+ * @param part : the part
+ * @param path : the path to the file
+ *
+ * @sa upload_ply_quantized
+ *
+ * @return the part on success, 0 on error
+ */
+DLLEXPORT GXPart_t *load_ply_quantized ( GXPart_t *part, const char *path );
+
+/** !
+ *  Quantize the vertices of a mapped PLY file, in the encodings of its vertex
+ *  groups, and upload them and its faces into the buffers of a part. The part
+ *  keeps its vertex groups, and how to dequantize its positions
+ *
+ * @param part  : the part
+ * @param p_ply : the PLY file. Its vertices must have x, y, and z
+ *
+ * @sa get_ply_vertex_groups
+ * @sa quantize_vertices
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int upload_ply_quantized ( GXPart_t *part, GXPLY_t *p_ply );
+
+// Getters
+/** !
+ *  Find an element by name
+ *
+ * @param p_ply : the PLY file
+ * @param name  : the name of the element
+ *
+ * @return the element, or 0 if the file has no element of that name
+ */
+DLLEXPORT GXPLYElement_t *get_ply_element ( GXPLY_t *p_ply, const char *name );
+
+/** !
+ *  Get the vertices of a PLY file as floats, one per vertex property, in the
+ *  order of the header. Points into the mapping when the file already holds
+ *  little endian floats, in which case the vertices may not be aligned to 4
+ *  bytes, and should be read with memcpy. Anything else is converted once,
+ *  and later calls return the same vertices
+ *
+ * @param p_ply    : the PLY file
+ * @param p_stride : return, bytes between vertices
+ * @param p_count  : return, the number of vertices
+ *
+ * @sa get_ply_indices
+ *
+ * @return the vertices on success, 0 on error. Valid until the file is unmapped
+ */
+DLLEXPORT const void *get_ply_vertices ( GXPLY_t *p_ply, size_t *p_stride, size_t *p_count );
+
+/** !
+ *  Get the faces of a PLY file as triangles. Faces with more than three
+ *  vertices are split into fans. The faces are triangulated once, and later
+ *  calls return the same indices. A face that refers to a vertex past the end
+ *  of the vertex element is an error
+ *
+ * @param p_ply   : the PLY file
+ * @param p_count : return, the number of indices
+ *
+ * @sa get_ply_vertices
+ *
+ * @return the indices on success, 0 on error. Valid until the file is unmapped
+ */
+DLLEXPORT const u32 *get_ply_indices ( GXPLY_t *p_ply, size_t *p_count );
+
+/** !
+ *  Find the vertex groups of a PLY file, and where each of their properties is
+ *  in the vertices returned by get_ply_vertices. A group is found only when it
+ *  has every property. Colors may leave out alpha
+ *
+ * @param p_ply    : the PLY file
+ * @param p_source : return, where each group is
+ *
+ * @sa get_ply_vertices
+ *
+ * @return a bitmask of VERTEX_GROUP_* codes, or 0 if there are none
+ */
+DLLEXPORT u32 get_ply_vertex_groups ( GXPLY_t *p_ply, GXVertexSource_t *p_source );
+
+// Destructors
+/** !
+ *  Unmap a PLY file, and free what was converted from it
+ *
+ * @param pp_ply : pointer to PLY file
+ *
+ * @sa map_ply
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int unmap_ply ( GXPLY_t **pp_ply );
@@ -30,6 +30,12 @@
 // json submodule
 #include <json/json.h>
 
+// The most levels of detail a part can have
+#define PART_MAX_LODS 8
+
+// Levels of detail are drawn while their error is under this many pixels
+#define PART_LOD_PIXEL_ERROR 1.f
+
 struct GXPart_s
 {
 	char           *name;
@@ -46,6 +52,38 @@ struct GXPart_s
 	size_t          vertex_count,
 	                index_count,
 		            users;
+
+	// Bytes in each index, 2 or 4
+	size_t          index_size;
+
+	// Vertex groups of quantized vertices, or 0 when vertices are floats. Positions dequantize to xyz + position * w
+	u32             vertex_groups;
+	vec4            dequantize;
+
+	// Levels of detail, each a range of the index buffer. Level 0 is the whole part
+	struct
+	{
+		u32         first_index,
+		            index_count;
+		float       error;
+	}               lods[PART_MAX_LODS];
+	size_t          lod_count;
+
+	// Bounding sphere in model space
+	vec3            center;
+	float           radius;
+
+	// Meshlets of the first level of detail, for task and mesh shaders. One buffer holds the meshlets, their vertices, then their triangles
+	VkBuffer        meshlet_buffer;
+	VkDeviceMemory  meshlet_buffer_memory;
+	size_t          meshlet_count,
+	                meshlet_vertices_offset,
+	                meshlet_triangles_offset;
+
+	// Bounds of the meshlets, four to a group, for culling on the CPU
+	GXMeshletBounds_t *meshlet_bounds;
+
+	handle_t        handle;
 };
 
 // Allocators
@@ -86,6 +124,56 @@ DLLEXPORT int load_part ( GXPart_t   **pp_part, char *path );
 DLLEXPORT int load_part_as_json_text ( GXPart_t **pp_part, char *text );
 DLLEXPORT int load_part_as_json_value ( GXPart_t **pp_part, JSONValue_t *p_value );
 
+/** !
+ *  Copy vertices and triangles into new vertex and index buffers of a part
+ *
+ * @param p_part       : the part
+ * @param p_vertices   : the vertices
+ * @param vertex_size  : bytes in each vertex
+ * @param vertex_count : the number of vertices
+ * @param p_indices    : the indices, three for each triangle
+ * @param index_size   : bytes in each index, 2 or 4
+ * @param index_count  : the number of indices
+ *
+ * @sa load_part_as_json_value
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int upload_part ( GXPart_t *p_part, const void *p_vertices, size_t vertex_size, size_t vertex_count, const void *p_indices, size_t index_size, size_t index_count );
+
+/** !
+ *  Copy meshlets into a new storage buffer of a part, for task and mesh
+ *  shaders, and keep their bounds for culling on the CPU
+ *
+ * @param p_part         : the part, after upload_part
+ * @param p_meshlets     : the meshlets
+ * @param meshlet_count  : the number of meshlets
+ * @param p_vertices     : the vertices of every meshlet, as indices of the vertex buffer
+ * @param vertex_count   : the number of meshlet vertices
+ * @param p_triangles    : the triangles of every meshlet, as three indices of its vertices
+ * @param triangle_count : the number of meshlet triangles
+ *
+ * @sa cull_part_meshlets
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int upload_part_meshlets ( GXPart_t *p_part, const GXMeshlet_t *p_meshlets, size_t meshlet_count, const u32 *p_vertices, size_t vertex_count, const u8 *p_triangles, size_t triangle_count );
+
+// Getters
+/** !
+ *  Choose the coarsest level of detail of a part whose error, projected onto
+ *  the screen, is under a number of pixels. The bounds of the part are moved
+ *  into world space with the model matrix of the transform
+ *
+ * @param p_part      : the part
+ * @param p_transform : the transform of the instance being drawn
+ * @param p_camera    : the camera
+ * @param pixel_error : the most error allowed, in pixels
+ *
+ * @return the level of detail, or 0 on error
+ */
+DLLEXPORT size_t select_part_lod ( GXPart_t *p_part, GXTransform_t *p_transform, GXCamera_t *p_camera, float pixel_error );
+
 // Info
 
 // TODO: Document
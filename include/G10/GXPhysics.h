@@ -18,9 +18,72 @@
 #include <G10/GXCollider.h>
 #include <G10/GXCollision.h>
 #include <G10/GXEntity.h>
+#include <G10/GXRigidbody.h>
+
+// Size of a narrowphase work unit. Each chunk of pairs fits in L1
+#define NARROWPHASE_CHUNK_BYTES 16384
+#define NARROWPHASE_CHUNK_PAIRS ( NARROWPHASE_CHUNK_BYTES / sizeof(GXCollisionPair_t) )
+
+// Maximum number of threads that may run the narrowphase at once
+#define NARROWPHASE_MAX_THREADS 64
+
+// Past any chunk. Set while begin_narrowphase rewrites the chunks, so workers claim nothing
+#define NARROWPHASE_CLOSED      0x40000000
+
+struct GXCollisionPair_s
+{
+	GXEntity_t *a,
+	           *b;
+	u32         shape_pair; // ( lesser collider type * 8 ) + greater collider type
+};
+
+// Broadphase
+/** !
+ *  Find potentially colliding pairs of entities with sweep and prune, and
+ *  prepare the pair list for the narrowphase.
+ *
+ * @param p_instance  : Pointer to instance
+ * @param pp_actors   : Array of entities
+ * @param actor_count : Number of entities
+ *
+ * @sa begin_narrowphase
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int detect_broadphase ( GXInstance_t *p_instance, GXEntity_t **pp_actors, size_t actor_count );
+
+// Narrowphase
+/** !
+ *  Sort a pair list by shape pair, and split it into chunks for the
+ *  narrowphase workers. Workers stop claiming chunks of the last narrowphase,
+ *  and the ones still testing pairs are waited for, before anything is
+ *  rewritten.
+ *
+ * @param p_instance : Pointer to instance
+ * @param p_pairs    : Array of pairs. Copied.
+ * @param pair_count : Number of pairs
+ *
+ * @sa detect_collisions
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int begin_narrowphase ( GXInstance_t *p_instance, GXCollisionPair_t *p_pairs, size_t pair_count );
+
+/** !
+ *  Get the contact manifolds produced by the last narrowphase
+ *
+ * @param p_manifolds : return, may be null
+ *
+ * @sa detect_collisions
+ *
+ * @return number of manifolds
+ */
+DLLEXPORT size_t get_narrowphase_manifolds ( GXManifold_t *p_manifolds );
 
 /** !
- *  Detect and update collisions in the instances active scene
+ *  Detect and update collisions in the instances active scene. Any number of
+ *  threads may call this concurrently; each claims chunks of the pair list
+ *  prepared by begin_narrowphase until none remain.
  *
  * @param p_instance : Pointer to instance
  *
@@ -32,6 +95,21 @@
  */
 DLLEXPORT int detect_collisions ( GXInstance_t *p_instance );
 
+/** !
+ *  Push apart the entities in each contact manifold from the last narrowphase,
+ *  and remove their approaching velocity. Tests the pairs no worker has
+ *  claimed, and waits for the workers still testing theirs, first. Scheduled
+ *  as "Solve Collisions", after "Resolve Collisions".
+ *
+ * @param p_instance : Pointer to instance
+ *
+ * @sa detect_collisions
+ * @sa get_narrowphase_manifolds
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int solve_collisions ( GXInstance_t *p_instance );
+
 /** !
  *  Updates location and rotation derivatives for each object in the instances active scene.
  *
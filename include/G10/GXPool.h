@@ -0,0 +1,165 @@
+/** !
+ * @file G10/GXPool.h
+ * @author Jacob Smith
+ *
+ * Fixed size object pools. A pool carves objects of one size out of cache
+ * line aligned slabs, and keeps freed objects on a free list. Each thread
+ * caches a batch of free objects for each pool it uses, so allocating and
+ * freeing only take the pool's lock once per batch. Once a pool has grown to
+ * its working set, it never calls malloc again.
+ *
+ * Constructors allocate with the G10_POOL_ALLOC and G10_POOL_FREE macros, so
+ * a build can route them back to calloc and free.
+ */
+
+// Include guard
+#pragma once
+
+// Standard library
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// G10
+#include <G10/GXtypedef.h>
+#include <G10/G10.h>
+#include <G10/GXArena.h>
+
+// Alignment of each slab
+#define POOL_SLAB_ALIGNMENT 64
+
+// Default size of a slab
+#define POOL_SLAB_SIZE ( 16 * 1024 )
+
+// Alignment of each object
+#define POOL_OBJECT_ALIGNMENT 16
+
+// Objects moved between a thread's cache and its pool at once
+#define POOL_BATCH 32
+
+struct GXPool_s
+{
+
+	// Size of each object, and objects per slab
+	size_t         object_size,
+	               slab_objects;
+
+	// Every slab. Each slab starts on a cache line
+	void         **slabs;
+	size_t         slab_count,
+	               slab_max;
+
+	// Objects in every slab
+	size_t         object_count;
+
+	// Free objects no thread has cached
+	void          *free_list;
+	size_t         free_count;
+
+	// Distinguishes this pool from an earlier pool at the same address
+	u64            id;
+
+	// The next live pool, and the variable get_pool stored this pool in
+	GXPool_t      *next,
+	             **slot;
+
+	// Guards the slabs and the free list
+	SDL_SpinLock   lock;
+};
+
+// Allocators
+/** !
+ *  Allocate memory for a pool
+ *
+ * @param pp_pool      : return
+ * @param object_size  : the size of each object in bytes
+ * @param slab_objects : objects per slab, or 0 to fill POOL_SLAB_SIZE bytes
+ *
+ * @sa destroy_pool
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int create_pool ( GXPool_t **pp_pool, size_t object_size, size_t slab_objects );
+
+// Mutators
+/** !
+ *  Allocate a zeroed object from a pool. Safe to call from many threads at once
+ *
+ * @param p_pool : the pool
+ *
+ * @sa pool_free
+ *
+ * @return a pointer aligned to POOL_OBJECT_ALIGNMENT on success, 0 on error
+ */
+DLLEXPORT void *pool_alloc ( GXPool_t *p_pool );
+
+/** !
+ *  Return an object to a pool. Any thread may free any object of the pool
+ *
+ * @param p_pool : the pool
+ * @param p      : the object, or null
+ *
+ * @sa pool_alloc
+ */
+DLLEXPORT void pool_free ( GXPool_t *p_pool, void *p );
+
+/** !
+ *  Allocate a zeroed object from the arena bound to the calling thread, or from
+ *  a pool if none is bound. For objects with the lifetime of a scene
+ *
+ * @param pp_pool : the pool, made by get_pool on first use
+ * @param size    : the size of the object in bytes
+ *
+ * @sa pool_release
+ * @sa set_thread_arena
+ *
+ * @return a pointer on success, 0 on error
+ */
+DLLEXPORT void *pool_calloc ( GXPool_t **pp_pool, size_t size );
+
+/** !
+ *  Free an object from pool_calloc. Objects that belong to an arena are left
+ *  for destroy_arena
+ *
+ * @param pp_pool : the pool
+ * @param p       : the object, or null
+ *
+ * @sa pool_calloc
+ */
+DLLEXPORT void pool_release ( GXPool_t **pp_pool, void *p );
+
+// Getters
+/** !
+ *  Get the pool stored in a variable, making it on first use. Safe to call from
+ *  many threads at once
+ *
+ * @param pp_pool     : the variable
+ * @param object_size : the size of each object in bytes
+ *
+ * @sa clear_pools
+ *
+ * @return the pool on success, 0 on error
+ */
+DLLEXPORT GXPool_t *get_pool ( GXPool_t **pp_pool, size_t object_size );
+
+// Destructors
+/** !
+ *  Free a pool, and every object allocated from it
+ *
+ * @param pp_pool : pointer to pool
+ *
+ * @sa create_pool
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int destroy_pool ( GXPool_t **pp_pool );
+
+/** !
+ *  Free every pool made by get_pool, and zero the variables they were stored in
+ *
+ * @sa get_pool
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int clear_pools ( void );
@@ -0,0 +1,106 @@
+/** !
+ * @file G10/GXPrefab.h
+ * @author Jacob Smith
+ *
+ * Prefabs. A prefab is an entity that is parsed once, and kept as a template.
+ * Instances are stamped out of the template with a memcpy of each component,
+ * instead of being parsed from JSON again.
+ *
+ * Instances share the template's immutable data. Parts, materials, collider
+ * hulls and callbacks, and AI states are borrowed from the template, and an
+ * instance only copies AI states when it adds a state callback. Transforms,
+ * rigidbody forces, and bounding volumes are written every frame, so each
+ * instance gets its own.
+ *
+ * An entity is stamped from a prefab when its JSON has a "prefab" property.
+ */
+
+// Include guard
+#pragma once
+
+// Standard library
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// json submodule
+#include <json/json.h>
+
+// G10
+#include <G10/GXtypedef.h>
+#include <G10/G10.h>
+#include <G10/GXEntity.h>
+
+struct GXPrefab_s
+{
+
+	// The name of the prefab. A prefab loaded from a file is named by its path
+	char       *name;
+
+	// The template. Instances copy it, and borrow what it points to
+	GXEntity_t *entity;
+};
+
+// Allocators
+/** !
+ *  Allocate memory for a prefab
+ *
+ * @param pp_prefab : return
+ *
+ * @sa destroy_prefab
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int create_prefab ( GXPrefab_t **pp_prefab );
+
+// Constructors
+/** !
+ *  Load a prefab from an entity JSON file. The prefab is named by the path
+ *
+ * @param pp_prefab : return
+ * @param path      : The path to a JSON file containing an entity object
+ *
+ * @sa load_prefab_as_json_value
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int load_prefab ( GXPrefab_t **pp_prefab, const char *path );
+
+/** !
+ *  Load a prefab from an entity JSON value. The prefab is named by the entity
+ *
+ * @param pp_prefab : return
+ * @param p_value   : The entity JSON value
+ *
+ * @sa load_prefab
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int load_prefab_as_json_value ( GXPrefab_t **pp_prefab, JSONValue_t *p_value );
+
+/** !
+ *  Stamp an entity out of a prefab. The entity's components are allocated with
+ *  arena_calloc, so a loading thread stamps into the scene's arena. Safe to call
+ *  from many threads at once
+ *
+ * @param pp_entity : return
+ * @param p_prefab  : the prefab
+ * @param name      : the name of the entity
+ *
+ * @sa destroy_entity
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int instance_prefab ( GXEntity_t **pp_entity, GXPrefab_t *p_prefab, const char *name );
+
+// Destructors
+/** !
+ *  Destroy a prefab. Every instance of the prefab must be destroyed first
+ *
+ * @param pp_prefab : pointer to prefab
+ *
+ * @sa create_prefab
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int destroy_prefab ( GXPrefab_t **pp_prefab );
@@ -0,0 +1,208 @@
+/** !
+ * @file G10/GXQBVH.h
+ * @author Jacob Smith
+ *
+ * Compiled, read only, 4-wide bounding volume hierarchy. The dynamic tree in
+ * GXBV.h is flattened into one contiguous array of nodes, each holding the
+ * bounds of four children as structures of arrays, so one SIMD test checks
+ * every child of a node.
+ */
+
+// Include guard
+#pragma once
+
+// Standard library
+#include <float.h>
+#include <math.h>
+
+// SSE
+#if defined(__SSE__) || defined(_M_X64) || ( defined(_M_IX86_FP) && _M_IX86_FP >= 1 )
+    #include <xmmintrin.h>
+    #define G10_QBVH_SSE
+#endif
+
+// G10
+#include <G10/GXtypedef.h>
+#include <G10/G10.h>
+#include <G10/GXBV.h>
+#include <G10/GXCamera.h>
+#include <G10/GXEntity.h>
+#include <G10/GXCollider.h>
+
+// Child index of an unused slot
+#define QBVH_EMPTY INT32_MIN
+
+// Child indices less than zero are leaves. Leaf i is stored as ~i
+#define QBVH_IS_LEAF(c)    ( (c) < 0 && (c) != QBVH_EMPTY )
+#define QBVH_LEAF_INDEX(c) ( (size_t) ~(c) )
+
+// Maximum depth of a traversal
+#define QBVH_STACK_SIZE 256
+
+struct GXQBVHNode_s
+{
+
+    // Child bounds, one lane per child
+    float min_x[4], min_y[4], min_z[4],
+          max_x[4], max_y[4], max_z[4];
+
+    // Index of each child node, ~index of each leaf, or QBVH_EMPTY
+    i32   children[4];
+
+    // Index of the parent node, or -1 for the root
+    i32   parent;
+
+    // Slot of this node in its parent
+    u32   parent_slot;
+
+    // Pad to two cache lines
+    u8    padding[8];
+};
+
+struct GXQBVH_s
+{
+
+    // Nodes. The root is node 0, and parents always precede their children
+    GXQBVHNode_t  *nodes;
+    size_t         node_count,
+                   node_max;
+
+    // Leaves, in the order they were compiled
+    GXBV_t       **leaves;
+    size_t         leaf_count,
+                   leaf_max;
+
+    // The dynamic tree this was compiled from
+    GXBV_t        *source;
+};
+
+// Allocators
+/** !
+ *  Allocate memory for a 4-wide bounding volume hierarchy
+ *
+ * @param pp_qbvh : return
+ *
+ * @sa destroy_qbvh
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int create_qbvh ( GXQBVH_t **pp_qbvh );
+
+// Constructors
+/** !
+ *  Compile a dynamic bounding volume hierarchy into a 4-wide bounding volume
+ *  hierarchy. Reuses the memory of the last build.
+ *
+ * @param p_qbvh : the 4-wide bounding volume hierarchy
+ * @param p_bvh  : the dynamic bounding volume hierarchy
+ *
+ * @sa refit_qbvh
+ * @sa update_qbvh
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int build_qbvh ( GXQBVH_t *p_qbvh, GXBV_t *p_bvh );
+
+// Updaters
+/** !
+ *  Recompute the bounds of every node from the bounds of the leaves, without
+ *  changing the shape of the tree.
+ *
+ * @param p_qbvh : the 4-wide bounding volume hierarchy
+ *
+ * @sa build_qbvh
+ * @sa update_qbvh
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int refit_qbvh ( GXQBVH_t *p_qbvh );
+
+/** !
+ *  Refit the 4-wide bounding volume hierarchy if the dynamic tree still has
+ *  the same leaves, else rebuild it. Call once a frame.
+ *
+ * @param p_qbvh : the 4-wide bounding volume hierarchy
+ * @param p_bvh  : the dynamic bounding volume hierarchy
+ *
+ * @sa build_qbvh
+ * @sa refit_qbvh
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int update_qbvh ( GXQBVH_t *p_qbvh, GXBV_t *p_bvh );
+
+// Queries
+/** !
+ *  Find the closest entity whose bounding volume is hit by a ray
+ *
+ * @param p_qbvh    : the 4-wide bounding volume hierarchy
+ * @param origin    : the origin of the ray
+ * @param direction : the direction of the ray
+ * @param max_t     : the length of the ray, in units of direction
+ * @param pp_entity : return
+ * @param p_t       : return, the distance to the hit in units of direction. May be null.
+ *
+ * @sa qbvh_overlap
+ * @sa qbvh_frustum
+ *
+ * @return true if something was hit, else false. False on error
+ */
+DLLEXPORT bool qbvh_raycast ( GXQBVH_t *p_qbvh, vec3 origin, vec3 direction, float max_t, GXEntity_t **pp_entity, float *p_t );
+
+/** !
+ *  Find each entity whose bounding volume overlaps an axis aligned box
+ *
+ * @param p_qbvh       : the 4-wide bounding volume hierarchy
+ * @param min          : the minimum of the box
+ * @param max          : the maximum of the box
+ * @param pp_entities  : return, may be null
+ * @param max_entities : the size of pp_entities
+ *
+ * @sa qbvh_raycast
+ * @sa qbvh_frustum
+ *
+ * @return the number of overlapping entities, which may exceed max_entities, or 0
+ *         on error
+ */
+DLLEXPORT size_t qbvh_overlap ( GXQBVH_t *p_qbvh, vec3 min, vec3 max, GXEntity_t **pp_entities, size_t max_entities );
+
+/** !
+ *  Find each entity whose bounding volume is inside or intersects a frustum
+ *
+ * @param p_qbvh       : the 4-wide bounding volume hierarchy
+ * @param p_planes     : six planes, with normals pointing inward. A point p is inside a plane when x*p.x + y*p.y + z*p.z + w >= 0
+ * @param pp_entities  : return, may be null
+ * @param max_entities : the size of pp_entities
+ *
+ * @sa frustum_planes_from_camera
+ * @sa qbvh_raycast
+ * @sa qbvh_overlap
+ *
+ * @return the number of visible entities, which may exceed max_entities, or 0 on
+ *         error
+ */
+DLLEXPORT size_t qbvh_frustum ( GXQBVH_t *p_qbvh, vec4 *p_planes, GXEntity_t **pp_entities, size_t max_entities );
+
+/** !
+ *  Compute the six planes of a camera's view frustum
+ *
+ * @param p_camera : the camera
+ * @param p_planes : return, six planes
+ *
+ * @sa qbvh_frustum
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int frustum_planes_from_camera ( GXCamera_t *p_camera, vec4 *p_planes );
+
+// Destructors
+/** !
+ *  Free a 4-wide bounding volume hierarchy. The dynamic tree is not freed.
+ *
+ * @param pp_qbvh : pointer to 4-wide bounding volume hierarchy
+ *
+ * @sa create_qbvh
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int destroy_qbvh ( GXQBVH_t **pp_qbvh );
@@ -70,6 +70,17 @@ DLLEXPORT quaternion multiply_quaternion_quaternion_vec4 ( quaternion q1, quater
  */
 DLLEXPORT quaternion multiply_quaternion_quaternion ( quaternion q1, quaternion q2 );
 
+/** !
+ * Multiplies two quaternions. r may alias q1 or q2
+ *
+ * @param r  : return ( q1 times q2 )
+ * @param q1 : quaternion 1
+ * @param q2 : quaternion 2
+ *
+ * @sa multiply_quaternion_quaternion
+ */
+DLLEXPORT void multiply_quaternion_quaternion_p ( quaternion *r, const quaternion *q1, const quaternion *q2 );
+
 /** !
  * Creates a rotation matrix from a quaternion
  *
@@ -100,4 +111,88 @@ DLLEXPORT quaternion normalize_quaternion ( quaternion q );
  *
  * @return The quaternion between q1 and q2 at a given time
 */
-DLLEXPORT quaternion q_slerp ( quaternion q1, quaternion q2, float delta_time );
\ No newline at end of file
+DLLEXPORT quaternion q_slerp ( quaternion q1, quaternion q2, float delta_time );
+
+// Batches
+/** !
+ * Normalizes each quaternion of an array. Unlike normalize_quaternion, all
+ * four components are normalized. r may alias q
+ *
+ * @param r     : return, count quaternions
+ * @param q     : count quaternions
+ * @param count : the number of quaternions
+ *
+ * @sa normalize_quaternion_batch_soa
+ */
+DLLEXPORT void normalize_quaternion_batch ( quaternion *r, const quaternion *q, size_t count );
+
+/** !
+ * Normalizes each quaternion of a structure of arrays. The arrays need not be
+ * aligned. r may alias q
+ *
+ * @param r     : return
+ * @param q     : count quaternions
+ * @param count : the number of quaternions
+ *
+ * @sa normalize_quaternion_batch
+ */
+DLLEXPORT void normalize_quaternion_batch_soa ( quaternion_soa r, quaternion_soa q, size_t count );
+
+/** !
+ * Computes a model matrix from each location, rotation, and scale. Matches
+ * transform_model_matrix
+ *
+ * @param r        : return, count matrices
+ * @param location : count locations
+ * @param rotation : count quaternions
+ * @param scale    : count scales
+ * @param count    : the number of matrices
+ *
+ * @sa model_mat4_from_trs_batch_soa
+ */
+DLLEXPORT void model_mat4_from_trs_batch ( mat4 *r, const vec3 *location, const quaternion *rotation, const vec3 *scale, size_t count );
+
+/** !
+ * Computes a model matrix from each location, rotation, and scale of a
+ * structure of arrays. The w arrays are not read. The arrays need not be aligned
+ *
+ * @param r        : return, count matrices
+ * @param location : count locations
+ * @param rotation : count quaternions
+ * @param scale    : count scales
+ * @param count    : the number of matrices
+ *
+ * @sa model_mat4_from_trs_batch
+ */
+DLLEXPORT void model_mat4_from_trs_batch_soa ( mat4 *r, vec3_soa location, quaternion_soa rotation, vec3_soa scale, size_t count );
+
+/** !
+ * Spherical linear interpolation between each pair of quaternions, by the
+ * same amount. Agrees with q_slerp to about six digits. r may alias q0 or q1
+ *
+ * @param r     : return, count quaternions
+ * @param q0    : count quaternions
+ * @param q1    : count quaternions
+ * @param t     : the amount to interpolate, from 0 to 1
+ * @param count : the number of quaternions
+ *
+ * @sa q_slerp
+ * @sa q_slerp_batch_soa
+ */
+DLLEXPORT void q_slerp_batch ( quaternion *r, const quaternion *q0, const quaternion *q1, float t, size_t count );
+
+/** !
+ * Spherical linear interpolation between each pair of quaternions of two
+ * structures of arrays, by the same amount. The arrays need not be aligned.
+ * r may alias q0 or q1
+ *
+ * @param r     : return
+ * @param q0    : count quaternions
+ * @param q1    : count quaternions
+ * @param t     : the amount to interpolate, from 0 to 1
+ * @param count : the number of quaternions
+ *
+ * @sa q_slerp
+ * @sa q_slerp_batch
+ */
+DLLEXPORT void q_slerp_batch_soa ( quaternion_soa r, quaternion_soa q0, quaternion_soa q1, float t, size_t count );
@@ -72,8 +72,12 @@ struct GXRenderPass_s
 
 struct GXSubpass_s
 {
-	char  *name,
-	     **shader_names;
+	char  *name;
+
+	// Interned shader names, and, resolved once at load, the handle and draw queue of each shader
+	const char **shader_names;
+	handle_t    *shader_handles;
+	queue      **draw_queues;
 	size_t shader_count;
 	VkSubpassDescription2 subpass_description;
 };
@@ -29,6 +29,7 @@
 #include <G10/GXCamera.h>
 #include <G10/GXLight.h>
 #include <G10/GXShader.h>
+#include <G10/GXQBVH.h>
 
 struct GXScene_s
 {
@@ -54,9 +55,27 @@ struct GXScene_s
 	// A bounding volume hierarchy tree containing entities with colliders
 	GXBV_t *bvh;
 
+	// The bounding volume hierarchy, compiled for queries. Updated once a frame
+	GXQBVH_t *qbvh;
+
+	// The transform of each entity. Dirty subtrees are updated once a frame
+	GXTransformHierarchy_t *transforms;
+
+	// Every entity, grouped into archetypes by component
+	GXComponentStorage_t *components;
+
+	// Entities, components, and names loaded with the scene. Freed all at once
+	GXArena_t *arena;
+
+	// Guards appending entities, which the loading threads do at once
+	SDL_mutex *lock;
+
 	// The camera to be used while drawing the scene
 	GXCamera_t     *active_camera;
 	GXEntity_t     *active_entity;
+
+	// The part being drawn
+	GXPart_t       *active_part;
 };
 
 // Allocators
@@ -194,6 +213,17 @@ DLLEXPORT int scene_info ( GXScene_t   *p_scene );
  */
 DLLEXPORT GXEntity_t *get_entity ( GXScene_t *p_scene, char *name );
 
+/** !
+ *  Get an entity from the scene by its handle. Resolve names to handles once,
+ *  with get_entity, and use handles after that
+ *
+ * @param p_scene : The scene
+ * @param handle  : The handle
+ *
+ * @return a pointer to the entity, if the handle is live, else 0
+ */
+DLLEXPORT GXEntity_t *get_entity_by_handle ( GXScene_t *p_scene, handle_t handle );
+
 /** !
  *  Get a camera from the scene by it's name
  *
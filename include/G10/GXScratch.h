@@ -0,0 +1,105 @@
+/** !
+ * @file G10/GXScratch.h
+ * @author Jacob Smith
+ *
+ * Per thread scratch memory. Each thread bumps temporary allocations out of a
+ * buffer of its own, without a lock, and never frees them one at a time. The
+ * scheduler resets each thread's scratch memory at the end of the thread's
+ * frame. Code that runs outside of the scheduler takes a mark before it
+ * allocates, and rewinds to the mark when it is done.
+ *
+ * Allocations that don't fit spill onto the heap, and are freed with the rest
+ * of the scratch memory. The next reset grows the buffer to fit them, so a
+ * thread stops spilling after its first few frames.
+ *
+ * Scratch memory belongs to the thread that allocated it. Never free it, and
+ * never use it after the thread's next frame.
+ */
+
+// Include guard
+#pragma once
+
+// Standard library
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// G10
+#include <G10/GXtypedef.h>
+#include <G10/G10.h>
+
+// Initial size of each thread's buffer
+#define SCRATCH_SIZE ( 256 * 1024 )
+
+// Alignment of every allocation
+#define SCRATCH_ALIGNMENT 16
+
+struct GXScratchMark_s
+{
+
+	// Bytes of the buffer in use, and allocations spilled onto the heap
+	size_t used,
+	       spill_count;
+};
+
+// Mutators
+/** !
+ *  Allocate scratch memory for the calling thread. The memory is not zeroed
+ *
+ * @param size : the size of the allocation in bytes
+ *
+ * @sa scratch_calloc
+ * @sa scratch_reset
+ *
+ * @return a pointer aligned to SCRATCH_ALIGNMENT on success, 0 on error
+ */
+DLLEXPORT void *scratch_alloc ( size_t size );
+
+/** !
+ *  Allocate zeroed scratch memory for the calling thread
+ *
+ * @param count : the number of elements
+ * @param size  : the size of each element in bytes
+ *
+ * @sa scratch_alloc
+ *
+ * @return a pointer aligned to SCRATCH_ALIGNMENT on success, 0 on error
+ */
+DLLEXPORT void *scratch_calloc ( size_t count, size_t size );
+
+/** !
+ *  Get the position of the calling thread's scratch memory
+ *
+ * @sa scratch_rewind
+ *
+ * @return a mark
+ */
+DLLEXPORT GXScratchMark_t scratch_mark ( void );
+
+/** !
+ *  Free every scratch allocation the calling thread made since a mark
+ *
+ * @param mark : the mark
+ *
+ * @sa scratch_mark
+ */
+DLLEXPORT void scratch_rewind ( GXScratchMark_t mark );
+
+/** !
+ *  Free all of the calling thread's scratch allocations. Called by the scheduler
+ *  at the end of each frame. Grows the buffer if the frame spilled onto the heap
+ *
+ * @sa scratch_alloc
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int scratch_reset ( void );
+
+// Destructors
+/** !
+ *  Free the calling thread's scratch buffer. Call before the thread exits
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int scratch_release ( void );
@@ -54,7 +54,7 @@ struct GXClient_s
 {
 	GXThread_t  *thread;
 	TCPsocket    socket;
-	GXEntity_t **actors;
+	handle_t    *actors; // Resolved from names once, in actor_initialize
 	size_t       actor_count,
 		         recv_len,
 				 send_len;
@@ -20,6 +20,7 @@
 #include <G10/GXtypedef.h>
 #include <G10/G10.h>
 #include <G10/GXCamera.h>
+#include <G10/GXVertex.h>
 
 enum g10_pipeline_e
 {
@@ -59,6 +60,7 @@ struct GXShader_s
 
     char                 *name;
     size_t                users;
+    handle_t              handle;
     enum g10_pipeline_e   type;
     GXLayout_t           *layout;
 
@@ -0,0 +1,148 @@
+/** !
+ * @file G10/GXSnapshot.h
+ * @author Jacob Smith
+ *
+ * Snapshots of the mutable state of a scene, for replay and rollback. A
+ * snapshot holds the location, rotation, and scale of each transform, the
+ * linear and angular state of each rigidbody, and the current state of each
+ * AI. Derived data, like model matrices, is rebuilt after a restore.
+ *
+ * Entities are found through the scene's component storage, and are written
+ * one archetype chunk at a time, into one packed array per component. An
+ * entity is matched to its record by its handle, so a snapshot can only be
+ * restored into the scene it was taken from.
+ *
+ * A delta stores a snapshot as the words that changed since a base snapshot.
+ * Entities that did not move cost a few bytes each.
+ *
+ * Snapshots are in the byte order of the machine that took them.
+ */
+
+// Include guard
+#pragma once
+
+// Standard library
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// G10
+#include <G10/GXtypedef.h>
+#include <G10/G10.h>
+#include <G10/GXArchetype.h>
+#include <G10/GXEntity.h>
+#include <G10/GXTransform.h>
+#include <G10/GXRigidbody.h>
+#include <G10/GXAI.h>
+
+struct GXSnapshot_s
+{
+
+	// The snapshot, or the delta. Reused by the next take, so steady state snapshots don't allocate
+	u8     *data;
+	size_t  size,
+	        max;
+};
+
+// Allocators
+/** !
+ *  Allocate memory for a snapshot
+ *
+ * @param pp_snapshot : return
+ *
+ * @sa destroy_snapshot
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int create_snapshot ( GXSnapshot_t **pp_snapshot );
+
+// Constructors
+/** !
+ *  Load a snapshot, or a delta, from a file
+ *
+ * @param pp_snapshot : return
+ * @param path        : the path to the file
+ *
+ * @sa save_snapshot
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int load_snapshot ( GXSnapshot_t **pp_snapshot, const char *path );
+
+// Mutators
+/** !
+ *  Write the mutable state of every stored entity of a scene to a snapshot
+ *
+ * @param p_snapshot : the snapshot
+ * @param p_scene    : the scene
+ *
+ * @sa restore_snapshot
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int take_snapshot ( GXSnapshot_t *p_snapshot, GXScene_t *p_scene );
+
+/** !
+ *  Write the state in a snapshot back to the scene it was taken from. Entities
+ *  that were removed, or whose components changed, are skipped. A corrupt
+ *  snapshot is rejected before anything is written
+ *
+ * @param p_snapshot : the snapshot
+ * @param p_scene    : the scene
+ *
+ * @sa take_snapshot
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int restore_snapshot ( GXSnapshot_t *p_snapshot, GXScene_t *p_scene );
+
+/** !
+ *  Encode a snapshot as a delta against a base snapshot
+ *
+ * @param p_delta    : return
+ * @param p_base     : the base snapshot
+ * @param p_snapshot : the snapshot to encode
+ *
+ * @sa apply_snapshot_delta
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int encode_snapshot_delta ( GXSnapshot_t *p_delta, GXSnapshot_t *p_base, GXSnapshot_t *p_snapshot );
+
+/** !
+ *  Decode a delta against the base snapshot it was encoded with
+ *
+ * @param p_snapshot : return
+ * @param p_base     : the base snapshot
+ * @param p_delta    : the delta
+ *
+ * @sa encode_snapshot_delta
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int apply_snapshot_delta ( GXSnapshot_t *p_snapshot, GXSnapshot_t *p_base, GXSnapshot_t *p_delta );
+
+// Info
+/** !
+ *  Write a snapshot, or a delta, to a file
+ *
+ * @param p_snapshot : the snapshot
+ * @param path       : the path to the file
+ *
+ * @sa load_snapshot
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int save_snapshot ( GXSnapshot_t *p_snapshot, const char *path );
+
+// Destructors
+/** !
+ *  Destroy a snapshot
+ *
+ * @param pp_snapshot : pointer to snapshot
+ *
+ * @sa create_snapshot
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int destroy_snapshot ( GXSnapshot_t **pp_snapshot );
@@ -0,0 +1,157 @@
+/** !
+ * @file G10/GXStats.h
+ * @author Jacob Smith
+ *
+ * Memory and object count statistics. Constructors and destructors add to a
+ * counter for each statistic, and the peak of each counter is kept for the
+ * session. Counters are relaxed atomics that are only touched when an object
+ * is made or freed, so they are cheap enough to leave on. Define G10_STAT_ADD
+ * as nothing to compile them out.
+ *
+ * Per scene statistics are gathered on request by walking the scene.
+ */
+
+// Include guard
+#pragma once
+
+// Standard library
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// G10
+#include <G10/GXtypedef.h>
+#include <G10/G10.h>
+
+enum stat_type_e
+{
+
+    // Live objects
+    stat_entities              = 0,
+    stat_transforms            = 1,
+    stat_rigidbodies           = 2,
+    stat_colliders             = 3,
+    stat_ais                   = 4,
+    stat_prefabs               = 5,
+    stat_parts                 = 6,
+    stat_materials             = 7,
+    stat_shaders               = 8,
+    stat_images                = 9,
+
+    // Bytes of CPU memory held by arenas, pools, and scratch buffers
+    stat_arena_bytes           = 10,
+    stat_pool_bytes            = 11,
+    stat_scratch_bytes         = 12,
+
+    // Bytes of GPU memory bound to vertex buffers, index buffers, and images
+    stat_vertex_buffer_bytes   = 13,
+    stat_index_buffer_bytes    = 14,
+    stat_image_bytes           = 15,
+
+    // Cache lookups
+    stat_part_cache_hits       = 16,
+    stat_part_cache_misses     = 17,
+    stat_material_cache_hits   = 18,
+    stat_material_cache_misses = 19,
+    stat_shader_cache_hits     = 20,
+    stat_shader_cache_misses   = 21,
+    stat_ai_cache_hits         = 22,
+    stat_ai_cache_misses       = 23,
+
+    stat_count                 = 24
+};
+typedef enum stat_type_e stat_type_t;
+
+struct GXSceneStats_s
+{
+
+	// Objects in the scene
+	size_t entities,
+	       transforms,
+	       rigidbodies,
+	       colliders,
+	       ais,
+	       cameras,
+	       lights;
+
+	// Bytes of the scene's arena reserved, and handed out
+	size_t arena_bytes,
+	       arena_used;
+};
+
+// Mutators
+/** !
+ *  Add to a statistic. Safe to call from many threads at once
+ *
+ * @param stat : the statistic
+ * @param n    : the amount to add. Negative to subtract
+ *
+ * @sa get_stat
+ */
+DLLEXPORT void stats_add ( stat_type_t stat, i64 n );
+
+// Getters
+/** !
+ *  Get the value of a statistic
+ *
+ * @param stat : the statistic
+ *
+ * @sa get_stat_peak
+ *
+ * @return the value
+ */
+DLLEXPORT i64 get_stat ( stat_type_t stat );
+
+/** !
+ *  Get the highest value of a statistic this session
+ *
+ * @param stat : the statistic
+ *
+ * @sa get_stat
+ *
+ * @return the peak value
+ */
+DLLEXPORT i64 get_stat_peak ( stat_type_t stat );
+
+/** !
+ *  Get the name of a statistic
+ *
+ * @param stat : the statistic
+ *
+ * @return the name, or 0 if stat is out of range
+ */
+DLLEXPORT const char *get_stat_name ( stat_type_t stat );
+
+/** !
+ *  Count the objects and memory of a scene
+ *
+ * @param p_scene : the scene
+ * @param p_stats : return
+ *
+ * @sa scene_info
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int get_scene_stats ( GXScene_t *p_scene, GXSceneStats_t *p_stats );
+
+// Info
+/** !
+ *  Print every statistic, and the statistics of each scene
+ *
+ * @sa print_stats_as_json
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int stats_info ( void );
+
+/** !
+ *  Write every statistic, and the statistics of each scene, as a JSON object
+ *
+ * @param p_f : the file
+ *
+ * @sa stats_info
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int print_stats_as_json ( FILE *p_f );
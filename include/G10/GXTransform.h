@@ -23,12 +23,47 @@
 #include <G10/GXLinear.h>
 #include <G10/GXQuaternion.h>
 
+// The location, rotation, or scale changed, so the local matrix is stale
+#define TRANSFORM_LOCAL_DIRTY 0x1
+
+// The world matrix is stale, and the transform is on its hierarchy's dirty list
+#define TRANSFORM_WORLD_DIRTY 0x2
+
 struct GXTransform_s
 {
 	vec3       location;
 	quaternion rotation;
 	vec3       scale;
+
+	// The world matrix. Equal to the local matrix times the parent's world matrix
 	mat4       model_matrix;
+
+	// The matrix made from location, rotation, and scale
+	mat4       local_matrix;
+
+	// Hierarchy
+	GXTransform_t          *parent;
+	GXTransformHierarchy_t *p_hierarchy;
+	size_t                  index,
+	                        subtree_size;
+	u8                      flags;
+};
+
+struct GXTransformHierarchy_s
+{
+
+	// Transforms in depth first order. Parents precede their children, and each subtree is contiguous
+	GXTransform_t **transforms;
+	size_t          transform_count,
+	                transform_max;
+
+	// Transforms whose world matrix is stale
+	GXTransform_t **dirty;
+	size_t          dirty_count,
+	                dirty_max;
+
+	// Set when a transform is added, removed, or reparented
+	bool            reorder;
 };
 
 // Allocators
@@ -99,19 +134,96 @@ DLLEXPORT int construct_transform ( GXTransform_t **pp_transform, vec3 location,
 
 // Getter
 /** !
- *  Compute a model matrix from the transform
+ *  Compute a model matrix from the transform, without parents. Builds the
+ *  scale, rotation, and translation directly, with no intermediate matrices.
  *
  * @param p_transform : Pointer to transform
  * @param r           : return
  *
  * @sa construct_transform
+ * @sa dirty_transform
  *
  */
 DLLEXPORT void transform_model_matrix ( GXTransform_t *p_transform, mat4 *r );
 
+// Hierarchy
+/** !
+ *  Allocate memory for a transform hierarchy
+ *
+ * @param pp_hierarchy : return
+ *
+ * @sa destroy_transform_hierarchy
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int create_transform_hierarchy ( GXTransformHierarchy_t **pp_hierarchy );
+
+/** !
+ *  Add a transform to a hierarchy as a root. Its world matrix is computed on
+ *  the next update
+ *
+ * @param p_hierarchy : the hierarchy
+ * @param p_transform : the transform
+ *
+ * @sa remove_transform
+ * @sa set_transform_parent
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int add_transform ( GXTransformHierarchy_t *p_hierarchy, GXTransform_t *p_transform );
+
+/** !
+ *  Remove a transform from its hierarchy. Its children become roots
+ *
+ * @param p_transform : the transform
+ *
+ * @sa add_transform
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int remove_transform ( GXTransform_t *p_transform );
+
+/** !
+ *  Attach a transform to a parent, or detach it if parent is null. The
+ *  transform's location, rotation, and scale become relative to the parent.
+ *  Both transforms must be in the same hierarchy
+ *
+ * @param p_transform : the child
+ * @param p_parent    : the parent, or null
+ *
+ * @sa add_transform
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int set_transform_parent ( GXTransform_t *p_transform, GXTransform_t *p_parent );
+
+/** !
+ *  Call after changing a transform's location, rotation, or scale. If the
+ *  transform is in a hierarchy, its subtree is updated by the next call to
+ *  update_transforms, else its model matrix is updated now
+ *
+ * @param p_transform : the transform
+ *
+ * @sa update_transforms
+ */
+DLLEXPORT void dirty_transform ( GXTransform_t *p_transform );
+
+/** !
+ *  Recompute the world matrix of each dirty subtree, and restore depth first
+ *  order after a removal or a reparent. Does nothing if no transform changed.
+ *  Call once a frame, from one thread
+ *
+ * @param p_hierarchy : the hierarchy
+ *
+ * @sa dirty_transform
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int update_transforms ( GXTransformHierarchy_t *p_hierarchy );
+
 // Destructors
 /** !
- *  Free a transform and all its contents
+ *  Free a transform and all its contents. Removes the transform from its hierarchy
  *
  * @param p_transform : Pointer to transform
  *
@@ -121,3 +233,15 @@ DLLEXPORT void transform_model_matrix ( GXTransform_t *p_transform, mat4 *r );
  */
 DLLEXPORT int destroy_transform ( GXTransform_t **pp_transform );
 
+/** !
+ *  Free a transform hierarchy. The transforms are not freed, and become roots
+ *  outside of any hierarchy
+ *
+ * @param pp_hierarchy : pointer to transform hierarchy
+ *
+ * @sa create_transform_hierarchy
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int destroy_transform_hierarchy ( GXTransformHierarchy_t **pp_hierarchy );
+
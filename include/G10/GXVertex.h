@@ -0,0 +1,120 @@
+/** !
+ * @file G10/GXVertex.h
+ * @author Jacob Smith
+ *
+ * Quantized vertex formats. A vertex is described by a bitmask of the vertex
+ * groups it has, the same groups a PLY file is sorted into. Each group has one
+ * compact encoding, and the groups are interleaved in the order of their bits.
+ *
+ * ╭─────────────────────┬──────┬──────────────────────────┬───────┬───────╮
+ * │ Vertex group        │ Code │ Encoding                 │ Bytes │ Float │
+ * ├─────────────────────┼──────┼──────────────────────────┼───────┼───────┤
+ * │ Geometric vertices  │ 0x01 │ 16 bit unorm, in bounds  │     8 │    12 │
+ * │ Texture coordinates │ 0x02 │ half float               │     4 │     8 │
+ * │ Vertex normals      │ 0x04 │ octahedral, 16 bit snorm │     4 │    12 │
+ * │ Vertex bitangents   │ 0x08 │ octahedral, 16 bit snorm │     4 │    12 │
+ * │ Vertex tangents     │ 0x10 │ octahedral, 16 bit snorm │     4 │    12 │
+ * │ Vertex colors       │ 0x20 │ 8 bit unorm              │     4 │    16 │
+ * │ Bone groups         │ 0x40 │ 8 bit uint               │     4 │    16 │
+ * │ Bone weights        │ 0x80 │ 8 bit unorm, sum to one  │     4 │    16 │
+ * ╰─────────────────────┴──────┴──────────────────────────┴───────┴───────╯
+ *
+ * Positions are stored relative to the box around the part, and scaled the
+ * same on every axis, so dequantizing is a uniform scale and a translation
+ * that can be folded into the model matrix. Octahedral vectors are decoded in
+ * the vertex shader with
+ *
+ *     vec3 n = vec3(e.xy, 1.0 - abs(e.x) - abs(e.y));
+ *     if ( n.z < 0 ) n.xy = ( 1.0 - abs(n.yx) ) * sign(n.xy);
+ *     n = normalize(n);
+ */
+
+// Include guard
+#pragma once
+
+// Standard library
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Vulkan
+#include <vulkan/vulkan.h>
+
+// G10
+#include <G10/GXtypedef.h>
+#include <G10/G10.h>
+
+// Vertex groups
+#define VERTEX_GROUP_GEOMETRIC 0x01
+#define VERTEX_GROUP_TEXTURE   0x02
+#define VERTEX_GROUP_NORMAL    0x04
+#define VERTEX_GROUP_BITANGENT 0x08
+#define VERTEX_GROUP_TANGENT   0x10
+#define VERTEX_GROUP_COLOR     0x20
+#define VERTEX_GROUP_BONES     0x40
+#define VERTEX_GROUP_WEIGHTS   0x80
+
+#define VERTEX_GROUP_COUNT     8
+
+struct GXVertexSource_s
+{
+
+	// The float of each property of each group, in bit order, and how many properties each group has
+	size_t properties[VERTEX_GROUP_COUNT][4],
+	       counts[VERTEX_GROUP_COUNT];
+
+	// What each group is multiplied by before it is encoded, like 1 / 255 for colors stored as bytes
+	float  scales[VERTEX_GROUP_COUNT];
+};
+
+// Quantizers
+/** !
+ *  Encode float vertices in the quantized format of a set of vertex groups
+ *
+ * @param groups        : the vertex groups to encode
+ * @param p_source      : where each group is in the float vertices
+ * @param p_vertices    : the float vertices. May be unaligned
+ * @param vertex_stride : bytes between float vertices
+ * @param vertex_count  : the number of vertices
+ * @param p_quantized   : return, vertex_count * quantized_vertex_stride(groups) bytes
+ * @param p_dequantize  : return, the translation in xyz, and the scale in w, that bring positions back
+ *
+ * @sa quantized_vertex_stride
+ * @sa quantized_vertex_input
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int quantize_vertices ( u32 groups, const GXVertexSource_t *p_source, const void *p_vertices, size_t vertex_stride, size_t vertex_count, void *p_quantized, vec4 *p_dequantize );
+
+// Getters
+/** !
+ *  Get the vertex group of a name, like "geometric" or "normal"
+ *
+ * @param name : the name of the vertex group
+ *
+ * @return the code of the vertex group, or 0 if the name is not a vertex group
+ */
+DLLEXPORT u32 get_vertex_group ( const char *name );
+
+/** !
+ *  Get the bytes between quantized vertices
+ *
+ * @param groups : the vertex groups
+ *
+ * @return the stride of a quantized vertex
+ */
+DLLEXPORT size_t quantized_vertex_stride ( u32 groups );
+
+/** !
+ *  Describe quantized vertices to a graphics pipeline. Each group is one
+ *  attribute of binding 0, at the next location
+ *
+ * @param groups       : the vertex groups
+ * @param p_binding    : return, the binding description
+ * @param p_attributes : return, up to VERTEX_GROUP_COUNT attribute descriptions
+ *
+ * @sa quantize_vertices
+ *
+ * @return the number of attribute descriptions
+ */
+DLLEXPORT u32 quantized_vertex_input ( u32 groups, VkVertexInputBindingDescription *p_binding, VkVertexInputAttributeDescription *p_attributes );
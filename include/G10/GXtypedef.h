@@ -27,10 +27,40 @@ typedef          long long i64;
 
 
 
+// Generational handle
+typedef u32                handle_t;
+
 // Floats
 typedef float              f32;
 typedef double             f64;
 
+// Alignment
+#if defined(_MSC_VER)
+    #define G10_ALIGN(n) __declspec(align(n))
+#else
+    #define G10_ALIGN(n) __attribute__((aligned(n)))
+#endif
+
+// Thread local storage
+#if defined(_MSC_VER)
+    #define G10_THREAD_LOCAL __declspec(thread)
+#else
+    #define G10_THREAD_LOCAL _Thread_local
+#endif
+
+// Atomic operations on 64 bit integers. G10_ATOMIC_ADD returns the old value, and
+// G10_ATOMIC_CAS returns true if *p held o, and now holds n
+#if defined(_MSC_VER)
+    #include <intrin.h>
+    #define G10_ATOMIC_ADD(p, v)    _InterlockedExchangeAdd64((volatile long long *)(p), (long long)(v))
+    #define G10_ATOMIC_LOAD(p)      _InterlockedOr64((volatile long long *)(p), 0)
+    #define G10_ATOMIC_CAS(p, o, n) ( _InterlockedCompareExchange64((volatile long long *)(p), (long long)(n), (long long)(o)) == (long long)(o) )
+#else
+    #define G10_ATOMIC_ADD(p, v)    __atomic_fetch_add((p), (v), __ATOMIC_RELAXED)
+    #define G10_ATOMIC_LOAD(p)      __atomic_load_n((p), __ATOMIC_RELAXED)
+    #define G10_ATOMIC_CAS(p, o, n) __sync_bool_compare_and_swap((p), (o), (n))
+#endif
+
 // 2D vector
 struct GXvec2_s {
     float x,
@@ -38,8 +68,8 @@ struct GXvec2_s {
 };
 typedef struct GXvec2_s vec2;
 
-// 3D / 4D vector
-struct GXvec4_s {
+// 3D / 4D vector. Aligned for SIMD loads
+struct G10_ALIGN(16) GXvec4_s {
     float x,
           y,
           z,
@@ -48,6 +78,16 @@ struct GXvec4_s {
 typedef struct GXvec4_s vec4;
 typedef struct GXvec4_s vec3;
 
+// 3D / 4D vectors, as a structure of arrays
+struct GXvec4SoA_s {
+    float *x,
+          *y,
+          *z,
+          *w;
+};
+typedef struct GXvec4SoA_s vec4_soa;
+typedef struct GXvec4SoA_s vec3_soa;
+
 // 2x2 matrix
 struct GXmat2_s {
     float a, b,
@@ -55,8 +95,8 @@ struct GXmat2_s {
 };
 typedef struct GXmat2_s mat2;
 
-// 4x4 matrix
-struct GXmat4_s {
+// 4x4 matrix. Aligned for SIMD loads
+struct G10_ALIGN(16) GXmat4_s {
     float a, b, c, d,
           e, f, g, h,
           i, j, k, l,
@@ -64,8 +104,8 @@ struct GXmat4_s {
 };
 typedef struct GXmat4_s mat4;
 
-// Quaternion
-struct quaternion_s
+// Quaternion. Aligned for SIMD loads
+struct G10_ALIGN(16) quaternion_s
 {
     float u,
           i,
@@ -74,6 +114,16 @@ struct quaternion_s
 };
 typedef struct quaternion_s quaternion;
 
+// Quaternions, as a structure of arrays
+struct quaternionSoA_s
+{
+    float *u,
+          *i,
+          *j,
+          *k;
+};
+typedef struct quaternionSoA_s quaternion_soa;
+
 // Insatnce
 struct GXInstance_s;
 
@@ -116,6 +166,10 @@ typedef struct GXScene_s GXScene_t;
 struct GXEntity_s;
 typedef struct GXEntity_s GXEntity_t;
 
+// Prefab type
+struct GXPrefab_s;
+typedef struct GXPrefab_s GXPrefab_t;
+
 // Camera type
 struct GXCamera_s;
 typedef struct GXCamera_s GXCamera_t;
@@ -128,6 +182,61 @@ typedef struct GXLight_s GXLight_t;
 struct GXBV_s;
 typedef struct GXBV_s GXBV_t;
 
+// Compiled 4-wide bounding volume hierarchy
+struct GXQBVH_s;
+typedef struct GXQBVH_s GXQBVH_t;
+
+// 4-wide bounding volume hierarchy node
+struct GXQBVHNode_s;
+typedef struct GXQBVHNode_s GXQBVHNode_t;
+
+// Archetype
+struct GXArchetype_s;
+typedef struct GXArchetype_s GXArchetype_t;
+
+struct GXArchetypeChunk_s;
+typedef struct GXArchetypeChunk_s GXArchetypeChunk_t;
+
+struct GXComponentStorage_s;
+typedef struct GXComponentStorage_s GXComponentStorage_t;
+
+struct GXWorkList_s;
+typedef struct GXWorkList_s GXWorkList_t;
+
+// Arena
+struct GXArena_s;
+typedef struct GXArena_s GXArena_t;
+
+struct GXArenaBlock_s;
+typedef struct GXArenaBlock_s GXArenaBlock_t;
+
+// Pool
+struct GXPool_s;
+typedef struct GXPool_s GXPool_t;
+
+// Scratch memory
+struct GXScratchMark_s;
+typedef struct GXScratchMark_s GXScratchMark_t;
+
+// Snapshots
+struct GXSnapshot_s;
+typedef struct GXSnapshot_s GXSnapshot_t;
+
+// Statistics
+struct GXSceneStats_s;
+typedef struct GXSceneStats_s GXSceneStats_t;
+
+// Allocation tracking
+struct GXAllocStats_s;
+struct GXAllocSite_s;
+
+typedef struct GXAllocStats_s GXAllocStats_t;
+typedef struct GXAllocSite_s  GXAllocSite_t;
+
+// Handle table
+struct GXHandleTable_s;
+typedef struct GXHandleTable_s GXHandleTable_t;
+
 // Skybox type
 struct GXSkybox_s;
 typedef struct GXSkybox_s GXSkybox_t;
@@ -136,6 +245,36 @@ typedef struct GXSkybox_s GXSkybox_t;
 struct GXPart_s;
 typedef struct GXPart_s GXPart_t;
 
+// PLY files
+struct GXPLYProperty_s;
+struct GXPLYElement_s;
+struct GXPLY_s;
+
+typedef struct GXPLYProperty_s GXPLYProperty_t;
+typedef struct GXPLYElement_s  GXPLYElement_t;
+typedef struct GXPLY_s         GXPLY_t;
+
+// Assets
+struct GXAsset_s;
+typedef struct GXAsset_s GXAsset_t;
+
+// Meshes
+struct GXMeshHeader_s;
+struct GXMeshLOD_s;
+struct GXMeshlet_s;
+struct GXMeshletBounds_s;
+struct GXMesh_s;
+
+typedef struct GXMeshHeader_s     GXMeshHeader_t;
+typedef struct GXMeshLOD_s        GXMeshLOD_t;
+typedef struct GXMeshlet_s        GXMeshlet_t;
+typedef struct GXMeshletBounds_s  GXMeshletBounds_t;
+typedef struct GXMesh_s           GXMesh_t;
+
+// Vertex formats
+struct GXVertexSource_s;
+typedef struct GXVertexSource_s GXVertexSource_t;
+
 // Shader type
 struct GXShader_s;
 
@@ -165,6 +304,9 @@ typedef struct GXTexture_s GXTexture_t;
 struct GXTransform_s;
 typedef struct GXTransform_s GXTransform_t;
 
+struct GXTransformHierarchy_s;
+typedef struct GXTransformHierarchy_s GXTransformHierarchy_t;
+
 // Rigid body
 struct GXRigidbody_s;
 typedef struct GXRigidbody_s GXRigidbody_t;
@@ -177,6 +319,14 @@ typedef struct GXCollider_s GXCollider_t;
 struct GXCollision_s;
 typedef struct GXCollision_s GXCollision_t;
 
+// Contact manifold
+struct GXManifold_s;
+typedef struct GXManifold_s GXManifold_t;
+
+// Collision pair
+struct GXCollisionPair_s;
+typedef struct GXCollisionPair_s GXCollisionPair_t;
+
 // Armature
 struct GXRig_s;
 typedef struct GXRig_s GXRig_t;